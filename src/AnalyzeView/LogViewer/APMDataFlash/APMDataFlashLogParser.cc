@@ -7,9 +7,9 @@
 #include <QtCore/QFile>
 #include <QtCore/QFutureWatcher>
 #include <QtCore/QHash>
-#include <QtCore/QSet>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
 
@@ -343,19 +343,19 @@ QString _ardupilotEventDescription(int eventId)
     }
 }
 
-double _extractTimestampSeconds(const QMap<QString, QVariant> &values)
+enum class MessageKind { Other, Parm, Msg, Mode, Err, Ev };
+
+MessageKind _messageKind(const QString &name)
 {
-    if (values.contains(QStringLiteral("TimeUS"))) {
-        return values.value(QStringLiteral("TimeUS")).toDouble() / 1000000.0;
-    }
-    if (values.contains(QStringLiteral("TimeMS"))) {
-        return values.value(QStringLiteral("TimeMS")).toDouble() / 1000.0;
-    }
-    if (values.contains(QStringLiteral("Time"))) {
-        return values.value(QStringLiteral("Time")).toDouble() / 1000.0;
-    }
+    static const QHash<QString, MessageKind> kinds = {
+        {QStringLiteral("PARM"), MessageKind::Parm},
+        {QStringLiteral("MSG"), MessageKind::Msg},
+        {QStringLiteral("MODE"), MessageKind::Mode},
+        {QStringLiteral("ERR"), MessageKind::Err},
+        {QStringLiteral("EV"), MessageKind::Ev},
+    };
 
-    return -1.0;
+    return kinds.value(name, MessageKind::Other);
 }
 
 void _appendEvent(QVariantList &events, double timestampSecs, const QString &type, const QString &description)
@@ -416,37 +416,23 @@ ParseResult _parseDataFlashFile(const QString &filePath)
         return result;
     }
 
-    QSet<QString> signalSet;
-    QSet<QString> plottableSet;
     double minTimestampSecs = -1.0;
     double maxTimestampSecs = -1.0;
     bool hasOpenModeSegment = false;
     double modeSegmentStartSecs = -1.0;
     QString currentModeName;
 
-    // Precompute, once per format, the fully-qualified signal names ("<msg>.<col>")
-    // and a lookup map from column name to that pre-formatted signal name. Building
-    // these names per-message via QString::arg() previously dominated parse cost.
-    QHash<uint8_t, QHash<QString, QString>> signalNameByCol;
-    signalNameByCol.reserve(formats.size());
+    // Each format is compiled once into a flat extractor, so numeric columns go straight into their series. Only
+    // the few message types that feed parameters, messages and events are still parsed into a value map.
+    APMDataFlashUtility::SeriesDecoder decoder(formats);
+    std::array<MessageKind, 256> kinds;
+    kinds.fill(MessageKind::Other);
     for (auto fmtIt = formats.cbegin(); fmtIt != formats.cend(); ++fmtIt) {
-        const APMDataFlashUtility::MessageFormat &fmt = fmtIt.value();
-        QHash<QString, QString> &perCol = signalNameByCol[fmtIt.key()];
-        perCol.reserve(fmt.columns.size());
-        for (const QString &col : fmt.columns) {
-            perCol.insert(col, fmt.name + QLatin1Char('.') + col);
-        }
+        kinds[fmtIt.key()] = _messageKind(fmtIt.value().name);
     }
 
-    static const QString kPARM = QStringLiteral("PARM");
-    static const QString kMSG  = QStringLiteral("MSG");
-    static const QString kMODE = QStringLiteral("MODE");
-    static const QString kERR  = QStringLiteral("ERR");
-    static const QString kEV   = QStringLiteral("EV");
-
-    APMDataFlashUtility::iterateMessages(bytes.constData(), bytes.size(), formats, [&result, &signalSet, &plottableSet, &minTimestampSecs, &maxTimestampSecs, &hasOpenModeSegment, &modeSegmentStartSecs, &currentModeName, &signalNameByCol](uint8_t msgType, const char *payload, int, const APMDataFlashUtility::MessageFormat &fmt) {
-        const QMap<QString, QVariant> values = APMDataFlashUtility::parseMessage(payload, fmt);
-        const double timestampSecs = _extractTimestampSeconds(values);
+    APMDataFlashUtility::iterateMessages(bytes.constData(), bytes.size(), formats, [&result, &minTimestampSecs, &maxTimestampSecs, &hasOpenModeSegment, &modeSegmentStartSecs, &currentModeName, &decoder, &kinds](uint8_t msgType, const char *payload, int, const APMDataFlashUtility::MessageFormat &fmt) {
+        const double timestampSecs = decoder.timestampSeconds(msgType, payload);
         if (timestampSecs >= 0.0) {
             if (minTimestampSecs < 0.0 || timestampSecs < minTimestampSecs) {
                 minTimestampSecs = timestampSecs;
@@ -454,7 +440,10 @@ ParseResult _parseDataFlashFile(const QString &filePath)
             maxTimestampSecs = std::max(maxTimestampSecs, timestampSecs);
         }
 
-        if (fmt.name == kPARM) {
+        const MessageKind kind = kinds[msgType];
+        const QMap<QString, QVariant> values = (kind != MessageKind::Other) ? APMDataFlashUtility::parseMessage(payload, fmt) : QMap<QString, QVariant>();
+
+        if (kind == MessageKind::Parm) {
             const QString paramName = values.value(QStringLiteral("Name")).toString();
             const QVariant paramValue = values.contains(QStringLiteral("Value")) ? values.value(QStringLiteral("Value")) : values.value(QStringLiteral("Val"));
             if (!paramName.isEmpty()) {
@@ -463,7 +452,7 @@ ParseResult _parseDataFlashFile(const QString &filePath)
                 row[QStringLiteral("value")] = paramValue;
                 result.parameters.append(row);
             }
-        } else if (fmt.name == kMSG) {
+        } else if (kind == MessageKind::Msg) {
             const QString text = values.value(QStringLiteral("Message")).toString();
             const QString detected = _vehicleTypeFromMessageText(text);
             if (result.detectedVehicleType.isEmpty() && !detected.isEmpty()) {
@@ -475,7 +464,7 @@ ParseResult _parseDataFlashFile(const QString &filePath)
                 row[QStringLiteral("text")] = text;
                 result.messages.append(row);
             }
-        } else if (fmt.name == kMODE) {
+        } else if (kind == MessageKind::Mode) {
             QString modeName = values.value(QStringLiteral("Mode")).toString();
             bool isNumericMode = false;
             const int modeNumber = modeName.toInt(&isNumericMode);
@@ -497,41 +486,18 @@ ParseResult _parseDataFlashFile(const QString &filePath)
                 modeSegmentStartSecs = timestampSecs;
                 currentModeName = modeName;
             }
-        } else if (fmt.name == kERR) {
+        } else if (kind == MessageKind::Err) {
             const int subsystem = values.value(QStringLiteral("Subsys")).toInt();
             const int ecode = values.value(QStringLiteral("ECode")).toInt();
             _appendEvent(result.events, timestampSecs, QStringLiteral("error"), _ardupilotErrDescription(subsystem, ecode));
-        } else if (fmt.name == kEV) {
+        } else if (kind == MessageKind::Ev) {
             const int eventId = values.value(QStringLiteral("Id"), values.value(QStringLiteral("Event"))).toInt();
             _appendEvent(result.events, timestampSecs, QStringLiteral("event"), _ardupilotEventDescription(eventId));
         }
 
         result.sampleCount++;
 
-        // Single pass: lookup precomputed signal names, populate signal/plottable
-        // sets, and append numeric samples in one walk over the values map.
-        const QHash<QString, QString> &perCol = signalNameByCol[msgType];
-        const bool haveTimestamp = (timestampSecs >= 0.0);
-        for (auto it = values.cbegin(); it != values.cend(); ++it) {
-            const auto nameIt = perCol.constFind(it.key());
-            if (nameIt == perCol.constEnd()) {
-                continue;
-            }
-            const QString &signalName = nameIt.value();
-            signalSet.insert(signalName);
-
-            if (!haveTimestamp) {
-                continue;
-            }
-            const int typeId = it.value().metaType().id();
-            const bool numeric = (typeId == QMetaType::Int) || (typeId == QMetaType::UInt) ||
-                                 (typeId == QMetaType::LongLong) || (typeId == QMetaType::ULongLong) ||
-                                 (typeId == QMetaType::Float) || (typeId == QMetaType::Double);
-            if (numeric) {
-                result.fieldSamples[signalName].append(QPointF(timestampSecs, it.value().toDouble()));
-                plottableSet.insert(signalName);
-            }
-        }
+        decoder.decode(msgType, payload, timestampSecs);
 
         return true;
     });
@@ -544,9 +510,10 @@ ParseResult _parseDataFlashFile(const QString &filePath)
         result.modeSegments.append(segment);
     }
 
-    result.availableFields = signalSet.values();
+    result.fieldSamples = decoder.takeSeries();
+    result.availableFields = decoder.fieldNames();
     std::sort(result.availableFields.begin(), result.availableFields.end());
-    result.plottableFields = plottableSet.values();
+    result.plottableFields = result.fieldSamples.keys();
     std::sort(result.plottableFields.begin(), result.plottableFields.end());
     result.minTimestamp = minTimestampSecs;
     result.maxTimestamp = maxTimestampSecs;
@@ -7,12 +7,16 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QFile>
 #include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QSet>
 #include <QtCore/QTimeZone>
 #include <QtCore/QVariantMap>
 
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
 #include <limits>
 
 namespace {
@@ -207,18 +211,20 @@ QString _ardupilotEventDescription(int eventId)
     }
 }
 
-double _extractTimestampSeconds(const QMap<QString, QVariant> &values)
+enum class MessageKind { Other, Parm, Msg, Mode, Err, Ev, Gps };
+
+MessageKind _messageKind(const QString &name)
 {
-    if (values.contains(QStringLiteral("TimeUS"))) {
-        return values.value(QStringLiteral("TimeUS")).toDouble() / 1000000.0;
-    }
-    if (values.contains(QStringLiteral("TimeMS"))) {
-        return values.value(QStringLiteral("TimeMS")).toDouble() / 1000.0;
-    }
-    if (values.contains(QStringLiteral("Time"))) {
-        return values.value(QStringLiteral("Time")).toDouble() / 1000.0;
-    }
-    return -1.0;
+    static const QHash<QString, MessageKind> kinds = {
+        {QStringLiteral("PARM"), MessageKind::Parm},
+        {QStringLiteral("MSG"), MessageKind::Msg},
+        {QStringLiteral("MODE"), MessageKind::Mode},
+        {QStringLiteral("ERR"), MessageKind::Err},
+        {QStringLiteral("EV"), MessageKind::Ev},
+        {QStringLiteral("GPS"), MessageKind::Gps},
+        {QStringLiteral("GPS2"), MessageKind::Gps},
+    };
+    return kinds.value(name, MessageKind::Other);
 }
 
 void _appendEvent(QVariantList &events, double timestampSecs, const QString &type, const QString &description)
@@ -233,11 +239,207 @@ void _appendEvent(QVariantList &events, double timestampSecs, const QString &typ
     events.append(eventRow);
 }
 
+/// Start time of the log from a GPS message's week and milliseconds, or a null QDateTime if they are not valid
+QDateTime _startTimeFromGps(const QMap<QString, QVariant> &values, double timestampSecs)
+{
+    if (!values.contains(QStringLiteral("GWk")) || !values.contains(QStringLiteral("GMS")) || (timestampSecs < 0.0)) {
+        return QDateTime();
+    }
+
+    const int gwk = values.value(QStringLiteral("GWk")).toInt();
+    const int gms = values.value(QStringLiteral("GMS")).toInt();
+    if (gwk <= 2000) {
+        return QDateTime();
+    }
+
+    const double gpsSecs = 315964800.0 + (7.0 * 24 * 60 * 60) * gwk + (gms / 1000.0);
+    const QDateTime gpsDateTime = QDateTime::fromMSecsSinceEpoch(
+        static_cast<qint64>(gpsSecs * 1000.0), QTimeZone::utc());
+    const int leapSecs = _leapSecondsGPS(gpsDateTime.date().year(), gpsDateTime.date().month());
+    const double utcSecs = gpsSecs - leapSecs;
+    return QDateTime::fromMSecsSinceEpoch(
+        static_cast<qint64>((utcSecs - timestampSecs) * 1000.0), QTimeZone::utc());
+}
+
+/// How a DataFlash format character is kept in the sample store: its native width, with the scaling of the
+/// centi- and 1e-7 integer types left to the divisor. Half floats are widened to float when stored.
+void _storedType(char formatChar, LogSampleStore::ValueType &type, double &divisor)
+{
+    using VT = LogSampleStore::ValueType;
+    divisor = 1.0;
+    switch (formatChar) {
+    case 'b': type = VT::Int8; break;
+    case 'B':
+    case 'M': type = VT::UInt8; break;
+    case 'h': type = VT::Int16; break;
+    case 'H': type = VT::UInt16; break;
+    case 'c': type = VT::Int16; divisor = 100.0; break;
+    case 'C': type = VT::UInt16; divisor = 100.0; break;
+    case 'i': type = VT::Int32; break;
+    case 'I': type = VT::UInt32; break;
+    case 'e': type = VT::Int32; divisor = 100.0; break;
+    case 'E': type = VT::UInt32; divisor = 100.0; break;
+    case 'L': type = VT::Int32; divisor = 1.0e7; break;
+    case 'f':
+    case 'g': type = VT::Float; break;
+    case 'q': type = VT::Int64; break;
+    case 'Q': type = VT::UInt64; break;
+    default:  type = VT::Double; break;
+    }
+}
+
+/// What one chunk of the log decodes to. Payloads point into the mapped file.
+struct DecodedChunk {
+    struct Record {
+        MessageKind kind = MessageKind::Other;
+        const char *payload = nullptr;
+        const APMDataFlashUtility::MessageFormat *fmt = nullptr;
+        double timestampSecs = -1.0;
+    };
+
+    /// Where the numeric columns of one message type go in the store
+    struct StorePlan {
+        struct Field {
+            int offset = 0;
+            int series = -1;
+            bool half = false;
+        };
+
+        bool planned = false;
+        int group = -1;
+        QList<Field> fields;
+    };
+
+    explicit DecodedChunk(const QMap<uint8_t, APMDataFlashUtility::MessageFormat> &formats)
+        : decoder(formats) {}
+
+    /// Copies the numeric columns of a timestamped message into the store, planning the type on first use
+    void store(uint8_t msgType, const char *payload, const APMDataFlashUtility::MessageFormat &fmt, double timestampSecs)
+    {
+        StorePlan &plan = storePlans[msgType];
+        if (!plan.planned) {
+            plan.planned = true;
+            const QList<APMDataFlashUtility::SeriesDecoder::Column> columns = decoder.numericColumns(msgType);
+            if (!columns.isEmpty()) {
+                plan.group = samples.addGroup(fmt.name);
+            }
+            for (const APMDataFlashUtility::SeriesDecoder::Column &column : columns) {
+                LogSampleStore::ValueType type;
+                double divisor;
+                _storedType(column.formatChar, type, divisor);
+                plan.fields.append({column.offset, samples.addSeries(plan.group, column.fieldName, type, divisor),
+                                    column.formatChar == 'g'});
+            }
+        }
+        if (plan.group < 0) {
+            return;
+        }
+
+        samples.appendRow(plan.group, timestampSecs);
+        for (const StorePlan::Field &field : std::as_const(plan.fields)) {
+            if (field.half) {
+                uint16_t bits;
+                (void) memcpy(&bits, payload + field.offset, sizeof(bits));
+                const float value = APMDataFlashUtility::halfToFloat(bits);
+                samples.appendValue(field.series, &value);
+            } else {
+                samples.appendValue(field.series, payload + field.offset);
+            }
+        }
+    }
+
+    APMDataFlashUtility::SeriesDecoder decoder;     ///< Timestamps, field names and column layouts
+    std::array<StorePlan, 256> storePlans;
+    LogSampleStore samples;
+    QList<Record> records;      ///< PARM, MSG, MODE, ERR and EV messages, in file order
+    QDateTime startTime;        ///< From the chunk's first valid GPS message
+    double minTimestampSecs = -1.0;
+    double maxTimestampSecs = -1.0;
+    int sampleCount = 0;
+};
+
+/// Mode segment being built while records are replayed in file order
+struct ModeTracker {
+    bool hasOpenSegment = false;
+    double segmentStartSecs = -1.0;
+    QString currentModeName;
+};
+
+void _applyRecord(const DecodedChunk::Record &record, LogParseResult &result, ModeTracker &modes)
+{
+    const QMap<QString, QVariant> values = APMDataFlashUtility::parseMessage(record.payload, *record.fmt);
+    const double timestampSecs = record.timestampSecs;
+
+    if (record.kind == MessageKind::Parm) {
+        const QString paramName = values.value(QStringLiteral("Name")).toString();
+        const QVariant paramValue = values.contains(QStringLiteral("Value"))
+            ? values.value(QStringLiteral("Value"))
+            : values.value(QStringLiteral("Val"));
+        if (!paramName.isEmpty()) {
+            QVariantMap row;
+            row[QStringLiteral("name")]         = paramName;
+            row[QStringLiteral("value")]        = paramValue;
+            // DataFlash logs don't carry default value metadata
+            row[QStringLiteral("isFloat")]      = paramValue.metaType() == QMetaType::fromType<float>()
+                                                  || paramValue.metaType() == QMetaType::fromType<double>();
+            row[QStringLiteral("hasDefault")]   = false;
+            row[QStringLiteral("defaultValue")] = QVariant();
+            row[QStringLiteral("isDefault")]    = false;
+            result.parameters.append(row);
+        }
+    } else if (record.kind == MessageKind::Msg) {
+        const QString text = values.value(QStringLiteral("Message")).toString();
+        const QString detected = _vehicleTypeFromMessageText(text);
+        if (result.detectedVehicleType.isEmpty() && !detected.isEmpty()) {
+            result.detectedVehicleType = detected;
+            _parseFirmwareVersionFromMessageText(text, result.firmwareMajorVersion, result.firmwareMinorVersion);
+        }
+        if (!text.isEmpty()) {
+            QVariantMap row;
+            row[QStringLiteral("time")] = timestampSecs;
+            row[QStringLiteral("text")] = text;
+            result.messages.append(row);
+        }
+    } else if (record.kind == MessageKind::Mode) {
+        QString modeName = values.value(QStringLiteral("Mode")).toString();
+        bool isNumeric = false;
+        const int modeNumber = modeName.toInt(&isNumeric);
+        if (isNumeric) {
+            modeName = _ardupilotModeName(result.detectedVehicleType, modeNumber);
+        } else if (modeName.isEmpty()) {
+            modeName = QCoreApplication::translate("LogFileParser", "Unknown");
+        }
+        _appendEvent(result.events, timestampSecs, QStringLiteral("mode"),
+                     QCoreApplication::translate("LogFileParser", "Mode: %1").arg(modeName));
+        if (timestampSecs >= 0.0) {
+            if (modes.hasOpenSegment && (timestampSecs > modes.segmentStartSecs)) {
+                QVariantMap segment;
+                segment[QStringLiteral("mode")] = modes.currentModeName;
+                segment[QStringLiteral("start")] = modes.segmentStartSecs;
+                segment[QStringLiteral("end")] = timestampSecs;
+                result.modeSegments.append(segment);
+            }
+            modes.hasOpenSegment = true;
+            modes.segmentStartSecs = timestampSecs;
+            modes.currentModeName = modeName;
+        }
+    } else if (record.kind == MessageKind::Err) {
+        const int subsystem = values.value(QStringLiteral("Subsys")).toInt();
+        const int ecode = values.value(QStringLiteral("ECode")).toInt();
+        _appendEvent(result.events, timestampSecs, QStringLiteral("error"),
+                     _ardupilotErrDescription(subsystem, ecode));
+    } else if (record.kind == MessageKind::Ev) {
+        const int eventId = values.value(QStringLiteral("Id"), values.value(QStringLiteral("Event"))).toInt();
+        _appendEvent(result.events, timestampSecs, QStringLiteral("event"),
+                     _ardupilotEventDescription(eventId));
+    }
+}
+
 } // namespace
 
 namespace DataFlashParser {
 
-LogParseResult parseFile(const QString &filePath, const ProgressCallback &progressCallback, const CancelToken &cancelToken)
+LogParseResult parseFile(const QString &filePath, const ProgressCallback &progressCallback, const CancelToken &cancelToken, qint64 chunkSize)
 {
     LogParseResult result;
     result.sourceType = LogParseResult::SourceType::APMDataFlash;
@@ -288,160 +490,98 @@ LogParseResult parseFile(const QString &filePath, const ProgressCallback &progre
         return result;
     }
 
-    QSet<QString> fieldSet;
-    QSet<QString> plottableFieldSet;
-    double minTimestampSecs = -1.0;
-    double maxTimestampSecs = -1.0;
-    bool hasOpenModeSegment = false;
-    double modeSegmentStartSecs = -1.0;
-    QString currentModeName;
-
-    QHash<uint8_t, QHash<QString, QString>> fieldNameByCol;
-    fieldNameByCol.reserve(formats.size());
+    std::array<MessageKind, 256> kinds;
+    kinds.fill(MessageKind::Other);
+    std::array<const APMDataFlashUtility::MessageFormat *, 256> formatsByType{};
     for (auto fmtIt = formats.cbegin(); fmtIt != formats.cend(); ++fmtIt) {
-        const APMDataFlashUtility::MessageFormat &fmt = fmtIt.value();
-        QHash<QString, QString> &perCol = fieldNameByCol[fmtIt.key()];
-        perCol.reserve(fmt.columns.size());
-        for (const QString &col : fmt.columns) {
-            perCol.insert(col, fmt.name + QLatin1Char('.') + col);
-        }
+        kinds[fmtIt.key()] = _messageKind(fmtIt.value().name);
+        formatsByType[fmtIt.key()] = &fmtIt.value();
     }
 
-    static const QString kPARM = QStringLiteral("PARM");
-    static const QString kMSG  = QStringLiteral("MSG");
-    static const QString kMODE = QStringLiteral("MODE");
-    static const QString kERR  = QStringLiteral("ERR");
-    static const QString kEV   = QStringLiteral("EV");
-    static const QString kGPS  = QStringLiteral("GPS");
-    static const QString kGPS2 = QStringLiteral("GPS2");
-
-    APMDataFlashUtility::iterateMessages(bytes.constData(), bytes.size(), formats,
-        [&](uint8_t msgType, const char *payload, int, const APMDataFlashUtility::MessageFormat &fmt) {
-        const QMap<QString, QVariant> values = APMDataFlashUtility::parseMessage(payload, fmt);
-        const double timestampSecs = _extractTimestampSeconds(values);
-        if (timestampSecs >= 0.0) {
-            if (minTimestampSecs < 0.0 || timestampSecs < minTimestampSecs) { minTimestampSecs = timestampSecs; }
-            maxTimestampSecs = std::max(maxTimestampSecs, timestampSecs);
-        }
+    // Phase one: split the log at message boundaries. Phase two: decode the chunks in parallel. Numeric columns go
+    // straight into per-chunk sample stores; the few message types that feed parameters, messages and events are only
+    // noted, and replayed in file order once every chunk is done since they depend on what came before them.
+    QList<LogParseChunk> chunks;
+    const QList<qint64> boundaries = APMDataFlashUtility::findChunkBoundaries(bytes.constData(), bytes.size(), formats, chunkSize);
+    for (qsizetype i = 0; i < boundaries.size(); i++) {
+        chunks.append(LogParseChunk{boundaries.at(i), (i + 1 < boundaries.size()) ? boundaries.at(i + 1) : fileSize});
+    }
 
-        if ((fmt.name == kGPS || fmt.name == kGPS2) && result.startTime.isNull()
-                && values.contains(QStringLiteral("GWk")) && values.contains(QStringLiteral("GMS"))
-                && timestampSecs >= 0.0) {
-            const int gwk = values.value(QStringLiteral("GWk")).toInt();
-            const int gms = values.value(QStringLiteral("GMS")).toInt();
-            if (gwk > 2000) {
-                const double gpsSecs = 315964800.0 + (7.0 * 24 * 60 * 60) * gwk + (gms / 1000.0);
-                const QDateTime gpsDateTime = QDateTime::fromMSecsSinceEpoch(
-                    static_cast<qint64>(gpsSecs * 1000.0), QTimeZone::utc());
-                const int leapSecs = _leapSecondsGPS(gpsDateTime.date().year(), gpsDateTime.date().month());
-                const double utcSecs = gpsSecs - leapSecs;
-                result.startTime = QDateTime::fromMSecsSinceEpoch(
-                    static_cast<qint64>((utcSecs - timestampSecs) * 1000.0), QTimeZone::utc());
-            }
-        }
+    std::deque<DecodedChunk> decoded;
+    for (qsizetype i = 0; i < chunks.size(); i++) {
+        (void) decoded.emplace_back(formats);
+    }
 
-        if (fmt.name == kPARM) {
-            const QString paramName = values.value(QStringLiteral("Name")).toString();
-            const QVariant paramValue = values.contains(QStringLiteral("Value"))
-                ? values.value(QStringLiteral("Value"))
-                : values.value(QStringLiteral("Val"));
-            if (!paramName.isEmpty()) {
-                QVariantMap row;
-                row[QStringLiteral("name")]         = paramName;
-                row[QStringLiteral("value")]        = paramValue;
-                // DataFlash logs don't carry default value metadata
-                row[QStringLiteral("isFloat")]      = paramValue.metaType() == QMetaType::fromType<float>()
-                                                      || paramValue.metaType() == QMetaType::fromType<double>();
-                row[QStringLiteral("hasDefault")]   = false;
-                row[QStringLiteral("defaultValue")] = QVariant();
-                row[QStringLiteral("isDefault")]    = false;
-                result.parameters.append(row);
-            }
-        } else if (fmt.name == kMSG) {
-            const QString text = values.value(QStringLiteral("Message")).toString();
-            const QString detected = _vehicleTypeFromMessageText(text);
-            if (result.detectedVehicleType.isEmpty() && !detected.isEmpty()) {
-                result.detectedVehicleType = detected;
-                _parseFirmwareVersionFromMessageText(text, result.firmwareMajorVersion, result.firmwareMinorVersion);
-            }
-            if (!text.isEmpty()) {
-                QVariantMap row;
-                row[QStringLiteral("time")] = timestampSecs;
-                row[QStringLiteral("text")] = text;
-                result.messages.append(row);
-            }
-        } else if (fmt.name == kMODE) {
-            QString modeName = values.value(QStringLiteral("Mode")).toString();
-            bool isNumeric = false;
-            const int modeNumber = modeName.toInt(&isNumeric);
-            if (isNumeric) {
-                modeName = _ardupilotModeName(result.detectedVehicleType, modeNumber);
-            } else if (modeName.isEmpty()) {
-                modeName = QCoreApplication::translate("LogFileParser", "Unknown");
-            }
-            _appendEvent(result.events, timestampSecs, QStringLiteral("mode"),
-                         QCoreApplication::translate("LogFileParser", "Mode: %1").arg(modeName));
+    decodeLogChunks(chunks, fileSize, progressCallback, cancelToken, [&](int index, const ProgressCallback &chunkProgress) {
+        DecodedChunk &chunk = decoded[static_cast<size_t>(index)];
+        const LogParseChunk &range = chunks.at(index);
+        APMDataFlashUtility::iterateMessages(bytes.constData() + range.begin, range.size(), formats,
+            [&](uint8_t msgType, const char *payload, int, const APMDataFlashUtility::MessageFormat &fmt) {
+            const double timestampSecs = chunk.decoder.timestampSeconds(msgType, payload);
             if (timestampSecs >= 0.0) {
-                if (hasOpenModeSegment && (timestampSecs > modeSegmentStartSecs)) {
-                    QVariantMap segment;
-                    segment[QStringLiteral("mode")] = currentModeName;
-                    segment[QStringLiteral("start")] = modeSegmentStartSecs;
-                    segment[QStringLiteral("end")] = timestampSecs;
-                    result.modeSegments.append(segment);
+                if (chunk.minTimestampSecs < 0.0 || timestampSecs < chunk.minTimestampSecs) { chunk.minTimestampSecs = timestampSecs; }
+                chunk.maxTimestampSecs = std::max(chunk.maxTimestampSecs, timestampSecs);
+            }
+
+            const MessageKind kind = kinds[msgType];
+            if (kind == MessageKind::Gps) {
+                if (chunk.startTime.isNull()) {
+                    chunk.startTime = _startTimeFromGps(APMDataFlashUtility::parseMessage(payload, fmt), timestampSecs);
                 }
-                hasOpenModeSegment = true;
-                modeSegmentStartSecs = timestampSecs;
-                currentModeName = modeName;
+            } else if (kind != MessageKind::Other) {
+                chunk.records.append(DecodedChunk::Record{kind, payload, formatsByType[msgType], timestampSecs});
             }
-        } else if (fmt.name == kERR) {
-            const int subsystem = values.value(QStringLiteral("Subsys")).toInt();
-            const int ecode = values.value(QStringLiteral("ECode")).toInt();
-            _appendEvent(result.events, timestampSecs, QStringLiteral("error"),
-                         _ardupilotErrDescription(subsystem, ecode));
-        } else if (fmt.name == kEV) {
-            const int eventId = values.value(QStringLiteral("Id"), values.value(QStringLiteral("Event"))).toInt();
-            _appendEvent(result.events, timestampSecs, QStringLiteral("event"),
-                         _ardupilotEventDescription(eventId));
-        }
 
-        result.sampleCount++;
-
-        const QHash<QString, QString> &perCol = fieldNameByCol[msgType];
-        const bool haveTimestamp = (timestampSecs >= 0.0);
-        for (auto it = values.cbegin(); it != values.cend(); ++it) {
-            const auto nameIt = perCol.constFind(it.key());
-            if (nameIt == perCol.constEnd()) { continue; }
-            const QString &fieldName = nameIt.value();
-            fieldSet.insert(fieldName);
-            if (!haveTimestamp) { continue; }
-            const int typeId = it.value().metaType().id();
-            const bool numeric =
-                (typeId == QMetaType::Int) || (typeId == QMetaType::UInt) ||
-                (typeId == QMetaType::LongLong) || (typeId == QMetaType::ULongLong) ||
-                (typeId == QMetaType::Float) || (typeId == QMetaType::Double);
-            if (numeric) {
-                result.fieldSamples[fieldName].append(QPointF(timestampSecs, it.value().toDouble()));
-                plottableFieldSet.insert(fieldName);
+            chunk.sampleCount++;
+
+            chunk.decoder.markSeen(msgType);
+            if (timestampSecs >= 0.0) {
+                chunk.store(msgType, payload, fmt, timestampSecs);
             }
-        }
-        return !cancelToken || !cancelToken->load(std::memory_order_relaxed);
-    }, progressCallback);
+            return !cancelToken || !cancelToken->load(std::memory_order_relaxed);
+        }, chunkProgress);
+    });
 
     if (cancelToken && cancelToken->load(std::memory_order_relaxed)) {
         return result; // cancelled; ok remains false
     }
 
-    if (hasOpenModeSegment && (maxTimestampSecs >= modeSegmentStartSecs)) {
+    double minTimestampSecs = -1.0;
+    double maxTimestampSecs = -1.0;
+    ModeTracker modes;
+    QSet<QString> fieldNames;
+    for (DecodedChunk &chunk : decoded) {
+        for (const DecodedChunk::Record &record : std::as_const(chunk.records)) {
+            _applyRecord(record, result, modes);
+        }
+        if (result.startTime.isNull()) {
+            result.startTime = chunk.startTime;
+        }
+        if (chunk.minTimestampSecs >= 0.0 && (minTimestampSecs < 0.0 || chunk.minTimestampSecs < minTimestampSecs)) {
+            minTimestampSecs = chunk.minTimestampSecs;
+        }
+        maxTimestampSecs = std::max(maxTimestampSecs, chunk.maxTimestampSecs);
+        result.sampleCount += chunk.sampleCount;
+
+        const QStringList names = chunk.decoder.fieldNames();
+        fieldNames.unite(QSet<QString>(names.cbegin(), names.cend()));
+        // Chunks are appended in the order their samples were logged in
+        result.samples.append(chunk.samples);
+    }
+    decoded.clear();
+
+    if (modes.hasOpenSegment && (maxTimestampSecs >= modes.segmentStartSecs)) {
         QVariantMap segment;
-        segment[QStringLiteral("mode")] = currentModeName;
-        segment[QStringLiteral("start")] = modeSegmentStartSecs;
+        segment[QStringLiteral("mode")] = modes.currentModeName;
+        segment[QStringLiteral("start")] = modes.segmentStartSecs;
         segment[QStringLiteral("end")] = maxTimestampSecs;
         result.modeSegments.append(segment);
     }
 
-    result.availableFields = fieldSet.values();
+    result.samples.squeeze();
+    result.availableFields = fieldNames.values();
     std::sort(result.availableFields.begin(), result.availableFields.end());
-    result.plottableFields = plottableFieldSet.values();
+    result.plottableFields = result.samples.seriesNames();
     std::sort(result.plottableFields.begin(), result.plottableFields.end());
     result.minTimestamp = minTimestampSecs;
     result.maxTimestamp = maxTimestampSecs;
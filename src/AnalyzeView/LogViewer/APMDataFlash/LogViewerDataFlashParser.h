@@ -1,5 +1,6 @@
 #pragma once
 
+#include "LogParseChunks.h"
 #include "LogParseResultPrivate.h"
 // Note: named LogViewerDataFlashParser to avoid collision with GeoTag/DataFlashParser.h
 
@@ -7,7 +8,8 @@
 
 // Free-function parser for ArduPilot DataFlash (.bin / .log) files.
 // Returns a filled LogParseResult on success (result.ok == true) or an error
-// message in result.errorMessage on failure.
+// message in result.errorMessage on failure. Logs larger than chunkSize are
+// decoded in chunks of about that size in parallel.
 namespace DataFlashParser {
-    LogParseResult parseFile(const QString &filePath, const ProgressCallback &progressCallback = nullptr, const CancelToken &cancelToken = nullptr);
+    LogParseResult parseFile(const QString &filePath, const ProgressCallback &progressCallback = nullptr, const CancelToken &cancelToken = nullptr, qint64 chunkSize = kLogParseChunkSize);
 }
@@ -162,7 +162,8 @@ void LogFileParser::_applyResult(const LogParseResult &result)
             _modeNames.append(mode);
         }
     }
-    _fieldSamples = result.fieldSamples;
+    _samples = result.samples;
+    _pyramids.clear();
     _sampleCount = result.sampleCount;
     _detectedVehicleType = result.detectedVehicleType;
     emit availableFieldsChanged();
@@ -180,6 +181,12 @@ void LogFileParser::_applyResult(const LogParseResult &result)
         emit timeRangeChanged();
     }
     emit sampleCountChanged();
+    const qint64 sampleMemoryBytes = _samples.memoryUsage();
+    qCDebug(LogFileParserLog) << "Sample store" << _samples.seriesNames().size() << "series" << sampleMemoryBytes << "bytes";
+    if (_sampleMemoryBytes != sampleMemoryBytes) {
+        _sampleMemoryBytes = sampleMemoryBytes;
+        emit sampleMemoryBytesChanged();
+    }
     if (_startTime != result.startTime) {
         _startTime = result.startTime;
         emit startTimeChanged();
@@ -215,7 +222,9 @@ void LogFileParser::clear()
     if (!_detectedVehicleType.isEmpty()) { _detectedVehicleType.clear(); emit detectedVehicleTypeChanged(); }
     if (!_plottableFields.isEmpty()) { _plottableFields.clear(); emit plottableFieldsChanged(); }
 
-    _fieldSamples.clear();
+    _pyramids.clear();
+    _samples.clear();
+    if (_sampleMemoryBytes != 0) { _sampleMemoryBytes = 0; emit sampleMemoryBytesChanged(); }
     _gpsLatField.clear();
     _gpsLonField.clear();
     _gpsAltField.clear();
@@ -232,118 +241,110 @@ void LogFileParser::clear()
 QVariantList LogFileParser::fieldSamples(const QString &fieldName) const
 {
     QVariantList output;
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend()) { return output; }
-    const QVector<QPointF> &points = it.value();
-    output.reserve(points.size());
-    for (const QPointF &p : points) { output.append(p); }
+    const LogSampleStore::Series samples = _samples.series(fieldName);
+    output.reserve(samples.size());
+    for (qsizetype i = 0; i < samples.size(); i++) { output.append(samples.point(i)); }
     return output;
 }
 
 QVariantMap LogFileParser::fieldMinMax(const QString &fieldName) const
 {
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend() || it->isEmpty()) { return {}; }
-    const QVector<QPointF> &points = it.value();
+    const LogSampleStore::Series samples = _samples.series(fieldName);
+    if (samples.isEmpty()) { return {}; }
     double minY = std::numeric_limits<double>::max();
     double maxY = std::numeric_limits<double>::lowest();
-    for (const QPointF &p : points) {
-        if (p.y() < minY) minY = p.y();
-        if (p.y() > maxY) maxY = p.y();
+    for (qsizetype i = 0; i < samples.size(); i++) {
+        const double y = samples.value(i);
+        if (y < minY) minY = y;
+        if (y > maxY) maxY = y;
     }
     return QVariantMap{{QStringLiteral("min"), minY}, {QStringLiteral("max"), maxY}};
 }
 
-QVariantList LogFileParser::fieldSamplesFiltered(const QString &fieldName, double minX, double maxX, int pixelWidth) const
+QList<QPointF> LogFileParser::fieldSamplesFiltered(const QString &fieldName, double minX, double maxX, int pixelWidth) const
 {
-    QVariantList output;
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend() || pixelWidth <= 0 || maxX <= minX) { return output; }
-
-    const QVector<QPointF> &points = it.value();
+    QList<QPointF> output;
+    const int seriesId = _samples.seriesId(fieldName);
+    const LogSampleStore::Series samples = _samples.series(seriesId);
+    if (samples.isEmpty() || pixelWidth <= 0 || maxX <= minX) { return output; }
 
     // Find the slice within [minX, maxX]
-    const auto sliceBegin = std::lower_bound(points.cbegin(), points.cend(), minX,
-        [](const QPointF &p, double t) { return p.x() < t; });
-    const auto sliceEnd = std::upper_bound(sliceBegin, points.cend(), maxX,
-        [](double t, const QPointF &p) { return t < p.x(); });
+    const double *const times = samples.times();
+    const qsizetype sliceBegin = std::lower_bound(times, times + samples.size(), minX) - times;
+    const qsizetype sliceEnd = std::upper_bound(times + sliceBegin, times + samples.size(), maxX) - times;
 
-    const qsizetype sliceCount = std::distance(sliceBegin, sliceEnd);
+    const qsizetype sliceCount = sliceEnd - sliceBegin;
     if (sliceCount == 0) { return output; }
 
     // If already sparse enough, return slice as-is
     if (sliceCount <= 4 * pixelWidth) {
         output.reserve(sliceCount);
-        for (auto jt = sliceBegin; jt != sliceEnd; ++jt) { output.append(*jt); }
+        for (qsizetype i = sliceBegin; i < sliceEnd; ++i) { output.append(samples.point(i)); }
         return output;
     }
 
-    // Screen-space min/max bucketing: one bucket per pixel column.
-    // For each column track first, min-y, max-y, last indices; flush in time order.
+    // Screen-space min/max bucketing: one bucket per pixel column, holding its first, min-y, max-y and last
+    // samples in time order. Column edges are found by binary search and the extremes between them by the
+    // series' min/max pyramid, so the cost follows pixelWidth rather than the number of samples in view.
+    const LogSamplePyramid &pyramid = _pyramid(seriesId);
     output.reserve(4 * pixelWidth);
     const double range = maxX - minX;
 
     auto columnOf = [&](double x) -> int {
-        return static_cast<int>((x - minX) / range * pixelWidth);
+        return std::clamp(static_cast<int>((x - minX) / range * pixelWidth), 0, pixelWidth - 1);
     };
 
-    // Per-column state
-    int    curCol   = -1;
-    qsizetype firstIdx = -1;
-    qsizetype minIdx   = -1;
-    qsizetype maxIdx   = -1;
-    qsizetype lastIdx  = -1;
-
-    auto flush = [&]() {
-        if (firstIdx < 0) return;
-        // Collect the up-to-4 representative indices in time order, deduplicated
-        qsizetype indices[4] = { firstIdx, minIdx, maxIdx, lastIdx };
+    qsizetype columnBegin = sliceBegin;
+    while (columnBegin < sliceEnd) {
+        const int col = columnOf(times[columnBegin]);
+        const qsizetype columnEnd = std::partition_point(times + columnBegin, times + sliceEnd,
+            [&](double t) { return columnOf(t) == col; }) - times;
+
+        qsizetype minIdx = -1;
+        qsizetype maxIdx = -1;
+        pyramid.minMax(columnBegin, columnEnd, minIdx, maxIdx);
+
+        // Up to 4 representative indices in time order, deduplicated
+        qsizetype indices[4] = { columnBegin, minIdx, maxIdx, columnEnd - 1 };
         std::sort(indices, indices + 4);
         qsizetype prev = -1;
         for (qsizetype idx : indices) {
             if (idx != prev) {
-                output.append(*(sliceBegin + idx));
+                output.append(samples.point(idx));
                 prev = idx;
             }
         }
-    };
-
-    for (qsizetype i = 0; i < sliceCount; ++i) {
-        const QPointF &p = *(sliceBegin + i);
-        const int col = std::clamp(columnOf(p.x()), 0, pixelWidth - 1);
-        if (col != curCol) {
-            flush();
-            curCol   = col;
-            firstIdx = i;
-            minIdx   = i;
-            maxIdx   = i;
-        } else {
-            if (p.y() < (sliceBegin + minIdx)->y()) minIdx = i;
-            if (p.y() > (sliceBegin + maxIdx)->y()) maxIdx = i;
-        }
-        lastIdx = i;
+        columnBegin = columnEnd;
     }
-    flush();
 
     return output;
 }
 
+const LogSamplePyramid &LogFileParser::_pyramid(int seriesId) const
+{
+    auto it = _pyramids.find(seriesId);
+    if (it == _pyramids.end()) {
+        it = _pyramids.emplace(seriesId, _samples.series(seriesId));
+        qCDebug(LogFileParserLog) << "Built min/max pyramid for series" << seriesId << it->memoryUsage() << "bytes";
+    }
+    return it.value();
+}
+
 double LogFileParser::fieldValueAt(const QString &fieldName, double timestampSeconds) const
 {
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend() || it->isEmpty()) {
+    const LogSampleStore::Series samples = _samples.series(fieldName);
+    if (samples.isEmpty()) {
         return std::numeric_limits<double>::quiet_NaN();
     }
-    const QVector<QPointF> &points = it.value();
-    const auto lower = std::lower_bound(points.cbegin(), points.cend(), timestampSeconds,
-        [](const QPointF &p, double t) { return p.x() < t; });
+    const double *const times = samples.times();
+    const qsizetype lower = std::lower_bound(times, times + samples.size(), timestampSeconds) - times;
 
-    if (lower == points.cbegin()) { return lower->y(); }
-    if (lower == points.cend()) { return points.constLast().y(); }
+    if (lower == 0) { return samples.value(0); }
+    if (lower == samples.size()) { return samples.value(samples.size() - 1); }
 
-    const auto prev = std::prev(lower);
-    return (std::fabs(prev->x() - timestampSeconds) <= std::fabs(lower->x() - timestampSeconds))
-        ? prev->y() : lower->y();
+    const qsizetype prev = lower - 1;
+    return (std::fabs(times[prev] - timestampSeconds) <= std::fabs(times[lower] - timestampSeconds))
+        ? samples.value(prev) : samples.value(lower);
 }
 
 QString LogFileParser::modeColor(const QString &modeName) const
@@ -419,24 +420,18 @@ QVariantMap LogFileParser::gpsCoordAt(double timestampSeconds) const
         return {};
     }
 
-    const auto latIt = _fieldSamples.constFind(_gpsLatField);
-    const auto lonIt = _fieldSamples.constFind(_gpsLonField);
-    if (latIt == _fieldSamples.cend() || lonIt == _fieldSamples.cend()) {
-        return {};
-    }
-
-    const QVector<QPointF> &latPts = latIt.value();
-    const QVector<QPointF> &lonPts = lonIt.value();
+    const LogSampleStore::Series latPts = _samples.series(_gpsLatField);
+    const LogSampleStore::Series lonPts = _samples.series(_gpsLonField);
     if (latPts.isEmpty() || lonPts.isEmpty()) {
         return {};
     }
 
     // Binary search for the sample with timestamp closest to timestampSeconds.
-    int lo = 0;
-    int hi = latPts.size() - 1;
+    qsizetype lo = 0;
+    qsizetype hi = latPts.size() - 1;
     while (lo < hi) {
-        const int mid = (lo + hi) / 2;
-        if (latPts[mid].x() < timestampSeconds) {
+        const qsizetype mid = (lo + hi) / 2;
+        if (latPts.time(mid) < timestampSeconds) {
             lo = mid + 1;
         } else {
             hi = mid;
@@ -444,17 +439,17 @@ QVariantMap LogFileParser::gpsCoordAt(double timestampSeconds) const
     }
     // lo is the first index >= timestampSeconds; compare with lo-1.
     if (lo > 0) {
-        const double dPrev = timestampSeconds - latPts[lo - 1].x();
-        const double dCurr = latPts[lo].x() - timestampSeconds;
+        const double dPrev = timestampSeconds - latPts.time(lo - 1);
+        const double dCurr = latPts.time(lo) - timestampSeconds;
         if (dPrev < dCurr) {
             --lo;
         }
     }
 
-    const int lonIdx = std::min(lo, static_cast<int>(lonPts.size()) - 1);
+    const qsizetype lonIdx = std::min(lo, lonPts.size() - 1);
     QVariantMap coord;
-    coord[QStringLiteral("latitude")]  = latPts[lo].y();
-    coord[QStringLiteral("longitude")] = lonPts[lonIdx].y();
+    coord[QStringLiteral("latitude")]  = latPts.value(lo);
+    coord[QStringLiteral("longitude")] = lonPts.value(lonIdx);
     return coord;
 }
 
@@ -489,44 +484,33 @@ QVariantList LogFileParser::gpsPath() const
     };
 
     for (const auto &c : candidates) {
-        const auto latIt = _fieldSamples.constFind(QLatin1String(c.latField));
-        const auto lonIt = _fieldSamples.constFind(QLatin1String(c.lonField));
-        if (latIt == _fieldSamples.cend() || lonIt == _fieldSamples.cend()) {
-            continue;
-        }
-
-        const QVector<QPointF> &latPts = latIt.value();
-        const QVector<QPointF> &lonPts = lonIt.value();
+        const LogSampleStore::Series latPts = _samples.series(QLatin1String(c.latField));
+        const LogSampleStore::Series lonPts = _samples.series(QLatin1String(c.lonField));
         if (latPts.isEmpty() || lonPts.isEmpty()) {
             continue;
         }
 
-        // Resolve optional status field (same message, same sample count as lat/lon).
-        const QVector<QPointF> *statusPts = nullptr;
-        if (c.statusField) {
-            const auto statusIt = _fieldSamples.constFind(QLatin1String(c.statusField));
-            if (statusIt != _fieldSamples.cend() && !statusIt.value().isEmpty()) {
-                statusPts = &statusIt.value();
-            }
-        }
+        // Optional status field (same message, same sample count as lat/lon); empty if absent.
+        const LogSampleStore::Series statusPts = c.statusField
+            ? _samples.series(QLatin1String(c.statusField)) : LogSampleStore::Series();
 
         qCDebug(LogFileParserLog) << "gpsPath: found candidate" << c.latField
             << "samples:" << latPts.size()
-            << "first lat:" << latPts.first().y()
-            << "first lon:" << lonPts.first().y();
+            << "first lat:" << latPts.value(0)
+            << "first lon:" << lonPts.value(0);
 
         QVariantList path;
-        const int n = std::min(latPts.size(), lonPts.size());
+        const qsizetype n = std::min(latPts.size(), lonPts.size());
         path.reserve(n);
 
-        for (int i = 0; i < n; i++) {
+        for (qsizetype i = 0; i < n; i++) {
             // Skip samples that don't have a valid GPS fix.
-            if (statusPts && i < statusPts->size() && (*statusPts)[i].y() < c.statusMinValue) {
+            if (i < statusPts.size() && statusPts.value(i) < c.statusMinValue) {
                 continue;
             }
 
-            const double lat = latPts[i].y();
-            const double lon = lonPts[i].y();
+            const double lat = latPts.value(i);
+            const double lon = lonPts.value(i);
 
             if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0
                     || (qFuzzyIsNull(lat) && qFuzzyIsNull(lon))) {
@@ -546,8 +530,7 @@ QVariantList LogFileParser::gpsPath() const
             // Only cache the alt field if it actually exists and has samples;
             // otherwise the altitude chart would be shown with no data.
             const QLatin1String altField(c.altField);
-            const auto altIt = _fieldSamples.constFind(altField);
-            _gpsAltField = (altIt != _fieldSamples.cend() && !altIt.value().isEmpty()) ? altField : QLatin1String{};
+            _gpsAltField = !_samples.series(altField).isEmpty() ? altField : QLatin1String{};
             return path;
         }
 
@@ -555,11 +538,11 @@ QVariantList LogFileParser::gpsPath() const
     }
 
     qCDebug(LogFileParserLog) << "gpsPath: no GPS data found; available fields containing 'lat' or 'lon':";
-    for (auto it = _fieldSamples.cbegin(); it != _fieldSamples.cend(); ++it) {
-        const QString &fn = it.key();
+    for (const QString &fn : _plottableFields) {
         if (fn.contains(QLatin1String("lat"), Qt::CaseInsensitive) || fn.contains(QLatin1String("lon"), Qt::CaseInsensitive)) {
-            qCDebug(LogFileParserLog) << " " << fn << "samples:" << it.value().size()
-                << (it.value().isEmpty() ? 0.0 : it.value().first().y());
+            const LogSampleStore::Series samples = _samples.series(fn);
+            qCDebug(LogFileParserLog) << " " << fn << "samples:" << samples.size()
+                << (samples.isEmpty() ? 0.0 : samples.value(0));
         }
     }
     return {};
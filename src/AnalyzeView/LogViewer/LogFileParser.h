@@ -1,6 +1,9 @@
 #pragma once
 
+#include "LogSampleStore.h"
+
 #include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QObject>
 #include <QtCore/QPointF>
 #include <QtCore/QString>
@@ -8,7 +11,6 @@
 #include <QtCore/QVariant>
 #include <QtCore/QVariantList>
 #include <QtCore/QDateTime>
-#include <QtCore/QVector>
 #include <QtCore/QtGlobal>
 #include <QtQmlIntegration/QtQmlIntegration>
 
@@ -22,7 +24,8 @@
 /// viewer UI consumes identically for both formats:
 ///
 ///  - availableFields / plottableFields — two-level "Type.Field" hierarchy
-///  - fieldSamples(name) — time-series (QPointF) for charting
+///  - fieldSamples(name) — time-series (QPointF) for charting, read from a columnar LogSampleStore
+///  - sampleMemoryBytes — bytes the stored samples take
 ///  - modeSegments — flight-mode bands for the chart timeline
 ///  - events — timestamped events / errors / warnings
 ///  - parameters — parameter name/value pairs from the log
@@ -51,6 +54,7 @@ class LogFileParser : public QObject
     Q_PROPERTY(double       maxTimestamp        READ maxTimestamp        NOTIFY timeRangeChanged)
     Q_PROPERTY(int          sampleCount         READ sampleCount         NOTIFY sampleCountChanged)
     Q_PROPERTY(QDateTime    startTime           READ startTime           NOTIFY startTimeChanged)
+    Q_PROPERTY(qint64       sampleMemoryBytes   READ sampleMemoryBytes   NOTIFY sampleMemoryBytesChanged)
 
 public:
     explicit LogFileParser(QObject *parent = nullptr);
@@ -71,6 +75,7 @@ class LogFileParser : public QObject
     double maxTimestamp() const { return _maxTimestamp; }
     int sampleCount() const { return _sampleCount; }
     QDateTime startTime() const { return _startTime; }
+    qint64 sampleMemoryBytes() const { return _sampleMemoryBytes; }
     bool parsing() const { return _parsing; }
     float parseProgress() const { return _parseProgress; }
 
@@ -78,7 +83,9 @@ class LogFileParser : public QObject
     Q_INVOKABLE void startParsingAsync(const QString &filePath);
     Q_INVOKABLE void clear();
     Q_INVOKABLE QVariantList fieldSamples(const QString &fieldName) const;
-    Q_INVOKABLE QVariantList fieldSamplesFiltered(const QString &fieldName, double minX, double maxX, int pixelWidth) const;
+    /// Samples of @p fieldName in [@p minX, @p maxX], reduced to at most the first, min, max and last sample of each
+    /// of @p pixelWidth columns. Answered in O(pixelWidth log n) from a min/max pyramid built on first use.
+    Q_INVOKABLE QList<QPointF> fieldSamplesFiltered(const QString &fieldName, double minX, double maxX, int pixelWidth) const;
     Q_INVOKABLE QVariantMap  fieldMinMax(const QString &fieldName) const;
     Q_INVOKABLE double fieldValueAt(const QString &fieldName, double timestampSeconds) const;
     Q_INVOKABLE QString modeAt(double timestampSeconds) const;
@@ -115,6 +122,7 @@ class LogFileParser : public QObject
     void timeRangeChanged();
     void sampleCountChanged();
     void startTimeChanged();
+    void sampleMemoryBytesChanged();
     void parsingChanged();
     void parseProgressChanged();
     void parseFileFinished(const QString &filePath, bool ok, const QString &errorMessage);
@@ -122,6 +130,7 @@ class LogFileParser : public QObject
 private:
     void _setParseError(const QString &error);
     void _applyResult(const struct LogParseResult &result);
+    const LogSamplePyramid &_pyramid(int seriesId) const;
 
     bool _parseComplete = false;
     QString _parseError;
@@ -133,7 +142,9 @@ class LogFileParser : public QObject
     QVariantList _modeSegments;
     QVariantList _dropouts;
     QString _detectedVehicleType;
-    QHash<QString, QVector<QPointF>> _fieldSamples;
+    LogSampleStore _samples;
+    mutable QHash<int, LogSamplePyramid> _pyramids;     ///< By series id, built by fieldSamplesFiltered()
+    qint64 _sampleMemoryBytes = 0;
     double _minTimestamp = -1.0;
     double _maxTimestamp = -1.0;
     int _sampleCount = 0;
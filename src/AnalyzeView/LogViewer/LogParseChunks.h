@@ -0,0 +1,64 @@
+#pragma once
+
+// Private implementation detail shared by the DataFlash and ULog parsers.
+// Do NOT include this header from any public-facing header.
+
+#include "LogParseResultPrivate.h"
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtCore/QList>
+
+#include <mutex>
+#include <numeric>
+
+/// Byte range [begin, end) of a log file that starts and ends on message boundaries, so it decodes on its own
+/// given the log's definitions.
+struct LogParseChunk {
+    qint64 begin = 0;
+    qint64 end = 0;
+
+    qint64 size() const { return end - begin; }
+};
+
+/// Logs are split into chunks of about this many bytes; a smaller log is decoded in one piece.
+constexpr qint64 kLogParseChunkSize = 16 * 1024 * 1024;
+
+/// Runs @p decodeChunk(index, chunkProgress) for every chunk on the global thread pool, the calling thread
+/// included, and returns once all of them are done. Chunks finish in any order; merging their results in index
+/// order is up to the caller. A chunk reports its own progress as a fraction of its bytes through
+/// chunkProgress; @p progressCallback receives the fraction of all @p totalBytes decoded so far, never
+/// decreasing. Chunks not yet started are skipped once @p cancelToken is set.
+template<typename DecodeChunk>
+void decodeLogChunks(const QList<LogParseChunk> &chunks, qint64 totalBytes, const ProgressCallback &progressCallback,
+                     const CancelToken &cancelToken, DecodeChunk decodeChunk)
+{
+    std::mutex progressMutex;
+    QList<qint64> chunkDone(chunks.size(), 0);
+    qint64 totalDone = 0;
+
+    const auto reportProgress = [&](int index, float fraction) {
+        if (!progressCallback || (totalBytes <= 0)) {
+            return;
+        }
+        const qint64 done = static_cast<qint64>(static_cast<double>(chunks.at(index).size()) * fraction);
+        const std::lock_guard<std::mutex> lock(progressMutex);
+        if (done > chunkDone.at(index)) {
+            totalDone += done - chunkDone.at(index);
+            chunkDone[index] = done;
+            progressCallback(static_cast<float>(totalDone) / static_cast<float>(totalBytes));
+        }
+    };
+
+    QList<int> indices(chunks.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, [&](int index) {
+        if (cancelToken && cancelToken->load(std::memory_order_relaxed)) {
+            return;
+        }
+        const ProgressCallback chunkProgress = [&reportProgress, index](float fraction) {
+            reportProgress(index, fraction);
+        };
+        decodeChunk(index, chunkProgress);
+        reportProgress(index, 1.f);
+    });
+}
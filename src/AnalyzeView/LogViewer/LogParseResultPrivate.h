@@ -3,13 +3,12 @@
 // Private implementation detail shared between LogFileParser.cc and ULogFullHandler.cc.
 // Do NOT include this header from any public-facing header.
 
+#include "LogSampleStore.h"
+
 #include <QtCore/QDateTime>
-#include <QtCore/QHash>
-#include <QtCore/QPointF>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QVariantList>
-#include <QtCore/QVector>
 
 #include <atomic>
 #include <functional>
@@ -35,7 +34,7 @@ struct LogParseResult {
     QVariantList messages;
     QVariantList modeSegments;
     QVariantList dropouts;
-    QHash<QString, QVector<QPointF>> fieldSamples;
+    LogSampleStore samples;
     double minTimestamp = -1.0;
     double maxTimestamp = -1.0;
     int sampleCount = 0;
@@ -0,0 +1,286 @@
+#include "LogSampleStore.h"
+
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// NaN never wins and loses to any number, so a gap in a series does not hide the extremes around it
+bool isLower(double candidate, double current)
+{
+    return !std::isnan(candidate) && (std::isnan(current) || (candidate < current));
+}
+
+bool isHigher(double candidate, double current)
+{
+    return !std::isnan(candidate) && (std::isnan(current) || (candidate > current));
+}
+
+} // namespace
+
+int LogSampleStore::valueSize(ValueType type)
+{
+    switch (type) {
+    case ValueType::Int8:
+    case ValueType::UInt8:
+    case ValueType::Bool:
+        return 1;
+    case ValueType::Int16:
+    case ValueType::UInt16:
+        return 2;
+    case ValueType::Int32:
+    case ValueType::UInt32:
+    case ValueType::Float:
+        return 4;
+    case ValueType::Int64:
+    case ValueType::UInt64:
+    case ValueType::Double:
+        return 8;
+    }
+    return 8;
+}
+
+int LogSampleStore::addGroup(const QString &name)
+{
+    const auto it = _groupsByName.constFind(name);
+    if (it != _groupsByName.cend()) {
+        return it.value();
+    }
+
+    const int id = static_cast<int>(_groups.size());
+    _groups.append(Group{name, {}, {}});
+    (void) _groupsByName.insert(name, id);
+    return id;
+}
+
+int LogSampleStore::addSeries(int group, const QString &name, ValueType type, double divisor)
+{
+    const auto it = _seriesByName.constFind(name);
+    if (it != _seriesByName.cend()) {
+        return it.value();
+    }
+
+    const int id = static_cast<int>(_series.size());
+    _series.append(Column{name, group, type, valueSize(type), divisor, {}});
+    _groups[group].series.append(id);
+    (void) _seriesByName.insert(name, id);
+    // Rows logged before the series existed read 0
+    _padGroup(_groups[group]);
+    return id;
+}
+
+void LogSampleStore::append(LogSampleStore &other)
+{
+    if (isEmpty()) {
+        *this = std::move(other);
+        other.clear();
+        return;
+    }
+
+    for (Group &otherGroup : other._groups) {
+        const int groupId = addGroup(otherGroup.name);
+        Group &group = _groups[groupId];
+        const qsizetype rowsBefore = group.times.size();
+        group.times.append(otherGroup.times);
+
+        for (const int otherId : std::as_const(otherGroup.series)) {
+            Column &otherColumn = other._series[otherId];
+            const int id = addSeries(groupId, otherColumn.name, otherColumn.type, otherColumn.divisor);
+            Column &column = _series[id];
+            // A series created just now was padded to the new row count already
+            column.values.truncate(rowsBefore * column.width);
+            if (column.width == otherColumn.width) {
+                column.values.append(otherColumn.values);
+            } else {
+                column.values.append(QByteArray(otherGroup.times.size() * column.width, '\0'));
+            }
+        }
+        _padGroup(_groups[groupId]);
+    }
+
+    other.clear();
+}
+
+void LogSampleStore::_padGroup(Group &group)
+{
+    const qsizetype rows = group.times.size();
+    for (const int id : std::as_const(group.series)) {
+        Column &column = _series[id];
+        const qsizetype bytes = rows * column.width;
+        if (column.values.size() < bytes) {
+            column.values.append(QByteArray(bytes - column.values.size(), '\0'));
+        }
+    }
+}
+
+LogSampleStore::Series LogSampleStore::series(int id) const
+{
+    Series view;
+    if ((id < 0) || (id >= _series.size())) {
+        return view;
+    }
+
+    const Column &column = _series.at(id);
+    const Group &group = _groups.at(column.group);
+    view._times = group.times.constData();
+    view._values = column.values.constData();
+    view._size = group.times.size();
+    view._type = column.type;
+    view._width = column.width;
+    view._divisor = column.divisor;
+    return view;
+}
+
+LogSampleStore::Series LogSampleStore::series(const QString &name) const
+{
+    return series(seriesId(name));
+}
+
+QVector<QPointF> LogSampleStore::points(const QString &name) const
+{
+    const Series samples = series(name);
+    QVector<QPointF> result;
+    result.reserve(samples.size());
+    for (qsizetype i = 0; i < samples.size(); i++) {
+        result.append(samples.point(i));
+    }
+    return result;
+}
+
+QStringList LogSampleStore::seriesNames() const
+{
+    QStringList names;
+    for (const Column &column : _series) {
+        if (!_groups.at(column.group).times.isEmpty()) {
+            names.append(column.name);
+        }
+    }
+    return names;
+}
+
+qint64 LogSampleStore::memoryUsage() const
+{
+    qint64 bytes = 0;
+    for (const Group &group : _groups) {
+        bytes += group.times.capacity() * static_cast<qint64>(sizeof(double));
+    }
+    for (const Column &column : _series) {
+        bytes += column.values.capacity();
+    }
+    return bytes;
+}
+
+void LogSampleStore::clear()
+{
+    _groups.clear();
+    _series.clear();
+    _groupsByName.clear();
+    _seriesByName.clear();
+}
+
+void LogSampleStore::squeeze()
+{
+    for (Group &group : _groups) {
+        group.times.squeeze();
+    }
+    for (Column &column : _series) {
+        column.values.squeeze();
+    }
+}
+
+LogSamplePyramid::LogSamplePyramid(const LogSampleStore::Series &series)
+    : _series(series)
+{
+    // Indices are stored in 32 bits; a longer series is scanned instead
+    if (series.size() > std::numeric_limits<quint32>::max()) {
+        return;
+    }
+
+    const qsizetype baseBlocks = series.size() >> kBaseShift;
+    if (baseBlocks == 0) {
+        return;
+    }
+
+    Level base;
+    base.minIndex.resize(baseBlocks);
+    base.maxIndex.resize(baseBlocks);
+    for (qsizetype block = 0; block < baseBlocks; block++) {
+        const qsizetype first = block << kBaseShift;
+        qsizetype minIndex = first;
+        qsizetype maxIndex = first;
+        double minValue = series.value(first);
+        double maxValue = minValue;
+        for (qsizetype i = first + 1; i < (first + (qsizetype(1) << kBaseShift)); i++) {
+            const double value = series.value(i);
+            if (isLower(value, minValue)) { minValue = value; minIndex = i; }
+            if (isHigher(value, maxValue)) { maxValue = value; maxIndex = i; }
+        }
+        base.minIndex[block] = static_cast<quint32>(minIndex);
+        base.maxIndex[block] = static_cast<quint32>(maxIndex);
+    }
+    _levels.append(std::move(base));
+
+    // Each level pairs the blocks of the one below; the left block wins ties so the first extreme is kept
+    while (_levels.constLast().minIndex.size() >= 2) {
+        const Level &below = _levels.constLast();
+        const qsizetype blocks = below.minIndex.size() / 2;
+        Level level;
+        level.minIndex.resize(blocks);
+        level.maxIndex.resize(blocks);
+        for (qsizetype block = 0; block < blocks; block++) {
+            const quint32 leftMin = below.minIndex.at(2 * block);
+            const quint32 rightMin = below.minIndex.at((2 * block) + 1);
+            level.minIndex[block] = isLower(series.value(rightMin), series.value(leftMin)) ? rightMin : leftMin;
+            const quint32 leftMax = below.maxIndex.at(2 * block);
+            const quint32 rightMax = below.maxIndex.at((2 * block) + 1);
+            level.maxIndex[block] = isHigher(series.value(rightMax), series.value(leftMax)) ? rightMax : leftMax;
+        }
+        _levels.append(std::move(level));
+    }
+}
+
+void LogSamplePyramid::minMax(qsizetype begin, qsizetype end, qsizetype &minIndex, qsizetype &maxIndex) const
+{
+    minIndex = begin;
+    maxIndex = begin;
+    double minValue = _series.value(begin);
+    double maxValue = minValue;
+
+    // Left to right over the largest aligned blocks that fit, so ties keep the first index
+    qsizetype i = begin;
+    while (i < end) {
+        int level = -1;
+        while ((level + 1) < _levels.size()) {
+            const qsizetype blockSize = qsizetype(1) << (kBaseShift + level + 1);
+            if (((i & (blockSize - 1)) != 0) || ((i + blockSize) > end)) {
+                break;
+            }
+            level++;
+        }
+
+        qsizetype blockMin = i;
+        qsizetype blockMax = i;
+        qsizetype next = i + 1;
+        if (level >= 0) {
+            const int shift = kBaseShift + level;
+            blockMin = _levels.at(level).minIndex.at(i >> shift);
+            blockMax = _levels.at(level).maxIndex.at(i >> shift);
+            next = i + (qsizetype(1) << shift);
+        }
+
+        const double low = _series.value(blockMin);
+        if (isLower(low, minValue)) { minValue = low; minIndex = blockMin; }
+        const double high = _series.value(blockMax);
+        if (isHigher(high, maxValue)) { maxValue = high; maxIndex = blockMax; }
+        i = next;
+    }
+}
+
+qint64 LogSamplePyramid::memoryUsage() const
+{
+    qint64 bytes = 0;
+    for (const Level &level : _levels) {
+        bytes += (level.minIndex.capacity() + level.maxIndex.capacity()) * static_cast<qint64>(sizeof(quint32));
+    }
+    return bytes;
+}
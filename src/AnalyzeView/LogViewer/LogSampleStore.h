@@ -0,0 +1,165 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QPointF>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include <cstdint>
+#include <cstring>
+
+/// \brief Columnar storage for the time series of a parsed log.
+///
+/// Series logged together (the fields of one ULog topic instance, the columns of
+/// one DataFlash message type) form a group that owns a single timestamp column.
+/// Each series keeps only its values, at the width they were logged with, plus an
+/// optional divisor for scaled integers. Series are addressed by integer id; names
+/// are only looked up once, through seriesId().
+///
+class LogSampleStore
+{
+public:
+    enum class ValueType : uint8_t {
+        Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float, Double,
+        Bool,   ///< One byte, read as 0 or 1
+    };
+
+    static int valueSize(ValueType type);
+
+    /// Read-only view of one series, valid until the store is modified
+    class Series
+    {
+    public:
+        qsizetype size() const { return _size; }
+        bool isEmpty() const { return _size == 0; }
+        double time(qsizetype index) const { return _times[index]; }
+        double value(qsizetype index) const;
+        QPointF point(qsizetype index) const { return QPointF(time(index), value(index)); }
+        /// Timestamps of the whole series, sorted as they were logged
+        const double *times() const { return _times; }
+
+    private:
+        friend class LogSampleStore;
+
+        const double *_times = nullptr;
+        const char *_values = nullptr;
+        qsizetype _size = 0;
+        ValueType _type = ValueType::Double;
+        int _width = 8;
+        double _divisor = 1.0;
+    };
+
+    /// Group named @p name, created if needed
+    int addGroup(const QString &name);
+    /// Series named @p name in @p group, created if needed. Values read back as stored / @p divisor.
+    int addSeries(int group, const QString &name, ValueType type, double divisor = 1.0);
+
+    /// Starts a row of @p group at @p timestampSecs. Every series of the group then gets exactly one value
+    /// through appendValue().
+    void appendRow(int group, double timestampSecs) { _groups[group].times.append(timestampSecs); }
+    /// Appends valueSize() bytes in the series' native layout
+    void appendValue(int series, const void *value)
+    {
+        Column &column = _series[series];
+        (void) column.values.append(static_cast<const char *>(value), column.width);
+    }
+
+    /// Appends the rows of @p other after this store's, matching groups and series by name. A series missing
+    /// on one side reads 0 for that side's rows. Leaves @p other empty.
+    void append(LogSampleStore &other);
+
+    /// Id of the series named @p name, or -1
+    int seriesId(const QString &name) const { return _seriesByName.value(name, -1); }
+    Series series(int id) const;
+    Series series(const QString &name) const;
+    /// Samples of a series as points, for callers that need a copy
+    QVector<QPointF> points(const QString &name) const;
+
+    /// Names of the series with at least one sample, unsorted
+    QStringList seriesNames() const;
+    /// Bytes held by timestamp and value columns
+    qint64 memoryUsage() const;
+
+    bool isEmpty() const { return _series.isEmpty(); }
+    void clear();
+    /// Releases the spare capacity columns grew into while being filled
+    void squeeze();
+
+private:
+    struct Group {
+        QString name;
+        QVector<double> times;
+        QList<int> series;
+    };
+
+    struct Column {
+        QString name;
+        int group = -1;
+        ValueType type = ValueType::Double;
+        int width = 8;
+        double divisor = 1.0;
+        QByteArray values;
+    };
+
+    void _padGroup(Group &group);
+
+    QList<Group> _groups;
+    QList<Column> _series;
+    QHash<QString, int> _groupsByName;
+    QHash<QString, int> _seriesByName;
+};
+
+/// \brief Min/max pyramid over one series of a LogSampleStore.
+///
+/// Level k holds the index of the first minimum and first maximum of every aligned block of 8 << k samples,
+/// so the extremes of any index range come from O(log n) blocks instead of a scan. Built once per series, on
+/// first use; it takes about a quarter of the series' sample count in index pairs.
+///
+class LogSamplePyramid
+{
+public:
+    LogSamplePyramid() = default;
+    /// @p series must stay valid for the pyramid's lifetime
+    explicit LogSamplePyramid(const LogSampleStore::Series &series);
+
+    /// Indices of the first minimum and first maximum value in [@p begin, @p end), which must not be empty.
+    /// NaN samples are skipped; @p begin is returned for both when the whole range is NaN.
+    void minMax(qsizetype begin, qsizetype end, qsizetype &minIndex, qsizetype &maxIndex) const;
+
+    /// Bytes held by the levels
+    qint64 memoryUsage() const;
+
+private:
+    struct Level {
+        QList<quint32> minIndex;
+        QList<quint32> maxIndex;
+    };
+
+    static constexpr int kBaseShift = 3;    ///< Level 0 blocks hold 8 samples
+
+    LogSampleStore::Series _series;
+    QList<Level> _levels;
+};
+
+inline double LogSampleStore::Series::value(qsizetype index) const
+{
+    const char *const data = _values + (index * _width);
+    double value = 0.0;
+    switch (_type) {
+    case ValueType::Int8:   { int8_t v;   (void) memcpy(&v, data, sizeof(v)); value = v; break; }
+    case ValueType::UInt8:  { uint8_t v;  (void) memcpy(&v, data, sizeof(v)); value = v; break; }
+    case ValueType::Int16:  { int16_t v;  (void) memcpy(&v, data, sizeof(v)); value = v; break; }
+    case ValueType::UInt16: { uint16_t v; (void) memcpy(&v, data, sizeof(v)); value = v; break; }
+    case ValueType::Int32:  { int32_t v;  (void) memcpy(&v, data, sizeof(v)); value = v; break; }
+    case ValueType::UInt32: { uint32_t v; (void) memcpy(&v, data, sizeof(v)); value = v; break; }
+    case ValueType::Int64:  { int64_t v;  (void) memcpy(&v, data, sizeof(v)); value = static_cast<double>(v); break; }
+    case ValueType::UInt64: { uint64_t v; (void) memcpy(&v, data, sizeof(v)); value = static_cast<double>(v); break; }
+    case ValueType::Float:  { float v;    (void) memcpy(&v, data, sizeof(v)); value = static_cast<double>(v); break; }
+    case ValueType::Double: { (void) memcpy(&value, data, sizeof(value)); break; }
+    case ValueType::Bool:   { value = (*data != 0) ? 1.0 : 0.0; break; }
+    }
+    return (_divisor == 1.0) ? value : (value / _divisor);
+}
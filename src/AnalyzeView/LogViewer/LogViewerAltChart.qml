@@ -66,15 +66,18 @@ Item {
         const pixelWidth = Math.max(1, Math.floor(_base.graphsView.plotArea.width))
         const points = logParser.fieldSamplesFiltered(fieldName, _base.zoomMinX, _base.zoomMaxX, pixelWidth)
 
-        _altSeries.clear()
-        if (!points || points.length === 0) return
+        if (!points || points.length === 0) {
+            _altSeries.clear()
+            return
+        }
 
+        _altSeries.replace(points)
         let minY = Number.MAX_VALUE
         let maxY = -Number.MAX_VALUE
         for (let i = 0; i < points.length; i++) {
-            _altSeries.append(points[i].x, points[i].y)
-            if (points[i].y < minY) minY = points[i].y
-            if (points[i].y > maxY) maxY = points[i].y
+            const y = points[i].y
+            if (y < minY) minY = y
+            if (y > maxY) maxY = y
         }
 
         // Track full-dataset min/max (not just visible window)
@@ -229,12 +229,13 @@ ColumnLayout {
                 continue
             }
 
+            series.replace(points)
             let minY = Number.MAX_VALUE
             let maxY = -Number.MAX_VALUE
             for (let j = 0; j < points.length; j++) {
-                series.append(points[j].x, points[j].y)
-                if (points[j].y < minY) minY = points[j].y
-                if (points[j].y > maxY) maxY = points[j].y
+                const y = points[j].y
+                if (y < minY) minY = y
+                if (y > maxY) maxY = y
             }
             _fieldYRange[fieldName] = { min: minY, max: maxY }
         }
@@ -5,15 +5,123 @@
 #include <QtCore/QCoreApplication>
 #include "ULogFullHandler.h"
 
+#include <QtCore/QByteArray>
 #include <QtCore/QFile>
 
 #include <ulog_cpp/reader.hpp>
 
+#include <cstring>
+#include <deque>
 #include <limits>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr qint64 kMessageHeaderSize = 3;  // uint16_t msg_size, uint8_t msg_type
+
+bool _isDefinitionMessage(uint8_t type)
+{
+    switch (type) {
+    case 'B': case 'F': case 'I': case 'M': case 'P': case 'Q':
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool _isDataMessage(uint8_t type)
+{
+    switch (type) {
+    case 'A': case 'R': case 'D': case 'I': case 'M': case 'P': case 'Q': case 'L': case 'C': case 'S': case 'O':
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// How a ULog splits into chunks that decode on their own
+struct ULogLayout {
+    qint64 definitionsEnd = 0;  ///< Offset of the first data section message
+    QByteArray subscriptions;   ///< Every AddLoggedMessage of the data section, as logged
+    QList<LogParseChunk> chunks;
+};
+
+/// Phase one: walks message headers only. The data section is split at message boundaries; from the first
+/// message that does not look valid on, the rest of the file stays in one chunk and the reader's own resync
+/// deals with it. Logs with appended data are not split.
+ULogLayout _scanLayout(const uint8_t *data, qint64 size, qint64 chunkSize)
+{
+    ULogLayout layout;
+    const auto messageSize = [data](qint64 pos) {
+        uint16_t msgSize;
+        (void) memcpy(&msgSize, data + pos, sizeof(msgSize));
+        return kMessageHeaderSize + msgSize;
+    };
+
+    qint64 pos = PX4ULogUtility::kHeaderSize;
+    while ((pos + kMessageHeaderSize <= size) && _isDefinitionMessage(data[pos + 2])) {
+        const qint64 length = messageSize(pos);
+        if ((data[pos + 2] == 'B') && (length >= kMessageHeaderSize + 16)) {
+            // incompat_flags[8] follows compat_flags[8]
+            for (qint64 i = pos + kMessageHeaderSize + 8; i < pos + kMessageHeaderSize + 16; i++) {
+                if (data[i] != 0) {
+                    layout.chunks.append(LogParseChunk{0, size});
+                    return layout;
+                }
+            }
+        }
+        pos += length;
+    }
+    layout.definitionsEnd = pos;
+
+    qint64 chunkBegin = 0;
+    while (pos + kMessageHeaderSize <= size) {
+        const uint8_t type = data[pos + 2];
+        const qint64 length = messageSize(pos);
+        if (!_isDataMessage(type) || (pos + length > size)) {
+            break;
+        }
+        if (type == 'A') {
+            layout.subscriptions.append(reinterpret_cast<const char *>(data + pos), length);
+        }
+        // The first chunk keeps at least one data message, which is what completes the header
+        if ((pos > layout.definitionsEnd) && ((pos - chunkBegin) >= chunkSize)) {
+            layout.chunks.append(LogParseChunk{chunkBegin, pos});
+            chunkBegin = pos;
+        }
+        pos += length;
+    }
+    layout.chunks.append(LogParseChunk{chunkBegin, size});
+
+    return layout;
+}
+
+/// Feeds @p size bytes to @p reader in the pieces a file read would deliver. Returns false once cancelled.
+bool _read(ulog_cpp::Reader &reader, const uint8_t *data, qint64 size, const ProgressCallback &progressCallback, const CancelToken &cancelToken)
+{
+    static constexpr qint64 kReadSize = 64 * 1024;
+    qint64 offset = 0;
+    while (offset < size) {
+        const qint64 remaining = size - offset;
+        const qint64 piece = (remaining < kReadSize) ? remaining : kReadSize;
+        reader.readChunk(data + offset, static_cast<size_t>(piece));
+        offset += piece;
+        if (cancelToken && cancelToken->load(std::memory_order_relaxed)) {
+            return false;
+        }
+        if (progressCallback) {
+            progressCallback(static_cast<float>(offset) / static_cast<float>(size));
+        }
+    }
+    return true;
+}
+
+} // namespace
 
 namespace ULogParser {
 
-LogParseResult parseFile(const QString &filePath, const ProgressCallback &progressCallback, const CancelToken &cancelToken)
+LogParseResult parseFile(const QString &filePath, const ProgressCallback &progressCallback, const CancelToken &cancelToken, qint64 chunkSize)
 {
     LogParseResult result;
 
@@ -53,22 +161,40 @@ LogParseResult parseFile(const QString &filePath, const ProgressCallback &progre
         return result;
     }
 
-    auto handler = std::make_shared<ULogFullHandler>(result, progressCallback);
-    ulog_cpp::Reader reader(handler);
+    const uint8_t *const data = reinterpret_cast<const uint8_t *>(raw);
+    const ULogLayout layout = _scanLayout(data, fileSize, chunkSize);
+
+    // Phase two: the first chunk is read as the start of the file; every later one gets the definitions and all
+    // subscriptions ahead of its own bytes, and is then appended to the first in file order
+    std::deque<LogParseResult> chunkResults(static_cast<size_t>(layout.chunks.size() - 1));
+    std::vector<std::shared_ptr<ULogFullHandler>> handlers;
+    handlers.push_back(std::make_shared<ULogFullHandler>(result, progressCallback));
+    for (LogParseResult &chunkResult : chunkResults) {
+        handlers.push_back(std::make_shared<ULogFullHandler>(chunkResult));
+        handlers.back()->setContinuation(true);
+    }
 
-    static constexpr qint64 kChunkSize = 64 * 1024;
-    qint64 offset = 0;
-    while (offset < fileSize) {
-        const qint64 remaining = fileSize - offset;
-        const qint64 chunk = (remaining < kChunkSize) ? remaining : kChunkSize;
-        reader.readChunk(reinterpret_cast<const uint8_t *>(raw) + offset, static_cast<size_t>(chunk));
-        offset += chunk;
-        if (cancelToken && cancelToken->load(std::memory_order_relaxed)) {
-            return result;  // cancelled; result.ok is false, discarded by requestId guard
-        }
-        if (progressCallback) {
-            progressCallback(static_cast<float>(offset) / static_cast<float>(fileSize));
+    decodeLogChunks(layout.chunks, fileSize, progressCallback, cancelToken, [&](int index, const ProgressCallback &chunkProgress) {
+        const LogParseChunk &chunk = layout.chunks.at(index);
+        ulog_cpp::Reader reader(handlers.at(static_cast<size_t>(index)));
+        if (index > 0) {
+            reader.readChunk(data, static_cast<size_t>(layout.definitionsEnd));
+            if (!layout.subscriptions.isEmpty()) {
+                reader.readChunk(reinterpret_cast<const uint8_t *>(layout.subscriptions.constData()),
+                                 static_cast<size_t>(layout.subscriptions.size()));
+            }
         }
+        (void) _read(reader, data + chunk.begin, chunk.size(), chunkProgress, cancelToken);
+    });
+
+    if (cancelToken && cancelToken->load(std::memory_order_relaxed)) {
+        return result;  // cancelled; result.ok is false, discarded by requestId guard
+    }
+
+    const std::shared_ptr<ULogFullHandler> &handler = handlers.front();
+    for (size_t i = 1; i < handlers.size(); i++) {
+        handler->appendChunk(*handlers.at(i));
+        handlers[i].reset();
     }
 
     if (handler->hadFatalError()) {
@@ -1,12 +1,14 @@
 #pragma once
 
+#include "LogParseChunks.h"
 #include "LogParseResultPrivate.h"
 
 #include <QtCore/QString>
 
 // Free-function parser for PX4 ULog (.ulg) files.
 // Returns a filled LogParseResult on success (result.ok == true) or an error
-// message in result.errorMessage on failure.
+// message in result.errorMessage on failure. The data section of logs larger
+// than chunkSize is decoded in chunks of about that size in parallel.
 namespace ULogParser {
-    LogParseResult parseFile(const QString &filePath, const ProgressCallback &progressCallback = nullptr, const CancelToken &cancelToken = nullptr);
+    LogParseResult parseFile(const QString &filePath, const ProgressCallback &progressCallback = nullptr, const CancelToken &cancelToken = nullptr, qint64 chunkSize = kLogParseChunkSize);
 }
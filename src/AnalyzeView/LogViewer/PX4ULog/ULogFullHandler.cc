@@ -7,9 +7,10 @@
 #include <QtCore/QTimeZone>
 
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
-#include <ulog_cpp/subscription.hpp>
+#include <ulog_cpp/messages.hpp>
 
 QGC_LOGGING_CATEGORY(ULogFullHandlerLog, "AnalyzeView.ULogFullHandler")
 
@@ -69,6 +70,55 @@ bool _isNumericScalarField(const ulog_cpp::Field &field)
     }
 }
 
+/// Native sample store type of a numeric scalar field
+LogSampleStore::ValueType _valueType(ulog_cpp::Field::BasicType type)
+{
+    using BT = ulog_cpp::Field::BasicType;
+    using VT = LogSampleStore::ValueType;
+    switch (type) {
+    case BT::INT8:   return VT::Int8;
+    case BT::UINT8:  return VT::UInt8;
+    case BT::INT16:  return VT::Int16;
+    case BT::UINT16: return VT::UInt16;
+    case BT::INT32:  return VT::Int32;
+    case BT::UINT32: return VT::UInt32;
+    case BT::INT64:  return VT::Int64;
+    case BT::UINT64: return VT::UInt64;
+    case BT::FLOAT:  return VT::Float;
+    case BT::BOOL:   return VT::Bool;
+    default:         return VT::Double;
+    }
+}
+
+template<typename T>
+T _load(const uint8_t *data)
+{
+    T value;
+    (void) memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+/// Reads a numeric scalar of the given type and converts it, like TypedDataView::as<R>()
+template<typename R>
+R _loadAs(const uint8_t *data, ulog_cpp::Field::BasicType type)
+{
+    using BT = ulog_cpp::Field::BasicType;
+    switch (type) {
+    case BT::INT8:   return static_cast<R>(_load<int8_t>(data));
+    case BT::UINT8:  return static_cast<R>(_load<uint8_t>(data));
+    case BT::INT16:  return static_cast<R>(_load<int16_t>(data));
+    case BT::UINT16: return static_cast<R>(_load<uint16_t>(data));
+    case BT::INT32:  return static_cast<R>(_load<int32_t>(data));
+    case BT::UINT32: return static_cast<R>(_load<uint32_t>(data));
+    case BT::INT64:  return static_cast<R>(_load<int64_t>(data));
+    case BT::UINT64: return static_cast<R>(_load<uint64_t>(data));
+    case BT::FLOAT:  return static_cast<R>(_load<float>(data));
+    case BT::DOUBLE: return static_cast<R>(_load<double>(data));
+    case BT::BOOL:   return static_cast<R>(data[0] != 0);
+    default:         return R{};
+    }
+}
+
 } // namespace
 
 ULogFullHandler::ULogFullHandler(LogParseResult &result, const ProgressCallback &/*progressCallback*/)
@@ -95,13 +145,11 @@ void ULogFullHandler::messageFormat(const ulog_cpp::MessageFormat &message_forma
 
 void ULogFullHandler::addLoggedMessage(const ulog_cpp::AddLoggedMessage &add_logged_message)
 {
-    const auto it = _formats.find(add_logged_message.messageName());
-    if (it != _formats.cend()) {
-        _subscriptions[add_logged_message.msgId()] = {
-            it->second,
-            add_logged_message.multiId(),
-            add_logged_message.messageName()
-        };
+    // Field offsets are only known once the header has resolved every format
+    if (_headerComplete) {
+        _planSubscription(add_logged_message);
+    } else {
+        _pendingSubscriptions.push_back(add_logged_message);
     }
 }
 
@@ -111,91 +159,146 @@ void ULogFullHandler::headerComplete()
     for (auto &[name, fmt] : _formats) {
         fmt->resolveDefinition(_formats);
     }
+
+    for (const ulog_cpp::AddLoggedMessage &subscription : _pendingSubscriptions) {
+        _planSubscription(subscription);
+    }
+    _pendingSubscriptions.clear();
 }
 
-void ULogFullHandler::data(const ulog_cpp::Data &data)
+void ULogFullHandler::_planSubscription(const ulog_cpp::AddLoggedMessage &add_logged_message)
 {
-    if (!_headerComplete) {
+    const auto formatIt = _formats.find(add_logged_message.messageName());
+    if (formatIt == _formats.cend()) {
         return;
     }
-
-    const auto it = _subscriptions.find(data.msgId());
-    if (it == _subscriptions.cend()) {
-        return;
+    const ulog_cpp::MessageFormat &format = *formatIt->second;
+
+    SubscriptionPlan plan;
+    plan.planned = true;
+
+    const auto needBytes = [&plan](const ulog_cpp::Field &field) {
+        plan.minSize = std::max(plan.minSize, field.offsetInMessage() + field.type().size);
+    };
+
+    // Timestamp (ULog convention: field named "timestamp", unit µs)
+    const auto timestampIt = format.fieldMap().find("timestamp");
+    if (timestampIt != format.fieldMap().cend() && timestampIt->second->definitionResolved()
+            && _isNumericScalarField(*timestampIt->second)) {
+        plan.timestampOffset = timestampIt->second->offsetInMessage();
+        plan.timestampType = timestampIt->second->type().type;
+        needBytes(*timestampIt->second);
     }
 
-    const SubscriptionInfo &sub = it->second;
-    if (!sub.format) {
-        return;
+    // Extract GPS UTC start time from first valid sensor_gps/vehicle_gps_position sample.
+    // Define QGC_NO_LOG_START_TIME at build time to suppress this for UI testing.
+#ifndef QGC_NO_LOG_START_TIME
+    const std::string &topicName = add_logged_message.messageName();
+    if ((topicName == "sensor_gps" || topicName == "vehicle_gps_position") && plan.timestampOffset >= 0) {
+        const auto utcIt = format.fieldMap().find("time_utc_usec");
+        if (utcIt != format.fieldMap().cend() && utcIt->second->definitionResolved()
+                && _isNumericScalarField(*utcIt->second)) {
+            plan.utcOffset = utcIt->second->offsetInMessage();
+            plan.utcType = utcIt->second->type().type;
+            needBytes(*utcIt->second);
+        }
     }
+#endif // QGC_NO_LOG_START_TIME
 
-    try {
-        const ulog_cpp::TypedDataView view(data, *sub.format);
-
-        // Extract timestamp (ULog convention: field named "timestamp", unit µs)
-        double timestampSecs = -1.0;
-        if (sub.format->fieldMap().count("timestamp") > 0) {
-            const uint64_t tsUs = view.at("timestamp").as<uint64_t>();
-            timestampSecs = static_cast<double>(tsUs) / 1e6;
-            _lastTimestampSecs = timestampSecs;
+    // Field name: "topic_name.field" or "topic_name[N].field" for multi-instance.
+    // The fields of a topic instance share one timestamp column.
+    const QString topic = QString::fromStdString(add_logged_message.messageName());
+    const QString instance = (add_logged_message.multiId() > 0)
+        ? QStringLiteral("%1[%2]").arg(topic).arg(add_logged_message.multiId())
+        : topic;
+    const QString prefix = instance + QLatin1Char('.');
+
+    for (const auto &field : format.fields()) {
+        // Skip padding fields and the timestamp itself
+        if (field->name().rfind("_padding", 0) == 0) {
+            continue;
+        }
+        if (field->name() == "timestamp") {
+            continue;
+        }
+        if (!field->definitionResolved()) {
+            continue;
         }
 
-        // Extract GPS UTC start time from first valid sensor_gps/vehicle_gps_position sample.
-        // Define QGC_NO_LOG_START_TIME at build time to suppress this for UI testing.
-#ifndef QGC_NO_LOG_START_TIME
-        if (_result.startTime.isNull() && timestampSecs >= 0.0) {
-            if ((sub.topicName == "sensor_gps" || sub.topicName == "vehicle_gps_position")
-                    && sub.format->fieldMap().count("time_utc_usec") > 0) {
-                const uint64_t utcUsec = view.at("time_utc_usec").as<uint64_t>();
-                const uint64_t tsUs   = view.at("timestamp").as<uint64_t>();
-                if (utcUsec > 0 && utcUsec >= tsUs) {
-                    const qint64 startMs = static_cast<qint64>((utcUsec - tsUs) / 1000);
-                    _result.startTime = QDateTime::fromMSecsSinceEpoch(startMs, QTimeZone::utc());
-                }
-            }
+        const QString fieldName = prefix + QString::fromStdString(field->name());
+        plan.fieldNames.append(fieldName);
+
+        // Samples need a time axis
+        if (!_isNumericScalarField(*field) || plan.timestampOffset < 0) {
+            continue;
         }
-#endif // QGC_NO_LOG_START_TIME
 
-        // Field name: "topic_name.field" or "topic_name[N].field" for multi-instance
-        const QString prefix = (sub.multiId > 0)
-            ? QStringLiteral("%1[%2].").arg(QString::fromStdString(sub.topicName)).arg(sub.multiId)
-            : QString::fromStdString(sub.topicName) + QLatin1Char('.');
+        // A repeated subscription of the same topic instance shares its group and series
+        if (plan.group < 0) {
+            plan.group = _result.samples.addGroup(instance);
+        }
+        plan.fields.push_back({field->offsetInMessage(),
+                               _result.samples.addSeries(plan.group, fieldName, _valueType(field->type().type))});
+        needBytes(*field);
+    }
 
-        for (const auto &field : sub.format->fields()) {
-            // Skip padding fields and the timestamp itself
-            if (field->name().rfind("_padding", 0) == 0) {
-                continue;
-            }
-            if (field->name() == "timestamp") {
-                continue;
-            }
-            if (!field->definitionResolved()) {
-                continue;
-            }
+    const uint16_t msgId = add_logged_message.msgId();
+    if (msgId >= _plans.size()) {
+        _plans.resize(static_cast<size_t>(msgId) + 1);
+    }
+    _plans[msgId] = std::move(plan);
+}
 
-            const QString fieldName = prefix + QString::fromStdString(field->name());
-            _fieldSet.insert(fieldName);
+void ULogFullHandler::data(const ulog_cpp::Data &data)
+{
+    if (!_headerComplete || (data.msgId() >= _plans.size())) {
+        return;
+    }
 
-            if (!_isNumericScalarField(*field) || timestampSecs < 0.0) {
-                continue;
-            }
+    SubscriptionPlan &plan = _plans[data.msgId()];
+    if (!plan.planned) {
+        return;
+    }
 
-            const double value = view.at(field).as<double>();
-            _result.fieldSamples[fieldName].append(QPointF(timestampSecs, value));
-            _plottableFieldSet.insert(fieldName);
-        }
+    const std::vector<uint8_t> &payload = data.data();
+    if (payload.size() < static_cast<size_t>(plan.minSize)) {
+        qCWarning(ULogFullHandlerLog) << "Failed to decode data message: expected at least" << plan.minSize
+                                      << "bytes, got" << payload.size();
+        return;
+    }
+    const uint8_t *const bytes = payload.data();
 
-        _result.sampleCount++;
+    plan.seen = true;
+    _result.sampleCount++;
 
-        if (timestampSecs >= 0.0) {
-            if (_result.minTimestamp < 0.0 || timestampSecs < _result.minTimestamp) {
-                _result.minTimestamp = timestampSecs;
-            }
-            _result.maxTimestamp = std::max(_result.maxTimestamp, timestampSecs);
+    if (plan.timestampOffset < 0) {
+        return;
+    }
+
+    const uint64_t tsUs = _loadAs<uint64_t>(bytes + plan.timestampOffset, plan.timestampType);
+    const double timestampSecs = static_cast<double>(tsUs) / 1e6;
+    _lastTimestampSecs = timestampSecs;
+
+    if ((plan.utcOffset >= 0) && _result.startTime.isNull()) {
+        const uint64_t utcUsec = _loadAs<uint64_t>(bytes + plan.utcOffset, plan.utcType);
+        if (utcUsec > 0 && utcUsec >= tsUs) {
+            const qint64 startMs = static_cast<qint64>((utcUsec - tsUs) / 1000);
+            _result.startTime = QDateTime::fromMSecsSinceEpoch(startMs, QTimeZone::utc());
+        }
+    }
+
+    if (plan.group >= 0) {
+        // ULog is little-endian like every supported host, so fields are copied as logged
+        _result.samples.appendRow(plan.group, timestampSecs);
+        for (const FieldPlan &field : plan.fields) {
+            _result.samples.appendValue(field.series, bytes + field.offset);
         }
-    } catch (const std::exception &e) {
-        qCWarning(ULogFullHandlerLog) << "Failed to decode data message:" << e.what();
     }
+
+    if (_result.minTimestamp < 0.0 || timestampSecs < _result.minTimestamp) {
+        _result.minTimestamp = timestampSecs;
+    }
+    _result.maxTimestamp = std::max(_result.maxTimestamp, timestampSecs);
 }
 
 void ULogFullHandler::logging(const ulog_cpp::Logging &logging)
@@ -230,6 +333,10 @@ void ULogFullHandler::logging(const ulog_cpp::Logging &logging)
 
 void ULogFullHandler::parameter(const ulog_cpp::Parameter &param)
 {
+    if (_continuation && !_headerComplete) {
+        return;
+    }
+
     const QString name = QString::fromStdString(param.field().name());
     if (name.isEmpty()) {
         return;
@@ -257,6 +364,10 @@ void ULogFullHandler::parameter(const ulog_cpp::Parameter &param)
 
 void ULogFullHandler::parameterDefault(const ulog_cpp::ParameterDefault &param_default)
 {
+    if (_continuation && !_headerComplete) {
+        return;
+    }
+
     const QString name = QString::fromStdString(param_default.field().name());
     if (name.isEmpty()) {
         return;
@@ -278,6 +389,10 @@ void ULogFullHandler::parameterDefault(const ulog_cpp::ParameterDefault &param_d
 void ULogFullHandler::dropout(const ulog_cpp::Dropout &dropout)
 {
     if (_lastTimestampSecs < 0.0) {
+        // The previous chunk knows when this one started
+        if (_continuation) {
+            _leadingDropoutsMs.append(static_cast<double>(dropout.durationMs()));
+        }
         return;
     }
 
@@ -289,13 +404,69 @@ void ULogFullHandler::dropout(const ulog_cpp::Dropout &dropout)
     _result.dropouts.append(row);
 }
 
+void ULogFullHandler::appendChunk(ULogFullHandler &next)
+{
+    if (next._hadFatalError) {
+        _hadFatalError = true;
+        if (_result.errorMessage.isEmpty()) {
+            _result.errorMessage = next._result.errorMessage;
+        }
+    }
+
+    for (const SubscriptionPlan &plan : next._plans) {
+        if (plan.seen) {
+            for (const QString &fieldName : plan.fieldNames) {
+                _fieldSet.insert(fieldName);
+            }
+        }
+    }
+    _result.samples.append(next._result.samples);
+
+    _result.parameters.append(next._result.parameters);
+    _result.messages.append(next._result.messages);
+    _result.events.append(next._result.events);
+    for (const double durationMs : std::as_const(next._leadingDropoutsMs)) {
+        if (_lastTimestampSecs >= 0.0) {
+            QVariantMap row;
+            row[QStringLiteral("start")] = _lastTimestampSecs;
+            row[QStringLiteral("end")] = _lastTimestampSecs + durationMs / 1000.0;
+            _result.dropouts.append(row);
+        }
+    }
+    _result.dropouts.append(next._result.dropouts);
+    _paramDefaults.insert(next._paramDefaults);
+
+    _result.sampleCount += next._result.sampleCount;
+    if (next._result.minTimestamp >= 0.0
+            && (_result.minTimestamp < 0.0 || next._result.minTimestamp < _result.minTimestamp)) {
+        _result.minTimestamp = next._result.minTimestamp;
+    }
+    _result.maxTimestamp = std::max(_result.maxTimestamp, next._result.maxTimestamp);
+    if (_result.startTime.isNull()) {
+        _result.startTime = next._result.startTime;
+    }
+    if (next._lastTimestampSecs >= 0.0) {
+        _lastTimestampSecs = next._lastTimestampSecs;
+    }
+}
+
 void ULogFullHandler::finalize()
 {
+    // A field never sampled is listed but not plottable
+    for (const SubscriptionPlan &plan : _plans) {
+        if (plan.seen) {
+            for (const QString &fieldName : plan.fieldNames) {
+                _fieldSet.insert(fieldName);
+            }
+        }
+    }
+    _result.samples.squeeze();
+
     // Detect vehicle type from vehicle_status.vehicle_type
     // PX4 vehicle_type enum: 0=Unknown, 1=Rotary Wing, 2=Fixed Wing, 3=Rover, 4=Airship
-    const auto vehicleTypeIt = _result.fieldSamples.constFind(QStringLiteral("vehicle_status.vehicle_type"));
-    if (vehicleTypeIt != _result.fieldSamples.cend() && !vehicleTypeIt->isEmpty()) {
-        const int vtype = static_cast<int>(vehicleTypeIt->first().y());
+    const LogSampleStore::Series vehicleTypes = _result.samples.series(QStringLiteral("vehicle_status.vehicle_type"));
+    if (!vehicleTypes.isEmpty()) {
+        const int vtype = static_cast<int>(vehicleTypes.value(0));
         switch (vtype) {
         case 1: _result.detectedVehicleType = QStringLiteral("Multirotor/Helicopter"); break;
         case 2: _result.detectedVehicleType = QStringLiteral("Fixed Wing");            break;
@@ -307,14 +478,14 @@ void ULogFullHandler::finalize()
 
     // Derive mode segments from vehicle_status.nav_state samples.
     // nav_state is a uint8_t mapped to the PX4 navigation_state enum.
-    const auto navStateIt = _result.fieldSamples.constFind(QStringLiteral("vehicle_status.nav_state"));
-    if (navStateIt != _result.fieldSamples.cend()) {
-        const QVector<QPointF> &samples = navStateIt.value();
+    const LogSampleStore::Series navStates = _result.samples.series(QStringLiteral("vehicle_status.nav_state"));
+    if (!navStates.isEmpty()) {
         int lastNavState = -1;
         double segmentStart = -1.0;
         QString segmentMode;
 
-        for (const QPointF &pt : samples) {
+        for (qsizetype i = 0; i < navStates.size(); i++) {
+            const QPointF pt = navStates.point(i);
             const int navState = static_cast<int>(pt.y());
             if (navState != lastNavState) {
                 // Close the previous segment
@@ -344,7 +515,7 @@ void ULogFullHandler::finalize()
     // Sort field lists for consistent display
     _result.availableFields = _fieldSet.values();
     std::sort(_result.availableFields.begin(), _result.availableFields.end());
-    _result.plottableFields = _plottableFieldSet.values();
+    _result.plottableFields = _result.samples.seriesNames();
     std::sort(_result.plottableFields.begin(), _result.plottableFields.end());
 
     // Annotate parameter rows with default value info now that all ParameterDefault
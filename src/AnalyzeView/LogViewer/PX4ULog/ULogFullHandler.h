@@ -3,14 +3,15 @@
 #include "LogParseResultPrivate.h"
 
 #include <QtCore/QHash>
-#include <QtCore/QPointF>
+#include <QtCore/QList>
 #include <QtCore/QSet>
 #include <QtCore/QString>
-#include <QtCore/QVector>
+#include <QtCore/QStringList>
 
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <ulog_cpp/data_handler_interface.hpp>
 #include <ulog_cpp/messages.hpp>
@@ -21,6 +22,9 @@ struct LogParseResult;
 ///
 /// Streams through a ULog file in a single pass, collecting signal samples,
 /// parameters, log messages, events, and dropouts into a LogParseResult.
+/// Each subscription is planned once: byte offsets and widths of its fields and
+/// the sample store series they feed, so data messages are copied into their
+/// columns without name lookups or conversions.
 /// Call finalize() after parsing to build mode segments and sort signal lists.
 ///
 class ULogFullHandler final : public ulog_cpp::DataHandlerInterface
@@ -42,6 +46,14 @@ class ULogFullHandler final : public ulog_cpp::DataHandlerInterface
     bool hadFatalError() const { return _hadFatalError; }
     bool isHeaderComplete() const { return _headerComplete; }
 
+    /// Marks a handler that decodes a later chunk of the log. It is fed the definitions section again to plan its
+    /// subscriptions, but the parameters there belong to the first chunk's handler and are ignored.
+    void setContinuation(bool continuation) { _continuation = continuation; }
+
+    /// Takes over everything @p next collected, as if this handler had gone on to parse @p next's chunk itself.
+    /// Chunks must be appended in file order, before finalize().
+    void appendChunk(ULogFullHandler &next);
+
     /// Post-parse: derive mode segments from vehicle_status.nav_state samples
     /// and sort availableFields / plottableFields lists.
     void finalize();
@@ -49,19 +61,37 @@ class ULogFullHandler final : public ulog_cpp::DataHandlerInterface
 private:
     LogParseResult &_result;
 
-    struct SubscriptionInfo {
-        std::shared_ptr<ulog_cpp::MessageFormat> format;
-        uint8_t multiId{0};
-        std::string topicName;
+    using BasicType = ulog_cpp::Field::BasicType;
+
+    struct FieldPlan {
+        int offset{0};
+        int series{-1};                     ///< Id in _result.samples
     };
 
+    struct SubscriptionPlan {
+        bool planned{false};
+        bool seen{false};
+        int minSize{0};                     ///< Bytes a message needs for every planned load
+        int timestampOffset{-1};            ///< -1 if the topic has no timestamp
+        BasicType timestampType{BasicType::UINT64};
+        int utcOffset{-1};                  ///< time_utc_usec of a GPS topic, else -1
+        BasicType utcType{BasicType::UINT64};
+        int group{-1};                      ///< Sample store group of the topic instance, -1 if nothing to plot
+        std::vector<FieldPlan> fields;
+        QStringList fieldNames;             ///< Every listed field, plottable or not
+    };
+
+    void _planSubscription(const ulog_cpp::AddLoggedMessage &add_logged_message);
+
     std::map<std::string, std::shared_ptr<ulog_cpp::MessageFormat>> _formats;
-    std::map<uint16_t, SubscriptionInfo> _subscriptions;
+    std::vector<ulog_cpp::AddLoggedMessage> _pendingSubscriptions;  ///< Added before the header completed
+    std::vector<SubscriptionPlan> _plans;                           ///< Indexed by msg id
     QSet<QString> _fieldSet;
-    QSet<QString> _plottableFieldSet;
     // Map of parameter name -> default value (system default, from ParameterDefault messages)
     QHash<QString, double> _paramDefaults;
     double _lastTimestampSecs{-1.0};
+    QList<double> _leadingDropoutsMs;   ///< Continuation only: dropouts before the chunk's first timestamp
     bool _hadFatalError{false};
     bool _headerComplete{false};
+    bool _continuation{false};
 };
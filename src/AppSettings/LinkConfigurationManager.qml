@@ -116,6 +116,16 @@ SettingsGroupLayout {
 
             onAccepted: {
                 linkSettingsLoader.item.saveSettings()
+                if (editingConfig.forwarding) {
+                    editingConfig.routeAllowSysIds  = allowSysIdsField.text
+                    editingConfig.routeDenySysIds   = denySysIdsField.text
+                    editingConfig.routeAllowCompIds = allowCompIdsField.text
+                    editingConfig.routeDenyCompIds  = denyCompIdsField.text
+                    editingConfig.routeAllowMsgIds  = allowMsgIdsField.text
+                    editingConfig.routeDenyMsgIds   = denyMsgIdsField.text
+                    editingConfig.routeMaxRateHz    = maxRateField.text === "" ? 0 : parseFloat(maxRateField.text)
+                    editingConfig.routeSigning      = signingCombo.currentIndex
+                }
                 editingConfig.name = nameField.text
                 if (originalConfig) {
                     _linkManager.endConfigurationEditing(originalConfig, editingConfig)
@@ -157,6 +167,90 @@ SettingsGroupLayout {
                     onCheckedChanged:   editingConfig.highLatency = checked
                 }
 
+                QGCCheckBoxSlider {
+                    Layout.fillWidth:   true
+                    text:               qsTr("Forward MAVLink To This Link")
+                    checked:            editingConfig.forwarding
+                    onCheckedChanged:   editingConfig.forwarding = checked
+                }
+
+                GridLayout {
+                    Layout.fillWidth:   true
+                    columns:            2
+                    columnSpacing:      ScreenTools.defaultFontPixelWidth
+                    rowSpacing:         ScreenTools.defaultFontPixelHeight / 4
+                    visible:            editingConfig.forwarding
+
+                    QGCLabel {
+                        Layout.columnSpan:  2
+                        Layout.fillWidth:   true
+                        font.pointSize:     ScreenTools.smallFontPointSize
+                        wrapMode:           Text.WordWrap
+                        text:               qsTr("Comma-separated ids. Empty allow lists forward everything; deny lists take precedence.")
+                    }
+
+                    QGCLabel { text: qsTr("Allow System IDs") }
+                    QGCTextField {
+                        id:                 allowSysIdsField
+                        Layout.fillWidth:   true
+                        text:               editingConfig.routeAllowSysIds
+                    }
+
+                    QGCLabel { text: qsTr("Deny System IDs") }
+                    QGCTextField {
+                        id:                 denySysIdsField
+                        Layout.fillWidth:   true
+                        text:               editingConfig.routeDenySysIds
+                    }
+
+                    QGCLabel { text: qsTr("Allow Component IDs") }
+                    QGCTextField {
+                        id:                 allowCompIdsField
+                        Layout.fillWidth:   true
+                        text:               editingConfig.routeAllowCompIds
+                    }
+
+                    QGCLabel { text: qsTr("Deny Component IDs") }
+                    QGCTextField {
+                        id:                 denyCompIdsField
+                        Layout.fillWidth:   true
+                        text:               editingConfig.routeDenyCompIds
+                    }
+
+                    QGCLabel { text: qsTr("Allow Message IDs") }
+                    QGCTextField {
+                        id:                 allowMsgIdsField
+                        Layout.fillWidth:   true
+                        text:               editingConfig.routeAllowMsgIds
+                    }
+
+                    QGCLabel { text: qsTr("Deny Message IDs") }
+                    QGCTextField {
+                        id:                 denyMsgIdsField
+                        Layout.fillWidth:   true
+                        text:               editingConfig.routeDenyMsgIds
+                    }
+
+                    QGCLabel { text: qsTr("Max Rate Per Stream (Hz)") }
+                    QGCTextField {
+                        id:                 maxRateField
+                        Layout.fillWidth:   true
+                        text:               editingConfig.routeMaxRateHz > 0 ? editingConfig.routeMaxRateHz.toString() : ""
+                        placeholderText:    qsTr("Unlimited")
+                        inputMethodHints:   Qt.ImhFormattedNumbersOnly
+                    }
+
+                    LabelledComboBox {
+                        id:                 signingCombo
+                        Layout.columnSpan:  2
+                        Layout.fillWidth:   true
+                        label:              qsTr("Signed Messages")
+                        // Order matches MAVLinkRouteFilter::SigningPolicy
+                        model:              [ qsTr("Strip Signature"), qsTr("Forward As Received"), qsTr("Forward Only Signed") ]
+                        Component.onCompleted: currentIndex = editingConfig.routeSigning
+                    }
+                }
+
                 LabelledComboBox {
                     label:                  qsTr("Type")
                     enabled:                originalConfig == null
@@ -5,25 +5,53 @@ import QtQuick.Layouts
 import QGroundControl
 import QGroundControl.Controls
 
-RowLayout {
-    spacing: _colSpacing
+ColumnLayout {
+    spacing: _rowSpacing
 
     function saveSettings() {
         console.log(logField.text)
         subEditConfig.filename = logField.text
+        subEditConfig.unpaced = unpacedCheckBox.checked
+        subEditConfig.maxMessagesPerSecond = Math.max(0, parseInt(rateField.text) || 0)
     }
 
-    QGCLabel { text: qsTr("Log File") }
+    RowLayout {
+        spacing: _colSpacing
 
-    QGCTextField {
-        id: logField
-        Layout.preferredWidth: _secondColumnWidth
-        text: subEditConfig.filename
+        QGCLabel { text: qsTr("Log File") }
+
+        QGCTextField {
+            id: logField
+            Layout.preferredWidth: _secondColumnWidth
+            text: subEditConfig.filename
+        }
+
+        QGCButton {
+            text: qsTr("Browse")
+            onClicked: filePicker.openForLoad()
+        }
     }
 
-    QGCButton {
-        text: qsTr("Browse")
-        onClicked: filePicker.openForLoad()
+    QGCCheckBoxSlider {
+        id: unpacedCheckBox
+        Layout.fillWidth: true
+        text: qsTr("Replay As Fast As Possible")
+        checked: subEditConfig.unpaced
+    }
+
+    RowLayout {
+        spacing: _colSpacing
+        visible: unpacedCheckBox.checked
+
+        QGCLabel { text: qsTr("Max Messages/Sec") }
+
+        QGCTextField {
+            id: rateField
+            Layout.preferredWidth: _secondColumnWidth
+            text: subEditConfig.maxMessagesPerSecond > 0 ? subEditConfig.maxMessagesPerSecond.toString() : ""
+            placeholderText: qsTr("Unlimited")
+            inputMethodHints: Qt.ImhDigitsOnly
+        }
     }
 
     QGCFileDialog {
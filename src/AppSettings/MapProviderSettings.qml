@@ -3,6 +3,7 @@ import QtQuick.Layouts
 
 import QGroundControl
 import QGroundControl.Controls
+import QGroundControl.FactControls
 
 /// Map provider, type, and elevation provider selection.
 /// Wraps a SettingsGroupLayout with cascading comboboxes driven by QGCMapEngineManager.
@@ -13,6 +14,7 @@ SettingsGroupLayout {
     property Fact _mapProviderFact:     QGroundControl.settingsManager.flightMapSettings.mapProvider
     property Fact _mapTypeFact:         QGroundControl.settingsManager.flightMapSettings.mapType
     property Fact _elevationProviderFact: QGroundControl.settingsManager.flightMapSettings.elevationMapProvider
+    property Fact _localDemDirectoryFact: QGroundControl.settingsManager.flightMapSettings.localDemDirectory
 
     LabelledComboBox {
         label: qsTr("Provider")
@@ -55,4 +57,12 @@ SettingsGroupLayout {
             comboBox.currentIndex = index
         }
     }
+
+    LabelledFactBrowse {
+        Layout.fillWidth:   true
+        label:              qsTr("Local Elevation Files")
+        fact:               _localDemDirectoryFact
+        defaultText:        qsTr("<use elevation provider>")
+        visible:            _localDemDirectoryFact.visible
+    }
 }
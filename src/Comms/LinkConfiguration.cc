@@ -25,6 +25,8 @@ LinkConfiguration::LinkConfiguration(const LinkConfiguration *copy, QObject *par
     , _link(copy->_link)
     , _name(copy->name())
     , _dynamic(copy->isDynamic())
+    , _forwarding(copy->isForwarding())
+    , _routeFilter(copy->routeFilter())
     , _autoConnect(copy->isAutoConnect())
     , _highLatency(copy->isHighLatency())
 {
@@ -45,10 +47,90 @@ void LinkConfiguration::copyFrom(const LinkConfiguration *source)
     setLink(source->_link.lock());
     setName(source->name());
     setDynamic(source->isDynamic());
+    setForwarding(source->isForwarding());
+    setRouteFilter(source->routeFilter());
     setAutoConnect(source->isAutoConnect());
     setHighLatency(source->isHighLatency());
 }
 
+void LinkConfiguration::setForwarding(bool forwarding)
+{
+    if (forwarding != _forwarding) {
+        _forwarding = forwarding;
+        emit forwardingChanged();
+    }
+}
+
+void LinkConfiguration::setRouteFilter(const MAVLinkRouteFilter &filter)
+{
+    if (filter != _routeFilter) {
+        _routeFilter = filter;
+        emit routeFilterChanged();
+    }
+}
+
+void LinkConfiguration::setRouteAllowSysIds(const QString &ids)
+{
+    MAVLinkRouteFilter filter = _routeFilter;
+    filter.allowSysIds = MAVLinkRouteFilter::idsFromText<uint8_t>(ids, QStringLiteral("allowSysIds"));
+    setRouteFilter(filter);
+}
+
+void LinkConfiguration::setRouteDenySysIds(const QString &ids)
+{
+    MAVLinkRouteFilter filter = _routeFilter;
+    filter.denySysIds = MAVLinkRouteFilter::idsFromText<uint8_t>(ids, QStringLiteral("denySysIds"));
+    setRouteFilter(filter);
+}
+
+void LinkConfiguration::setRouteAllowCompIds(const QString &ids)
+{
+    MAVLinkRouteFilter filter = _routeFilter;
+    filter.allowCompIds = MAVLinkRouteFilter::idsFromText<uint8_t>(ids, QStringLiteral("allowCompIds"));
+    setRouteFilter(filter);
+}
+
+void LinkConfiguration::setRouteDenyCompIds(const QString &ids)
+{
+    MAVLinkRouteFilter filter = _routeFilter;
+    filter.denyCompIds = MAVLinkRouteFilter::idsFromText<uint8_t>(ids, QStringLiteral("denyCompIds"));
+    setRouteFilter(filter);
+}
+
+void LinkConfiguration::setRouteAllowMsgIds(const QString &ids)
+{
+    MAVLinkRouteFilter filter = _routeFilter;
+    filter.allowMsgIds = MAVLinkRouteFilter::idsFromText<uint32_t>(ids, QStringLiteral("allowMsgIds"));
+    setRouteFilter(filter);
+}
+
+void LinkConfiguration::setRouteDenyMsgIds(const QString &ids)
+{
+    MAVLinkRouteFilter filter = _routeFilter;
+    filter.denyMsgIds = MAVLinkRouteFilter::idsFromText<uint32_t>(ids, QStringLiteral("denyMsgIds"));
+    setRouteFilter(filter);
+}
+
+void LinkConfiguration::setRouteMaxRateHz(double maxRateHz)
+{
+    MAVLinkRouteFilter filter = _routeFilter;
+    filter.maxRateHz = (maxRateHz > 0.0) ? maxRateHz : 0.0;
+    setRouteFilter(filter);
+}
+
+void LinkConfiguration::setRouteSigning(int signing)
+{
+    if ((signing < static_cast<int>(MAVLinkRouteFilter::SigningPolicy::Strip)) ||
+        (signing > static_cast<int>(MAVLinkRouteFilter::SigningPolicy::SignedOnly))) {
+        qCWarning(LinkConfigurationLog) << "Invalid signing policy" << signing;
+        return;
+    }
+
+    MAVLinkRouteFilter filter = _routeFilter;
+    filter.signing = static_cast<MAVLinkRouteFilter::SigningPolicy>(signing);
+    setRouteFilter(filter);
+}
+
 LinkConfiguration *LinkConfiguration::createSettings(int type, const QString &name)
 {
     LinkConfiguration *config = nullptr;
@@ -6,6 +6,8 @@
 #include <QtCore/QString>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include "MAVLinkRouteFilter.h"
+
 class LinkInterface;
 
 /// \brief Interface holding link specific settings.
@@ -26,6 +28,17 @@ class LinkConfiguration : public QObject
     Q_PROPERTY(QString          settingsURL     READ settingsURL                            CONSTANT)
     Q_PROPERTY(QString          settingsTitle   READ settingsTitle                          CONSTANT)
     Q_PROPERTY(bool             highLatency     READ isHighLatency  WRITE setHighLatency    NOTIFY highLatencyChanged)
+    Q_PROPERTY(bool             forwarding      READ isForwarding   WRITE setForwarding     NOTIFY forwardingChanged)
+
+    // Router endpoint filter, id lists as comma-separated text
+    Q_PROPERTY(QString  routeAllowSysIds    READ routeAllowSysIds   WRITE setRouteAllowSysIds   NOTIFY routeFilterChanged)
+    Q_PROPERTY(QString  routeDenySysIds     READ routeDenySysIds    WRITE setRouteDenySysIds    NOTIFY routeFilterChanged)
+    Q_PROPERTY(QString  routeAllowCompIds   READ routeAllowCompIds  WRITE setRouteAllowCompIds  NOTIFY routeFilterChanged)
+    Q_PROPERTY(QString  routeDenyCompIds    READ routeDenyCompIds   WRITE setRouteDenyCompIds   NOTIFY routeFilterChanged)
+    Q_PROPERTY(QString  routeAllowMsgIds    READ routeAllowMsgIds   WRITE setRouteAllowMsgIds   NOTIFY routeFilterChanged)
+    Q_PROPERTY(QString  routeDenyMsgIds     READ routeDenyMsgIds    WRITE setRouteDenyMsgIds    NOTIFY routeFilterChanged)
+    Q_PROPERTY(double   routeMaxRateHz      READ routeMaxRateHz     WRITE setRouteMaxRateHz     NOTIFY routeFilterChanged)
+    Q_PROPERTY(int      routeSigning        READ routeSigning       WRITE setRouteSigning       NOTIFY routeFilterChanged)
 
 public:
     LinkConfiguration(const QString &name, QObject *parent = nullptr);
@@ -53,8 +66,30 @@ class LinkConfiguration : public QObject
     ///     @return True if forwarding
     bool isForwarding() const { return _forwarding; }
 
-    /// Set if this is this a forwarding link configuration. (decided at runtime)
-    void setForwarding(bool forwarding = true) { _forwarding = forwarding; };
+    /// Set if this is this a forwarding link configuration. Persisted for router endpoints the user configures.
+    void setForwarding(bool forwarding = true);
+
+    /// What MAVLinkProtocol forwards to this link when it is a forwarding link
+    const MAVLinkRouteFilter &routeFilter() const { return _routeFilter; }
+    void setRouteFilter(const MAVLinkRouteFilter &filter);
+
+    QString routeAllowSysIds() const { return MAVLinkRouteFilter::idsToText(_routeFilter.allowSysIds); }
+    QString routeDenySysIds() const { return MAVLinkRouteFilter::idsToText(_routeFilter.denySysIds); }
+    QString routeAllowCompIds() const { return MAVLinkRouteFilter::idsToText(_routeFilter.allowCompIds); }
+    QString routeDenyCompIds() const { return MAVLinkRouteFilter::idsToText(_routeFilter.denyCompIds); }
+    QString routeAllowMsgIds() const { return MAVLinkRouteFilter::idsToText(_routeFilter.allowMsgIds); }
+    QString routeDenyMsgIds() const { return MAVLinkRouteFilter::idsToText(_routeFilter.denyMsgIds); }
+    double routeMaxRateHz() const { return _routeFilter.maxRateHz; }
+    /// MAVLinkRouteFilter::SigningPolicy as an int
+    int routeSigning() const { return static_cast<int>(_routeFilter.signing); }
+    void setRouteAllowSysIds(const QString &ids);
+    void setRouteDenySysIds(const QString &ids);
+    void setRouteAllowCompIds(const QString &ids);
+    void setRouteDenyCompIds(const QString &ids);
+    void setRouteAllowMsgIds(const QString &ids);
+    void setRouteDenyMsgIds(const QString &ids);
+    void setRouteMaxRateHz(double maxRateHz);
+    void setRouteSigning(int signing);
 
     bool isAutoConnect() const { return _autoConnect; }
 
@@ -155,6 +190,8 @@ class LinkConfiguration : public QObject
     void dynamicChanged();
     void autoConnectChanged();
     void highLatencyChanged();
+    void forwardingChanged();
+    void routeFilterChanged();
 
 protected:
     std::weak_ptr<LinkInterface> _link; ///< Link currently using this configuration (if any)
@@ -162,7 +199,8 @@ class LinkConfiguration : public QObject
 private:
     QString _name;
     bool _dynamic = false;     ///< A connection added automatically and not persistent (unless it's edited).
-    bool _forwarding = false;  ///< Automatically added Mavlink forwarding connection
+    bool _forwarding = false;  ///< Mavlink forwarding connection (router endpoint)
+    MAVLinkRouteFilter _routeFilter;
     bool _autoConnect = false; ///< This connection is started automatically at boot
     bool _highLatency = false;
     bool _suppressAutoReconnect = false; ///< User disconnected; skip auto-reconnect until manually reconnected (runtime only)
@@ -1,6 +1,7 @@
 #include "LinkInterface.h"
 #include "MAVLinkLib.h"
 #include "LinkManager.h"
+#include "MAVLinkProtocol.h"
 #include "AppMessages.h"
 #include "QGCApplication.h"
 #include "QGCLoggingCategory.h"
@@ -73,6 +74,8 @@ void LinkInterface::_freeMavlinkChannel()
 {
     qCDebug(LinkInterfaceLog) << _mavlinkChannel;
 
+    QMutexLocker locker(&_receiveMutex);
+
     if (!mavlinkChannelIsSet()) {
         return;
     }
@@ -90,6 +93,17 @@ void LinkInterface::_freeMavlinkChannel()
     _mavlinkChannel = LinkManager::invalidMavlinkChannel();
 }
 
+void LinkInterface::_receiveBytesOnLinkThread(const QByteArray &data)
+{
+    QMutexLocker locker(&_receiveMutex);
+
+    if (!mavlinkChannelIsSet()) {
+        return;
+    }
+
+    MAVLinkProtocol::instance()->receiveBytesOnLinkThread(this, data);
+}
+
 void LinkInterface::writeBytesThreadSafe(const char *bytes, int length)
 {
     const QByteArray data(bytes, length);
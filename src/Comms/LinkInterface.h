@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QtCore/QMutex>
 #include <QtQmlIntegration/QtQmlIntegration>
 
 #include <memory>
@@ -65,6 +66,10 @@ class LinkInterface : public QObject
 
     void _connectionRemoved();
 
+    /// Receive path for links whose I/O runs on a worker thread. Call from that thread: MAVLink is decoded there
+    /// and only complete messages are handed to the GUI thread. Safe against a concurrent _freeMavlinkChannel().
+    void _receiveBytesOnLinkThread(const QByteArray &data);
+
     SharedLinkConfigurationPtr _config;
 
 private slots:
@@ -79,6 +84,8 @@ private slots:
     bool _decodedFirstMavlinkPacket = false;
     int _vehicleReferenceCount = 0;
     bool _mavlinkV1TrafficReported = false;
+    /// Held by the link thread while decoding so the channel and signing controller can't be freed underneath it.
+    QMutex _receiveMutex;
     /// Must `reset()` in `_freeMavlinkChannel` before LinkManager frees the channel so the
     /// controller can flush the final timestamp.
     std::unique_ptr<SigningController> _signingController;
@@ -187,6 +187,7 @@ bool LinkManager::createConnectedLink(SharedLinkConfigurationPtr &config)
         _rgLinks.append(link);
     }
     config->setLink(link);
+    MAVLinkProtocol::instance()->invalidateForwarding();
 
     return true;
 }
@@ -242,6 +243,32 @@ SharedLinkInterfacePtr LinkManager::mavlinkForwardingSupportLink()
     return nullptr;
 }
 
+std::shared_ptr<const MAVLinkRouter> LinkManager::createMavlinkRouter()
+{
+    const bool forwardMavlink = SettingsManager::instance()->mavlinkSettings()->forwardMavlink()->rawValue().toBool();
+
+    QList<MAVLinkRouter::Endpoint> endpoints;
+    QSet<const LinkInterface*> forwardingLinks;
+    QMutexLocker locker(&_linksMutex);
+
+    for (const SharedLinkInterfacePtr &link : _rgLinks) {
+        const SharedLinkConfigurationPtr linkConfig = link->linkConfiguration();
+        if (!linkConfig || !linkConfig->isForwarding()) {
+            continue;
+        }
+        forwardingLinks.insert(link.get());
+        if ((linkConfig->name() == _mavlinkForwardingLinkName) && !forwardMavlink) {
+            continue;
+        }
+        if ((linkConfig->name() == _mavlinkForwardingSupportLinkName) && !_mavlinkSupportForwardingEnabled) {
+            continue;
+        }
+        endpoints.append({link, linkConfig->routeFilter()});
+    }
+
+    return std::make_shared<const MAVLinkRouter>(endpoints, forwardingLinks);
+}
+
 void LinkManager::disconnectAll()
 {
     QList<SharedLinkInterfacePtr> links;
@@ -284,6 +311,7 @@ void LinkManager::_linkDisconnected()
         qCDebug(LinkManagerLog) << "link already removed";
         return;
     }
+    MAVLinkProtocol::instance()->invalidateForwarding();
 
     if (config) {
         config->noteDisconnected();
@@ -347,6 +375,10 @@ void LinkManager::saveLinkConfigurationList()
         settings.setValue(root + "/type", linkConfig->type());
         settings.setValue(root + "/auto", linkConfig->isAutoConnect());
         settings.setValue(root + "/high_latency", linkConfig->isHighLatency());
+        if (linkConfig->isForwarding()) {
+            settings.setValue(root + "/forwarding", true);
+            linkConfig->routeFilter().saveSettings(settings, root + "/route");
+        }
         linkConfig->saveSettings(settings, root);
     }
 
@@ -419,6 +451,12 @@ void LinkManager::loadLinkConfigurationList()
                 link->setAutoConnect(autoConnect);
                 const bool highLatency = settings.value(root + "/high_latency").toBool();
                 link->setHighLatency(highLatency);
+                if (settings.value(root + "/forwarding").toBool()) {
+                    link->setForwarding();
+                    MAVLinkRouteFilter routeFilter;
+                    routeFilter.loadSettings(settings, root + "/route");
+                    link->setRouteFilter(routeFilter);
+                }
                 link->loadSettings(settings, root);
                 addConfiguration(link);
             }
@@ -643,6 +681,7 @@ void LinkManager::createMavlinkForwardingSupportLink()
     const QString hostName = SettingsManager::instance()->mavlinkSettings()->forwardMavlinkAPMSupportHostName()->rawValue().toString();
     _createDynamicForwardLink(_mavlinkForwardingSupportLinkName, hostName);
     _mavlinkSupportForwardingEnabled = true;
+    MAVLinkProtocol::instance()->invalidateForwarding();
     emit mavlinkSupportForwardingEnabledChanged();
 }
 
@@ -683,6 +722,12 @@ SharedLinkConfigurationPtr LinkManager::addConfiguration(LinkConfiguration *conf
     (void) _qmlConfigurations->append(config);
     (void) _rgLinkConfigs.append(SharedLinkConfigurationPtr(config));
 
+    // Any of these can change what a connected endpoint is routed
+    MAVLinkProtocol *const mavlinkProtocol = MAVLinkProtocol::instance();
+    (void) connect(config, &LinkConfiguration::forwardingChanged, mavlinkProtocol, &MAVLinkProtocol::invalidateForwarding);
+    (void) connect(config, &LinkConfiguration::routeFilterChanged, mavlinkProtocol, &MAVLinkProtocol::invalidateForwarding);
+    (void) connect(config, &LinkConfiguration::nameChanged, mavlinkProtocol, &MAVLinkProtocol::invalidateForwarding);
+
     return _rgLinkConfigs.last();
 }
 
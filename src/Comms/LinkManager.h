@@ -10,6 +10,7 @@
 
 #include "LinkConfiguration.h"
 #include "LinkInterface.h"
+#include "MAVLinkRouter.h"
 #ifndef QGC_NO_SERIAL_LINK
     #include "QGCSerialPortInfo.h"
 #endif
@@ -90,6 +91,10 @@ class LinkManager : public QObject
     /// Returns pointer to the mavlink support forwarding link, or nullptr if it does not exist
     SharedLinkInterfacePtr mavlinkForwardingSupportLink();
 
+    /// GUI thread. Routing table over every connected forwarding link, with its filter. The settings-driven
+    /// forwarding and support links are routed to only while their switches are on.
+    std::shared_ptr<const MAVLinkRouter> createMavlinkRouter();
+
     void disconnectAll();
 
     /// Allocates a mavlink channel for use
@@ -5,11 +5,14 @@
 #include "MultiVehicleManager.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QFileInfo>
-#include <QtCore/QtEndian>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
+#include <limits>
+
 QGC_LOGGING_CATEGORY(LogReplayLinkLog, "Comms.LogReplayLink")
 
 /*===========================================================================*/
@@ -23,6 +26,8 @@ LogReplayConfiguration::LogReplayConfiguration(const QString &name, QObject *par
 LogReplayConfiguration::LogReplayConfiguration(const LogReplayConfiguration *copy, QObject *parent)
     : LinkConfiguration(copy, parent)
     , _logFilename(copy->logFilename())
+    , _unpaced(copy->unpaced())
+    , _maxMessagesPerSecond(copy->maxMessagesPerSecond())
 {
     qCDebug(LogReplayLinkLog) << this;
 }
@@ -39,6 +44,8 @@ void LogReplayConfiguration::copyFrom(const LinkConfiguration *source)
     const LogReplayConfiguration *logReplaySource = qobject_cast<const LogReplayConfiguration*>(source);
 
     setLogFilename(logReplaySource->logFilename());
+    setUnpaced(logReplaySource->unpaced());
+    setMaxMessagesPerSecond(logReplaySource->maxMessagesPerSecond());
 }
 
 void LogReplayConfiguration::loadSettings(QSettings &settings, const QString &root)
@@ -46,6 +53,8 @@ void LogReplayConfiguration::loadSettings(QSettings &settings, const QString &ro
     settings.beginGroup(root);
 
     setLogFilename(settings.value("logFilename", "").toString());
+    setUnpaced(settings.value("unpaced", false).toBool());
+    setMaxMessagesPerSecond(settings.value("maxMessagesPerSecond", 0).toUInt());
 
     settings.endGroup();
 }
@@ -55,6 +64,8 @@ void LogReplayConfiguration::saveSettings(QSettings &settings, const QString &ro
     settings.beginGroup(root);
 
     settings.setValue("logFilename", _logFilename);
+    settings.setValue("unpaced", _unpaced);
+    settings.setValue("maxMessagesPerSecond", _maxMessagesPerSecond);
 
     settings.endGroup();
 }
@@ -72,6 +83,22 @@ void LogReplayConfiguration::setLogFilename(const QString &logFilename)
     }
 }
 
+void LogReplayConfiguration::setUnpaced(bool unpaced)
+{
+    if (unpaced != _unpaced) {
+        _unpaced = unpaced;
+        emit unpacedChanged();
+    }
+}
+
+void LogReplayConfiguration::setMaxMessagesPerSecond(uint32_t maxMessagesPerSecond)
+{
+    if (maxMessagesPerSecond != _maxMessagesPerSecond) {
+        _maxMessagesPerSecond = maxMessagesPerSecond;
+        emit maxMessagesPerSecondChanged();
+    }
+}
+
 /*===========================================================================*/
 
 LogReplayWorker::LogReplayWorker(const LogReplayConfiguration *config, QObject *parent)
@@ -114,6 +141,9 @@ void LogReplayWorker::connectToLog()
         return;
     }
 
+    _unpaced = _logReplayConfig->unpaced();
+    _maxMessagesPerSecond = _logReplayConfig->maxMessagesPerSecond();
+
     _isConnected = true;
     emit connected();
 
@@ -133,9 +163,7 @@ void LogReplayWorker::disconnectFromLog()
         _readTickTimer->stop();
     }
 
-    if (_logFile.isOpen()) {
-        _logFile.close();
-    }
+    _closeLogFile();
 
     _isConnected = false;
     emit disconnected();
@@ -151,12 +179,19 @@ void LogReplayWorker::play()
     LinkManager::instance()->setConnectionsSuspended(tr("Connect not allowed during Flight Data replay."));
     MAVLinkProtocol::instance()->suspendLogForReplay(true);
 
-    if (_logFile.atEnd()) {
+    if (_atEnd()) {
         _resetPlaybackToBeginning();
     }
 
     _playbackStartTimeMSecs = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch());
     _playbackStartLogTimeUSecs = _logCurrentTimeUSecs;
+    if (_unpaced) {
+        _unpacedClock.start();
+        _lastProgressMSecs = 0;
+        _unpacedFrames = 0;
+        _unpacedBytes = 0;
+        _unpacedReadNs = 0;
+    }
     _readTickTimer->start(1);
 
     emit playbackStarted();
@@ -190,41 +225,39 @@ void LogReplayWorker::movePlayhead(qreal percentComplete)
     }
 
     percentComplete = qBound(0., percentComplete, 100.);
-    const qreal percentCompleteMult = percentComplete / 100.0;
-    const qint64 newFilePos = static_cast<qint64>(percentCompleteMult * static_cast<qreal>(_logFile.size()));
-    if (!_logFile.seek(newFilePos)) {
-        emit errorOccurred(tr("Unable to seek to new position"));
+
+    if (!_index.isBuilt()) {
+        // Applied as soon as the background index build finishes
+        _pendingPlayheadPercent = percentComplete;
         return;
     }
 
-    mavlink_message_t dummy{};
-    _logCurrentTimeUSecs = _seekToNextMavlinkMessage(dummy);
-
-    qreal newRelativeTimeUSecs = static_cast<qreal>(_logCurrentTimeUSecs - _logStartTimeUSecs);
-    const qreal baudRate = _logFile.size() / static_cast<qreal>(_logDurationUSecs) / 1e6;
-    const qreal desiredTimeUSecs = percentCompleteMult * _logDurationUSecs;
-    const qint64 offset = (newRelativeTimeUSecs - desiredTimeUSecs) * baudRate;
-    if (!_logFile.seek(_logFile.pos() + offset)) {
-        emit errorOccurred(tr("Unable to seek to new position"));
-        return;
+    const quint64 desiredTimeUSecs = _logStartTimeUSecs + static_cast<quint64>((percentComplete / 100.0) * _logDurationUSecs);
+    TlogIndex::Record record;
+    if (_index.seek(desiredTimeUSecs, record)) {
+        _logOffset = record.offset;
+        _logCurrentTimeUSecs = record.timestampUSecs;
+    } else {
+        _logOffset = _logFileSize;
+        _logCurrentTimeUSecs = _logEndTimeUSecs;
     }
 
-    _logCurrentTimeUSecs = _seekToNextMavlinkMessage(dummy);
     _signalCurrentLogTimeSecs();
 
-    newRelativeTimeUSecs = static_cast<qreal>(_logCurrentTimeUSecs - _logStartTimeUSecs);
+    const qreal newRelativeTimeUSecs = static_cast<qreal>(_logCurrentTimeUSecs - _logStartTimeUSecs);
     percentComplete = ((newRelativeTimeUSecs / _logDurationUSecs) * 100);
     emit playbackPercentCompleteChanged(percentComplete);
 }
 
-void LogReplayWorker::_resetPlaybackToBeginning()
+bool LogReplayWorker::_atEnd() const
 {
-    if (_logFile.isOpen()) {
-        if (!_logFile.reset()) {
-            qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile.error() << _logFile.errorString();
-        }
-    }
+    TlogIndex::Record record;
+    return !_index.readRecord(_logOffset, record);
+}
 
+void LogReplayWorker::_resetPlaybackToBeginning()
+{
+    _logOffset = 0;
     _playbackStartTimeMSecs = 0;
     _playbackStartLogTimeUSecs = 0;
     _logCurrentTimeUSecs = _logStartTimeUSecs;
@@ -232,26 +265,51 @@ void LogReplayWorker::_resetPlaybackToBeginning()
 
 void LogReplayWorker::_readNextLogEntry()
 {
+    if (_unpaced) {
+        _readNextBatchUnpaced();
+        return;
+    }
+
+    // Everything due within the next few msecs goes out as one contiguous MAVLink stream
+    QByteArray frames;
     int timeToNextExecutionMSecs = 0;
-    while (timeToNextExecutionMSecs < 3) {
-        QByteArray bytes;
-        bytes.reserve(_logFile.bytesAvailable());
-        const qint64 nextTimeUSecs = _readNextMavlinkMessage(bytes);
-        emit dataReceived(bytes);
-        emit playbackPercentCompleteChanged((static_cast<float>(_logCurrentTimeUSecs - _logStartTimeUSecs) / static_cast<float>(_logDurationUSecs)) * 100);
+    bool atEnd = false;
+    TlogIndex::Record record;
+    while (true) {
+        if (!_index.readRecord(_logOffset, record)) {
+            _logOffset = _logFileSize;
+            atEnd = true;
+            break;
+        }
 
-        if (_logFile.atEnd()) {
-            pause();
-            emit playbackAtEnd();
-            return;
+        _logCurrentTimeUSecs = record.timestampUSecs;
+
+        const quint64 logMovementUSecs = (_logCurrentTimeUSecs > _playbackStartLogTimeUSecs) ? (_logCurrentTimeUSecs - _playbackStartLogTimeUSecs) : 0;
+        const qint64 desiredCurrentTimeMSecs = static_cast<qint64>(_playbackStartTimeMSecs) + static_cast<qint64>((logMovementUSecs / 1000) / _playbackSpeed);
+        timeToNextExecutionMSecs = static_cast<int>(desiredCurrentTimeMSecs - QDateTime::currentMSecsSinceEpoch());
+        if (timeToNextExecutionMSecs >= 3) {
+            break;
         }
 
-        _logCurrentTimeUSecs = nextTimeUSecs;
+        if (frames.size() >= kMaxBatchBytes) {
+            // Running behind; let the event loop breathe before sending the rest
+            timeToNextExecutionMSecs = 0;
+            break;
+        }
+
+        (void) frames.append(reinterpret_cast<const char*>(_logData + record.frameOffset), record.frameLength);
+        _logOffset = record.nextOffset();
+    }
 
-        const quint64 currentTimeMSecs = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch());
-        const quint64 desiredPlayheadMovementTimeMSecs = ((_logCurrentTimeUSecs - _playbackStartLogTimeUSecs) / 1000) / _playbackSpeed;
-        const quint64 desiredCurrentTimeMSecs = _playbackStartTimeMSecs + desiredPlayheadMovementTimeMSecs;
-        timeToNextExecutionMSecs = desiredCurrentTimeMSecs - currentTimeMSecs;
+    if (!frames.isEmpty()) {
+        emit dataReceived(frames);
+    }
+    emit playbackPercentCompleteChanged((static_cast<float>(_logCurrentTimeUSecs - _logStartTimeUSecs) / static_cast<float>(_logDurationUSecs)) * 100);
+
+    if (atEnd) {
+        pause();
+        emit playbackAtEnd();
+        return;
     }
 
     _signalCurrentLogTimeSecs();
@@ -259,6 +317,80 @@ void LogReplayWorker::_readNextLogEntry()
     _readTickTimer->start(timeToNextExecutionMSecs);
 }
 
+void LogReplayWorker::batchConsumed()
+{
+    if (_batchesInFlight > 0) {
+        --_batchesInFlight;
+    }
+
+    if (_unpaced && isPlaying()) {
+        _readNextBatchUnpaced();
+    }
+}
+
+void LogReplayWorker::_readNextBatchUnpaced()
+{
+    // Batches are only limited by how many the GUI thread has yet to consume, and by the optional rate cap
+    while (_batchesInFlight < kMaxBatchesInFlight) {
+        qint64 frameBudget = std::numeric_limits<qint64>::max();
+        if (_maxMessagesPerSecond > 0) {
+            frameBudget = ((_unpacedClock.elapsed() * _maxMessagesPerSecond) / 1000) - static_cast<qint64>(_unpacedFrames);
+            if (frameBudget <= 0) {
+                _readTickTimer->start(1);
+                return;
+            }
+        }
+
+        QElapsedTimer readTimer;
+        readTimer.start();
+
+        QByteArray frames;
+        qint64 frameCount = 0;
+        bool atEnd = false;
+        TlogIndex::Record record;
+        while ((frames.size() < kMaxBatchBytes) && (frameCount < frameBudget)) {
+            if (!_index.readRecord(_logOffset, record)) {
+                _logOffset = _logFileSize;
+                atEnd = true;
+                break;
+            }
+
+            (void) frames.append(reinterpret_cast<const char*>(_logData + record.frameOffset), record.frameLength);
+            _logOffset = record.nextOffset();
+            _logCurrentTimeUSecs = record.timestampUSecs;
+            ++frameCount;
+        }
+
+        _unpacedReadNs += readTimer.nsecsElapsed();
+
+        if (!frames.isEmpty()) {
+            _unpacedFrames += static_cast<quint64>(frameCount);
+            _unpacedBytes += static_cast<quint64>(frames.size());
+            ++_batchesInFlight;
+            emit dataReceived(frames);
+        }
+
+        if (atEnd) {
+            emit playbackPercentCompleteChanged(100);
+            _signalCurrentLogTimeSecs();
+            pause();
+            emit playbackAtEnd();
+            emit unpacedPlaybackFinished(_unpacedFrames, _unpacedBytes, _unpacedReadNs);
+            return;
+        }
+    }
+
+    const qint64 nowMSecs = _unpacedClock.elapsed();
+    if ((nowMSecs - _lastProgressMSecs) >= kUnpacedProgressIntervalMSecs) {
+        _lastProgressMSecs = nowMSecs;
+        emit playbackPercentCompleteChanged((static_cast<float>(_logCurrentTimeUSecs - _logStartTimeUSecs) / static_cast<float>(_logDurationUSecs)) * 100);
+        _signalCurrentLogTimeSecs();
+    }
+
+    // batchConsumed() picks up from here; the idle tick only keeps isPlaying() true
+    _readTickTimer->start(kUnpacedProgressIntervalMSecs);
+}
+
 void LogReplayWorker::_signalCurrentLogTimeSecs()
 {
     emit currentLogTimeSecs((_logCurrentTimeUSecs - _logStartTimeUSecs) / 1000000);
@@ -267,7 +399,7 @@ void LogReplayWorker::_signalCurrentLogTimeSecs()
 bool LogReplayWorker::_loadLogFile()
 {
     if (_logFile.isOpen()) {
-        _logFile.close();
+        _closeLogFile();
         emit errorOccurred(tr("Attempt to load new log while log being played"));
         return false;
     }
@@ -279,14 +411,22 @@ bool LogReplayWorker::_loadLogFile()
         return false;
     }
 
-    QFileInfo logFileInfo;
-    logFileInfo.setFile(logFilename);
-    _logFileSize = logFileInfo.size();
+    _logFileSize = _logFile.size();
+    if (_logFileSize > TlogIndex::kTimestampBytes) {
+        _logData = _logFile.map(0, _logFileSize);
+        if (!_logData) {
+            const QString errorString = _logFile.errorString();
+            _closeLogFile();
+            emit errorOccurred(tr("Unable to map log file: '%1', error: %2").arg(logFilename, errorString));
+            return false;
+        }
+        _index.setData(_logData, _logFileSize);
+    }
 
-    const quint64 startTimeUSecs = _parseTimestamp(_logFile.read(kTimestamp));
-    const quint64 endTimeUSecs = _findLastTimestamp();
+    const quint64 startTimeUSecs = _index.firstTimestamp();
+    const quint64 endTimeUSecs = _index.findLastTimestamp();
     if (endTimeUSecs <= startTimeUSecs) {
-        _logFile.close();
+        _closeLogFile();
         emit errorOccurred(tr("The log file '%1' is corrupt or empty.").arg(logFilename));
         return false;
     }
@@ -295,10 +435,9 @@ bool LogReplayWorker::_loadLogFile()
     _logStartTimeUSecs = startTimeUSecs;
     _logDurationUSecs = endTimeUSecs - startTimeUSecs;
     _logCurrentTimeUSecs = startTimeUSecs;
+    _logOffset = 0;
 
-    if (!_logFile.reset()) {
-        qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile.error() << _logFile.errorString();
-    }
+    _startIndexBuild();
 
     const quint64 logDurationSecondsTotal = _logDurationUSecs / 1000000;
     emit logFileStats(logDurationSecondsTotal);
@@ -306,92 +445,66 @@ bool LogReplayWorker::_loadLogFile()
     return true;
 }
 
-quint64 LogReplayWorker::_parseTimestamp(const QByteArray &bytes)
+void LogReplayWorker::_closeLogFile()
 {
-    const quint64 currentTimestamp = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000;
-    quint64 timestamp = qFromBigEndian(*reinterpret_cast<const quint64*>(bytes.constData()));
-    if (timestamp > currentTimestamp) {
-        timestamp = qbswap(timestamp);
+    if (_indexWatcher) {
+        // The build reads from the mapping, so it has to be gone before the unmap below
+        _indexCancel->store(true);
+        (void) _indexWatcher->disconnect(this);
+        _indexWatcher->waitForFinished();
+        delete _indexWatcher;
+        _indexWatcher = nullptr;
     }
+    _pendingPlayheadPercent = -1;
 
-    return timestamp;
-}
-
-quint64 LogReplayWorker::_readNextMavlinkMessage(QByteArray &bytes)
-{
-    bytes.clear();
-
-    char nextByte;
-    while (_logFile.getChar(&nextByte)) {
-        mavlink_message_t message{};
-        mavlink_status_t status{};
-        const bool messageFound = mavlink_parse_char(_mavlinkChannel, nextByte, &message, &status);
-
-        if (status.parse_state == MAVLINK_PARSE_STATE_GOT_STX) {
-            bytes.clear();
-        }
-        (void) bytes.append(nextByte);
-
-        if (messageFound) {
-            const QByteArray rawTime = _logFile.read(kTimestamp);
-            return _parseTimestamp(rawTime);
-        }
+    _index.setData(nullptr, 0);
+    if (_logData) {
+        (void) _logFile.unmap(_logData);
+        _logData = nullptr;
     }
 
-    return 0;
+    if (_logFile.isOpen()) {
+        _logFile.close();
+    }
 }
 
-quint64 LogReplayWorker::_seekToNextMavlinkMessage(mavlink_message_t &nextMsg)
+void LogReplayWorker::_startIndexBuild()
 {
-    mavlink_reset_channel_status(_mavlinkChannel);
-
-    qint64 messageStartPos = -1;
-    char nextByte;
-    while (_logFile.getChar(&nextByte)) {
-        mavlink_status_t status{};
-        const bool messageFound = mavlink_parse_char(_mavlinkChannel, nextByte, &nextMsg, &status);
-
-        if (status.parse_state == MAVLINK_PARSE_STATE_GOT_STX) {
-            messageStartPos = _logFile.pos() - 1;
-        }
-
-        if (messageFound && (messageStartPos != -1)) {
-            if (!_logFile.seek(messageStartPos - kTimestamp)) {
-                qCWarning(LogReplayLinkLog) << "Failed to seek next message:" << _logFile.error() << _logFile.errorString();
-                break;
-            }
-
-            const QByteArray rawTime = _logFile.read(kTimestamp);
-            return _parseTimestamp(rawTime);
-        }
+    const QString logFilename = _logReplayConfig->logFilename();
+    if (_index.loadCache(logFilename)) {
+        qCDebug(LogReplayLinkLog) << "Using cached index" << TlogIndex::cacheFileName(logFilename);
+        return;
     }
 
-    return 0;
+    _indexCancel = std::make_shared<std::atomic<bool>>(false);
+    _indexWatcher = new QFutureWatcher<TlogIndex>(this);
+    (void) connect(_indexWatcher, &QFutureWatcher<TlogIndex>::finished, this, &LogReplayWorker::_indexBuildFinished);
+    _indexWatcher->setFuture(QtConcurrent::run([index = _index, cancel = _indexCancel, logFilename]() mutable {
+        if (index.build(cancel.get())) {
+            (void) index.saveCache(logFilename);
+        }
+        return index;
+    }));
 }
 
-quint64 LogReplayWorker::_findLastTimestamp()
+void LogReplayWorker::_indexBuildFinished()
 {
-    if (!_logFile.reset()) {
-        qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile.error() << _logFile.errorString();
-    }
+    const TlogIndex index = _indexWatcher->result();
+    _indexWatcher->deleteLater();
+    _indexWatcher = nullptr;
 
-    mavlink_reset_channel_status(_mavlinkChannel);
-
-    quint64 lastTimestamp = 0;
+    if (!index.isBuilt()) {
+        return;
+    }
 
-    while (_logFile.bytesAvailable() > static_cast<qint64>(kTimestamp)) {
-        lastTimestamp = _parseTimestamp(_logFile.read(kTimestamp));
+    qCDebug(LogReplayLinkLog) << "Index ready:" << index.recordCount() << "records";
+    _index = index;
 
-        bool endOfMessage = false;
-        char nextByte;
-        while (!endOfMessage && _logFile.getChar(&nextByte)) {
-            mavlink_message_t msg{};
-            mavlink_status_t status{};
-            endOfMessage = mavlink_parse_char(_mavlinkChannel, nextByte, &msg, &status);
-        }
+    if (_pendingPlayheadPercent >= 0) {
+        const qreal percentComplete = _pendingPlayheadPercent;
+        _pendingPlayheadPercent = -1;
+        movePlayhead(percentComplete);
     }
-
-    return lastTimestamp;
 }
 
 /*===========================================================================*/
@@ -422,6 +535,8 @@ LogReplayLink::LogReplayLink(SharedLinkConfigurationPtr &config, QObject *parent
     (void) connect(_worker, &LogReplayWorker::playbackPercentCompleteChanged, this, &LogReplayLink::playbackPercentCompleteChanged, Qt::QueuedConnection);
     (void) connect(_worker, &LogReplayWorker::currentLogTimeSecs, this, &LogReplayLink::currentLogTimeSecs, Qt::QueuedConnection);
     (void) connect(_worker, &LogReplayWorker::disconnected, this, &LogReplayLink::disconnected, Qt::QueuedConnection);
+    (void) connect(_worker, &LogReplayWorker::playbackStarted, this, &LogReplayLink::_onPlaybackStarted, Qt::QueuedConnection);
+    (void) connect(_worker, &LogReplayWorker::unpacedPlaybackFinished, this, &LogReplayLink::_onUnpacedPlaybackFinished, Qt::QueuedConnection);
 
     _workerThread->start();
 }
@@ -466,6 +581,11 @@ void LogReplayLink::_onConnected()
 
 void LogReplayLink::_onDisconnected()
 {
+    if (_unpacedWallTimer.isValid()) {
+        _unpacedWallTimer.invalidate();
+        (void) MAVLinkProtocol::instance()->stopReceiveStageTiming();
+    }
+
     if (!_disconnectedEmitted.exchange(true)) {
         emit disconnected();
     }
@@ -480,6 +600,49 @@ void LogReplayLink::_onErrorOccurred(const QString &errorString)
 void LogReplayLink::_onDataReceived(const QByteArray &data)
 {
     emit bytesReceived(this, data);
+
+    if (_logReplayConfig->unpaced()) {
+        (void) QMetaObject::invokeMethod(_worker, "batchConsumed", Qt::QueuedConnection);
+    }
+}
+
+void LogReplayLink::_onPlaybackStarted()
+{
+    if (_logReplayConfig->unpaced()) {
+        _unpacedWallTimer.start();
+        MAVLinkProtocol::instance()->startReceiveStageTiming(this);
+    }
+}
+
+void LogReplayLink::_onUnpacedPlaybackFinished(quint64 framesRead, quint64 bytesRead, qint64 readNs)
+{
+    if (!_unpacedWallTimer.isValid()) {
+        return;
+    }
+
+    const MAVLinkProtocol::ReceiveStageTiming timing = MAVLinkProtocol::instance()->stopReceiveStageTiming();
+
+    LogReplayStats stats;
+    stats.framesRead = framesRead;
+    stats.bytesRead = bytesRead;
+    stats.messagesDecoded = timing.messages;
+    stats.wallNs = _unpacedWallTimer.nsecsElapsed();
+    stats.readNs = readNs;
+    stats.decodeNs = timing.decodeNs;
+    stats.dispatchNs = timing.dispatchNs;
+    _unpacedWallTimer.invalidate();
+
+    qCInfo(LogReplayLinkLog).noquote()
+        << QStringLiteral("Unpaced replay: %1 messages, %2 bytes in %3 ms (%4 msg/s); read %5 ms, decode %6 ms, dispatch %7 ms")
+               .arg(stats.messagesDecoded)
+               .arg(stats.bytesRead)
+               .arg(stats.wallNs / 1e6, 0, 'f', 1)
+               .arg(stats.messagesPerSecond(), 0, 'f', 0)
+               .arg(stats.readNs / 1e6, 0, 'f', 1)
+               .arg(stats.decodeNs / 1e6, 0, 'f', 1)
+               .arg(stats.dispatchNs / 1e6, 0, 'f', 1);
+
+    emit unpacedPlaybackFinished(stats);
 }
 
 bool LogReplayLink::isPlaying() const
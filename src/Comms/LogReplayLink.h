@@ -3,13 +3,17 @@
 #include "LinkConfiguration.h"
 #include "LinkInterface.h"
 #include "QGCMAVLinkTypes.h"
+#include "TlogIndex.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtQmlIntegration/QtQmlIntegration>
 
 #include <atomic>
+#include <memory>
 
 class QTimer;
+template <typename T> class QFutureWatcher;
 
 /*===========================================================================*/
 
@@ -18,7 +22,9 @@ class LogReplayConfiguration : public LinkConfiguration
     Q_OBJECT
     QML_ELEMENT
     QML_UNCREATABLE("")
-    Q_PROPERTY(QString filename READ logFilename WRITE setLogFilename NOTIFY filenameChanged)
+    Q_PROPERTY(QString  filename                READ logFilename            WRITE setLogFilename            NOTIFY filenameChanged)
+    Q_PROPERTY(bool     unpaced                 READ unpaced                WRITE setUnpaced                NOTIFY unpacedChanged)
+    Q_PROPERTY(uint     maxMessagesPerSecond    READ maxMessagesPerSecond   WRITE setMaxMessagesPerSecond   NOTIFY maxMessagesPerSecondChanged)
 
 public:
     explicit LogReplayConfiguration(const QString &name, QObject *parent = nullptr);
@@ -36,12 +42,41 @@ class LogReplayConfiguration : public LinkConfiguration
     QString logFilename() const { return _logFilename; }
     void setLogFilename(const QString &logFilename);
 
+    /// Replay as fast as the receive path keeps up instead of at log time
+    bool unpaced() const { return _unpaced; }
+    void setUnpaced(bool unpaced);
+
+    /// Cap for unpaced replay, 0 for none
+    uint32_t maxMessagesPerSecond() const { return _maxMessagesPerSecond; }
+    void setMaxMessagesPerSecond(uint32_t maxMessagesPerSecond);
+
 signals:
     void filenameChanged();
+    void unpacedChanged();
+    void maxMessagesPerSecondChanged();
 
 private:
     QString _logFilename;
+    bool _unpaced = false;
+    uint32_t _maxMessagesPerSecond = 0;
+};
+
+/*===========================================================================*/
+
+/// Throughput and per-stage timing of an unpaced replay, from playbackStarted() to the end of the log.
+struct LogReplayStats
+{
+    quint64 framesRead = 0;
+    quint64 bytesRead = 0;
+    quint64 messagesDecoded = 0;
+    qint64 wallNs = 0;
+    qint64 readNs = 0;          ///< Framing records out of the mapped log (replay thread)
+    qint64 decodeNs = 0;        ///< MAVLinkProtocol framing, signing, loss accounting (GUI thread)
+    qint64 dispatchNs = 0;      ///< messageReceived handlers: vehicles, fact groups, plugins (GUI thread)
+
+    double messagesPerSecond() const { return (wallNs > 0) ? ((messagesDecoded * 1e9) / wallNs) : 0; }
 };
+Q_DECLARE_METATYPE(LogReplayStats)
 
 /*===========================================================================*/
 
@@ -67,6 +102,7 @@ class LogReplayWorker : public QObject
     void playbackAtEnd();
     void playbackPercentCompleteChanged(qreal percentComplete);
     void currentLogTimeSecs(uint32_t secs);
+    void unpacedPlaybackFinished(quint64 framesRead, quint64 bytesRead, qint64 readNs);
 
 public slots:
     void setup();
@@ -76,16 +112,19 @@ public slots:
     void pause();
     void setPlaybackSpeed(qreal playbackSpeed);
     void movePlayhead(qreal percentComplete);
+    /// Unpaced replay: the link has handed a batch from dataReceived() to the receive path.
+    void batchConsumed();
 
 private slots:
     void _readNextLogEntry();
 
 private:
-    quint64 _parseTimestamp(const QByteArray &bytes);
-    quint64 _seekToNextMavlinkMessage(mavlink_message_t &nextMsg);
-    quint64 _findLastTimestamp();
-    quint64 _readNextMavlinkMessage(QByteArray &bytes);
+    void _readNextBatchUnpaced();
     bool _loadLogFile();
+    void _closeLogFile();
+    void _startIndexBuild();
+    void _indexBuildFinished();
+    bool _atEnd() const;
     void _resetPlaybackToBeginning();
     void _signalCurrentLogTimeSecs();
 
@@ -93,7 +132,6 @@ private slots:
     QTimer *_readTickTimer = nullptr;
 
     bool _isConnected = false;
-    uint8_t _mavlinkChannel = 0;
 
     quint64 _logCurrentTimeUSecs = 0;
     quint64 _logStartTimeUSecs = 0;
@@ -104,10 +142,31 @@ private slots:
     quint64 _playbackStartTimeMSecs = 0;
     quint64 _playbackStartLogTimeUSecs = 0;
 
+    /// Frames are read straight out of the mapping; the index only has to exist for seeking.
     QFile _logFile;
-    quint64 _logFileSize = 0;
-
-    static constexpr size_t kTimestamp = sizeof(quint64);
+    uchar *_logData = nullptr;
+    qint64 _logFileSize = 0;
+    qint64 _logOffset = 0;      ///< Next record to play
+
+    TlogIndex _index;
+    QFutureWatcher<TlogIndex> *_indexWatcher = nullptr;
+    std::shared_ptr<std::atomic<bool>> _indexCancel;
+    qreal _pendingPlayheadPercent = -1;    ///< Seek requested before the index was ready
+
+    bool _unpaced = false;
+    uint32_t _maxMessagesPerSecond = 0;
+    int _batchesInFlight = 0;
+    QElapsedTimer _unpacedClock;
+    qint64 _lastProgressMSecs = 0;
+    quint64 _unpacedFrames = 0;
+    quint64 _unpacedBytes = 0;
+    qint64 _unpacedReadNs = 0;
+
+    /// Upper bound on frames handed to the link per timer tick.
+    static constexpr qsizetype kMaxBatchBytes = 16 * 1024;
+    /// Unpaced batches queued to the GUI thread before the reader waits for batchConsumed().
+    static constexpr int kMaxBatchesInFlight = 4;
+    static constexpr int kUnpacedProgressIntervalMSecs = 100;
 };
 
 /*===========================================================================*/
@@ -137,9 +196,13 @@ class LogReplayLink : public LinkInterface
     void playbackAtEnd();
     void playbackPercentCompleteChanged(qreal percentComplete);
     void currentLogTimeSecs(uint32_t secs);
+    /// Unpaced replay reached the end of the log.
+    void unpacedPlaybackFinished(const LogReplayStats &stats);
 
 private slots:
     void _writeBytes(const QByteArray &bytes) override { Q_UNUSED(bytes); }
+    void _onPlaybackStarted();
+    void _onUnpacedPlaybackFinished(quint64 framesRead, quint64 bytesRead, qint64 readNs);
     void _onConnected();
     void _onDisconnected();
     void _onErrorOccurred(const QString &errorString);
@@ -152,4 +215,5 @@ private slots:
     LogReplayWorker *_worker = nullptr;
     QThread *_workerThread = nullptr;
     std::atomic<bool> _disconnectedEmitted{false};
+    QElapsedTimer _unpacedWallTimer;
 };
@@ -2,19 +2,24 @@
 
 #include <QtCore/QApplicationStatic>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QMetaType>
 #include <QtCore/QSettings>
 #include <QtCore/QStandardPaths>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
+#include <chrono>
 #include <cstring>
+#include <utility>
 
 #include "AppMessages.h"
 #include "AppSettings.h"
 #include "LinkManager.h"
 #include "MAVLinkLib.h"
 #include "LinkInterface.h"
+#include "MAVLinkFrameScanner.h"
 #include "MAVLinkSigning.h"
 #include "SigningController.h"
 #include "MavlinkSettings.h"
@@ -28,8 +33,11 @@ QGC_LOGGING_CATEGORY(MAVLinkProtocolLog, "Comms.MAVLinkProtocol")
 
 Q_APPLICATION_STATIC(MAVLinkProtocol, _mavlinkProtocolInstance);
 
-MAVLinkProtocol::MAVLinkProtocol(QObject* parent) : QObject(parent), _tempLogFile(new QFile(this))
+MAVLinkProtocol::MAVLinkProtocol(QObject* parent) : QObject(parent), _logWriter(new TelemetryLogWriter(this))
 {
+    (void)connect(_logWriter, &TelemetryLogWriter::writeFailed, this, &MAVLinkProtocol::_logWriteFailed,
+                  Qt::QueuedConnection);
+
     qCDebug(MAVLinkProtocolLog) << this;
 }
 
@@ -53,6 +61,8 @@ void MAVLinkProtocol::init()
 
     (void)connect(MultiVehicleManager::instance(), &MultiVehicleManager::vehicleRemoved, this,
                   &MAVLinkProtocol::_vehicleCountChanged);
+    (void)connect(SettingsManager::instance()->mavlinkSettings()->forwardMavlink(), &Fact::rawValueChanged, this,
+                  &MAVLinkProtocol::invalidateForwarding);
 
     _initialized = true;
 }
@@ -60,9 +70,18 @@ void MAVLinkProtocol::init()
 void MAVLinkProtocol::resetMetadataForLink(LinkInterface* link)
 {
     const uint8_t channel = link->mavlinkChannel();
-    _totalReceiveCounter[channel] = 0;
-    _totalLossCounter[channel] = 0;
-    _runningLossPercent[channel] = 0.f;
+    // The counters belong to the decoding thread, which may be the link's worker thread.
+    _countersResetPending[channel].store(true, std::memory_order_release);
+
+    // A new link on a recycled channel must not inherit the previous link's undelivered messages.
+    {
+        PendingMessages& pending = _pending[channel];
+        QMutexLocker locker(&pending.mutex);
+        pending.link = link;
+        pending.messages.clear();
+        pending.statuses.clear();
+        pending.dropped = 0;
+    }
 
     link->setDecodedFirstMavlinkPacket(false);
 }
@@ -70,33 +89,20 @@ void MAVLinkProtocol::resetMetadataForLink(LinkInterface* link)
 void MAVLinkProtocol::resetSequenceTracking(LinkInterface* link)
 {
     // Clear per-(sysid,compid) sequence state so next packet isn't counted as a gap.
-    const uint8_t channel = link->mavlinkChannel();
-    _firstMessageSeen[channel].clear();
-    std::memset(_lastIndex[channel], 0, sizeof(_lastIndex[channel]));
+    _sequenceResetPending[link->mavlinkChannel()].store(true, std::memory_order_release);
 }
 
 void MAVLinkProtocol::logSentBytes(const LinkInterface* link, const QByteArray& data)
 {
     Q_UNUSED(link);
 
-    if (_logSuspendError || _logSuspendReplay || !_tempLogFile->isOpen()) {
+    if (_logSuspendError || _logSuspendReplay) {
         return;
     }
 
-    const quint64 time = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() * 1000);
-    uint8_t bytes_time[sizeof(quint64)]{};
-    qToBigEndian(time, bytes_time);
-
-    QByteArray logData = data;
-    QByteArray timeData = QByteArray::fromRawData(reinterpret_cast<const char*>(bytes_time), sizeof(bytes_time));
-    (void)logData.prepend(timeData);
-    if (_tempLogFile->write(logData) != logData.length()) {
-        const QString message = QStringLiteral("MAVLink Logging failed. Could not write to file %1, logging disabled.")
-                                    .arg(_tempLogFile->fileName());
-        QGC::showAppMessage(message, getName());
-        _stopLogging();
-        _logSuspendError = true;
-    }
+    // bytesSent is delivered to this object, so this always runs on the GUI thread.
+    (void)_logWriter->logBytes(TelemetryLogWriter::kGuiThreadProducer, TelemetryLogWriter::currentTimestampUsec(),
+                               data);
 }
 
 void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray& data)
@@ -107,48 +113,248 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray& data)
         return;
     }
 
-    for (uint8_t byte : data) {
-        const uint8_t mavlinkChannel = link->mavlinkChannel();
-        mavlink_message_t message{};
-        mavlink_status_t status{};
+    // Stage timing for an unpaced replay wraps the same decode/dispatch path every link takes.
+    const bool timed = (link == _timedLink);
+    QElapsedTimer stageTimer;
+    if (timed) {
+        stageTimer.start();
+    }
+
+    QList<mavlink_message_t> messages;
+    QList<MessageStatus> statuses;
+    _decodeBytes(link, TelemetryLogWriter::kGuiThreadProducer, data, messages, statuses);
+
+    if (timed) {
+        _receiveStageTiming.decodeNs += stageTimer.nsecsElapsed();
+        _receiveStageTiming.messages += static_cast<quint64>(messages.size());
+        stageTimer.restart();
+    }
+
+    (void) _dispatchMessages(link, linkPtr, messages);
 
-        const uint8_t framing = mavlink_parse_char(mavlinkChannel, byte, &message, &status);
-        if (framing == MAVLINK_FRAMING_OK || framing == MAVLINK_FRAMING_BAD_SIGNATURE) {
-            if (SigningController* const sigCtrl = link->signing()) {
-                // Auto-detected key: reset sequence tracking so the key-install gap isn't counted as loss.
-                if (sigCtrl->processFrame(framing == MAVLINK_FRAMING_OK, message)) {
-                    resetSequenceTracking(link);
+    if (timed) {
+        _receiveStageTiming.dispatchNs += stageTimer.nsecsElapsed();
+    }
+
+    _emitStatuses(statuses);
+}
+
+void MAVLinkProtocol::startReceiveStageTiming(const LinkInterface* link)
+{
+    _timedLink = link;
+    _receiveStageTiming = ReceiveStageTiming();
+}
+
+MAVLinkProtocol::ReceiveStageTiming MAVLinkProtocol::stopReceiveStageTiming()
+{
+    _timedLink = nullptr;
+    return std::exchange(_receiveStageTiming, ReceiveStageTiming());
+}
+
+void MAVLinkProtocol::receiveBytesOnLinkThread(LinkInterface* link, const QByteArray& data)
+{
+    const uint8_t mavlinkChannel = link->mavlinkChannel();
+
+    QList<mavlink_message_t> messages;
+    QList<MessageStatus> statuses;
+    _decodeBytes(link, mavlinkChannel, data, messages, statuses);
+    if (messages.isEmpty()) {
+        return;
+    }
+
+    PendingMessages& pending = _pending[mavlinkChannel];
+    {
+        QMutexLocker locker(&pending.mutex);
+        pending.link = link;
+        if ((pending.messages.size() + messages.size()) <= kMaxPendingMessages) {
+            pending.messages.append(std::move(messages));
+        } else {
+            // The GUI thread is behind: fill the backlog up to its limit, then only keep what a vehicle can't
+            // recover from losing.
+            uint64_t dropped = 0;
+            for (const mavlink_message_t& message : std::as_const(messages)) {
+                const qsizetype limit = _keepUnderBackpressure(message.msgid)
+                                            ? (kMaxPendingMessages + kMaxPendingKeptMessages)
+                                            : kMaxPendingMessages;
+                if (pending.messages.size() < limit) {
+                    pending.messages.append(message);
+                } else {
+                    dropped++;
                 }
             }
+            pending.dropped += dropped;
+            (void) _droppedMessages.fetch_add(dropped, std::memory_order_relaxed);
+        }
+        pending.statuses.append(std::move(statuses));
+        if (pending.statuses.size() > kMaxPendingStatuses) {
+            pending.statuses.remove(0, pending.statuses.size() - kMaxPendingStatuses);
+        }
+        if (pending.dispatchQueued) {
+            return;
+        }
+        pending.dispatchQueued = true;
+    }
+
+    (void) QMetaObject::invokeMethod(this, [this, mavlinkChannel]() { _dispatchPending(mavlinkChannel); },
+                                     Qt::QueuedConnection);
+}
+
+void MAVLinkProtocol::_dispatchPending(uint8_t mavlinkChannel)
+{
+    PendingMessages& pending = _pending[mavlinkChannel];
+
+    LinkInterface* link = nullptr;
+    QList<mavlink_message_t> messages;
+    QList<MessageStatus> statuses;
+    uint64_t dropped = 0;
+    bool requeue = false;
+    {
+        QMutexLocker locker(&pending.mutex);
+        link = pending.link;
+        if (pending.messages.size() <= kMaxDispatchBatch) {
+            messages.swap(pending.messages);
+            statuses.swap(pending.statuses);
+            pending.dispatchQueued = false;
+        } else {
+            // Hand over one slice and yield, so a burst can't monopolise the GUI thread.
+            messages = pending.messages.first(kMaxDispatchBatch);
+            pending.messages.remove(0, kMaxDispatchBatch);
+            requeue = true;
+        }
+        dropped = std::exchange(pending.dropped, 0);
+    }
+
+    if (requeue) {
+        (void) QMetaObject::invokeMethod(this, [this, mavlinkChannel]() { _dispatchPending(mavlinkChannel); },
+                                         Qt::QueuedConnection);
+    }
+
+    if (dropped > 0) {
+        qCWarning(MAVLinkProtocolLog) << "GUI dispatch backlog on channel" << mavlinkChannel
+                                      << "dropped" << dropped << "messages," << droppedMessageCount() << "in total";
+    }
+
+    const SharedLinkInterfacePtr linkPtr = LinkManager::instance()->sharedLinkInterfacePointerForLink(link);
+    if (!linkPtr) {
+        qCDebug(MAVLinkProtocolLog) << "link gone!" << messages.size() << "decoded messages arrived too late";
+        return;
+    }
+
+    (void) _dispatchMessages(link, linkPtr, messages);
+    _emitStatuses(statuses);
+}
+
+void MAVLinkProtocol::_emitStatuses(const QList<MessageStatus>& statuses)
+{
+    for (const MessageStatus& status : statuses) {
+        emit mavlinkMessageStatus(status.sysid, status.totalSent, status.totalReceived, status.totalLoss,
+                                  status.lossPercent);
+    }
+}
+
+bool MAVLinkProtocol::_keepUnderBackpressure(uint32_t msgid)
+{
+    switch (msgid) {
+        case MAVLINK_MSG_ID_HEARTBEAT:
+        case MAVLINK_MSG_ID_HIGH_LATENCY:
+        case MAVLINK_MSG_ID_HIGH_LATENCY2:
+        case MAVLINK_MSG_ID_PARAM_VALUE:
+        case MAVLINK_MSG_ID_COMMAND_ACK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void MAVLinkProtocol::_decodeBytes(LinkInterface* link, int logProducer, QByteArrayView data,
+                                   QList<mavlink_message_t>& messages, QList<MessageStatus>& statuses)
+{
+    // Per-link state is constant for the whole buffer; resolve it once rather than per byte.
+    const uint8_t mavlinkChannel = link->mavlinkChannel();
+    if (_countersResetPending[mavlinkChannel].exchange(false, std::memory_order_acq_rel)) {
+        _totalReceiveCounter[mavlinkChannel] = 0;
+        _totalLossCounter[mavlinkChannel] = 0;
+        _runningLossPercent[mavlinkChannel] = 0.f;
+    }
+    SigningController* const sigCtrl = link->signing();
+    bool sawV1Traffic = false;
+
+    ForwardingCache& forwarding = _forwarding[mavlinkChannel];
+    _refreshForwarding(forwarding);
+    // Traffic that arrived over a forwarding link is not forwarded again
+    const bool forward = forwarding.batch.isActive() && !forwarding.batch.router()->isForwardingLink(link);
+    // One timestamp per receive buffer is fine-grained enough for per-stream rate limits.
+    const qint64 nowNs = forward ? std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       std::chrono::steady_clock::now().time_since_epoch()).count()
+                                 : 0;
+
+    MAVLinkFrameScanner scanner(mavlinkChannel, data);
+    while (scanner.next()) {
+        const mavlink_message_t& message = scanner.message();
+        const uint8_t framing = scanner.framing();
+
+        if (sigCtrl) {
+            // Auto-detected key: reset sequence tracking so the key-install gap isn't counted as loss.
+            if (sigCtrl->processFrame(framing == MAVLINK_FRAMING_OK, message)) {
+                resetSequenceTracking(link);
+            }
         }
         if (framing != MAVLINK_FRAMING_OK) {
             continue;
         }
 
         // v1/v2 share per-(sysid,compid) sequence counters; counting v1 makes every v2 appear lost. Skip v1 non-heartbeats.
-        const bool isV1 = (status.flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1);
+        const bool isV1 = scanner.isV1();
         if (isV1 && message.msgid != MAVLINK_MSG_ID_HEARTBEAT) {
-            link->reportMavlinkV1Traffic();
+            sawV1Traffic = true;
             continue;
         }
 
         if (!isV1) {
             _updateCounters(mavlinkChannel, message);
         }
-        if (!linkPtr->linkConfiguration()->isForwarding()) {
-            _forward(message);
-            _forwardSupport(message);
+        if (forward) {
+            forwarding.batch.route(message, nowNs);
         }
-        _logData(link, message);
+        _logData(logProducer, message);
+        _updateStatus(mavlinkChannel, message, statuses);
 
-        if (!_updateStatus(link, linkPtr, mavlinkChannel, message)) {
-            break;
+        messages.append(message);
+    }
+
+    if (forward) {
+        forwarding.batch.flush();
+    }
+
+    if (sawV1Traffic) {
+        (void) QMetaObject::invokeMethod(link, &LinkInterface::reportMavlinkV1Traffic, Qt::AutoConnection);
+    }
+}
+
+bool MAVLinkProtocol::_dispatchMessages(LinkInterface* link, const SharedLinkInterfacePtr& linkPtr,
+                                        const QList<mavlink_message_t>& messages)
+{
+    for (const mavlink_message_t& message : messages) {
+        _handleHeartbeatInfo(link, message);
+
+        emit messageReceived(link, message);
+
+        // Only we still hold the link: it was removed while handling the message.
+        if (linkPtr.use_count() == 1) {
+            return false;
         }
     }
+
+    return true;
 }
 
 void MAVLinkProtocol::_updateCounters(uint8_t mavlinkChannel, const mavlink_message_t& message)
 {
+    if (_sequenceResetPending[mavlinkChannel].exchange(false, std::memory_order_acq_rel)) {
+        _firstMessageSeen[mavlinkChannel].clear();
+        std::memset(_lastIndex[mavlinkChannel], 0, sizeof(_lastIndex[mavlinkChannel]));
+    }
+
     _totalReceiveCounter[mavlinkChannel]++;
 
     uint8_t& lastSeq = _lastIndex[mavlinkChannel][message.sysid][message.compid];
@@ -180,74 +386,72 @@ void MAVLinkProtocol::_updateCounters(uint8_t mavlinkChannel, const mavlink_mess
     _runningLossPercent[mavlinkChannel] = (currentLossPercent + _runningLossPercent[mavlinkChannel]) * 0.5f;
 }
 
-void MAVLinkProtocol::_forward(const mavlink_message_t& message)
+void MAVLinkProtocol::invalidateForwarding()
 {
-    if (message.msgid == MAVLINK_MSG_ID_SETUP_SIGNING) {
+    if (QThread::currentThread() != thread()) {
+        (void) QMetaObject::invokeMethod(this, &MAVLinkProtocol::invalidateForwarding, Qt::QueuedConnection);
         return;
     }
 
-    if (!SettingsManager::instance()->mavlinkSettings()->forwardMavlink()->rawValue().toBool()) {
-        return;
+    // Settings, links and their route filters all belong to the GUI thread, so the table is built here and link
+    // threads only ever load the finished snapshot.
+    std::shared_ptr<const MAVLinkRouter> router = LinkManager::instance()->createMavlinkRouter();
+    {
+        QMutexLocker locker(&_routerMutex);
+        _router.swap(router);
     }
+    (void) _forwardingGeneration.fetch_add(1, std::memory_order_release);
+}
 
-    SharedLinkInterfacePtr forwardingLink = LinkManager::instance()->mavlinkForwardingLink();
-    if (!forwardingLink) {
+void MAVLinkProtocol::_refreshForwarding(ForwardingCache& cache)
+{
+    const uint64_t generation = _forwardingGeneration.load(std::memory_order_acquire);
+    if (cache.generation == generation) {
         return;
     }
+    cache.generation = generation;
 
-    // Strip signature on forward: foreign key would BAD_SIGNATURE on downstream signing-aware parsers.
-    const QByteArray bytes = MAVLinkSigning::serializeUnsignedCopy(message);
-    (void)forwardingLink->writeBytesThreadSafe(bytes.constData(), bytes.size());
+    std::shared_ptr<const MAVLinkRouter> router;
+    {
+        QMutexLocker locker(&_routerMutex);
+        router = _router;
+    }
+    cache.batch.setRouter(std::move(router));
 }
 
-void MAVLinkProtocol::_forwardSupport(const mavlink_message_t& message)
+void MAVLinkProtocol::_logData(int logProducer, const mavlink_message_t& message)
 {
-    if (message.msgid == MAVLINK_MSG_ID_SETUP_SIGNING) {
+    if (_logSuspendError || _logSuspendReplay) {
         return;
     }
 
-    if (!LinkManager::instance()->mavlinkSupportForwardingEnabled()) {
+    if (!_logWriter->isOpen()) {
         return;
     }
 
-    SharedLinkInterfacePtr forwardingSupportLink = LinkManager::instance()->mavlinkForwardingSupportLink();
-    if (!forwardingSupportLink) {
-        return;
-    }
+    // Serialization (signature stripped, SETUP_SIGNING omitted) and file I/O happen on the writer thread.
+    (void)_logWriter->logMessage(logProducer, TelemetryLogWriter::currentTimestampUsec(), message);
 
-    const QByteArray bytes = MAVLinkSigning::serializeUnsignedCopy(message);
-    (void)forwardingSupportLink->writeBytesThreadSafe(bytes.constData(), bytes.size());
-}
-
-void MAVLinkProtocol::_logData(LinkInterface* link, const mavlink_message_t& message)
-{
-    if (!_logSuspendError && !_logSuspendReplay && _tempLogFile->isOpen()) {
-        // MAVLink spec §Logging: omit SETUP_SIGNING (contains secret key)
-        if (message.msgid != MAVLINK_MSG_ID_SETUP_SIGNING) {
-            // MAVLink spec §Logging: strip signature block from logged packets.
-            const QByteArray msgBytes = MAVLinkSigning::serializeUnsignedCopy(message);
-            const quint64 timestamp = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() * 1000);
-            QByteArray log_data;
-            log_data.resize(static_cast<qsizetype>(sizeof(timestamp)) + msgBytes.size());
-            qToBigEndian(timestamp, reinterpret_cast<uint8_t*>(log_data.data()));
-            std::memcpy(log_data.data() + sizeof(timestamp), msgBytes.constData(), msgBytes.size());
-            if (_tempLogFile->write(log_data) != log_data.size()) {
-                const QString logErrorMessage =
-                    QStringLiteral("MAVLink Logging failed. Could not write to file %1, logging disabled.")
-                        .arg(_tempLogFile->fileName());
-                QGC::showAppMessage(logErrorMessage, getName());
-                _stopLogging();
-                _logSuspendError = true;
-            }
-        }
-
-        if ((message.msgid == MAVLINK_MSG_ID_HEARTBEAT) && !_vehicleWasArmed) {
-            if (mavlink_msg_heartbeat_get_base_mode(&message) & MAV_MODE_FLAG_DECODE_POSITION_SAFETY) {
-                _vehicleWasArmed = true;
-            }
+    if ((message.msgid == MAVLINK_MSG_ID_HEARTBEAT) && !_vehicleWasArmed) {
+        if (mavlink_msg_heartbeat_get_base_mode(&message) & MAV_MODE_FLAG_DECODE_POSITION_SAFETY) {
+            _vehicleWasArmed = true;
         }
     }
+}
+
+void MAVLinkProtocol::_logWriteFailed(const QString& fileName)
+{
+    _logSuspendError = true;
 
+    const QString logErrorMessage =
+        QStringLiteral("MAVLink Logging failed. Could not write to file %1, logging disabled.").arg(fileName);
+    QGC::showAppMessage(logErrorMessage, getName());
+    _stopLogging();
+    _logSuspendError = true;
+}
+
+void MAVLinkProtocol::_handleHeartbeatInfo(LinkInterface* link, const mavlink_message_t& message)
+{
     switch (message.msgid) {
         case MAVLINK_MSG_ID_HEARTBEAT: {
             _startLogging();
@@ -276,37 +480,34 @@ void MAVLinkProtocol::_logData(LinkInterface* link, const mavlink_message_t& mes
     }
 }
 
-bool MAVLinkProtocol::_updateStatus(LinkInterface* link, const SharedLinkInterfacePtr linkPtr, uint8_t mavlinkChannel,
-                                    const mavlink_message_t& message)
+void MAVLinkProtocol::_updateStatus(uint8_t mavlinkChannel, const mavlink_message_t& message,
+                                    QList<MessageStatus>& statuses)
 {
     if ((_totalReceiveCounter[mavlinkChannel] % 31) == 0) {
         const uint64_t totalSent = _totalReceiveCounter[mavlinkChannel] + _totalLossCounter[mavlinkChannel];
-        emit mavlinkMessageStatus(message.sysid, totalSent, _totalReceiveCounter[mavlinkChannel],
-                                  _totalLossCounter[mavlinkChannel], _runningLossPercent[mavlinkChannel]);
-    }
-
-    emit messageReceived(link, message);
-
-    if (linkPtr.use_count() == 1) {
-        return false;
+        statuses.append(MessageStatus{message.sysid, totalSent, _totalReceiveCounter[mavlinkChannel],
+                                      _totalLossCounter[mavlinkChannel], _runningLossPercent[mavlinkChannel]});
     }
-
-    return true;
 }
 
 bool MAVLinkProtocol::_closeLogFile()
 {
-    if (!_tempLogFile->isOpen()) {
+    if (!_logWriter->close()) {
         return false;
     }
 
-    if (_tempLogFile->size() == 0) {
-        (void)_tempLogFile->remove();
+    const TelemetryLogWriter::Stats stats = telemetryLogStats();
+    if (stats.droppedRecords > 0) {
+        qCWarning(MAVLinkProtocolLog) << "Telemetry log" << _logWriter->fileName() << "is missing"
+                                      << stats.droppedRecords << "of" << (stats.writtenRecords + stats.droppedRecords)
+                                      << "records";
+    }
+
+    if (stats.bytesWritten == 0) {
+        (void)QFile::remove(_logWriter->fileName());
         return false;
     }
 
-    (void)_tempLogFile->flush();
-    _tempLogFile->close();
     return true;
 }
 
@@ -327,11 +528,11 @@ void MAVLinkProtocol::_startLogging()
     }
 #endif
 
-    if (_tempLogFile->isOpen()) {
+    if (_logSuspendReplay) {
         return;
     }
 
-    if (_logSuspendReplay) {
+    if (_logWriter->isOpen()) {
         return;
     }
 
@@ -344,19 +545,18 @@ void MAVLinkProtocol::_startLogging()
         return;
     }
 
-    _tempLogFile->setFileName(logPath);
-    if (!_tempLogFile->open(QIODevice::WriteOnly)) {
+    if (!_logWriter->open(logPath)) {
         const QString message = QStringLiteral(
                                     "Opening Flight Data file for writing failed. "
                                     "Unable to write to %1. Please choose a different file location.")
-                                    .arg(_tempLogFile->fileName());
+                                    .arg(logPath);
         QGC::showAppMessage(message, getName());
         _closeLogFile();
         _logSuspendError = true;
         return;
     }
 
-    qCDebug(MAVLinkProtocolLog) << "Temp log" << _tempLogFile->fileName();
+    qCDebug(MAVLinkProtocolLog) << "Temp log" << _logWriter->fileName();
     (void)_checkTelemetrySavePath();
 
     _logSuspendError = false;
@@ -364,15 +564,15 @@ void MAVLinkProtocol::_startLogging()
 
 void MAVLinkProtocol::_stopLogging()
 {
-    if (_tempLogFile->isOpen() && _closeLogFile()) {
+    if (_closeLogFile()) {
         auto appSettings = SettingsManager::instance()->appSettings();
         auto mavlinkSettings = SettingsManager::instance()->mavlinkSettings();
         if ((_vehicleWasArmed || mavlinkSettings->telemetrySaveNotArmed()->rawValue().toBool()) &&
             mavlinkSettings->telemetrySave()->rawValue().toBool() &&
             !appSettings->disableAllPersistence()->rawValue().toBool()) {
-            _saveTelemetryLog(_tempLogFile->fileName());
+            _saveTelemetryLog(_logWriter->fileName());
         } else {
-            (void)QFile::remove(_tempLogFile->fileName());
+            (void)QFile::remove(_logWriter->fileName());
         }
     }
 
@@ -1,16 +1,21 @@
 #pragma once
 
 #include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QPair>
 #include <QtCore/QSet>
 #include <QtCore/QString>
+#include <atomic>
+#include <memory>
 
 #include "LinkInterface.h"
 #include "MAVLinkEnums.h"
 #include "MAVLinkMessageType.h"
-
-class QFile;
+#include "MAVLinkRouter.h"
+#include "TelemetryLogWriter.h"
 
 /// \brief MAVLink micro air vehicle protocol reference implementation.
 ///
@@ -33,15 +38,46 @@ class MAVLinkProtocol : public QObject
 
     static int getComponentId() { return MAV_COMP_ID_MISSIONPLANNER; }
 
+    /// Thread-safe: loss counters are cleared by the decoding thread before its next message.
     void resetMetadataForLink(LinkInterface* link);
 
     /// Reset sequence tracking so signing transitions don't inflate loss counters.
+    /// Thread-safe: applied by the decoding thread before its next sequence update.
     void resetSequenceTracking(LinkInterface* link);
 
+    /// Thread-safe receive entry point for links that read on a worker thread. Parsing, signing checks, loss
+    /// accounting, forwarding and telemetry logging run on the calling thread; decoded messages are handed to the
+    /// GUI thread in one batch per event-loop tick.
+    void receiveBytesOnLinkThread(LinkInterface* link, const QByteArray& data);
+
     void suspendLogForReplay(bool suspend) { _logSuspendReplay = suspend; }
 
+    /// Rebuilds the routing table on the GUI thread and publishes it to every channel before its next buffer; call
+    /// when the forwarding settings, the set of links or an endpoint's route filter changes. Calls from other
+    /// threads are deferred to the GUI thread.
+    void invalidateForwarding();
+
     void checkForLostLogFiles();
 
+    /// Time receiveBytes() spent on one link, split by stage.
+    struct ReceiveStageTiming
+    {
+        quint64 messages = 0;
+        qint64 decodeNs = 0;    ///< Framing, signing, loss accounting, forwarding and logging
+        qint64 dispatchNs = 0;  ///< messageReceived handlers (vehicles, fact groups, plugins)
+    };
+
+    /// GUI thread. Starts accumulating ReceiveStageTiming for @p link, replacing any link timed before.
+    void startReceiveStageTiming(const LinkInterface* link);
+    /// GUI thread. Stops timing and returns what was accumulated.
+    ReceiveStageTiming stopReceiveStageTiming();
+
+    /// Queue depth and dropped-record counters of the telemetry log writer.
+    TelemetryLogWriter::Stats telemetryLogStats() const { return _logWriter->stats(); }
+
+    /// Decoded messages dropped because the GUI thread fell too far behind, over all channels.
+    uint64_t droppedMessageCount() const { return _droppedMessages.load(std::memory_order_relaxed); }
+
 signals:
     void vehicleHeartbeatInfo(LinkInterface* link, int vehicleId, int componentId, int vehicleFirmwareType,
                               int vehicleType);
@@ -62,26 +98,84 @@ private slots:
     void _vehicleCountChanged();
 
 private:
-    void _logData(LinkInterface* link, const mavlink_message_t& message);
+    /// A mavlinkMessageStatus snapshot taken while decoding, emitted once the messages before it are dispatched.
+    struct MessageStatus
+    {
+        int sysid = 0;
+        uint64_t totalSent = 0;
+        uint64_t totalReceived = 0;
+        uint64_t totalLoss = 0;
+        float lossPercent = 0.f;
+    };
+
+    /// Decoded messages waiting for the GUI thread, one queue per MAVLink channel.
+    struct PendingMessages
+    {
+        QMutex mutex;
+        LinkInterface* link = nullptr;
+        QList<mavlink_message_t> messages;
+        QList<MessageStatus> statuses;
+        bool dispatchQueued = false;
+        uint64_t dropped = 0;
+    };
+
+    /// The router as last resolved by the thread decoding a channel, with that thread's per-endpoint output.
+    struct ForwardingCache
+    {
+        uint64_t generation = 0;
+        MAVLinkRouteBatch batch;
+    };
+
+    /// Runs on whichever thread reads the link. Appends accepted messages to @p messages and the status snapshots
+    /// taken along the way to @p statuses. @p logProducer is the TelemetryLogWriter ring owned by the calling thread.
+    void _decodeBytes(LinkInterface* link, int logProducer, QByteArrayView data, QList<mavlink_message_t>& messages,
+                      QList<MessageStatus>& statuses);
+    /// GUI thread only. Returns false if the link went away while handling a message.
+    bool _dispatchMessages(LinkInterface* link, const SharedLinkInterfacePtr& linkPtr,
+                           const QList<mavlink_message_t>& messages);
+    void _dispatchPending(uint8_t mavlinkChannel);
+    void _emitStatuses(const QList<MessageStatus>& statuses);
+    /// Messages still queued for the GUI thread once a channel's backlog is over kMaxPendingMessages.
+    static bool _keepUnderBackpressure(uint32_t msgid);
+    void _handleHeartbeatInfo(LinkInterface* link, const mavlink_message_t& message);
+
+    void _logData(int logProducer, const mavlink_message_t& message);
+    void _logWriteFailed(const QString& fileName);
     bool _closeLogFile();
     void _startLogging();
     void _stopLogging();
 
-    void _forward(const mavlink_message_t& message);
-    void _forwardSupport(const mavlink_message_t& message);
+    /// Picks up the router published by the last invalidateForwarding(), if the channel doesn't have it yet
+    void _refreshForwarding(ForwardingCache& cache);
 
     void _updateCounters(uint8_t mavlinkChannel, const mavlink_message_t& message);
-    bool _updateStatus(LinkInterface* link, const SharedLinkInterfacePtr linkPtr, uint8_t mavlinkChannel,
-                       const mavlink_message_t& message);
+    void _updateStatus(uint8_t mavlinkChannel, const mavlink_message_t& message, QList<MessageStatus>& statuses);
 
     void _saveTelemetryLog(const QString& tempLogfile);
     bool _checkTelemetrySavePath();
 
-    QFile* _tempLogFile = nullptr;
+    /// Fed from link threads without locking; opened and closed on the GUI thread.
+    TelemetryLogWriter* _logWriter = nullptr;
+
+    std::atomic<bool> _logSuspendError = false;
+    std::atomic<bool> _logSuspendReplay = false;
+    std::atomic<bool> _vehicleWasArmed = false;
+
+    PendingMessages _pending[MAVLINK_COMM_NUM_BUFFERS];
+    std::atomic<uint64_t> _droppedMessages = 0;
 
-    bool _logSuspendError = false;
-    bool _logSuspendReplay = false;
-    bool _vehicleWasArmed = false;
+    const LinkInterface* _timedLink = nullptr;
+    ReceiveStageTiming _receiveStageTiming;
+
+    /// Only touched by the thread decoding that channel; _forwardingGeneration tells it when to reload _router.
+    ForwardingCache _forwarding[MAVLINK_COMM_NUM_BUFFERS];
+    std::atomic<uint64_t> _forwardingGeneration{0};
+    QMutex _routerMutex;                            ///< Guards _router
+    std::shared_ptr<const MAVLinkRouter> _router;   ///< Built on the GUI thread, immutable once published
+
+    /// Sequence/loss state below is only touched by the thread decoding that channel.
+    std::atomic<bool> _sequenceResetPending[MAVLINK_COMM_NUM_BUFFERS]{};
+    std::atomic<bool> _countersResetPending[MAVLINK_COMM_NUM_BUFFERS]{};
 
     /// Per-(channel, sysid, compid) last sequence ID. Channel-scoped so traffic on link A doesn't perturb expected
     /// sequence on link B (which has independent sequence histories from the same vehicle).
@@ -98,4 +192,13 @@ private slots:
     static constexpr const char* _logFileExtension = "mavlink";
 
     static constexpr uint8_t kMaxCompId = MAV_COMPONENT_ENUM_END - 1;
+
+    /// Messages handed to the GUI per event-loop tick before yielding to rendering and other links.
+    static constexpr qsizetype kMaxDispatchBatch = 512;
+    /// Pending messages per channel beyond which new ones are dropped instead of growing without bound.
+    static constexpr qsizetype kMaxPendingMessages = 16384;
+    /// Headroom above kMaxPendingMessages for the messages _keepUnderBackpressure() accepts.
+    static constexpr qsizetype kMaxPendingKeptMessages = 4096;
+    /// Newest status snapshots kept per channel while the GUI thread is behind.
+    static constexpr qsizetype kMaxPendingStatuses = 64;
 };
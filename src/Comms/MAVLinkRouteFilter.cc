@@ -0,0 +1,82 @@
+#include "MAVLinkRouteFilter.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QStringList>
+
+#include <limits>
+
+QGC_LOGGING_CATEGORY(MAVLinkRouteFilterLog, "Comms.MAVLinkRouteFilter")
+
+template <typename T>
+QList<T> MAVLinkRouteFilter::idsFromText(const QString &text, const QString &key)
+{
+    QList<T> ids;
+    const QStringList parts = text.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString &part : parts) {
+        bool ok = false;
+        const qulonglong value = part.trimmed().toULongLong(&ok);
+        if (!ok || (value > std::numeric_limits<T>::max())) {
+            qCWarning(MAVLinkRouteFilterLog) << "Ignoring invalid id" << part << "in" << key;
+            continue;
+        }
+        if (!ids.contains(static_cast<T>(value))) {
+            ids.append(static_cast<T>(value));
+        }
+    }
+    return ids;
+}
+
+template <typename T>
+QString MAVLinkRouteFilter::idsToText(const QList<T> &ids)
+{
+    QStringList parts;
+    parts.reserve(ids.size());
+    for (const T id : ids) {
+        parts.append(QString::number(id));
+    }
+    return parts.join(QLatin1Char(','));
+}
+
+template QList<uint8_t> MAVLinkRouteFilter::idsFromText<uint8_t>(const QString &, const QString &);
+template QList<uint32_t> MAVLinkRouteFilter::idsFromText<uint32_t>(const QString &, const QString &);
+template QString MAVLinkRouteFilter::idsToText<uint8_t>(const QList<uint8_t> &);
+template QString MAVLinkRouteFilter::idsToText<uint32_t>(const QList<uint32_t> &);
+
+void MAVLinkRouteFilter::loadSettings(QSettings &settings, const QString &root)
+{
+    settings.beginGroup(root);
+
+    allowSysIds = idsFromText<uint8_t>(settings.value("allowSysIds").toString(), root + "/allowSysIds");
+    denySysIds = idsFromText<uint8_t>(settings.value("denySysIds").toString(), root + "/denySysIds");
+    allowCompIds = idsFromText<uint8_t>(settings.value("allowCompIds").toString(), root + "/allowCompIds");
+    denyCompIds = idsFromText<uint8_t>(settings.value("denyCompIds").toString(), root + "/denyCompIds");
+    allowMsgIds = idsFromText<uint32_t>(settings.value("allowMsgIds").toString(), root + "/allowMsgIds");
+    denyMsgIds = idsFromText<uint32_t>(settings.value("denyMsgIds").toString(), root + "/denyMsgIds");
+    maxRateHz = qMax(0.0, settings.value("maxRateHz", 0.0).toDouble());
+
+    const int policy = settings.value("signing", static_cast<int>(SigningPolicy::Strip)).toInt();
+    if ((policy < static_cast<int>(SigningPolicy::Strip)) || (policy > static_cast<int>(SigningPolicy::SignedOnly))) {
+        qCWarning(MAVLinkRouteFilterLog) << "Invalid signing policy" << policy << "in" << root;
+        signing = SigningPolicy::Strip;
+    } else {
+        signing = static_cast<SigningPolicy>(policy);
+    }
+
+    settings.endGroup();
+}
+
+void MAVLinkRouteFilter::saveSettings(QSettings &settings, const QString &root) const
+{
+    settings.beginGroup(root);
+
+    settings.setValue("allowSysIds", idsToText(allowSysIds));
+    settings.setValue("denySysIds", idsToText(denySysIds));
+    settings.setValue("allowCompIds", idsToText(allowCompIds));
+    settings.setValue("denyCompIds", idsToText(denyCompIds));
+    settings.setValue("allowMsgIds", idsToText(allowMsgIds));
+    settings.setValue("denyMsgIds", idsToText(denyMsgIds));
+    settings.setValue("maxRateHz", maxRateHz);
+    settings.setValue("signing", static_cast<int>(signing));
+
+    settings.endGroup();
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QSettings>
+#include <QtCore/QString>
+#include <cstdint>
+
+/// \brief What a forwarding endpoint receives from the MAVLink router.
+///
+/// An empty allow list accepts everything; deny lists win over allow lists. SETUP_SIGNING is never forwarded
+/// regardless of the filter.
+struct MAVLinkRouteFilter
+{
+    enum class SigningPolicy : uint8_t
+    {
+        Strip,       ///< Forward an unsigned copy; a downstream without our key would reject the signature
+        Preserve,    ///< Forward frames as received, signature included
+        SignedOnly,  ///< Forward only frames that arrived signed (and so verified), signature included
+    };
+
+    QList<uint8_t> allowSysIds;
+    QList<uint8_t> denySysIds;
+    QList<uint8_t> allowCompIds;
+    QList<uint8_t> denyCompIds;
+    QList<uint32_t> allowMsgIds;
+    QList<uint32_t> denyMsgIds;
+    double maxRateHz = 0.0;  ///< Per (sysid, compid, msgid) stream, 0 for unlimited
+    SigningPolicy signing = SigningPolicy::Strip;
+
+    bool acceptsSysId(uint8_t sysId) const { return _accepts(allowSysIds, denySysIds, sysId); }
+    bool acceptsCompId(uint8_t compId) const { return _accepts(allowCompIds, denyCompIds, compId); }
+    bool acceptsMsgId(uint32_t msgId) const { return _accepts(allowMsgIds, denyMsgIds, msgId); }
+
+    void loadSettings(QSettings &settings, const QString &root);
+    void saveSettings(QSettings &settings, const QString &root) const;
+
+    /// Comma-separated id lists, as persisted and as edited in the link settings dialog.
+    /// Invalid or out of range entries are dropped with a warning naming \a key.
+    template <typename T>
+    static QList<T> idsFromText(const QString &text, const QString &key);
+    template <typename T>
+    static QString idsToText(const QList<T> &ids);
+
+    bool operator==(const MAVLinkRouteFilter &other) const = default;
+
+private:
+    template <typename T>
+    static bool _accepts(const QList<T> &allow, const QList<T> &deny, T value)
+    {
+        return (allow.isEmpty() || allow.contains(value)) && !deny.contains(value);
+    }
+};
@@ -0,0 +1,169 @@
+#include "MAVLinkRouter.h"
+#include "MAVLinkLib.h"
+#include "MAVLinkSigning.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QSet>
+
+#include <bit>
+#include <cmath>
+
+QGC_LOGGING_CATEGORY(MAVLinkRouterLog, "Comms.MAVLinkRouter")
+
+MAVLinkRouter::MAVLinkRouter(const QList<Endpoint>& endpoints, const QSet<const LinkInterface*>& forwardingLinks)
+    : _endpoints(endpoints)
+    , _forwardingLinks(forwardingLinks)
+{
+    if (_endpoints.size() > kMaxEndpoints) {
+        qCWarning(MAVLinkRouterLog) << "Routing to the first" << kMaxEndpoints << "of" << _endpoints.size()
+                                    << "forwarding endpoints";
+        _endpoints.resize(kMaxEndpoints);
+    }
+
+    QSet<uint32_t> sparseMsgIds;
+    for (const Endpoint& endpoint : std::as_const(_endpoints)) {
+        for (const uint32_t msgId : endpoint.filter.allowMsgIds) {
+            if (msgId >= kDenseMsgIds) {
+                sparseMsgIds.insert(msgId);
+            }
+        }
+        for (const uint32_t msgId : endpoint.filter.denyMsgIds) {
+            if (msgId >= kDenseMsgIds) {
+                sparseMsgIds.insert(msgId);
+            }
+        }
+    }
+    for (const uint32_t msgId : std::as_const(sparseMsgIds)) {
+        _sparseMsgIdMasks.insert(msgId, 0);
+    }
+
+    for (int index = 0; index < _endpoints.size(); ++index) {
+        const MAVLinkRouteFilter& filter = _endpoints.at(index).filter;
+        const quint64 bit = 1ULL << index;
+
+        for (int id = 0; id < 256; ++id) {
+            if (filter.acceptsSysId(static_cast<uint8_t>(id))) {
+                _sysIdMasks[id] |= bit;
+            }
+            if (filter.acceptsCompId(static_cast<uint8_t>(id))) {
+                _compIdMasks[id] |= bit;
+            }
+        }
+
+        for (uint32_t msgId = 0; msgId < kDenseMsgIds; ++msgId) {
+            if (filter.acceptsMsgId(msgId)) {
+                _denseMsgIdMasks[msgId] |= bit;
+            }
+        }
+        for (auto it = _sparseMsgIdMasks.begin(); it != _sparseMsgIdMasks.end(); ++it) {
+            if (filter.acceptsMsgId(it.key())) {
+                it.value() |= bit;
+            }
+        }
+        if (filter.allowMsgIds.isEmpty()) {
+            _defaultMsgIdMask |= bit;
+        }
+
+        switch (filter.signing) {
+        case MAVLinkRouteFilter::SigningPolicy::Strip:
+            _stripMask |= bit;
+            break;
+        case MAVLinkRouteFilter::SigningPolicy::SignedOnly:
+            _signedOnlyMask |= bit;
+            break;
+        case MAVLinkRouteFilter::SigningPolicy::Preserve:
+            break;
+        }
+
+        if (filter.maxRateHz > 0.0) {
+            _minIntervalNs[index] = static_cast<qint64>(std::llround(1e9 / filter.maxRateHz));
+        }
+    }
+
+    // Key material never leaves this GCS, whatever the filters say.
+    _denseMsgIdMasks[MAVLINK_MSG_ID_SETUP_SIGNING] = 0;
+}
+
+quint64 MAVLinkRouter::route(const mavlink_message_t& message) const
+{
+    quint64 mask = _sysIdMasks[message.sysid] & _compIdMasks[message.compid] & _msgIdMask(message.msgid);
+    if (_signedOnlyMask && !MAVLinkSigning::isMessageSigned(message)) {
+        mask &= ~_signedOnlyMask;
+    }
+    return mask;
+}
+
+void MAVLinkRouteBatch::setRouter(std::shared_ptr<const MAVLinkRouter> router)
+{
+    _router = std::move(router);
+    _outputs.clear();
+    if (_router) {
+        _outputs.resize(_router->endpointCount());
+    }
+}
+
+void MAVLinkRouteBatch::route(const mavlink_message_t& message, qint64 nowNs)
+{
+    quint64 mask = _router->route(message);
+    if (mask == 0) {
+        return;
+    }
+
+    // Each form is serialized at most once per message, however many endpoints take it.
+    uint8_t stripped[MAVLINK_MAX_PACKET_LEN];
+    uint16_t strippedLength = 0;
+    uint8_t asReceived[MAVLINK_MAX_PACKET_LEN];
+    uint16_t asReceivedLength = 0;
+
+    const quint64 streamKey =
+        (static_cast<quint64>(message.msgid) << 16) | (static_cast<quint64>(message.sysid) << 8) | message.compid;
+
+    while (mask != 0) {
+        const int index = std::countr_zero(mask);
+        mask &= mask - 1;
+
+        Output& output = _outputs[index];
+        const qint64 minIntervalNs = _router->minIntervalNs(index);
+        if (minIntervalNs > 0) {
+            const auto it = output.lastSentNs.constFind(streamKey);
+            if ((it != output.lastSentNs.cend()) && ((nowNs - it.value()) < minIntervalNs)) {
+                continue;
+            }
+            output.lastSentNs.insert(streamKey, nowNs);
+        }
+
+        if (_router->stripsSignature(index)) {
+            if (strippedLength == 0) {
+                strippedLength = MAVLinkSigning::serializeUnsignedCopy(message, stripped);
+            }
+            _append(output.pending, stripped, strippedLength);
+        } else {
+            if (asReceivedLength == 0) {
+                asReceivedLength = mavlink_msg_to_send_buffer(asReceived, &message);
+            }
+            _append(output.pending, asReceived, asReceivedLength);
+        }
+    }
+}
+
+void MAVLinkRouteBatch::flush()
+{
+    for (size_t index = 0; index < _outputs.size(); ++index) {
+        QByteArray& pending = _outputs[index].pending;
+        if (pending.isEmpty()) {
+            continue;
+        }
+        if (const SharedLinkInterfacePtr link = _router->endpoint(static_cast<int>(index)).link.lock()) {
+            link->writeBytesThreadSafe(pending.constData(), static_cast<int>(pending.size()));
+        }
+        pending.resize(0);
+    }
+}
+
+void MAVLinkRouteBatch::_append(QByteArray& pending, const uint8_t* frame, uint16_t length)
+{
+    if (pending.capacity() < kPendingBufferBytes) {
+        pending.reserve(kPendingBufferBytes);
+    }
+    (void) pending.append(reinterpret_cast<const char*>(frame), length);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QSet>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "LinkInterface.h"
+#include "MAVLinkMessageType.h"
+#include "MAVLinkRouteFilter.h"
+
+/// \brief Immutable routing table for forwarded MAVLink traffic.
+///
+/// Every endpoint's filter is flattened into one bit per endpoint in per-sysid, per-compid and per-msgid masks, so
+/// routing a message is three lookups and an AND; the cost of fan-out is proportional to the endpoints that take it.
+class MAVLinkRouter
+{
+public:
+    static constexpr int kMaxEndpoints = 64;
+
+    struct Endpoint
+    {
+        WeakLinkInterfacePtr link;
+        MAVLinkRouteFilter filter;
+    };
+
+    /// Endpoints past kMaxEndpoints are dropped with a warning. Traffic arriving on @p forwardingLinks is not
+    /// forwarded again, whether or not they are routed to.
+    explicit MAVLinkRouter(const QList<Endpoint>& endpoints, const QSet<const LinkInterface*>& forwardingLinks = {});
+
+    int endpointCount() const { return static_cast<int>(_endpoints.size()); }
+    bool isEmpty() const { return _endpoints.isEmpty(); }
+    const Endpoint& endpoint(int index) const { return _endpoints.at(index); }
+    bool isForwardingLink(const LinkInterface* link) const { return _forwardingLinks.contains(link); }
+
+    /// Bit i is set if endpoint i takes @p message, before rate limiting.
+    quint64 route(const mavlink_message_t& message) const;
+
+    bool stripsSignature(int index) const { return (_stripMask & (1ULL << index)) != 0; }
+    /// Minimum spacing between forwarded messages of one (sysid, compid, msgid) stream, 0 if unlimited.
+    qint64 minIntervalNs(int index) const { return _minIntervalNs[index]; }
+
+private:
+    quint64 _msgIdMask(uint32_t msgId) const
+    {
+        return (msgId < kDenseMsgIds) ? _denseMsgIdMasks[msgId] : _sparseMsgIdMasks.value(msgId, _defaultMsgIdMask);
+    }
+
+    /// Message ids below this (the common dialect range) get a flat table; listed ids above it go in a hash.
+    static constexpr uint32_t kDenseMsgIds = 1024;
+
+    QList<Endpoint> _endpoints;
+    QSet<const LinkInterface*> _forwardingLinks;
+    std::array<quint64, 256> _sysIdMasks{};
+    std::array<quint64, 256> _compIdMasks{};
+    std::array<quint64, kDenseMsgIds> _denseMsgIdMasks{};
+    QHash<uint32_t, quint64> _sparseMsgIdMasks;
+    quint64 _defaultMsgIdMask = 0;  ///< Endpoints taking msgids above the dense range that no filter lists
+    quint64 _signedOnlyMask = 0;
+    quint64 _stripMask = 0;
+    std::array<qint64, kMaxEndpoints> _minIntervalNs{};
+};
+
+/// \brief Applies a MAVLinkRouter to one channel's traffic and batches the output per endpoint.
+///
+/// Owned by the thread decoding the channel: rate-limit state is per incoming link, and every endpoint gets a
+/// single write per receive buffer.
+class MAVLinkRouteBatch
+{
+public:
+    /// Discards pending output and rate-limit state.
+    void setRouter(std::shared_ptr<const MAVLinkRouter> router);
+    bool isActive() const { return _router && !_router->isEmpty(); }
+    const MAVLinkRouter* router() const { return _router.get(); }
+
+    /// Queues @p message for every endpoint that takes it. @p nowNs is a monotonic timestamp.
+    void route(const mavlink_message_t& message, qint64 nowNs);
+    /// Frames queued for endpoint @p index since the last flush.
+    QByteArrayView pending(int index) const { return _outputs[index].pending; }
+    /// Writes each endpoint's queued frames in one call and clears them.
+    void flush();
+
+private:
+    static void _append(QByteArray& pending, const uint8_t* frame, uint16_t length);
+
+    struct Output
+    {
+        QByteArray pending;
+        QHash<quint64, qint64> lastSentNs;  ///< By (msgid, sysid, compid), only for rate-limited endpoints
+    };
+
+    std::shared_ptr<const MAVLinkRouter> _router;
+    std::vector<Output> _outputs;
+
+    /// Initial size of an endpoint's buffer; a receive buffer's worth of frames rarely exceeds it.
+    static constexpr qsizetype kPendingBufferBytes = 16 * 1024;
+};
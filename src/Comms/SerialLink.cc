@@ -414,7 +414,8 @@ SerialLink::SerialLink(SharedLinkConfigurationPtr &config, QObject *parent)
 
     (void) connect(_worker, &SerialWorker::connected, this, &SerialLink::_onConnected, Qt::QueuedConnection);
     (void) connect(_worker, &SerialWorker::disconnected, this, &SerialLink::_onDisconnected, Qt::QueuedConnection);
-    (void) connect(_worker, &SerialWorker::dataReceived, this, &SerialLink::_onDataReceived, Qt::QueuedConnection);
+    // Direct: MAVLink decoding runs on the worker thread, only decoded messages reach the GUI thread.
+    (void) connect(_worker, &SerialWorker::dataReceived, this, &SerialLink::_onDataReceived, Qt::DirectConnection);
     (void) connect(_worker, &SerialWorker::dataSent, this, &SerialLink::_onDataSent, Qt::QueuedConnection);
     (void) connect(_worker, &SerialWorker::errorOccurred, this, &SerialLink::_onErrorOccurred, Qt::QueuedConnection);
 
@@ -474,7 +475,7 @@ void SerialLink::_onErrorOccurred(const QString &errorString)
 
 void SerialLink::_onDataReceived(const QByteArray &data)
 {
-    emit bytesReceived(this, data);
+    _receiveBytesOnLinkThread(data);
 }
 
 void SerialLink::_onDataSent(const QByteArray &data)
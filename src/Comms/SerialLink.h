@@ -157,6 +157,7 @@ public slots:
 private slots:
     void _onConnected();
     void _onDisconnected();
+    /// Invoked directly on the worker thread.
     void _onDataReceived(const QByteArray &data);
     void _onDataSent(const QByteArray &data);
     void _onErrorOccurred(const QString &errorString);
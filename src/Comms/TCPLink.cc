@@ -263,7 +263,8 @@ TCPLink::TCPLink(SharedLinkConfigurationPtr &config, QObject *parent)
     (void) connect(_worker, &TCPWorker::connected, this, &TCPLink::_onConnected, Qt::QueuedConnection);
     (void) connect(_worker, &TCPWorker::disconnected, this, &TCPLink::_onDisconnected, Qt::QueuedConnection);
     (void) connect(_worker, &TCPWorker::errorOccurred, this, &TCPLink::_onErrorOccurred, Qt::QueuedConnection);
-    (void) connect(_worker, &TCPWorker::dataReceived, this, &TCPLink::_onDataReceived, Qt::QueuedConnection);
+    // Direct: MAVLink decoding runs on the worker thread, only decoded messages reach the GUI thread.
+    (void) connect(_worker, &TCPWorker::dataReceived, this, &TCPLink::_onDataReceived, Qt::DirectConnection);
     (void) connect(_worker, &TCPWorker::dataSent, this, &TCPLink::_onDataSent, Qt::QueuedConnection);
 
     _workerThread->start();
@@ -322,7 +323,7 @@ void TCPLink::_onErrorOccurred(const QString &errorString)
 
 void TCPLink::_onDataReceived(const QByteArray &data)
 {
-    emit bytesReceived(this, data);
+    _receiveBytesOnLinkThread(data);
 }
 
 void TCPLink::_onDataSent(const QByteArray &data)
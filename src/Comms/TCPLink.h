@@ -104,6 +104,7 @@ private slots:
     void _onConnected();
     void _onDisconnected();
     void _onErrorOccurred(const QString &errorString);
+    /// Invoked directly on the worker thread.
     void _onDataReceived(const QByteArray &data);
     void _onDataSent(const QByteArray &data);
 
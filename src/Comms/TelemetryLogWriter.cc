@@ -0,0 +1,335 @@
+#include "TelemetryLogWriter.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+#include <QtCore/QtEndian>
+#include <algorithm>
+#include <cstring>
+
+#include "MAVLinkLib.h"
+#include "MAVLinkSigning.h"
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(TelemetryLogWriterLog, "Comms.TelemetryLogWriter")
+
+TelemetryLogWriter::TelemetryLogWriter(QObject* parent)
+    : QObject(parent)
+{
+    qCDebug(TelemetryLogWriterLog) << this;
+}
+
+TelemetryLogWriter::~TelemetryLogWriter()
+{
+    (void) close();
+
+    qCDebug(TelemetryLogWriterLog) << this;
+}
+
+quint64 TelemetryLogWriter::currentTimestampUsec()
+{
+    return static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() * 1000);
+}
+
+bool TelemetryLogWriter::open(const QString& fileName)
+{
+    (void) close();
+
+    _file.setFileName(fileName);
+    // The arena already batches writes; QFile's own buffer would only add a copy.
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+        qCWarning(TelemetryLogWriterLog) << "Open failed" << fileName << _file.errorString();
+        return false;
+    }
+
+    // Nothing consumes while the thread is down, so this thread can act as consumer and drop leftovers.
+    _discardQueued();
+    _arena.clear();
+    _arena.reserve(kChunkBytes * 2);
+    _failed = false;
+    _droppedRecords = 0;
+    _writtenRecords = 0;
+    _bytesWritten = 0;
+    _stopRequested = false;
+    _wakePending = false;
+
+    _thread = QThread::create([this]() { _run(); });
+    _thread->setObjectName(QStringLiteral("TelemetryLogWriter"));
+    _thread->start(QThread::LowPriority);
+
+    _accepting.store(true, std::memory_order_release);
+    return true;
+}
+
+bool TelemetryLogWriter::close()
+{
+    _accepting.store(false, std::memory_order_release);
+
+    if (_thread) {
+        _stopRequested.store(true, std::memory_order_release);
+        _wake.release();
+        (void) _thread->wait();
+        delete _thread;
+        _thread = nullptr;
+
+        const Stats totals = stats();
+        qCDebug(TelemetryLogWriterLog) << "Closed" << _file.fileName() << "records:" << totals.writtenRecords
+                                       << "bytes:" << totals.bytesWritten << "dropped:" << totals.droppedRecords;
+    }
+
+    if (!_file.isOpen()) {
+        return false;
+    }
+
+    _file.close();
+    return true;
+}
+
+TelemetryLogWriter::Ring* TelemetryLogWriter::_ring(int producer)
+{
+    Q_ASSERT((producer >= 0) && (producer < kProducerCount));
+
+    Ring* ring = _rings[producer].load(std::memory_order_acquire);
+    if (!ring) {
+        // Only the producer itself creates its ring, so there is no race on creation.
+        _ringStorage[producer] = std::make_unique<Ring>(kRingCapacity);
+        ring = _ringStorage[producer].get();
+        _rings[producer].store(ring, std::memory_order_release);
+    }
+    return ring;
+}
+
+bool TelemetryLogWriter::logMessage(int producer, quint64 timestampUsec, const mavlink_message_t& message)
+{
+    if (!_accepting.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    Ring* const ring = _ring(producer);
+    Record* const record = ring->producerSlot();
+    if (!record) {
+        _droppedRecords.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    record->timestampUsec = timestampUsec;
+    record->rawLength = 0;
+    record->message = message;
+    ring->publish();
+    _recordPublished(ring);
+    return true;
+}
+
+bool TelemetryLogWriter::logBytes(int producer, quint64 timestampUsec, QByteArrayView bytes)
+{
+    if (!_accepting.load(std::memory_order_acquire) || bytes.isEmpty()) {
+        return false;
+    }
+
+    // A write may carry several frames (forwarded traffic is batched per endpoint); log one record per frame.
+    // The file is a byte stream to its readers, so this is the same log the write would have made whole.
+    Ring* const ring = _ring(producer);
+    bool logged = true;
+    qsizetype pos = 0;
+    while (pos < bytes.size()) {
+        const qsizetype length = std::min(_frameLength(bytes.sliced(pos)), bytes.size() - pos);
+        Record* const record = ring->producerSlot();
+        if (!record) {
+            _droppedRecords.fetch_add(1, std::memory_order_relaxed);
+            logged = false;
+        } else {
+            record->timestampUsec = timestampUsec;
+            record->rawLength = static_cast<uint16_t>(length);
+            (void) memcpy(record->raw, bytes.data() + pos, static_cast<size_t>(length));
+            ring->publish();
+        }
+        pos += length;
+    }
+    _recordPublished(ring);
+    return logged;
+}
+
+qsizetype TelemetryLogWriter::_frameLength(QByteArrayView bytes)
+{
+    const uint8_t* const data = reinterpret_cast<const uint8_t*>(bytes.data());
+    if ((bytes.size() >= 2) && (data[0] == MAVLINK_STX_MAVLINK1)) {
+        return MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1 + data[1] + MAVLINK_NUM_CHECKSUM_BYTES;
+    }
+    if ((bytes.size() >= 3) && (data[0] == MAVLINK_STX)) {
+        const qsizetype signature = (data[2] & MAVLINK_IFLAG_SIGNED) ? MAVLINK_SIGNATURE_BLOCK_LEN : 0;
+        return MAVLINK_NUM_HEADER_BYTES + data[1] + MAVLINK_NUM_CHECKSUM_BYTES + signature;
+    }
+    // Not at a frame start: keep the bytes anyway, in record-sized pieces
+    return MAVLINK_MAX_PACKET_LEN;
+}
+
+void TelemetryLogWriter::_recordPublished(const Ring* ring)
+{
+    // The writer polls every kFlushIntervalMs; only wake it early when a ring is filling up.
+    if ((ring->size() >= (ring->capacity() / 2)) && !_wakePending.exchange(true, std::memory_order_acq_rel)) {
+        _wake.release();
+    }
+}
+
+TelemetryLogWriter::Stats TelemetryLogWriter::stats() const
+{
+    Stats result;
+    for (const std::atomic<Ring*>& slot : _rings) {
+        if (const Ring* const ring = slot.load(std::memory_order_acquire)) {
+            result.queueDepth += ring->size();
+        }
+    }
+    result.droppedRecords = _droppedRecords.load(std::memory_order_relaxed);
+    result.writtenRecords = _writtenRecords.load(std::memory_order_relaxed);
+    result.bytesWritten = _bytesWritten.load(std::memory_order_relaxed);
+    return result;
+}
+
+void TelemetryLogWriter::_run()
+{
+    QElapsedTimer sinceFlush;
+    sinceFlush.start();
+    QElapsedTimer sinceStats;
+    sinceStats.start();
+    uint64_t reportedDrops = 0;
+
+    while (true) {
+        const bool stopping = _stopRequested.load(std::memory_order_acquire);
+
+        _wakePending.store(false, std::memory_order_release);
+        if (!_drain()) {
+            break;
+        }
+
+        if (stopping) {
+            (void) _writeArena(false);
+            break;
+        }
+
+        if (sinceFlush.elapsed() >= kFlushIntervalMs) {
+            if (!_writeArena(false)) {
+                break;
+            }
+            sinceFlush.restart();
+
+            const uint64_t drops = _droppedRecords.load(std::memory_order_relaxed);
+            if (drops != reportedDrops) {
+                qCWarning(TelemetryLogWriterLog) << "Dropped" << (drops - reportedDrops) << "records, queue depth"
+                                                 << stats().queueDepth;
+                reportedDrops = drops;
+            }
+
+            if (sinceStats.elapsed() >= kStatsIntervalMs) {
+                sinceStats.restart();
+                if (TelemetryLogWriterLog().isDebugEnabled()) {
+                    const Stats current = stats();
+                    qCDebug(TelemetryLogWriterLog) << "Queue depth:" << current.queueDepth
+                                                   << "records:" << current.writtenRecords
+                                                   << "bytes:" << current.bytesWritten
+                                                   << "dropped:" << current.droppedRecords;
+                }
+            }
+        }
+
+        (void) _wake.tryAcquire(1, kFlushIntervalMs);
+    }
+}
+
+bool TelemetryLogWriter::_drain()
+{
+    if (_failed) {
+        _discardQueued();
+        return false;
+    }
+
+    std::array<Ring*, kProducerCount> rings{};
+    int ringCount = 0;
+    for (std::atomic<Ring*>& slot : _rings) {
+        if (Ring* const ring = slot.load(std::memory_order_acquire)) {
+            rings[ringCount++] = ring;
+        }
+    }
+
+    // K-way merge on the ring heads keeps the file in timestamp order across links.
+    while (true) {
+        Ring* oldest = nullptr;
+        Record* oldestRecord = nullptr;
+        for (int i = 0; i < ringCount; i++) {
+            Record* const record = rings[i]->consumerSlot();
+            if (record && (!oldestRecord || (record->timestampUsec < oldestRecord->timestampUsec))) {
+                oldest = rings[i];
+                oldestRecord = record;
+            }
+        }
+        if (!oldestRecord) {
+            return true;
+        }
+
+        _appendRecord(*oldestRecord);
+        oldest->release();
+
+        if ((_arena.size() >= kChunkBytes) && !_writeArena(true)) {
+            return false;
+        }
+    }
+}
+
+void TelemetryLogWriter::_appendRecord(const Record& record)
+{
+    // MAVLink spec §Logging: omit SETUP_SIGNING (contains secret key)
+    if ((record.rawLength == 0) && (record.message.msgid == MAVLINK_MSG_ID_SETUP_SIGNING)) {
+        return;
+    }
+
+    const qsizetype start = _arena.size();
+    _arena.resize(start + static_cast<qsizetype>(sizeof(quint64)) + MAVLINK_MAX_PACKET_LEN);
+    uint8_t* const out = reinterpret_cast<uint8_t*>(_arena.data() + start);
+    qToBigEndian(record.timestampUsec, out);
+
+    uint16_t length;
+    if (record.rawLength == 0) {
+        // MAVLink spec §Logging: strip signature block from logged packets.
+        length = MAVLinkSigning::serializeUnsignedCopy(record.message, out + sizeof(quint64));
+    } else {
+        length = record.rawLength;
+        (void) memcpy(out + sizeof(quint64), record.raw, length);
+    }
+    _arena.resize(start + static_cast<qsizetype>(sizeof(quint64)) + length);
+    _writtenRecords.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool TelemetryLogWriter::_writeArena(bool wholeChunksOnly)
+{
+    const qsizetype bytes = wholeChunksOnly ? ((_arena.size() / kChunkBytes) * kChunkBytes) : _arena.size();
+    if (bytes == 0) {
+        return true;
+    }
+
+    if (_file.write(_arena.constData(), bytes) != bytes) {
+        qCWarning(TelemetryLogWriterLog) << "Write failed" << _file.fileName() << _file.errorString();
+        _failed = true;
+        _accepting.store(false, std::memory_order_release);
+        _arena.clear();
+        _discardQueued();
+        emit writeFailed(_file.fileName());
+        return false;
+    }
+
+    _bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+    // Keep the partial chunk; QByteArray::remove() shifts in place without reallocating.
+    (void) _arena.remove(0, bytes);
+    return true;
+}
+
+void TelemetryLogWriter::_discardQueued()
+{
+    for (std::atomic<Ring*>& slot : _rings) {
+        if (Ring* const ring = slot.load(std::memory_order_acquire)) {
+            const size_t queued = ring->size();
+            ring->discard();
+            if (_failed) {
+                _droppedRecords.fetch_add(queued, std::memory_order_relaxed);
+            }
+        }
+    }
+}
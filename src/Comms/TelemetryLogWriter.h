@@ -0,0 +1,119 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QFile>
+#include <QtCore/QObject>
+#include <QtCore/QSemaphore>
+#include <QtCore/QString>
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include "MAVLinkMessageType.h"
+#include "SpscRing.h"
+
+class QThread;
+
+/// \brief Background writer for .tlog telemetry files.
+///
+/// Each producer (one per MAVLink channel decode thread, plus the GUI thread) owns a lock-free SPSC ring of
+/// fixed-size records, so logging a message never takes a lock or allocates. A dedicated thread merges the rings in
+/// timestamp order, serializes records (8-byte big-endian usec timestamp + unsigned MAVLink frame) into a reusable
+/// arena and writes it out in kChunkBytes pieces, or whatever is buffered every kFlushIntervalMs.
+///
+/// A record that does not fit in its ring is dropped and counted rather than stalling the producer. On a write
+/// failure the writer stops writing, discards further records and emits writeFailed(). stats() are logged every
+/// kStatsIntervalMs at debug level while the file is open.
+class TelemetryLogWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Producer index for the GUI thread. Channel decode threads use their MAVLink channel number.
+    static constexpr int kGuiThreadProducer = MAVLINK_COMM_NUM_BUFFERS;
+    static constexpr int kProducerCount = MAVLINK_COMM_NUM_BUFFERS + 1;
+
+    static constexpr size_t kRingCapacity = 1024;
+    static constexpr qsizetype kChunkBytes = 64 * 1024;
+    static constexpr int kFlushIntervalMs = 250;
+    static constexpr int kStatsIntervalMs = 10000;
+
+    struct Stats
+    {
+        uint64_t queueDepth = 0;        ///< Records waiting in the rings
+        uint64_t droppedRecords = 0;    ///< Records lost to a full ring or a write failure
+        uint64_t writtenRecords = 0;
+        qint64 bytesWritten = 0;
+    };
+
+    explicit TelemetryLogWriter(QObject* parent = nullptr);
+    ~TelemetryLogWriter() override;
+
+    /// GUI thread. Opens (truncates) @p fileName and starts the writer thread.
+    bool open(const QString& fileName);
+
+    /// GUI thread. Writes everything queued so far, then closes the file and stops the writer thread.
+    /// Returns false if no file was open. A file whose writes failed is still closed and reported as open.
+    bool close();
+
+    bool isOpen() const { return _accepting.load(std::memory_order_acquire); }
+    QString fileName() const { return _file.fileName(); }
+    QString errorString() const { return _file.errorString(); }
+
+    /// Producer side: lock-free and allocation-free. Returns false if the record was dropped or logging is closed.
+    bool logMessage(int producer, quint64 timestampUsec, const mavlink_message_t& message);
+    bool logBytes(int producer, quint64 timestampUsec, QByteArrayView bytes);
+
+    Stats stats() const;
+
+    static quint64 currentTimestampUsec();
+
+signals:
+    /// Emitted from the writer thread.
+    void writeFailed(const QString& fileName);
+
+private:
+    struct Record
+    {
+        quint64 timestampUsec = 0;
+        uint16_t rawLength = 0;     ///< 0: message holds a decoded message, otherwise raw holds the bytes
+        union {
+            mavlink_message_t message;
+            uint8_t raw[MAVLINK_MAX_PACKET_LEN];
+        };
+
+        Record() : message{} {}
+    };
+    using Ring = QGC::SpscRing<Record>;
+
+    Ring* _ring(int producer);
+    void _recordPublished(const Ring* ring);
+    /// Bytes of the MAVLink frame starting @p bytes, or MAVLINK_MAX_PACKET_LEN if it does not start a frame
+    static qsizetype _frameLength(QByteArrayView bytes);
+
+    void _run();
+    /// Merges all rings into the arena in timestamp order. Returns false once a write has failed.
+    bool _drain();
+    void _appendRecord(const Record& record);
+    bool _writeArena(bool wholeChunksOnly);
+    void _discardQueued();
+
+    QFile _file;
+    QThread* _thread = nullptr;
+    QSemaphore _wake;
+
+    std::array<std::atomic<Ring*>, kProducerCount> _rings{};
+    std::array<std::unique_ptr<Ring>, kProducerCount> _ringStorage;
+
+    /// Writer thread only
+    QByteArray _arena;
+    bool _failed = false;
+
+    std::atomic<bool> _accepting = false;
+    std::atomic<bool> _stopRequested = false;
+    std::atomic<bool> _wakePending = false;
+    std::atomic<uint64_t> _droppedRecords = 0;
+    std::atomic<uint64_t> _writtenRecords = 0;
+    std::atomic<qint64> _bytesWritten = 0;
+};
@@ -0,0 +1,294 @@
+#include "TlogIndex.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtEndian>
+#include <algorithm>
+#include <cstring>
+
+#include "MAVLinkLib.h"
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(TlogIndexLog, "Comms.TlogIndex")
+
+namespace {
+
+constexpr qint64 kV1HeaderBytes = MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1;
+constexpr qint64 kV2HeaderBytes = MAVLINK_NUM_HEADER_BYTES;
+
+/// Only the tail of the file is framed to find the last timestamp; a longer run of garbage falls back to a full walk.
+constexpr qint64 kTailWindowBytes = 64 * 1024;
+
+constexpr char kCacheMagic[8] = {'Q', 'G', 'C', 'T', 'L', 'I', 'D', 'X'};
+constexpr quint32 kCacheVersion = 1;
+
+struct CacheHeader
+{
+    char magic[8];
+    quint32 version;
+    quint32 recordsPerEntry;
+    qint64 logSize;
+    qint64 logModifiedMSecs;
+    quint64 firstTimestampUSecs;
+    quint64 lastTimestampUSecs;
+    quint64 recordCount;
+    quint64 entryCount;
+};
+
+constexpr bool isStx(uchar byte)
+{
+    return (byte == MAVLINK_STX) || (byte == MAVLINK_STX_MAVLINK1);
+}
+
+}  // namespace
+
+void TlogIndex::setData(const uchar* data, qint64 size)
+{
+    _data = data;
+    _size = size;
+    _swapTimestamps = false;
+
+    _built = false;
+    _entries.clear();
+    _firstTimestampUSecs = 0;
+    _lastTimestampUSecs = 0;
+    _recordCount = 0;
+
+    // Some logs were written with little-endian timestamps; a big-endian read of those lands far in the future.
+    Record first;
+    if (readRecord(0, first)) {
+        const quint64 nowUSecs = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000;
+        _swapTimestamps = (first.timestampUSecs > nowUSecs);
+        _firstTimestampUSecs = _timestampAt(first.offset);
+    }
+}
+
+quint64 TlogIndex::_timestampAt(qint64 offset) const
+{
+    const quint64 timestamp = qFromBigEndian<quint64>(_data + offset);
+    return _swapTimestamps ? qbswap(timestamp) : timestamp;
+}
+
+qint64 TlogIndex::_frameLength(const uchar* frame, qint64 available)
+{
+    const bool isV1 = (frame[0] == MAVLINK_STX_MAVLINK1);
+    const qint64 headerBytes = isV1 ? kV1HeaderBytes : kV2HeaderBytes;
+    if (available < headerBytes) {
+        return 0;
+    }
+
+    const uint8_t payloadLen = frame[1];
+    const uint8_t incompatFlags = isV1 ? 0 : frame[2];
+    if ((incompatFlags & ~MAVLINK_IFLAG_MASK) != 0) {
+        return 0;
+    }
+
+    const qint64 frameBytes = headerBytes + payloadLen + MAVLINK_NUM_CHECKSUM_BYTES +
+                              ((incompatFlags & MAVLINK_IFLAG_SIGNED) ? MAVLINK_SIGNATURE_BLOCK_LEN : 0);
+    if (available < frameBytes) {
+        return 0;
+    }
+
+    const uint32_t msgid = isV1 ? frame[5]
+                                : (static_cast<uint32_t>(frame[7]) | (static_cast<uint32_t>(frame[8]) << 8) |
+                                   (static_cast<uint32_t>(frame[9]) << 16));
+    const mavlink_msg_entry_t* const entry = mavlink_get_msg_entry(msgid);
+    uint16_t crc = crc_calculate(frame + 1, static_cast<uint16_t>(headerBytes - 1 + payloadLen));
+    crc_accumulate(entry ? entry->crc_extra : 0, &crc);
+
+    const uchar* const ck = frame + headerBytes + payloadLen;
+    if ((ck[0] != (crc & 0xFF)) || (ck[1] != (crc >> 8))) {
+        return 0;
+    }
+
+    return frameBytes;
+}
+
+bool TlogIndex::readRecord(qint64 offset, Record& record) const
+{
+    offset = std::max<qint64>(offset, 0);
+    if ((offset + kTimestampBytes) >= _size) {
+        return false;
+    }
+
+    const uchar* const end = _data + _size;
+    const uchar* frame = _data + offset + kTimestampBytes;
+
+    while (frame < end) {
+        // Well-formed logs hit on the first byte; find_if only does work while resyncing past garbage.
+        frame = std::find_if(frame, end, isStx);
+        if (frame == end) {
+            break;
+        }
+
+        const qint64 frameLength = _frameLength(frame, end - frame);
+        if (frameLength > 0) {
+            record.frameOffset = frame - _data;
+            record.frameLength = frameLength;
+            record.offset = record.frameOffset - kTimestampBytes;
+            record.timestampUSecs = _timestampAt(record.offset);
+            return true;
+        }
+        ++frame;
+    }
+
+    return false;
+}
+
+quint64 TlogIndex::findLastTimestamp() const
+{
+    if (_built) {
+        return _lastTimestampUSecs;
+    }
+
+    qint64 start = std::max<qint64>(_size - kTailWindowBytes, 0);
+    while (true) {
+        quint64 lastTimestamp = 0;
+        bool found = false;
+        Record record;
+        qint64 offset = start;
+        while (readRecord(offset, record)) {
+            lastTimestamp = record.timestampUSecs;
+            found = true;
+            offset = record.nextOffset();
+        }
+
+        if (found || (start == 0)) {
+            return lastTimestamp;
+        }
+        start = 0;
+    }
+}
+
+bool TlogIndex::build(const std::atomic<bool>* cancel)
+{
+    _built = false;
+    _entries.clear();
+    _entries.reserve(static_cast<size_t>(_size / (kRecordsPerEntry * 32)) + 1);
+    _recordCount = 0;
+
+    quint64 maxTimestampUSecs = 0;
+    Record record;
+    qint64 offset = 0;
+    while (readRecord(offset, record)) {
+        if (cancel && ((_recordCount % 4096) == 0) && cancel->load(std::memory_order_relaxed)) {
+            _entries.clear();
+            return false;
+        }
+
+        if (_recordCount == 0) {
+            _firstTimestampUSecs = record.timestampUSecs;
+        }
+        maxTimestampUSecs = std::max(maxTimestampUSecs, record.timestampUSecs);
+        if ((_recordCount % kRecordsPerEntry) == 0) {
+            _entries.push_back({maxTimestampUSecs, record.offset});
+        }
+        _lastTimestampUSecs = record.timestampUSecs;
+        ++_recordCount;
+        offset = record.nextOffset();
+    }
+
+    _built = true;
+    qCDebug(TlogIndexLog) << "Indexed" << _recordCount << "records," << _entries.size() << "entries";
+    return true;
+}
+
+bool TlogIndex::seek(quint64 timestampUSecs, Record& record) const
+{
+    if (!_built || _entries.empty()) {
+        return false;
+    }
+
+    // Every record before entry (it - 1) is older than the target, so the scan starts there.
+    auto it = std::lower_bound(_entries.cbegin(), _entries.cend(), timestampUSecs,
+                               [](const Entry& entry, quint64 value) { return entry.maxTimestampUSecs < value; });
+    if (it != _entries.cbegin()) {
+        --it;
+    }
+
+    qint64 offset = it->offset;
+    while (readRecord(offset, record)) {
+        if (record.timestampUSecs >= timestampUSecs) {
+            return true;
+        }
+        offset = record.nextOffset();
+    }
+
+    return false;
+}
+
+bool TlogIndex::loadCache(const QString& logFileName)
+{
+    const QFileInfo logInfo(logFileName);
+    QFile file(cacheFileName(logFileName));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    CacheHeader header{};
+    if ((file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)) ||
+        (memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0) || (header.version != kCacheVersion) ||
+        (header.recordsPerEntry != kRecordsPerEntry) || (header.logSize != _size) ||
+        (header.logSize != logInfo.size()) ||
+        (header.logModifiedMSecs != logInfo.lastModified().toMSecsSinceEpoch())) {
+        qCDebug(TlogIndexLog) << "Ignoring stale index" << file.fileName();
+        return false;
+    }
+
+    const qint64 entryBytes = static_cast<qint64>(header.entryCount * sizeof(Entry));
+    if ((file.size() - static_cast<qint64>(sizeof(header))) != entryBytes) {
+        qCWarning(TlogIndexLog) << "Truncated index" << file.fileName();
+        return false;
+    }
+
+    _entries.resize(header.entryCount);
+    if (file.read(reinterpret_cast<char*>(_entries.data()), entryBytes) != entryBytes) {
+        _entries.clear();
+        return false;
+    }
+
+    _firstTimestampUSecs = header.firstTimestampUSecs;
+    _lastTimestampUSecs = header.lastTimestampUSecs;
+    _recordCount = header.recordCount;
+    _built = true;
+    return true;
+}
+
+bool TlogIndex::saveCache(const QString& logFileName) const
+{
+    if (!_built) {
+        return false;
+    }
+
+    const QFileInfo logInfo(logFileName);
+
+    CacheHeader header{};
+    (void) memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kCacheVersion;
+    header.recordsPerEntry = kRecordsPerEntry;
+    header.logSize = logInfo.size();
+    header.logModifiedMSecs = logInfo.lastModified().toMSecsSinceEpoch();
+    header.firstTimestampUSecs = _firstTimestampUSecs;
+    header.lastTimestampUSecs = _lastTimestampUSecs;
+    header.recordCount = _recordCount;
+    header.entryCount = _entries.size();
+
+    // Logs often live in read-only locations; replay simply reindexes next time.
+    QSaveFile file(cacheFileName(logFileName));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCDebug(TlogIndexLog) << "Not caching index:" << file.errorString();
+        return false;
+    }
+
+    const qint64 entryBytes = static_cast<qint64>(_entries.size() * sizeof(Entry));
+    if ((file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header)) ||
+        (file.write(reinterpret_cast<const char*>(_entries.data()), entryBytes) != entryBytes)) {
+        qCDebug(TlogIndexLog) << "Not caching index:" << file.errorString();
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QtTypes>
+#include <atomic>
+#include <vector>
+
+/// \brief Seek index over a memory-mapped .tlog.
+///
+/// A .tlog is a sequence of records, each an 8-byte usec timestamp followed by one MAVLink frame. Records are
+/// framed straight from the mapped bytes using the MAVLink header length and CRC; bytes that do not form a valid
+/// record are skipped, the same way the per-byte parser would skip them.
+///
+/// build() walks the whole file once and keeps every kRecordsPerEntry-th record offset together with the running
+/// maximum timestamp, so seek() is a binary search followed by a short forward scan. The result can be cached next
+/// to the log with saveCache() and reused while the log's size and modification time are unchanged.
+class TlogIndex
+{
+public:
+    struct Record
+    {
+        quint64 timestampUSecs = 0;
+        qint64 offset = -1;         ///< Start of the timestamp
+        qint64 frameOffset = -1;    ///< Start of the MAVLink frame
+        qint64 frameLength = 0;
+
+        qint64 nextOffset() const { return frameOffset + frameLength; }
+    };
+
+    static constexpr qint64 kTimestampBytes = sizeof(quint64);
+    static constexpr quint32 kRecordsPerEntry = 64;
+
+    /// @p data must stay mapped for as long as this index reads from it. Resets any built index.
+    void setData(const uchar* data, qint64 size);
+
+    const uchar* data() const { return _data; }
+    qint64 size() const { return _size; }
+
+    /// Finds the first valid record at or after @p offset. Returns false at end of data.
+    bool readRecord(qint64 offset, Record& record) const;
+
+    /// Timestamp of the last record, found by framing only the tail of the file where possible.
+    quint64 findLastTimestamp() const;
+
+    /// Walks the whole file. Returns false if @p cancel was raised before it finished.
+    bool build(const std::atomic<bool>* cancel = nullptr);
+    bool isBuilt() const { return _built; }
+
+    /// Built index only. Finds the first record with a timestamp >= @p timestampUSecs.
+    bool seek(quint64 timestampUSecs, Record& record) const;
+
+    quint64 firstTimestamp() const { return _firstTimestampUSecs; }
+    quint64 lastTimestamp() const { return _lastTimestampUSecs; }
+    quint64 recordCount() const { return _recordCount; }
+
+    /// Loads a cache written for @p logFileName. Fails if the log has changed since the cache was written.
+    bool loadCache(const QString& logFileName);
+    bool saveCache(const QString& logFileName) const;
+
+    static QString cacheFileName(const QString& logFileName) { return logFileName + QStringLiteral(".qgcidx"); }
+
+private:
+    struct Entry
+    {
+        quint64 maxTimestampUSecs = 0;  ///< Highest timestamp up to and including this record
+        qint64 offset = 0;
+    };
+
+    quint64 _timestampAt(qint64 offset) const;
+    static qint64 _frameLength(const uchar* frame, qint64 available);
+
+    const uchar* _data = nullptr;
+    qint64 _size = 0;
+    bool _swapTimestamps = false;
+
+    bool _built = false;
+    std::vector<Entry> _entries;
+    quint64 _firstTimestampUSecs = 0;
+    quint64 _lastTimestampUSecs = 0;
+    quint64 _recordCount = 0;
+};
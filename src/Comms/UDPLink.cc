@@ -18,17 +18,6 @@ namespace {
     constexpr int BUFFER_TRIGGER_SIZE = 10 * 1024;
     constexpr int RECEIVE_TIME_LIMIT_MS = 50;
 
-    bool containsTarget(const QList<std::shared_ptr<UDPClient>> &list, const QHostAddress &address, quint16 port)
-    {
-        for (const std::shared_ptr<UDPClient> &target : list) {
-            if ((target->address == address) && (target->port == port)) {
-                return true;
-            }
-        }
-
-        return false;
-    }
-
     bool containsHost(const QList<std::shared_ptr<UDPClient>> &list, const QString &hostname, quint16 port)
     {
         for (const std::shared_ptr<UDPClient> &target : list) {
@@ -302,6 +291,11 @@ void UDPWorker::setupSocket()
         _socket = new QUdpSocket(this);
     }
 
+    if (!_batch && UdpDatagramBatch::isSupported()) {
+        _batch = std::make_unique<UdpDatagramBatch>();
+    }
+    _receiveBuffer.reserve(BUFFER_TRIGGER_SIZE + UdpDatagramBatch::kSlotBytes);
+
     const QList<QHostAddress> localAddresses = QNetworkInterface::allAddresses();
     _localAddresses = QSet(localAddresses.constBegin(), localAddresses.constEnd());
 
@@ -384,7 +378,12 @@ void UDPWorker::disconnectLink()
     (void) _socket->leaveMulticastGroup(_multicastGroup);
     _socket->close();
 
+    QMutexLocker locker(&_sessionTargetsMutex);
     _sessionTargets.clear();
+    _sessionTargetKeys.clear();
+    locker.unlock();
+
+    _knownSenders.clear();
 }
 
 void UDPWorker::writeData(const QByteArray &data)
@@ -394,6 +393,18 @@ void UDPWorker::writeData(const QByteArray &data)
         return;
     }
 
+    // IPv4 targets are collected and sent in batches; everything else goes out one datagram at a time
+    _sendEndpoints.clear();
+    const auto sendTo = [this, &data](const QHostAddress &address, quint16 port) {
+        bool isIPv4 = false;
+        const quint32 ipv4 = address.toIPv4Address(&isIPv4);
+        if (_batch && isIPv4) {
+            _sendEndpoints.append({ipv4, port});
+        } else {
+            _writeDatagram(data, address, port);
+        }
+    };
+
     QMutexLocker locker(&_sessionTargetsMutex);
 
     // Send to all manually targeted systems
@@ -401,25 +412,69 @@ void UDPWorker::writeData(const QByteArray &data)
         if (target->address.isNull()) {
             continue;
         }
-        if (!containsTarget(_sessionTargets, target->address, target->port)) {
-            if (_socket->writeDatagram(data, target->address, target->port) < 0) {
-                qCWarning(UDPLinkLog) << "Could Not Send Data - Write Failed!";
-            }
+        if (!_sessionTargetKeys.contains(_endpointKey(target->address, target->port))) {
+            sendTo(target->address, target->port);
         }
     }
 
     // Send to all connected systems
     for (const std::shared_ptr<UDPClient> &target: _sessionTargets) {
-        if (_socket->writeDatagram(data, target->address, target->port) < 0) {
-            qCWarning(UDPLinkLog) << "Could Not Send Data - Write Failed!";
-        }
+        sendTo(target->address, target->port);
     }
 
     locker.unlock();
 
+    if (!_sendEndpoints.isEmpty()) {
+        const int sent = _batch->send(_socket->socketDescriptor(), data, _sendEndpoints);
+        if (sent < _sendEndpoints.size()) {
+            qCWarning(UDPLinkLog) << "Could Not Send Data - Write Failed!" << _batch->errorString();
+        }
+    }
+
     emit dataSent(data);
 }
 
+void UDPWorker::_writeDatagram(const QByteArray &data, const QHostAddress &address, quint16 port)
+{
+    if (_socket->writeDatagram(data, address, port) < 0) {
+        qCWarning(UDPLinkLog) << "Could Not Send Data - Write Failed!";
+    }
+}
+
+quint64 UDPWorker::_endpointKey(const QHostAddress &address, quint16 port)
+{
+    bool isIPv4 = false;
+    const quint32 ipv4 = address.toIPv4Address(&isIPv4);
+    if (isIPv4) {
+        return UdpDatagramBatch::endpointKey(ipv4, port);
+    }
+
+    // Top bit set keeps hashed keys clear of the 48 bits an IPv4 key uses
+    return (Q_UINT64_C(1) << 63) | ((static_cast<quint64>(qHash(address)) & Q_UINT64_C(0x7FFFFFFFFFFF)) << 16) | port;
+}
+
+void UDPWorker::_addSender(quint64 senderKey, const QHostAddress &address, quint16 port)
+{
+    _knownSenders.insert(senderKey);
+
+    const bool ipLocal = address.isLoopback() || _localAddresses.contains(address);
+    _addSessionTarget(ipLocal ? QHostAddress(QHostAddress::SpecialAddress::LocalHost) : address, port);
+}
+
+void UDPWorker::_addSessionTarget(const QHostAddress &address, quint16 port)
+{
+    const quint64 key = _endpointKey(address, port);
+
+    QMutexLocker locker(&_sessionTargetsMutex);
+    if (_sessionTargetKeys.contains(key)) {
+        return;
+    }
+
+    qCDebug(UDPLinkLog) << "UDP Adding target:" << address << port;
+    _sessionTargetKeys.insert(key);
+    _sessionTargets.append(std::make_shared<UDPClient>(address, port));
+}
+
 void UDPWorker::_onSocketConnected()
 {
     qCDebug(UDPLinkLog) << "UDP connected to" << _udpConfig->localPort();
@@ -445,47 +500,113 @@ void UDPWorker::_onSocketReadyRead()
 
     const qint64 byteCount = _socket->pendingDatagramSize();
     if (byteCount <= 0) {
-        emit errorOccurred(tr("Could Not Read Data - No Data Available!"));
+        // A batched read can drain datagrams that arrived after the notifier fired
+        if (!_batch) {
+            emit errorOccurred(tr("Could Not Read Data - No Data Available!"));
+        }
         return;
     }
 
-    QByteArray buffer;
-    buffer.reserve(BUFFER_TRIGGER_SIZE);
-    QElapsedTimer timer;
-    timer.start();
-    bool received = false;
-    while (_socket->hasPendingDatagrams()) {
-        const QNetworkDatagram datagramIn = _socket->receiveDatagram();
-        if (datagramIn.isNull() || datagramIn.data().isEmpty()) {
-            continue;
+    _receiveBuffer.resize(0);
+    _receiveTimer.start();
+    _receiveEmitted = false;
+
+    if (_batch) {
+        _readBatched();
+    } else {
+        _readDatagrams();
+    }
+
+    if (_receiveBuffer.isEmpty()) {
+        if (!_receiveEmitted) {
+            qCWarning(UDPLinkLog) << "No Data Available to Read!";
         }
+        return;
+    }
+
+    emit dataReceived(_receiveBuffer);
+    _receiveBuffer.resize(0);
+}
 
-        (void) buffer.append(datagramIn.data());
+void UDPWorker::_readBatched()
+{
+    // QUdpSocket only re-arms its read notifier after one of its own reads, so the first datagram goes through it
+    const qint64 size = _socket->pendingDatagramSize();
+    if (_datagram.size() < size) {
+        _datagram.resize(size);
+    }
+    quint16 senderPort = 0;
+    const qint64 length = _socket->readDatagram(_datagram.data(), size, &_senderAddress, &senderPort);
+    if (length > 0) {
+        _appendReceived(QByteArrayView(_datagram.constData(), length));
+        const quint64 key = _endpointKey(_senderAddress, senderPort);
+        if (!_knownSenders.contains(key)) {
+            _addSender(key, _senderAddress, senderPort);
+        }
+    }
 
-        if ((buffer.size() > BUFFER_TRIGGER_SIZE) || (timer.elapsed() > RECEIVE_TIME_LIMIT_MS)) {
-            received = true;
-            emit dataReceived(buffer);
-            buffer.clear();
-            (void) timer.restart();
+    const qintptr descriptor = _socket->socketDescriptor();
+    const quint64 truncatedBefore = _batch->truncatedDatagrams();
+    while (true) {
+        const int count = _batch->receive(descriptor);
+        if (count < 0) {
+            qCWarning(UDPLinkLog) << "Batched receive failed:" << _batch->errorString();
+            break;
         }
 
-        const bool ipLocal = datagramIn.senderAddress().isLoopback() || _localAddresses.contains(datagramIn.senderAddress());
-        const QHostAddress senderAddress = ipLocal ? QHostAddress(QHostAddress::SpecialAddress::LocalHost) : datagramIn.senderAddress();
+        for (int i = 0; i < count; i++) {
+            const QByteArrayView datagram = _batch->datagram(i);
+            if (datagram.isEmpty()) {
+                continue;
+            }
+            _appendReceived(datagram);
 
-        QMutexLocker locker(&_sessionTargetsMutex);
-        if (!containsTarget(_sessionTargets, senderAddress, datagramIn.senderPort())) {
-            qCDebug(UDPLinkLog) << "UDP Adding target:" << senderAddress << datagramIn.senderPort();
-            _sessionTargets.append(std::make_shared<UDPClient>(senderAddress, datagramIn.senderPort()));
+            const UdpDatagramBatch::Endpoint sender = _batch->sender(i);
+            const quint64 key = UdpDatagramBatch::endpointKey(sender.ipv4, sender.port);
+            if (!_knownSenders.contains(key)) {
+                _addSender(key, QHostAddress(sender.ipv4), sender.port);
+            }
+        }
+
+        if (count < UdpDatagramBatch::kBatchSize) {
+            break;
         }
-        locker.unlock();
     }
 
-    if (!received && buffer.isEmpty()) {
-        qCWarning(UDPLinkLog) << "No Data Available to Read!";
-        return;
+    if (_batch->truncatedDatagrams() != truncatedBefore) {
+        qCWarning(UDPLinkLog) << "Truncated" << (_batch->truncatedDatagrams() - truncatedBefore) << "datagrams larger than" << UdpDatagramBatch::kSlotBytes << "bytes";
+    }
+}
+
+void UDPWorker::_readDatagrams()
+{
+    while (_socket->hasPendingDatagrams()) {
+        const QNetworkDatagram datagramIn = _socket->receiveDatagram();
+        if (datagramIn.isNull() || datagramIn.data().isEmpty()) {
+            continue;
+        }
+
+        _appendReceived(datagramIn.data());
+
+        const QHostAddress senderAddress = datagramIn.senderAddress();
+        const quint16 senderPort = static_cast<quint16>(datagramIn.senderPort());
+        const quint64 key = _endpointKey(senderAddress, senderPort);
+        if (!_knownSenders.contains(key)) {
+            _addSender(key, senderAddress, senderPort);
+        }
     }
+}
 
-    emit dataReceived(buffer);
+void UDPWorker::_appendReceived(QByteArrayView data)
+{
+    (void) _receiveBuffer.append(data);
+
+    if ((_receiveBuffer.size() > BUFFER_TRIGGER_SIZE) || (_receiveTimer.elapsed() > RECEIVE_TIME_LIMIT_MS)) {
+        _receiveEmitted = true;
+        emit dataReceived(_receiveBuffer);
+        _receiveBuffer.resize(0);
+        (void) _receiveTimer.restart();
+    }
 }
 
 void UDPWorker::_onSocketBytesWritten(qint64 bytes)
@@ -524,7 +645,8 @@ UDPLink::UDPLink(SharedLinkConfigurationPtr &config, QObject *parent)
     (void) connect(_worker, &UDPWorker::connected, this, &UDPLink::_onConnected, Qt::QueuedConnection);
     (void) connect(_worker, &UDPWorker::disconnected, this, &UDPLink::_onDisconnected, Qt::QueuedConnection);
     (void) connect(_worker, &UDPWorker::errorOccurred, this, &UDPLink::_onErrorOccurred, Qt::QueuedConnection);
-    (void) connect(_worker, &UDPWorker::dataReceived, this, &UDPLink::_onDataReceived, Qt::QueuedConnection);
+    // Direct: MAVLink decoding runs on the worker thread, only decoded messages reach the GUI thread.
+    (void) connect(_worker, &UDPWorker::dataReceived, this, &UDPLink::_onDataReceived, Qt::DirectConnection);
     (void) connect(_worker, &UDPWorker::dataSent, this, &UDPLink::_onDataSent, Qt::QueuedConnection);
 
     _workerThread->start();
@@ -583,7 +705,7 @@ void UDPLink::_onErrorOccurred(const QString &errorString)
 
 void UDPLink::_onDataReceived(const QByteArray &data)
 {
-    emit bytesReceived(this, data);
+    _receiveBytesOnLinkThread(data);
 }
 
 void UDPLink::_onDataSent(const QByteArray &data)
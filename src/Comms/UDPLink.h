@@ -4,12 +4,18 @@
 #include "LinkInterface.h"
 
 #include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QList>
 #include <QtCore/QMutex>
+#include <QtCore/QSet>
 #include <QtCore/QString>
 #include <QtNetwork/QHostAddress>
 
 #include <atomic>
+#include <memory>
+
+#include "UdpDatagramBatch.h"
 
 class QUdpSocket;
 class QThread;
@@ -134,14 +140,37 @@ private slots:
     void _onSocketErrorOccurred(QAbstractSocket::SocketError socketError);
 
 private:
+    void _readBatched();
+    void _readDatagrams();
+    /// Appends to the receive buffer, emitting it once it is large or old enough
+    void _appendReceived(QByteArrayView data);
+    /// First datagram from @p senderKey: remembers it and makes the sender a session target
+    void _addSender(quint64 senderKey, const QHostAddress &address, quint16 port);
+    void _addSessionTarget(const QHostAddress &address, quint16 port);
+    void _writeDatagram(const QByteArray &data, const QHostAddress &address, quint16 port);
+
+    /// Packs IPv4 endpoints exactly, anything else by hash
+    static quint64 _endpointKey(const QHostAddress &address, quint16 port);
+
     const UDPConfiguration *_udpConfig = nullptr;
     QUdpSocket *_socket = nullptr;
     QMutex _sessionTargetsMutex;
     QList<std::shared_ptr<UDPClient>> _sessionTargets;
+    QSet<quint64> _sessionTargetKeys;           ///< Guarded by _sessionTargetsMutex
     bool _isConnected = false;
     bool _errorEmitted = false;
     QSet<QHostAddress> _localAddresses;
 
+    /// Worker thread only
+    std::unique_ptr<UdpDatagramBatch> _batch;   ///< Null where batched I/O is not supported
+    QSet<quint64> _knownSenders;
+    QByteArray _receiveBuffer;
+    QElapsedTimer _receiveTimer;
+    bool _receiveEmitted = false;
+    QByteArray _datagram;
+    QHostAddress _senderAddress;
+    QList<UdpDatagramBatch::Endpoint> _sendEndpoints;
+
     static const QHostAddress _multicastGroup;
 };
 
@@ -167,6 +196,7 @@ private slots:
     void _onConnected();
     void _onDisconnected();
     void _onErrorOccurred(const QString &errorString);
+    /// Invoked directly on the worker thread.
     void _onDataReceived(const QByteArray &data);
     void _onDataSent(const QByteArray &data);
 
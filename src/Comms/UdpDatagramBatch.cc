@@ -0,0 +1,173 @@
+#include "UdpDatagramBatch.h"
+
+#include <QtCore/QtEndian>
+
+#ifdef Q_OS_LINUX
+#include <array>
+#include <cerrno>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+#ifdef Q_OS_LINUX
+
+struct UdpDatagramBatch::Buffers
+{
+    Buffers()
+        : ring(new char[static_cast<size_t>(kBatchSize * kSlotBytes)])
+    {
+        // Everything but the name lengths stays pointed at the same storage for the life of the batch
+        for (int i = 0; i < kBatchSize; i++) {
+            rxIov[i].iov_base = ring.get() + (i * kSlotBytes);
+            rxIov[i].iov_len = static_cast<size_t>(kSlotBytes);
+            rxMessages[i].msg_hdr.msg_name = &rxAddresses[i];
+            rxMessages[i].msg_hdr.msg_iov = &rxIov[i];
+            rxMessages[i].msg_hdr.msg_iovlen = 1;
+
+            txMessages[i].msg_hdr.msg_name = &txAddresses[i];
+            txMessages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            txMessages[i].msg_hdr.msg_iov = &txIov;
+            txMessages[i].msg_hdr.msg_iovlen = 1;
+            txAddresses[i].sin_family = AF_INET;
+        }
+    }
+
+    std::unique_ptr<char[]> ring;
+    std::array<iovec, kBatchSize> rxIov{};
+    std::array<sockaddr_in, kBatchSize> rxAddresses{};
+    std::array<mmsghdr, kBatchSize> rxMessages{};
+
+    iovec txIov{};
+    std::array<sockaddr_in, kBatchSize> txAddresses{};
+    std::array<mmsghdr, kBatchSize> txMessages{};
+};
+
+UdpDatagramBatch::UdpDatagramBatch()
+    : _buffers(std::make_unique<Buffers>())
+{
+}
+
+bool UdpDatagramBatch::isSupported()
+{
+    return true;
+}
+
+int UdpDatagramBatch::receive(qintptr socketDescriptor)
+{
+    for (mmsghdr &message : _buffers->rxMessages) {
+        message.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    }
+
+    int count;
+    do {
+        count = ::recvmmsg(static_cast<int>(socketDescriptor), _buffers->rxMessages.data(), kBatchSize, MSG_DONTWAIT, nullptr);
+    } while ((count < 0) && (errno == EINTR));
+
+    if (count < 0) {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+            return 0;
+        }
+        _errorString = qt_error_string(errno);
+        return -1;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (_buffers->rxMessages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+            _truncatedDatagrams++;
+        }
+    }
+
+    return count;
+}
+
+QByteArrayView UdpDatagramBatch::datagram(int index) const
+{
+    Q_ASSERT((index >= 0) && (index < kBatchSize));
+    const qsizetype length = qMin(static_cast<qsizetype>(_buffers->rxMessages[index].msg_len), kSlotBytes);
+    return QByteArrayView(_buffers->ring.get() + (index * kSlotBytes), length);
+}
+
+UdpDatagramBatch::Endpoint UdpDatagramBatch::sender(int index) const
+{
+    Q_ASSERT((index >= 0) && (index < kBatchSize));
+    const sockaddr_in &address = _buffers->rxAddresses[index];
+    return {qFromBigEndian(static_cast<quint32>(address.sin_addr.s_addr)), qFromBigEndian(static_cast<quint16>(address.sin_port))};
+}
+
+int UdpDatagramBatch::send(qintptr socketDescriptor, QByteArrayView data, QSpan<const Endpoint> endpoints)
+{
+    _buffers->txIov.iov_base = const_cast<char *>(data.data());
+    _buffers->txIov.iov_len = static_cast<size_t>(data.size());
+
+    qsizetype sent = 0;
+    while (sent < endpoints.size()) {
+        const int batch = static_cast<int>(qMin<qsizetype>(endpoints.size() - sent, kBatchSize));
+        for (int i = 0; i < batch; i++) {
+            _buffers->txAddresses[i].sin_addr.s_addr = qToBigEndian(endpoints[sent + i].ipv4);
+            _buffers->txAddresses[i].sin_port = qToBigEndian(endpoints[sent + i].port);
+        }
+
+        int count;
+        do {
+            count = ::sendmmsg(static_cast<int>(socketDescriptor), _buffers->txMessages.data(), static_cast<unsigned int>(batch), 0);
+        } while ((count < 0) && (errno == EINTR));
+
+        if (count < 0) {
+            _errorString = qt_error_string(errno);
+            return (sent > 0) ? static_cast<int>(sent) : -1;
+        }
+
+        sent += count;
+        if (count < batch) {
+            // The send buffer is full; the rest would only fail the same way
+            break;
+        }
+    }
+
+    return static_cast<int>(sent);
+}
+
+#else
+
+struct UdpDatagramBatch::Buffers
+{
+};
+
+UdpDatagramBatch::UdpDatagramBatch() = default;
+
+bool UdpDatagramBatch::isSupported()
+{
+    return false;
+}
+
+int UdpDatagramBatch::receive(qintptr socketDescriptor)
+{
+    Q_UNUSED(socketDescriptor);
+    _errorString = QStringLiteral("Batched datagram I/O is not supported on this platform");
+    return -1;
+}
+
+QByteArrayView UdpDatagramBatch::datagram(int index) const
+{
+    Q_UNUSED(index);
+    return QByteArrayView();
+}
+
+UdpDatagramBatch::Endpoint UdpDatagramBatch::sender(int index) const
+{
+    Q_UNUSED(index);
+    return Endpoint();
+}
+
+int UdpDatagramBatch::send(qintptr socketDescriptor, QByteArrayView data, QSpan<const Endpoint> endpoints)
+{
+    Q_UNUSED(socketDescriptor);
+    Q_UNUSED(data);
+    Q_UNUSED(endpoints);
+    _errorString = QStringLiteral("Batched datagram I/O is not supported on this platform");
+    return -1;
+}
+
+#endif
+
+UdpDatagramBatch::~UdpDatagramBatch() = default;
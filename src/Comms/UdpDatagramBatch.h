@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QtCore/QByteArrayView>
+#include <QtCore/QSpan>
+#include <QtCore/QString>
+#include <QtCore/QtTypes>
+
+#include <memory>
+
+/// \brief Receives and sends UDP datagrams in batches of up to kBatchSize per system call.
+///
+/// Uses recvmmsg/sendmmsg on the descriptor of an already bound socket. That is Linux only: isSupported() is false
+/// elsewhere and callers keep using QUdpSocket directly. Received datagrams land in a ring of fixed-size slots that is
+/// allocated once and reused; they stay valid until the next receive(). Only IPv4 is handled, matching the AnyIPv4
+/// bind of UDPLink.
+///
+/// Each slot holds the largest IPv4 UDP payload. The ring is left uninitialised, so only the pages datagrams are
+/// actually written to become resident.
+class UdpDatagramBatch
+{
+public:
+    static constexpr int kBatchSize = 64;
+    /// Largest UDP payload over IPv4, so no datagram is truncated
+    static constexpr qsizetype kSlotBytes = 65507;
+
+    struct Endpoint
+    {
+        quint32 ipv4 = 0;   ///< Host byte order
+        quint16 port = 0;
+    };
+
+    UdpDatagramBatch();
+    ~UdpDatagramBatch();
+
+    static bool isSupported();
+
+    /// Packs an IPv4 endpoint into a hash key
+    static constexpr quint64 endpointKey(quint32 ipv4, quint16 port) { return (static_cast<quint64>(ipv4) << 16) | port; }
+
+    /// Receives whatever is pending, up to kBatchSize datagrams, without blocking.
+    /// @return number of datagrams received, 0 if none were pending, -1 on error
+    int receive(qintptr socketDescriptor);
+
+    /// Valid after receive() for 0 <= @p index < the count it returned
+    QByteArrayView datagram(int index) const;
+    Endpoint sender(int index) const;
+
+    /// Sends @p data once to every endpoint, kBatchSize endpoints per system call.
+    /// @return number of datagrams sent, -1 if none could be sent
+    int send(qintptr socketDescriptor, QByteArrayView data, QSpan<const Endpoint> endpoints);
+
+    quint64 truncatedDatagrams() const { return _truncatedDatagrams; }
+    QString errorString() const { return _errorString; }
+
+private:
+    struct Buffers;
+    std::unique_ptr<Buffers> _buffers;
+
+    quint64 _truncatedDatagrams = 0;
+    QString _errorString;
+};
@@ -5,6 +5,7 @@
 #include <limits>
 
 #include "Fact.h"
+#include "FactNotificationCoalescer.h"
 #include "FactValueSliderListModel.h"
 #include "AppMessages.h"
 #include "QGCApplication.h"
@@ -98,6 +99,7 @@ const Fact &Fact::operator=(const Fact& other)
     _type = other._type;
     _sendValueChangedSignals = other._sendValueChangedSignals;
     _deferredValueChangeSignal = other._deferredValueChangeSignal;
+    _coalescedNotifications = other._coalescedNotifications;
     _valueSliderModel = nullptr;
     if (_metaData && other._metaData) {
         *_metaData = *other._metaData;
@@ -148,11 +150,7 @@ void Fact::setRawValue(const QVariant &value)
             }
 
             if (changed) {
-                const QVariant cooked = _metaData->rawTranslator()(typedValue);
-                _sendValueChangedSignal(cooked);
-                //-- Must be in this order
-                emit containerRawValueChanged(typedValue);
-                emit rawValueChanged(typedValue);
+                _rawValueUpdated();
             }
         }
     } else {
@@ -160,6 +158,40 @@ void Fact::setRawValue(const QVariant &value)
     }
 }
 
+void Fact::_rawValueUpdated()
+{
+    if (_coalescedNotifications) {
+        if (_coalescedDirty) {
+            // Already queued; the coalesced notification picks up the latest value
+            return;
+        }
+        if (FactNotificationCoalescer::instance()->markDirty(this)) {
+            _coalescedDirty = true;
+            return;
+        }
+    }
+
+    _emitRawValueChanged();
+}
+
+void Fact::_emitRawValueChanged()
+{
+    const QVariant typedValue = rawValue();
+    const QVariant cooked = _metaData->rawTranslator()(typedValue);
+    _sendValueChangedSignal(cooked);
+    //-- Must be in this order
+    emit containerRawValueChanged(typedValue);
+    emit rawValueChanged(typedValue);
+}
+
+void Fact::_sendCoalescedNotification()
+{
+    if (_coalescedDirty) {
+        _coalescedDirty = false;
+        _emitRawValueChanged();
+    }
+}
+
 void Fact::setCookedValue(const QVariant& value)
 {
     if (_metaData) {
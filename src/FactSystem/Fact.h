@@ -6,9 +6,12 @@
 #include <QtCore/QString>
 #include <QtCore/QVariant>
 #include <QtQmlIntegration/QtQmlIntegration>
+#include <type_traits>
+#include <utility>
 
 #include "FactMetaData.h"
 
+class FactNotificationCoalescer;
 class FactValueSliderListModel;
 
 /// \brief A Fact is used to hold a single value within the system.
@@ -147,6 +150,13 @@ class Fact : public QObject
     QString rawValueStringFullPrecision() const;
 
     void setRawValue(const QVariant &value);
+
+    /// Telemetry fast path. A value that already matches the Fact's storage type is stored without a QVariant
+    /// round trip through FactMetaData::convertAndValidateRaw; anything else goes through setRawValue(QVariant).
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    void setRawValue(T value);
+
     void setCookedValue(const QVariant &value);
     void setEnumIndex(int index);
     void setEnumStringValue(const QString &value);
@@ -160,6 +170,11 @@ class Fact : public QObject
     void clearDeferredValueChangeSignal() { _deferredValueChangeSignal = false; }
     void sendDeferredValueChangedSignal();
 
+    /// Coalesced Facts only mark themselves dirty on a value change; FactNotificationCoalescer sends one
+    /// rawValueChanged/valueChanged per tick with the latest value. rawValue() is always current. Used by FactGroup.
+    void setCoalescedNotifications(bool coalesced) { _coalescedNotifications = coalesced; }
+    bool coalescedNotifications() const { return _coalescedNotifications; }
+
     /// Sets and sends new value to vehicle even if value is the same
     void forceSetRawValue(const QVariant &value);
 
@@ -216,4 +231,110 @@ private slots:
 
 private:
     void _init();
+
+    /// Stores @p value if it differs from the current value. Returns true if it changed.
+    template <typename S>
+    bool _storeTypedRawValue(S value);
+    void _rawValueUpdated();
+    void _emitRawValueChanged();
+    void _sendCoalescedNotification();
+
+    bool _coalescedNotifications = false;
+    bool _coalescedDirty = false;
+
+    friend class FactNotificationCoalescer;
 };
+
+template <typename S>
+bool Fact::_storeTypedRawValue(S value)
+{
+    QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
+    if ((_rawValue.metaType() == QMetaType::fromType<S>()) && (*static_cast<const S *>(_rawValue.constData()) == value)) {
+        return false;
+    }
+    _rawValue.setValue(value);
+    return true;
+}
+
+template <typename T>
+    requires std::is_arithmetic_v<T>
+void Fact::setRawValue(T value)
+{
+    if (_metaData) {
+        bool handled = true;
+        bool changed = false;
+
+        switch (_metaData->type()) {
+        case FactMetaData::valueTypeBool:
+            if constexpr (std::is_same_v<T, bool>) {
+                changed = _storeTypedRawValue(value);
+            } else {
+                handled = false;
+            }
+            break;
+        case FactMetaData::valueTypeFloat:
+            if constexpr (std::is_floating_point_v<T>) {
+                changed = _storeTypedRawValue(static_cast<float>(value));
+            } else {
+                handled = false;
+            }
+            break;
+        case FactMetaData::valueTypeDouble:
+        case FactMetaData::valueTypeElapsedTimeInSeconds:
+            if constexpr (std::is_floating_point_v<T>) {
+                changed = _storeTypedRawValue(static_cast<double>(value));
+            } else {
+                handled = false;
+            }
+            break;
+        case FactMetaData::valueTypeInt8:
+        case FactMetaData::valueTypeInt16:
+        case FactMetaData::valueTypeInt32:
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                handled = std::in_range<int>(value);
+                changed = handled && _storeTypedRawValue(static_cast<int>(value));
+            } else {
+                handled = false;
+            }
+            break;
+        case FactMetaData::valueTypeInt64:
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                handled = std::in_range<qlonglong>(value);
+                changed = handled && _storeTypedRawValue(static_cast<qlonglong>(value));
+            } else {
+                handled = false;
+            }
+            break;
+        case FactMetaData::valueTypeUint8:
+        case FactMetaData::valueTypeUint16:
+        case FactMetaData::valueTypeUint32:
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                handled = std::in_range<uint>(value);
+                changed = handled && _storeTypedRawValue(static_cast<uint>(value));
+            } else {
+                handled = false;
+            }
+            break;
+        case FactMetaData::valueTypeUint64:
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                handled = std::in_range<qulonglong>(value);
+                changed = handled && _storeTypedRawValue(static_cast<qulonglong>(value));
+            } else {
+                handled = false;
+            }
+            break;
+        default:
+            handled = false;
+            break;
+        }
+
+        if (handled) {
+            if (changed) {
+                _rawValueUpdated();
+            }
+            return;
+        }
+    }
+
+    setRawValue(QVariant::fromValue(value));
+}
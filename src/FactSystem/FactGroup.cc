@@ -121,6 +121,9 @@ void FactGroup::_addFact(Fact *fact, const QString &name)
     }
 
     fact->setSendValueChangedSignals(_updateRateMSecs == 0);
+    if (_coalescedNotifications) {
+        fact->setCoalescedNotifications(true);
+    }
     if (_nameToFactMetaDataMap.contains(name)) {
         fact->setMetaData(_nameToFactMetaDataMap[name], true /* setDefaultFromMetaData */);
     }
@@ -179,3 +182,11 @@ void FactGroup::_setTelemetryAvailable (bool telemetryAvailable)
         emit telemetryAvailableChanged(_telemetryAvailable);
     }
 }
+
+void FactGroup::_setCoalescedNotifications(bool coalesced)
+{
+    _coalescedNotifications = coalesced;
+    for (Fact *const fact : std::as_const(_nameToFactMap)) {
+        fact->setCoalescedNotifications(coalesced);
+    }
+}
@@ -48,6 +48,12 @@ class FactGroup : public QObject
     /// Allows a FactGroup to parse incoming messages and fill in values
     virtual void handleMessage(Vehicle * /*vehicle*/, const mavlink_message_t & /*message*/) {}
 
+    /// Message ids handleMessage() cares about. Vehicle only routes these ids to the group.
+    /// The default of kAllMessageIds routes every message, for groups which have not declared their ids.
+    virtual QList<uint32_t> handledMessageIds() const { return { kAllMessageIds }; }
+
+    static constexpr uint32_t kAllMessageIds = UINT32_MAX;
+
 signals:
     void factNamesChanged();
     void factGroupNamesChanged();
@@ -64,6 +70,10 @@ protected slots:
     void _loadFromJsonArray(const QJsonArray &jsonArray);
     void _setTelemetryAvailable(bool telemetryAvailable);
 
+    /// Telemetry groups opt in: their Facts then notify at most once per FactNotificationCoalescer tick however fast
+    /// messages arrive. Applies to Facts already added and to those added later.
+    void _setCoalescedNotifications(bool coalesced);
+
     const int _updateRateMSecs = 0;   ///< Update rate for Fact::valueChanged signals, 0: immediate update
 
     QMap<QString, Fact*> _nameToFactMap;
@@ -78,4 +88,5 @@ protected slots:
     QTimer _updateTimer;
     const bool _ignoreCamelCase = false;
     bool _telemetryAvailable = false;
+    bool _coalescedNotifications = false;
 };
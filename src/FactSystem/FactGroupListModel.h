@@ -20,6 +20,9 @@ class FactGroupListModel : public QmlObjectListModel
     /// Allows for creation/updating of dynamic FactGroups based on incoming messages
     void handleMessageForFactGroupCreation(Vehicle *vehicle, const mavlink_message_t &message);
 
+    /// Message ids which can create a FactGroup, used by Vehicle to route only these to the model
+    virtual QList<uint32_t> handledMessageIds() const = 0;
+
 protected:
     virtual bool _shouldHandleMessage(const mavlink_message_t &message, QList<uint32_t> &ids) const = 0;
     virtual FactGroupWithId *_createFactGroupWithId(uint32_t id) = 0;
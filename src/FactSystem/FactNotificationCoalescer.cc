@@ -0,0 +1,75 @@
+#include "FactNotificationCoalescer.h"
+#include "Fact.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QApplicationStatic>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
+
+#include <utility>
+
+QGC_LOGGING_CATEGORY(FactNotificationCoalescerLog, "FactSystem.FactNotificationCoalescer")
+
+Q_APPLICATION_STATIC(FactNotificationCoalescer, _factNotificationCoalescerInstance);
+
+FactNotificationCoalescer::FactNotificationCoalescer(QObject *parent)
+    : QObject(parent)
+    , _timer(this)
+{
+    // Telemetry can touch a Fact from any thread first; the tick always belongs to the GUI thread.
+    if (QCoreApplication *const app = QCoreApplication::instance(); app && (thread() != app->thread())) {
+        moveToThread(app->thread());
+    }
+
+    _timer.setSingleShot(true);
+    _timer.setTimerType(Qt::PreciseTimer);
+    _timer.setInterval(_intervalMSecs);
+    (void) connect(&_timer, &QTimer::timeout, this, &FactNotificationCoalescer::flush);
+
+    qCDebug(FactNotificationCoalescerLog) << this;
+}
+
+FactNotificationCoalescer::~FactNotificationCoalescer()
+{
+    qCDebug(FactNotificationCoalescerLog) << this;
+}
+
+FactNotificationCoalescer *FactNotificationCoalescer::instance()
+{
+    return _factNotificationCoalescerInstance();
+}
+
+void FactNotificationCoalescer::setIntervalMSecs(int intervalMSecs)
+{
+    _intervalMSecs = qMax(0, intervalMSecs);
+    _timer.setInterval(_intervalMSecs);
+    if (_intervalMSecs == 0) {
+        flush();
+    }
+}
+
+bool FactNotificationCoalescer::markDirty(Fact *fact)
+{
+    if ((_intervalMSecs == 0) || (QThread::currentThread() != thread())) {
+        return false;
+    }
+
+    _dirty.append(fact);
+    if (!_timer.isActive()) {
+        _timer.start();
+    }
+    return true;
+}
+
+void FactNotificationCoalescer::flush()
+{
+    _timer.stop();
+
+    // Handlers may write more telemetry; those land in _dirty and wait for the next tick.
+    const QList<QPointer<Fact>> dirty = std::exchange(_dirty, {});
+    for (const QPointer<Fact> &fact : dirty) {
+        if (fact) {
+            fact->_sendCoalescedNotification();
+        }
+    }
+}
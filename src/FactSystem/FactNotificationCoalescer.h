@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+
+class Fact;
+
+/// \brief Batches value change notifications of telemetry Facts.
+///
+/// Facts in coalesced mode (see Fact::setCoalescedNotifications) only mark themselves dirty on write. The first
+/// dirty Fact arms a single-shot tick, and the tick emits one rawValueChanged/valueChanged per dirty Fact with its
+/// latest value. However fast telemetry arrives, QML bindings re-evaluate at most once per tick. The timer is idle
+/// while nothing is dirty.
+///
+/// GUI thread only. Writes from other threads are notified immediately.
+class FactNotificationCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FactNotificationCoalescer(QObject *parent = nullptr);
+    ~FactNotificationCoalescer();
+
+    static FactNotificationCoalescer *instance();
+
+    /// 0 disables coalescing: dirty Facts are flushed and later writes notify immediately.
+    void setIntervalMSecs(int intervalMSecs);
+    int intervalMSecs() const { return _intervalMSecs; }
+
+    /// Returns false if @p fact must notify immediately instead.
+    bool markDirty(Fact *fact);
+
+    /// Emits all pending notifications now.
+    void flush();
+
+    qsizetype pendingCount() const { return _dirty.size(); }
+
+    static constexpr int kDefaultIntervalMSecs = 16;    ///< ~60 Hz
+
+private:
+    QTimer _timer;
+    int _intervalMSecs = kDefaultIntervalMSecs;
+    QList<QPointer<Fact>> _dirty;
+};
@@ -9,6 +9,7 @@ APMSubmarineFactGroup::APMSubmarineFactGroup(QObject *parent)
 {
     // qCDebug(APMSubmarineFactGroupLog) << Q_FUNC_INFO << this;
 
+    _setCoalescedNotifications(true);
     _addFact(&_camTiltFact);
     _addFact(&_tetherTurnsFact);
     _addFact(&_lightsLevel1Fact);
@@ -231,6 +231,14 @@ FlightMap {
         planMasterController:       _planMasterController
     }
 
+    // Downloads tiles ahead of the vehicle and along the mission before the map needs them
+    TilePrefetchController {
+        missionController:  _planMasterController.missionController
+        vehicle:            _activeVehicle
+        mapType:            _root.activeMapType ? _root.activeMapType.name : ""
+        zoomLevel:          _root.zoomLevel
+    }
+
     ObstacleDistanceOverlayMap {
         id: obstacleDistance
         showText: !pipMode
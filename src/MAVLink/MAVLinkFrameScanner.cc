@@ -0,0 +1,182 @@
+#include "MAVLinkFrameScanner.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "MAVLinkLib.h"
+
+namespace {
+
+constexpr qsizetype kV1HeaderBytes = MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1;
+constexpr qsizetype kV2HeaderBytes = MAVLINK_NUM_HEADER_BYTES;
+
+constexpr bool isStx(uint8_t byte)
+{
+    return (byte == MAVLINK_STX) || (byte == MAVLINK_STX_MAVLINK1);
+}
+
+}  // namespace
+
+MAVLinkFrameScanner::MAVLinkFrameScanner(uint8_t channel, QByteArrayView data)
+    : _channel(channel),
+      _status(mavlink_get_channel_status(channel)),
+      _data(reinterpret_cast<const uint8_t*>(data.constData())),
+      _size(data.size())
+{
+}
+
+bool MAVLinkFrameScanner::_channelIdle() const
+{
+    return (_status->parse_state == MAVLINK_PARSE_STATE_UNINIT) || (_status->parse_state == MAVLINK_PARSE_STATE_IDLE);
+}
+
+bool MAVLinkFrameScanner::next()
+{
+    if (!_status) {
+        return false;
+    }
+
+    while (_pos < _size) {
+        if (_channelIdle()) {
+            // An idle parser ignores everything up to the next STX, so skip it in one pass.
+            const uint8_t* const begin = _data + _pos;
+            const uint8_t* const stx = std::find_if(begin, _data + _size, isStx);
+            if (stx != begin) {
+                _status->parse_error = 0;
+            }
+            _pos = stx - _data;
+            if (_pos >= _size) {
+                break;
+            }
+
+            if (_tryFastFrame() == FastResult::Frame) {
+                ++_fastPathFrames;
+                return true;
+            }
+        }
+
+        // Parser is mid-frame (split across reads) or the frame at _pos needs libmavlink's full handling.
+        // Stay on the byte path until the channel returns to idle.
+        do {
+            const uint8_t framing = mavlink_parse_char(_channel, _data[_pos++], &_message, &_parseStatus);
+            ++_bytePathBytes;
+            if ((framing == MAVLINK_FRAMING_OK) || (framing == MAVLINK_FRAMING_BAD_SIGNATURE)) {
+                _framing = framing;
+                _isV1 = (_parseStatus.flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1);
+                return true;
+            }
+        } while ((_pos < _size) && !_channelIdle());
+    }
+
+    return false;
+}
+
+MAVLinkFrameScanner::FastResult MAVLinkFrameScanner::_tryFastFrame()
+{
+    const uint8_t* const frame = _data + _pos;
+    const qsizetype available = _size - _pos;
+
+    const bool isV1 = (frame[0] == MAVLINK_STX_MAVLINK1);
+    const qsizetype headerBytes = isV1 ? kV1HeaderBytes : kV2HeaderBytes;
+    if (available < headerBytes) {
+        return FastResult::Fallback;
+    }
+
+    const uint8_t payloadLen = frame[1];
+    const uint8_t incompatFlags = isV1 ? 0 : frame[2];
+    if ((incompatFlags & ~MAVLINK_IFLAG_MASK) != 0) {
+        return FastResult::Fallback;
+    }
+
+    const bool isSigned = (incompatFlags & MAVLINK_IFLAG_SIGNED);
+    const qsizetype frameBytes =
+        headerBytes + payloadLen + MAVLINK_NUM_CHECKSUM_BYTES + (isSigned ? MAVLINK_SIGNATURE_BLOCK_LEN : 0);
+    if (available < frameBytes) {
+        return FastResult::Fallback;
+    }
+
+    uint8_t compatFlags = 0;
+    uint8_t seq;
+    uint8_t sysid;
+    uint8_t compid;
+    uint32_t msgid;
+    if (isV1) {
+        seq = frame[2];
+        sysid = frame[3];
+        compid = frame[4];
+        msgid = frame[5];
+    } else {
+        compatFlags = frame[3];
+        seq = frame[4];
+        sysid = frame[5];
+        compid = frame[6];
+        msgid = static_cast<uint32_t>(frame[7]) | (static_cast<uint32_t>(frame[8]) << 8) |
+                (static_cast<uint32_t>(frame[9]) << 16);
+    }
+
+    // CRC covers everything after STX through the payload, then crc_extra.
+    const mavlink_msg_entry_t* const entry = mavlink_get_msg_entry(msgid);
+    uint16_t crc = crc_calculate(frame + 1, static_cast<uint16_t>(headerBytes - 1 + payloadLen));
+    crc_accumulate(entry ? entry->crc_extra : 0, &crc);
+
+    const uint8_t* const ck = frame + headerBytes + payloadLen;
+    if ((ck[0] != (crc & 0xFF)) || (ck[1] != (crc >> 8))) {
+        return FastResult::Fallback;
+    }
+
+    mavlink_message_t& msg = _message;
+    msg.checksum = crc;
+    msg.magic = frame[0];
+    msg.len = payloadLen;
+    msg.incompat_flags = incompatFlags;
+    msg.compat_flags = compatFlags;
+    msg.seq = seq;
+    msg.sysid = sysid;
+    msg.compid = compid;
+    msg.msgid = msgid;
+
+    char* const payload = _MAV_PAYLOAD_NON_CONST(&msg);
+    (void) memcpy(payload, frame + headerBytes, payloadLen);
+    // Zero-fill truncated (MAVLink2 trailing-zero) payloads exactly as the byte parser does.
+    if (entry && (payloadLen < entry->max_msg_len)) {
+        (void) memset(payload + payloadLen, 0, entry->max_msg_len - payloadLen);
+    }
+    msg.ck[0] = ck[0];
+    msg.ck[1] = ck[1];
+    if (isSigned) {
+        (void) memcpy(msg.signature, ck + MAVLINK_NUM_CHECKSUM_BYTES, MAVLINK_SIGNATURE_BLOCK_LEN);
+    }
+
+    // Same acceptance rules as mavlink_frame_char_buffer(). Anything it would not report as OK goes back
+    // through the byte parser so BAD_SIGNATURE reporting and error counters stay libmavlink's.
+    mavlink_signing_t* const signing = _status->signing;
+    if (isSigned) {
+        if (!mavlink_signature_check(signing, _status->signing_streams, &msg) &&
+            !(signing->accept_unsigned_callback && signing->accept_unsigned_callback(_status, msgid))) {
+            return FastResult::Fallback;
+        }
+    } else if (signing &&
+               (!signing->accept_unsigned_callback || !signing->accept_unsigned_callback(_status, msgid))) {
+        return FastResult::Fallback;
+    }
+
+    if (isV1) {
+        _status->flags |= MAVLINK_STATUS_FLAG_IN_MAVLINK1;
+    } else {
+        _status->flags &= ~MAVLINK_STATUS_FLAG_IN_MAVLINK1;
+    }
+    _status->msg_received = MAVLINK_FRAMING_OK;
+    _status->parse_state = MAVLINK_PARSE_STATE_IDLE;
+    _status->current_rx_seq = seq;
+    if (_status->packet_rx_success_count == 0) {
+        _status->packet_rx_drop_count = 0;
+    }
+    _status->packet_rx_success_count++;
+    _status->parse_error = 0;
+
+    _framing = MAVLINK_FRAMING_OK;
+    _isV1 = isV1;
+    _pos += frameBytes;
+
+    return FastResult::Frame;
+}
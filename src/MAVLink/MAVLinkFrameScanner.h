@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QtCore/QByteArrayView>
+#include <cstdint>
+
+#include "MAVLinkMessageType.h"
+
+/// \brief Buffer-level MAVLink frame scanner for one channel.
+///
+/// Walks a received byte span and emits whole frames. A frame that starts while the channel parser is idle and
+/// lies entirely inside the span is validated (header, CRC, signature) directly over the contiguous bytes and
+/// copied out once. Everything else - frames split across reads, bad CRCs, rejected signatures, unknown incompat
+/// flags - is fed through libmavlink's per-byte state machine, so channel status, rx counters and signing state
+/// end up exactly as mavlink_parse_char() alone would have left them.
+///
+/// libmavlink keeps the per-channel rx buffer in a TU-local static, so all parsing of a channel must go through
+/// one scanner TU. Do not mix direct mavlink_parse_char() calls on the same channel.
+///
+/// Usage:
+/// \code
+///     MAVLinkFrameScanner scanner(channel, data);
+///     while (scanner.next()) {
+///         handle(scanner.framing(), scanner.message());
+///     }
+/// \endcode
+class MAVLinkFrameScanner
+{
+public:
+    MAVLinkFrameScanner(uint8_t channel, QByteArrayView data);
+
+    /// Advance to the next frame with MAVLINK_FRAMING_OK or MAVLINK_FRAMING_BAD_SIGNATURE.
+    /// Returns false once the span is exhausted; any trailing partial frame stays in the channel parser.
+    bool next();
+
+    /// Framing result of the current frame.
+    uint8_t framing() const { return _framing; }
+
+    /// True if the current frame arrived as MAVLink v1.
+    bool isV1() const { return _isV1; }
+
+    /// The current frame. Valid until the next call to next().
+    const mavlink_message_t& message() const { return _message; }
+
+    /// Frames decoded straight from the span without the per-byte parser.
+    uint32_t fastPathFrames() const { return _fastPathFrames; }
+
+    /// Bytes that went through mavlink_parse_char().
+    uint32_t bytePathBytes() const { return _bytePathBytes; }
+
+private:
+    enum class FastResult : uint8_t
+    {
+        Frame,      ///< Complete valid frame copied into _message
+        Fallback,   ///< Let the byte parser handle this frame
+    };
+
+    bool _channelIdle() const;
+    FastResult _tryFastFrame();
+
+    uint8_t _channel;
+    mavlink_status_t* _status = nullptr;
+    const uint8_t* _data = nullptr;
+    qsizetype _size = 0;
+    qsizetype _pos = 0;
+
+    mavlink_message_t _message{};
+    mavlink_status_t _parseStatus{};
+    uint8_t _framing = 0;
+    bool _isV1 = false;
+
+    uint32_t _fastPathFrames = 0;
+    uint32_t _bytePathBytes = 0;
+};
@@ -1,6 +1,5 @@
 #include "MAVLinkSigning.h"
 
-#include <QtCore/QCryptographicHash>
 #include <QtCore/QDateTime>
 #include <algorithm>
 
@@ -122,6 +121,14 @@ void setMessageSigned(mavlink_message_t& message, bool isSigned)
 }
 
 QByteArray serializeUnsignedCopy(const mavlink_message_t& message)
+{
+    QByteArray buf(MAVLINK_MAX_PACKET_LEN, Qt::Uninitialized);
+    const uint16_t len = serializeUnsignedCopy(message, reinterpret_cast<uint8_t*>(buf.data()));
+    buf.resize(len);
+    return buf;
+}
+
+uint16_t serializeUnsignedCopy(const mavlink_message_t& message, uint8_t* buffer)
 {
     mavlink_message_t copy = message;
 
@@ -150,33 +157,28 @@ QByteArray serializeUnsignedCopy(const mavlink_message_t& message)
         mavlink_ck_b(&copy) = static_cast<uint8_t>(checksum >> 8);
     }
 
-    QByteArray buf(MAVLINK_MAX_PACKET_LEN, Qt::Uninitialized);
-    const uint16_t len = mavlink_msg_to_send_buffer(reinterpret_cast<uint8_t*>(buf.data()), &copy);
-    buf.resize(len);
-    return buf;
+    return mavlink_msg_to_send_buffer(buffer, &copy);
 }
 
 namespace {
 
-/// C lib signature hash: SHA-256(secret_key + header_bytes + payload + CRC + link_id + timestamp).
+/// C lib signature hash: SHA-256(secret_key + header_bytes + payload + CRC + link_id + timestamp), truncated to 48 bits.
 /// `message.signature[0..kSignaturePrefixBytes)` (link_id + timestamp) must already be populated by the caller, since
 /// they are hashed in. Shared by verify (memcmp) and sign (memcpy) so the two can never diverge on wire layout.
-void _computeSignatureHash(QByteArrayView key, const mavlink_message_t& message, uchar (&hashBuf)[kSigningKeySize])
+/// Streams straight from the message with libmavlink's SHA-256, the same one mavlink_signature_check uses, so a
+/// verify touches no heap and builds no part list.
+void _computeSignatureHash(QByteArrayView key, const mavlink_message_t& message, uint8_t (&hash)[kSignatureHashBytes])
 {
-    const uint8_t* header = reinterpret_cast<const uint8_t*>(&message.magic);
-    const char* payload = _MAV_PAYLOAD(&message);
-    const uint8_t* sig = message.signature;
     const uint8_t crc[2] = {static_cast<uint8_t>(message.checksum & 0xFF), static_cast<uint8_t>(message.checksum >> 8)};
 
-    const QByteArrayView parts[] = {
-        key.first(kSigningKeySize),
-        QByteArrayView(reinterpret_cast<const char*>(header), MAVLINK_NUM_HEADER_BYTES),
-        QByteArrayView(payload, message.len),
-        QByteArrayView(reinterpret_cast<const char*>(crc), sizeof(crc)),
-        QByteArrayView(reinterpret_cast<const char*>(sig), kSignaturePrefixBytes),
-    };
-    (void) QCryptographicHash::hashInto(QSpan<uchar>(hashBuf), QSpan<const QByteArrayView>(parts),
-                                       QCryptographicHash::Sha256);
+    mavlink_sha256_ctx ctx;
+    mavlink_sha256_init(&ctx);
+    mavlink_sha256_update(&ctx, key.constData(), kSigningKeySize);
+    mavlink_sha256_update(&ctx, &message.magic, MAVLINK_NUM_HEADER_BYTES);
+    mavlink_sha256_update(&ctx, _MAV_PAYLOAD(&message), message.len);
+    mavlink_sha256_update(&ctx, crc, sizeof(crc));
+    mavlink_sha256_update(&ctx, message.signature, kSignaturePrefixBytes);
+    mavlink_sha256_final_48(&ctx, hash);
 }
 
 }  // namespace
@@ -187,10 +189,10 @@ bool verifySignature(QByteArrayView key, const mavlink_message_t& message)
         return false;
     }
 
-    uchar hashBuf[kSigningKeySize];
-    _computeSignatureHash(key, message, hashBuf);
+    uint8_t hash[kSignatureHashBytes];
+    _computeSignatureHash(key, message, hash);
 
-    return memcmp(hashBuf, message.signature + kSignaturePrefixBytes, kSignatureHashBytes) == 0;
+    return memcmp(hash, message.signature + kSignaturePrefixBytes, kSignatureHashBytes) == 0;
 }
 
 void signMessage(QByteArrayView key, uint8_t linkId, uint64_t timestamp, mavlink_message_t& message)
@@ -206,9 +208,9 @@ void signMessage(QByteArrayView key, uint8_t linkId, uint64_t timestamp, mavlink
         message.signature[1 + i] = static_cast<uint8_t>((timestamp >> (8 * i)) & 0xFF);
     }
 
-    uchar hashBuf[kSigningKeySize];
-    _computeSignatureHash(key, message, hashBuf);
-    memcpy(message.signature + kSignaturePrefixBytes, hashBuf, kSignatureHashBytes);
+    uint8_t hash[kSignatureHashBytes];
+    _computeSignatureHash(key, message, hash);
+    memcpy(message.signature + kSignaturePrefixBytes, hash, kSignatureHashBytes);
 
     setMessageSigned(message, true);
 }
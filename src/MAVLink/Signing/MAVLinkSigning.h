@@ -74,6 +74,10 @@ void setMessageSigned(mavlink_message_t& message, bool isSigned);
 /// No-op for MAVLink1 (returns the original wire bytes; mavlink1 has no signature flag).
 QByteArray serializeUnsignedCopy(const mavlink_message_t& message);
 
+/// Allocation-free form of serializeUnsignedCopy() for hot paths. `buffer` must hold MAVLINK_MAX_PACKET_LEN bytes.
+/// Returns the number of bytes written.
+uint16_t serializeUnsignedCopy(const mavlink_message_t& message, uint8_t* buffer);
+
 /// Verify a key against a signed message's signature.
 bool verifySignature(QByteArrayView key, const mavlink_message_t& message);
 bool verifySignature(const SigningKey& key, const mavlink_message_t& message);
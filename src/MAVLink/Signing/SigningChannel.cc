@@ -33,7 +33,7 @@ bool SigningChannel::init(mavlink_channel_t channel, QByteArrayView key, mavlink
         _signing.accept_unsigned_callback = nullptr;
         _streams = {};
         _keyHint.clear();
-        _enabled = false;
+        _enabled.store(false, std::memory_order_release);
         return true;
     }
 
@@ -57,7 +57,7 @@ bool SigningChannel::init(mavlink_channel_t channel, QByteArrayView key, mavlink
 
     status->signing = &_signing;
     status->signing_streams = &_streams;
-    _enabled = true;
+    _enabled.store(true, std::memory_order_release);
     return true;
 }
 
@@ -125,8 +125,7 @@ bool SigningChannel::setSignOutgoing(bool signOutgoing)
 
 bool SigningChannel::isEnabled() const
 {
-    QReadLocker locker(&_lock);
-    return _enabled;
+    return _enabled.load(std::memory_order_acquire);
 }
 
 int SigningChannel::streamCount() const
@@ -189,15 +188,14 @@ MAVLinkSigning::DetectSnapshot SigningChannel::detectSnapshot() const
     return snap;
 }
 
-bool SigningChannel::consumeStatusTransition(mavlink_channel_t channel)
+bool SigningChannel::consumeStatusTransition()
 {
-    QWriteLocker locker(&_lock);
-    const mavlink_status_t* const status = mavlink_get_channel_status(channel);
+    // While enabled, status->signing points at _signing, so its last_status is the channel's.
     const mavlink_signing_status_t current =
-        (status && status->signing) ? status->signing->last_status : MAVLINK_SIGNING_STATUS_NONE;
-    if (current == _lastTransitionStatus) {
+        _enabled.load(std::memory_order_acquire) ? _signing.last_status : MAVLINK_SIGNING_STATUS_NONE;
+    if (current == _lastTransitionStatus.load(std::memory_order_relaxed)) {
         return false;
     }
-    _lastTransitionStatus = current;
+    _lastTransitionStatus.store(current, std::memory_order_relaxed);
     return true;
 }
@@ -81,7 +81,8 @@ class SigningChannel
     MAVLinkSigning::DetectSnapshot detectSnapshot() const;
 
     /// True if last_status changed since previous call; sole transition-detection source.
-    bool consumeStatusTransition(mavlink_channel_t channel);
+    /// Lock-free: call from the link-RX thread only, which is the thread libmavlink writes last_status on.
+    bool consumeStatusTransition();
 
 private:
     friend class SigningController;
@@ -93,10 +94,11 @@ class SigningChannel
     /// Per-link by design. ArduPilot/PX4 use a single global table; QGC must scope per link because USB+radio failover sees divergent timestamp histories per medium and a shared table causes OLD_TIMESTAMP rejections on the slower link.
     mavlink_signing_streams_t _streams{};
     QString _keyHint;
-    bool _enabled = false;
+    /// Written under _lock; atomic so isEnabled() on the per-frame path doesn't take it.
+    std::atomic<bool> _enabled{false};
     /// Hot path: lock-free read on every signed packet; co-observed reads use detectSnapshot.
     std::atomic<bool> _autoDetectSuspended{false};
     QDeadlineTimer _detectCooldown;  // default-constructed → expired (forever in the past)
-    mavlink_signing_status_t _lastTransitionStatus = MAVLINK_SIGNING_STATUS_NONE;
+    std::atomic<mavlink_signing_status_t> _lastTransitionStatus{MAVLINK_SIGNING_STATUS_NONE};
     mutable QReadWriteLock _lock;
 };
@@ -42,6 +42,7 @@ SigningController::~SigningController()
             QGC::secureZero(_op.keyBytes);
         }
         _op = PendingOp{};
+        _opPending.store(false, std::memory_order_release);
     }
 
     // Detach status->signing before _channel dies — otherwise the next parser call dangles.
@@ -51,6 +52,7 @@ SigningController::~SigningController()
 void SigningController::_setOpLocked(PendingOp next)
 {
     _op = std::move(next);
+    _opPending.store(_isPendingLocked(), std::memory_order_release);
     QMetaObject::invokeMethod(this, [this]() { emit stateChanged(); }, Qt::AutoConnection);
 }
 
@@ -214,7 +216,7 @@ std::optional<SigningFailure> SigningController::tryBeginDisable(uint8_t expecte
 
 bool SigningController::processFrame(bool framingOk, const mavlink_message_t& message)
 {
-    if (_channel.consumeStatusTransition(_mavlinkChannel)) {
+    if (_channel.consumeStatusTransition()) {
         QMetaObject::invokeMethod(this, [this]() { emit stateChanged(); }, Qt::AutoConnection);
     }
 
@@ -227,6 +229,7 @@ bool SigningController::processFrame(bool framingOk, const mavlink_message_t& me
             QMutexLocker<QRecursiveMutex> locker(&_fsmMutex);
             burstFired = _badSigBurst.record();
             burstCount = _badSigBurst.count();
+            _badSigBurstActive.store(true, std::memory_order_release);
             pendingEnable = (_op.kind == OpKind::Enable);
         }
         if (burstFired) {
@@ -244,9 +247,8 @@ bool SigningController::processFrame(bool framingOk, const mavlink_message_t& me
         return false;
     }
 
-    {
-        QMutexLocker<QRecursiveMutex> locker(&_fsmMutex);
-        _badSigBurst.reset();
+    if (_badSigBurstActive.load(std::memory_order_acquire)) {
+        resetBadSigBurst();
     }
 
     bool autoDetected = false;
@@ -260,7 +262,8 @@ bool SigningController::processFrame(bool framingOk, const mavlink_message_t& me
         }
     }
 
-    {
+    // A begin*() racing this check only misses the current frame; the vehicle's next heartbeat is seen.
+    if (_opPending.load(std::memory_order_acquire)) {
         QMutexLocker<QRecursiveMutex> locker(&_fsmMutex);
         _handleFsmFrameLocked(message);
     }
@@ -272,6 +275,7 @@ void SigningController::resetBadSigBurst()
 {
     QMutexLocker<QRecursiveMutex> locker(&_fsmMutex);
     _badSigBurst.reset();
+    _badSigBurstActive.store(false, std::memory_order_release);
 }
 
 void SigningController::_handleFsmFrameLocked(const mavlink_message_t& message)
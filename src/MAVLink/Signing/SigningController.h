@@ -4,6 +4,7 @@
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QTimer>
+#include <atomic>
 #include <chrono>
 #include <optional>
 
@@ -63,6 +64,7 @@ class SigningController : public QObject
     void clearDetectCooldown() { _channel.clearDetectCooldown(); }
 
     /// Per-frame entry point; drives burst alerts, auto-detect, and the FSM. Returns true on auto-detect.
+    /// A good frame with no bad-signature burst to clear and no pending operation takes no lock.
     bool processFrame(bool framingOk, const mavlink_message_t& message);
 
     void resetBadSigBurst();
@@ -119,6 +121,9 @@ class SigningController : public QObject
     /// because Qt::AutoConnection slots fired from the same thread may call state() and re-enter.
     mutable QRecursiveMutex _fsmMutex;
     PendingOp _op;
+    /// Lock-free mirrors for the processFrame fast path; written under _fsmMutex.
+    std::atomic<bool> _opPending{false};
+    std::atomic<bool> _badSigBurstActive{false};
     std::optional<QGC::AutoSuspendGuard> _autoDetectGuard;
     QTimer _timeout;
     /// 1Hz catch-up of `_signing.timestamp` to wall clock; libmavlink only bumps per-packet so idle
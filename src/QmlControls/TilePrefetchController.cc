@@ -0,0 +1,129 @@
+#include "TilePrefetchController.h"
+
+#include "Fact.h"
+#include "FactGroup.h"
+#include "FlightPathSegment.h"
+#include "MissionController.h"
+#include "QGCLoggingCategory.h"
+#include "QGCMapEngine.h"
+#include "QGCTilePrefetcher.h"
+#include "QmlObjectListModel.h"
+#include "Vehicle.h"
+
+QGC_LOGGING_CATEGORY(TilePrefetchControllerLog, "QMLControls.TilePrefetchController")
+
+TilePrefetchController::TilePrefetchController(QObject *parent)
+    : QObject(parent)
+{
+    qCDebug(TilePrefetchControllerLog) << this;
+}
+
+TilePrefetchController::~TilePrefetchController()
+{
+    QGCTilePrefetcher *const prefetcher = getQGCMapEngine()->prefetcher();
+    prefetcher->setMissionPath({});
+    prefetcher->clearVehicleTrack();
+
+    qCDebug(TilePrefetchControllerLog) << this;
+}
+
+void TilePrefetchController::setMissionController(MissionController *missionController)
+{
+    if (missionController == _missionController) {
+        return;
+    }
+
+    if (_missionController) {
+        (void) disconnect(_missionController, nullptr, this, nullptr);
+        (void) disconnect(_missionController->simpleFlightPathSegments(), nullptr, this, nullptr);
+    }
+
+    _missionController = missionController;
+
+    if (_missionController) {
+        (void) connect(_missionController, &MissionController::visualItemsReset, this, &TilePrefetchController::_updateMissionPath);
+        (void) connect(_missionController, &MissionController::missionPlannedDistanceChanged, this, &TilePrefetchController::_updateMissionPath);
+        (void) connect(_missionController->simpleFlightPathSegments(), &QmlObjectListModel::modelReset, this, &TilePrefetchController::_updateMissionPath);
+    }
+
+    emit missionControllerChanged();
+    _updateMissionPath();
+}
+
+void TilePrefetchController::setVehicle(Vehicle *vehicle)
+{
+    if (vehicle == _vehicle) {
+        return;
+    }
+
+    if (_vehicle) {
+        (void) disconnect(_vehicle, nullptr, this, nullptr);
+    }
+
+    _vehicle = vehicle;
+
+    if (_vehicle) {
+        (void) connect(_vehicle, &Vehicle::coordinateChanged, this, &TilePrefetchController::_updateVehicleTrack);
+    }
+
+    emit vehicleChanged();
+    _updateVehicleTrack();
+}
+
+void TilePrefetchController::setMapType(const QString &mapType)
+{
+    if (mapType == _mapType) {
+        return;
+    }
+
+    _mapType = mapType;
+    getQGCMapEngine()->prefetcher()->setMapType(_mapType);
+    emit mapTypeChanged();
+}
+
+void TilePrefetchController::setZoomLevel(double zoomLevel)
+{
+    if (qFuzzyCompare(zoomLevel, _zoomLevel)) {
+        return;
+    }
+
+    _zoomLevel = zoomLevel;
+    getQGCMapEngine()->prefetcher()->setZoomLevel(static_cast<int>(_zoomLevel));
+    emit zoomLevelChanged();
+}
+
+void TilePrefetchController::_updateMissionPath()
+{
+    QList<QGeoCoordinate> path;
+
+    if (_missionController) {
+        const QmlObjectListModel *const segments = _missionController->simpleFlightPathSegments();
+        for (int i = 0; i < segments->count(); i++) {
+            const FlightPathSegment *const segment = segments->value<const FlightPathSegment*>(i);
+            if (!segment) {
+                continue;
+            }
+            if (path.isEmpty() || (path.last() != segment->coordinate1())) {
+                path.append(segment->coordinate1());
+            }
+            path.append(segment->coordinate2());
+        }
+    }
+
+    qCDebug(TilePrefetchControllerLog) << "Mission path points:" << path.size();
+    getQGCMapEngine()->prefetcher()->setMissionPath(path);
+}
+
+void TilePrefetchController::_updateVehicleTrack()
+{
+    QGCTilePrefetcher *const prefetcher = getQGCMapEngine()->prefetcher();
+    if (!_vehicle) {
+        prefetcher->clearVehicleTrack();
+        return;
+    }
+
+    FactGroup *const vehicleFacts = _vehicle->vehicleFactGroup();
+    const double heading = vehicleFacts->getFact(QStringLiteral("heading"))->rawValue().toDouble();
+    const double groundSpeed = vehicleFacts->getFact(QStringLiteral("groundSpeed"))->rawValue().toDouble();
+    prefetcher->setVehicleTrack(_vehicle->coordinate(), heading, groundSpeed);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QString>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtQmlIntegration/QtQmlIntegration>
+
+class MissionController;
+class Vehicle;
+
+/// Feeds the map engine's tile prefetcher from a map view: the mission's flight path, the vehicle's position and
+/// velocity, and the map type and zoom being shown.
+class TilePrefetchController : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    Q_MOC_INCLUDE("MissionController.h")
+    Q_MOC_INCLUDE("Vehicle.h")
+    Q_PROPERTY(MissionController    *missionController  READ missionController  WRITE setMissionController  NOTIFY missionControllerChanged)
+    Q_PROPERTY(Vehicle              *vehicle            READ vehicle            WRITE setVehicle            NOTIFY vehicleChanged)
+    Q_PROPERTY(QString              mapType             READ mapType            WRITE setMapType            NOTIFY mapTypeChanged)
+    Q_PROPERTY(double               zoomLevel           READ zoomLevel          WRITE setZoomLevel          NOTIFY zoomLevelChanged)
+
+public:
+    explicit TilePrefetchController(QObject *parent = nullptr);
+    ~TilePrefetchController();
+
+    MissionController *missionController() const { return _missionController; }
+    Vehicle *vehicle() const { return _vehicle; }
+    QString mapType() const { return _mapType; }
+    double zoomLevel() const { return _zoomLevel; }
+
+    void setMissionController(MissionController *missionController);
+    void setVehicle(Vehicle *vehicle);
+    void setMapType(const QString &mapType);
+    void setZoomLevel(double zoomLevel);
+
+signals:
+    void missionControllerChanged();
+    void vehicleChanged();
+    void mapTypeChanged();
+    void zoomLevelChanged();
+
+private slots:
+    void _updateMissionPath();
+    void _updateVehicleTrack();
+
+private:
+    QPointer<MissionController> _missionController;
+    QPointer<Vehicle> _vehicle;
+    QString _mapType;
+    double _zoomLevel = 0.;
+};
@@ -55,6 +55,8 @@ class MapProvider
 
     virtual bool isElevationProvider() const { return false; }
     virtual bool isBingProvider() const { return false; }
+    /// Tiles come only from local tile archives, never from the network
+    virtual bool isArchiveProvider() const { return false; }
 
     virtual QGCTileSet getTileCount(int zoom, double topleftLon,
                                     double topleftLat, double bottomRightLon,
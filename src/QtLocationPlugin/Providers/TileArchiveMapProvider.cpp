@@ -0,0 +1,493 @@
+#include "TileArchiveMapProvider.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QtEndian>
+#include <QtSql/QSqlQuery>
+
+#include "QGCCompression.h"
+#include "QGCLoggingCategory.h"
+#include "QGCMapUrlEngine.h"
+#include "QGCSqlHelper.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+QGC_LOGGING_CATEGORY(TileArchiveLog, "QtLocationPlugin.TileArchive")
+
+namespace {
+
+QString normalizedFormat(const QString &format)
+{
+    const QString lower = format.trimmed().toLower();
+    if ((lower == QStringLiteral("jpg")) || (lower == QStringLiteral("jpeg"))) {
+        return QStringLiteral("jpg");
+    }
+    if ((lower == QStringLiteral("png")) || (lower == QStringLiteral("webp"))) {
+        return lower;
+    }
+
+    return QString();
+}
+
+bool validTile(int x, int y, int zoom)
+{
+    if ((zoom < 0) || (zoom > QGC_MAX_MAP_ZOOM)) {
+        return false;
+    }
+
+    const int count = 1 << zoom;
+    return ((x >= 0) && (x < count) && (y >= 0) && (y < count));
+}
+
+struct ArchiveSource
+{
+    std::unique_ptr<TileArchive> archive;
+    QString type;   ///< Map type whose tiles it serves
+};
+
+/// Never emptied: tiles handed out by a PMTiles archive point into its mapping
+std::vector<ArchiveSource> &archiveSources()
+{
+    static std::vector<ArchiveSource> sources;
+    return sources;
+}
+
+} // namespace
+
+/*===========================================================================*/
+
+std::unique_ptr<TileArchive> TileArchive::open(const QString &path)
+{
+    const QString suffix = QFileInfo(path).suffix().toLower();
+    if (suffix == QStringLiteral("pmtiles")) {
+        return PMTilesArchive::open(path);
+    }
+    if (suffix == QStringLiteral("mbtiles")) {
+        return MBTilesArchive::open(path);
+    }
+
+    qCWarning(TileArchiveLog) << "Unknown tile archive type:" << path;
+    return nullptr;
+}
+
+/*===========================================================================*/
+
+MBTilesArchive::MBTilesArchive(const QString &path)
+    : TileArchive(path)
+{
+}
+
+MBTilesArchive::~MBTilesArchive() = default;
+
+std::unique_ptr<MBTilesArchive> MBTilesArchive::open(const QString &path)
+{
+    std::unique_ptr<MBTilesArchive> archive(new MBTilesArchive(path));
+    if (!archive->_load()) {
+        return nullptr;
+    }
+
+    return archive;
+}
+
+bool MBTilesArchive::_load()
+{
+    if (!QFileInfo::exists(_path)) {
+        qCWarning(TileArchiveLog) << "No such file:" << _path;
+        return false;
+    }
+
+    _connection = std::make_unique<QGCSqlHelper::ScopedConnection>(_path, true, QStringLiteral("QGCMBTiles"));
+    if (!_connection->isValid()) {
+        qCWarning(TileArchiveLog) << "Failed to open" << _path;
+        return false;
+    }
+
+    QSqlDatabase db = _connection->database();
+    QSqlQuery query(db);
+
+    // Let SQLite page the whole file in from a mapping instead of reading it through its own cache
+    (void) query.exec(QStringLiteral("PRAGMA mmap_size = %1").arg(QFileInfo(_path).size()));
+
+    if (!query.exec(QStringLiteral("SELECT name, value FROM metadata"))) {
+        qCWarning(TileArchiveLog) << "No metadata in" << _path;
+        return false;
+    }
+
+    QString format;
+    while (query.next()) {
+        const QString key = query.value(0).toString();
+        const QString value = query.value(1).toString();
+        if (key == QStringLiteral("name")) {
+            _name = value;
+        } else if (key == QStringLiteral("format")) {
+            format = value;
+        } else if (key == QStringLiteral("minzoom")) {
+            _minZoom = value.toInt();
+        } else if (key == QStringLiteral("maxzoom")) {
+            _maxZoom = value.toInt();
+        }
+    }
+
+    _format = normalizedFormat(format);
+    if (_format.isEmpty()) {
+        qCWarning(TileArchiveLog) << "Unsupported tile format" << format << "in" << _path;
+        return false;
+    }
+
+    _tileQuery = std::make_unique<QSqlQuery>(db);
+    _tileQuery->setForwardOnly(true);
+    if (!_tileQuery->prepare(QStringLiteral("SELECT tile_data FROM tiles WHERE zoom_level = ? AND tile_column = ? AND tile_row = ?"))) {
+        qCWarning(TileArchiveLog) << "No tiles table in" << _path;
+        return false;
+    }
+
+    qCDebug(TileArchiveLog) << "Opened" << _path << _name << _format << _minZoom << _maxZoom;
+    return true;
+}
+
+QByteArray MBTilesArchive::tile(int x, int y, int zoom) const
+{
+    if (!validTile(x, y, zoom) || (zoom < _minZoom) || (zoom > _maxZoom)) {
+        return QByteArray();
+    }
+
+    // MBTiles rows count up from the south (TMS)
+    const int row = (1 << zoom) - 1 - y;
+    _tileQuery->bindValue(0, zoom);
+    _tileQuery->bindValue(1, x);
+    _tileQuery->bindValue(2, row);
+
+    QByteArray result;
+    if (_tileQuery->exec() && _tileQuery->next()) {
+        result = _tileQuery->value(0).toByteArray();
+    }
+    _tileQuery->finish();
+
+    return result;
+}
+
+/*===========================================================================*/
+
+PMTilesArchive::PMTilesArchive(const QString &path)
+    : TileArchive(path)
+    , _file(path)
+{
+}
+
+PMTilesArchive::~PMTilesArchive()
+{
+    if (_data) {
+        (void) _file.unmap(const_cast<uchar*>(_data));
+    }
+}
+
+std::unique_ptr<PMTilesArchive> PMTilesArchive::open(const QString &path)
+{
+    std::unique_ptr<PMTilesArchive> archive(new PMTilesArchive(path));
+    if (!archive->_load()) {
+        return nullptr;
+    }
+
+    return archive;
+}
+
+quint64 PMTilesArchive::tileId(int x, int y, int zoom)
+{
+    const quint64 n = quint64(1) << zoom;
+    const quint64 lowerZoomTiles = ((quint64(1) << (2 * zoom)) - 1) / 3;
+
+    quint64 tx = static_cast<quint64>(x);
+    quint64 ty = static_cast<quint64>(y);
+    quint64 d = 0;
+    for (quint64 s = n / 2; s > 0; s /= 2) {
+        const quint64 rx = (tx & s) ? 1 : 0;
+        const quint64 ry = (ty & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                tx = n - 1 - tx;
+                ty = n - 1 - ty;
+            }
+            std::swap(tx, ty);
+        }
+    }
+
+    return lowerZoomTiles + d;
+}
+
+bool PMTilesArchive::_load()
+{
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(TileArchiveLog) << "Failed to open" << _path << _file.errorString();
+        return false;
+    }
+
+    _size = static_cast<quint64>(_file.size());
+    if (_size < kHeaderSize) {
+        qCWarning(TileArchiveLog) << "Too short for a PMTiles archive:" << _path;
+        return false;
+    }
+
+    _data = _file.map(0, _file.size());
+    if (!_data) {
+        qCWarning(TileArchiveLog) << "Failed to map" << _path << _file.errorString();
+        return false;
+    }
+
+    if ((std::memcmp(_data, "PMTiles", 7) != 0) || (_data[7] != 3)) {
+        qCWarning(TileArchiveLog) << "Not a PMTiles v3 archive:" << _path;
+        return false;
+    }
+
+    const auto u64 = [this](int offset) { return qFromLittleEndian<quint64>(_data + offset); };
+    const quint64 rootOffset = u64(8);
+    const quint64 rootLength = u64(16);
+    const quint64 metadataOffset = u64(24);
+    const quint64 metadataLength = u64(32);
+    _leafOffset = u64(40);
+    const quint64 leafLength = u64(48);
+    _tileDataOffset = u64(56);
+    _tileDataLength = u64(64);
+    _internalCompression = _data[97];
+    const quint8 tileCompression = _data[98];
+    const quint8 tileType = _data[99];
+    _minZoom = _data[100];
+    _maxZoom = qMin<int>(_data[101], QGC_MAX_MAP_ZOOM);
+
+    if (!_inFile(rootOffset, rootLength) || !_inFile(metadataOffset, metadataLength) ||
+        !_inFile(_leafOffset, leafLength) || !_inFile(_tileDataOffset, _tileDataLength)) {
+        qCWarning(TileArchiveLog) << "Sections run past the end of" << _path;
+        return false;
+    }
+
+    // 0 unknown, 1 none, 2 gzip. Tiles are handed to the map as they are stored, so they must not be compressed.
+    if ((_internalCompression > 2) || (tileCompression > 1)) {
+        qCWarning(TileArchiveLog) << "Unsupported compression" << _internalCompression << tileCompression << "in" << _path;
+        return false;
+    }
+
+    switch (tileType) {
+    case 2:
+        _format = QStringLiteral("png");
+        break;
+    case 3:
+        _format = QStringLiteral("jpg");
+        break;
+    case 4:
+        _format = QStringLiteral("webp");
+        break;
+    default:
+        qCWarning(TileArchiveLog) << "Unsupported tile type" << tileType << "in" << _path;
+        return false;
+    }
+
+    if (metadataLength > 0) {
+        const QJsonDocument metadata = QJsonDocument::fromJson(_internalData(metadataOffset, metadataLength));
+        _name = metadata.object().value(QStringLiteral("name")).toString();
+    }
+
+    if (!_readDirectory(rootOffset, rootLength, 0)) {
+        qCWarning(TileArchiveLog) << "Corrupt directory in" << _path;
+        _entries.clear();
+        return false;
+    }
+
+    std::sort(_entries.begin(), _entries.end(), [](const Entry &a, const Entry &b) { return a.tileId < b.tileId; });
+    _entries.squeeze();
+
+    qCDebug(TileArchiveLog) << "Opened" << _path << _name << _format << _minZoom << _maxZoom << _entries.size() << "entries";
+    return true;
+}
+
+bool PMTilesArchive::_readDirectory(quint64 offset, quint64 length, int depth)
+{
+    const QByteArray directory = _internalData(offset, length);
+    const auto *pos = reinterpret_cast<const uchar*>(directory.constData());
+    const auto *const end = pos + directory.size();
+
+    const auto readVarint = [&pos, end](quint64 &value) {
+        value = 0;
+        for (int shift = 0; (pos < end) && (shift < 64); shift += 7) {
+            const uchar byte = *pos++;
+            value |= static_cast<quint64>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    quint64 count = 0;
+    // Every entry takes at least one byte in each of its four columns
+    if (!readVarint(count) || (count > static_cast<quint64>(end - pos))) {
+        return false;
+    }
+
+    QList<Entry> entries(static_cast<qsizetype>(count));
+    quint64 value = 0;
+    quint64 lastId = 0;
+    for (Entry &entry : entries) {
+        if (!readVarint(value)) {
+            return false;
+        }
+        lastId += value;
+        entry.tileId = lastId;
+    }
+    for (Entry &entry : entries) {
+        if (!readVarint(value) || (value > std::numeric_limits<quint32>::max())) {
+            return false;
+        }
+        entry.runLength = static_cast<quint32>(value);
+    }
+    for (Entry &entry : entries) {
+        if (!readVarint(value) || (value > std::numeric_limits<quint32>::max())) {
+            return false;
+        }
+        entry.length = static_cast<quint32>(value);
+    }
+    for (qsizetype i = 0; i < entries.size(); i++) {
+        if (!readVarint(value)) {
+            return false;
+        }
+        // 0 means "right after the previous entry"
+        if (value == 0) {
+            if (i == 0) {
+                return false;
+            }
+            entries[i].offset = entries[i - 1].offset + entries[i - 1].length;
+        } else {
+            entries[i].offset = value - 1;
+        }
+    }
+
+    for (const Entry &entry : std::as_const(entries)) {
+        if (entry.runLength == 0) {
+            if ((depth >= kMaxDirectoryDepth) || !_inFile(_leafOffset + entry.offset, entry.length) ||
+                !_readDirectory(_leafOffset + entry.offset, entry.length, depth + 1)) {
+                return false;
+            }
+        } else {
+            if ((entry.offset > _tileDataLength) || (entry.length > (_tileDataLength - entry.offset))) {
+                return false;
+            }
+            _entries.append(entry);
+        }
+    }
+
+    return true;
+}
+
+QByteArray PMTilesArchive::_internalData(quint64 offset, quint64 length) const
+{
+    if ((length == 0) || !_inFile(offset, length)) {
+        return QByteArray();
+    }
+
+    const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char*>(_data + offset), static_cast<qsizetype>(length));
+    if (_internalCompression == 2) {
+        return QGCCompression::decompressData(raw, QGCCompression::Format::GZIP);
+    }
+
+    return raw;
+}
+
+QByteArray PMTilesArchive::tile(int x, int y, int zoom) const
+{
+    if (!validTile(x, y, zoom) || (zoom < _minZoom) || (zoom > _maxZoom)) {
+        return QByteArray();
+    }
+
+    const quint64 id = tileId(x, y, zoom);
+    auto it = std::upper_bound(_entries.cbegin(), _entries.cend(), id, [](quint64 value, const Entry &entry) {
+        return value < entry.tileId;
+    });
+    if (it == _entries.cbegin()) {
+        return QByteArray();
+    }
+    --it;
+    if ((id - it->tileId) >= it->runLength) {
+        return QByteArray();
+    }
+
+    // No copy: the bytes stay in the mapping, which lives as long as the process
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(_data + _tileDataOffset + it->offset), it->length);
+}
+
+/*===========================================================================*/
+
+QString TileArchiveMapProvider::_getURL(int x, int y, int zoom) const
+{
+    // Never fetched; a non-empty URL keeps the tile fetcher from dropping the request before the archives are asked
+    return QStringLiteral("qgc-archive:///%1/%2/%3").arg(zoom).arg(x).arg(y);
+}
+
+int TileArchiveMapProvider::loadArchives(const QString &directory)
+{
+    if (directory.isEmpty()) {
+        return 0;
+    }
+
+    const QDir dir(directory);
+    const QFileInfoList files = dir.entryInfoList({QStringLiteral("*.mbtiles"), QStringLiteral("*.pmtiles")}, QDir::Files, QDir::Name);
+
+    int added = 0;
+    for (const QFileInfo &file : files) {
+        const QString path = file.canonicalFilePath();
+        const std::vector<ArchiveSource> &sources = archiveSources();
+        const bool loaded = std::any_of(sources.cbegin(), sources.cend(), [&path](const ArchiveSource &source) {
+            return (source.archive->path() == path);
+        });
+        if (loaded) {
+            continue;
+        }
+
+        std::unique_ptr<TileArchive> archive = TileArchive::open(path);
+        if (archive) {
+            addArchive(std::move(archive));
+            added++;
+        }
+    }
+
+    return added;
+}
+
+void TileArchiveMapProvider::addArchive(std::unique_ptr<TileArchive> archive)
+{
+    if (!archive) {
+        return;
+    }
+
+    const SharedMapProvider mapProvider = UrlFactory::getMapProviderFromProviderType(archive->name());
+    const bool underLiveCache = mapProvider && !mapProvider->isArchiveProvider() && !mapProvider->isElevationProvider();
+    const QString type = underLiveCache ? archive->name() : QString(kProviderKey);
+
+    qCDebug(TileArchiveLog) << "Serving" << archive->path() << "as" << type;
+    archiveSources().push_back({std::move(archive), type});
+}
+
+qsizetype TileArchiveMapProvider::archiveCount()
+{
+    return static_cast<qsizetype>(archiveSources().size());
+}
+
+QByteArray TileArchiveMapProvider::archivedTile(QStringView type, int x, int y, int zoom, QString &format)
+{
+    for (const ArchiveSource &source : archiveSources()) {
+        if (source.type != type) {
+            continue;
+        }
+
+        const QByteArray tile = source.archive->tile(x, y, zoom);
+        if (!tile.isEmpty()) {
+            format = source.archive->format();
+            return tile;
+        }
+    }
+
+    return QByteArray();
+}
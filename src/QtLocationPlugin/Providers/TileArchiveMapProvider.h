@@ -0,0 +1,146 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+#include <memory>
+
+#include "MapProvider.h"
+
+class QSqlQuery;
+namespace QGCSqlHelper {
+class ScopedConnection;
+}
+
+/// A read-only file of pre-rendered raster tiles. Archives are opened once and stay open until exit, so the bytes
+/// they hand out can be kept by the map's own caches.
+class TileArchive
+{
+public:
+    virtual ~TileArchive() = default;
+
+    /// Opens an MBTiles (.mbtiles) or PMTiles (.pmtiles) file; nullptr if it is neither or cannot be used
+    static std::unique_ptr<TileArchive> open(const QString &path);
+
+    /// Tile @p x, @p y (XYZ scheme) at @p zoom, or an empty array if the archive does not have it
+    virtual QByteArray tile(int x, int y, int zoom) const = 0;
+
+    const QString &path() const { return _path; }
+    /// From the archive's metadata
+    const QString &name() const { return _name; }
+    /// png, jpg or webp
+    const QString &format() const { return _format; }
+    int minZoom() const { return _minZoom; }
+    int maxZoom() const { return _maxZoom; }
+
+protected:
+    explicit TileArchive(const QString &path)
+        : _path(path) {}
+
+    const QString _path;
+    QString _name;
+    QString _format;
+    int _minZoom = 0;
+    int _maxZoom = QGC_MAX_MAP_ZOOM;
+};
+
+/// \brief https://github.com/mapbox/mbtiles-spec
+///
+/// An SQLite database of TMS-addressed tiles, read through SQLite's memory-mapped I/O. Each tile is copied once out
+/// of the page holding it. Only usable from the thread that opened it.
+class MBTilesArchive final : public TileArchive
+{
+public:
+    ~MBTilesArchive() final;
+
+    static std::unique_ptr<MBTilesArchive> open(const QString &path);
+
+    QByteArray tile(int x, int y, int zoom) const final;
+
+private:
+    explicit MBTilesArchive(const QString &path);
+    bool _load();
+
+    std::unique_ptr<QGCSqlHelper::ScopedConnection> _connection;
+    std::unique_ptr<QSqlQuery> _tileQuery;  ///< Destroyed before the connection
+};
+
+/// \brief https://github.com/protomaps/PMTiles/blob/main/spec/v3/spec.md
+///
+/// One file of tiles ordered along a Hilbert curve behind a directory. The file is memory-mapped whole and the
+/// directory, leaves included, is decoded once on open; tiles are handed out as views into the mapping.
+class PMTilesArchive final : public TileArchive
+{
+public:
+    ~PMTilesArchive() final;
+
+    static std::unique_ptr<PMTilesArchive> open(const QString &path);
+
+    QByteArray tile(int x, int y, int zoom) const final;
+
+    /// Position of a tile on the archive's Hilbert curve, counting every tile of the lower zoom levels first
+    static quint64 tileId(int x, int y, int zoom);
+
+    static constexpr int kHeaderSize = 127;
+
+private:
+    struct Entry
+    {
+        quint64 tileId = 0;
+        quint64 offset = 0;
+        quint32 length = 0;
+        quint32 runLength = 0;  ///< Consecutive tile ids sharing these bytes; 0 for a leaf directory
+    };
+
+    explicit PMTilesArchive(const QString &path);
+    bool _load();
+    bool _readDirectory(quint64 offset, quint64 length, int depth);
+    /// Directory or metadata bytes, decompressed when the archive compresses them
+    QByteArray _internalData(quint64 offset, quint64 length) const;
+    bool _inFile(quint64 offset, quint64 length) const { return (offset <= _size) && (length <= (_size - offset)); }
+
+    QFile _file;
+    const uchar *_data = nullptr;
+    quint64 _size = 0;
+    quint64 _leafOffset = 0;
+    quint64 _tileDataOffset = 0;
+    quint64 _tileDataLength = 0;
+    quint8 _internalCompression = 0;
+    QList<Entry> _entries;  ///< Tile runs of every directory, sorted by tile id
+
+    static constexpr int kMaxDirectoryDepth = 4;
+};
+
+/// Map type drawn only from the tile archives in the TileArchives folder. An archive whose metadata names another
+/// map type instead sits under that type's live cache: a tile missing from the cache is looked up in the archives
+/// before it is downloaded.
+class TileArchiveMapProvider : public MapProvider
+{
+public:
+    TileArchiveMapProvider()
+        : MapProvider(
+            kProviderKey,
+            QString(),
+            QStringLiteral("png"),
+            QGC_AVERAGE_TILE_SIZE,
+            MapProvider::StreetMap) {}
+
+    bool isArchiveProvider() const final { return true; }
+
+    /// Opens the archives in @p directory that are not open yet, in file name order. Returns how many were added.
+    /// Must be called from the thread the map runs on.
+    static int loadArchives(const QString &directory);
+    static void addArchive(std::unique_ptr<TileArchive> archive);
+    static qsizetype archiveCount();
+
+    /// The tile from the first archive serving @p type that has it, or an empty array. @p format receives its
+    /// image format.
+    static QByteArray archivedTile(QStringView type, int x, int y, int zoom, QString &format);
+
+    static constexpr const char *kProviderKey = "Offline Basemap";
+
+private:
+    QString _getURL(int x, int y, int zoom) const final;
+};
@@ -6,20 +6,20 @@
 
 struct QGCCacheTile
 {
-    QGCCacheTile(const QString &hash_, const QByteArray &img_, const QString &format_, const QString &type_, quint64 tileSet_ = UINT64_MAX)
+    QGCCacheTile(quint64 key_, const QByteArray &img_, const QString &format_, const QString &type_, quint64 tileSet_ = UINT64_MAX)
         : tileSet(tileSet_)
-        , hash(hash_)
+        , key(key_)
         , img(img_)
         , format(format_)
         , type(type_)
     {}
-    QGCCacheTile(const QString &hash_, quint64 tileSet_)
+    QGCCacheTile(quint64 key_, quint64 tileSet_)
         : tileSet(tileSet_)
-        , hash(hash_)
+        , key(key_)
     {}
 
     quint64 tileSet;
-    QString hash;
+    quint64 key;
     QByteArray img;
     QString format;
     QString type;
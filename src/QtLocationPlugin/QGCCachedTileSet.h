@@ -1,15 +1,11 @@
 #pragma once
 
 #include <QtCore/QDateTime>
-#include <QtCore/QHash>
-#include <QtCore/QMutex>
 #include <QtCore/QObject>
-#include <QtCore/QQueue>
 #include <QtCore/QString>
-#include <QtNetwork/QNetworkReply>
 
-struct QGCTile;
 class QGCMapEngineManager;
+class QGCTileDownloadPipeline;
 class QNetworkAccessManager;
 
 class QGCCachedTileSet : public QObject
@@ -133,13 +129,11 @@ class QGCCachedTileSet : public QObject
     void nameChanged();
 
 private slots:
-    void _tileListFetched(const QQueue<QGCTile*> &tiles);
-    void _networkReplyFinished();
-    void _networkReplyError(QNetworkReply::NetworkError error);
+    void _tilesStored(quint32 count, quint64 bytes);
+    void _tilesFailed(quint32 count);
+    void _doneWithDownload(bool cancelled);
 
 private:
-    void _prepareDownload();
-    void _doneWithDownload();
 
     QString _name;
     QString _mapTypeStr;
@@ -161,17 +155,10 @@ private slots:
     bool _defaultSet = false;
     bool _deleting = false;
     bool _downloading = false;
-    bool _noMoreTiles = false;
-    bool _batchRequested = false;
     bool _selected = false;
-    bool _cancelPending = false;
     QDateTime _creationDate;
 
-    QHash<QString, QNetworkReply*> _replies;
-    QMutex _repliesMutex;
-    QQueue<QGCTile*> _tilesToDownload;
     QGCMapEngineManager *_manager = nullptr;
     QNetworkAccessManager *_networkManager = nullptr;
-
-    static constexpr uint32_t kTileBatchSize = 256;
+    QGCTileDownloadPipeline *_pipeline = nullptr;
 };
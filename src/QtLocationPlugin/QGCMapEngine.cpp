@@ -2,14 +2,18 @@
 
 #include <QtCore/QApplicationStatic>
 
+#include "AppSettings.h"
 #include "QGCCachedTileSet.h"
 #include "QGCCacheTile.h"
 #include "QGCLoggingCategory.h"
 #include "QGCMapTasks.h"
 #include "QGCTile.h"
 #include "QGCTileCacheWorker.h"
+#include "QGCTilePrefetcher.h"
 #include "QGCTileSet.h"
 #include "QGeoFileTileCacheQGC.h"
+#include "SettingsManager.h"
+#include "TileArchiveMapProvider.h"
 
 QGC_LOGGING_CATEGORY(QGCMapEngineLog, "QtLocationPlugin.QGCMapEngine")
 
@@ -22,6 +26,7 @@ QGCMapEngine *getQGCMapEngine()
 
 QGCMapEngine::QGCMapEngine(QObject *parent)
     : QObject(parent)
+    , m_prefetcher(new QGCTilePrefetcher(this))
 {
     qCDebug(QGCMapEngineLog) << this;
 
@@ -63,6 +68,9 @@ void QGCMapEngine::init(const QString &databasePath)
     m_worker->setDatabaseFile(databasePath);
     (void) connect(m_worker, &QGCCacheWorker::updateTotals, this, &QGCMapEngine::_updateTotals);
 
+    _loadTileArchives();
+    (void) connect(SettingsManager::instance()->appSettings(), &AppSettings::savePathsChanged, this, &QGCMapEngine::_loadTileArchives);
+
     QGCMapTask *task = new QGCMapTask(QGCMapTask::TaskType::taskInit);
     if (!addTask(task)) {
         task->deleteLater();
@@ -80,6 +88,14 @@ bool QGCMapEngine::addTask(QGCMapTask *task)
     return result;
 }
 
+void QGCMapEngine::_loadTileArchives()
+{
+    const int added = TileArchiveMapProvider::loadArchives(SettingsManager::instance()->appSettings()->tileArchiveSavePath());
+    if (added > 0) {
+        qCDebug(QGCMapEngineLog) << "Loaded" << added << "tile archives";
+    }
+}
+
 void QGCMapEngine::_updateTotals(quint32 totaltiles, quint64 totalsize, quint32 defaulttiles, quint64 defaultsize)
 {
     emit updateTotals(totaltiles, totalsize, defaulttiles, defaultsize);
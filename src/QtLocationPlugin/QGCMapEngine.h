@@ -5,6 +5,7 @@
 
 class QGCMapTask;
 class QGCCacheWorker;
+class QGCTilePrefetcher;
 
 class QGCMapEngine : public QObject
 {
@@ -16,6 +17,7 @@ class QGCMapEngine : public QObject
 
     void init(const QString &databasePath);
     bool addTask(QGCMapTask *task);
+    QGCTilePrefetcher *prefetcher() const { return m_prefetcher; }
 
     static QGCMapEngine *instance();
 
@@ -25,9 +27,11 @@ class QGCMapEngine : public QObject
 private slots:
     void _updateTotals(quint32 totaltiles, quint64 totalsize, quint32 defaulttiles, quint64 defaultsize);
     void _pruned() { m_pruning = false; }
+    void _loadTileArchives();
 
 private:
     QGCCacheWorker *m_worker = nullptr;
+    QGCTilePrefetcher *m_prefetcher = nullptr;
     bool m_pruning = false;
     std::atomic<bool> m_initialized = false;
 };
@@ -19,6 +19,7 @@
 #include "QGCMapEngine.h"
 #include "QGCMapTasks.h"
 #include "QGCMapUrlEngine.h"
+#include "QGCTilePrefetcher.h"
 #include "QGeoFileTileCacheQGC.h"
 #include "QmlObjectListModel.h"
 #include "SettingsManager.h"
@@ -91,6 +92,11 @@ QString QGCMapEngineManager::tileSizeStr() const
     return QGC::bigSizeToString(_imageSet.tileSize + _elevationSet.tileSize);
 }
 
+QGCTilePrefetcher *QGCMapEngineManager::tilePrefetcher() const
+{
+    return getQGCMapEngine()->prefetcher();
+}
+
 void QGCMapEngineManager::loadTileSets()
 {
     if (_tileSets->count() > 0) {
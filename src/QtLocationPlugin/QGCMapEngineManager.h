@@ -7,6 +7,7 @@
 
 class QGCCachedTileSet;
 class QGCCompressionJob;
+class QGCTilePrefetcher;
 class QmlObjectListModel;
 
 class QGCMapEngineManager : public QObject
@@ -16,6 +17,7 @@ class QGCMapEngineManager : public QObject
     // QML_UNCREATABLE("")
     Q_MOC_INCLUDE("QmlObjectListModel.h")
     Q_MOC_INCLUDE("QGCCachedTileSet.h")
+    Q_MOC_INCLUDE("QGCTilePrefetcher.h")
     Q_PROPERTY(bool                 fetchElevation  MEMBER _fetchElevation                          NOTIFY fetchElevationChanged)
     Q_PROPERTY(bool                 importReplace   MEMBER _importReplace                           NOTIFY importReplaceChanged)
     Q_PROPERTY(ImportAction         importAction    READ importAction       WRITE setImportAction   NOTIFY importActionChanged)
@@ -30,6 +32,7 @@ class QGCMapEngineManager : public QObject
     Q_PROPERTY(QStringList          elevationProviderList   READ elevationProviderList              CONSTANT)
     Q_PROPERTY(quint64              tileCount       READ tileCount                                  NOTIFY tileCountChanged)
     Q_PROPERTY(quint64              tileSize        READ tileSize                                   NOTIFY tileSizeChanged)
+    Q_PROPERTY(QGCTilePrefetcher    *tilePrefetcher READ tilePrefetcher                             CONSTANT)
 
 public:
     explicit QGCMapEngineManager(QObject *parent = nullptr);
@@ -76,6 +79,7 @@ class QGCMapEngineManager : public QObject
     QString tileSizeStr() const;
     quint64 tileCount() const { return (_imageSet.tileCount + _elevationSet.tileCount); }
     quint64 tileSize() const { return (_imageSet.tileSize + _elevationSet.tileSize); }
+    QGCTilePrefetcher *tilePrefetcher() const;
 
     void setActionProgress(int percentage) { if (percentage != _actionProgress) { _actionProgress = percentage; emit actionProgressChanged(); } }
     void setErrorMessage(const QString &error) { if (error != _errorMessage) { _errorMessage = error; emit errorMessageChanged(); } }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QtCore/QList>
 #include <QtCore/QObject>
 #include <QtCore/QQueue>
 #include <QtCore/QString>
@@ -7,6 +8,7 @@
 #include "QGCMapTaskBase.h"
 #include "QGCTileCacheTypes.h"
 #include "QGCTile.h"
+#include "QGCTileKey.h"
 
 struct QGCCacheTile;
 class QGCCachedTileSet;
@@ -69,9 +71,11 @@ class QGCFetchTileTask : public QGCMapTask
     Q_OBJECT
 
 public:
-    explicit QGCFetchTileTask(const QString &hash, QObject *parent = nullptr)
+    /// @param lowPriority served only while no lookup for the visible map is waiting, e.g. for prefetching
+    explicit QGCFetchTileTask(quint64 key, bool lowPriority = false, QObject *parent = nullptr)
         : QGCMapTask(TaskType::taskFetchTile, parent)
-        , m_hash(hash)
+        , m_key(key)
+        , m_lowPriority(lowPriority)
     {}
     ~QGCFetchTileTask() = default;
 
@@ -80,13 +84,15 @@ class QGCFetchTileTask : public QGCMapTask
         emit tileFetched(tile);
     }
 
-    QString hash() const { return m_hash; }
+    quint64 key() const { return m_key; }
+    bool lowPriority() const { return m_lowPriority; }
 
 signals:
     void tileFetched(QGCCacheTile *tile);
 
 private:
-    const QString m_hash;
+    const quint64 m_key = 0;
+    const bool m_lowPriority = false;
 };
 
 //-----------------------------------------------------------------------------
@@ -146,22 +152,28 @@ class QGCUpdateTileDownloadStateTask : public QGCMapTask
     Q_OBJECT
 
 public:
-    QGCUpdateTileDownloadStateTask(quint64 setID, QGCTile::TileState state, const QString &hash, QObject *parent = nullptr)
+    /// @param key the tile's key, or QGCTileKey::kAllTiles for every tile of the set
+    QGCUpdateTileDownloadStateTask(quint64 setID, QGCTile::TileState state, quint64 key, QObject *parent = nullptr)
+        : QGCUpdateTileDownloadStateTask(setID, state, QList<quint64>{key}, parent)
+    {}
+    /// Updates every tile in @p keys in one transaction
+    QGCUpdateTileDownloadStateTask(quint64 setID, QGCTile::TileState state, const QList<quint64> &keys, QObject *parent = nullptr)
         : QGCMapTask(TaskType::taskUpdateTileDownloadState, parent)
         , m_setID(setID)
         , m_state(state)
-        , m_hash(hash)
+        , m_keys(keys)
     {}
     ~QGCUpdateTileDownloadStateTask() = default;
 
-    QString hash() const { return m_hash; }
+    const QList<quint64> &keys() const { return m_keys; }
+    bool allTiles() const { return ((m_keys.size() == 1) && (m_keys.first() == QGCTileKey::kAllTiles)); }
     quint64 setID() const { return m_setID; }
     QGCTile::TileState state() const { return m_state; }
 
 private:
     const quint64 m_setID = 0;
     const QGCTile::TileState m_state = QGCTile::StatePending;
-    const QString m_hash;
+    const QList<quint64> m_keys;
 };
 
 //-----------------------------------------------------------------------------
@@ -1,5 +1,6 @@
 #include "QGCMapUrlEngine.h"
 
+#include "QGCTileKey.h"
 #include "QGCTileSet.h"
 
 #include <QtCore/QtMinMax>
@@ -12,6 +13,7 @@
 #include "GoogleMapProvider.h"
 #include "MapboxMapProvider.h"
 #include "TianDiTuProvider.h"
+#include "TileArchiveMapProvider.h"
 #include "QGCLoggingCategory.h"
 
 QGC_LOGGING_CATEGORY(QGCMapUrlEngineLog, "QtLocationPlugin.QGCMapUrlEngine")
@@ -70,7 +72,10 @@ const QList<SharedMapProvider> UrlFactory::_providers = {
 
     std::make_shared<CustomURLMapProvider>(),
 
-    std::make_shared<CopernicusElevationProvider>()
+    std::make_shared<CopernicusElevationProvider>(),
+
+    // Map ids follow construction order and are stored with every cached tile; new providers go last
+    std::make_shared<TileArchiveMapProvider>()
 };
 
 QString UrlFactory::getImageFormat(int qtMapId, QByteArrayView image)
@@ -276,14 +281,13 @@ int UrlFactory::hashFromProviderType(QStringView type)
     return -1;
 }
 
-QString UrlFactory::tileHashToType(QStringView tileHash)
+QString UrlFactory::tileKeyToType(quint64 tileKey)
 {
-    const int providerHash = tileHash.mid(0,10).toInt();
-    return providerTypeFromHash(providerHash);
+    return providerTypeFromHash(QGCTileKey::providerId(tileKey));
 }
 
-QString UrlFactory::getTileHash(QStringView type, int x, int y, int z)
+quint64 UrlFactory::getTileKey(QStringView type, int x, int y, int z)
 {
     const int hash = hashFromProviderType(type);
-    return QString::asprintf("%010d%08d%08d%03d", hash, x, y, z);
+    return QGCTileKey::make(hash, x, y, z);
 }
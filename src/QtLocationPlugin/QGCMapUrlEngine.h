@@ -44,8 +44,8 @@ class UrlFactory
     static QString providerTypeFromHash(int hash);
 
     static int hashFromProviderType(QStringView type);
-    static QString tileHashToType(QStringView tileHash);
-    static QString getTileHash(QStringView type, int x, int y, int z);
+    static QString tileKeyToType(quint64 tileKey);
+    static quint64 getTileKey(QStringView type, int x, int y, int z);
 
 private:
     static const QList<std::shared_ptr<const MapProvider>> _providers;
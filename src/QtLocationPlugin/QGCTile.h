@@ -17,7 +17,7 @@ struct QGCTile
     int y = 0;
     int z = 0;
     quint64 tileSet = UINT64_MAX;
-    QString hash;
+    quint64 key = 0;
     int type = -1;
 };
 Q_DECLARE_METATYPE(QGCTile)
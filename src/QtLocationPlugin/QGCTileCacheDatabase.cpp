@@ -10,6 +10,7 @@
 #include <QtSql/QSqlError>
 #include <QtSql/QSqlQuery>
 
+#include <algorithm>
 #include <atomic>
 
 #include "QGCCacheTile.h"
@@ -17,12 +18,45 @@
 #include "QGCMapUrlEngine.h"
 #include "QGCSqlHelper.h"
 #include "QGCTile.h"
+#include "QGCTileKey.h"
 #include "QGCTileSet.h"
 
 QGC_LOGGING_CATEGORY(QGCTileCacheDatabaseLog, "QtLocationPlugin.QGCTileCacheDatabase")
 
 static std::atomic<quint64> s_connectionCounter{0};
 
+// Shared by _createDB and the schema migration so both build identical tables
+static constexpr const char *kTilesColumns =
+    "(tileID INTEGER PRIMARY KEY NOT NULL, "
+    "tileKey INTEGER NOT NULL UNIQUE, "
+    "format TEXT NOT NULL, "
+    "tile BLOB NULL, "
+    "size INTEGER, "
+    "type INTEGER, "
+    "date INTEGER DEFAULT 0)";
+
+static constexpr const char *kTilesDownloadColumns =
+    "(setID INTEGER NOT NULL REFERENCES TileSets(setID) ON DELETE CASCADE, "
+    "tileKey INTEGER NOT NULL, "
+    "type INTEGER, "
+    "x INTEGER, "
+    "y INTEGER, "
+    "z INTEGER, "
+    "state INTEGER DEFAULT 0)";
+
+struct QGCTileCacheDatabase::SaveStatements
+{
+    explicit SaveStatements(const QSqlDatabase &db)
+        : insertTile(db)
+        , findTile(db)
+        , linkTile(db)
+    {}
+
+    QSqlQuery insertTile;
+    QSqlQuery findTile;
+    QSqlQuery linkTile;
+};
+
 QGCTileCacheDatabase::QGCTileCacheDatabase(const QString &databasePath)
     : _databasePath(databasePath)
     , _connectionName(QStringLiteral("QGCTileCache_%1").arg(s_connectionCounter.fetch_add(1)))
@@ -75,16 +109,24 @@ bool QGCTileCacheDatabase::_checkSchemaVersion()
         // Legacy DBs stored map type as text; migration is not supported so the cache is rebuilt.
         if (query.exec("SELECT COUNT(*) FROM Tiles") && query.next() && query.value(0).toInt() > 0) {
             qCWarning(QGCTileCacheDatabaseLog) << "Legacy database detected (no schema version). Discarding cached tiles and rebuilding.";
-            _defaultSet = kInvalidTileSet;
-            query.exec("DROP TABLE IF EXISTS TilesDownload");
-            query.exec("DROP TABLE IF EXISTS SetTiles");
-            query.exec("DROP TABLE IF EXISTS Tiles");
-            query.exec("DROP TABLE IF EXISTS TileSets");
+        }
+        // Dropped even when empty: _createDB only creates missing tables and would keep the legacy columns
+        _defaultSet = kInvalidTileSet;
+        query.exec("DROP TABLE IF EXISTS TilesDownload");
+        query.exec("DROP TABLE IF EXISTS SetTiles");
+        query.exec("DROP TABLE IF EXISTS Tiles");
+        query.exec("DROP TABLE IF EXISTS TileSets");
+        return true;
+    }
+
+    if (version == 1) {
+        if (!_migrateTileKeys(db)) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Failed to migrate schema version 1 to" << kSchemaVersion;
+            return false;
         }
         return true;
     }
 
-    // Future: handle incremental migrations here (version < kSchemaVersion).
     qCWarning(QGCTileCacheDatabaseLog) << "Unknown schema version" << version << "(expected" << kSchemaVersion << "). Resetting cache.";
     _defaultSet = kInvalidTileSet;
     query.exec("DROP TABLE IF EXISTS TilesDownload");
@@ -94,6 +136,65 @@ bool QGCTileCacheDatabase::_checkSchemaVersion()
     return true;
 }
 
+bool QGCTileCacheDatabase::_migrateTileKeys(QSqlDatabase db)
+{
+    // Version 1 keyed tiles by a 29 character TEXT hash. Rebuild Tiles and TilesDownload keyed by the packed
+    // integer, keeping tileIDs so SetTiles stays valid. Indexes are recreated by _createDB.
+    QSqlQuery query(db);
+    if (!query.exec("PRAGMA foreign_keys = OFF")) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to disable foreign keys for migration:" << query.lastError().text();
+        return false;
+    }
+
+    bool ok = false;
+    {
+        QGCSqlHelper::Transaction txn(db);
+        if (!txn.ok()) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Failed to start transaction for migration";
+        } else {
+            const QString tilesKey = QString::fromLatin1(QGCTileKey::kLegacyHashSql).arg(QStringLiteral("hash"));
+            const QStringList statements = {
+                QStringLiteral("CREATE TABLE Tiles_v2 %1").arg(QLatin1String(kTilesColumns)),
+                QStringLiteral("INSERT OR IGNORE INTO Tiles_v2(tileID, tileKey, format, tile, size, type, date) "
+                               "SELECT tileID, %1, format, tile, size, type, date FROM Tiles").arg(tilesKey),
+                QStringLiteral("CREATE TABLE TilesDownload_v2 %1").arg(QLatin1String(kTilesDownloadColumns)),
+                QStringLiteral("INSERT INTO TilesDownload_v2(setID, tileKey, type, x, y, z, state) "
+                               "SELECT setID, %1, type, x, y, z, state FROM TilesDownload").arg(tilesKey),
+                QStringLiteral("DROP TABLE TilesDownload"),
+                QStringLiteral("DROP TABLE Tiles"),
+                QStringLiteral("ALTER TABLE Tiles_v2 RENAME TO Tiles"),
+                QStringLiteral("ALTER TABLE TilesDownload_v2 RENAME TO TilesDownload"),
+                // Malformed hashes that collided were not copied
+                QStringLiteral("DELETE FROM SetTiles WHERE tileID NOT IN (SELECT tileID FROM Tiles)"),
+            };
+
+            ok = true;
+            for (const QString &sql : statements) {
+                if (!query.exec(sql)) {
+                    qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (migrate tile keys):" << sql << query.lastError().text();
+                    ok = false;
+                    break;
+                }
+            }
+            query.finish();
+
+            if (ok && !txn.commit()) {
+                qCWarning(QGCTileCacheDatabaseLog) << "Failed to commit migration transaction";
+                ok = false;
+            }
+        }
+    }
+
+    if (!query.exec("PRAGMA foreign_keys = ON")) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to re-enable foreign keys after migration:" << query.lastError().text();
+    }
+
+    if (ok) {
+        qCDebug(QGCTileCacheDatabaseLog) << "Migrated tile cache to schema version" << kSchemaVersion;
+    }
+    return ok;
+}
+
 bool QGCTileCacheDatabase::init()
 {
     _failed = false;
@@ -122,7 +223,7 @@ bool QGCTileCacheDatabase::init()
     return !_failed;
 }
 
-bool QGCTileCacheDatabase::connectDB()
+bool QGCTileCacheDatabase::connectDB(bool readOnly)
 {
     if (_connected) {
         disconnectDB();
@@ -130,6 +231,9 @@ bool QGCTileCacheDatabase::connectDB()
 
     QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", _connectionName);
     db.setDatabaseName(_databasePath);
+    if (readOnly) {
+        db.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY"));
+    }
     _valid = db.open();
     if (_valid) {
         QGCSqlHelper::applySqlitePragmas(db);
@@ -143,6 +247,8 @@ bool QGCTileCacheDatabase::connectDB()
 
 void QGCTileCacheDatabase::disconnectDB()
 {
+    _saveStatements.reset();
+
     if (!_connected) {
         return;
     }
@@ -161,104 +267,168 @@ void QGCTileCacheDatabase::disconnectDB()
     QSqlDatabase::removeDatabase(_connectionName);
 }
 
-bool QGCTileCacheDatabase::saveTile(const QString &hash, const QString &format, const QByteArray &img, const QString &type, quint64 tileSet)
+bool QGCTileCacheDatabase::saveTile(quint64 key, const QString &format, const QByteArray &img, const QString &type, quint64 tileSet)
 {
-    if (!_ensureConnected()) {
-        return false;
+    const QGCCacheTile tile(key, img, format, type, tileSet);
+    return saveTiles({&tile}).constFirst();
+}
+
+QList<bool> QGCTileCacheDatabase::saveTiles(const QList<const QGCCacheTile*> &tiles)
+{
+    QList<bool> saved(tiles.size(), false);
+    if (tiles.isEmpty() || !_ensureConnected()) {
+        return saved;
+    }
+
+    const bool needsDefaultSet = std::any_of(tiles.cbegin(), tiles.cend(),
+                                             [](const QGCCacheTile *tile) { return tile->tileSet == kInvalidTileSet; });
+    const quint64 defaultSet = needsDefaultSet ? _getDefaultTileSet() : kInvalidTileSet;
+
+    SaveStatements *const statements = _prepareSaveStatements();
+    if (!statements) {
+        return saved;
     }
 
     QGCSqlHelper::Transaction txn(_database());
     if (!txn.ok()) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Failed to start transaction for saveTile";
-        return false;
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to start transaction for saveTiles";
+        return saved;
     }
 
-    QSqlQuery query(_database());
-    if (!query.prepare("INSERT OR IGNORE INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)")) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare saveTile):" << query.lastError().text();
-        return false;
+    const qint64 date = QDateTime::currentSecsSinceEpoch();
+    for (qsizetype i = 0; i < tiles.size(); i++) {
+        saved[i] = _saveTile(*statements, *tiles[i], defaultSet, date);
     }
-    query.addBindValue(hash);
-    query.addBindValue(format);
-    query.addBindValue(img);
-    query.addBindValue(img.size());
-    query.addBindValue(UrlFactory::getQtMapIdFromProviderType(type));
-    query.addBindValue(QDateTime::currentSecsSinceEpoch());
-    if (!query.exec()) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (saveTile INSERT):" << query.lastError().text();
-        return false;
+
+    // Leave no statement mid-step between batches; an active one would block DROP TABLE and schema changes
+    statements->insertTile.finish();
+    statements->findTile.finish();
+    statements->linkTile.finish();
+
+    if (!txn.commit()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to commit saveTiles transaction";
+        saved.fill(false);
     }
 
-    if (!query.prepare("SELECT tileID FROM Tiles WHERE hash = ?")) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare tile lookup):" << query.lastError().text();
-        return false;
+    return saved;
+}
+
+QGCTileCacheDatabase::SaveStatements *QGCTileCacheDatabase::_prepareSaveStatements()
+{
+    if (_saveStatements) {
+        return _saveStatements.get();
     }
-    query.addBindValue(hash);
-    if (!query.exec() || !query.next()) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (tile lookup):" << query.lastError().text();
-        return false;
+
+    auto statements = std::make_unique<SaveStatements>(_database());
+    if (!statements->insertTile.prepare("INSERT OR IGNORE INTO Tiles(tileKey, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)")) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare saveTile):" << statements->insertTile.lastError().text();
+        return nullptr;
+    }
+    if (!statements->findTile.prepare("SELECT tileID FROM Tiles WHERE tileKey = ?")) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare tile lookup):" << statements->findTile.lastError().text();
+        return nullptr;
+    }
+    if (!statements->linkTile.prepare("INSERT OR IGNORE INTO SetTiles(tileID, setID) VALUES(?, ?)")) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare SetTiles):" << statements->linkTile.lastError().text();
+        return nullptr;
     }
-    const quint64 tileID = query.value(0).toULongLong();
 
-    const quint64 setID = (tileSet == kInvalidTileSet) ? _getDefaultTileSet() : tileSet;
+    _saveStatements = std::move(statements);
+    return _saveStatements.get();
+}
+
+bool QGCTileCacheDatabase::_saveTile(SaveStatements &statements, const QGCCacheTile &tile, quint64 defaultSet, qint64 date)
+{
+    // Checked first: the batch commits, so a tile row without a set would be left behind
+    const quint64 setID = (tile.tileSet == kInvalidTileSet) ? defaultSet : tile.tileSet;
     if (setID == kInvalidTileSet) {
         qCWarning(QGCTileCacheDatabaseLog) << "Cannot save tile: no valid tile set";
         return false;
     }
-    if (!query.prepare("INSERT OR IGNORE INTO SetTiles(tileID, setID) VALUES(?, ?)")) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare SetTiles):" << query.lastError().text();
-        return false;
-    }
-    query.addBindValue(tileID);
-    query.addBindValue(setID);
-    if (!query.exec()) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (add tile into SetTiles):" << query.lastError().text();
+
+    QSqlQuery &insert = statements.insertTile;
+    insert.bindValue(0, tile.key);
+    insert.bindValue(1, tile.format);
+    insert.bindValue(2, tile.img);
+    insert.bindValue(3, tile.img.size());
+    insert.bindValue(4, UrlFactory::getQtMapIdFromProviderType(tile.type));
+    insert.bindValue(5, date);
+    if (!insert.exec()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (saveTile INSERT):" << insert.lastError().text();
         return false;
     }
 
-    if (!txn.commit()) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Failed to commit saveTile transaction";
+    // A fresh insert knows its rowid; only a tile that was already cached needs the lookup
+    quint64 tileID = 0;
+    const bool inserted = (insert.numRowsAffected() == 1);
+    if (inserted) {
+        tileID = insert.lastInsertId().toULongLong();
+    } else {
+        QSqlQuery &find = statements.findTile;
+        find.bindValue(0, tile.key);
+        if (!find.exec() || !find.next()) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (tile lookup):" << find.lastError().text();
+            return false;
+        }
+        tileID = find.value(0).toULongLong();
+        find.finish();
+    }
+
+    QSqlQuery &link = statements.linkTile;
+    link.bindValue(0, tileID);
+    link.bindValue(1, setID);
+    if (!link.exec()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (add tile into SetTiles):" << link.lastError().text();
+        if (inserted) {
+            // The rest of the batch still commits; don't leave this tile behind without a set
+            QSqlQuery cleanup(_database());
+            if (!cleanup.prepare("DELETE FROM Tiles WHERE tileID = ?")) {
+                return false;
+            }
+            cleanup.addBindValue(tileID);
+            (void) cleanup.exec();
+        }
         return false;
     }
 
-    qCDebug(QGCTileCacheDatabaseLog) << "HASH:" << hash;
+    qCDebug(QGCTileCacheDatabaseLog) << "KEY:" << tile.key;
     return true;
 }
 
-std::unique_ptr<QGCCacheTile> QGCTileCacheDatabase::getTile(const QString &hash)
+std::unique_ptr<QGCCacheTile> QGCTileCacheDatabase::getTile(quint64 key)
 {
     if (!_ensureConnected()) {
         return nullptr;
     }
 
     QSqlQuery query(_database());
-    if (!query.prepare("SELECT tile, format, type FROM Tiles WHERE hash = ?")) {
+    if (!query.prepare("SELECT tile, format, type FROM Tiles WHERE tileKey = ?")) {
         return nullptr;
     }
-    query.addBindValue(hash);
+    query.addBindValue(key);
     if (query.exec() && query.next()) {
         const QByteArray tileData = query.value(0).toByteArray();
         const QString format = query.value(1).toString();
         const QString type = UrlFactory::getProviderTypeFromQtMapId(query.value(2).toInt());
-        qCDebug(QGCTileCacheDatabaseLog) << "(Found in DB) HASH:" << hash;
-        return std::make_unique<QGCCacheTile>(hash, tileData, format, type);
+        qCDebug(QGCTileCacheDatabaseLog) << "(Found in DB) KEY:" << key;
+        return std::make_unique<QGCCacheTile>(key, tileData, format, type);
     }
 
-    qCDebug(QGCTileCacheDatabaseLog) << "(NOT in DB) HASH:" << hash;
+    qCDebug(QGCTileCacheDatabaseLog) << "(NOT in DB) KEY:" << key;
     return nullptr;
 }
 
-std::optional<quint64> QGCTileCacheDatabase::findTile(const QString &hash)
+std::optional<quint64> QGCTileCacheDatabase::findTile(quint64 key)
 {
     if (!_ensureConnected()) {
         return std::nullopt;
     }
 
     QSqlQuery query(_database());
-    if (!query.prepare("SELECT tileID FROM Tiles WHERE hash = ?")) {
+    if (!query.prepare("SELECT tileID FROM Tiles WHERE tileKey = ?")) {
         return std::nullopt;
     }
-    query.addBindValue(hash);
+    query.addBindValue(key);
     if (query.exec() && query.next()) {
         return query.value(0).toULongLong();
     }
@@ -343,28 +513,28 @@ std::optional<quint64> QGCTileCacheDatabase::createTileSet(const QString &name,
     const quint64 setID = query.lastInsertId().toULongLong();
 
     // Process tiles in streaming batches to avoid holding all coordinates in memory
-    constexpr int kHashBatchSize = 500;
+    constexpr int kKeyBatchSize = 500;
     const int mapTypeId = UrlFactory::getQtMapIdFromProviderType(type);
 
-    struct TileCoord { int x, y; QString hash; };
+    struct TileCoord { int x, y; quint64 key; };
 
     auto processBatch = [&](const QList<TileCoord> &tiles, int z) -> bool {
-        QHash<QString, quint64> existingTiles;
+        QHash<quint64, quint64> existingTiles;
         QSqlQuery lookup(_database());
         lookup.setForwardOnly(true);
-        if (lookup.prepare(QStringLiteral("SELECT hash, tileID FROM Tiles WHERE hash IN (%1)").arg(QGCSqlHelper::placeholders(tiles.size())))) {
+        if (lookup.prepare(QStringLiteral("SELECT tileKey, tileID FROM Tiles WHERE tileKey IN (%1)").arg(QGCSqlHelper::placeholders(tiles.size())))) {
             for (const auto &tc : tiles) {
-                lookup.addBindValue(tc.hash);
+                lookup.addBindValue(tc.key);
             }
             if (lookup.exec()) {
                 while (lookup.next()) {
-                    existingTiles.insert(lookup.value(0).toString(), lookup.value(1).toULongLong());
+                    existingTiles.insert(lookup.value(0).toULongLong(), lookup.value(1).toULongLong());
                 }
             }
         }
 
         for (const auto &tc : tiles) {
-            auto it = existingTiles.find(tc.hash);
+            auto it = existingTiles.find(tc.key);
             if (it != existingTiles.end()) {
                 if (!query.prepare("INSERT OR IGNORE INTO SetTiles(tileID, setID) VALUES(?, ?)")) {
                     return false;
@@ -376,11 +546,11 @@ std::optional<quint64> QGCTileCacheDatabase::createTileSet(const QString &name,
                     return false;
                 }
             } else {
-                if (!query.prepare("INSERT OR IGNORE INTO TilesDownload(setID, hash, type, x, y, z, state) VALUES(?, ?, ?, ?, ?, ?, ?)")) {
+                if (!query.prepare("INSERT OR IGNORE INTO TilesDownload(setID, tileKey, type, x, y, z, state) VALUES(?, ?, ?, ?, ?, ?, ?)")) {
                     return false;
                 }
                 query.addBindValue(setID);
-                query.addBindValue(tc.hash);
+                query.addBindValue(tc.key);
                 query.addBindValue(mapTypeId);
                 query.addBindValue(tc.x);
                 query.addBindValue(tc.y);
@@ -399,13 +569,13 @@ std::optional<quint64> QGCTileCacheDatabase::createTileSet(const QString &name,
         const QGCTileSet set = UrlFactory::getTileCount(z, topleftLon, topleftLat, bottomRightLon, bottomRightLat, type);
 
         QList<TileCoord> batch;
-        batch.reserve(kHashBatchSize);
+        batch.reserve(kKeyBatchSize);
 
         for (int x = set.tileX0; x <= set.tileX1; x++) {
             for (int y = set.tileY0; y <= set.tileY1; y++) {
-                batch.append({x, y, UrlFactory::getTileHash(type, x, y, z)});
+                batch.append({x, y, UrlFactory::getTileKey(type, x, y, z)});
 
-                if (batch.size() >= kHashBatchSize) {
+                if (batch.size() >= kKeyBatchSize) {
                     if (!processBatch(batch, z)) return std::nullopt;
                     batch.clear();
                 }
@@ -541,6 +711,7 @@ bool QGCTileCacheDatabase::resetDatabase()
     }
 
     _defaultSet = kInvalidTileSet;
+    _saveStatements.reset();
 
     QGCSqlHelper::Transaction txn(_database());
     if (!txn.ok()) {
@@ -577,7 +748,7 @@ QList<QGCTile> QGCTileCacheDatabase::getTileDownloadList(quint64 setID, int coun
     }
 
     QSqlQuery query(_database());
-    if (!query.prepare("SELECT hash, type, x, y, z FROM TilesDownload WHERE setID = ? AND state = ? LIMIT ?")) {
+    if (!query.prepare("SELECT tileKey, type, x, y, z FROM TilesDownload WHERE setID = ? AND state = ? LIMIT ?")) {
         qCWarning(QGCTileCacheDatabaseLog) << "Failed to prepare tile download list query:" << query.lastError().text();
         return tiles;
     }
@@ -590,7 +761,7 @@ QList<QGCTile> QGCTileCacheDatabase::getTileDownloadList(quint64 setID, int coun
 
     while (query.next()) {
         QGCTile tile;
-        tile.hash = query.value(0).toString();
+        tile.key = query.value(0).toULongLong();
         tile.type = query.value(1).toInt();
         tile.x = query.value(2).toInt();
         tile.y = query.value(3).toInt();
@@ -599,11 +770,11 @@ QList<QGCTile> QGCTileCacheDatabase::getTileDownloadList(quint64 setID, int coun
     }
 
     if (!tiles.isEmpty()) {
-        if (query.prepare(QStringLiteral("UPDATE TilesDownload SET state = ? WHERE setID = ? AND hash IN (%1)").arg(QGCSqlHelper::placeholders(tiles.size())))) {
+        if (query.prepare(QStringLiteral("UPDATE TilesDownload SET state = ? WHERE setID = ? AND tileKey IN (%1)").arg(QGCSqlHelper::placeholders(tiles.size())))) {
             query.addBindValue(static_cast<int>(QGCTile::StateDownloading));
             query.addBindValue(setID);
             for (qsizetype i = 0; i < tiles.size(); i++) {
-                query.addBindValue(tiles[i].hash);
+                query.addBindValue(tiles[i].key);
             }
             if (!query.exec()) {
                 qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (batch set TilesDownload state):" << query.lastError().text();
@@ -621,30 +792,53 @@ QList<QGCTile> QGCTileCacheDatabase::getTileDownloadList(quint64 setID, int coun
     return tiles;
 }
 
-bool QGCTileCacheDatabase::updateTileDownloadState(quint64 setID, int state, const QString &hash)
+bool QGCTileCacheDatabase::updateTileDownloadState(quint64 setID, int state, quint64 key)
+{
+    return updateTileDownloadStates(setID, state, {key});
+}
+
+bool QGCTileCacheDatabase::updateTileDownloadStates(quint64 setID, int state, const QList<quint64> &keys)
 {
+    if (keys.isEmpty()) {
+        return true;
+    }
     if (!_ensureConnected()) {
         return false;
     }
 
+    QGCSqlHelper::Transaction txn(_database());
+    if (!txn.ok()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to start transaction for updateTileDownloadStates";
+        return false;
+    }
+
     QSqlQuery query(_database());
-    if (state == QGCTile::StateComplete) {
-        if (!query.prepare("DELETE FROM TilesDownload WHERE setID = ? AND hash = ?")) {
-            return false;
+    for (qsizetype offset = 0; offset < keys.size(); offset += kDownloadStateBatchSize) {
+        const qsizetype count = qMin(kDownloadStateBatchSize, keys.size() - offset);
+        const QString inList = QGCSqlHelper::placeholders(static_cast<int>(count));
+        if (state == QGCTile::StateComplete) {
+            if (!query.prepare(QStringLiteral("DELETE FROM TilesDownload WHERE setID = ? AND tileKey IN (%1)").arg(inList))) {
+                return false;
+            }
+        } else {
+            if (!query.prepare(QStringLiteral("UPDATE TilesDownload SET state = ? WHERE setID = ? AND tileKey IN (%1)").arg(inList))) {
+                return false;
+            }
+            query.addBindValue(state);
         }
         query.addBindValue(setID);
-        query.addBindValue(hash);
-    } else {
-        if (!query.prepare("UPDATE TilesDownload SET state = ? WHERE setID = ? AND hash = ?")) {
+        for (qsizetype i = offset; i < (offset + count); i++) {
+            query.addBindValue(keys[i]);
+        }
+
+        if (!query.exec()) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Error:" << query.lastError().text();
             return false;
         }
-        query.addBindValue(state);
-        query.addBindValue(setID);
-        query.addBindValue(hash);
     }
 
-    if (!query.exec()) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Error:" << query.lastError().text();
+    if (!txn.commit()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to commit updateTileDownloadStates transaction";
         return false;
     }
 
@@ -682,7 +876,7 @@ bool QGCTileCacheDatabase::pruneCache(quint64 amount)
     while (remaining > 0) {
         QSqlQuery query(_database());
         query.setForwardOnly(true);
-        if (!query.prepare(QStringLiteral("SELECT tileID, size, hash FROM Tiles WHERE tileID IN (%1) ORDER BY date ASC LIMIT ?").arg(kUniqueTilesSubquery))) {
+        if (!query.prepare(QStringLiteral("SELECT tileID, size, tileKey FROM Tiles WHERE tileID IN (%1) ORDER BY date ASC LIMIT ?").arg(kUniqueTilesSubquery))) {
             qCWarning(QGCTileCacheDatabaseLog) << "Failed to prepare prune query:" << query.lastError().text();
             return false;
         }
@@ -697,7 +891,7 @@ bool QGCTileCacheDatabase::pruneCache(quint64 amount)
             tileIDs << query.value(0).toULongLong();
             const quint64 sz = query.value(1).toULongLong();
             remaining = (sz >= remaining) ? 0 : remaining - sz;
-            qCDebug(QGCTileCacheDatabaseLog) << "HASH:" << query.value(2).toString();
+            qCDebug(QGCTileCacheDatabaseLog) << "KEY:" << query.value(2).toULongLong();
         }
 
         if (tileIDs.isEmpty()) {
@@ -743,7 +937,7 @@ void QGCTileCacheDatabase::deleteBingNoTileTiles()
 
     QSqlQuery query(_database());
     query.setForwardOnly(true);
-    if (!query.prepare("SELECT tileID, hash FROM Tiles WHERE LENGTH(tile) = ? AND tile = ?")) {
+    if (!query.prepare("SELECT tileID, tileKey FROM Tiles WHERE LENGTH(tile) = ? AND tile = ?")) {
         qCWarning(QGCTileCacheDatabaseLog) << "Failed to prepare Bing no-tile query";
         return;
     }
@@ -757,7 +951,7 @@ void QGCTileCacheDatabase::deleteBingNoTileTiles()
     QList<quint64> idsToDelete;
     while (query.next()) {
         idsToDelete.append(query.value(0).toULongLong());
-        qCDebug(QGCTileCacheDatabaseLog) << "HASH:" << query.value(1).toString();
+        qCDebug(QGCTileCacheDatabaseLog) << "KEY:" << query.value(1).toULongLong();
     }
 
     if (idsToDelete.isEmpty()) {
@@ -1096,7 +1290,7 @@ DatabaseResult QGCTileCacheDatabase::exportSets(const QList<TileSetRecord> &sets
     for (const auto &set : sets) {
         QSqlQuery query(_database());
         query.setForwardOnly(true);
-        if (!query.prepare("SELECT T.hash, T.format, T.tile, T.type, T.date FROM Tiles T "
+        if (!query.prepare("SELECT T.tileKey, T.format, T.tile, T.type, T.date FROM Tiles T "
                            "INNER JOIN SetTiles S ON T.tileID = S.tileID WHERE S.setID = ?")) {
             qCWarning(QGCTileCacheDatabaseLog) << "Failed to prepare tile query for export set" << set.name;
             continue;
@@ -1142,19 +1336,19 @@ DatabaseResult QGCTileCacheDatabase::exportSets(const QList<TileSetRecord> &sets
 
         quint64 skippedTiles = 0;
         while (query.next()) {
-            const QString hash = query.value(0).toString();
+            const quint64 key = query.value(0).toULongLong();
             const QString format = query.value(1).toString();
             const QByteArray img = query.value(2).toByteArray();
             const int tileType = query.value(3).toInt();
             const quint64 tileDate = query.value(4).toULongLong();
 
             quint64 exportTileID = 0;
-            if (!exportQuery.prepare("INSERT INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)")) {
+            if (!exportQuery.prepare("INSERT INTO Tiles(tileKey, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)")) {
                 qCWarning(QGCTileCacheDatabaseLog) << "Failed to prepare tile INSERT for export:" << exportQuery.lastError().text();
                 skippedTiles++;
                 continue;
             }
-            exportQuery.addBindValue(hash);
+            exportQuery.addBindValue(key);
             exportQuery.addBindValue(format);
             exportQuery.addBindValue(img);
             exportQuery.addBindValue(img.size());
@@ -1164,8 +1358,8 @@ DatabaseResult QGCTileCacheDatabase::exportSets(const QList<TileSetRecord> &sets
                 exportTileID = exportQuery.lastInsertId().toULongLong();
             } else {
                 QSqlQuery lookup(exportDB.database());
-                if (lookup.prepare("SELECT tileID FROM Tiles WHERE hash = ?")) {
-                    lookup.addBindValue(hash);
+                if (lookup.prepare("SELECT tileID FROM Tiles WHERE tileKey = ?")) {
+                    lookup.addBindValue(key);
                     if (lookup.exec() && lookup.next()) {
                         exportTileID = lookup.value(0).toULongLong();
                     }
@@ -1210,16 +1404,7 @@ bool QGCTileCacheDatabase::_createDB(QSqlDatabase db, bool createDefault)
     // enabled foreign_keys; nothing to redo here.
     QSqlQuery query(db);
 
-    if (!query.exec(
-        "CREATE TABLE IF NOT EXISTS Tiles ("
-        "tileID INTEGER PRIMARY KEY NOT NULL, "
-        "hash TEXT NOT NULL UNIQUE, "
-        "format TEXT NOT NULL, "
-        "tile BLOB NULL, "
-        "size INTEGER, "
-        "type INTEGER, "
-        "date INTEGER DEFAULT 0)"))
-    {
+    if (!query.exec(QStringLiteral("CREATE TABLE IF NOT EXISTS Tiles %1").arg(QLatin1String(kTilesColumns)))) {
         qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (create Tiles db):" << query.lastError().text();
         return false;
     }
@@ -1253,16 +1438,7 @@ bool QGCTileCacheDatabase::_createDB(QSqlDatabase db, bool createDefault)
         return false;
     }
 
-    if (!query.exec(
-        "CREATE TABLE IF NOT EXISTS TilesDownload ("
-        "setID INTEGER NOT NULL REFERENCES TileSets(setID) ON DELETE CASCADE, "
-        "hash TEXT NOT NULL, "
-        "type INTEGER, "
-        "x INTEGER, "
-        "y INTEGER, "
-        "z INTEGER, "
-        "state INTEGER DEFAULT 0)"))
-    {
+    if (!query.exec(QStringLiteral("CREATE TABLE IF NOT EXISTS TilesDownload %1").arg(QLatin1String(kTilesDownloadColumns)))) {
         qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (create TilesDownload db):" << query.lastError().text();
         return false;
     }
@@ -1271,7 +1447,7 @@ bool QGCTileCacheDatabase::_createDB(QSqlDatabase db, bool createDefault)
         "CREATE UNIQUE INDEX IF NOT EXISTS idx_settiles_unique ON SetTiles(tileID, setID)",
         "CREATE INDEX IF NOT EXISTS idx_settiles_setid ON SetTiles(setID)",
         "CREATE INDEX IF NOT EXISTS idx_settiles_tileid ON SetTiles(tileID)",
-        "CREATE UNIQUE INDEX IF NOT EXISTS idx_tilesdownload_setid_hash ON TilesDownload(setID, hash)",
+        "CREATE UNIQUE INDEX IF NOT EXISTS idx_tilesdownload_setid_tilekey ON TilesDownload(setID, tileKey)",
         "CREATE INDEX IF NOT EXISTS idx_tilesdownload_setid_state ON TilesDownload(setID, state)",
         "CREATE INDEX IF NOT EXISTS idx_tiles_date ON Tiles(date)",
     };
@@ -1390,10 +1566,15 @@ quint64 QGCTileCacheDatabase::_copyTilesForSet(QSqlDatabase srcDB, quint64 srcSe
                                                  int &lastProgress, ProgressCallback progressCb,
                                                  quint64 *tilesIteratedOut, bool useTransaction)
 {
+    // Databases exported before schema version 2 key tiles by TEXT hash; convert while reading
+    const bool legacyKeys = QGCSqlHelper::userVersion(srcDB).value_or(0) < 2;
+    const QString keyColumn = legacyKeys ? QString::fromLatin1(QGCTileKey::kLegacyHashSql).arg(QStringLiteral("T.hash"))
+                                         : QStringLiteral("T.tileKey");
+
     QSqlQuery subQuery(srcDB);
     subQuery.setForwardOnly(true);
-    if (!subQuery.prepare("SELECT T.hash, T.format, T.tile, T.type, T.date FROM Tiles T "
-                          "INNER JOIN SetTiles S ON T.tileID = S.tileID WHERE S.setID = ?")) {
+    if (!subQuery.prepare(QStringLiteral("SELECT %1, T.format, T.tile, T.type, T.date FROM Tiles T "
+                                         "INNER JOIN SetTiles S ON T.tileID = S.tileID WHERE S.setID = ?").arg(keyColumn))) {
         if (tilesIteratedOut) *tilesIteratedOut = 0;
         return 0;
     }
@@ -1419,15 +1600,15 @@ quint64 QGCTileCacheDatabase::_copyTilesForSet(QSqlDatabase srcDB, quint64 srcSe
     QSqlQuery cQuery(_database());
     while (subQuery.next()) {
         tilesFound++;
-        const QString hash = subQuery.value(0).toString();
+        const quint64 key = subQuery.value(0).toULongLong();
         const QString format = subQuery.value(1).toString();
         const QByteArray img = subQuery.value(2).toByteArray();
         const int tileType = subQuery.value(3).toInt();
         const quint64 tileDate = subQuery.value(4).toULongLong();
 
         quint64 importTileID = 0;
-        if (cQuery.prepare("INSERT INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)")) {
-            cQuery.addBindValue(hash);
+        if (cQuery.prepare("INSERT INTO Tiles(tileKey, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)")) {
+            cQuery.addBindValue(key);
             cQuery.addBindValue(format);
             cQuery.addBindValue(img);
             cQuery.addBindValue(img.size());
@@ -1436,8 +1617,8 @@ quint64 QGCTileCacheDatabase::_copyTilesForSet(QSqlDatabase srcDB, quint64 srcSe
             if (cQuery.exec()) {
                 importTileID = cQuery.lastInsertId().toULongLong();
             } else {
-                if (cQuery.prepare("SELECT tileID FROM Tiles WHERE hash = ?")) {
-                    cQuery.addBindValue(hash);
+                if (cQuery.prepare("SELECT tileID FROM Tiles WHERE tileKey = ?")) {
+                    cQuery.addBindValue(key);
                     if (cQuery.exec() && cQuery.next()) {
                         importTileID = cQuery.value(0).toULongLong();
                     }
@@ -17,22 +17,26 @@ class QGCTileCacheDatabase
 {
 public:
     static constexpr quint64 kInvalidTileSet = UINT64_MAX;
-    static constexpr int kSchemaVersion = 1;
+    static constexpr int kSchemaVersion = 2;
 
     explicit QGCTileCacheDatabase(const QString &databasePath);
     ~QGCTileCacheDatabase();
 
     bool init();
-    bool connectDB();
+    /// A read-only connection serves lookups alongside the writer (WAL); it never creates or migrates the schema.
+    bool connectDB(bool readOnly = false);
     void disconnectDB();
 
     bool isValid() const { return _valid; }
     bool hasFailed() const { return _failed; }
 
     // Tiles
-    bool saveTile(const QString &hash, const QString &format, const QByteArray &img, const QString &type, quint64 tileSet);
-    std::unique_ptr<QGCCacheTile> getTile(const QString &hash);
-    std::optional<quint64> findTile(const QString &hash);
+    bool saveTile(quint64 key, const QString &format, const QByteArray &img, const QString &type, quint64 tileSet);
+    /// Saves all tiles in one transaction with reused prepared statements. Returns one entry per tile: whether it
+    /// was saved. A failed transaction fails every tile.
+    QList<bool> saveTiles(const QList<const QGCCacheTile*> &tiles);
+    std::unique_ptr<QGCCacheTile> getTile(quint64 key);
+    std::optional<quint64> findTile(quint64 key);
 
     // Tile Sets
     QList<TileSetRecord> getTileSets();
@@ -47,7 +51,9 @@ class QGCTileCacheDatabase
 
     // Downloads
     QList<QGCTile> getTileDownloadList(quint64 setID, int count);
-    bool updateTileDownloadState(quint64 setID, int state, const QString &hash);
+    bool updateTileDownloadState(quint64 setID, int state, quint64 key);
+    /// Moves every tile in @p keys to @p state in one transaction; StateComplete removes them from the download list
+    bool updateTileDownloadStates(quint64 setID, int state, const QList<quint64> &keys);
     bool updateAllTileDownloadStates(quint64 setID, int state);
 
     // Cache
@@ -69,9 +75,14 @@ class QGCTileCacheDatabase
     static constexpr const char *kBingNoTileDoneKey = "_deleteBingNoTileTilesDone";
 
 private:
+    struct SaveStatements;
+
     bool _ensureConnected() const;
+    SaveStatements *_prepareSaveStatements();
+    bool _saveTile(SaveStatements &statements, const QGCCacheTile &tile, quint64 defaultSet, qint64 date);
     QSqlDatabase _database() const;
     bool _checkSchemaVersion();
+    bool _migrateTileKeys(QSqlDatabase db);
     bool _createDB(QSqlDatabase db, bool createDefault = true);
     quint64 _getDefaultTileSet();
     bool _deleteTilesByIDs(const QList<quint64> &ids);
@@ -83,11 +94,13 @@ class QGCTileCacheDatabase
 
     QString _databasePath;
     QString _connectionName;
+    std::unique_ptr<SaveStatements> _saveStatements;  ///< Bound to the open connection; dropped on disconnect/reset
     quint64 _defaultSet = kInvalidTileSet;
     bool _connected = false;
     bool _valid = false;
     bool _failed = false;
     static constexpr int kPruneBatchSize = 128;
+    static constexpr qsizetype kDownloadStateBatchSize = 500;   ///< Keys per statement, under SQLite's bound-parameter limit
     static constexpr const char *kUniqueTilesSubquery =
         "SELECT A.tileID FROM SetTiles A JOIN SetTiles B ON A.tileID = B.tileID "
         "WHERE B.setID = ? GROUP BY A.tileID HAVING COUNT(A.tileID) = 1";
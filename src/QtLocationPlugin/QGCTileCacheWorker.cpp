@@ -2,6 +2,7 @@
 #include "QGCTileCacheDatabase.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDeadlineTimer>
 #include <QtCore/QSettings>
 
 #include "QGCCacheTile.h"
@@ -9,6 +10,7 @@
 #include "QGCLoggingCategory.h"
 #include "QGCMapTasks.h"
 #include "QGCMapUrlEngine.h"
+#include "QGCTileKey.h"
 
 QGC_LOGGING_CATEGORY(QGCTileCacheWorkerLog, "QtLocationPlugin.QGCTileCacheWorker")
 
@@ -31,8 +33,16 @@ void QGCCacheWorker::stop()
     QMutexLocker lock(&_taskQueueMutex);
     qDeleteAll(_taskQueue);
     _taskQueue.clear();
+    _pendingSaves.clear();
     lock.unlock();
 
+    QMutexLocker readLock(&_readQueueMutex);
+    qDeleteAll(_readQueue);
+    _readQueue.clear();
+    qDeleteAll(_lowPriorityReadQueue);
+    _lowPriorityReadQueue.clear();
+    readLock.unlock();
+
     if (isRunning()) {
         _waitc.wakeAll();
     }
@@ -47,6 +57,23 @@ bool QGCCacheWorker::enqueueTask(QGCMapTask *task)
     }
 
     QMutexLocker lock(&_taskQueueMutex);
+    if (task->type() == QGCMapTask::TaskType::taskFetchTile) {
+        const QGCFetchTileTask *const fetchTask = static_cast<QGCFetchTileTask*>(task);
+        QMutexLocker readLock(&_readQueueMutex);
+        if (_readersAccepting && !_pendingSaves.contains(fetchTask->key())) {
+            lock.unlock();
+            if (fetchTask->lowPriority()) {
+                _lowPriorityReadQueue.enqueue(task);
+            } else {
+                _readQueue.enqueue(task);
+            }
+            readLock.unlock();
+            _readWaitc.wakeAll();
+            return true;
+        }
+    } else if (task->type() == QGCMapTask::TaskType::taskCacheTile) {
+        _pendingSaves[static_cast<QGCSaveTileTask*>(task)->tile()->key]++;
+    }
     _taskQueue.enqueue(task);
     lock.unlock();
 
@@ -74,6 +101,7 @@ void QGCCacheWorker::run()
             orphan->deleteLater();
         }
         _taskQueue.clear();
+        _pendingSaves.clear();
         return;
     }
 
@@ -84,6 +112,9 @@ void QGCCacheWorker::run()
     }
 
     _dbValid = _database->isValid();
+    if (_dbValid) {
+        _startReaders();
+    }
 
     _updateTimer.start();
 
@@ -91,10 +122,26 @@ void QGCCacheWorker::run()
     while (!_stopRequested) {
         if (!_taskQueue.isEmpty()) {
             QGCMapTask* const task = _taskQueue.dequeue();
-            lock.unlock();
-            _runTask(task);
-            lock.relock();
-            task->deleteLater();
+            if (task->type() == QGCMapTask::TaskType::taskCacheTile) {
+                // Panning and bulk downloads deliver tiles one task at a time; commit them together
+                QList<QGCMapTask*> batch{task};
+                _collectSaveBatch(lock, batch);
+                lock.unlock();
+                _saveTiles(batch);
+                lock.relock();
+                for (QGCMapTask *saved : std::as_const(batch)) {
+                    const quint64 key = static_cast<QGCSaveTileTask*>(saved)->tile()->key;
+                    if (const auto it = _pendingSaves.find(key); (it != _pendingSaves.end()) && (--it.value() <= 0)) {
+                        _pendingSaves.erase(it);
+                    }
+                    saved->deleteLater();
+                }
+            } else {
+                lock.unlock();
+                _runTask(task);
+                lock.relock();
+                task->deleteLater();
+            }
 
             const qsizetype count = _taskQueue.count();
             if (count > 100) {
@@ -120,8 +167,11 @@ void QGCCacheWorker::run()
         orphan->deleteLater();
     }
     _taskQueue.clear();
+    _pendingSaves.clear();
     lock.unlock();
 
+    _stopReaders();
+
     _dbValid = false;
     if (_database) {
         _database->disconnectDB();
@@ -135,10 +185,10 @@ void QGCCacheWorker::_runTask(QGCMapTask *task)
     case QGCMapTask::TaskType::taskInit:
         break;
     case QGCMapTask::TaskType::taskCacheTile:
-        _saveTile(task);
+        _saveTiles({task});
         break;
     case QGCMapTask::TaskType::taskFetchTile:
-        _getTile(task);
+        _getTile(_database.get(), task);
         break;
     case QGCMapTask::TaskType::taskFetchTileSets:
         _getTileSets(task);
@@ -162,7 +212,9 @@ void QGCCacheWorker::_runTask(QGCMapTask *task)
         _pruneCache(task);
         break;
     case QGCMapTask::TaskType::taskReset:
+        _pauseReaders();
         _resetCacheDatabase(task);
+        _resumeReaders();
         break;
     case QGCMapTask::TaskType::taskExport:
         _exportSets(task);
@@ -193,27 +245,56 @@ void QGCCacheWorker::_emitTotals()
     _updateTimer.restart();
 }
 
-void QGCCacheWorker::_saveTile(QGCMapTask *mtask)
+void QGCCacheWorker::_collectSaveBatch(QMutexLocker<QMutex> &lock, QList<QGCMapTask*> &batch)
 {
-    if (!_testTask(mtask)) {
+    const QDeadlineTimer deadline(kSaveBatchWindowMs);
+    while ((batch.size() < kMaxSaveBatch) && !_stopRequested) {
+        if (_taskQueue.isEmpty()) {
+            if (deadline.hasExpired() || !_waitc.wait(lock.mutex(), deadline)) {
+                break;
+            }
+            continue;
+        }
+        // Anything else queued behind the tiles must see them saved, so stop at the first other task
+        if (_taskQueue.head()->type() != QGCMapTask::TaskType::taskCacheTile) {
+            break;
+        }
+        batch.append(_taskQueue.dequeue());
+    }
+}
+
+void QGCCacheWorker::_saveTiles(const QList<QGCMapTask*> &tasks)
+{
+    if (!_database || !_database->isValid()) {
+        for (QGCMapTask *task : tasks) {
+            (void) _testTask(task);
+        }
         return;
     }
 
-    QGCSaveTileTask *task = static_cast<QGCSaveTileTask*>(mtask);
-    if (!_database->saveTile(task->tile()->hash, task->tile()->format,
-                             task->tile()->img, task->tile()->type, task->tile()->tileSet)) {
-        mtask->setError("Error saving tile to cache");
+    QList<const QGCCacheTile*> tiles;
+    tiles.reserve(tasks.size());
+    for (QGCMapTask *task : tasks) {
+        tiles.append(static_cast<QGCSaveTileTask*>(task)->tile());
+    }
+
+    const QList<bool> saved = _database->saveTiles(tiles);
+    for (qsizetype i = 0; i < tasks.size(); i++) {
+        if (!saved[i]) {
+            tasks[i]->setError("Error saving tile to cache");
+        }
     }
 }
 
-void QGCCacheWorker::_getTile(QGCMapTask *mtask)
+void QGCCacheWorker::_getTile(QGCTileCacheDatabase *database, QGCMapTask *mtask)
 {
-    if (!_testTask(mtask)) {
+    if (!database || !database->isValid()) {
+        mtask->setError("No Cache Database");
         return;
     }
 
     QGCFetchTileTask *task = static_cast<QGCFetchTileTask*>(mtask);
-    auto tile = _database->getTile(task->hash());
+    auto tile = database->getTile(task->key());
     if (tile) {
         task->setTileFetched(tile.release());
     } else {
@@ -318,10 +399,10 @@ void QGCCacheWorker::_updateTileDownloadState(QGCMapTask *mtask)
 
     QGCUpdateTileDownloadStateTask *task = static_cast<QGCUpdateTileDownloadStateTask*>(mtask);
     bool ok;
-    if (task->hash() == QStringLiteral("*")) {
+    if (task->allTiles()) {
         ok = _database->updateAllTileDownloadStates(task->setID(), static_cast<int>(task->state()));
     } else {
-        ok = _database->updateTileDownloadState(task->setID(), static_cast<int>(task->state()), task->hash());
+        ok = _database->updateTileDownloadStates(task->setID(), static_cast<int>(task->state()), task->keys());
     }
     if (!ok) {
         mtask->setError("Error updating tile download state");
@@ -395,7 +476,9 @@ void QGCCacheWorker::_importSets(QGCMapTask *mtask)
 
     DatabaseResult result;
     if (task->replace()) {
+        _pauseReaders();
         result = _database->importSetsReplace(task->path(), progress);
+        _resumeReaders();
     } else {
         result = _database->importSetsMerge(task->path(), progress);
     }
@@ -434,3 +517,116 @@ void QGCCacheWorker::_exportSets(QGCMapTask *mtask)
 
     task->setExportCompleted();
 }
+
+void QGCCacheWorker::_startReaders()
+{
+    QMutexLocker lock(&_readQueueMutex);
+    _readersStopping = false;
+    _readersPaused = false;
+    _readersAccepting = true;
+    lock.unlock();
+
+    for (int i = 0; i < kReaderThreads; i++) {
+        QThread *const reader = QThread::create([this]() { _runReader(); });
+        reader->setObjectName(QStringLiteral("QGCCacheReader%1").arg(i));
+        reader->start(QThread::NormalPriority);
+        _readers.append(reader);
+    }
+}
+
+void QGCCacheWorker::_stopReaders()
+{
+    QMutexLocker lock(&_readQueueMutex);
+    _readersAccepting = false;
+    _readersStopping = true;
+    lock.unlock();
+    _readWaitc.wakeAll();
+
+    for (QThread *reader : std::as_const(_readers)) {
+        (void) reader->wait();
+        delete reader;
+    }
+    _readers.clear();
+
+    lock.relock();
+    for (QGCMapTask *orphan : std::as_const(_readQueue)) {
+        orphan->setError(tr("Worker shutting down"));
+        orphan->deleteLater();
+    }
+    _readQueue.clear();
+    for (QGCMapTask *orphan : std::as_const(_lowPriorityReadQueue)) {
+        orphan->setError(tr("Worker shutting down"));
+        orphan->deleteLater();
+    }
+    _lowPriorityReadQueue.clear();
+}
+
+void QGCCacheWorker::_runReader()
+{
+    // Connections belong to the thread that opened them, so each reader has its own
+    QGCTileCacheDatabase database(_databasePath);
+    bool connected = false;
+
+    QMutexLocker lock(&_readQueueMutex);
+    while (!_readersStopping) {
+        if (_readersPaused && connected) {
+            lock.unlock();
+            database.disconnectDB();
+            lock.relock();
+            connected = false;
+            _connectedReaders--;
+            _readWaitc.wakeAll();
+            continue;
+        }
+        if (_readersPaused || (_readQueue.isEmpty() && _lowPriorityReadQueue.isEmpty())) {
+            (void) _readWaitc.wait(lock.mutex());
+            continue;
+        }
+
+        QGCMapTask *const task = !_readQueue.isEmpty() ? _readQueue.dequeue() : _lowPriorityReadQueue.dequeue();
+        // Counted before the connection opens, so a pause waits for it
+        const bool connect = !connected;
+        if (connect) {
+            _connectedReaders++;
+            connected = true;
+        }
+        lock.unlock();
+
+        if (connect && !database.connectDB(true)) {
+            qCWarning(QGCTileCacheWorkerLog) << "Failed to open reader connection";
+        }
+        _getTile(&database, task);
+        task->deleteLater();
+
+        lock.relock();
+        if (!database.isValid()) {
+            connected = false;
+            _connectedReaders--;
+            _readWaitc.wakeAll();
+        }
+    }
+
+    if (connected) {
+        _connectedReaders--;
+        lock.unlock();
+        database.disconnectDB();
+    }
+}
+
+void QGCCacheWorker::_pauseReaders()
+{
+    QMutexLocker lock(&_readQueueMutex);
+    _readersPaused = true;
+    _readWaitc.wakeAll();
+    while (_connectedReaders > 0) {
+        (void) _readWaitc.wait(lock.mutex());
+    }
+}
+
+void QGCCacheWorker::_resumeReaders()
+{
+    QMutexLocker lock(&_readQueueMutex);
+    _readersPaused = false;
+    lock.unlock();
+    _readWaitc.wakeAll();
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QMutex>
 #include <QtCore/QQueue>
 #include <QtCore/QString>
@@ -12,6 +14,9 @@
 class QGCMapTask;
 class QGCTileCacheDatabase;
 
+/// Runs map cache tasks against the tile database. Writes and maintenance run in order on this thread; tile
+/// lookups for the visible map are served by a small pool of read-only connections so they never wait behind an
+/// import, export or prune.
 class QGCCacheWorker : public QThread
 {
     Q_OBJECT
@@ -34,9 +39,12 @@ public slots:
 
 private:
     void _runTask(QGCMapTask *task);
+    /// Called with the queue locked. Moves the save tasks at the head of the queue into @p batch, waiting up to
+    /// kSaveBatchWindowMs for more while the queue is empty.
+    void _collectSaveBatch(QMutexLocker<QMutex> &lock, QList<QGCMapTask*> &batch);
 
-    void _saveTile(QGCMapTask *task);
-    void _getTile(QGCMapTask *task);
+    void _saveTiles(const QList<QGCMapTask*> &tasks);
+    void _getTile(QGCTileCacheDatabase *database, QGCMapTask *task);
     void _getTileSets(QGCMapTask *task);
     void _createTileSet(QGCMapTask *task);
     void _getTileDownloadList(QGCMapTask *task);
@@ -50,9 +58,19 @@ public slots:
     bool _testTask(QGCMapTask *task);
     void _emitTotals();
 
+    void _startReaders();
+    void _stopReaders();
+    void _runReader();
+    /// Closes every reader connection and holds the readers off until _resumeReaders(), for tasks that drop the
+    /// tables or replace the database file
+    void _pauseReaders();
+    void _resumeReaders();
+
     std::unique_ptr<QGCTileCacheDatabase> _database;
     QMutex _taskQueueMutex;
     QQueue<QGCMapTask*> _taskQueue;
+    /// Keys of queued, not yet committed saves; a lookup for one goes through _taskQueue so it sees the save
+    QHash<quint64, int> _pendingSaves;
     QWaitCondition _waitc;
     QString _databasePath;
     QElapsedTimer _updateTimer;
@@ -60,6 +78,22 @@ public slots:
     std::atomic_bool _dbValid = false;
     std::atomic_bool _stopRequested = false;
 
+    /// Lookup lane; everything below is guarded by _readQueueMutex
+    QMutex _readQueueMutex;
+    QQueue<QGCMapTask*> _readQueue;
+    QQueue<QGCMapTask*> _lowPriorityReadQueue;  ///< Served only while _readQueue is empty
+    QWaitCondition _readWaitc;
+    int _connectedReaders = 0;
+    bool _readersAccepting = false;  ///< Until the readers run, lookups go through the write queue
+    bool _readersPaused = false;
+    bool _readersStopping = false;
+    QList<QThread*> _readers;  ///< Owned by the worker thread
+
     static constexpr int kShortTimeoutMs = 2000;
     static constexpr int kLongTimeoutMs = 5000;
+    /// Save tasks committed in one transaction, at most
+    static constexpr qsizetype kMaxSaveBatch = 256;
+    /// How long a partial save batch waits for more tiles before committing
+    static constexpr int kSaveBatchWindowMs = 50;
+    static constexpr int kReaderThreads = 2;
 };
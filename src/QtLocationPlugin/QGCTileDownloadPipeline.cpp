@@ -0,0 +1,326 @@
+#include "QGCTileDownloadPipeline.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QFile>
+#include <QtCore/QFutureWatcher>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+
+#include "ElevationMapProvider.h"
+#include "MapProvider.h"
+#include "QGCCacheTile.h"
+#include "QGCLoggingCategory.h"
+#include "QGCMapEngine.h"
+#include "QGCMapTasks.h"
+#include "QGCMapUrlEngine.h"
+#include "QGCNetworkHelper.h"
+#include "QGeoTileFetcherQGC.h"
+
+#include <utility>
+
+QGC_LOGGING_CATEGORY(QGCTileDownloadPipelineLog, "QtLocationPlugin.QGCTileDownloadPipeline")
+
+QGCTileDownloadPipeline::QGCTileDownloadPipeline(quint64 setID, QNetworkAccessManager *networkManager, QObject *parent)
+    : QObject(parent)
+    , _setID(setID)
+    , _networkManager(networkManager)
+    , _taskSink([](QGCMapTask *task) { return getQGCMapEngine()->addTask(task); })
+    , _requestFactory([](const QGCTile &tile) { return QGeoTileFetcherQGC::getNetworkRequest(tile.type, tile.x, tile.y, tile.z); })
+{
+    qCDebug(QGCTileDownloadPipelineLog) << this;
+
+    _flushTimer.setSingleShot(true);
+    (void) connect(&_flushTimer, &QTimer::timeout, this, [this]() {
+        _flushStore();
+        _advance();
+    });
+}
+
+QGCTileDownloadPipeline::~QGCTileDownloadPipeline()
+{
+    for (QNetworkReply *reply : std::as_const(_replies)) {
+        (void) disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+    }
+    qDeleteAll(_storeQueue);
+
+    qCDebug(QGCTileDownloadPipelineLog) << this;
+}
+
+void QGCTileDownloadPipeline::start()
+{
+    if (_running) {
+        return;
+    }
+
+    _running = true;
+    _cancelled = false;
+    _listExhausted = false;
+    _advance();
+}
+
+void QGCTileDownloadPipeline::cancel()
+{
+    if (!_running || _cancelled) {
+        return;
+    }
+
+    _cancelled = true;
+
+    QList<quint64> keys;
+    keys.reserve(_fetchQueue.size() + _replies.size());
+    for (const QGCTile &tile : std::as_const(_fetchQueue)) {
+        keys.append(tile.key);
+    }
+    _fetchQueue.clear();
+
+    for (auto it = _replies.cbegin(); it != _replies.cend(); ++it) {
+        keys.append(it.key());
+        QNetworkReply *const reply = it.value();
+        (void) disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        reply->deleteLater();
+    }
+    _replies.clear();
+
+    qCDebug(QGCTileDownloadPipelineLog) << "Cancelled, returning" << keys.size() << "tiles to pending";
+    if (!keys.isEmpty()) {
+        (void) _addTask(new QGCUpdateTileDownloadStateTask(_setID, QGCTile::StatePending, keys));
+    }
+
+    _advance();
+}
+
+QString QGCTileDownloadPipeline::validateTile(const QString &type, QByteArray &image)
+{
+    if (image.isEmpty()) {
+        return QString();
+    }
+
+    const SharedMapProvider mapProvider = UrlFactory::getMapProviderFromProviderType(type);
+    if (!mapProvider) {
+        return QString();
+    }
+
+    if (mapProvider->isBingProvider()) {
+        static const QByteArray bingNoTileImage = []() {
+            QFile file(QStringLiteral(":/res/BingNoTileBytes.dat"));
+            return file.open(QFile::ReadOnly) ? file.readAll() : QByteArray();
+        }();
+        if (image == bingNoTileImage) {
+            return QString();
+        }
+    }
+
+    if (mapProvider->isElevationProvider()) {
+        const SharedElevationProvider elevationProvider = std::dynamic_pointer_cast<const ElevationProvider>(mapProvider);
+        image = elevationProvider->serialize(image);
+        if (image.isEmpty()) {
+            return QString();
+        }
+    }
+
+    return mapProvider->getImageFormat(image);
+}
+
+void QGCTileDownloadPipeline::_advance()
+{
+    if (!_running) {
+        return;
+    }
+
+    _validateTiles();
+    if ((_storeQueue.size() + _failedKeys.size()) >= _options.storeBatch) {
+        _flushStore();
+        // A receiver of the store signals may have cancelled, and that may have finished the run
+        if (!_running) {
+            return;
+        }
+    }
+    if (!_cancelled) {
+        _requestTileList();
+        _fetchTiles();
+    }
+
+    if (_idle()) {
+        _running = false;
+        _flushStore();
+        qCDebug(QGCTileDownloadPipelineLog) << "Finished" << (_cancelled ? "(cancelled)" : "");
+        emit finished(_cancelled);
+        return;
+    }
+
+    if ((!_storeQueue.isEmpty() || !_failedKeys.isEmpty()) && !_flushTimer.isActive()) {
+        _flushTimer.start(_options.storeFlushMs);
+    }
+}
+
+bool QGCTileDownloadPipeline::_idle() const
+{
+    return ((_cancelled || _listExhausted) && !_listRequested && _fetchQueue.isEmpty() && _replies.isEmpty() &&
+            _validateQueue.isEmpty() && (_validations == 0));
+}
+
+void QGCTileDownloadPipeline::_requestTileList()
+{
+    // Ask for the next list while the fetch stage still has a slot's worth of work, so it never runs dry
+    if (_listRequested || _listExhausted || (_fetchQueue.size() > _options.maxFetches)) {
+        return;
+    }
+
+    _listRequested = true;
+
+    QGCGetTileDownloadListTask *const task = new QGCGetTileDownloadListTask(_setID, _options.listBatch);
+    (void) connect(task, &QGCGetTileDownloadListTask::tileListFetched, this, &QGCTileDownloadPipeline::_tileListFetched);
+    // Queued: enqueueTask reports a refused task from inside this call
+    (void) connect(task, &QGCMapTask::error, this, [this]() {
+        _listRequested = false;
+        _listExhausted = true;
+        _advance();
+    }, Qt::QueuedConnection);
+    (void) _addTask(task);
+}
+
+void QGCTileDownloadPipeline::_tileListFetched(const QQueue<QGCTile*> &tiles)
+{
+    _listRequested = false;
+    if (tiles.size() < _options.listBatch) {
+        _listExhausted = true;
+    }
+
+    QList<quint64> returned;
+    for (QGCTile *tile : tiles) {
+        if (_cancelled) {
+            returned.append(tile->key);
+        } else {
+            _fetchQueue.enqueue(*tile);
+        }
+        delete tile;
+    }
+
+    // Listing marked these as downloading; a cancel in the meantime means they will not be
+    if (!returned.isEmpty()) {
+        (void) _addTask(new QGCUpdateTileDownloadStateTask(_setID, QGCTile::StatePending, returned));
+    }
+
+    _advance();
+}
+
+void QGCTileDownloadPipeline::_fetchTiles()
+{
+    while (!_fetchQueue.isEmpty() && (_replies.size() < _options.maxFetches) &&
+           ((_validateQueue.size() + _validations + _storeQueue.size()) < _options.maxBuffered)) {
+        const QGCTile tile = _fetchQueue.dequeue();
+
+        QNetworkRequest request = _requestFactory(tile);
+        if (!request.url().isValid()) {
+            qCWarning(QGCTileDownloadPipelineLog) << "Invalid URL for tile" << tile.key;
+            _failedKeys.append(tile.key);
+            continue;
+        }
+        request.setOriginatingObject(this);
+        request.setAttribute(QNetworkRequest::User, QVariant::fromValue(tile.key));
+
+        QNetworkReply *const reply = _networkManager->get(request);
+        reply->setParent(this);
+        QGCNetworkHelper::ignoreSslErrorsIfNeeded(reply);
+        (void) connect(reply, &QNetworkReply::finished, this, &QGCTileDownloadPipeline::_networkReplyFinished);
+        (void) _replies.insert(tile.key, reply);
+    }
+}
+
+void QGCTileDownloadPipeline::_networkReplyFinished()
+{
+    QNetworkReply *const reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply) {
+        return;
+    }
+    reply->deleteLater();
+
+    const quint64 key = reply->request().attribute(QNetworkRequest::User).toULongLong();
+    if (_replies.remove(key) == 0) {
+        return;
+    }
+
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if ((reply->error() != QNetworkReply::NoError) || !QGCNetworkHelper::isHttpSuccess(statusCode)) {
+        qCDebug(QGCTileDownloadPipelineLog) << "Error fetching tile" << key << reply->errorString();
+        _failedKeys.append(key);
+    } else {
+        _validateQueue.enqueue({key, UrlFactory::tileKeyToType(key), reply->readAll()});
+    }
+
+    _advance();
+}
+
+void QGCTileDownloadPipeline::_validateTiles()
+{
+    using Result = std::pair<FetchedTile, QString>;
+
+    while (!_validateQueue.isEmpty() && (_validations < _options.maxValidations)) {
+        FetchedTile tile = _validateQueue.dequeue();
+        _validations++;
+
+        QFutureWatcher<Result> *const watcher = new QFutureWatcher<Result>(this);
+        (void) connect(watcher, &QFutureWatcher<Result>::finished, this, [this, watcher]() {
+            const Result result = watcher->result();
+            watcher->deleteLater();
+            _validations--;
+            _validated(result.first, result.second);
+            _advance();
+        });
+        watcher->setFuture(QtConcurrent::run([tile = std::move(tile)]() mutable {
+            const QString format = validateTile(tile.type, tile.image);
+            return Result(std::move(tile), format);
+        }));
+    }
+}
+
+void QGCTileDownloadPipeline::_validated(const FetchedTile &tile, const QString &format)
+{
+    if (format.isEmpty()) {
+        qCWarning(QGCTileDownloadPipelineLog) << "Rejected tile" << tile.key << "of" << tile.image.size() << "bytes";
+        _failedKeys.append(tile.key);
+        return;
+    }
+
+    _storeQueue.append(new QGCCacheTile(tile.key, tile.image, format, tile.type, _setID));
+}
+
+void QGCTileDownloadPipeline::_flushStore()
+{
+    _flushTimer.stop();
+
+    // The worker commits consecutive saves in one transaction; the state update behind them runs once they are in
+    if (!_storeQueue.isEmpty()) {
+        QList<quint64> keys;
+        keys.reserve(_storeQueue.size());
+        quint64 bytes = 0;
+        for (QGCCacheTile *tile : std::as_const(_storeQueue)) {
+            keys.append(tile->key);
+            bytes += tile->img.size();
+            (void) _addTask(new QGCSaveTileTask(tile));
+        }
+        _storeQueue.clear();
+
+        (void) _addTask(new QGCUpdateTileDownloadStateTask(_setID, QGCTile::StateComplete, keys));
+        emit tilesStored(static_cast<quint32>(keys.size()), bytes);
+    }
+
+    if (!_failedKeys.isEmpty()) {
+        const QList<quint64> keys = std::exchange(_failedKeys, {});
+        (void) _addTask(new QGCUpdateTileDownloadStateTask(_setID, QGCTile::StateError, keys));
+        emit tilesFailed(static_cast<quint32>(keys.size()));
+    }
+}
+
+bool QGCTileDownloadPipeline::_addTask(QGCMapTask *task)
+{
+    (void) connect(task, &QGCMapTask::error, this, &QGCTileDownloadPipeline::taskError);
+    if (!_taskSink(task)) {
+        task->deleteLater();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QQueue>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkRequest>
+
+#include <functional>
+
+#include "QGCMapTaskBase.h"
+#include "QGCTile.h"
+
+struct QGCCacheTile;
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/// Downloads the pending tiles of an offline tile set in three stages joined by bounded queues: fetch (many
+/// replies in flight), validate (decode checks on the thread pool) and store (saves and download-state updates
+/// handed to the cache worker in batches). The fetch stage pauses whenever the later stages fall behind, so memory
+/// stays bounded however large the set is. Progress lives in the TilesDownload table: stored tiles are removed
+/// from it and cancelled ones go back to pending, so a new start picks up where the last one stopped.
+class QGCTileDownloadPipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options
+    {
+        int maxFetches = 24;        ///< Replies in flight; QNetworkAccessManager spreads them over its per-host connections
+        int maxValidations = 4;     ///< Tiles being validated on the thread pool
+        int listBatch = 256;        ///< Tiles per download list request
+        int storeBatch = 64;        ///< Tiles per store flush
+        int storeFlushMs = 250;     ///< Longest a validated tile waits for its batch to fill
+        int maxBuffered = 256;      ///< Fetched tiles waiting to be validated or stored before fetching pauses
+    };
+
+    using TaskSink = std::function<bool(QGCMapTask*)>;
+    using RequestFactory = std::function<QNetworkRequest(const QGCTile&)>;
+
+    QGCTileDownloadPipeline(quint64 setID, QNetworkAccessManager *networkManager, QObject *parent = nullptr);
+    ~QGCTileDownloadPipeline();
+
+    void setOptions(const Options &options) { if (!_running) { _options = options; } }
+    /// Where cache tasks go; the map engine by default
+    void setTaskSink(TaskSink sink) { _taskSink = std::move(sink); }
+    /// Builds the request for a tile; the provider's tile URL by default
+    void setRequestFactory(RequestFactory factory) { _requestFactory = std::move(factory); }
+
+    void start();
+    /// Stops fetching and returns unfinished tiles to pending. Tiles already downloaded are still stored; finished()
+    /// follows once they are.
+    void cancel();
+    bool running() const { return _running; }
+
+    /// Rejects what the provider sends in place of a missing tile and returns the image format, or an empty string.
+    /// Elevation tiles are converted to their cached form in @p image. Safe to call from any thread.
+    static QString validateTile(const QString &type, QByteArray &image);
+
+signals:
+    void tilesStored(quint32 count, quint64 bytes);
+    void tilesFailed(quint32 count);
+    void finished(bool cancelled);
+    void taskError(QGCMapTask::TaskType type, const QString &errorString);
+
+private slots:
+    void _tileListFetched(const QQueue<QGCTile*> &tiles);
+    void _networkReplyFinished();
+
+private:
+    struct FetchedTile
+    {
+        quint64 key = 0;
+        QString type;
+        QByteArray image;
+    };
+
+    void _advance();
+    void _requestTileList();
+    void _fetchTiles();
+    void _validateTiles();
+    void _validated(const FetchedTile &tile, const QString &format);
+    void _flushStore();
+    bool _addTask(QGCMapTask *task);
+    bool _idle() const;
+
+    const quint64 _setID;
+    QNetworkAccessManager *const _networkManager;
+    Options _options;
+    TaskSink _taskSink;
+    RequestFactory _requestFactory;
+
+    QQueue<QGCTile> _fetchQueue;                ///< Listed, waiting for a fetch slot
+    QHash<quint64, QNetworkReply*> _replies;    ///< Being fetched
+    QQueue<FetchedTile> _validateQueue;         ///< Fetched, waiting for a validation slot
+    int _validations = 0;                       ///< Being validated
+    QList<QGCCacheTile*> _storeQueue;           ///< Validated, waiting for the next flush
+    QList<quint64> _failedKeys;                 ///< Failed, waiting for the next flush
+    QTimer _flushTimer;
+
+    bool _running = false;
+    bool _cancelled = false;
+    bool _listRequested = false;
+    bool _listExhausted = false;
+};
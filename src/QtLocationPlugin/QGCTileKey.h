@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QtCore/QStringView>
+#include <QtCore/QtTypes>
+
+#include <optional>
+
+/// \brief Packed cache key of a map tile.
+///
+/// Provider map id, zoom, x and y in one integer: y in bits 0-23, x in bits 24-47, zoom in bits 48-53 and the
+/// provider in bits 54-62. Bit 63 stays clear so keys round-trip through SQLite's signed INTEGER.
+namespace QGCTileKey {
+
+inline constexpr int kCoordBits = 24;
+inline constexpr int kZoomBits = 6;
+inline constexpr int kProviderBits = 9;
+
+inline constexpr int kXShift = kCoordBits;
+inline constexpr int kZoomShift = 2 * kCoordBits;
+inline constexpr int kProviderShift = kZoomShift + kZoomBits;
+
+inline constexpr quint64 kCoordMask = (1ULL << kCoordBits) - 1;
+inline constexpr quint64 kZoomMask = (1ULL << kZoomBits) - 1;
+inline constexpr quint64 kProviderMask = (1ULL << kProviderBits) - 1;
+
+/// Stands for every tile of a set, e.g. when resetting download states; never a real key
+inline constexpr quint64 kAllTiles = UINT64_MAX;
+
+constexpr quint64 make(int providerId, int x, int y, int z)
+{
+    return ((static_cast<quint64>(providerId) & kProviderMask) << kProviderShift) |
+           ((static_cast<quint64>(z) & kZoomMask) << kZoomShift) |
+           ((static_cast<quint64>(x) & kCoordMask) << kXShift) |
+           (static_cast<quint64>(y) & kCoordMask);
+}
+
+constexpr int providerId(quint64 key) { return static_cast<int>((key >> kProviderShift) & kProviderMask); }
+constexpr int zoom(quint64 key) { return static_cast<int>((key >> kZoomShift) & kZoomMask); }
+constexpr int x(quint64 key) { return static_cast<int>((key >> kXShift) & kCoordMask); }
+constexpr int y(quint64 key) { return static_cast<int>(key & kCoordMask); }
+
+/// Converts a TEXT hash of schema version 1 ("%010d%08d%08d%03d": provider, x, y, zoom)
+inline std::optional<quint64> fromLegacyHash(QStringView hash)
+{
+    if (hash.size() != 29) {
+        return std::nullopt;
+    }
+
+    bool providerOk = false;
+    bool xOk = false;
+    bool yOk = false;
+    bool zoomOk = false;
+    const int provider = hash.sliced(0, 10).toInt(&providerOk);
+    const int tileX = hash.sliced(10, 8).toInt(&xOk);
+    const int tileY = hash.sliced(18, 8).toInt(&yOk);
+    const int tileZoom = hash.sliced(26, 3).toInt(&zoomOk);
+    if (!providerOk || !xOk || !yOk || !zoomOk) {
+        return std::nullopt;
+    }
+
+    return make(provider, tileX, tileY, tileZoom);
+}
+
+/// SQL expression computing make() from a legacy TEXT hash column, for migrating whole tables at once
+inline constexpr const char *kLegacyHashSql =
+    "(((CAST(substr(%1, 1, 10) AS INTEGER) & 511) << 54) | "
+    "((CAST(substr(%1, 27, 3) AS INTEGER) & 63) << 48) | "
+    "((CAST(substr(%1, 11, 8) AS INTEGER) & 16777215) << 24) | "
+    "(CAST(substr(%1, 19, 8) AS INTEGER) & 16777215))";
+
+}  // namespace QGCTileKey
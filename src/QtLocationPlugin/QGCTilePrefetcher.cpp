@@ -0,0 +1,478 @@
+#include "QGCTilePrefetcher.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QHashFunctions>
+#include <QtCore/QtNumeric>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+
+#include "AppSettings.h"
+#include "MapProvider.h"
+#include "MapsSettings.h"
+#include "QGCCacheTile.h"
+#include "QGCLoggingCategory.h"
+#include "QGCMapEngine.h"
+#include "QGCMapTasks.h"
+#include "QGCMapUrlEngine.h"
+#include "QGCNetworkHelper.h"
+#include "QGCTileKey.h"
+#include "QGeoFileTileCacheQGC.h"
+#include "QGeoTileFetcherQGC.h"
+#include "SettingsManager.h"
+
+#include <cmath>
+
+QGC_LOGGING_CATEGORY(QGCTilePrefetcherLog, "QtLocationPlugin.QGCTilePrefetcher")
+
+QGCTilePrefetcher::QGCTilePrefetcher(QObject *parent)
+    : QObject(parent)
+{
+    qCDebug(QGCTilePrefetcherLog) << this;
+
+    _rebuildTimer.setSingleShot(true);
+    _rebuildTimer.setInterval(kRebuildDelayMs);
+    (void) connect(&_rebuildTimer, &QTimer::timeout, this, &QGCTilePrefetcher::_rebuildQueue);
+
+    _budgetTimer.setSingleShot(true);
+    (void) connect(&_budgetTimer, &QTimer::timeout, this, &QGCTilePrefetcher::_pump);
+
+    _statisticsTimer.setSingleShot(true);
+    _statisticsTimer.setInterval(kStatisticsIntervalMs);
+    (void) connect(&_statisticsTimer, &QTimer::timeout, this, [this]() {
+        qCDebug(QGCTilePrefetcherLog) << "View lookups:" << _viewLookups << "hit rate:" << hitRate()
+                                      << "prefetched hits:" << _prefetchedHits << "prefetched:" << _tilesPrefetched
+                                      << "tiles," << _bytesPrefetched << "bytes, pending:" << pendingTiles();
+        emit statisticsChanged();
+    });
+
+    _bandwidthClock.start();
+}
+
+QGCTilePrefetcher::~QGCTilePrefetcher()
+{
+    _abortAll();
+
+    qCDebug(QGCTilePrefetcherLog) << this;
+}
+
+void QGCTilePrefetcher::setMapType(const QString &type)
+{
+    if (type == _mapType) {
+        return;
+    }
+
+    _mapType = type;
+    _vehicleTrackSignature = 0;
+    _scheduleRebuild();
+}
+
+void QGCTilePrefetcher::setZoomLevel(int zoom)
+{
+    zoom = qBound(1, zoom, QGC_MAX_MAP_ZOOM);
+    if (zoom == _zoom) {
+        return;
+    }
+
+    _zoom = zoom;
+    _vehicleTrackSignature = 0;
+    _scheduleRebuild();
+}
+
+void QGCTilePrefetcher::setMissionPath(const QList<QGeoCoordinate> &path)
+{
+    if (path == _missionPath) {
+        return;
+    }
+
+    _missionPath = path;
+    _scheduleRebuild();
+}
+
+void QGCTilePrefetcher::setVehicleTrack(const QGeoCoordinate &position, double heading, double groundSpeed)
+{
+    const QList<QGeoCoordinate> track = predictTrack(position, heading, groundSpeed, kTrackHorizonSecs);
+    if (track.isEmpty()) {
+        clearVehicleTrack();
+        return;
+    }
+
+    // Vehicle updates arrive several times a second; the track only needs rebuilding once the vehicle enters a new
+    // tile, turns or changes speed noticeably
+    const SharedMapProvider provider = UrlFactory::getMapProviderFromProviderType(_mapType);
+    const int tileX = provider ? provider->long2tileX(position.longitude(), _zoom) : 0;
+    const int tileY = provider ? provider->lat2tileY(position.latitude(), _zoom) : 0;
+    const int headingBucket = static_cast<int>(heading / kTrackHeadingBucket);
+    const int speedBucket = static_cast<int>(std::log2(groundSpeed));
+    const size_t signature = qHashMulti(1, tileX, tileY, headingBucket, speedBucket);
+    if (signature == _vehicleTrackSignature) {
+        return;
+    }
+
+    _vehicleTrackSignature = signature;
+    _vehicleTrack = track;
+    _scheduleRebuild();
+}
+
+void QGCTilePrefetcher::clearVehicleTrack()
+{
+    if (_vehicleTrack.isEmpty()) {
+        return;
+    }
+
+    _vehicleTrack.clear();
+    _vehicleTrackSignature = 0;
+    _scheduleRebuild();
+}
+
+void QGCTilePrefetcher::recordViewLookup(quint64 key, bool hit)
+{
+    _viewLookups++;
+    if (hit) {
+        _viewHits++;
+        // A prefetched tile counts once, the first time the map shows it
+        if (_prefetched.remove(key)) {
+            _prefetchedHits++;
+        }
+    }
+
+    _statisticsUpdated();
+}
+
+void QGCTilePrefetcher::resetStatistics()
+{
+    _viewLookups = 0;
+    _viewHits = 0;
+    _prefetchedHits = 0;
+    _tilesPrefetched = 0;
+    _bytesPrefetched = 0;
+    _prefetched.clear();
+
+    emit statisticsChanged();
+}
+
+QList<quint64> QGCTilePrefetcher::tilesAlongPath(QStringView type, const QList<QGeoCoordinate> &path, int zoom, int margin, qsizetype maxTiles)
+{
+    QList<quint64> keys;
+
+    const SharedMapProvider provider = UrlFactory::getMapProviderFromProviderType(type);
+    if (!provider || provider->isElevationProvider() || path.isEmpty() || (zoom < 1) || (zoom > QGC_MAX_MAP_ZOOM)) {
+        return keys;
+    }
+
+    const int providerHash = UrlFactory::hashFromProviderType(type);
+    const int maxIndex = (1 << zoom) - 1;
+    QSet<quint64> seen;
+
+    // Returns false once maxTiles is reached
+    const auto addTile = [&](const QGeoCoordinate &coord) -> bool {
+        const int tileX = provider->long2tileX(coord.longitude(), zoom);
+        const int tileY = provider->lat2tileY(coord.latitude(), zoom);
+        for (int y = qMax(0, tileY - margin); y <= qMin(maxIndex, tileY + margin); y++) {
+            for (int x = qMax(0, tileX - margin); x <= qMin(maxIndex, tileX + margin); x++) {
+                const quint64 key = QGCTileKey::make(providerHash, x, y, zoom);
+                if (seen.contains(key)) {
+                    continue;
+                }
+                (void) seen.insert(key);
+                keys.append(key);
+                if (keys.size() >= maxTiles) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    if (!path.first().isValid() || !addTile(path.first())) {
+        return keys;
+    }
+
+    for (qsizetype i = 1; i < path.size(); i++) {
+        const QGeoCoordinate &from = path.at(i - 1);
+        const QGeoCoordinate &to = path.at(i);
+        if (!from.isValid() || !to.isValid()) {
+            continue;
+        }
+
+        // Two samples per tile crossed, so a diagonal step can't skip a tile
+        const int spanX = qAbs(provider->long2tileX(to.longitude(), zoom) - provider->long2tileX(from.longitude(), zoom));
+        const int spanY = qAbs(provider->lat2tileY(to.latitude(), zoom) - provider->lat2tileY(from.latitude(), zoom));
+        const int steps = qMax(1, 2 * qMax(spanX, spanY));
+        const double distance = from.distanceTo(to);
+        const double azimuth = from.azimuthTo(to);
+        for (int step = 1; step <= steps; step++) {
+            const QGeoCoordinate coord = (step == steps) ? to : from.atDistanceAndAzimuth(distance * step / steps, azimuth);
+            if (!addTile(coord)) {
+                return keys;
+            }
+        }
+    }
+
+    return keys;
+}
+
+QList<QGeoCoordinate> QGCTilePrefetcher::predictTrack(const QGeoCoordinate &position, double heading, double groundSpeed, double horizonSecs)
+{
+    if (!position.isValid() || !qIsFinite(heading) || !qIsFinite(groundSpeed) || (groundSpeed < kMinTrackSpeed)) {
+        return {};
+    }
+
+    return { position, position.atDistanceAndAzimuth(groundSpeed * horizonSecs, heading) };
+}
+
+void QGCTilePrefetcher::_scheduleRebuild()
+{
+    if (!_rebuildTimer.isActive()) {
+        _rebuildTimer.start();
+    }
+}
+
+void QGCTilePrefetcher::_rebuildQueue()
+{
+    _queue.clear();
+    _downloadQueue.clear();
+
+    if (!_enabled() || _mapType.isEmpty() || (_zoom < 1)) {
+        _statisticsUpdated();
+        return;
+    }
+
+    if (_visited.size() > kMaxTrackedKeys) {
+        _visited.clear();
+    }
+
+    // Nearest first: the vehicle's track, then the mission, each at the map's zoom before the levels either side
+    struct Pass {
+        const QList<QGeoCoordinate> &path;
+        int zoom;
+        int margin;
+    };
+    const Pass passes[] = {
+        { _vehicleTrack, _zoom, kCorridorTiles },
+        { _missionPath, _zoom, kCorridorTiles },
+        { _vehicleTrack, _zoom + 1, 0 },
+        { _vehicleTrack, _zoom - 1, kCorridorTiles },
+        { _missionPath, _zoom + 1, 0 },
+        { _missionPath, _zoom - 1, kCorridorTiles },
+    };
+
+    QSet<quint64> queued;
+    for (const Pass &pass : passes) {
+        const QList<quint64> keys = tilesAlongPath(_mapType, pass.path, pass.zoom, pass.margin, kMaxTilesPerPath);
+        for (const quint64 key : keys) {
+            if (!_visited.contains(key) && !_replies.contains(key) && !queued.contains(key)) {
+                (void) queued.insert(key);
+                _queue.enqueue(key);
+            }
+        }
+    }
+
+    qCDebug(QGCTilePrefetcherLog) << "Queued" << _queue.size() << "tiles for" << _mapType << "at zoom" << _zoom;
+
+    _statisticsUpdated();
+    _pump();
+}
+
+bool QGCTilePrefetcher::_enabled() const
+{
+    SettingsManager *const settingsManager = SettingsManager::instance();
+    if (settingsManager->appSettings()->disableAllPersistence()->rawValue().toBool()) {
+        return false;
+    }
+
+    // Archive map types are never downloaded
+    const SharedMapProvider provider = UrlFactory::getMapProviderFromProviderType(_mapType);
+    if (provider && provider->isArchiveProvider()) {
+        return false;
+    }
+
+    return settingsManager->mapsSettings()->prefetchTiles()->rawValue().toBool();
+}
+
+void QGCTilePrefetcher::_pump()
+{
+    if (!_enabled()) {
+        _abortAll();
+        return;
+    }
+
+    while ((_lookups.size() < kMaxLookupsInFlight) && !_queue.isEmpty()) {
+        const quint64 key = _queue.dequeue();
+        if (_visited.contains(key)) {
+            continue;
+        }
+        (void) _visited.insert(key);
+
+        QGCFetchTileTask *const task = new QGCFetchTileTask(key, true);
+        (void) connect(task, &QGCFetchTileTask::tileFetched, this, [this, key](QGCCacheTile *tile) {
+            delete tile;
+            _lookupFinished(key, true);
+        });
+        (void) connect(task, &QGCMapTask::error, this, [this, key]() {
+            _lookupFinished(key, false);
+        });
+        if (!getQGCMapEngine()->addTask(task)) {
+            // The cache isn't up yet; the next rebuild tries again
+            task->deleteLater();
+            (void) _visited.remove(key);
+            break;
+        }
+        // Only now, so the error a rejected task reports synchronously is ignored
+        (void) _lookups.insert(key);
+    }
+
+    _pumpDownloads();
+}
+
+void QGCTilePrefetcher::_lookupFinished(quint64 key, bool cached)
+{
+    if (!_lookups.remove(key)) {
+        return;
+    }
+
+    if (!cached) {
+        _downloadQueue.enqueue(key);
+    }
+
+    _pump();
+}
+
+void QGCTilePrefetcher::_pumpDownloads()
+{
+    if (_downloadQueue.isEmpty() || (_replies.size() >= kMaxDownloadsInFlight)) {
+        return;
+    }
+
+    if (_sessionBytes >= _diskBudgetBytes()) {
+        if (!_diskBudgetReported) {
+            _diskBudgetReported = true;
+            qCDebug(QGCTilePrefetcherLog) << "Disk budget reached after" << _sessionBytes << "bytes";
+        }
+        _downloadQueue.clear();
+        return;
+    }
+
+    if (!QGCNetworkHelper::isInternetAvailable()) {
+        _downloadQueue.clear();
+        return;
+    }
+
+    if (!_networkManager) {
+        _networkManager = new QNetworkAccessManager(this);
+        QGCNetworkHelper::configureProxy(_networkManager);
+    }
+
+    while ((_replies.size() < kMaxDownloadsInFlight) && !_downloadQueue.isEmpty()) {
+        const qint64 delayMs = _bandwidthDelayMs();
+        if (delayMs > 0) {
+            if (!_budgetTimer.isActive()) {
+                _budgetTimer.start(static_cast<int>(delayMs));
+            }
+            return;
+        }
+
+        const quint64 key = _downloadQueue.dequeue();
+        const int mapId = UrlFactory::getQtMapIdFromProviderType(UrlFactory::tileKeyToType(key));
+        QNetworkRequest request = QGeoTileFetcherQGC::getNetworkRequest(mapId, QGCTileKey::x(key), QGCTileKey::y(key), QGCTileKey::zoom(key));
+        if (!request.url().isValid()) {
+            continue;
+        }
+        request.setPriority(QNetworkRequest::LowPriority);
+        request.setOriginatingObject(this);
+        request.setAttribute(QNetworkRequest::User, QVariant::fromValue(key));
+
+        QNetworkReply *const reply = _networkManager->get(request);
+        reply->setParent(this);
+        QGCNetworkHelper::ignoreSslErrorsIfNeeded(reply);
+        (void) connect(reply, &QNetworkReply::finished, this, &QGCTilePrefetcher::_networkReplyFinished);
+        (void) _replies.insert(key, reply);
+    }
+}
+
+void QGCTilePrefetcher::_networkReplyFinished()
+{
+    QNetworkReply *const reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply) {
+        return;
+    }
+    reply->deleteLater();
+
+    const quint64 key = reply->request().attribute(QNetworkRequest::User).toULongLong();
+    (void) _replies.remove(key);
+
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if ((reply->error() != QNetworkReply::NoError) || !QGCNetworkHelper::isHttpSuccess(statusCode)) {
+        qCDebug(QGCTilePrefetcherLog) << "Download failed for tile" << key << reply->errorString();
+        _pump();
+        return;
+    }
+
+    const QByteArray image = reply->readAll();
+    _bandwidthTokens -= image.size();
+
+    const QString type = UrlFactory::tileKeyToType(key);
+    const SharedMapProvider mapProvider = UrlFactory::getMapProviderFromProviderType(type);
+    if (!image.isEmpty() && mapProvider) {
+        static const QByteArray bingNoTileImage = []() {
+            QFile file(QStringLiteral(":/res/BingNoTileBytes.dat"));
+            return file.open(QFile::ReadOnly) ? file.readAll() : QByteArray();
+        }();
+
+        const QString format = mapProvider->getImageFormat(image);
+        if (!format.isEmpty() && !(mapProvider->isBingProvider() && (image == bingNoTileImage))) {
+            QGeoFileTileCacheQGC::cacheTile(type, key, image, format);
+            (void) _prefetched.insert(key);
+            if (_prefetched.size() > kMaxTrackedKeys) {
+                _prefetched.clear();
+            }
+            _tilesPrefetched++;
+            _bytesPrefetched += image.size();
+            _sessionBytes += image.size();
+            _statisticsUpdated();
+        }
+    }
+
+    _pump();
+}
+
+qint64 QGCTilePrefetcher::_bandwidthDelayMs()
+{
+    // Token bucket holding at most one second of transfer
+    const qint64 rate = qMax<qint64>(1, SettingsManager::instance()->mapsSettings()->prefetchBandwidth()->rawValue().toLongLong() * 1024);
+    _bandwidthTokens = qMin(rate, _bandwidthTokens + ((rate * _bandwidthClock.restart()) / 1000));
+    if (_bandwidthTokens > 0) {
+        return 0;
+    }
+
+    return qMax<qint64>(1, (-_bandwidthTokens * 1000) / rate);
+}
+
+quint64 QGCTilePrefetcher::_diskBudgetBytes() const
+{
+    constexpr quint64 kMegabyte = 1024 * 1024;
+    const quint64 budget = SettingsManager::instance()->mapsSettings()->prefetchDiskBudget()->rawValue().toULongLong() * kMegabyte;
+    const quint64 cacheShare = (static_cast<quint64>(QGeoFileTileCacheQGC::getMaxDiskCacheSetting()) * kMegabyte) / kDiskCacheShareDivisor;
+    return qMin(budget, cacheShare);
+}
+
+void QGCTilePrefetcher::_statisticsUpdated()
+{
+    if (!_statisticsTimer.isActive()) {
+        _statisticsTimer.start();
+    }
+}
+
+void QGCTilePrefetcher::_abortAll()
+{
+    _queue.clear();
+    _downloadQueue.clear();
+    _budgetTimer.stop();
+
+    const QList<QNetworkReply*> replies = _replies.values();
+    _replies.clear();
+    for (QNetworkReply *reply : replies) {
+        (void) disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        reply->deleteLater();
+    }
+}
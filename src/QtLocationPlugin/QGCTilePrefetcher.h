@@ -0,0 +1,119 @@
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QQueue>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <QtPositioning/QGeoCoordinate>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/// Downloads map tiles before the map asks for them: ahead of the vehicle on its current track and along the
+/// planned mission path, at the map's zoom and the levels either side. Cache lookups go through the worker's
+/// low-priority lane and downloads are throttled to the prefetch bandwidth and disk budgets, so the visible map
+/// always comes first. View lookups are counted so the hit rate shows whether prefetching pays off.
+class QGCTilePrefetcher : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(quint32  viewLookups     READ viewLookups        NOTIFY statisticsChanged)
+    Q_PROPERTY(quint32  viewHits        READ viewHits           NOTIFY statisticsChanged)
+    Q_PROPERTY(quint32  prefetchedHits  READ prefetchedHits     NOTIFY statisticsChanged)
+    Q_PROPERTY(double   hitRate         READ hitRate            NOTIFY statisticsChanged)
+    Q_PROPERTY(quint32  tilesPrefetched READ tilesPrefetched    NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64  bytesPrefetched READ bytesPrefetched    NOTIFY statisticsChanged)
+    Q_PROPERTY(int      pendingTiles    READ pendingTiles       NOTIFY statisticsChanged)
+
+public:
+    explicit QGCTilePrefetcher(QObject *parent = nullptr);
+    ~QGCTilePrefetcher();
+
+    void setMapType(const QString &type);
+    void setZoomLevel(int zoom);
+    void setMissionPath(const QList<QGeoCoordinate> &path);
+    /// @param heading degrees true
+    /// @param groundSpeed m/s
+    void setVehicleTrack(const QGeoCoordinate &position, double heading, double groundSpeed);
+    void clearVehicleTrack();
+
+    /// Called for every tile the map looks up in the cache
+    void recordViewLookup(quint64 key, bool hit);
+    Q_INVOKABLE void resetStatistics();
+
+    quint32 viewLookups() const { return _viewLookups; }
+    quint32 viewHits() const { return _viewHits; }
+    quint32 prefetchedHits() const { return _prefetchedHits; }
+    double hitRate() const { return (_viewLookups > 0) ? (static_cast<double>(_viewHits) / _viewLookups) : 0.; }
+    quint32 tilesPrefetched() const { return _tilesPrefetched; }
+    quint64 bytesPrefetched() const { return _bytesPrefetched; }
+    int pendingTiles() const { return static_cast<int>(_queue.size() + _downloadQueue.size() + _lookups.size() + _replies.size()); }
+
+    /// Keys of the tiles covering @p path at @p zoom, in path order, widened by @p margin tiles on every side.
+    /// Stops after @p maxTiles keys.
+    static QList<quint64> tilesAlongPath(QStringView type, const QList<QGeoCoordinate> &path, int zoom, int margin, qsizetype maxTiles);
+    /// Where the vehicle will be over the next @p horizonSecs; empty while it is too slow for a track to matter
+    static QList<QGeoCoordinate> predictTrack(const QGeoCoordinate &position, double heading, double groundSpeed, double horizonSecs);
+
+signals:
+    void statisticsChanged();
+
+private slots:
+    void _rebuildQueue();
+    void _pump();
+    void _networkReplyFinished();
+
+private:
+    bool _enabled() const;
+    void _lookupFinished(quint64 key, bool cached);
+    void _pumpDownloads();
+    qint64 _bandwidthDelayMs();
+    quint64 _diskBudgetBytes() const;
+    void _scheduleRebuild();
+    void _statisticsUpdated();
+    void _abortAll();
+
+    QString _mapType;
+    int _zoom = 0;
+    QList<QGeoCoordinate> _missionPath;
+    QList<QGeoCoordinate> _vehicleTrack;
+    size_t _vehicleTrackSignature = 0;
+
+    QQueue<quint64> _queue;             ///< Waiting for a cache lookup
+    QQueue<quint64> _downloadQueue;     ///< Not cached, waiting for a download
+    QSet<quint64> _visited;             ///< Looked up or downloaded this session
+    QSet<quint64> _prefetched;          ///< Downloaded by us and not yet shown by the map
+    QSet<quint64> _lookups;             ///< Cache lookups in flight
+    QHash<quint64, QNetworkReply*> _replies;
+    QNetworkAccessManager *_networkManager = nullptr;
+
+    QTimer _rebuildTimer;
+    QTimer _budgetTimer;
+    QTimer _statisticsTimer;
+    QElapsedTimer _bandwidthClock;
+    qint64 _bandwidthTokens = 0;
+    quint64 _sessionBytes = 0;
+    bool _diskBudgetReported = false;
+
+    quint32 _viewLookups = 0;
+    quint32 _viewHits = 0;
+    quint32 _prefetchedHits = 0;
+    quint32 _tilesPrefetched = 0;
+    quint64 _bytesPrefetched = 0;
+
+    static constexpr int kMaxLookupsInFlight = 4;
+    /// Below QGeoTileFetcherQGC::concurrentDownloads() so the map keeps most of the connections to a host
+    static constexpr int kMaxDownloadsInFlight = 2;
+    static constexpr int kCorridorTiles = 1;
+    static constexpr qsizetype kMaxTilesPerPath = 2048;
+    static constexpr qsizetype kMaxTrackedKeys = 65536;
+    static constexpr double kTrackHorizonSecs = 60.;
+    static constexpr double kMinTrackSpeed = 2.;
+    static constexpr double kTrackHeadingBucket = 15.;
+    static constexpr int kRebuildDelayMs = 250;
+    static constexpr int kStatisticsIntervalMs = 1000;
+    static constexpr quint64 kDiskCacheShareDivisor = 4;   ///< Never fill more than this fraction of the disk cache
+};
@@ -88,15 +88,15 @@ quint32 QGeoFileTileCacheQGC::getMaxDiskCacheSetting()
 
 void QGeoFileTileCacheQGC::cacheTile(const QString &type, int x, int y, int z, const QByteArray &image, const QString &format, qulonglong set)
 {
-    const QString hash = UrlFactory::getTileHash(type, x, y, z);
-    cacheTile(type, hash, image, format, set);
+    const quint64 key = UrlFactory::getTileKey(type, x, y, z);
+    cacheTile(type, key, image, format, set);
 }
 
-void QGeoFileTileCacheQGC::cacheTile(const QString &type, const QString &hash, const QByteArray &image, const QString &format, qulonglong set)
+void QGeoFileTileCacheQGC::cacheTile(const QString &type, quint64 key, const QByteArray &image, const QString &format, qulonglong set)
 {
     AppSettings *appSettings = SettingsManager::instance()->appSettings();
     if (!appSettings->disableAllPersistence()->rawValue().toBool()) {
-        QGCCacheTile *tile = new QGCCacheTile(hash, image, format, type, set);
+        QGCCacheTile *tile = new QGCCacheTile(key, image, format, type, set);
         QGCSaveTileTask *task = new QGCSaveTileTask(tile);
         if (!getQGCMapEngine()->addTask(task)) {
             task->deleteLater();
@@ -106,8 +106,8 @@ void QGeoFileTileCacheQGC::cacheTile(const QString &type, const QString &hash, c
 
 QGCFetchTileTask* QGeoFileTileCacheQGC::createFetchTileTask(const QString &type, int x, int y, int z)
 {
-    const QString hash = UrlFactory::getTileHash(type, x, y, z);
-    QGCFetchTileTask *task = new QGCFetchTileTask(hash);
+    const quint64 key = UrlFactory::getTileKey(type, x, y, z);
+    QGCFetchTileTask *task = new QGCFetchTileTask(key);
     return task;
 }
 
@@ -13,7 +13,9 @@
 #include "QGCMapTasks.h"
 #include "QGCMapUrlEngine.h"
 #include "QGCNetworkHelper.h"
+#include "QGCTilePrefetcher.h"
 #include "QGeoFileTileCacheQGC.h"
+#include "TileArchiveMapProvider.h"
 
 QGC_LOGGING_CATEGORY(QGeoTiledMapReplyQGCLog, "QtLocationPlugin.QGeoTiledMapReplyQGC")
 
@@ -181,6 +183,7 @@ void QGeoTiledMapReplyQGC::_networkReplySslErrors(const QList<QSslError> &errors
 void QGeoTiledMapReplyQGC::_cacheReply(QGCCacheTile *tile)
 {
     if (tile) {
+        getQGCMapEngine()->prefetcher()->recordViewLookup(tile->key, true);
         setMapImageData(tile->img);
         setMapImageFormat(tile->format);
         setCached(true);
@@ -197,6 +200,27 @@ void QGeoTiledMapReplyQGC::_cacheError(QGCMapTask::TaskType type, QStringView er
 
     Q_ASSERT(type == QGCMapTask::TaskType::taskFetchTile);
 
+    const QGeoTileSpec &spec = tileSpec();
+    const QString mapType = UrlFactory::getProviderTypeFromQtMapId(spec.mapId());
+
+    // Tile archives sit between the live cache and the network
+    QString format;
+    const QByteArray archived = TileArchiveMapProvider::archivedTile(mapType, spec.x(), spec.y(), spec.zoom(), format);
+    getQGCMapEngine()->prefetcher()->recordViewLookup(UrlFactory::getTileKey(mapType, spec.x(), spec.y(), spec.zoom()), !archived.isEmpty());
+    if (!archived.isEmpty()) {
+        setMapImageData(archived);
+        setMapImageFormat(format);
+        setCached(true);
+        setFinished(true);
+        return;
+    }
+
+    const SharedMapProvider mapProvider = UrlFactory::getMapProviderFromQtMapId(spec.mapId());
+    if (mapProvider && mapProvider->isArchiveProvider()) {
+        setError(QGeoTiledMapReply::UnknownError, tr("Tile Not In Archive"));
+        return;
+    }
+
     if (!QGCNetworkHelper::isInternetAvailable()) {
         setError(QGeoTiledMapReply::CommunicationError, tr("Network Not Available"));
         return;
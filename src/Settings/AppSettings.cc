@@ -239,6 +239,7 @@ void AppSettings::_checkSavePathDirectories(void)
         QGCFileHelper::ensureDirectoryExists(QGCFileHelper::joinPath(savePath, crashDirectory));
         QGCFileHelper::ensureDirectoryExists(QGCFileHelper::joinPath(savePath, mavlinkActionsDirectory));
         QGCFileHelper::ensureDirectoryExists(QGCFileHelper::joinPath(savePath, settingsDirectory));
+        QGCFileHelper::ensureDirectoryExists(QGCFileHelper::joinPath(savePath, tileArchiveDirectory));
     }
 }
 
@@ -307,6 +308,11 @@ QString AppSettings::settingsSavePath(void)
     return _childSavePath(settingsDirectory);
 }
 
+QString AppSettings::tileArchiveSavePath(void)
+{
+    return _childSavePath(tileArchiveDirectory);
+}
+
 QList<int> AppSettings::firstRunPromptsIdsVariantToList(const QVariant& firstRunPromptIds)
 {
     QList<int> rgIds;
@@ -68,6 +68,7 @@ class AppSettings : public SettingsGroup
     Q_PROPERTY(QString crashSavePath            READ crashSavePath              NOTIFY savePathsChanged)
     Q_PROPERTY(QString mavlinkActionsSavePath   READ mavlinkActionsSavePath     NOTIFY savePathsChanged)
     Q_PROPERTY(QString settingsSavePath         READ settingsSavePath           NOTIFY savePathsChanged)
+    Q_PROPERTY(QString tileArchiveSavePath      READ tileArchiveSavePath        NOTIFY savePathsChanged)
 
     Q_PROPERTY(QString planFileExtension        MEMBER planFileExtension        CONSTANT)
     Q_PROPERTY(QString waypointsFileExtension   MEMBER waypointsFileExtension   CONSTANT)
@@ -89,6 +90,7 @@ class AppSettings : public SettingsGroup
     QString crashSavePath         ();
     QString mavlinkActionsSavePath();
     QString settingsSavePath      ();
+    QString tileArchiveSavePath   ();
 
     // Helper methods for working with firstRunPromptIds QVariant settings string list
     static QList<int> firstRunPromptsIdsVariantToList   (const QVariant& firstRunPromptIds);
@@ -116,6 +118,7 @@ class AppSettings : public SettingsGroup
     static constexpr const char* crashDirectory =           QT_TRANSLATE_NOOP("AppSettings", "CrashLogs");
     static constexpr const char* mavlinkActionsDirectory =  QT_TRANSLATE_NOOP("AppSettings", "MavlinkActions");
     static constexpr const char* settingsDirectory =        QT_TRANSLATE_NOOP("AppSettings", "Settings");
+    static constexpr const char* tileArchiveDirectory =     QT_TRANSLATE_NOOP("AppSettings", "TileArchives");
 
 signals:
     void savePathsChanged();
@@ -7,3 +7,4 @@ DECLARE_SETTINGGROUP(FlightMap, "FlightMap")
 DECLARE_SETTINGSFACT(FlightMapSettings, mapProvider)
 DECLARE_SETTINGSFACT(FlightMapSettings, mapType)
 DECLARE_SETTINGSFACT(FlightMapSettings, elevationMapProvider)
+DECLARE_SETTINGSFACT(FlightMapSettings, localDemDirectory)
@@ -17,4 +17,5 @@ class FlightMapSettings : public SettingsGroup
     DEFINE_SETTINGFACT(mapProvider)
     DEFINE_SETTINGFACT(mapType)
     DEFINE_SETTINGFACT(elevationMapProvider)
+    DEFINE_SETTINGFACT(localDemDirectory)
 };
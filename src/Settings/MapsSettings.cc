@@ -28,3 +28,6 @@ DECLARE_SETTINGGROUP(Maps, "Maps")
 
 DECLARE_SETTINGSFACT(MapsSettings, maxCacheDiskSize)
 DECLARE_SETTINGSFACT(MapsSettings, maxCacheMemorySize)
+DECLARE_SETTINGSFACT(MapsSettings, prefetchTiles)
+DECLARE_SETTINGSFACT(MapsSettings, prefetchBandwidth)
+DECLARE_SETTINGSFACT(MapsSettings, prefetchDiskBudget)
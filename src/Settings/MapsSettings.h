@@ -16,4 +16,7 @@ class MapsSettings : public SettingsGroup
 
     DEFINE_SETTINGFACT(maxCacheDiskSize)
     DEFINE_SETTINGFACT(maxCacheMemorySize)
+    DEFINE_SETTINGFACT(prefetchTiles)
+    DEFINE_SETTINGFACT(prefetchBandwidth)
+    DEFINE_SETTINGFACT(prefetchDiskBudget)
 };
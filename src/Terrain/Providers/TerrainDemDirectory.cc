@@ -0,0 +1,540 @@
+#include "TerrainDemDirectory.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QtEndian>
+#include <QtCore/QtNumeric>
+#include <QtPositioning/QGeoCoordinate>
+
+#include <cmath>
+#include <cstring>
+
+QGC_LOGGING_CATEGORY(TerrainDemDirectoryLog, "Terrain.TerrainDemDirectory")
+
+namespace {
+
+enum TiffTag : quint16 {
+    ImageWidth = 256,
+    ImageLength = 257,
+    BitsPerSample = 258,
+    Compression = 259,
+    StripOffsets = 273,
+    SamplesPerPixel = 277,
+    RowsPerStrip = 278,
+    Predictor = 317,
+    TileWidth = 322,
+    TileLength = 323,
+    TileOffsets = 324,
+    SampleFormat = 339,
+    ModelPixelScale = 33550,
+    ModelTiepoint = 33922,
+    GeoKeyDirectory = 34735,
+    GdalNoData = 42113,
+};
+
+enum TiffType : quint16 {
+    Ascii = 2,
+    Short = 3,
+    Long = 4,
+    Double = 12,
+};
+
+constexpr quint16 kGTModelTypeGeoKey = 1024;
+constexpr quint16 kGTRasterTypeGeoKey = 1025;
+constexpr quint16 kModelTypeGeographic = 2;
+constexpr quint16 kRasterPixelIsPoint = 2;
+
+/// Bounds-checked reads from a mapped TIFF in its own byte order
+struct TiffReader
+{
+    const uchar *data;
+    qint64 size;
+    bool bigEndian;
+
+    bool inRange(qint64 offset, qint64 bytes) const { return (offset >= 0) && (bytes >= 0) && ((offset + bytes) <= size); }
+
+    quint16 u16(qint64 offset) const { return bigEndian ? qFromBigEndian<quint16>(data + offset) : qFromLittleEndian<quint16>(data + offset); }
+    quint32 u32(qint64 offset) const { return bigEndian ? qFromBigEndian<quint32>(data + offset) : qFromLittleEndian<quint32>(data + offset); }
+    double f64(qint64 offset) const
+    {
+        const quint64 bits = bigEndian ? qFromBigEndian<quint64>(data + offset) : qFromLittleEndian<quint64>(data + offset);
+        double value;
+        (void) memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+struct TiffEntry
+{
+    quint16 type = 0;
+    quint32 count = 0;
+    qint64 valueOffset = -1;    ///< Where the values start: inside the entry when they fit in 4 bytes
+
+    bool isValid() const { return valueOffset >= 0; }
+};
+
+int tiffTypeSize(quint16 type)
+{
+    switch (type) {
+    case TiffType::Ascii:
+        return 1;
+    case TiffType::Short:
+        return 2;
+    case TiffType::Long:
+        return 4;
+    case TiffType::Double:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+bool tiffUInt(const TiffReader &reader, const TiffEntry &entry, quint32 index, quint32 &value)
+{
+    if (!entry.isValid() || (index >= entry.count)) {
+        return false;
+    }
+
+    switch (entry.type) {
+    case TiffType::Short:
+        value = reader.u16(entry.valueOffset + (index * 2));
+        return true;
+    case TiffType::Long:
+        value = reader.u32(entry.valueOffset + (index * 4));
+        return true;
+    default:
+        return false;
+    }
+}
+
+}  // namespace
+
+TerrainDemDirectory::TerrainDemDirectory(const QString &path)
+    : _path(path)
+{
+    QDirIterator it(path, {QStringLiteral("*.hgt"), QStringLiteral("*.tif"), QStringLiteral("*.tiff")},
+                    QDir::Files | QDir::Readable, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString fileName = it.next();
+        if (fileName.endsWith(QStringLiteral(".hgt"), Qt::CaseInsensitive)) {
+            _addHgt(fileName);
+        } else {
+            _addGeoTiff(fileName);
+        }
+    }
+
+    qCDebug(TerrainDemDirectoryLog) << "Opened" << path << "files:" << _files.size() << "hgt:" << _hgtFiles.size() << "geotiff:" << _geoTiffFiles.size();
+}
+
+TerrainDemDirectory::~TerrainDemDirectory() = default;
+
+std::shared_ptr<const TerrainDemDirectory> TerrainDemDirectory::shared(const QString &path)
+{
+    static QMutex mutex;
+    static QHash<QString, std::weak_ptr<const TerrainDemDirectory>> directories;
+
+    const QString key = QFileInfo(path).absoluteFilePath();
+
+    QMutexLocker locker(&mutex);
+    std::shared_ptr<const TerrainDemDirectory> directory = directories.value(key).lock();
+    if (!directory) {
+        directory = std::make_shared<const TerrainDemDirectory>(key);
+        directories.insert(key, directory);
+    }
+    return directory;
+}
+
+const uchar *TerrainDemDirectory::_map(const QString &fileName, qint64 &size)
+{
+    auto file = std::make_unique<QFile>(fileName);
+    if (!file->open(QIODevice::ReadOnly)) {
+        qCWarning(TerrainDemDirectoryLog) << "Open failed" << fileName << file->errorString();
+        return nullptr;
+    }
+
+    size = file->size();
+    const uchar *const data = (size > 0) ? file->map(0, size) : nullptr;
+    if (!data) {
+        qCWarning(TerrainDemDirectoryLog) << "Map failed" << fileName << file->errorString();
+        return nullptr;
+    }
+
+    _mappedFiles.push_back(std::move(file));
+    return data;
+}
+
+void TerrainDemDirectory::_addHgt(const QString &fileName)
+{
+    static const QRegularExpression nameRegex(QStringLiteral("^([NS])(\\d{2})([EW])(\\d{3})"), QRegularExpression::CaseInsensitiveOption);
+
+    const QRegularExpressionMatch match = nameRegex.match(QFileInfo(fileName).fileName());
+    if (!match.hasMatch()) {
+        qCWarning(TerrainDemDirectoryLog) << "Skipping .hgt without a cell name" << fileName;
+        return;
+    }
+
+    int lat = match.captured(2).toInt();
+    int lon = match.captured(4).toInt();
+    if (match.captured(1).compare(QStringLiteral("S"), Qt::CaseInsensitive) == 0) {
+        lat = -lat;
+    }
+    if (match.captured(3).compare(QStringLiteral("W"), Qt::CaseInsensitive) == 0) {
+        lon = -lon;
+    }
+    if ((lat < -90) || (lat > 89) || (lon < -180) || (lon > 179)) {
+        qCWarning(TerrainDemDirectoryLog) << "Skipping .hgt with invalid cell" << fileName;
+        return;
+    }
+
+    const QFileInfo info(fileName);
+    const int samples = static_cast<int>(std::lround(std::sqrt(info.size() / 2.0)));
+    if ((samples < 2) || ((static_cast<qint64>(samples) * samples * 2) != info.size())) {
+        qCWarning(TerrainDemDirectoryLog) << "Skipping .hgt that is not a square int16 grid" << fileName << info.size();
+        return;
+    }
+
+    DemFile file;
+    file.data = _map(fileName, file.size);
+    if (!file.data) {
+        return;
+    }
+
+    file.width = samples;
+    file.height = samples;
+    file.latSpacing = 1.0 / (samples - 1);
+    file.lonSpacing = file.latSpacing;
+    file.originLat = lat + 1;
+    file.originLon = lon;
+    file.south = lat;
+    file.north = lat + 1;
+    file.west = lon;
+    file.east = lon + 1;
+    file.blockWidth = samples;
+    file.blockHeight = samples;
+    file.blocksAcross = 1;
+    file.blockOffsets = {0};
+
+    _hgtFiles.insert(_hgtKey(lat, lon), static_cast<qsizetype>(_files.size()));
+    _files.push_back(std::move(file));
+}
+
+void TerrainDemDirectory::_addGeoTiff(const QString &fileName)
+{
+    DemFile file;
+    file.data = _map(fileName, file.size);
+    if (!file.data) {
+        return;
+    }
+
+    QString errorString;
+    if (!_parseGeoTiff(file.data, file.size, file, errorString)) {
+        qCWarning(TerrainDemDirectoryLog) << "Skipping GeoTIFF" << fileName << errorString;
+        _mappedFiles.pop_back();
+        return;
+    }
+
+    _geoTiffFiles.push_back(static_cast<qsizetype>(_files.size()));
+    _files.push_back(std::move(file));
+}
+
+bool TerrainDemDirectory::_parseGeoTiff(const uchar *data, qint64 size, DemFile &file, QString &errorString)
+{
+    if ((size < 8) || !(((data[0] == 'I') && (data[1] == 'I')) || ((data[0] == 'M') && (data[1] == 'M')))) {
+        errorString = QStringLiteral("not a TIFF");
+        return false;
+    }
+
+    const TiffReader reader{data, size, data[0] == 'M'};
+    if (reader.u16(2) != 42) {
+        errorString = QStringLiteral("only classic TIFF is supported");
+        return false;
+    }
+
+    const qint64 ifdOffset = reader.u32(4);
+    if (!reader.inRange(ifdOffset, 2)) {
+        errorString = QStringLiteral("bad IFD offset");
+        return false;
+    }
+
+    QHash<quint16, TiffEntry> entries;
+    const quint16 entryCount = reader.u16(ifdOffset);
+    if (!reader.inRange(ifdOffset + 2, static_cast<qint64>(entryCount) * 12)) {
+        errorString = QStringLiteral("truncated IFD");
+        return false;
+    }
+    for (quint16 i = 0; i < entryCount; i++) {
+        const qint64 entryOffset = ifdOffset + 2 + (static_cast<qint64>(i) * 12);
+        TiffEntry entry;
+        entry.type = reader.u16(entryOffset + 2);
+        entry.count = reader.u32(entryOffset + 4);
+        const qint64 bytes = static_cast<qint64>(tiffTypeSize(entry.type)) * entry.count;
+        entry.valueOffset = (bytes <= 4) ? (entryOffset + 8) : reader.u32(entryOffset + 8);
+        if ((bytes == 0) || !reader.inRange(entry.valueOffset, bytes)) {
+            continue;
+        }
+        entries.insert(reader.u16(entryOffset), entry);
+    }
+
+    const auto uintTag = [&](quint16 tag, quint32 defaultValue) {
+        quint32 value = defaultValue;
+        (void) tiffUInt(reader, entries.value(tag), 0, value);
+        return value;
+    };
+
+    const quint32 width = uintTag(TiffTag::ImageWidth, 0);
+    const quint32 height = uintTag(TiffTag::ImageLength, 0);
+    if ((width < 2) || (height < 2) || (width > 1000000) || (height > 1000000)) {
+        errorString = QStringLiteral("bad image size");
+        return false;
+    }
+    if ((uintTag(TiffTag::Compression, 1) != 1) || (uintTag(TiffTag::Predictor, 1) != 1)) {
+        errorString = QStringLiteral("only uncompressed samples are supported");
+        return false;
+    }
+    if ((uintTag(TiffTag::BitsPerSample, 1) != 16) || (uintTag(TiffTag::SamplesPerPixel, 1) != 1)) {
+        errorString = QStringLiteral("only single band 16-bit samples are supported");
+        return false;
+    }
+
+    const quint32 sampleFormat = uintTag(TiffTag::SampleFormat, 1);
+    if ((sampleFormat != 1) && (sampleFormat != 2)) {
+        errorString = QStringLiteral("only integer samples are supported");
+        return false;
+    }
+
+    file.bigEndian = reader.bigEndian;
+    file.isUnsigned = (sampleFormat == 1);
+    file.width = static_cast<int>(width);
+    file.height = static_cast<int>(height);
+
+    TiffEntry offsetsEntry;
+    quint32 blocksDown;
+    if (entries.contains(TiffTag::TileOffsets)) {
+        file.blockWidth = static_cast<int>(uintTag(TiffTag::TileWidth, 0));
+        file.blockHeight = static_cast<int>(uintTag(TiffTag::TileLength, 0));
+        if ((file.blockWidth <= 0) || (file.blockHeight <= 0)) {
+            errorString = QStringLiteral("bad tile size");
+            return false;
+        }
+        offsetsEntry = entries.value(TiffTag::TileOffsets);
+    } else {
+        file.blockWidth = file.width;
+        file.blockHeight = static_cast<int>(qMin(uintTag(TiffTag::RowsPerStrip, height), height));
+        if (file.blockHeight <= 0) {
+            errorString = QStringLiteral("bad strip size");
+            return false;
+        }
+        offsetsEntry = entries.value(TiffTag::StripOffsets);
+    }
+    file.blocksAcross = (file.width + file.blockWidth - 1) / file.blockWidth;
+    blocksDown = static_cast<quint32>((file.height + file.blockHeight - 1) / file.blockHeight);
+
+    const quint32 blockCount = static_cast<quint32>(file.blocksAcross) * blocksDown;
+    if (!offsetsEntry.isValid() || (offsetsEntry.count < blockCount)) {
+        errorString = QStringLiteral("missing block offsets");
+        return false;
+    }
+
+    file.blockOffsets.resize(blockCount);
+    for (quint32 i = 0; i < blockCount; i++) {
+        quint32 offset = 0;
+        (void) tiffUInt(reader, offsetsEntry, i, offset);
+
+        // Only the last strip may be short; tiles are always stored whole
+        const bool lastStrip = (file.blocksAcross == 1) && (i == (blockCount - 1)) && !entries.contains(TiffTag::TileOffsets);
+        const qint64 rows = lastStrip ? (file.height - (static_cast<qint64>(i) * file.blockHeight)) : file.blockHeight;
+        if (!reader.inRange(offset, rows * file.blockWidth * 2)) {
+            errorString = QStringLiteral("block %1 outside file").arg(i);
+            return false;
+        }
+        file.blockOffsets[i] = offset;
+    }
+
+    const TiffEntry scaleEntry = entries.value(TiffTag::ModelPixelScale);
+    const TiffEntry tiepointEntry = entries.value(TiffTag::ModelTiepoint);
+    if (!scaleEntry.isValid() || (scaleEntry.type != TiffType::Double) || (scaleEntry.count < 2) ||
+        !tiepointEntry.isValid() || (tiepointEntry.type != TiffType::Double) || (tiepointEntry.count < 6)) {
+        errorString = QStringLiteral("missing ModelPixelScale/ModelTiepoint");
+        return false;
+    }
+
+    bool pixelIsPoint = false;
+    const TiffEntry geoKeysEntry = entries.value(TiffTag::GeoKeyDirectory);
+    if (geoKeysEntry.isValid() && (geoKeysEntry.type == TiffType::Short) && (geoKeysEntry.count >= 4)) {
+        const quint32 keyCount = qMin<quint32>(reader.u16(geoKeysEntry.valueOffset + 6), (geoKeysEntry.count / 4) - 1);
+        for (quint32 i = 1; i <= keyCount; i++) {
+            const qint64 keyOffset = geoKeysEntry.valueOffset + (static_cast<qint64>(i) * 8);
+            const quint16 keyId = reader.u16(keyOffset);
+            const quint16 location = reader.u16(keyOffset + 2);
+            const quint16 value = reader.u16(keyOffset + 6);
+            if (location != 0) {
+                continue;
+            }
+            if ((keyId == kGTModelTypeGeoKey) && (value != kModelTypeGeographic)) {
+                errorString = QStringLiteral("only geographic (lat/lon) rasters are supported");
+                return false;
+            }
+            if (keyId == kGTRasterTypeGeoKey) {
+                pixelIsPoint = (value == kRasterPixelIsPoint);
+            }
+        }
+    }
+
+    file.lonSpacing = reader.f64(scaleEntry.valueOffset);
+    file.latSpacing = reader.f64(scaleEntry.valueOffset + 8);
+    if (!(file.lonSpacing > 0.0) || !(file.latSpacing > 0.0)) {
+        errorString = QStringLiteral("bad pixel scale");
+        return false;
+    }
+
+    const double tieI = reader.f64(tiepointEntry.valueOffset);
+    const double tieJ = reader.f64(tiepointEntry.valueOffset + 8);
+    const double tieX = reader.f64(tiepointEntry.valueOffset + 24);
+    const double tieY = reader.f64(tiepointEntry.valueOffset + 32);
+
+    // PixelIsArea ties the corner of the pixel, so sample centres sit half a pixel in
+    const double centreShift = pixelIsPoint ? 0.0 : 0.5;
+    file.originLon = tieX + ((centreShift - tieI) * file.lonSpacing);
+    file.originLat = tieY - ((centreShift - tieJ) * file.latSpacing);
+
+    const double edge = pixelIsPoint ? 0.0 : 0.5;
+    file.west = file.originLon - (edge * file.lonSpacing);
+    file.east = file.originLon + ((file.width - 1 + edge) * file.lonSpacing);
+    file.north = file.originLat + (edge * file.latSpacing);
+    file.south = file.originLat - ((file.height - 1 + edge) * file.latSpacing);
+
+    const TiffEntry noDataEntry = entries.value(TiffTag::GdalNoData);
+    if (noDataEntry.isValid() && (noDataEntry.type == TiffType::Ascii)) {
+        const char *const text = reinterpret_cast<const char *>(data + noDataEntry.valueOffset);
+        bool ok = false;
+        const double noData = QByteArray(text, qstrnlen(text, noDataEntry.count)).trimmed().toDouble(&ok);
+        if (ok) {
+            file.hasVoidValue = true;
+            file.voidValue = static_cast<int>(std::lround(noData));
+        }
+    } else if (file.isUnsigned) {
+        file.hasVoidValue = false;
+    }
+
+    return true;
+}
+
+const TerrainDemDirectory::DemFile *TerrainDemDirectory::_findFile(double lat, double lon) const
+{
+    // Casting a non-finite floor() to int is undefined
+    if (!qIsFinite(lat) || !qIsFinite(lon)) {
+        return nullptr;
+    }
+
+    const int cellLat = static_cast<int>(std::floor(lat));
+    const int cellLon = static_cast<int>(std::floor(lon));
+
+    // A coordinate on a cell edge is in both cells; either one may be the file that is present
+    for (int dLat = 0; dLat >= ((lat == cellLat) ? -1 : 0); dLat--) {
+        for (int dLon = 0; dLon >= ((lon == cellLon) ? -1 : 0); dLon--) {
+            const auto it = _hgtFiles.constFind(_hgtKey(cellLat + dLat, cellLon + dLon));
+            if (it != _hgtFiles.cend()) {
+                return &_files[static_cast<size_t>(it.value())];
+            }
+        }
+    }
+
+    for (const qsizetype index : _geoTiffFiles) {
+        const DemFile &file = _files[static_cast<size_t>(index)];
+        if (file.contains(lat, lon)) {
+            return &file;
+        }
+    }
+
+    return nullptr;
+}
+
+bool TerrainDemDirectory::_value(const DemFile &file, int row, int col, double &value)
+{
+    const int block = ((row / file.blockHeight) * file.blocksAcross) + (col / file.blockWidth);
+    const qint64 sample = (static_cast<qint64>(row % file.blockHeight) * file.blockWidth) + (col % file.blockWidth);
+    const uchar *const bytes = file.data + file.blockOffsets[static_cast<size_t>(block)] + (sample * 2);
+
+    const quint16 raw = file.bigEndian ? qFromBigEndian<quint16>(bytes) : qFromLittleEndian<quint16>(bytes);
+    const int sampleValue = file.isUnsigned ? static_cast<int>(raw) : static_cast<int>(static_cast<qint16>(raw));
+    if (file.hasVoidValue && (sampleValue == file.voidValue)) {
+        return false;
+    }
+
+    value = sampleValue;
+    return true;
+}
+
+double TerrainDemDirectory::_sample(const DemFile &file, double lat, double lon)
+{
+    const double row = qBound(0.0, (file.originLat - lat) / file.latSpacing, static_cast<double>(file.height - 1));
+    const double col = qBound(0.0, (lon - file.originLon) / file.lonSpacing, static_cast<double>(file.width - 1));
+
+    const int row0 = qMin(static_cast<int>(row), file.height - 2);
+    const int col0 = qMin(static_cast<int>(col), file.width - 2);
+    const double rowFraction = row - row0;
+    const double colFraction = col - col0;
+
+    const double weights[4] = {
+        (1.0 - rowFraction) * (1.0 - colFraction),
+        (1.0 - rowFraction) * colFraction,
+        rowFraction * (1.0 - colFraction),
+        rowFraction * colFraction,
+    };
+
+    double elevation = 0.0;
+    for (int i = 0; i < 4; i++) {
+        if (weights[i] == 0.0) {
+            continue;
+        }
+        double value;
+        if (!_value(file, row0 + (i / 2), col0 + (i % 2), value)) {
+            return qQNaN();
+        }
+        elevation += weights[i] * value;
+    }
+
+    return elevation;
+}
+
+double TerrainDemDirectory::elevation(const QGeoCoordinate &coordinate) const
+{
+    double result = qQNaN();
+    (void) elevations(QSpan<const QGeoCoordinate>(&coordinate, 1), QSpan<double>(&result, 1));
+    return result;
+}
+
+qsizetype TerrainDemDirectory::elevations(QSpan<const QGeoCoordinate> coordinates, QSpan<double> elevations) const
+{
+    Q_ASSERT(coordinates.size() == elevations.size());
+
+    qsizetype missing = 0;
+    const DemFile *file = nullptr;
+    for (qsizetype i = 0; i < coordinates.size(); i++) {
+        if (!coordinates[i].isValid()) {
+            elevations[i] = qQNaN();
+            missing++;
+            continue;
+        }
+
+        const double lat = coordinates[i].latitude();
+        const double lon = coordinates[i].longitude();
+
+        // Queries are spatially coherent, so the last file usually answers the next coordinate too
+        if (!file || !file->contains(lat, lon)) {
+            file = _findFile(lat, lon);
+        }
+
+        elevations[i] = file ? _sample(*file, lat, lon) : qQNaN();
+        if (qIsNaN(elevations[i])) {
+            missing++;
+        }
+    }
+
+    return missing;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QSpan>
+#include <QtCore/QString>
+
+#include <memory>
+#include <vector>
+
+class QFile;
+class QGeoCoordinate;
+
+/// \brief Elevations from a directory of local DEM files, read straight from memory-mapped pages.
+///
+/// Supported files (the directory is searched recursively):
+///  - SRTM .hgt: square grid of big-endian int16 samples, named for the south-west corner of its 1 degree cell
+///    (e.g. N47E008.hgt). The grid size follows from the file size: 3601 for 1 arc-second, 1201 for 3 arc-second.
+///  - GeoTIFF (.tif/.tiff): classic TIFF, one band of uncompressed 16-bit integer samples, stripped or tiled, placed
+///    with ModelTiepoint and ModelPixelScale in geographic degrees.
+///
+/// Files are mapped and their headers parsed once when the directory is opened. A lookup finds the file, computes the
+/// byte offsets of the four surrounding samples and interpolates bilinearly; nothing is decoded or copied per tile.
+/// Coordinates that no file covers, or that touch a void sample, give NaN.
+class TerrainDemDirectory
+{
+public:
+    explicit TerrainDemDirectory(const QString &path);
+    ~TerrainDemDirectory();
+
+    /// Returns the opened directory for @p path, shared with other users that still hold it
+    static std::shared_ptr<const TerrainDemDirectory> shared(const QString &path);
+
+    QString path() const { return _path; }
+    qsizetype fileCount() const { return static_cast<qsizetype>(_files.size()); }
+
+    double elevation(const QGeoCoordinate &coordinate) const;
+
+    /// @param[out] elevations one value per coordinate, NaN where there is no data
+    /// @return number of coordinates without data
+    qsizetype elevations(QSpan<const QGeoCoordinate> coordinates, QSpan<double> elevations) const;
+
+    static constexpr int16_t kVoidValue = -32768;  ///< SRTM void marker
+
+private:
+    struct DemFile
+    {
+        const uchar *data = nullptr;
+        qint64 size = 0;
+        bool bigEndian = true;
+        bool isUnsigned = false;
+        bool hasVoidValue = true;
+        int voidValue = kVoidValue;
+
+        int width = 0;
+        int height = 0;
+
+        /// Geographic position of sample (0, 0), rows run south and columns east
+        double originLat = 0.0;
+        double originLon = 0.0;
+        double latSpacing = 0.0;
+        double lonSpacing = 0.0;
+
+        /// Area the file answers for
+        double south = 0.0;
+        double west = 0.0;
+        double north = 0.0;
+        double east = 0.0;
+
+        /// Strips are treated as blocks spanning the full image width
+        int blockWidth = 0;
+        int blockHeight = 0;
+        int blocksAcross = 0;
+        std::vector<quint32> blockOffsets;
+
+        bool contains(double lat, double lon) const { return (lat >= south) && (lat <= north) && (lon >= west) && (lon <= east); }
+    };
+
+    void _addHgt(const QString &fileName);
+    void _addGeoTiff(const QString &fileName);
+    const uchar *_map(const QString &fileName, qint64 &size);
+    const DemFile *_findFile(double lat, double lon) const;
+
+    static bool _parseGeoTiff(const uchar *data, qint64 size, DemFile &file, QString &errorString);
+    static double _sample(const DemFile &file, double lat, double lon);
+    static bool _value(const DemFile &file, int row, int col, double &value);
+    static int _hgtKey(int lat, int lon) { return ((lat + 90) * 360) + (lon + 180); }
+
+    QString _path;
+    std::vector<std::unique_ptr<QFile>> _mappedFiles;
+    std::vector<DemFile> _files;
+    QHash<int, qsizetype> _hgtFiles;        ///< 1 degree cell -> index into _files
+    std::vector<qsizetype> _geoTiffFiles;   ///< indices into _files
+};
@@ -0,0 +1,89 @@
+#include "TerrainQueryLocalDem.h"
+#include "TerrainDemDirectory.h"
+#include "TerrainTileManager.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtPositioning/QGeoCoordinate>
+
+QGC_LOGGING_CATEGORY(TerrainQueryLocalDemLog, "Terrain.TerrainQueryLocalDem")
+
+TerrainQueryLocalDem::TerrainQueryLocalDem(const QString &path, QObject *parent)
+    : TerrainQueryInterface(parent)
+    , _directory(TerrainDemDirectory::shared(path))
+{
+    qCDebug(TerrainQueryLocalDemLog) << this << path << "files:" << _directory->fileCount();
+}
+
+TerrainQueryLocalDem::~TerrainQueryLocalDem()
+{
+    qCDebug(TerrainQueryLocalDemLog) << this;
+}
+
+bool TerrainQueryLocalDem::_elevations(const QList<QGeoCoordinate> &coordinates, QList<double> &heights) const
+{
+    heights.resize(coordinates.size());
+    const qsizetype missing = _directory->elevations(coordinates, heights);
+    if (missing > 0) {
+        qCDebug(TerrainQueryLocalDemLog) << "no elevation for" << missing << "of" << coordinates.size() << "coordinates";
+        return false;
+    }
+
+    return true;
+}
+
+void TerrainQueryLocalDem::requestCoordinateHeights(const QList<QGeoCoordinate> &coordinates)
+{
+    if (coordinates.isEmpty()) {
+        return;
+    }
+
+    _queryMode = TerrainQuery::QueryModeCoordinates;
+
+    QList<double> heights;
+    if (!_elevations(coordinates, heights)) {
+        _requestFailed();
+        return;
+    }
+
+    signalCoordinateHeights(true, heights);
+}
+
+void TerrainQueryLocalDem::requestPathHeights(const QGeoCoordinate &fromCoord, const QGeoCoordinate &toCoord)
+{
+    _queryMode = TerrainQuery::QueryModePath;
+
+    double distanceBetween;
+    double finalDistanceBetween;
+    const QList<QGeoCoordinate> coordinates = TerrainTileManager::pathQueryToCoords(fromCoord, toCoord, distanceBetween, finalDistanceBetween);
+
+    QList<double> heights;
+    if (!_elevations(coordinates, heights)) {
+        _requestFailed();
+        return;
+    }
+
+    signalPathHeights(true, distanceBetween, finalDistanceBetween, heights);
+}
+
+void TerrainQueryLocalDem::requestCarpetHeights(const QGeoCoordinate &swCoord, const QGeoCoordinate &neCoord, bool statsOnly)
+{
+    _queryMode = TerrainQuery::QueryModeCarpet;
+
+    QList<QGeoCoordinate> coordinates;
+    int gridSizeLat, gridSizeLon;
+    if (!TerrainTileManager::carpetQueryToCoords(swCoord, neCoord, coordinates, gridSizeLat, gridSizeLon)) {
+        _requestFailed();
+        return;
+    }
+
+    QList<double> heights;
+    if (!_elevations(coordinates, heights)) {
+        _requestFailed();
+        return;
+    }
+
+    double minHeight, maxHeight;
+    QList<QList<double>> carpet;
+    TerrainTileManager::processCarpetResults(heights, gridSizeLat, gridSizeLon, statsOnly, minHeight, maxHeight, carpet);
+    signalCarpetHeights(true, minHeight, maxHeight, carpet);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QtCore/QObject>
+
+#include <memory>
+
+#include "TerrainQueryInterface.h"
+
+class QGeoCoordinate;
+class TerrainDemDirectory;
+
+/// \brief Terrain queries answered from a directory of local DEM files (SRTM .hgt / GeoTIFF).
+///
+/// Results are signalled synchronously from the request call. A query fails if any coordinate it needs is not
+/// covered by the directory or falls on a void.
+class TerrainQueryLocalDem : public TerrainQueryInterface
+{
+    Q_OBJECT
+
+public:
+    explicit TerrainQueryLocalDem(const QString &path, QObject *parent = nullptr);
+    ~TerrainQueryLocalDem();
+
+    void requestCoordinateHeights(const QList<QGeoCoordinate> &coordinates) final;
+    void requestPathHeights(const QGeoCoordinate &fromCoord, const QGeoCoordinate &toCoord) final;
+    void requestCarpetHeights(const QGeoCoordinate &swCoord, const QGeoCoordinate &neCoord, bool statsOnly) final;
+
+private:
+    /// @return false: at least one coordinate has no elevation
+    bool _elevations(const QList<QGeoCoordinate> &coordinates, QList<double> &heights) const;
+
+    std::shared_ptr<const TerrainDemDirectory> _directory;
+};
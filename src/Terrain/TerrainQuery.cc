@@ -1,7 +1,11 @@
 #include "TerrainQuery.h"
+#include "TerrainDemDirectory.h"
 #include "TerrainQueryInterface.h"
+#include "TerrainQueryLocalDem.h"
 #include "TerrainTileManager.h"
+#include "FlightMapSettings.h"
 #include "QGCLoggingCategory.h"
+#include "SettingsManager.h"
 
 #include <QtCore/QTimer>
 
@@ -10,10 +14,29 @@ QGC_LOGGING_CATEGORY(TerrainQueryVerboseLog, "Terrain.TerrainQuery:verbose")
 
 Q_GLOBAL_STATIC(TerrainAtCoordinateBatchManager, _terrainAtCoordinateBatchManager)
 
+namespace {
+
+QString localDemDirectory()
+{
+    return SettingsManager::instance()->flightMapSettings()->localDemDirectory()->rawValue().toString();
+}
+
+/// Local DEM files when a directory is configured, otherwise the tile cache backed by the elevation provider
+TerrainQueryInterface *createTerrainQuery(QObject *parent)
+{
+    const QString demDirectory = localDemDirectory();
+    if (!demDirectory.isEmpty()) {
+        return new TerrainQueryLocalDem(demDirectory, parent);
+    }
+    return new TerrainOfflineQuery(parent);
+}
+
+}  // namespace
+
 TerrainAtCoordinateBatchManager::TerrainAtCoordinateBatchManager(QObject *parent)
     : QObject(parent)
     , _batchTimer(new QTimer(this))
-    , _terrainQuery(new TerrainOfflineQuery(this))
+    , _terrainQuery(createTerrainQuery(this))
 {
     qCDebug(TerrainQueryLog) << this;
 
@@ -22,6 +45,7 @@ TerrainAtCoordinateBatchManager::TerrainAtCoordinateBatchManager(QObject *parent
 
     (void) connect(_batchTimer, &QTimer::timeout, this, &TerrainAtCoordinateBatchManager::_sendNextBatch);
     (void) connect(_terrainQuery, &TerrainQueryInterface::coordinateHeightsReceived, this, &TerrainAtCoordinateBatchManager::_coordinateHeights);
+    (void) connect(SettingsManager::instance()->flightMapSettings()->localDemDirectory(), &Fact::rawValueChanged, this, &TerrainAtCoordinateBatchManager::_terrainSourceChanged);
 }
 
 TerrainAtCoordinateBatchManager::~TerrainAtCoordinateBatchManager()
@@ -64,6 +88,34 @@ void TerrainAtCoordinateBatchManager::setTerrainQueryInterface(TerrainQueryInter
     }
 }
 
+std::shared_ptr<const TerrainDemDirectory> TerrainAtCoordinateBatchManager::demDirectory()
+{
+    if (!_demDirectory) {
+        const QString path = localDemDirectory();
+        if (!path.isEmpty()) {
+            _demDirectory = TerrainDemDirectory::shared(path);
+        }
+    }
+    return _demDirectory;
+}
+
+void TerrainAtCoordinateBatchManager::_terrainSourceChanged()
+{
+    _demDirectory.reset();
+
+    // A batch in flight on the old source will never be answered
+    if (_state != TerrainQuery::State::Idle) {
+        _state = TerrainQuery::State::Idle;
+        _batchFailed();
+    }
+
+    setTerrainQueryInterface(createTerrainQuery(nullptr));
+
+    if (!_requestQueue.isEmpty() && !_batchTimer->isActive()) {
+        _batchTimer->start();
+    }
+}
+
 void TerrainAtCoordinateBatchManager::_sendNextBatch()
 {
     qCDebug(TerrainQueryLog) << Q_FUNC_INFO << "_state:_requestQueue.count:_sentRequests.count" << _stateToString(_state) << _requestQueue.count() << _sentRequests.count();
@@ -181,6 +233,15 @@ void TerrainAtCoordinateQuery::requestData(const QList<QGeoCoordinate> &coordina
 
 bool TerrainAtCoordinateQuery::getAltitudesForCoordinates(const QList<QGeoCoordinate> &coordinates, QList<double> &altitudes, bool &error)
 {
+    // Held by the batch manager, so the directory is scanned once rather than on every lookup
+    const std::shared_ptr<const TerrainDemDirectory> demDirectory = TerrainAtCoordinateBatchManager::instance()->demDirectory();
+    if (demDirectory) {
+        // Local files are always at hand, so there is never a query to queue
+        altitudes.resize(coordinates.size());
+        error = (demDirectory->elevations(coordinates, altitudes) > 0);
+        return true;
+    }
+
     return TerrainTileManager::instance()->getAltitudesForCoordinates(coordinates, altitudes, error);
 }
 
@@ -197,7 +258,7 @@ void TerrainAtCoordinateQuery::signalTerrainData(bool success, const QList<doubl
 TerrainPathQuery::TerrainPathQuery(bool autoDelete, QObject *parent)
     : QObject(parent)
     , _autoDelete(autoDelete)
-    , _terrainQuery(new TerrainOfflineQuery(this))
+    , _terrainQuery(createTerrainQuery(this))
 {
     qCDebug(TerrainQueryLog) << this;
 
@@ -232,7 +293,7 @@ void TerrainPathQuery::_pathHeights(bool success, double distanceBetween, double
 TerrainAreaQuery::TerrainAreaQuery(bool autoDelete, QObject *parent)
     : QObject(parent)
     , _autoDelete(autoDelete)
-    , _terrainQuery(new TerrainOfflineQuery(this))
+    , _terrainQuery(createTerrainQuery(this))
 {
     qCDebug(TerrainQueryLog) << this;
 
@@ -6,10 +6,13 @@
 #include <QtCore/QVariant>
 #include <QtPositioning/QGeoCoordinate>
 
+#include <memory>
+
 #include "TerrainPathHeightInfo.h"
 #include "TerrainQueryInterface.h"
 
 class QTimer;
+class TerrainDemDirectory;
 
 // IMPORTANT NOTE: The terrain query objects below must continue to live until the the terrain system signals data back through them.
 // Because of that it makes object lifetime tricky. Normally you would use autoDelete = true such they delete themselves when they
@@ -39,8 +42,13 @@ class TerrainAtCoordinateBatchManager : public QObject
     /// Set custom terrain query interface (for testing). Takes ownership.
     void setTerrainQueryInterface(TerrainQueryInterface *terrainQuery);
 
+    /// The configured local DEM directory, opened on first use and held until the setting changes.
+    /// Null when no directory is configured.
+    std::shared_ptr<const TerrainDemDirectory> demDirectory();
+
 private slots:
     void _sendNextBatch();
+    void _terrainSourceChanged();
     void _coordinateHeights(bool success, const QList<double> &heights);
 
 private:
@@ -62,6 +70,7 @@ private slots:
     TerrainQuery::State _state = TerrainQuery::State::Idle;
     QTimer *_batchTimer = nullptr;
     TerrainQueryInterface *_terrainQuery = nullptr;
+    std::shared_ptr<const TerrainDemDirectory> _demDirectory;
     static constexpr int _batchTimeout = 500;
 };
 
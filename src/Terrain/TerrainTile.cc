@@ -4,6 +4,10 @@
 #include <QtCore/QtNumeric>
 #include <QtPositioning/QGeoCoordinate>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 QGC_LOGGING_CATEGORY(TerrainTileLog, "Terrain.terraintile");
 
 TerrainTile::TerrainTile(const QByteArray &byteArray)
@@ -51,18 +55,8 @@ TerrainTile::TerrainTile(const QByteArray &byteArray)
     qCDebug(TerrainTileLog) << this << "TileInfo: min, max, avg:" << _tileInfo.minElevation << _tileInfo.maxElevation << _tileInfo.avgElevation;
     qCDebug(TerrainTileLog) << this << "TileInfo: cell size:" << _cellSizeLat << _cellSizeLon;
 
-    _elevationData.resize(_tileInfo.gridSizeLat);
-    for (int k = 0; k < _tileInfo.gridSizeLat; k++) {
-        _elevationData[k].resize(_tileInfo.gridSizeLon);
-    }
-
-    int valueIndex = 0;
-    const int16_t* const pTileData = reinterpret_cast<const int16_t*>(&reinterpret_cast<const uint8_t*>(byteArray.constData())[cTileHeaderBytes]);
-    for (int i = 0; i < _tileInfo.gridSizeLat; i++) {
-        for (int j = 0; j < _tileInfo.gridSizeLon; j++) {
-            _elevationData[i][j] = pTileData[valueIndex++];
-        }
-    }
+    _elevationData.resize(static_cast<qsizetype>(_tileInfo.gridSizeLat) * _tileInfo.gridSizeLon);
+    (void) memcpy(_elevationData.data(), byteArray.constData() + cTileHeaderBytes, cTileDataBytes);
 
     _isValid = true;
 }
@@ -79,35 +73,87 @@ double TerrainTile::elevation(const QGeoCoordinate &coordinate) const
         return qQNaN();
     }
 
-    const double latDeltaSw = coordinate.latitude() - _tileInfo.swLat;
-    const double lonDeltaSw = coordinate.longitude() - _tileInfo.swLon;
+    double result = qQNaN();
+    if (elevations(QSpan<const QGeoCoordinate>(&coordinate, 1), QSpan<double>(&result, 1)) > 0) {
+        qCWarning(TerrainTileLog) << this << "Internal error: coordinate" << coordinate << "outside tile bounds";
+    }
 
-    const int16_t latIndex = qFloor(latDeltaSw / _cellSizeLat);
-    const int16_t lonIndex = qFloor(lonDeltaSw / _cellSizeLon);
+    qCDebug(TerrainTileLog) << this << "coordinate:" << coordinate << "elevation:" << result;
 
-    const bool latIndexInvalid = (latIndex < 0) || (latIndex > (_tileInfo.gridSizeLat - 1));
-    const bool lonIndexInvalid = (lonIndex < 0) || (lonIndex > (_tileInfo.gridSizeLon - 1));
+    return result;
+}
 
-    if (latIndexInvalid || lonIndexInvalid) {
-        qCWarning(TerrainTileLog) << this << "Internal error: coordinate" << coordinate << "outside tile bounds";
-        return qQNaN();
-    }
+qsizetype TerrainTile::elevations(QSpan<const QGeoCoordinate> coordinates, QSpan<double> elevations) const
+{
+    Q_ASSERT(elevations.size() >= coordinates.size());
 
-    if ((latIndex >= _elevationData.size()) || (lonIndex >= _elevationData[latIndex].size())) {
-        qCWarning(TerrainTileLog).noquote() << this << "Internal error: _elevationData size inconsistent _tileInfo << coordinate" << coordinate
-            << "\n\t_tileInfo.gridSizeLat:" << _tileInfo.gridSizeLat << "_tileInfo.gridSizeLon:" << _tileInfo.gridSizeLon
-            << "\n\t_data.size():" << _elevationData.size() << "_elevationData[latIndex].size():" << _elevationData[latIndex].size();
-        return qQNaN();
+    if (!_isValid) {
+        qCWarning(TerrainTileLog) << this << "Request for elevations, but tile is invalid.";
+        std::fill_n(elevations.begin(), coordinates.size(), qQNaN());
+        return coordinates.size();
     }
 
-    const int16_t elevation = _elevationData[latIndex][lonIndex];
-    if (elevation < _tileInfo.minElevation) {
-        qCWarning(TerrainTileLog) << this << "Warning: elevation read is below min elevation in tile:" << elevation << "<" << _tileInfo.minElevation;
-    } else if (elevation > _tileInfo.maxElevation) {
-        qCWarning(TerrainTileLog) << this << "Warning: elevation read is above max elevation in tile:" << elevation << ">" << _tileInfo.maxElevation;
+    // QGeoCoordinate accessors are out of line, so coordinates are converted to grid positions a block at a time
+    // and the interpolation itself only sees plain arrays.
+    constexpr qsizetype kBlockSize = 256;
+    std::array<double, kBlockSize> latPositions;
+    std::array<double, kBlockSize> lonPositions;
+
+    const double latScale = 1.0 / _cellSizeLat;
+    const double lonScale = 1.0 / _cellSizeLon;
+
+    qsizetype outside = 0;
+    for (qsizetype start = 0; start < coordinates.size(); start += kBlockSize) {
+        const qsizetype count = std::min(kBlockSize, coordinates.size() - start);
+        for (qsizetype i = 0; i < count; i++) {
+            const QGeoCoordinate &coordinate = coordinates[start + i];
+            latPositions[i] = (coordinate.latitude() - _tileInfo.swLat) * latScale;
+            lonPositions[i] = (coordinate.longitude() - _tileInfo.swLon) * lonScale;
+        }
+        outside += _interpolate(latPositions.data(), lonPositions.data(), elevations.data() + start, count);
     }
 
-    qCDebug(TerrainTileLog) << this << "latIndex, lonIndex:" << latIndex << lonIndex << "elevation:" << elevation;
+    return outside;
+}
+
+qsizetype TerrainTile::_interpolate(const double *latPositions, const double *lonPositions, double *elevations, qsizetype count) const
+{
+    const int16_t *const grid = _elevationData.constData();
+    const qsizetype rows = _tileInfo.gridSizeLat;
+    const qsizetype cols = _tileInfo.gridSizeLon;
+    const double maxLatPosition = static_cast<double>(rows);
+    const double maxLonPosition = static_cast<double>(cols);
+
+    // Branch-free so the compiler can vectorize it: positions outside the grid sample cell 0 and are replaced by NaN.
+    qsizetype outside = 0;
+    for (qsizetype i = 0; i < count; i++) {
+        const double latPosition = latPositions[i];
+        const double lonPosition = lonPositions[i];
+        // Written so that NaN positions also count as outside
+        const bool inside = (latPosition >= 0.0) && (latPosition < maxLatPosition) && (lonPosition >= 0.0) && (lonPosition < maxLonPosition);
+
+        const double y = inside ? latPosition : 0.0;
+        const double x = inside ? lonPosition : 0.0;
+        const qsizetype row = static_cast<qsizetype>(y);
+        const qsizetype col = static_cast<qsizetype>(x);
+        const double ty = y - static_cast<double>(row);
+        const double tx = x - static_cast<double>(col);
+
+        // The last row/column has no neighbour to the north/east and is held constant
+        const qsizetype northOffset = ((row + 1) < rows) ? cols : 0;
+        const qsizetype eastOffset = ((col + 1) < cols) ? 1 : 0;
+
+        const int16_t *const sw = grid + (row * cols) + col;
+        const double sw0 = sw[0];
+        const double se0 = sw[eastOffset];
+        const double nw0 = sw[northOffset];
+        const double ne0 = sw[northOffset + eastOffset];
+
+        const double south = sw0 + ((se0 - sw0) * tx);
+        const double north = nw0 + ((ne0 - nw0) * tx);
+        elevations[i] = inside ? (south + ((north - south) * ty)) : qQNaN();
+        outside += inside ? 0 : 1;
+    }
 
-    return static_cast<double>(elevation);
+    return outside;
 }
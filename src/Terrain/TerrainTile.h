@@ -1,11 +1,15 @@
 #pragma once
 
 #include <QtCore/QList>
+#include <QtCore/QSpan>
+
 class QGeoCoordinate;
+class TerrainTileManagerTest;
 class TerrainTileTest;
 
 class TerrainTile
 {
+    friend class TerrainTileManagerTest;
     friend class TerrainTileTest;
 
 public:
@@ -20,9 +24,15 @@ class TerrainTile
 
     /// Evaluates the elevation at the given coordinate
     ///    @param coordinate
-    ///    @return elevation
+    ///    @return elevation, bilinearly interpolated between the four surrounding grid values
     double elevation(const QGeoCoordinate &coordinate) const;
 
+    /// Evaluates the elevations at many coordinates in one pass. Same results as calling elevation() for each.
+    ///    @param coordinates
+    ///    @param[out] elevations one value per coordinate, NaN for coordinates outside the tile
+    ///    @return number of coordinates outside the tile
+    qsizetype elevations(QSpan<const QGeoCoordinate> coordinates, QSpan<double> elevations) const;
+
     /// Accessor for the minimum elevation of the tile
     ///    @return minimum elevation
     double minElevation() const { return (_isValid ? static_cast<double>(_tileInfo.minElevation) : qQNaN()); }
@@ -35,6 +45,9 @@ class TerrainTile
     ///    @return average elevation
     double avgElevation() const { return (_isValid ? _tileInfo.avgElevation : qQNaN()); }
 
+    /// Approximate heap footprint of the tile, used as its cost in TerrainTileManager's tile cache
+    qsizetype memoryBytes() const { return static_cast<qsizetype>(sizeof(*this)) + (_elevationData.capacity() * static_cast<qsizetype>(sizeof(int16_t))); }
+
 protected:
     struct TileInfo_t {
         double  swLat, swLon, neLat, neLon;
@@ -44,8 +57,12 @@ class TerrainTile
     } Q_PACKED;
 
 private:
+    /// Interpolates at fractional grid positions. Positions outside the grid (or NaN) give NaN.
+    ///    @return number of positions outside the grid
+    qsizetype _interpolate(const double *latPositions, const double *lonPositions, double *elevations, qsizetype count) const;
+
     TileInfo_t _tileInfo{};
-    QList<QList<int16_t>> _elevationData;   ///< 2D elevation data array
+    QList<int16_t> _elevationData;          ///< Row-major elevation grid, gridSizeLat rows of gridSizeLon values
     double _cellSizeLat = 0.0;              ///< data grid size in latitude direction
     double _cellSizeLon = 0.0;              ///< data grid size in longitude direction
     bool _isValid = false;                  ///< data loaded is valid
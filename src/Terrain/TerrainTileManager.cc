@@ -15,6 +15,7 @@
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkRequest>
 
+#include <algorithm>
 #include <limits>
 
 #include "QGCNetworkHelper.h"
@@ -39,63 +40,129 @@ TerrainTileManager::TerrainTileManager(QObject *parent)
     qCDebug(TerrainTileManagerLog) << this;
 
     QGCNetworkHelper::configureProxy(_networkManager);
+
+    // Lookups can come from any thread, so the cache is sampled on a timer rather than from the lookup path
+    _statisticsTimer.setInterval(kStatisticsIntervalMs);
+    (void) connect(&_statisticsTimer, &QTimer::timeout, this, &TerrainTileManager::_logTileCacheStats);
+    _statisticsTimer.start();
 }
 
 TerrainTileManager::~TerrainTileManager()
 {
-    qDeleteAll(_tiles);
-
     qCDebug(TerrainTileManagerLog) << this;
 }
 
+quint64 TerrainTileManager::tileKey(int mapId, int x, int y)
+{
+    // 24 bits per axis covers the 36000 x 18000 tile grid of the 0.01 degree elevation tiles
+    return (static_cast<quint64>(static_cast<quint16>(mapId)) << 48) |
+           (static_cast<quint64>(static_cast<quint32>(x) & 0xFFFFFF) << 24) |
+           (static_cast<quint64>(static_cast<quint32>(y) & 0xFFFFFF));
+}
+
+TerrainTileManager::TileCacheStats TerrainTileManager::tileCacheStats() const
+{
+    QMutexLocker locker(&_tilesMutex);
+
+    TileCacheStats stats = _tileCacheStats;
+    stats.tileCount = _tiles.count();
+    stats.bytes = _tiles.totalCost();
+    stats.maxBytes = _tiles.maxCost();
+    return stats;
+}
+
+void TerrainTileManager::_logTileCacheStats()
+{
+    if (!TerrainTileManagerLog().isDebugEnabled()) {
+        return;
+    }
+
+    const TileCacheStats stats = tileCacheStats();
+    const quint64 lookups = stats.hits + stats.misses;
+    if (lookups == _loggedLookups) {
+        return;
+    }
+    _loggedLookups = lookups;
+
+    qCDebug(TerrainTileManagerLog) << "Tile cache hits:" << stats.hits << "misses:" << stats.misses
+                                   << "hit rate:" << (static_cast<double>(stats.hits) / lookups)
+                                   << "evictions:" << stats.evictions << "tiles:" << stats.tileCount
+                                   << "bytes:" << stats.bytes << "of" << stats.maxBytes;
+}
+
+void TerrainTileManager::setTileCacheMaxBytes(qsizetype maxBytes)
+{
+    QMutexLocker locker(&_tilesMutex);
+
+    const qsizetype countBefore = _tiles.count();
+    _tiles.setMaxCost(maxBytes);
+    _tileCacheStats.evictions += static_cast<quint64>(countBefore - _tiles.count());
+}
+
 bool TerrainTileManager::getAltitudesForCoordinates(const QList<QGeoCoordinate> &coordinates, QList<double> &altitudes, bool &error)
 {
     error = false;
 
     const QString elevationProviderName = SettingsManager::instance()->flightMapSettings()->elevationMapProvider()->rawValue().toString();
     const SharedMapProvider provider = UrlFactory::getMapProviderFromProviderType(elevationProviderName);
-    for (const QGeoCoordinate &coordinate: coordinates) {
-        const QString tileHash = UrlFactory::getTileHash(
-            provider->getMapName(),
-            provider->long2tileX(coordinate.longitude(), 1),
-            provider->lat2tileY(coordinate.latitude(), 1),
-            1
-        );
-        qCDebug(TerrainTileManagerLog) << "hash:coordinate" << tileHash << coordinate;
-
-        TerrainTile* const tile = _getCachedTile(tileHash);
+
+    // Path and carpet queries walk the terrain in order, so consecutive coordinates mostly share a tile. Each run of
+    // coordinates in the same tile costs one hash lookup and one batched sampling call.
+    const qsizetype firstAltitude = altitudes.size();
+    altitudes.resize(firstAltitude + coordinates.size());
+
+    qsizetype runStart = 0;
+    while (runStart < coordinates.size()) {
+        const QGeoCoordinate &coordinate = coordinates[runStart];
+        const int tileX = provider->long2tileX(coordinate.longitude(), 1);
+        const int tileY = provider->lat2tileY(coordinate.latitude(), 1);
+
+        qsizetype runEnd = runStart + 1;
+        while ((runEnd < coordinates.size()) &&
+               (provider->long2tileX(coordinates[runEnd].longitude(), 1) == tileX) &&
+               (provider->lat2tileY(coordinates[runEnd].latitude(), 1) == tileY)) {
+            runEnd++;
+        }
+
+        const quint64 key = tileKey(provider->getMapId(), tileX, tileY);
+        qCDebug(TerrainTileManagerLog) << "tile:coordinate:count" << tileX << tileY << coordinate << (runEnd - runStart);
+
+        const std::shared_ptr<const TerrainTile> tile = _getCachedTile(key);
         if (tile) {
-            const double elevation = tile->elevation(coordinate);
-            if (qIsNaN(elevation)) {
+            const QSpan<const QGeoCoordinate> run = QSpan<const QGeoCoordinate>(coordinates).subspan(runStart, runEnd - runStart);
+            const QSpan<double> runAltitudes = QSpan<double>(altitudes).subspan(firstAltitude + runStart, run.size());
+            if (tile->elevations(run, runAltitudes) > 0) {
                 error = true;
                 qCWarning(TerrainTileManagerLog) << "Internal Error: missing elevation in tile cache";
             } else {
-                qCDebug(TerrainTileManagerLog) << "returning elevation from tile cache" << elevation;
+                qCDebug(TerrainTileManagerLog) << "returning elevations from tile cache";
             }
-            altitudes.push_back(elevation);
-        } else if (_isFailedTile(tileHash)) {
+        } else if (_isFailedTile(key)) {
             // Tile fetch failed recently; short-circuit to avoid hammering the server with repeated requests
             // (e.g. uninitialized 0,0 coordinates from MAVLink TERRAIN_REQUEST returning HTTP 500).
             error = true;
-            altitudes.push_back(qQNaN());
-        } else if (_state != TerrainQuery::State::Downloading) {
-            QGeoTileSpec spec;
-            spec.setX(provider->long2tileX(coordinate.longitude(), 1));
-            spec.setY(provider->lat2tileY(coordinate.latitude(), 1));
-            spec.setZoom(1);
-            spec.setMapId(provider->getMapId());
-            const QNetworkRequest request = QGeoTileFetcherQGC::getNetworkRequest(spec.mapId(), spec.x(), spec.y(), spec.zoom());
-            QGeoTiledMapReplyQGC *reply = new QGeoTiledMapReplyQGC(_networkManager, request, spec, this);
-            (void) connect(reply, &QGeoTiledMapReplyQGC::finished, this, &TerrainTileManager::_terrainDone);
-            if (reply->init()) {
-                _state = TerrainQuery::State::Downloading;
-            } else {
-                reply->deleteLater();
-            }
-            return false;
+            std::fill(altitudes.begin() + firstAltitude + runStart, altitudes.begin() + firstAltitude + runEnd, qQNaN());
         } else {
+            altitudes.resize(firstAltitude);
+            if (_state != TerrainQuery::State::Downloading) {
+                QGeoTileSpec spec;
+                spec.setX(tileX);
+                spec.setY(tileY);
+                spec.setZoom(1);
+                spec.setMapId(provider->getMapId());
+                const QNetworkRequest request = QGeoTileFetcherQGC::getNetworkRequest(spec.mapId(), spec.x(), spec.y(), spec.zoom());
+                QGeoTiledMapReplyQGC *reply = new QGeoTiledMapReplyQGC(_networkManager, request, spec, this);
+                (void) connect(reply, &QGeoTiledMapReplyQGC::finished, this, &TerrainTileManager::_terrainDone);
+                if (reply->init()) {
+                    _state = TerrainQuery::State::Downloading;
+                } else {
+                    reply->deleteLater();
+                }
+            }
             return false;
         }
+
+        runStart = runEnd;
     }
 
     return true;
@@ -142,7 +209,7 @@ void TerrainTileManager::addPathQuery(TerrainQueryInterface *terrainQueryInterfa
 {
     double distanceBetween;
     double finalDistanceBetween;
-    const QList<QGeoCoordinate> coordinates = _pathQueryToCoords(startPoint, endPoint, distanceBetween, finalDistanceBetween);
+    const QList<QGeoCoordinate> coordinates = pathQueryToCoords(startPoint, endPoint, distanceBetween, finalDistanceBetween);
 
     bool error;
     QList<double> altitudes;
@@ -175,39 +242,13 @@ void TerrainTileManager::addPathQuery(TerrainQueryInterface *terrainQueryInterfa
 
 void TerrainTileManager::addCarpetQuery(TerrainQueryInterface *terrainQueryInterface, const QGeoCoordinate &swCoord, const QGeoCoordinate &neCoord, bool statsOnly)
 {
-    if (swCoord.longitude() > neCoord.longitude() || swCoord.latitude() > neCoord.latitude()) {
-        qCWarning(TerrainTileManagerLog) << "Invalid carpet bounds: SW must be south-west of NE";
-        terrainQueryInterface->signalCarpetHeights(false, qQNaN(), qQNaN(), QList<QList<double>>());
-        return;
-    }
-
-    const int gridSizeLat = qCeil((neCoord.latitude() - swCoord.latitude()) / TerrainTileCopernicus::kTileValueSpacingDegrees);
-    const int gridSizeLon = qCeil((neCoord.longitude() - swCoord.longitude()) / TerrainTileCopernicus::kTileValueSpacingDegrees);
-
-    if (gridSizeLat <= 0 || gridSizeLon <= 0) {
-        qCWarning(TerrainTileManagerLog) << "Carpet area too small";
-        terrainQueryInterface->signalCarpetHeights(false, qQNaN(), qQNaN(), QList<QList<double>>());
-        return;
-    }
-
-    if (gridSizeLat > kMaxCarpetGridSize || gridSizeLon > kMaxCarpetGridSize) {
-        qCWarning(TerrainTileManagerLog) << "Carpet area too large"
-                                         << "gridSizeLat:" << gridSizeLat
-                                         << "gridSizeLon:" << gridSizeLon
-                                         << "maxGridSize:" << kMaxCarpetGridSize;
+    QList<QGeoCoordinate> coordinates;
+    int gridSizeLat, gridSizeLon;
+    if (!carpetQueryToCoords(swCoord, neCoord, coordinates, gridSizeLat, gridSizeLon)) {
         terrainQueryInterface->signalCarpetHeights(false, qQNaN(), qQNaN(), QList<QList<double>>());
         return;
     }
 
-    QList<QGeoCoordinate> coordinates;
-    for (int latIdx = 0; latIdx <= gridSizeLat; latIdx++) {
-        const double lat = swCoord.latitude() + (latIdx * TerrainTileCopernicus::kTileValueSpacingDegrees);
-        for (int lonIdx = 0; lonIdx <= gridSizeLon; lonIdx++) {
-            const double lon = swCoord.longitude() + (lonIdx * TerrainTileCopernicus::kTileValueSpacingDegrees);
-            (void) coordinates.append(QGeoCoordinate(lat, lon));
-        }
-    }
-
     bool error;
     QList<double> altitudes;
     if (!getAltitudesForCoordinates(coordinates, altitudes, error)) {
@@ -219,8 +260,8 @@ void TerrainTileManager::addCarpetQuery(TerrainQueryInterface *terrainQueryInter
             0,
             coordinates,
             statsOnly,
-            gridSizeLat + 1,
-            gridSizeLon + 1
+            gridSizeLat,
+            gridSizeLon
         };
         _requestQueue.enqueue(queuedRequestInfo);
         return;
@@ -234,13 +275,13 @@ void TerrainTileManager::addCarpetQuery(TerrainQueryInterface *terrainQueryInter
 
     double minHeight, maxHeight;
     QList<QList<double>> carpet;
-    _processCarpetResults(altitudes, gridSizeLat + 1, gridSizeLon + 1, statsOnly, minHeight, maxHeight, carpet);
+    processCarpetResults(altitudes, gridSizeLat, gridSizeLon, statsOnly, minHeight, maxHeight, carpet);
 
     qCDebug(TerrainTileManagerLog) << "carpet altitudes from cached data, min:" << minHeight << "max:" << maxHeight;
     terrainQueryInterface->signalCarpetHeights(true, minHeight, maxHeight, carpet);
 }
 
-QList<QGeoCoordinate> TerrainTileManager::_pathQueryToCoords(const QGeoCoordinate &fromCoord, const QGeoCoordinate &toCoord, double &distanceBetween, double &finalDistanceBetween)
+QList<QGeoCoordinate> TerrainTileManager::pathQueryToCoords(const QGeoCoordinate &fromCoord, const QGeoCoordinate &toCoord, double &distanceBetween, double &finalDistanceBetween)
 {
     const double totalDistance = QGCGeo::geodesicDistance(fromCoord, toCoord);
     // TODO: get spacing from terrainQueryInterface
@@ -261,6 +302,45 @@ QList<QGeoCoordinate> TerrainTileManager::_pathQueryToCoords(const QGeoCoordinat
     return coordinates;
 }
 
+bool TerrainTileManager::carpetQueryToCoords(const QGeoCoordinate &swCoord, const QGeoCoordinate &neCoord, QList<QGeoCoordinate> &coordinates, int &gridSizeLat, int &gridSizeLon)
+{
+    if (swCoord.longitude() > neCoord.longitude() || swCoord.latitude() > neCoord.latitude()) {
+        qCWarning(TerrainTileManagerLog) << "Invalid carpet bounds: SW must be south-west of NE";
+        return false;
+    }
+
+    const int cellsLat = qCeil((neCoord.latitude() - swCoord.latitude()) / TerrainTileCopernicus::kTileValueSpacingDegrees);
+    const int cellsLon = qCeil((neCoord.longitude() - swCoord.longitude()) / TerrainTileCopernicus::kTileValueSpacingDegrees);
+
+    if (cellsLat <= 0 || cellsLon <= 0) {
+        qCWarning(TerrainTileManagerLog) << "Carpet area too small";
+        return false;
+    }
+
+    if (cellsLat > kMaxCarpetGridSize || cellsLon > kMaxCarpetGridSize) {
+        qCWarning(TerrainTileManagerLog) << "Carpet area too large"
+                                         << "gridSizeLat:" << cellsLat
+                                         << "gridSizeLon:" << cellsLon
+                                         << "maxGridSize:" << kMaxCarpetGridSize;
+        return false;
+    }
+
+    gridSizeLat = cellsLat + 1;
+    gridSizeLon = cellsLon + 1;
+
+    coordinates.clear();
+    coordinates.reserve(static_cast<qsizetype>(gridSizeLat) * gridSizeLon);
+    for (int latIdx = 0; latIdx < gridSizeLat; latIdx++) {
+        const double lat = swCoord.latitude() + (latIdx * TerrainTileCopernicus::kTileValueSpacingDegrees);
+        for (int lonIdx = 0; lonIdx < gridSizeLon; lonIdx++) {
+            const double lon = swCoord.longitude() + (lonIdx * TerrainTileCopernicus::kTileValueSpacingDegrees);
+            (void) coordinates.append(QGeoCoordinate(lat, lon));
+        }
+    }
+
+    return true;
+}
+
 void TerrainTileManager::_tileFailed()
 {
     QList<double> noAltitudes;
@@ -301,10 +381,10 @@ void TerrainTileManager::_terrainDone()
     const QByteArray responseBytes = reply->mapImageData();
     const QGeoTileSpec spec = reply->tileSpec();
 
-    const QString hash = UrlFactory::getTileHash(UrlFactory::getProviderTypeFromQtMapId(spec.mapId()), spec.x(), spec.y(), spec.zoom());
+    const quint64 key = tileKey(spec.mapId(), spec.x(), spec.y());
 
     if (reply->error() != QGeoTiledMapReplyQGC::NoError) {
-        const bool firstFailure = _recordFailedTile(hash);
+        const bool firstFailure = _recordFailedTile(key);
         if (firstFailure) {
             qCWarning(TerrainTileManagerLog) << "Elevation tile fetching returned error:" << reply->errorString();
         } else {
@@ -315,7 +395,7 @@ void TerrainTileManager::_terrainDone()
     }
 
     if (responseBytes.isEmpty()) {
-        const bool firstFailure = _recordFailedTile(hash);
+        const bool firstFailure = _recordFailedTile(key);
         if (firstFailure) {
             qCWarning(TerrainTileManagerLog) << "Error in fetching elevation tile. Empty response.";
         } else {
@@ -325,11 +405,11 @@ void TerrainTileManager::_terrainDone()
         return;
     }
 
-    _clearFailedTile(hash);
+    _clearFailedTile(key);
 
     qCDebug(TerrainTileManagerLog) << "Received some bytes of terrain data:" << responseBytes.size();
 
-    _cacheTile(responseBytes, hash);
+    _cacheTile(responseBytes, key);
 
     for (qsizetype i = _requestQueue.count() - 1; i >= 0; i--) {
         bool error;
@@ -373,8 +453,8 @@ void TerrainTileManager::_terrainDone()
             } else {
                 double minHeight, maxHeight;
                 QList<QList<double>> carpet;
-                _processCarpetResults(altitudes, requestInfo.carpetGridSizeLat, requestInfo.carpetGridSizeLon,
-                                      requestInfo.carpetStatsOnly, minHeight, maxHeight, carpet);
+                processCarpetResults(altitudes, requestInfo.carpetGridSizeLat, requestInfo.carpetGridSizeLon,
+                                     requestInfo.carpetStatsOnly, minHeight, maxHeight, carpet);
 
                 qCDebug(TerrainTileManagerLog) << "carpet altitudes from cached data, min:" << minHeight << "max:" << maxHeight;
                 requestInfo.terrainQueryInterface->signalCarpetHeights(true, minHeight, maxHeight, carpet);
@@ -388,44 +468,52 @@ void TerrainTileManager::_terrainDone()
     }
 }
 
-void TerrainTileManager::_cacheTile(const QByteArray &data, const QString &hash)
+void TerrainTileManager::_cacheTile(const QByteArray &data, quint64 key)
 {
-    TerrainTile* const terrainTile = new TerrainTile(data);
+    auto terrainTile = std::make_shared<const TerrainTile>(data);
     if (!terrainTile->isValid()) {
-        delete terrainTile;
         qCWarning(TerrainTileManagerLog) << "Received invalid tile";
         return;
     }
 
     QMutexLocker locker(&_tilesMutex);
-    if (!_tiles.contains(hash)) {
-        (void) _tiles.insert(hash, terrainTile);
-    } else {
-        delete terrainTile;
+    if (_tiles.contains(key)) {
+        return;
+    }
+
+    const qsizetype cost = terrainTile->memoryBytes();
+    const qsizetype countBefore = _tiles.count();
+    (void) _tiles.insert(key, new std::shared_ptr<const TerrainTile>(std::move(terrainTile)), cost);
+
+    // QCache evicts least recently used tiles to make room, or drops the new tile if it alone exceeds the budget
+    const qsizetype evicted = countBefore + 1 - _tiles.count();
+    if (evicted > 0) {
+        _tileCacheStats.evictions += static_cast<quint64>(evicted);
+        qCDebug(TerrainTileManagerLog) << "Evicted" << evicted << "tiles, cache now" << _tiles.count() << "tiles"
+                                       << _tiles.totalCost() << "of" << _tiles.maxCost() << "bytes";
     }
 }
 
-TerrainTile *TerrainTileManager::_getCachedTile(const QString &hash)
+std::shared_ptr<const TerrainTile> TerrainTileManager::_getCachedTile(quint64 key)
 {
     QMutexLocker locker(&_tilesMutex);
 
-    if (!_tiles.contains(hash)) {
-        return nullptr;
-    }
-
-    TerrainTile* const tile = _tiles[hash];
-    if (!tile->isValid()) {
+    // object() also marks the tile as most recently used
+    const std::shared_ptr<const TerrainTile> *const tile = _tiles.object(key);
+    if (!tile) {
+        _tileCacheStats.misses++;
         return nullptr;
     }
 
-    return tile;
+    _tileCacheStats.hits++;
+    return *tile;
 }
 
-bool TerrainTileManager::_isFailedTile(const QString &hash)
+bool TerrainTileManager::_isFailedTile(quint64 key)
 {
     QMutexLocker locker(&_tilesMutex);
 
-    const auto it = _failedTiles.constFind(hash);
+    const auto it = _failedTiles.constFind(key);
     if (it == _failedTiles.constEnd()) {
         return false;
     }
@@ -436,7 +524,7 @@ bool TerrainTileManager::_isFailedTile(const QString &hash)
     return false;
 }
 
-bool TerrainTileManager::_recordFailedTile(const QString &hash)
+bool TerrainTileManager::_recordFailedTile(quint64 key)
 {
     QMutexLocker locker(&_tilesMutex);
 
@@ -457,20 +545,20 @@ bool TerrainTileManager::_recordFailedTile(const QString &hash)
         }
     }
 
-    const bool firstFailure = !_failedTiles.contains(hash);
-    _failedTiles.insert(hash, now);
+    const bool firstFailure = !_failedTiles.contains(key);
+    _failedTiles.insert(key, now);
     return firstFailure;
 }
 
-void TerrainTileManager::_clearFailedTile(const QString &hash)
+void TerrainTileManager::_clearFailedTile(quint64 key)
 {
     QMutexLocker locker(&_tilesMutex);
 
-    _failedTiles.remove(hash);
+    _failedTiles.remove(key);
 }
 
-void TerrainTileManager::_processCarpetResults(const QList<double> &altitudes, int gridSizeLat, int gridSizeLon,
-                                               bool statsOnly, double &minHeight, double &maxHeight, QList<QList<double>> &carpet)
+void TerrainTileManager::processCarpetResults(const QList<double> &altitudes, int gridSizeLat, int gridSizeLon,
+                                              bool statsOnly, double &minHeight, double &maxHeight, QList<QList<double>> &carpet)
 {
     minHeight = std::numeric_limits<double>::max();
     maxHeight = std::numeric_limits<double>::lowest();
@@ -2,19 +2,25 @@
 
 #include "TerrainQueryInterface.h"
 
+#include <QtCore/QCache>
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QQueue>
+#include <QtCore/QTimer>
 #include <QtPositioning/QGeoCoordinate>
 
+#include <memory>
+
 class TerrainTile;
 class QNetworkAccessManager;
+class TerrainTileManagerTest;
 class UnitTestTerrainQuery;
 
 class TerrainTileManager : public QObject
 {
     Q_OBJECT
 
+    friend class TerrainTileManagerTest;
     friend class UnitTestTerrainQuery;
 public:
     explicit TerrainTileManager(QObject *parent = nullptr);
@@ -22,6 +28,25 @@ class TerrainTileManager : public QObject
 
     static TerrainTileManager *instance();
 
+    struct TileCacheStats {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+        qsizetype tileCount = 0;
+        qsizetype bytes = 0;
+        qsizetype maxBytes = 0;
+    };
+
+    /// In-memory tile cache counters, for diagnostics. Also logged periodically while the cache is in use.
+    TileCacheStats tileCacheStats() const;
+
+    /// Sets the in-memory tile budget. Least recently used tiles are evicted once the total exceeds it; they are
+    /// refetched from the map engine's disk cache when needed again.
+    void setTileCacheMaxBytes(qsizetype maxBytes);
+
+    /// Packs a tile address into the key used by the tile cache
+    static quint64 tileKey(int mapId, int x, int y);
+
     /// Either returns altitudes from cache or queues database request
     ///     @param[out] error true: altitude not returned due to error, false: altitudes returned
     ///     @return true: altitude returned (check error as well), false: database query queued (altitudes not returned)
@@ -31,20 +56,30 @@ class TerrainTileManager : public QObject
     void addPathQuery(TerrainQueryInterface *terrainQueryInterface, const QGeoCoordinate &startPoint, const QGeoCoordinate &endPoint);
     void addCarpetQuery(TerrainQueryInterface *terrainQueryInterface, const QGeoCoordinate &swCoord, const QGeoCoordinate &neCoord, bool statsOnly);
 
+    /// Returns a list of individual coordinates along the requested path spaced according to the terrain tile value spacing
+    static QList<QGeoCoordinate> pathQueryToCoords(const QGeoCoordinate &fromCoord, const QGeoCoordinate &toCoord, double &distanceBetween, double &finalDistanceBetween);
+
+    /// Returns the row-major grid of coordinates covering the requested area at the terrain tile value spacing
+    ///     @param[out] gridSizeLat number of rows
+    ///     @param[out] gridSizeLon number of columns
+    ///     @return false: bounds are inverted or the area is too small or too large
+    static bool carpetQueryToCoords(const QGeoCoordinate &swCoord, const QGeoCoordinate &neCoord, QList<QGeoCoordinate> &coordinates, int &gridSizeLat, int &gridSizeLon);
+
+    static void processCarpetResults(const QList<double> &altitudes, int gridSizeLat, int gridSizeLon,
+                                     bool statsOnly, double &minHeight, double &maxHeight, QList<QList<double>> &carpet);
+
 private slots:
     void _terrainDone();
+    void _logTileCacheStats();
 
 private:
-    /// Returns a list of individual coordinates along the requested path spaced according to the terrain tile value spacing
-    static QList<QGeoCoordinate> _pathQueryToCoords(const QGeoCoordinate &fromCoord, const QGeoCoordinate &toCoord, double &distanceBetween, double &finalDistanceBetween);
     void _tileFailed();
-    void _cacheTile(const QByteArray &data, const QString &hash);
-    TerrainTile *_getCachedTile(const QString &hash);
-    bool _isFailedTile(const QString &hash);
-    bool _recordFailedTile(const QString &hash);    ///< Records a failed fetch; returns true if this is the first failure for the tile
-    void _clearFailedTile(const QString &hash);
-    static void _processCarpetResults(const QList<double> &altitudes, int gridSizeLat, int gridSizeLon,
-                                      bool statsOnly, double &minHeight, double &maxHeight, QList<QList<double>> &carpet);
+    void _cacheTile(const QByteArray &data, quint64 key);
+    /// The returned tile stays valid even if it is evicted while the caller is still sampling it
+    std::shared_ptr<const TerrainTile> _getCachedTile(quint64 key);
+    bool _isFailedTile(quint64 key);
+    bool _recordFailedTile(quint64 key);    ///< Records a failed fetch; returns true if this is the first failure for the tile
+    void _clearFailedTile(quint64 key);
 
     struct QueuedRequestInfo_t {
         QPointer<TerrainQueryInterface> terrainQueryInterface;
@@ -60,12 +95,18 @@ private slots:
     QQueue<QueuedRequestInfo_t> _requestQueue;
     TerrainQuery::State _state = TerrainQuery::State::Idle;
 
-    QMutex _tilesMutex;                     ///< Guards both _tiles and _failedTiles
-    QHash<QString, TerrainTile*> _tiles;
-    QHash<QString, qint64> _failedTiles;  ///< Tile hash -> ms since epoch of last failed fetch; suppresses immediate retries
+    mutable QMutex _tilesMutex;             ///< Guards _tiles, _tileCacheStats and _failedTiles
+    QCache<quint64, std::shared_ptr<const TerrainTile>> _tiles{kDefaultTileCacheMaxBytes};    ///< LRU, cost is TerrainTile::memoryBytes()
+    TileCacheStats _tileCacheStats;
+    QHash<quint64, qint64> _failedTiles;    ///< Tile key -> ms since epoch of last failed fetch; suppresses immediate retries
     qint64 _lastFailedTileSweepMs = 0;      ///< ms since epoch of last expired-entry sweep of _failedTiles
 
     QNetworkAccessManager *_networkManager = nullptr;
 
+    QTimer _statisticsTimer;
+    quint64 _loggedLookups = 0;             ///< hits + misses at the last statistics log
+
     static constexpr qint64 kFailedTileBackoffMs = 5000;
+    static constexpr int kStatisticsIntervalMs = 10000;
+    static constexpr qsizetype kDefaultTileCacheMaxBytes = 32 * 1024 * 1024;
 };
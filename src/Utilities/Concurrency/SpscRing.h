@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace QGC {
+
+/// \brief Bounded lock-free single-producer / single-consumer ring.
+///
+/// Exactly one thread may call the producer methods and one (other) thread the consumer methods at any time.
+/// Slots are filled and drained in place, so large elements are never copied through a temporary:
+/// \code
+///     if (T *slot = ring.producerSlot()) { fill(*slot); ring.publish(); }
+///     while (T *slot = ring.consumerSlot()) { use(*slot); ring.release(); }
+/// \endcode
+template <typename T>
+class SpscRing
+{
+public:
+    /// @param capacity Rounded up to a power of two
+    explicit SpscRing(size_t capacity)
+        : _capacity(_roundUpPow2(capacity)),
+          _mask(_capacity - 1),
+          _slots(std::make_unique<T[]>(_capacity))
+    {
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    size_t capacity() const { return _capacity; }
+
+    /// Approximate from any thread, exact from either endpoint.
+    size_t size() const
+    {
+        // Head first: tail never falls behind a head read earlier, so this cannot underflow.
+        const size_t head = _head.load(std::memory_order_acquire);
+        return _tail.load(std::memory_order_acquire) - head;
+    }
+
+    bool isEmpty() const { return size() == 0; }
+
+    // Producer side
+
+    /// @return Next free slot, or nullptr if the ring is full
+    T *producerSlot()
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if ((tail - _producerHeadCache) == _capacity) {
+            _producerHeadCache = _head.load(std::memory_order_acquire);
+            if ((tail - _producerHeadCache) == _capacity) {
+                return nullptr;
+            }
+        }
+        return &_slots[tail & _mask];
+    }
+
+    /// Makes the slot returned by producerSlot() visible to the consumer.
+    void publish() { _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    bool tryPush(const T &value)
+    {
+        T *const slot = producerSlot();
+        if (!slot) {
+            return false;
+        }
+        *slot = value;
+        publish();
+        return true;
+    }
+
+    // Consumer side
+
+    /// @return Oldest published slot, or nullptr if the ring is empty
+    T *consumerSlot()
+    {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _consumerTailCache) {
+            _consumerTailCache = _tail.load(std::memory_order_acquire);
+            if (head == _consumerTailCache) {
+                return nullptr;
+            }
+        }
+        return &_slots[head & _mask];
+    }
+
+    /// Returns the slot from consumerSlot() to the producer.
+    void release() { _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    /// Consumer: drops everything currently published.
+    void discard()
+    {
+        _consumerTailCache = _tail.load(std::memory_order_acquire);
+        _head.store(_consumerTailCache, std::memory_order_release);
+    }
+
+private:
+    static size_t _roundUpPow2(size_t value)
+    {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    static constexpr size_t kCacheLine = 64;
+
+    const size_t _capacity;
+    const size_t _mask;
+    std::unique_ptr<T[]> _slots;
+
+    // Indices grow without wrapping; slot = index & _mask. Each side caches the other's index to avoid
+    // touching its cache line on every call.
+    alignas(kCacheLine) std::atomic<size_t> _head{0};
+    size_t _consumerTailCache = 0;
+    alignas(kCacheLine) std::atomic<size_t> _tail{0};
+    size_t _producerHeadCache = 0;
+};
+
+}  // namespace QGC
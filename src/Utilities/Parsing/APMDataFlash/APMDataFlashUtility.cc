@@ -1,7 +1,10 @@
 #include "APMDataFlashUtility.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QSet>
+
 #include <cstring>
+#include <utility>
 
 QGC_LOGGING_CATEGORY(APMDataFlashUtilityLog, "Utilities.APMDataFlashUtility")
 
@@ -184,6 +187,237 @@ QMap<QString, QVariant> parseMessage(const char *data, const MessageFormat &fmt)
     return result;
 }
 
+double parseNumericValue(const char *data, char formatChar)
+{
+    switch (formatChar) {
+    case 'b':
+        return static_cast<int8_t>(*data);
+    case 'B':
+    case 'M':
+        return static_cast<uint8_t>(*data);
+    case 'h': {
+        int16_t val;
+        memcpy(&val, data, sizeof(val));
+        return val;
+    }
+    case 'H': {
+        uint16_t val;
+        memcpy(&val, data, sizeof(val));
+        return val;
+    }
+    case 'c': {
+        int16_t val;
+        memcpy(&val, data, sizeof(val));
+        return val / 100.0;
+    }
+    case 'C': {
+        uint16_t val;
+        memcpy(&val, data, sizeof(val));
+        return val / 100.0;
+    }
+    case 'i': {
+        int32_t val;
+        memcpy(&val, data, sizeof(val));
+        return val;
+    }
+    case 'I': {
+        uint32_t val;
+        memcpy(&val, data, sizeof(val));
+        return val;
+    }
+    case 'e': {
+        int32_t val;
+        memcpy(&val, data, sizeof(val));
+        return val / 100.0;
+    }
+    case 'E': {
+        uint32_t val;
+        memcpy(&val, data, sizeof(val));
+        return val / 100.0;
+    }
+    case 'L': {
+        int32_t val;
+        memcpy(&val, data, sizeof(val));
+        return val / 1.0e7;
+    }
+    case 'f': {
+        float val;
+        memcpy(&val, data, sizeof(val));
+        return static_cast<double>(val);
+    }
+    case 'd': {
+        double val;
+        memcpy(&val, data, sizeof(val));
+        return val;
+    }
+    case 'q': {
+        int64_t val;
+        memcpy(&val, data, sizeof(val));
+        return static_cast<double>(val);
+    }
+    case 'Q': {
+        uint64_t val;
+        memcpy(&val, data, sizeof(val));
+        return static_cast<double>(val);
+    }
+    case 'g': {
+        uint16_t bits;
+        memcpy(&bits, data, sizeof(bits));
+        return static_cast<double>(halfToFloat(bits));
+    }
+    default:
+        return 0.0;
+    }
+}
+
+bool isNumericFormatChar(char formatChar)
+{
+    switch (formatChar) {
+    case 'n': case 'N': case 'Z': case 'a':
+        return false;
+    default:
+        return (formatCharSize(formatChar) > 0);
+    }
+}
+
+// ============================================================================
+// Compiled Series Decoding
+// ============================================================================
+
+SeriesDecoder::SeriesDecoder(const QMap<uint8_t, MessageFormat> &formats)
+{
+    for (auto it = formats.cbegin(); it != formats.cend(); ++it) {
+        const MessageFormat &fmt = it.value();
+        Plan &plan = _plans[it.key()];
+        const int payloadSize = fmt.length - 3;
+
+        // Same walk as parseMessage(); a column named twice keeps its last value there, so only the last one counts
+        QList<Field> columns;
+        QStringList names;
+        int offset = 0;
+        for (int i = 0; i < fmt.format.length() && i < fmt.columns.size(); ++i) {
+            const char formatChar = fmt.format.at(i).toLatin1();
+            const int size = formatCharSize(formatChar);
+            if (size == 0) {
+                continue;
+            }
+
+            const QString &column = fmt.columns.at(i);
+            const qsizetype previous = names.indexOf(column);
+            if (previous >= 0) {
+                names.removeAt(previous);
+                columns.removeAt(previous);
+            }
+            names.append(column);
+            // Columns running past the payload would read the next message
+            columns.append({offset, ((offset + size) <= payloadSize) ? formatChar : '\0', -1});
+            offset += size;
+        }
+
+        for (qsizetype i = 0; i < names.size(); ++i) {
+            const QString &column = names.at(i);
+            const Field &field = columns.at(i);
+            const QString fieldName = fmt.name + QLatin1Char('.') + column;
+            plan.fieldNames.append(fieldName);
+            if (isNumericFormatChar(field.formatChar)) {
+                plan.fields.append({field.offset, field.formatChar, _seriesIndex(fieldName)});
+            }
+        }
+
+        static const std::array<std::pair<QString, double>, 3> timeColumns = {{
+            {QStringLiteral("TimeUS"), 1000000.0},
+            {QStringLiteral("TimeMS"), 1000.0},
+            {QStringLiteral("Time"), 1000.0},
+        }};
+        for (const auto &[column, divisor] : timeColumns) {
+            const qsizetype index = names.indexOf(column);
+            if (index < 0) {
+                continue;
+            }
+            if (columns.at(index).formatChar != '\0') {
+                plan.timeOffset = columns.at(index).offset;
+                plan.timeFormatChar = columns.at(index).formatChar;
+                plan.timeDivisor = divisor;
+            }
+            break;
+        }
+    }
+}
+
+int SeriesDecoder::_seriesIndex(const QString &fieldName)
+{
+    const auto it = _seriesByName.constFind(fieldName);
+    if (it != _seriesByName.cend()) {
+        return it.value();
+    }
+
+    const int index = static_cast<int>(_series.size());
+    _seriesNames.append(fieldName);
+    _series.append(QVector<QPointF>());
+    (void) _seriesByName.insert(fieldName, index);
+    return index;
+}
+
+double SeriesDecoder::timestampSeconds(uint8_t msgType, const char *payload) const
+{
+    const Plan &plan = _plans[msgType];
+    if (plan.timeOffset < 0) {
+        return -1.0;
+    }
+
+    const char *const data = payload + plan.timeOffset;
+    const double time = isNumericFormatChar(plan.timeFormatChar)
+        ? parseNumericValue(data, plan.timeFormatChar)
+        : parseValue(data, plan.timeFormatChar).toDouble();
+    return time / plan.timeDivisor;
+}
+
+void SeriesDecoder::decode(uint8_t msgType, const char *payload, double timestampSecs)
+{
+    Plan &plan = _plans[msgType];
+    plan.seen = true;
+    if (timestampSecs < 0.0) {
+        return;
+    }
+
+    for (const Field &field : std::as_const(plan.fields)) {
+        _series[field.series].append(QPointF(timestampSecs, parseNumericValue(payload + field.offset, field.formatChar)));
+    }
+}
+
+QList<SeriesDecoder::Column> SeriesDecoder::numericColumns(uint8_t msgType) const
+{
+    QList<Column> columns;
+    for (const Field &field : _plans[msgType].fields) {
+        columns.append({_seriesNames.at(field.series), field.offset, field.formatChar});
+    }
+    return columns;
+}
+
+QStringList SeriesDecoder::fieldNames() const
+{
+    QSet<QString> names;
+    for (const Plan &plan : _plans) {
+        if (plan.seen) {
+            for (const QString &name : plan.fieldNames) {
+                names.insert(name);
+            }
+        }
+    }
+    return names.values();
+}
+
+QHash<QString, QVector<QPointF>> SeriesDecoder::takeSeries()
+{
+    QHash<QString, QVector<QPointF>> result;
+    for (qsizetype i = 0; i < _series.size(); ++i) {
+        if (!_series.at(i).isEmpty()) {
+            (void) result.insert(_seriesNames.at(i), std::exchange(_series[i], QVector<QPointF>()));
+        }
+    }
+    return result;
+}
+
 // ============================================================================
 // Header and Message Detection
 // ============================================================================
@@ -317,4 +551,47 @@ int iterateMessages(const char *data, qint64 size,
     return count;
 }
 
+QList<qint64> findChunkBoundaries(const char *data, qint64 size,
+                                  const QMap<uint8_t, MessageFormat> &formats,
+                                  qint64 chunkSize)
+{
+    std::array<bool, 256> known{};
+    std::array<int, 256> payloadSizes{};
+    for (auto it = formats.cbegin(); it != formats.cend(); ++it) {
+        known[it.key()] = true;
+        payloadSizes[it.key()] = it.value().length - 3;
+    }
+
+    QList<qint64> boundaries{0};
+    qint64 pos = 0;
+
+    // Same walk as iterateMessages(), hopping over payloads instead of decoding them
+    while (pos + 3 <= size) {
+        if (static_cast<uint8_t>(data[pos]) != kHeaderByte1 ||
+            static_cast<uint8_t>(data[pos + 1]) != kHeaderByte2) {
+            ++pos;
+            continue;
+        }
+
+        const uint8_t msgType = static_cast<uint8_t>(data[pos + 2]);
+        pos += 3;
+        if (!known[msgType]) {
+            continue;
+        }
+        const int payloadSize = payloadSizes[msgType];
+        if (pos + payloadSize > size) {
+            break;
+        }
+
+        const qint64 messageStart = pos - 3;
+        if ((messageStart - boundaries.last()) >= chunkSize) {
+            boundaries.append(messageStart);
+        }
+
+        pos += payloadSize;
+    }
+
+    return boundaries;
+}
+
 } // namespace APMDataFlashUtility
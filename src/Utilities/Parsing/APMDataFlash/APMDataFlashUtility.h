@@ -1,11 +1,15 @@
 #pragma once
 
 #include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QMap>
+#include <QtCore/QPointF>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QVariant>
 
+#include <array>
 #include <cstdint>
 #include <functional>
 
@@ -68,6 +72,76 @@ QVariant parseValue(const char *data, char formatChar);
 /// @return Map of column name to parsed value
 QMap<QString, QVariant> parseMessage(const char *data, const MessageFormat &fmt);
 
+/// Numeric value of a field as parseValue(data, formatChar).toDouble() would give it, without the QVariant
+/// @param data Pointer to binary data
+/// @param formatChar Numeric format character (see isNumericFormatChar())
+double parseNumericValue(const char *data, char formatChar);
+
+/// Whether parseValue() returns a number for a format character (strings and byte arrays are not)
+bool isNumericFormatChar(char formatChar);
+
+// ============================================================================
+// Compiled Series Decoding
+// ============================================================================
+
+/// Decodes the numeric columns of messages straight into one time series per "<MSG>.<Column>" field.
+/// Every format is compiled once into a flat table of (payload offset, format character, series index), so
+/// decoding a message builds no value map and looks up no names. The fields and samples it produces are the
+/// ones parseMessage() followed by a name lookup per value would.
+class SeriesDecoder
+{
+public:
+    explicit SeriesDecoder(const QMap<uint8_t, MessageFormat> &formats);
+
+    /// Timestamp of a message from its TimeUS, TimeMS or Time column, in seconds; -1 if it has none
+    double timestampSeconds(uint8_t msgType, const char *payload) const;
+
+    /// Append the numeric columns of a message to their series at @p timestampSecs; a negative timestamp only
+    /// marks the message type as seen
+    void decode(uint8_t msgType, const char *payload, double timestampSecs);
+
+    /// Mark a message type as seen without decoding it, for callers that store its columns themselves
+    void markSeen(uint8_t msgType) { _plans[msgType].seen = true; }
+
+    struct Column {
+        QString fieldName;
+        int offset = 0;
+        char formatChar = 0;
+    };
+
+    /// The numeric columns decode() appends for a message type, in payload order
+    QList<Column> numericColumns(uint8_t msgType) const;
+
+    /// Fields of every message type decoded so far, unsorted
+    QStringList fieldNames() const;
+
+    /// Series with at least one sample, by field name. Leaves the decoder's series empty.
+    QHash<QString, QVector<QPointF>> takeSeries();
+
+private:
+    struct Field {
+        int offset = 0;
+        char formatChar = 0;
+        int series = -1;
+    };
+
+    struct Plan {
+        QList<Field> fields;
+        QStringList fieldNames;
+        int timeOffset = -1;
+        char timeFormatChar = 0;
+        double timeDivisor = 1.0;
+        bool seen = false;
+    };
+
+    int _seriesIndex(const QString &fieldName);
+
+    std::array<Plan, 256> _plans;
+    QStringList _seriesNames;
+    QList<QVector<QPointF>> _series;
+    QHash<QString, int> _seriesByName;
+};
+
 // ============================================================================
 // Header and Message Detection
 // ============================================================================
@@ -126,6 +200,18 @@ int iterateMessages(const char *data, qint64 size,
                     const MessageCallback &callback,
                     const std::function<void(float)> &progressCallback = nullptr);
 
+/// Offsets at which to split a DataFlash log for decoding in pieces (first pass)
+/// Each offset is where iterateMessages() starts a message, so iterating each piece visits exactly the messages
+/// iterating the whole log would, in the same order.
+/// @param data Pointer to complete log data
+/// @param size Size of log data
+/// @param formats Message formats from parseFmtMessages()
+/// @param chunkSize Minimum distance between two offsets
+/// @return Start offset of every piece, beginning with 0
+QList<qint64> findChunkBoundaries(const char *data, qint64 size,
+                                  const QMap<uint8_t, MessageFormat> &formats,
+                                  qint64 chunkSize);
+
 // ============================================================================
 // Half-Precision Float Conversion
 // ============================================================================
@@ -7,6 +7,15 @@ BatteryFactGroupListModel::BatteryFactGroupListModel(QObject* parent)
 
 }
 
+QList<uint32_t> BatteryFactGroupListModel::handledMessageIds() const
+{
+    return {
+        MAVLINK_MSG_ID_HIGH_LATENCY,
+        MAVLINK_MSG_ID_HIGH_LATENCY2,
+        MAVLINK_MSG_ID_BATTERY_STATUS,
+    };
+}
+
 bool BatteryFactGroupListModel::_shouldHandleMessage(const mavlink_message_t &message, QList<uint32_t> &ids) const
 {
     ids.clear();
@@ -36,6 +45,7 @@ FactGroupWithId *BatteryFactGroupListModel::_createFactGroupWithId(uint32_t id)
 BatteryFactGroup::BatteryFactGroup(uint32_t batteryId, QObject *parent)
     : FactGroupWithId(1000, QStringLiteral(":/json/Vehicle/BatteryFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_batteryFunctionFact);
     _addFact(&_batteryTypeFact);
     _addFact(&_voltageFact);
@@ -80,6 +90,15 @@ void BatteryFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t &
     }
 }
 
+QList<uint32_t> BatteryFactGroup::handledMessageIds() const
+{
+    return {
+        MAVLINK_MSG_ID_HIGH_LATENCY,
+        MAVLINK_MSG_ID_HIGH_LATENCY2,
+        MAVLINK_MSG_ID_BATTERY_STATUS,
+    };
+}
+
 void BatteryFactGroup::_handleHighLatency(Vehicle * /*vehicle*/, const mavlink_message_t &message)
 {
     mavlink_high_latency_t highLatency{};
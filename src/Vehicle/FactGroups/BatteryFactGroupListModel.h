@@ -11,6 +11,8 @@ class BatteryFactGroupListModel : public FactGroupListModel
 public:
     explicit BatteryFactGroupListModel(QObject* parent = nullptr);
 
+    QList<uint32_t> handledMessageIds() const final;
+
 protected:
     // Overrides from FactGroupListModel
     bool _shouldHandleMessage(const mavlink_message_t &message, QList<uint32_t> &ids) const final;
@@ -49,6 +51,7 @@ class BatteryFactGroup : public FactGroupWithId
 
     // Overrides from FactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 private slots:
     void _timeRemainingChanged(const QVariant &value);
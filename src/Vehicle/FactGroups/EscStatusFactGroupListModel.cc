@@ -8,6 +8,14 @@ EscStatusFactGroupListModel::EscStatusFactGroupListModel(QObject* parent)
 
 }
 
+QList<uint32_t> EscStatusFactGroupListModel::handledMessageIds() const
+{
+    return {
+        MAVLINK_MSG_ID_ESC_INFO,
+        MAVLINK_MSG_ID_ESC_STATUS,
+    };
+}
+
 bool EscStatusFactGroupListModel::_shouldHandleMessage(const mavlink_message_t &message, QList<uint32_t> &ids) const
 {
     bool shouldHandle = false;
@@ -54,6 +62,7 @@ FactGroupWithId *EscStatusFactGroupListModel::_createFactGroupWithId(uint32_t id
 EscStatusFactGroup::EscStatusFactGroup(uint32_t escIndex, QObject *parent)
     : FactGroupWithId(1000, QStringLiteral(":/json/Vehicle/EscStatusFactGroup.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_rpmFact);
     _addFact(&_currentFact);
     _addFact(&_voltageFact);
@@ -90,6 +99,14 @@ void EscStatusFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t
     }
 }
 
+QList<uint32_t> EscStatusFactGroup::handledMessageIds() const
+{
+    return {
+        MAVLINK_MSG_ID_ESC_INFO,
+        MAVLINK_MSG_ID_ESC_STATUS,
+    };
+}
+
 void EscStatusFactGroup::_handleEscInfo(Vehicle * /*vehicle*/, const mavlink_message_t &message)
 {
     mavlink_esc_info_t escInfo{};
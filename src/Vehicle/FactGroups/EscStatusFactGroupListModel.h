@@ -11,6 +11,8 @@ class EscStatusFactGroupListModel : public FactGroupListModel
 public:
     explicit EscStatusFactGroupListModel(QObject* parent = nullptr);
 
+    QList<uint32_t> handledMessageIds() const final;
+
 protected:
     // Overrides from FactGroupListModel
     bool _shouldHandleMessage(const mavlink_message_t &message, QList<uint32_t> &ids) const final;
@@ -46,6 +48,7 @@ class EscStatusFactGroup : public FactGroupWithId
 
     // Overrides from FactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 private:
     void _handleEscInfo(Vehicle *vehicle, const mavlink_message_t &message);
@@ -6,6 +6,7 @@
 RadioStatusFactGroup::RadioStatusFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/RadioStatusFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_lrssiFact);
     _addFact(&_rrssiFact);
     _addFact(&_rxErrorsFact);
@@ -24,6 +25,11 @@ void RadioStatusFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message
     }
 }
 
+QList<uint32_t> RadioStatusFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_RADIO_STATUS };
+}
+
 void RadioStatusFactGroup::_handleRadioStatus(const mavlink_message_t &message)
 {
     mavlink_radio_status_t rstatus{};
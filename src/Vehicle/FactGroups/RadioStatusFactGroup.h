@@ -33,6 +33,7 @@ class RadioStatusFactGroup : public FactGroup
     Fact *rNoise()   { return &_rNoiseFact; }
 
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 private:
     void _handleRadioStatus(const mavlink_message_t &message);
@@ -3,6 +3,7 @@
 TerrainFactGroup::TerrainFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/TerrainFactGroup.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_blocksPendingFact);
     _addFact(&_blocksLoadedFact);
 }
@@ -4,6 +4,7 @@
 VehicleClockFactGroup::VehicleClockFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/ClockFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_currentTimeFact);
     _addFact(&_currentUTCTimeFact);
     _addFact(&_currentDateFact);
@@ -16,6 +16,9 @@ class VehicleClockFactGroup : public FactGroup
     Fact *currentUTCTime() { return &_currentUTCTimeFact; }
     Fact *currentDate() { return &_currentDateFact; }
 
+    // Driven by the update timer, not by incoming messages
+    QList<uint32_t> handledMessageIds() const final { return {}; }
+
 private slots:
     void _updateAllValues() final;
 
@@ -4,6 +4,7 @@
 VehicleDistanceSensorFactGroup::VehicleDistanceSensorFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/DistanceSensorFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_rotationNoneFact);
     _addFact(&_rotationYaw45Fact);
     _addFact(&_rotationYaw90Fact);
@@ -59,3 +60,8 @@ void VehicleDistanceSensorFactGroup::handleMessage(Vehicle *vehicle, const mavli
 
     _setTelemetryAvailable(true);
 }
+
+QList<uint32_t> VehicleDistanceSensorFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_DISTANCE_SENSOR };
+}
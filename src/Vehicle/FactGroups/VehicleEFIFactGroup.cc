@@ -4,6 +4,7 @@
 VehicleEFIFactGroup::VehicleEFIFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/EFIFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_healthFact);
     _addFact(&_ecuIndexFact);
     _addFact(&_rpmFact);
@@ -58,6 +59,11 @@ void VehicleEFIFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_
     }
 }
 
+QList<uint32_t> VehicleEFIFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_EFI_STATUS };
+}
+
 void VehicleEFIFactGroup::_handleEFIStatus(const mavlink_message_t &message)
 {
     mavlink_efi_status_t efi{};
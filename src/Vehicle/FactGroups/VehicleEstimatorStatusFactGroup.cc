@@ -4,6 +4,7 @@
 VehicleEstimatorStatusFactGroup::VehicleEstimatorStatusFactGroup(QObject *parent)
     : FactGroup(500, QStringLiteral(":/json/Vehicle/EstimatorStatusFactGroup.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_goodAttitudeEstimateFact);
     _addFact(&_goodHorizVelEstimateFact);
     _addFact(&_goodVertVelEstimateFact);
@@ -60,3 +61,8 @@ void VehicleEstimatorStatusFactGroup::handleMessage(Vehicle *vehicle, const mavl
 
     _setTelemetryAvailable(true);
 }
+
+QList<uint32_t> VehicleEstimatorStatusFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_ESTIMATOR_STATUS };
+}
@@ -52,6 +52,7 @@ class VehicleEstimatorStatusFactGroup : public FactGroup
 
     // Overrides from FactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 private:
     Fact _goodAttitudeEstimateFact = Fact(0, QStringLiteral("goodAttitudeEsimate"), FactMetaData::valueTypeBool);
@@ -10,6 +10,7 @@
 VehicleFactGroup::VehicleFactGroup(QObject *parent)
     : FactGroup(100, QStringLiteral(":/json/Vehicle/VehicleFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_rollFact);
     _addFact(&_pitchFact);
     _addFact(&_headingFact);
@@ -107,6 +108,22 @@ void VehicleFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t &
     }
 }
 
+QList<uint32_t> VehicleFactGroup::handledMessageIds() const
+{
+    QList<uint32_t> msgIds = {
+        MAVLINK_MSG_ID_ATTITUDE,
+        MAVLINK_MSG_ID_ATTITUDE_QUATERNION,
+        MAVLINK_MSG_ID_ALTITUDE,
+        MAVLINK_MSG_ID_VFR_HUD,
+        MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT,
+        MAVLINK_MSG_ID_RAW_IMU,
+    };
+#ifndef QGC_NO_ARDUPILOT_DIALECT
+    msgIds.append(MAVLINK_MSG_ID_RANGEFINDER);
+#endif
+    return msgIds;
+}
+
 void VehicleFactGroup::_handleAttitudeWorker(double rollRadians, double pitchRadians, double yawRadians)
 {
     double rollDegrees = QGC::limitAngleToPMPIf(rollRadians);
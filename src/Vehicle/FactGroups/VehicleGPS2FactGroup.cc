@@ -21,6 +21,14 @@ void VehicleGPS2FactGroup::handleMessage(Vehicle *vehicle, const mavlink_message
     }
 }
 
+QList<uint32_t> VehicleGPS2FactGroup::handledMessageIds() const
+{
+    return {
+        MAVLINK_MSG_ID_GPS2_RAW,
+        MAVLINK_MSG_ID_GNSS_INTEGRITY,
+    };
+}
+
 void VehicleGPS2FactGroup::_handleGps2Raw(const mavlink_message_t &message)
 {
     mavlink_gps2_raw_t gps2Raw{};
@@ -15,6 +15,7 @@
 VehicleGPSAggregateFactGroup::VehicleGPSAggregateFactGroup(QObject *parent)
     : FactGroup(1000, ":/json/Vehicle/GPSFact.json", parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_spoofingStateFact);
     _addFact(&_jammingStateFact);
     _addFact(&_authenticationStateFact);
@@ -43,6 +43,9 @@ class VehicleGPSAggregateFactGroup : public FactGroup
     void updateFromGps(VehicleGPSFactGroup* gps1, VehicleGPSFactGroup* gps2);
     void bindToGps(VehicleGPSFactGroup* gps1, VehicleGPSFactGroup* gps2);
 
+    // Derived from the bound GPS groups, not from incoming messages
+    QList<uint32_t> handledMessageIds() const final { return {}; }
+
 private slots:
     void _updateAggregates();
     void _onIntegrityUpdated();
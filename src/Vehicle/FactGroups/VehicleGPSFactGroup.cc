@@ -9,6 +9,7 @@
 VehicleGPSFactGroup::VehicleGPSFactGroup(QObject *parent)
     : FactGroup(1000, ":/json/Vehicle/GPSFact.json", parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_latFact);
     _addFact(&_lonFact);
     _addFact(&_mgrsFact);
@@ -65,6 +66,16 @@ void VehicleGPSFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_
     }
 }
 
+QList<uint32_t> VehicleGPSFactGroup::handledMessageIds() const
+{
+    return {
+        MAVLINK_MSG_ID_GPS_RAW_INT,
+        MAVLINK_MSG_ID_HIGH_LATENCY,
+        MAVLINK_MSG_ID_HIGH_LATENCY2,
+        MAVLINK_MSG_ID_GNSS_INTEGRITY,
+    };
+}
+
 void VehicleGPSFactGroup::_handleGpsRawInt(const mavlink_message_t &message)
 {
     mavlink_gps_raw_int_t gpsRawInt{};
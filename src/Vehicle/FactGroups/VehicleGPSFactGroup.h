@@ -46,6 +46,7 @@ class VehicleGPSFactGroup : public FactGroup
 
     // Overrides from FactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) override;
+    QList<uint32_t> handledMessageIds() const override;
 
 signals:
     void gnssIntegrityReceived();
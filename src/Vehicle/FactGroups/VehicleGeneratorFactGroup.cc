@@ -4,6 +4,7 @@
 VehicleGeneratorFactGroup::VehicleGeneratorFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/GeneratorFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_statusFact);
     _addFact(&_genSpeedFact);
     _addFact(&_batteryCurrentFact);
@@ -44,6 +45,11 @@ void VehicleGeneratorFactGroup::handleMessage(Vehicle *vehicle, const mavlink_me
     }
 }
 
+QList<uint32_t> VehicleGeneratorFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_GENERATOR_STATUS };
+}
+
 void VehicleGeneratorFactGroup::_handleGeneratorStatus(const mavlink_message_t &message)
 {
     mavlink_generator_status_t generator{};
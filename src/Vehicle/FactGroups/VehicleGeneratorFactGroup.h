@@ -36,6 +36,7 @@ class VehicleGeneratorFactGroup : public FactGroup
 
     // Overrides from FactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 signals:
     void flagsListGeneratorChanged();
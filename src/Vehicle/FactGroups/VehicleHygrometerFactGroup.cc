@@ -4,6 +4,7 @@
 VehicleHygrometerFactGroup::VehicleHygrometerFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/HygrometerFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_hygroTempFact);
     _addFact(&_hygroHumiFact);
     _addFact(&_hygroIDFact);
@@ -26,6 +27,11 @@ void VehicleHygrometerFactGroup::handleMessage(Vehicle *vehicle, const mavlink_m
     }
 }
 
+QList<uint32_t> VehicleHygrometerFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_HYGROMETER_SENSOR };
+}
+
 void VehicleHygrometerFactGroup::_handleHygrometerSensor(const mavlink_message_t &message)
 {
     mavlink_hygrometer_sensor_t hygrometer{};
@@ -4,6 +4,7 @@
 VehicleLocalPositionFactGroup::VehicleLocalPositionFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/LocalPositionFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_xFact);
     _addFact(&_yFact);
     _addFact(&_zFact);
@@ -40,3 +41,8 @@ void VehicleLocalPositionFactGroup::handleMessage(Vehicle *vehicle, const mavlin
 
     _setTelemetryAvailable(true);
 }
+
+QList<uint32_t> VehicleLocalPositionFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_LOCAL_POSITION_NED };
+}
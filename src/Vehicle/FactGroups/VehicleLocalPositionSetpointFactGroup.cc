@@ -4,6 +4,7 @@
 VehicleLocalPositionSetpointFactGroup::VehicleLocalPositionSetpointFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/LocalPositionSetpointFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_xFact);
     _addFact(&_yFact);
     _addFact(&_zFact);
@@ -40,3 +41,8 @@ void VehicleLocalPositionSetpointFactGroup::handleMessage(Vehicle *vehicle, cons
 
     _setTelemetryAvailable(true);
 }
+
+QList<uint32_t> VehicleLocalPositionSetpointFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_POSITION_TARGET_LOCAL_NED };
+}
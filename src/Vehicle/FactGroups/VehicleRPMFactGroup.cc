@@ -4,6 +4,7 @@
 VehicleRPMFactGroup::VehicleRPMFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/RPMFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_rpm1Fact);
     _addFact(&_rpm2Fact);
     _addFact(&_rpm3Fact);
@@ -35,6 +36,14 @@ void VehicleRPMFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_
     }
 }
 
+QList<uint32_t> VehicleRPMFactGroup::handledMessageIds() const
+{
+    return {
+        MAVLINK_MSG_ID_RAW_RPM,
+        MAVLINK_MSG_ID_RPM,
+    };
+}
+
 void VehicleRPMFactGroup::_handleRawRPM(const mavlink_message_t &message)
 {
     mavlink_raw_rpm_t raw_rpm{};
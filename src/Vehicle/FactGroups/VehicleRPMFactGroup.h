@@ -24,6 +24,7 @@ class VehicleRPMFactGroup : public FactGroup
 
     // Overrides from FactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 private:
     void _handleRawRPM(const mavlink_message_t &message);
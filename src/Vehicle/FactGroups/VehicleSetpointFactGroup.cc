@@ -6,6 +6,7 @@
 VehicleSetpointFactGroup::VehicleSetpointFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/SetpointFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_rollFact);
     _addFact(&_pitchFact);
     _addFact(&_yawFact);
@@ -48,3 +49,8 @@ void VehicleSetpointFactGroup::handleMessage(Vehicle *vehicle, const mavlink_mes
 
     _setTelemetryAvailable(true);
 }
+
+QList<uint32_t> VehicleSetpointFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_ATTITUDE_TARGET };
+}
@@ -4,6 +4,7 @@
 VehicleTemperatureFactGroup::VehicleTemperatureFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/TemperatureFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_temperature1Fact);
     _addFact(&_temperature2Fact);
     _addFact(&_temperature3Fact);
@@ -38,6 +39,17 @@ void VehicleTemperatureFactGroup::handleMessage(Vehicle *vehicle, const mavlink_
     }
 }
 
+QList<uint32_t> VehicleTemperatureFactGroup::handledMessageIds() const
+{
+    return {
+        MAVLINK_MSG_ID_SCALED_PRESSURE,
+        MAVLINK_MSG_ID_SCALED_PRESSURE2,
+        MAVLINK_MSG_ID_SCALED_PRESSURE3,
+        MAVLINK_MSG_ID_HIGH_LATENCY,
+        MAVLINK_MSG_ID_HIGH_LATENCY2,
+    };
+}
+
 void VehicleTemperatureFactGroup::_handleHighLatency(const mavlink_message_t &message)
 {
     mavlink_high_latency_t highLatency{};
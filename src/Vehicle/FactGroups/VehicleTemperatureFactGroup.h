@@ -18,6 +18,7 @@ class VehicleTemperatureFactGroup : public FactGroup
 
     // Overrides from FactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 private:
     void _handleScaledPressure(const mavlink_message_t &message);
@@ -4,6 +4,7 @@
 VehicleVibrationFactGroup::VehicleVibrationFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/VibrationFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_xAxisFact);
     _addFact(&_yAxisFact);
     _addFact(&_zAxisFact);
@@ -36,3 +37,8 @@ void VehicleVibrationFactGroup::handleMessage(Vehicle *vehicle, const mavlink_me
 
     _setTelemetryAvailable(true);
 }
+
+QList<uint32_t> VehicleVibrationFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_VIBRATION };
+}
@@ -24,6 +24,7 @@ class VehicleVibrationFactGroup : public FactGroup
 
     // Overrides from FactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 private:
     Fact _xAxisFact = Fact(0, QStringLiteral("xAxis"), FactMetaData::valueTypeDouble);
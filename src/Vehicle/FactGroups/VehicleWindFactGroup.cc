@@ -6,6 +6,7 @@
 VehicleWindFactGroup::VehicleWindFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/WindFact.json"), parent)
 {
+    _setCoalescedNotifications(true);
     _addFact(&_directionFact);
     _addFact(&_speedFact);
     _addFact(&_verticalSpeedFact);
@@ -39,6 +40,19 @@ void VehicleWindFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message
     }
 }
 
+QList<uint32_t> VehicleWindFactGroup::handledMessageIds() const
+{
+    QList<uint32_t> msgIds = {
+        MAVLINK_MSG_ID_WIND_COV,
+        MAVLINK_MSG_ID_HIGH_LATENCY,
+        MAVLINK_MSG_ID_HIGH_LATENCY2,
+    };
+#ifndef QGC_NO_ARDUPILOT_DIALECT
+    msgIds.append(MAVLINK_MSG_ID_WIND);
+#endif
+    return msgIds;
+}
+
 void VehicleWindFactGroup::_handleHighLatency(const mavlink_message_t &message)
 {
     mavlink_high_latency_t highLatency{};
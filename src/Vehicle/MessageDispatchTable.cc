@@ -0,0 +1,119 @@
+#include "MessageDispatchTable.h"
+
+#include <algorithm>
+#include <limits>
+
+void MessageDispatchTable::subscribe(const QList<uint32_t> &msgIds, Handler handler)
+{
+    if (msgIds.isEmpty()) {
+        return;
+    }
+
+    QList<uint32_t> sortedIds = msgIds;
+    std::sort(sortedIds.begin(), sortedIds.end());
+    sortedIds.erase(std::unique(sortedIds.begin(), sortedIds.end()), sortedIds.end());
+
+    _subscriptions.push_back({ std::move(handler), std::move(sortedIds) });
+    _dirty = true;
+}
+
+void MessageDispatchTable::subscribeAll(Handler handler)
+{
+    _subscriptions.push_back({ std::move(handler), {} });
+    _dirty = true;
+}
+
+void MessageDispatchTable::clear()
+{
+    _subscriptions.clear();
+    _offsets.clear();
+    _slots.clear();
+    _wildcardBegin = 0;
+    _dirty = false;
+}
+
+void MessageDispatchTable::dispatch(const mavlink_message_t &message)
+{
+    if (_dirty) {
+        _rebuild();
+    }
+
+    const uint32_t msgId = message.msgid;
+    uint32_t begin = _wildcardBegin;
+    uint32_t end = static_cast<uint32_t>(_slots.size());
+    if (msgId + 1 < _offsets.size()) {
+        begin = _offsets[msgId];
+        end = _offsets[msgId + 1];
+    }
+
+    for (uint32_t i = begin; i < end; i++) {
+        _subscriptions[_slots[i]].handler(message);
+    }
+}
+
+qsizetype MessageDispatchTable::handlerCount(uint32_t msgId)
+{
+    if (_dirty) {
+        _rebuild();
+    }
+
+    if (msgId + 1 < _offsets.size()) {
+        return _offsets[msgId + 1] - _offsets[msgId];
+    }
+    return static_cast<qsizetype>(_slots.size()) - _wildcardBegin;
+}
+
+void MessageDispatchTable::_rebuild()
+{
+    Q_ASSERT(_subscriptions.size() <= std::numeric_limits<uint16_t>::max());
+
+    uint32_t wildcardCount = 0;
+    uint32_t maxMsgId = 0;
+    bool haveIds = false;
+    for (const Subscription &subscription : _subscriptions) {
+        if (subscription.msgIds.isEmpty()) {
+            wildcardCount++;
+        } else {
+            maxMsgId = std::max(maxMsgId, subscription.msgIds.last());
+            haveIds = true;
+        }
+    }
+    const size_t tableSize = haveIds ? (static_cast<size_t>(maxMsgId) + 1) : 0;
+
+    // Counting pass, then prefix sum into offsets
+    _offsets.assign(tableSize + 1, wildcardCount);
+    _offsets[tableSize] = 0;
+    for (const Subscription &subscription : _subscriptions) {
+        for (const uint32_t msgId : subscription.msgIds) {
+            _offsets[msgId]++;
+        }
+    }
+    uint32_t total = 0;
+    for (uint32_t &offset : _offsets) {
+        const uint32_t count = offset;
+        offset = total;
+        total += count;
+    }
+    _wildcardBegin = total;
+
+    // Fill pass. Walking subscriptions in order keeps each msgid's handlers in subscription order.
+    _slots.assign(total + wildcardCount, 0);
+    std::vector<uint32_t> cursor(_offsets.begin(), _offsets.end() - 1);
+    uint32_t wildcardCursor = _wildcardBegin;
+    for (size_t index = 0; index < _subscriptions.size(); index++) {
+        const Subscription &subscription = _subscriptions[index];
+        const uint16_t slot = static_cast<uint16_t>(index);
+        if (subscription.msgIds.isEmpty()) {
+            for (uint32_t &next : cursor) {
+                _slots[next++] = slot;
+            }
+            _slots[wildcardCursor++] = slot;
+        } else {
+            for (const uint32_t msgId : subscription.msgIds) {
+                _slots[cursor[msgId]++] = slot;
+            }
+        }
+    }
+
+    _dirty = false;
+}
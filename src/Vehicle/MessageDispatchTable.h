@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include <QtCore/QList>
+
+#include "MAVLinkMessageType.h"
+
+/// \brief Flat msgid-indexed fan-out table for incoming MAVLink messages.
+///
+/// Consumers subscribe a handler to the message ids they care about, or to every message. dispatch() looks the
+/// msgid up in a compact per-id slot range so a high-rate stream only reaches its own handlers instead of every
+/// consumer running its own msgid switch. For any given msgid handlers run in subscription order, wildcard
+/// subscriptions included. The lookup table is rebuilt on the first dispatch after the subscriptions change.
+///
+/// Handlers may subscribe further handlers while being dispatched; those take effect from the next dispatch.
+/// clear() must not be called from a handler.
+class MessageDispatchTable
+{
+public:
+    using Handler = std::function<void(const mavlink_message_t &message)>;
+
+    /// Calls @p handler for every message whose id is in @p msgIds.
+    void subscribe(const QList<uint32_t> &msgIds, Handler handler);
+
+    /// Calls @p handler for every message.
+    void subscribeAll(Handler handler);
+
+    /// Removes all subscriptions.
+    void clear();
+
+    void dispatch(const mavlink_message_t &message);
+
+    /// @return Number of handlers dispatch() calls for @p msgId
+    qsizetype handlerCount(uint32_t msgId);
+
+private:
+    struct Subscription
+    {
+        Handler handler;
+        QList<uint32_t> msgIds;     ///< Sorted, unique. Empty: every message
+    };
+
+    void _rebuild();
+
+    std::deque<Subscription> _subscriptions;    ///< deque: references stay valid when a handler subscribes mid-dispatch
+    std::vector<uint32_t> _offsets;             ///< Slots for msgid N are _slots[_offsets[N].._offsets[N + 1]]
+    std::vector<uint16_t> _slots;               ///< Indices into _subscriptions
+    uint32_t _wildcardBegin = 0;                ///< Slots for msgids past the end of _offsets: wildcard subscriptions only
+    bool _dirty = false;
+};
@@ -369,6 +369,8 @@ void Vehicle::_commonInit(LinkInterface* link)
         }
     }
 
+    _setupMessageDispatch();
+
     _flightTimeUpdater.setInterval(1000);
     _flightTimeUpdater.setSingleShot(false);
     connect(&_flightTimeUpdater, &QTimer::timeout, this, &Vehicle::_updateFlightTime);
@@ -516,6 +518,63 @@ void Vehicle::resetCounters()
     _heardFrom          = false;
 }
 
+void Vehicle::_setupMessageDispatch()
+{
+    // Registration order is dispatch order for any given msgid
+    _messageDispatch.subscribe({ MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL }, [this](const mavlink_message_t& message) {
+        _ftpManager->_mavlinkMessageReceived(message);
+    });
+    _messageDispatch.subscribe({ MAVLINK_MSG_ID_PARAM_VALUE }, [this](const mavlink_message_t& message) {
+        _parameterManager->mavlinkMessageReceived(message);
+    });
+    _messageDispatch.subscribe({ MAVLINK_MSG_ID_DATA_TRANSMISSION_HANDSHAKE, MAVLINK_MSG_ID_ENCAPSULATED_DATA }, [this](const mavlink_message_t& message) {
+        (void) QMetaObject::invokeMethod(_imageProtocolManager, "mavlinkMessageReceived", Qt::AutoConnection, message);
+    });
+    _messageDispatch.subscribe({ MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS }, [this](const mavlink_message_t& message) {
+        _remoteIDManager->mavlinkMessageReceived(message);
+    });
+
+    // Any requested msgid can complete a request, and every inbound message doubles as a timeout tick
+    _messageDispatch.subscribeAll([this](const mavlink_message_t& message) {
+        _reqMsgCoord->handleReceivedMessage(message);
+    });
+
+    // Handle creation of dynamic fact group lists
+    _messageDispatch.subscribe(_batteryFactGroupListModel->handledMessageIds(), [this](const mavlink_message_t& message) {
+        _batteryFactGroupListModel->handleMessageForFactGroupCreation(this, message);
+    });
+    _messageDispatch.subscribe(_escStatusFactGroupListModel->handledMessageIds(), [this](const mavlink_message_t& message) {
+        _escStatusFactGroupListModel->handleMessageForFactGroupCreation(this, message);
+    });
+
+    // Battery, ESC and gimbal fact groups are added as telemetry arrives
+    connect(this, &FactGroup::factGroupNamesChanged, this, [this]() { _factGroupDispatchDirty = true; });
+}
+
+void Vehicle::_rebuildFactGroupDispatch()
+{
+    _factGroupDispatch.clear();
+
+    const auto subscribeGroup = [this](FactGroup* factGroup) {
+        const QList<uint32_t> msgIds = factGroup->handledMessageIds();
+        const auto handler = [this, factGroup](const mavlink_message_t& message) {
+            factGroup->handleMessage(this, message);
+        };
+        if (msgIds.contains(FactGroup::kAllMessageIds)) {
+            _factGroupDispatch.subscribeAll(handler);
+        } else {
+            _factGroupDispatch.subscribe(msgIds, handler);
+        }
+    };
+
+    for (FactGroup* factGroup : factGroups()) {
+        subscribeGroup(factGroup);
+    }
+    subscribeGroup(this);
+
+    _factGroupDispatchDirty = false;
+}
+
 void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t message)
 {
     if (message.sysid != _systemID && message.sysid != 0) {
@@ -567,23 +626,15 @@ void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t mes
     if (!_terrainProtocolHandler->mavlinkMessageReceived(message)) {
         return;
     }
-    _ftpManager->_mavlinkMessageReceived(message);
-    _parameterManager->mavlinkMessageReceived(message);
-    (void) QMetaObject::invokeMethod(_imageProtocolManager, "mavlinkMessageReceived", Qt::AutoConnection, message);
-    _remoteIDManager->mavlinkMessageReceived(message);
 
-    _reqMsgCoord->handleReceivedMessage(message);
+    // Subsystem managers, then dynamic fact group creation
+    _messageDispatch.dispatch(message);
 
-    // Handle creation of dynamic fact group lists
-    _batteryFactGroupListModel->handleMessageForFactGroupCreation(this, message);
-    _escStatusFactGroupListModel->handleMessageForFactGroupCreation(this, message);
-
-    // Let the fact groups take a whack at the mavlink traffic
-    for (FactGroup* factGroup : factGroups()) {
-        factGroup->handleMessage(this, message);
+    // Let the fact groups take a whack at the mavlink traffic. Groups created by the dispatch above see this message too.
+    if (_factGroupDispatchDirty) {
+        _rebuildFactGroupDispatch();
     }
-
-    this->handleMessage(this, message);
+    _factGroupDispatch.dispatch(message);
 
     switch (message.msgid) {
     case MAVLINK_MSG_ID_HOME_POSITION:
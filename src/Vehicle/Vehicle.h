@@ -17,6 +17,7 @@
 #include <array>
 #include <atomic>
 
+#include "MessageDispatchTable.h"
 #include "QGCMAVLink.h"
 #include "VehicleFactGroup.h"
 #include "VehicleSigningController.h"  // Q_PROPERTY needs the full QObject type for moc/QML metatype registration
@@ -79,6 +80,7 @@ class TerrainAtCoordinateQuery;
 class TerrainQueryCoordinator;
 class TerrainProtocolHandler;
 class TrajectoryPoints;
+class VehicleMessageDispatchTest;
 class VehicleObjectAvoidance;
 class VehicleSupports;
 
@@ -110,6 +112,7 @@ class Vehicle : public VehicleFactGroup, public VehicleTypes
     friend class SendMavCommandWithHandlerTest;     // Unit test
     friend class RequestMessageTest;                // Unit test
     friend class RetryableRequestMessageStateTest;  // Unit test
+    friend class VehicleMessageDispatchTest;        // Unit test
 #endif
     friend class GimbalController;                  // Allow GimbalController to call _addFactGroup
 
@@ -881,6 +884,8 @@ private slots:
     void _handleMavlinkLoggingDataAcked (mavlink_message_t& message);
     void _ackMavlinkLogData             (uint16_t sequence);
     void _commonInit                    (LinkInterface* link);
+    void _setupMessageDispatch          ();
+    void _rebuildFactGroupDispatch      ();
     void _setupAutoDisarmSignalling     ();
     void _setCapabilities               (uint64_t capabilityBits);
     void _updateArmed                   (bool armed);
@@ -1041,6 +1046,11 @@ private slots:
     MavCommandQueue*            _mavCmdQueue    = nullptr;
     RequestMessageCoordinator*  _reqMsgCoord    = nullptr;
 
+    // Incoming messages are routed by msgid so each one only reaches the handlers which declared interest in it
+    MessageDispatchTable        _messageDispatch;                   ///< Subsystem managers and FactGroupListModels
+    MessageDispatchTable        _factGroupDispatch;                 ///< factGroups() plus this, rebuilt when groups are added
+    bool                        _factGroupDispatchDirty = true;
+
 public:
     /// Ack timeout used in unit tests — kept on Vehicle for source-compat with
     /// existing tests (mirrors MavCommandQueue::kTestAckTimeoutMs).
@@ -1,6 +1,8 @@
 #include "APMDataFlashLogParserTest.h"
+#include "Benchmarking.h"
 
 #include "APMDataFlashLogParser.h"
+#include "APMDataFlashUtility.h"
 
 #include <QtCore/QFile>
 #include <QtCore/QRegularExpression>
@@ -53,6 +55,40 @@ QByteArray makeEventPayload(uint64_t timeUs, uint16_t eventId)
     return payload;
 }
 
+constexpr uint8_t kImuType = 153;
+
+QByteArray makeImuPayload(uint64_t timeUs, int i)
+{
+    // QffffffIIB = 8 + 6 * 4 + 2 * 4 + 1
+    QByteArray payload(41, '\0');
+    memcpy(payload.data(), &timeUs, sizeof(timeUs));
+    for (int axis = 0; axis < 6; ++axis) {
+        const float value = static_cast<float>((i % 100) * 0.01 + axis);
+        memcpy(payload.data() + 8 + (axis * 4), &value, sizeof(value));
+    }
+    const uint32_t errors = static_cast<uint32_t>(i % 3);
+    memcpy(payload.data() + 32, &errors, sizeof(errors));
+    memcpy(payload.data() + 36, &errors, sizeof(errors));
+    payload[40] = static_cast<char>(i % 2);
+    return payload;
+}
+
+/// A log shaped like ArduPilot's: a few parameters and modes among many high-rate sensor records
+QByteArray makeImuLog(int imuMessages)
+{
+    QByteArray bytes;
+    bytes.reserve(imuMessages * 44 + 1024);
+    appendMessage(bytes, 128, makeFmtPayload(150, 23, "PARM", "Nf", "Name,Value"));
+    appendMessage(bytes, 128, makeFmtPayload(151, 12, "MODE", "QB", "TimeUS,Mode"));
+    appendMessage(bytes, 128, makeFmtPayload(kImuType, 44, "IMU", "QffffffIIB", "TimeUS,GyrX,GyrY,GyrZ,AccX,AccY,AccZ,EG,EA,I"));
+    appendMessage(bytes, 150, makeParamPayload("LOG_BITMASK", 65535.0f));
+    appendMessage(bytes, 151, makeModePayload(1000ULL, 5));
+    for (int i = 0; i < imuMessages; ++i) {
+        appendMessage(bytes, kImuType, makeImuPayload(2500ULL * (i + 1), i));
+    }
+    return bytes;
+}
+
 } // namespace
 
 void APMDataFlashLogParserTest::_parseMinimalLogTest()
@@ -96,4 +132,90 @@ void APMDataFlashLogParserTest::_parseInvalidLogTest()
     QVERIFY(!parser.parseError().isEmpty());
 }
 
+void APMDataFlashLogParserTest::_parseSeriesTest()
+{
+    constexpr int kMessages = 500;
+    const QByteArray bytes = makeImuLog(kMessages);
+
+    QTemporaryFile tempFile;
+    QVERIFY(tempFile.open());
+    QVERIFY(tempFile.write(bytes) == bytes.size());
+    tempFile.close();
+
+    APMDataFlashLogParser parser;
+    QVERIFY(parser.parseFile(tempFile.fileName()));
+    QCOMPARE(parser.sampleCount(), kMessages + 2);
+    QVERIFY(parser.availableFields().contains(QStringLiteral("IMU.AccZ")));
+    QVERIFY(parser.availableFields().contains(QStringLiteral("PARM.Name")));
+    QVERIFY(!parser.plottableFields().contains(QStringLiteral("PARM.Name")));
+    QVERIFY(parser.plottableFields().contains(QStringLiteral("IMU.EA")));
+    QCOMPARE(parser.minTimestamp(), 0.001);
+    QCOMPARE(parser.maxTimestamp(), 0.0025 * kMessages);
+
+    // Each sample matches the value the generic message parser reads from the same record
+    APMDataFlashUtility::MessageFormat imu;
+    imu.name = QStringLiteral("IMU");
+    imu.format = QStringLiteral("QffffffIIB");
+    imu.columns = QStringLiteral("TimeUS,GyrX,GyrY,GyrZ,AccX,AccY,AccZ,EG,EA,I").split(QLatin1Char(','));
+    const QVariantList samples = parser.fieldSamples(QStringLiteral("IMU.AccY"));
+    QCOMPARE(samples.size(), kMessages);
+    for (const int i : {0, 1, 57, kMessages - 1}) {
+        const QByteArray payload = makeImuPayload(2500ULL * (i + 1), i);
+        QCOMPARE(samples.at(i).toPointF().y(),
+                 APMDataFlashUtility::parseMessage(payload.constData(), imu).value(QStringLiteral("AccY")).toDouble());
+    }
+}
+
+void APMDataFlashLogParserTest::_benchmarkParseThroughput()
+{
+    constexpr int kMessages = 50000;
+    const QByteArray bytes = makeImuLog(kMessages);
+
+    QTemporaryFile tempFile;
+    QVERIFY(tempFile.open());
+    QVERIFY(tempFile.write(bytes) == bytes.size());
+    tempFile.close();
+
+    QMap<uint8_t, APMDataFlashUtility::MessageFormat> formats;
+    QVERIFY(APMDataFlashUtility::parseFmtMessages(bytes.constData(), bytes.size(), formats));
+
+    auto bench = qgc::bench::ciConfig();
+    bench.epochs(5).warmup(1).minEpochIterations(1).relative(true).batch(kMessages).unit("message");
+
+    // What every record used to go through: a value map per message, then a name lookup per value
+    bench.run("parseMessage() value map", [&] {
+        QHash<QString, QVector<QPointF>> series;
+        APMDataFlashUtility::iterateMessages(bytes.constData(), bytes.size(), formats,
+            [&series](uint8_t, const char *payload, int, const APMDataFlashUtility::MessageFormat &fmt) {
+            const QMap<QString, QVariant> values = APMDataFlashUtility::parseMessage(payload, fmt);
+            const double timestamp = values.value(QStringLiteral("TimeUS")).toDouble() / 1000000.0;
+            for (auto it = values.cbegin(); it != values.cend(); ++it) {
+                series[fmt.name + QLatin1Char('.') + it.key()].append(QPointF(timestamp, it.value().toDouble()));
+            }
+            return true;
+        });
+        ankerl::nanobench::doNotOptimizeAway(series);
+    });
+
+    bench.run("SeriesDecoder compiled extractors", [&] {
+        APMDataFlashUtility::SeriesDecoder decoder(formats);
+        APMDataFlashUtility::iterateMessages(bytes.constData(), bytes.size(), formats,
+            [&decoder](uint8_t msgType, const char *payload, int, const APMDataFlashUtility::MessageFormat &) {
+            decoder.decode(msgType, payload, decoder.timestampSeconds(msgType, payload));
+            return true;
+        });
+        ankerl::nanobench::doNotOptimizeAway(decoder.takeSeries());
+    });
+
+    bench.run("APMDataFlashLogParser::parseFile()", [&] {
+        APMDataFlashLogParser parser;
+        const bool ok = parser.parseFile(tempFile.fileName());
+        ankerl::nanobench::doNotOptimizeAway(ok);
+    });
+
+    APMDataFlashLogParser parser;
+    QVERIFY(parser.parseFile(tempFile.fileName()));
+    QCOMPARE(parser.fieldSamples(QStringLiteral("IMU.GyrZ")).size(), kMessages);
+}
+
 UT_REGISTER_TEST(APMDataFlashLogParserTest, TestLabel::Unit, TestLabel::AnalyzeView)
@@ -9,4 +9,6 @@ class APMDataFlashLogParserTest : public UnitTest
 private slots:
     void _parseMinimalLogTest();
     void _parseInvalidLogTest();
+    void _parseSeriesTest();
+    void _benchmarkParseThroughput();
 };
@@ -1,11 +1,14 @@
 #include "LogFileParserTest.h"
+#include "Benchmarking.h"
 
 #include "LogFileParser.h"
 #include "LogViewerDataFlashParser.h"
 #include "LogViewerULogParser.h"
 
+#include <algorithm>
 #include <cstring>
 #include <functional>
+#include <limits>
 #include <vector>
 
 #include <QtCore/QByteArray>
@@ -124,6 +127,11 @@ void LogFileParserTest::_parseULogNumericTopicTest()
     QVERIFY(qAbs(samples[0].toPointF().y() - 0.1) < 1e-5);
     QVERIFY(qAbs(samples[1].toPointF().x() - 1.0) < 1e-5);
     QVERIFY(qAbs(samples[1].toPointF().y() - 0.2) < 1e-5);
+
+    // Two timestamps and two floats, at least
+    QVERIFY(parser.sampleMemoryBytes() >= 2 * static_cast<qint64>(sizeof(double) + sizeof(float)));
+    parser.clear();
+    QCOMPARE(parser.sampleMemoryBytes(), 0);
 }
 
 void LogFileParserTest::_parseULogParameterTest()
@@ -282,6 +290,130 @@ void LogFileParserTest::_parseULogInvalidFileTest()
     QVERIFY(!parser.parseError().isEmpty());
 }
 
+void LogFileParserTest::_parseULogFieldTypesTest()
+{
+    // Packed layout: timestamp@0 a@8 b@9 c@11 d@19 e@27 arr@28, 40 bytes
+    const auto makePayload = [](uint64_t ts, int8_t a, uint16_t b, int64_t c, double d, bool e) {
+        std::vector<uint8_t> buf(40, 0);
+        memcpy(buf.data(),      &ts, 8);
+        memcpy(buf.data() + 8,  &a,  1);
+        memcpy(buf.data() + 9,  &b,  2);
+        memcpy(buf.data() + 11, &c,  8);
+        memcpy(buf.data() + 19, &d,  8);
+        buf[27] = e ? 1 : 0;
+        return buf;
+    };
+
+    const QByteArray bytes = buildULog(
+        [](ulog_cpp::Writer &w) {
+            w.messageFormat(ulog_cpp::MessageFormat{
+                "mixed",
+                {ulog_cpp::Field{"uint64_t", "timestamp"},
+                 ulog_cpp::Field{"int8_t", "a"},
+                 ulog_cpp::Field{"uint16_t", "b"},
+                 ulog_cpp::Field{"int64_t", "c"},
+                 ulog_cpp::Field{"double", "d"},
+                 ulog_cpp::Field{"bool", "e"},
+                 ulog_cpp::Field{"float", "arr", 3}}
+            });
+        },
+        [&makePayload](ulog_cpp::Writer &w) {
+            w.addLoggedMessage(ulog_cpp::AddLoggedMessage{0, 1, "mixed"});
+            w.addLoggedMessage(ulog_cpp::AddLoggedMessage{1, 2, "mixed"});
+            w.data(ulog_cpp::Data{1, makePayload(1000000ULL, -5, 65000, -3000000000LL, 2.5, true)});
+            w.data(ulog_cpp::Data{2, makePayload(1500000ULL, 7, 3, 4, -1.25, false)});
+            w.data(ulog_cpp::Data{1, makePayload(2000000ULL, 6, 1, 2, 0.5, false)});
+        });
+
+    QTemporaryFile tmp;
+    tmp.setFileTemplate(QDir::tempPath() + QStringLiteral("/logtest_XXXXXX.ulg"));
+    QVERIFY(writeTempFile(tmp, bytes));
+
+    const LogParseResult result = ULogParser::parseFile(tmp.fileName());
+    QVERIFY(result.ok);
+    QCOMPARE(result.sampleCount, 3);
+
+    // Arrays are listed but never sampled
+    QVERIFY(result.availableFields.contains(QStringLiteral("mixed.arr")));
+    QVERIFY(!result.plottableFields.contains(QStringLiteral("mixed.arr")));
+    QCOMPARE(result.plottableFields.size(), 10);
+
+    const QVector<QPointF> a = result.samples.points(QStringLiteral("mixed.a"));
+    QCOMPARE(a.size(), 2);
+    QCOMPARE(a.at(0), QPointF(1.0, -5.0));
+    QCOMPARE(a.at(1), QPointF(2.0, 6.0));
+    QCOMPARE(result.samples.points(QStringLiteral("mixed.b")).first().y(), 65000.0);
+    QCOMPARE(result.samples.points(QStringLiteral("mixed.c")).first().y(), -3000000000.0);
+    QCOMPARE(result.samples.points(QStringLiteral("mixed.d")).first().y(), 2.5);
+    QCOMPARE(result.samples.points(QStringLiteral("mixed.e")).first().y(), 1.0);
+    // The fields of a topic instance share its timestamp column
+    QCOMPARE(result.samples.series(QStringLiteral("mixed.b")).times(), result.samples.series(QStringLiteral("mixed.a")).times());
+
+    // The second instance keeps its own series
+    const QVector<QPointF> d1 = result.samples.points(QStringLiteral("mixed[1].d"));
+    QCOMPARE(d1.size(), 1);
+    QCOMPARE(d1.first(), QPointF(1.5, -1.25));
+    QCOMPARE(result.minTimestamp, 1.0);
+    QCOMPARE(result.maxTimestamp, 2.0);
+}
+
+void LogFileParserTest::_benchmarkULogParse()
+{
+    // Stands in for a flight log: a sensor_combined-shaped topic at high rate plus a slower attitude topic
+    constexpr int kSensorMessages = 200000;
+    constexpr int kSensorSize = 8 + (12 * 4) + 2;
+    constexpr int kAttitudeSize = 8 + (4 * 4);
+
+    const QByteArray bytes = buildULog(
+        [](ulog_cpp::Writer &w) {
+            std::vector<ulog_cpp::Field> sensorFields{ulog_cpp::Field{"uint64_t", "timestamp"}};
+            for (int i = 0; i < 12; ++i) {
+                sensorFields.emplace_back("float", QStringLiteral("value%1").arg(i).toStdString().c_str());
+            }
+            sensorFields.emplace_back("uint8_t", "accel_clipping");
+            sensorFields.emplace_back("uint8_t", "gyro_clipping");
+            w.messageFormat(ulog_cpp::MessageFormat{"sensor_combined", sensorFields});
+            w.messageFormat(ulog_cpp::MessageFormat{
+                "vehicle_attitude",
+                {ulog_cpp::Field{"uint64_t", "timestamp"},
+                 ulog_cpp::Field{"float", "q", 4}}
+            });
+        },
+        [](ulog_cpp::Writer &w) {
+            w.addLoggedMessage(ulog_cpp::AddLoggedMessage{0, 1, "sensor_combined"});
+            w.addLoggedMessage(ulog_cpp::AddLoggedMessage{0, 2, "vehicle_attitude"});
+            std::vector<uint8_t> sensor(kSensorSize, 0);
+            std::vector<uint8_t> attitude(kAttitudeSize, 0);
+            for (int i = 0; i < kSensorMessages; ++i) {
+                const uint64_t ts = static_cast<uint64_t>(i) * 4000ULL;
+                memcpy(sensor.data(), &ts, 8);
+                for (int f = 0; f < 12; ++f) {
+                    const float value = static_cast<float>(i + f);
+                    memcpy(sensor.data() + 8 + (f * 4), &value, 4);
+                }
+                w.data(ulog_cpp::Data{1, sensor});
+                if ((i % 4) == 0) {
+                    memcpy(attitude.data(), &ts, 8);
+                    w.data(ulog_cpp::Data{2, attitude});
+                }
+            }
+        });
+
+    QTemporaryFile tmp;
+    tmp.setFileTemplate(QDir::tempPath() + QStringLiteral("/logtest_XXXXXX.ulg"));
+    QVERIFY(writeTempFile(tmp, bytes));
+
+    const LogParseResult check = ULogParser::parseFile(tmp.fileName());
+    QVERIFY(check.ok);
+    QCOMPARE(check.samples.points(QStringLiteral("sensor_combined.value0")).size(), kSensorMessages);
+
+    auto bench = qgc::bench::ciConfig();
+    bench.epochs(5).warmup(1).minEpochIterations(1).batch(bytes.size()).unit("byte");
+    bench.run("ULogParser::parseFile", [&] {
+        ankerl::nanobench::doNotOptimizeAway(ULogParser::parseFile(tmp.fileName()));
+    });
+}
+
 void LogFileParserTest::_parseDataFlashRegressionTest()
 {
     // Build a minimal DataFlash binary log to verify the .bin parse path
@@ -392,14 +524,14 @@ void LogFileParserTest::_fieldSamplesFilteredComprehensiveTest()
     // Each bucket has 4 distinct landmarks → exactly 40 output points.
     // -----------------------------------------------------------------------
     {
-        const QVariantList result = parser.fieldSamplesFiltered(
+        const QList<QPointF> result = parser.fieldSamplesFiltered(
             QStringLiteral("sens.val"), 0.0, 1.0, 10);
 
         QCOMPARE(result.size(), 40);
 
         int minCount = 0, maxCount = 0, firstCount = 0, lastCount = 0;
-        for (const QVariant &v : result) {
-            const double y = v.toPointF().y();
+        for (const QPointF &p : result) {
+            const double y = p.y();
             if (qAbs(y - (-9999.0)) < 0.01) ++minCount;
             if (qAbs(y - (+9999.0)) < 0.01) ++maxCount;
             if (y >= 1000.0 && y <= 1009.0)   ++firstCount;  // 1000+b, b=0..9
@@ -411,7 +543,7 @@ void LogFileParserTest::_fieldSamplesFilteredComprehensiveTest()
         QCOMPARE(lastCount,  10);
 
         for (int i = 1; i < result.size(); i++) {
-            QVERIFY(result[i].toPointF().x() >= result[i - 1].toPointF().x());
+            QVERIFY(result[i].x() >= result[i - 1].x());
         }
     }
 
@@ -419,7 +551,7 @@ void LogFileParserTest::_fieldSamplesFilteredComprehensiveTest()
     // Passthrough: pixelWidth=500 → threshold 4×500=2000 ≥ 500 → no filtering
     // -----------------------------------------------------------------------
     {
-        const QVariantList result = parser.fieldSamplesFiltered(
+        const QList<QPointF> result = parser.fieldSamplesFiltered(
             QStringLiteral("sens.val"), 0.0, 1.0, 500);
         QCOMPARE(result.size(), 500);
     }
@@ -430,15 +562,14 @@ void LogFileParserTest::_fieldSamplesFilteredComprehensiveTest()
     // Sub-buckets 0,2,4,6,8 contain the min; sub-buckets 1,3,5,7,9 the max.
     // -----------------------------------------------------------------------
     {
-        const QVariantList result = parser.fieldSamplesFiltered(
+        const QList<QPointF> result = parser.fieldSamplesFiltered(
             QStringLiteral("sens.val"), 0.0, 0.5, 10);
 
         QVERIFY(result.size() > 0);
         QVERIFY(result.size() <= 40);
 
         int minCount = 0, maxCount = 0;
-        for (const QVariant &v : result) {
-            const QPointF p = v.toPointF();
+        for (const QPointF &p : result) {
             QVERIFY(p.x() >= 0.0 && p.x() <= 0.5);
             if (qAbs(p.y() - (-9999.0)) < 0.01) ++minCount;
             if (qAbs(p.y() - (+9999.0)) < 0.01) ++maxCount;
@@ -447,7 +578,7 @@ void LogFileParserTest::_fieldSamplesFilteredComprehensiveTest()
         QCOMPARE(maxCount, 5);
 
         for (int i = 1; i < result.size(); i++) {
-            QVERIFY(result[i].toPointF().x() >= result[i - 1].toPointF().x());
+            QVERIFY(result[i].x() >= result[i - 1].x());
         }
     }
 
@@ -461,15 +592,14 @@ void LogFileParserTest::_fieldSamplesFilteredComprehensiveTest()
     //   offset 49 → col 9  (y = -1000.0  last of b=0)
     // -----------------------------------------------------------------------
     {
-        const QVariantList result = parser.fieldSamplesFiltered(
+        const QList<QPointF> result = parser.fieldSamplesFiltered(
             QStringLiteral("sens.val"), 0.0, 0.1, 10);
 
         QVERIFY(result.size() > 0);
         QVERIFY(result.size() <= 40);
 
         bool hasFirst = false, hasMin = false, hasMax = false, hasLast = false;
-        for (const QVariant &v : result) {
-            const QPointF p = v.toPointF();
+        for (const QPointF &p : result) {
             QVERIFY(p.x() >= 0.0 && p.x() <= 0.1);
             if (qAbs(p.y() -   1000.0) < 0.01) hasFirst = true;
             if (qAbs(p.y() - (-9999.0)) < 0.01) hasMin   = true;
@@ -482,7 +612,7 @@ void LogFileParserTest::_fieldSamplesFilteredComprehensiveTest()
         QVERIFY(hasLast);
 
         for (int i = 1; i < result.size(); i++) {
-            QVERIFY(result[i].toPointF().x() >= result[i - 1].toPointF().x());
+            QVERIFY(result[i].x() >= result[i - 1].x());
         }
     }
 
@@ -490,7 +620,7 @@ void LogFileParserTest::_fieldSamplesFilteredComprehensiveTest()
     // Out-of-range: no samples in [5.0, 6.0] → empty result
     // -----------------------------------------------------------------------
     {
-        const QVariantList result = parser.fieldSamplesFiltered(
+        const QList<QPointF> result = parser.fieldSamplesFiltered(
             QStringLiteral("sens.val"), 5.0, 6.0, 100);
         QCOMPARE(result.size(), 0);
     }
@@ -1028,4 +1158,180 @@ void LogFileParserTest::_clearDuringAsyncParseTest()
     QVERIFY(parser.availableFields().isEmpty());
 }
 
+// ============================================================================
+// Chunked parsing tests
+// ============================================================================
+
+namespace {
+
+// Everything a chunked parse must reproduce from a parse in one piece
+void verifySameResult(const LogParseResult &chunked, const LogParseResult &whole)
+{
+    QVERIFY(chunked.ok);
+    QCOMPARE(chunked.availableFields, whole.availableFields);
+    QCOMPARE(chunked.plottableFields, whole.plottableFields);
+    for (const QString &field : whole.plottableFields) {
+        QVERIFY2(chunked.samples.points(field) == whole.samples.points(field), qPrintable(field));
+    }
+    QCOMPARE(chunked.parameters, whole.parameters);
+    QCOMPARE(chunked.messages, whole.messages);
+    QCOMPARE(chunked.events, whole.events);
+    QCOMPARE(chunked.modeSegments, whole.modeSegments);
+    QCOMPARE(chunked.dropouts, whole.dropouts);
+    QCOMPARE(chunked.sampleCount, whole.sampleCount);
+    QCOMPARE(chunked.minTimestamp, whole.minTimestamp);
+    QCOMPARE(chunked.maxTimestamp, whole.maxTimestamp);
+    QCOMPARE(chunked.startTime, whole.startTime);
+    QCOMPARE(chunked.detectedVehicleType, whole.detectedVehicleType);
+}
+
+} // anonymous namespace
+
+void LogFileParserTest::_parseULogChunkedTest()
+{
+    constexpr int kSamples = 3000;
+    const QByteArray bytes = buildULog(
+        [](ulog_cpp::Writer &w) {
+            w.messageFormat(ulog_cpp::MessageFormat{
+                "sens",
+                {ulog_cpp::Field{"uint64_t", "timestamp"},
+                 ulog_cpp::Field{"float", "val"}}
+            });
+            w.messageFormat(ulog_cpp::MessageFormat{
+                "vehicle_status",
+                {ulog_cpp::Field{"uint64_t", "timestamp"},
+                 ulog_cpp::Field{"int32_t", "nav_state"}}
+            });
+            w.messageFormat(ulog_cpp::MessageFormat{
+                "sensor_gps",
+                {ulog_cpp::Field{"uint64_t", "timestamp"},
+                 ulog_cpp::Field{"uint64_t", "time_utc_usec"}}
+            });
+            w.parameter(ulog_cpp::Parameter{"MY_PARAM", 42.0f});
+        },
+        [](ulog_cpp::Writer &w) {
+            w.addLoggedMessage(ulog_cpp::AddLoggedMessage{0, 1, "sens"});
+            w.addLoggedMessage(ulog_cpp::AddLoggedMessage{1, 2, "sens"});
+            for (int i = 0; i < kSamples; ++i) {
+                const uint64_t ts = 1000000ULL + static_cast<uint64_t>(i) * 1000ULL;
+                w.data(ulog_cpp::Data{1, makePayload64Float(ts, static_cast<float>(i))});
+                if ((i % 2) == 0) {
+                    w.data(ulog_cpp::Data{2, makePayload64Float(ts, static_cast<float>(-i))});
+                }
+                // Subscribed part way through, so later chunks only know it from the scan
+                if (i == kSamples / 3) {
+                    w.addLoggedMessage(ulog_cpp::AddLoggedMessage{0, 3, "vehicle_status"});
+                    w.addLoggedMessage(ulog_cpp::AddLoggedMessage{0, 4, "sensor_gps"});
+                }
+                if ((i > kSamples / 3) && ((i % 400) == 0)) {
+                    w.data(ulog_cpp::Data{3, makePayload64Int32(ts, (i / 400) % 4)});
+                    w.data(ulog_cpp::Data{4, makePayloadUint64Uint64(ts, 1700000000000000ULL + ts)});
+                    w.logging(ulog_cpp::Logging{ulog_cpp::Logging::Level::Warning, "Warning", ts});
+                    w.dropout(ulog_cpp::Dropout{20});
+                }
+            }
+        });
+
+    QTemporaryFile tmp;
+    tmp.setFileTemplate(QDir::tempPath() + QStringLiteral("/logtest_XXXXXX.ulg"));
+    QVERIFY(writeTempFile(tmp, bytes));
+
+    const LogParseResult whole = ULogParser::parseFile(tmp.fileName(), nullptr, nullptr, std::numeric_limits<qint64>::max());
+    QVERIFY(whole.ok);
+    QCOMPARE(whole.samples.points(QStringLiteral("sens.val")).size(), kSamples);
+    QVERIFY(!whole.dropouts.isEmpty());
+    QVERIFY(whole.startTime.isValid());
+
+    // Chunks far smaller than the log, and chunks ending on every kind of message
+    for (const qint64 chunkSize : {1024, 1500, 4096}) {
+        QList<float> progressValues;
+        const LogParseResult chunked = ULogParser::parseFile(tmp.fileName(), [&progressValues](float v) {
+            progressValues.append(v);
+        }, nullptr, chunkSize);
+        verifySameResult(chunked, whole);
+        QVERIFY(!progressValues.isEmpty());
+        QCOMPARE(progressValues.last(), 1.f);
+        QVERIFY(std::is_sorted(progressValues.cbegin(), progressValues.cend()));
+    }
+}
+
+void LogFileParserTest::_parseDataFlashChunkedTest()
+{
+    QByteArray bytes;
+    appendBinMessage(bytes, 128, makeFmtPayloadStr(150, 15, "SENS", "Qf", "TimeUS,Val"));
+    appendBinMessage(bytes, 128, makeFmtPayloadStr(151, 12, "MODE", "QB", "TimeUS,Mode"));
+    appendBinMessage(bytes, 128, makeFmtPayloadStr(152, 75, "MSG", "QZ", "TimeUS,Message"));
+    appendBinMessage(bytes, 128, makeFmtPayloadStr(153, 17, "GPS", "QHI", "TimeUS,GWk,GMS"));
+    appendBinMessage(bytes, 128, makeFmtPayloadStr(154, 23, "PARM", "Nf", "Name,Value"));
+
+    const auto makeSens = [](uint64_t timeUs, float value) {
+        QByteArray payload(12, '\0');
+        memcpy(payload.data(), &timeUs, 8);
+        memcpy(payload.data() + 8, &value, 4);
+        return payload;
+    };
+    const auto makeMode = [](uint64_t timeUs, uint8_t mode) {
+        QByteArray payload(9, '\0');
+        memcpy(payload.data(), &timeUs, 8);
+        payload[8] = static_cast<char>(mode);
+        return payload;
+    };
+    const auto makeParam = [](const char *name, float value) {
+        QByteArray payload(20, '\0');
+        memcpy(payload.data(), name, strlen(name));
+        memcpy(payload.data() + 16, &value, 4);
+        return payload;
+    };
+
+    appendBinMessage(bytes, 154, makeParam("ARMING_CHECK", 1.0f));
+    QByteArray text(72, '\0');
+    memcpy(text.data() + 8, "ArduCopter V4.5.1", 17);
+    appendBinMessage(bytes, 152, text);
+
+    constexpr int kSamples = 4000;
+    for (int i = 0; i < kSamples; ++i) {
+        const uint64_t timeUs = 1000000ULL + static_cast<uint64_t>(i) * 2500ULL;
+        appendBinMessage(bytes, 150, makeSens(timeUs, static_cast<float>(i)));
+        if ((i % 500) == 0) {
+            appendBinMessage(bytes, 151, makeMode(timeUs, static_cast<uint8_t>((i / 500) % 3 == 0 ? 0 : 5)));
+        }
+        if (i == 1000) {
+            appendBinMessage(bytes, 153, makeGPSBinPayload(timeUs, 2300, 123456));
+        }
+        if (i == 1500) {
+            // Stray bytes the decoder has to resync over
+            bytes.append("\xA3\x00\x42", 3);
+        }
+        if (i == 2000) {
+            appendBinMessage(bytes, 154, makeParam("ARMING_CHECK", 0.0f));
+        }
+    }
+
+    QTemporaryFile tmp;
+    tmp.setFileTemplate(QDir::tempPath() + QStringLiteral("/logtest_XXXXXX.bin"));
+    QVERIFY(writeTempFile(tmp, bytes));
+
+    const LogParseResult whole = DataFlashParser::parseFile(tmp.fileName(), nullptr, nullptr, std::numeric_limits<qint64>::max());
+    QVERIFY(whole.ok);
+    QCOMPARE(whole.samples.points(QStringLiteral("SENS.Val")).size(), kSamples);
+    QCOMPARE(whole.parameters.size(), 2);
+    QVERIFY(whole.modeSegments.size() >= 2);
+    QVERIFY(whole.startTime.isValid());
+
+    for (const qint64 chunkSize : {1024, 1500, 4096}) {
+        QList<float> progressValues;
+        const LogParseResult chunked = DataFlashParser::parseFile(tmp.fileName(), [&progressValues](float v) {
+            progressValues.append(v);
+        }, nullptr, chunkSize);
+        verifySameResult(chunked, whole);
+        QVERIFY(!progressValues.isEmpty());
+        QCOMPARE(progressValues.last(), 1.f);
+        QVERIFY(std::is_sorted(progressValues.cbegin(), progressValues.cend()));
+    }
+
+    // A cancelled chunked parse reports failure rather than a partial result
+    const CancelToken cancelToken = std::make_shared<std::atomic<bool>>(true);
+    QVERIFY(!DataFlashParser::parseFile(tmp.fileName(), nullptr, cancelToken, 1024).ok);
+}
+
 UT_REGISTER_TEST(LogFileParserTest, TestLabel::Unit, TestLabel::AnalyzeView)
@@ -13,6 +13,8 @@ private slots:
     void _parseULogModeSegmentsTest();
     void _parseULogDropoutTest();
     void _parseULogInvalidFileTest();
+    void _parseULogFieldTypesTest();
+    void _benchmarkULogParse();
     void _parseDataFlashRegressionTest();
     void _parseUnsupportedExtensionTest();
     void _fieldSamplesFilteredComprehensiveTest();
@@ -28,4 +30,6 @@ private slots:
     void _parseProgressDataFlashTest();
     void _startParsingAsyncProgressTest();
     void _clearDuringAsyncParseTest();
+    void _parseULogChunkedTest();
+    void _parseDataFlashChunkedTest();
 };
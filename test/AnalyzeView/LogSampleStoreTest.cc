@@ -0,0 +1,246 @@
+#include "LogSampleStoreTest.h"
+
+#include "LogSampleStore.h"
+
+#include <QtCore/QRandomGenerator>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+void LogSampleStoreTest::_typedColumnsTest()
+{
+    using VT = LogSampleStore::ValueType;
+
+    LogSampleStore store;
+    const int group = store.addGroup(QStringLiteral("GPS"));
+    const int lat = store.addSeries(group, QStringLiteral("GPS.Lat"), VT::Int32, 1.0e7);
+    const int status = store.addSeries(group, QStringLiteral("GPS.Status"), VT::UInt8);
+    const int fix = store.addSeries(group, QStringLiteral("GPS.Fix"), VT::Bool);
+    const int big = store.addSeries(group, QStringLiteral("GPS.Big"), VT::Int64);
+
+    QCOMPARE(store.addGroup(QStringLiteral("GPS")), group);
+    QCOMPARE(store.addSeries(group, QStringLiteral("GPS.Lat"), VT::Int32, 1.0e7), lat);
+    QCOMPARE(store.seriesId(QStringLiteral("GPS.Status")), status);
+    QCOMPARE(store.seriesId(QStringLiteral("GPS.Missing")), -1);
+
+    for (int i = 0; i < 3; i++) {
+        const int32_t latValue = 473977420 + i;
+        const uint8_t statusValue = static_cast<uint8_t>(250 + i);
+        const uint8_t fixValue = static_cast<uint8_t>(i * 7);
+        const int64_t bigValue = -3000000000LL * i;
+        store.appendRow(group, 0.5 * i);
+        store.appendValue(lat, &latValue);
+        store.appendValue(status, &statusValue);
+        store.appendValue(fix, &fixValue);
+        store.appendValue(big, &bigValue);
+    }
+
+    const LogSampleStore::Series latSeries = store.series(lat);
+    QCOMPARE(latSeries.size(), 3);
+    QCOMPARE(latSeries.time(2), 1.0);
+    QCOMPARE(latSeries.value(2), 473977422 / 1.0e7);
+    QCOMPARE(store.series(QStringLiteral("GPS.Status")).value(2), 252.0);
+    QCOMPARE(store.series(fix).value(0), 0.0);
+    QCOMPARE(store.series(fix).value(1), 1.0);
+    QCOMPARE(store.series(big).value(1), -3000000000.0);
+    QCOMPARE(store.points(QStringLiteral("GPS.Status")), QVector<QPointF>({{0.0, 250.0}, {0.5, 251.0}, {1.0, 252.0}}));
+
+    // Every series of a group shares its timestamps
+    QCOMPARE(store.series(status).times(), latSeries.times());
+    QVERIFY(store.series(QStringLiteral("GPS.Missing")).isEmpty());
+
+    // A series added late reads 0 for the rows before it
+    const int late = store.addSeries(group, QStringLiteral("GPS.Late"), VT::Float);
+    const float lateValue = 1.5f;
+    store.appendRow(group, 1.5);
+    for (const int id : {lat, status, fix, big}) {
+        const int64_t zero = 0;
+        store.appendValue(id, &zero);
+    }
+    store.appendValue(late, &lateValue);
+    QCOMPARE(store.points(QStringLiteral("GPS.Late")), QVector<QPointF>({{0.0, 0.0}, {0.5, 0.0}, {1.0, 0.0}, {1.5, 1.5}}));
+
+    // A group without rows lists none of its series
+    const int empty = store.addGroup(QStringLiteral("EMPTY"));
+    (void) store.addSeries(empty, QStringLiteral("EMPTY.V"), VT::Double);
+    QStringList names = store.seriesNames();
+    names.sort();
+    QCOMPARE(names, QStringList({QStringLiteral("GPS.Big"), QStringLiteral("GPS.Fix"), QStringLiteral("GPS.Lat"),
+                                 QStringLiteral("GPS.Late"), QStringLiteral("GPS.Status")}));
+}
+
+void LogSampleStoreTest::_appendTest()
+{
+    using VT = LogSampleStore::ValueType;
+
+    const auto addRows = [](LogSampleStore &store, const QString &groupName, const QStringList &seriesNames, double firstTime, int rows) {
+        const int group = store.addGroup(groupName);
+        QList<int> ids;
+        for (const QString &name : seriesNames) {
+            ids.append(store.addSeries(group, name, VT::Int16, 100.0));
+        }
+        for (int i = 0; i < rows; i++) {
+            store.appendRow(group, firstTime + i);
+            for (const int id : std::as_const(ids)) {
+                const int16_t value = static_cast<int16_t>((firstTime + i) * 100);
+                store.appendValue(id, &value);
+            }
+        }
+    };
+
+    LogSampleStore merged;
+    LogSampleStore first;
+    addRows(first, QStringLiteral("A"), {QStringLiteral("A.x")}, 0.0, 2);
+    merged.append(first);
+    QVERIFY(first.isEmpty());
+    QCOMPARE(merged.points(QStringLiteral("A.x")), QVector<QPointF>({{0.0, 0.0}, {1.0, 1.0}}));
+
+    // A later chunk brings a new series into an existing group and a new group
+    LogSampleStore second;
+    addRows(second, QStringLiteral("A"), {QStringLiteral("A.x"), QStringLiteral("A.y")}, 2.0, 2);
+    addRows(second, QStringLiteral("B"), {QStringLiteral("B.z")}, 10.0, 1);
+    merged.append(second);
+    QVERIFY(second.isEmpty());
+
+    QCOMPARE(merged.points(QStringLiteral("A.x")), QVector<QPointF>({{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}, {3.0, 3.0}}));
+    QCOMPARE(merged.points(QStringLiteral("A.y")), QVector<QPointF>({{0.0, 0.0}, {1.0, 0.0}, {2.0, 2.0}, {3.0, 3.0}}));
+    QCOMPARE(merged.points(QStringLiteral("B.z")), QVector<QPointF>({{10.0, 10.0}}));
+
+    // A chunk missing a series pads it
+    LogSampleStore third;
+    addRows(third, QStringLiteral("A"), {QStringLiteral("A.y")}, 4.0, 1);
+    merged.append(third);
+    QCOMPARE(merged.series(QStringLiteral("A.x")).size(), 5);
+    QCOMPARE(merged.series(QStringLiteral("A.x")).value(4), 0.0);
+    QCOMPARE(merged.series(QStringLiteral("A.y")).value(4), 4.0);
+}
+
+void LogSampleStoreTest::_memoryUsageTest()
+{
+    constexpr int kRows = 1000;
+
+    LogSampleStore store;
+    QCOMPARE(store.memoryUsage(), 0);
+
+    const int group = store.addGroup(QStringLiteral("IMU"));
+    const int gyro = store.addSeries(group, QStringLiteral("IMU.GyrX"), LogSampleStore::ValueType::Float);
+    const int temp = store.addSeries(group, QStringLiteral("IMU.T"), LogSampleStore::ValueType::Int16);
+    for (int i = 0; i < kRows; i++) {
+        const float gyroValue = 0.01f * i;
+        const int16_t tempValue = 40;
+        store.appendRow(group, i * 0.001);
+        store.appendValue(gyro, &gyroValue);
+        store.appendValue(temp, &tempValue);
+    }
+    store.squeeze();
+
+    // One shared timestamp plus each value at its logged width, against 2 * 16 bytes as QPointF series
+    const qint64 expected = kRows * static_cast<qint64>(sizeof(double) + sizeof(float) + sizeof(int16_t));
+    QVERIFY2(store.memoryUsage() >= expected, qPrintable(QString::number(store.memoryUsage())));
+    QVERIFY2(store.memoryUsage() < expected + 64, qPrintable(QString::number(store.memoryUsage())));
+    QVERIFY(store.memoryUsage() < 2 * kRows * static_cast<qint64>(sizeof(QPointF)));
+
+    store.clear();
+    QVERIFY(store.isEmpty());
+    QCOMPARE(store.memoryUsage(), 0);
+}
+
+void LogSampleStoreTest::_pyramidMinMaxTest()
+{
+    constexpr int kRows = 1000;
+
+    // Few distinct values, so most ranges hold several equal extremes
+    LogSampleStore store;
+    const int group = store.addGroup(QStringLiteral("S"));
+    const int id = store.addSeries(group, QStringLiteral("S.v"), LogSampleStore::ValueType::Int16);
+    QRandomGenerator random(1234);
+    for (int i = 0; i < kRows; i++) {
+        const int16_t value = static_cast<int16_t>(random.bounded(10));
+        store.appendRow(group, i);
+        store.appendValue(id, &value);
+    }
+
+    const LogSampleStore::Series series = store.series(id);
+    const LogSamplePyramid pyramid(series);
+    QVERIFY(pyramid.memoryUsage() > 0);
+
+    for (int trial = 0; trial < 2000; trial++) {
+        const qsizetype begin = random.bounded(kRows);
+        const qsizetype end = begin + 1 + random.bounded(kRows - static_cast<int>(begin));
+
+        qsizetype expectedMin = begin;
+        qsizetype expectedMax = begin;
+        for (qsizetype i = begin + 1; i < end; i++) {
+            if (series.value(i) < series.value(expectedMin)) { expectedMin = i; }
+            if (series.value(i) > series.value(expectedMax)) { expectedMax = i; }
+        }
+
+        qsizetype minIndex = -1;
+        qsizetype maxIndex = -1;
+        pyramid.minMax(begin, end, minIndex, maxIndex);
+        QCOMPARE(minIndex, expectedMin);
+        QCOMPARE(maxIndex, expectedMax);
+    }
+
+    // An empty series has no levels
+    const LogSamplePyramid small(store.series(QStringLiteral("S.missing")));
+    QCOMPARE(small.memoryUsage(), 0);
+}
+
+void LogSampleStoreTest::_pyramidNaNTest()
+{
+    constexpr int kRows = 1000;
+    constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+    // NaN opens the series and every 8-sample block, and fills whole blocks in places
+    LogSampleStore store;
+    const int group = store.addGroup(QStringLiteral("S"));
+    const int id = store.addSeries(group, QStringLiteral("S.v"), LogSampleStore::ValueType::Double);
+    QRandomGenerator random(4321);
+    for (int i = 0; i < kRows; i++) {
+        const bool gap = ((i % 8) == 0) || ((i >= 64) && (i < 128)) || (random.bounded(4) == 0);
+        const double value = gap ? kNaN : static_cast<double>(random.bounded(10));
+        store.appendRow(group, i);
+        store.appendValue(id, &value);
+    }
+
+    const LogSampleStore::Series series = store.series(id);
+    const LogSamplePyramid pyramid(series);
+
+    const auto check = [&](qsizetype begin, qsizetype end) {
+        qsizetype expectedMin = begin;
+        qsizetype expectedMax = begin;
+        for (qsizetype i = begin + 1; i < end; i++) {
+            const double value = series.value(i);
+            if (std::isnan(value)) {
+                continue;
+            }
+            if (std::isnan(series.value(expectedMin)) || (value < series.value(expectedMin))) { expectedMin = i; }
+            if (std::isnan(series.value(expectedMax)) || (value > series.value(expectedMax))) { expectedMax = i; }
+        }
+
+        qsizetype minIndex = -1;
+        qsizetype maxIndex = -1;
+        pyramid.minMax(begin, end, minIndex, maxIndex);
+        QCOMPARE(minIndex, expectedMin);
+        QCOMPARE(maxIndex, expectedMax);
+    };
+
+    check(0, kRows);
+    check(64, 128);
+    check(56, 136);
+    for (int trial = 0; trial < 2000; trial++) {
+        const qsizetype begin = random.bounded(kRows);
+        check(begin, begin + 1 + random.bounded(kRows - static_cast<int>(begin)));
+    }
+
+    // Numbers exist in the whole series, so neither extreme may be NaN
+    qsizetype minIndex = -1;
+    qsizetype maxIndex = -1;
+    pyramid.minMax(0, kRows, minIndex, maxIndex);
+    QVERIFY(!std::isnan(series.value(minIndex)));
+    QVERIFY(!std::isnan(series.value(maxIndex)));
+}
+
+UT_REGISTER_TEST(LogSampleStoreTest, TestLabel::Unit, TestLabel::AnalyzeView)
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class LogSampleStoreTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _typedColumnsTest();
+    void _appendTest();
+    void _memoryUsageTest();
+    void _pyramidMinMaxTest();
+    void _pyramidNaNTest();
+};
@@ -77,6 +77,64 @@ void LinkConfigurationTest::_testBaseSetHighLatencyEmitsSignal()
     QCOMPARE(spy.count(), 2);
 }
 
+void LinkConfigurationTest::_testBaseSetForwardingEmitsSignal()
+{
+    TCPConfiguration config(QStringLiteral("ForwardTest"));
+    QSignalSpy spy(&config, &LinkConfiguration::forwardingChanged);
+
+    config.setForwarding(true);
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(config.isForwarding());
+
+    config.setForwarding(true);
+    QCOMPARE(spy.count(), 1);
+
+    config.setForwarding(false);
+    QCOMPARE(spy.count(), 2);
+}
+
+void LinkConfigurationTest::_testBaseRouteFilterProperties()
+{
+    TCPConfiguration config(QStringLiteral("RouteTest"));
+    QSignalSpy spy(&config, &LinkConfiguration::routeFilterChanged);
+
+    config.setRouteAllowSysIds(QStringLiteral(" 1, 2,,1"));
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(config.routeFilter().allowSysIds, QList<uint8_t>({1, 2}));
+    QCOMPARE(config.routeAllowSysIds(), QStringLiteral("1,2"));
+
+    // Same ids must not re-emit
+    config.setRouteAllowSysIds(QStringLiteral("1,2"));
+    QCOMPARE(spy.count(), 1);
+
+    expectLogMessage("Comms.MAVLinkRouteFilter", QtWarningMsg, QRegularExpression("Ignoring invalid id"));
+    config.setRouteDenyCompIds(QStringLiteral("190,256"));
+    QCOMPARE(config.routeFilter().denyCompIds, QList<uint8_t>({190}));
+
+    config.setRouteAllowMsgIds(QStringLiteral("0,33,12915"));
+    QCOMPARE(config.routeFilter().allowMsgIds, QList<uint32_t>({0, 33, 12915}));
+
+    config.setRouteMaxRateHz(-5.0);
+    QCOMPARE(config.routeMaxRateHz(), 0.0);
+    config.setRouteMaxRateHz(10.0);
+    QCOMPARE(config.routeFilter().maxRateHz, 10.0);
+
+    config.setRouteSigning(static_cast<int>(MAVLinkRouteFilter::SigningPolicy::SignedOnly));
+    QVERIFY(config.routeFilter().signing == MAVLinkRouteFilter::SigningPolicy::SignedOnly);
+
+    const int emitted = spy.count();
+    expectLogMessage("Comms.LinkConfiguration", QtWarningMsg, QRegularExpression("Invalid signing policy"));
+    config.setRouteSigning(7);
+    QCOMPARE(spy.count(), emitted);
+    QVERIFY(config.routeFilter().signing == MAVLinkRouteFilter::SigningPolicy::SignedOnly);
+
+    // The copy made for editing carries the filter back through copyFrom
+    TCPConfiguration edited(&config);
+    edited.setRouteDenySysIds(QStringLiteral("255"));
+    config.copyFrom(&edited);
+    QCOMPARE(config.routeFilter(), edited.routeFilter());
+}
+
 void LinkConfigurationTest::_testBaseDefaults()
 {
     TCPConfiguration config(QStringLiteral("DefaultsTest"));
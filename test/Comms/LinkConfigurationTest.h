@@ -12,6 +12,8 @@ private slots:
     void _testBaseSetDynamicEmitsSignal();
     void _testBaseSetAutoConnectEmitsSignal();
     void _testBaseSetHighLatencyEmitsSignal();
+    void _testBaseSetForwardingEmitsSignal();
+    void _testBaseRouteFilterProperties();
     void _testBaseDefaults();
     void _testBaseSettingsRoot();
     void _testSuppressAutoReconnectNotPersisted();
@@ -0,0 +1,167 @@
+#include "LogReplayLinkTest.h"
+
+#include "LinkManager.h"
+#include "LogReplayLink.h"
+#include "MAVLinkLib.h"
+#include "MultiVehicleManager.h"
+#include "Vehicle.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QSettings>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+namespace {
+
+constexpr quint64 kStartUSecs = 1700000000000000ULL;
+constexpr quint64 kStepUSecs = 10000;
+
+}  // namespace
+
+bool LogReplayLinkTest::_writeTlog(const QString &fileName, uint32_t recordCount, bool withHeartbeats)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QByteArray log;
+    for (uint32_t i = 0; i < recordCount; ++i) {
+        uchar timestamp[sizeof(quint64)];
+        qToBigEndian(kStartUSecs + (i * kStepUSecs), timestamp);
+        (void) log.append(reinterpret_cast<const char*>(timestamp), sizeof(timestamp));
+
+        mavlink_message_t message{};
+        if (withHeartbeats && ((i % 100) == 0)) {
+            (void) mavlink_msg_heartbeat_pack(1, MAV_COMP_ID_AUTOPILOT1, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, 0, MAV_STATE_STANDBY);
+        } else {
+            (void) mavlink_msg_attitude_pack(1, MAV_COMP_ID_AUTOPILOT1, &message, i, 0.1f, 0.2f, 0.3f, 0, 0, 0);
+        }
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const uint16_t length = mavlink_msg_to_send_buffer(buffer, &message);
+        (void) log.append(reinterpret_cast<const char*>(buffer), length);
+    }
+
+    return file.write(log) == log.size();
+}
+
+LogReplayLink *LogReplayLinkTest::_startUnpacedReplay(const QString &fileName, uint32_t maxMessagesPerSecond, SharedLinkConfigurationPtr &config)
+{
+    LogReplayConfiguration *const replayConfig = new LogReplayConfiguration(QStringLiteral("LogReplayLinkTest"));
+    replayConfig->setLogFilename(fileName);
+    replayConfig->setDynamic(true);
+    replayConfig->setUnpaced(true);
+    replayConfig->setMaxMessagesPerSecond(maxMessagesPerSecond);
+    config = linkManager()->addConfiguration(replayConfig);
+    if (!linkManager()->createConnectedLink(config)) {
+        return nullptr;
+    }
+    return qobject_cast<LogReplayLink*>(config->link());
+}
+
+void LogReplayLinkTest::_stopReplay(SharedLinkConfigurationPtr &config)
+{
+    if (config->link()) {
+        linkManager()->disconnectLink(config->link());
+        QTRY_VERIFY_WITH_TIMEOUT(config->link() == nullptr, TestTimeout::mediumMs());
+    }
+    QVERIFY(waitForAllVehiclesDisconnect());
+    linkManager()->removeConfiguration(config.get());
+}
+
+void LogReplayLinkTest::_testUnpacedReplayThroughVehicle()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("unpaced.tlog"));
+
+    // 100 seconds of log time; paced replay would take that long
+    constexpr uint32_t kRecords = 10000;
+    QVERIFY(_writeTlog(fileName, kRecords, true));
+
+    SharedLinkConfigurationPtr config;
+    LogReplayLink *const link = _startUnpacedReplay(fileName, 0, config);
+    QVERIFY(link);
+    QSignalSpy finishedSpy(link, &LogReplayLink::unpacedPlaybackFinished);
+    QVERIFY(finishedSpy.isValid());
+
+    QVERIFY(finishedSpy.wait(TestTimeout::longMs()));
+    const LogReplayStats stats = finishedSpy.first().at(0).value<LogReplayStats>();
+
+    QCOMPARE(stats.framesRead, quint64(kRecords));
+    QCOMPARE(stats.messagesDecoded, quint64(kRecords));
+    QVERIFY(stats.bytesRead > 0);
+    QVERIFY(stats.wallNs > 0);
+    QVERIFY(stats.readNs > 0);
+    QVERIFY(stats.decodeNs > 0);
+    QVERIFY(stats.dispatchNs > 0);
+    QVERIFY(stats.wallNs < (static_cast<qint64>(kRecords * kStepUSecs) * 1000));
+
+    // The replayed heartbeats brought up a vehicle, so dispatch went through Vehicle and its fact groups
+    Vehicle *const vehicle = MultiVehicleManager::instance()->activeVehicle();
+    QVERIFY(vehicle);
+    QCOMPARE(vehicle->id(), 1);
+
+    _stopReplay(config);
+}
+
+void LogReplayLinkTest::_testUnpacedReplayRateCap()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("capped.tlog"));
+
+    constexpr uint32_t kRecords = 600;
+    constexpr uint32_t kMaxMessagesPerSecond = 2000;
+    QVERIFY(_writeTlog(fileName, kRecords, false));
+
+    SharedLinkConfigurationPtr config;
+    LogReplayLink *const link = _startUnpacedReplay(fileName, kMaxMessagesPerSecond, config);
+    QVERIFY(link);
+    QSignalSpy finishedSpy(link, &LogReplayLink::unpacedPlaybackFinished);
+    QVERIFY(finishedSpy.isValid());
+
+    QVERIFY(finishedSpy.wait(TestTimeout::longMs()));
+    const LogReplayStats stats = finishedSpy.first().at(0).value<LogReplayStats>();
+
+    QCOMPARE(stats.framesRead, quint64(kRecords));
+    // 600 messages at 2000/s cannot finish in much under 300 ms
+    QVERIFY2(stats.wallNs >= 250'000'000, qPrintable(QString::number(stats.wallNs)));
+    QVERIFY(stats.messagesPerSecond() <= (kMaxMessagesPerSecond * 1.2));
+
+    _stopReplay(config);
+}
+
+void LogReplayLinkTest::_testUnpacedSettingsRoundtrip()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QSettings settings(tempDir.filePath(QStringLiteral("settings.ini")), QSettings::IniFormat);
+    const QString root = QStringLiteral("LogReplayTest");
+
+    {
+        LogReplayConfiguration config(QStringLiteral("ReplaySave"));
+        QSignalSpy unpacedSpy(&config, &LogReplayConfiguration::unpacedChanged);
+        QSignalSpy rateSpy(&config, &LogReplayConfiguration::maxMessagesPerSecondChanged);
+        config.setLogFilename(QStringLiteral("/tmp/flight.tlog"));
+        config.setUnpaced(true);
+        config.setUnpaced(true);
+        config.setMaxMessagesPerSecond(5000);
+        QCOMPARE(unpacedSpy.count(), 1);
+        QCOMPARE(rateSpy.count(), 1);
+        config.saveSettings(settings, root);
+    }
+
+    LogReplayConfiguration config(QStringLiteral("ReplayLoad"));
+    config.loadSettings(settings, root);
+    QVERIFY(config.unpaced());
+    QCOMPARE(config.maxMessagesPerSecond(), uint32_t(5000));
+
+    LogReplayConfiguration edited(&config);
+    QVERIFY(edited.unpaced());
+    QCOMPARE(edited.maxMessagesPerSecond(), uint32_t(5000));
+}
+
+UT_REGISTER_TEST(LogReplayLinkTest, TestLabel::Integration, TestLabel::Comms)
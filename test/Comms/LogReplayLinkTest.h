@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CommsTest.h"
+
+class LogReplayConfiguration;
+class LogReplayLink;
+
+/// Tests for unpaced LogReplayLink playback through the full receive path.
+class LogReplayLinkTest : public CommsTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testUnpacedReplayThroughVehicle();
+    void _testUnpacedReplayRateCap();
+    void _testUnpacedSettingsRoundtrip();
+
+private:
+    /// Writes @p recordCount tlog records; one HEARTBEAT every 100 when @p withHeartbeats, otherwise ATTITUDE only.
+    static bool _writeTlog(const QString &fileName, uint32_t recordCount, bool withHeartbeats);
+    LogReplayLink *_startUnpacedReplay(const QString &fileName, uint32_t maxMessagesPerSecond, SharedLinkConfigurationPtr &config);
+    void _stopReplay(SharedLinkConfigurationPtr &config);
+};
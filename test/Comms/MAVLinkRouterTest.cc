@@ -0,0 +1,244 @@
+#include "MAVLinkRouterTest.h"
+#include "Benchmarking.h"
+#include "MAVLinkLib.h"
+#include "MAVLinkRouter.h"
+#include "MAVLinkSigning.h"
+
+#include "Fixtures/RAIIFixtures.h"
+
+#include <QtCore/QSettings>
+#include <QtTest/QTest>
+
+namespace {
+
+mavlink_message_t heartbeat(uint8_t sysId, uint8_t compId = MAV_COMP_ID_AUTOPILOT1)
+{
+    mavlink_heartbeat_t heartbeat{};
+    heartbeat.type = MAV_TYPE_QUADROTOR;
+    heartbeat.autopilot = MAV_AUTOPILOT_PX4;
+    mavlink_message_t message;
+    (void) mavlink_msg_heartbeat_encode(sysId, compId, &message, &heartbeat);
+    return message;
+}
+
+/// Routing only looks at the header, so any msgid can be exercised with a heartbeat body
+mavlink_message_t withMsgId(mavlink_message_t message, uint32_t msgId)
+{
+    message.msgid = msgId;
+    return message;
+}
+
+MAVLinkRouter::Endpoint endpoint(const MAVLinkRouteFilter &filter)
+{
+    return MAVLinkRouter::Endpoint{WeakLinkInterfacePtr(), filter};
+}
+
+constexpr quint64 bit(int index)
+{
+    return 1ULL << index;
+}
+
+constexpr qint64 kMsecNs = 1000 * 1000;
+
+}  // namespace
+
+void MAVLinkRouterTest::_testRouteMasks()
+{
+    MAVLinkRouteFilter all;
+
+    MAVLinkRouteFilter vehicleOne;
+    vehicleOne.allowSysIds = {1};
+    vehicleOne.denyMsgIds = {MAVLINK_MSG_ID_ATTITUDE};
+
+    MAVLinkRouteFilter heartbeatsAndExtended;
+    heartbeatsAndExtended.allowMsgIds = {MAVLINK_MSG_ID_HEARTBEAT, 50001};
+
+    MAVLinkRouteFilter noGimbal;
+    noGimbal.denyCompIds = {MAV_COMP_ID_GIMBAL};
+
+    const MAVLinkRouter router({endpoint(all), endpoint(vehicleOne), endpoint(heartbeatsAndExtended), endpoint(noGimbal)});
+    QCOMPARE(router.endpointCount(), 4);
+
+    QCOMPARE(router.route(heartbeat(1)), bit(0) | bit(1) | bit(2) | bit(3));
+    QCOMPARE(router.route(heartbeat(2)), bit(0) | bit(2) | bit(3));
+    QCOMPARE(router.route(heartbeat(1, MAV_COMP_ID_GIMBAL)), bit(0) | bit(1) | bit(2));
+    QCOMPARE(router.route(withMsgId(heartbeat(1), MAVLINK_MSG_ID_ATTITUDE)), bit(0) | bit(3));
+
+    // Listed and unlisted ids past the dense table
+    QCOMPARE(router.route(withMsgId(heartbeat(1), 50001)), bit(0) | bit(1) | bit(2) | bit(3));
+    QCOMPARE(router.route(withMsgId(heartbeat(1), 50002)), bit(0) | bit(1) | bit(3));
+
+    // Never forwarded, even to an endpoint that asks for it
+    MAVLinkRouteFilter wantsSetupSigning;
+    wantsSetupSigning.allowMsgIds = {MAVLINK_MSG_ID_SETUP_SIGNING};
+    const MAVLinkRouter setupSigningRouter({endpoint(all), endpoint(wantsSetupSigning)});
+    QCOMPARE(setupSigningRouter.route(withMsgId(heartbeat(1), MAVLINK_MSG_ID_SETUP_SIGNING)), quint64(0));
+}
+
+void MAVLinkRouterTest::_testSigningPolicy()
+{
+    MAVLinkRouteFilter strip;
+    MAVLinkRouteFilter preserve;
+    preserve.signing = MAVLinkRouteFilter::SigningPolicy::Preserve;
+    MAVLinkRouteFilter signedOnly;
+    signedOnly.signing = MAVLinkRouteFilter::SigningPolicy::SignedOnly;
+
+    MAVLinkRouteBatch batch;
+    batch.setRouter(std::make_shared<const MAVLinkRouter>(
+        QList<MAVLinkRouter::Endpoint>{endpoint(strip), endpoint(preserve), endpoint(signedOnly)}));
+    QVERIFY(batch.isActive());
+
+    const mavlink_message_t unsignedMessage = heartbeat(1);
+    batch.route(unsignedMessage, 0);
+    QVERIFY(!batch.pending(0).isEmpty());
+    QCOMPARE(batch.pending(1).size(), batch.pending(0).size());
+    QVERIFY(batch.pending(2).isEmpty());
+    const qsizetype unsignedLength = batch.pending(0).size();
+
+    mavlink_message_t signedMessage = heartbeat(1);
+    MAVLinkSigning::setMessageSigned(signedMessage, true);
+    batch.route(signedMessage, 0);
+    QCOMPARE(batch.pending(0).size(), 2 * unsignedLength);
+    QCOMPARE(batch.pending(1).size(), 2 * unsignedLength + MAVLINK_SIGNATURE_BLOCK_LEN);
+    QCOMPARE(batch.pending(2).size(), unsignedLength + MAVLINK_SIGNATURE_BLOCK_LEN);
+
+    // The stripped copy parses as an ordinary unsigned frame
+    mavlink_message_t buffer{};
+    mavlink_status_t bufferStatus{};
+    mavlink_message_t parsed{};
+    mavlink_status_t status{};
+    int parsedCount = 0;
+    for (const char byte : batch.pending(0)) {
+        if (mavlink_frame_char_buffer(&buffer, &bufferStatus, static_cast<uint8_t>(byte), &parsed, &status) ==
+            MAVLINK_FRAMING_OK) {
+            QVERIFY(!MAVLinkSigning::isMessageSigned(parsed));
+            ++parsedCount;
+        }
+    }
+    QCOMPARE(parsedCount, 2);
+
+    // No link behind the endpoints: flush just drops the output
+    batch.flush();
+    QVERIFY(batch.pending(0).isEmpty());
+    QVERIFY(batch.pending(1).isEmpty());
+}
+
+void MAVLinkRouterTest::_testRateLimit()
+{
+    MAVLinkRouteFilter unlimited;
+    MAVLinkRouteFilter tenHz;
+    tenHz.maxRateHz = 10.0;
+
+    MAVLinkRouteBatch batch;
+    batch.setRouter(std::make_shared<const MAVLinkRouter>(QList<MAVLinkRouter::Endpoint>{endpoint(unlimited), endpoint(tenHz)}));
+
+    const mavlink_message_t vehicleOne = heartbeat(1);
+    const mavlink_message_t vehicleTwo = heartbeat(2);
+    const qsizetype frameLength = [&] {
+        batch.route(vehicleOne, 0);
+        return batch.pending(0).size();
+    }();
+
+    // Each (sysid, compid, msgid) stream is limited on its own
+    batch.route(vehicleTwo, 0);
+    batch.route(vehicleOne, 50 * kMsecNs);
+    batch.route(vehicleOne, 99 * kMsecNs);
+    batch.route(vehicleOne, 100 * kMsecNs);
+    batch.route(vehicleTwo, 150 * kMsecNs);
+
+    QCOMPARE(batch.pending(0).size(), 6 * frameLength);
+    QCOMPARE(batch.pending(1).size(), 3 * frameLength);
+
+    // A new router starts from a clean slate
+    batch.setRouter(std::make_shared<const MAVLinkRouter>(QList<MAVLinkRouter::Endpoint>{endpoint(tenHz)}));
+    batch.route(vehicleOne, 100 * kMsecNs);
+    QCOMPARE(batch.pending(0).size(), frameLength);
+
+    batch.setRouter(nullptr);
+    QVERIFY(!batch.isActive());
+}
+
+void MAVLinkRouterTest::_testEndpointLimit()
+{
+    QList<MAVLinkRouter::Endpoint> endpoints;
+    for (int i = 0; i < MAVLinkRouter::kMaxEndpoints + 2; ++i) {
+        endpoints.append(endpoint(MAVLinkRouteFilter()));
+    }
+
+    expectLogMessage("Comms.MAVLinkRouter", QtWarningMsg, QRegularExpression(QStringLiteral("Routing to the first")));
+    const MAVLinkRouter router(endpoints);
+    QCOMPARE(router.endpointCount(), MAVLinkRouter::kMaxEndpoints);
+    QCOMPARE(router.route(heartbeat(1)), ~quint64(0));
+}
+
+void MAVLinkRouterTest::_testFilterSettingsRoundtrip()
+{
+    TestFixtures::TempDirFixture tmpDir;
+    QVERIFY(tmpDir.isValid());
+    QSettings settings(tmpDir.path() + QStringLiteral("/settings.ini"), QSettings::IniFormat);
+    const QString root = QStringLiteral("MAVLinkRouterTest/route");
+
+    MAVLinkRouteFilter saved;
+    saved.allowSysIds = {1, 2, 255};
+    saved.denyCompIds = {MAV_COMP_ID_GIMBAL};
+    saved.allowMsgIds = {MAVLINK_MSG_ID_HEARTBEAT, 50001};
+    saved.denyMsgIds = {MAVLINK_MSG_ID_ATTITUDE};
+    saved.maxRateHz = 4.5;
+    saved.signing = MAVLinkRouteFilter::SigningPolicy::SignedOnly;
+    saved.saveSettings(settings, root);
+
+    MAVLinkRouteFilter loaded;
+    loaded.loadSettings(settings, root);
+    QVERIFY(loaded == saved);
+
+    // Out-of-range and malformed ids are dropped rather than wrapped
+    settings.setValue(root + QStringLiteral("/allowSysIds"), QStringLiteral("1, 256,x,3"));
+    loaded.loadSettings(settings, root);
+    QCOMPARE(loaded.allowSysIds, QList<uint8_t>({1, 3}));
+}
+
+void MAVLinkRouterTest::_benchmarkFanOut()
+{
+    // 32 endpoints, each interested in one vehicle: a message should cost one endpoint's work, not 32 filter checks
+    QList<MAVLinkRouter::Endpoint> endpoints;
+    for (int i = 0; i < 32; ++i) {
+        MAVLinkRouteFilter filter;
+        filter.allowSysIds = {static_cast<uint8_t>(i + 1)};
+        endpoints.append(endpoint(filter));
+    }
+
+    MAVLinkRouteBatch batch;
+    batch.setRouter(std::make_shared<const MAVLinkRouter>(endpoints));
+
+    QList<mavlink_message_t> messages;
+    for (int i = 0; i < 256; ++i) {
+        messages.append(heartbeat(static_cast<uint8_t>((i % 32) + 1)));
+    }
+
+    auto bench = qgc::bench::ciConfig();
+    bench.relative(true).batch(messages.size()).unit("message");
+
+    bench.run("check every endpoint's filter", [&] {
+        quint64 routed = 0;
+        for (const mavlink_message_t &message : std::as_const(messages)) {
+            for (int i = 0; i < endpoints.size(); ++i) {
+                const MAVLinkRouteFilter &filter = endpoints.at(i).filter;
+                if (filter.acceptsSysId(message.sysid) && filter.acceptsCompId(message.compid) &&
+                    filter.acceptsMsgId(message.msgid)) {
+                    routed |= bit(i);
+                }
+            }
+        }
+        ankerl::nanobench::doNotOptimizeAway(routed);
+    });
+
+    bench.run("MAVLinkRouteBatch::route", [&] {
+        for (const mavlink_message_t &message : std::as_const(messages)) {
+            batch.route(message, 0);
+        }
+        ankerl::nanobench::doNotOptimizeAway(batch.pending(0).size());
+        batch.flush();
+    });
+}
+
+UT_REGISTER_TEST(MAVLinkRouterTest, TestLabel::Unit, TestLabel::Comms)
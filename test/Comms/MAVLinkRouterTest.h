@@ -0,0 +1,16 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkRouterTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testRouteMasks();
+    void _testSigningPolicy();
+    void _testRateLimit();
+    void _testEndpointLimit();
+    void _testFilterSettingsRoundtrip();
+    void _benchmarkFanOut();
+};
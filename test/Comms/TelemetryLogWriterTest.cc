@@ -0,0 +1,214 @@
+#include "TelemetryLogWriterTest.h"
+
+#include "MAVLinkLib.h"
+#include "TelemetryLogWriter.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+#include <thread>
+
+namespace {
+
+struct LoggedRecord
+{
+    quint64 timestampUsec = 0;
+    mavlink_message_t message{};
+};
+
+/// Parses a .tlog back into records. Returns false on any malformed record.
+bool readLog(const QString& fileName, QList<LoggedRecord>& records)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray data = file.readAll();
+
+    qsizetype pos = 0;
+    while (pos < data.size()) {
+        if ((data.size() - pos) < static_cast<qsizetype>(sizeof(quint64))) {
+            return false;
+        }
+        LoggedRecord record;
+        record.timestampUsec = qFromBigEndian<quint64>(data.constData() + pos);
+        pos += sizeof(quint64);
+
+        mavlink_message_t rxMessage{};
+        mavlink_status_t rxStatus{};
+        mavlink_status_t status{};
+        bool parsed = false;
+        while (!parsed && (pos < data.size())) {
+            parsed = mavlink_frame_char_buffer(&rxMessage, &rxStatus, static_cast<uint8_t>(data[pos++]),
+                                               &record.message, &status) == MAVLINK_FRAMING_OK;
+        }
+        if (!parsed) {
+            return false;
+        }
+        records.append(record);
+    }
+    return true;
+}
+
+mavlink_message_t attitudeMessage(uint8_t sysid, uint32_t timeBootMs)
+{
+    mavlink_message_t message{};
+    (void) mavlink_msg_attitude_pack(sysid, MAV_COMP_ID_AUTOPILOT1, &message, timeBootMs, 0, 0, 0, 0, 0, 0);
+    return message;
+}
+
+}  // namespace
+
+void TelemetryLogWriterTest::_testRoundTripFromProducerThreads()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("roundtrip.tlog"));
+
+    TelemetryLogWriter writer;
+    QVERIFY(writer.open(fileName));
+    QVERIFY(writer.isOpen());
+
+    // More than one ring's worth per producer so the writer has to drain while producers are running
+    constexpr uint32_t kPerProducer = 4000;
+    const auto produce = [&writer](int producer, uint8_t sysid) {
+        for (uint32_t i = 0; i < kPerProducer; ++i) {
+            while (!writer.logMessage(producer, TelemetryLogWriter::currentTimestampUsec(), attitudeMessage(sysid, i))) {
+                std::this_thread::yield();
+            }
+        }
+    };
+    std::thread first(produce, 0, 1);
+    std::thread second(produce, 1, 2);
+    first.join();
+    second.join();
+
+    // Outgoing bytes come through the GUI thread producer
+    const mavlink_message_t outgoing = attitudeMessage(255, 0);
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t length = mavlink_msg_to_send_buffer(buffer, &outgoing);
+    QVERIFY(writer.logBytes(TelemetryLogWriter::kGuiThreadProducer, TelemetryLogWriter::currentTimestampUsec(),
+                            QByteArrayView(buffer, length)));
+
+    QVERIFY(writer.close());
+    QVERIFY(!writer.isOpen());
+
+    const TelemetryLogWriter::Stats stats = writer.stats();
+    QCOMPARE(stats.queueDepth, uint64_t(0));
+    QCOMPARE(stats.writtenRecords, uint64_t((kPerProducer * 2) + 1));
+    QCOMPARE(stats.bytesWritten, QFileInfo(fileName).size());
+
+    QList<LoggedRecord> records;
+    QVERIFY(readLog(fileName, records));
+    QCOMPARE(records.size(), qsizetype((kPerProducer * 2) + 1));
+
+    // Each producer's records stay in order and none are lost or duplicated
+    uint32_t next[3]{};
+    for (const LoggedRecord& record : records) {
+        QCOMPARE(record.message.msgid, uint32_t(MAVLINK_MSG_ID_ATTITUDE));
+        const uint8_t index = (record.message.sysid == 255) ? 0 : record.message.sysid;
+        QCOMPARE(mavlink_msg_attitude_get_time_boot_ms(&record.message), next[index]);
+        ++next[index];
+    }
+    QCOMPARE(next[0], uint32_t(1));
+    QCOMPARE(next[1], kPerProducer);
+    QCOMPARE(next[2], kPerProducer);
+}
+
+void TelemetryLogWriterTest::_testSetupSigningOmitted()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("signing.tlog"));
+
+    TelemetryLogWriter writer;
+    QVERIFY(writer.open(fileName));
+
+    mavlink_setup_signing_t setupSigning{};
+    mavlink_message_t signingMessage{};
+    (void) mavlink_msg_setup_signing_encode(255, MAV_COMP_ID_MISSIONPLANNER, &signingMessage, &setupSigning);
+
+    QVERIFY(writer.logMessage(0, 1, attitudeMessage(1, 1)));
+    QVERIFY(writer.logMessage(0, 2, signingMessage));
+    QVERIFY(writer.logMessage(0, 3, attitudeMessage(1, 3)));
+    QVERIFY(writer.close());
+
+    QList<LoggedRecord> records;
+    QVERIFY(readLog(fileName, records));
+    QCOMPARE(records.size(), qsizetype(2));
+    QCOMPARE(records[0].timestampUsec, quint64(1));
+    QCOMPARE(records[1].timestampUsec, quint64(3));
+    QCOMPARE(writer.stats().writtenRecords, uint64_t(2));
+}
+
+void TelemetryLogWriterTest::_testBatchedBytesSplit()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("batched.tlog"));
+
+    TelemetryLogWriter writer;
+    QVERIFY(writer.open(fileName));
+
+    // A forwarded batch: more frames in one write than fit a single record
+    constexpr uint32_t kFrames = 10;
+    QByteArray batch;
+    for (uint32_t i = 0; i < kFrames; ++i) {
+        const mavlink_message_t message = attitudeMessage(1, i);
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const uint16_t length = mavlink_msg_to_send_buffer(buffer, &message);
+        batch.append(reinterpret_cast<const char*>(buffer), length);
+    }
+    QVERIFY(batch.size() > MAVLINK_MAX_PACKET_LEN);
+    QVERIFY(writer.logBytes(TelemetryLogWriter::kGuiThreadProducer, 7, batch));
+    QCOMPARE(writer.stats().droppedRecords, uint64_t(0));
+
+    QVERIFY(writer.close());
+    QCOMPARE(writer.stats().writtenRecords, uint64_t(kFrames));
+
+    QList<LoggedRecord> records;
+    QVERIFY(readLog(fileName, records));
+    QCOMPARE(records.size(), qsizetype(kFrames));
+    for (uint32_t i = 0; i < kFrames; ++i) {
+        QCOMPARE(records[i].timestampUsec, quint64(7));
+        QCOMPARE(mavlink_msg_attitude_get_time_boot_ms(&records[i].message), i);
+    }
+
+    // Closed writers refuse records without counting them as dropped
+    QVERIFY(!writer.logMessage(0, 1, attitudeMessage(1, 1)));
+    QCOMPARE(writer.stats().droppedRecords, uint64_t(0));
+}
+
+void TelemetryLogWriterTest::_testWriteFailureStopsLogging()
+{
+#ifdef Q_OS_LINUX
+    if (!QFile::exists(QStringLiteral("/dev/full"))) {
+        QSKIP("/dev/full not available");
+    }
+
+    TelemetryLogWriter writer;
+    QSignalSpy spy(&writer, &TelemetryLogWriter::writeFailed);
+    QVERIFY(spy.isValid());
+    QVERIFY(writer.open(QStringLiteral("/dev/full")));
+
+    expectLogMessage("Comms.TelemetryLogWriter", QtWarningMsg, QRegularExpression("Write failed"));
+    QVERIFY(writer.logMessage(0, 1, attitudeMessage(1, 1)));
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, TestTimeout::mediumMs());
+    verifyExpectedLogMessage();
+
+    QCOMPARE(spy.first().at(0).toString(), QStringLiteral("/dev/full"));
+    QVERIFY(!writer.isOpen());
+    QVERIFY(!writer.logMessage(0, 2, attitudeMessage(1, 2)));
+
+    QVERIFY(writer.close());
+    QCOMPARE(writer.stats().bytesWritten, qint64(0));
+#else
+    QSKIP("Requires /dev/full");
+#endif
+}
+
+UT_REGISTER_TEST(TelemetryLogWriterTest, TestLabel::Unit, TestLabel::Comms)
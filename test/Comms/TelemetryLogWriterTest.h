@@ -0,0 +1,14 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class TelemetryLogWriterTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testRoundTripFromProducerThreads();
+    void _testSetupSigningOmitted();
+    void _testBatchedBytesSplit();
+    void _testWriteFailureStopsLogging();
+};
@@ -0,0 +1,188 @@
+#include "TlogIndexTest.h"
+
+#include "MAVLinkLib.h"
+#include "TlogIndex.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
+#include <QtTest/QTest>
+
+namespace {
+
+constexpr quint64 kStartUSecs = 1700000000000000ULL;
+constexpr quint64 kStepUSecs = 1000;
+
+/// Record i carries timestamp kStartUSecs + i * kStepUSecs and an ATTITUDE with time_boot_ms == i.
+QByteArray makeTlog(uint32_t recordCount, bool littleEndian = false, int garbageEvery = 0)
+{
+    QByteArray log;
+    for (uint32_t i = 0; i < recordCount; ++i) {
+        if ((garbageEvery > 0) && ((i % garbageEvery) == 0)) {
+            // Includes an STX so resync has to reject a false frame start
+            (void) log.append(QByteArray::fromHex("00fd0102030405"));
+        }
+
+        const quint64 timestamp = kStartUSecs + (i * kStepUSecs);
+        uchar timestampBytes[sizeof(quint64)];
+        if (littleEndian) {
+            qToLittleEndian(timestamp, timestampBytes);
+        } else {
+            qToBigEndian(timestamp, timestampBytes);
+        }
+        (void) log.append(reinterpret_cast<const char*>(timestampBytes), sizeof(timestampBytes));
+
+        mavlink_message_t message{};
+        (void) mavlink_msg_attitude_pack(1, MAV_COMP_ID_AUTOPILOT1, &message, i, 0, 0, 0, 0, 0, 0);
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const uint16_t length = mavlink_msg_to_send_buffer(buffer, &message);
+        (void) log.append(reinterpret_cast<const char*>(buffer), length);
+    }
+    return log;
+}
+
+uint32_t timeBootMs(const TlogIndex& index, const TlogIndex::Record& record)
+{
+    mavlink_message_t message{};
+    mavlink_status_t status{};
+    mavlink_message_t rxMessage{};
+    mavlink_status_t rxStatus{};
+    for (qint64 i = 0; i < record.frameLength; ++i) {
+        if (mavlink_frame_char_buffer(&rxMessage, &rxStatus, index.data()[record.frameOffset + i], &message, &status) ==
+            MAVLINK_FRAMING_OK) {
+            return mavlink_msg_attitude_get_time_boot_ms(&message);
+        }
+    }
+    return UINT32_MAX;
+}
+
+}  // namespace
+
+void TlogIndexTest::_testReadRecordsSkipsGarbage()
+{
+    constexpr uint32_t kRecords = 200;
+    const QByteArray log = makeTlog(kRecords, false, 7);
+
+    TlogIndex index;
+    index.setData(reinterpret_cast<const uchar*>(log.constData()), log.size());
+    QCOMPARE(index.firstTimestamp(), kStartUSecs);
+
+    uint32_t count = 0;
+    TlogIndex::Record record;
+    qint64 offset = 0;
+    while (index.readRecord(offset, record)) {
+        QCOMPARE(record.timestampUSecs, kStartUSecs + (count * kStepUSecs));
+        QCOMPARE(timeBootMs(index, record), count);
+        offset = record.nextOffset();
+        ++count;
+    }
+    QCOMPARE(count, kRecords);
+
+    QVERIFY(index.build());
+    QCOMPARE(index.recordCount(), quint64(kRecords));
+    QCOMPARE(index.lastTimestamp(), kStartUSecs + ((kRecords - 1) * kStepUSecs));
+}
+
+void TlogIndexTest::_testSeek()
+{
+    constexpr uint32_t kRecords = 1000;
+    const QByteArray log = makeTlog(kRecords);
+
+    TlogIndex index;
+    index.setData(reinterpret_cast<const uchar*>(log.constData()), log.size());
+
+    TlogIndex::Record record;
+    QVERIFY2(!index.seek(kStartUSecs, record), "seek needs a built index");
+    QVERIFY(index.build());
+
+    for (const uint32_t target : {0u, 1u, 63u, 64u, 65u, 500u, 999u}) {
+        QVERIFY(index.seek(kStartUSecs + (target * kStepUSecs), record));
+        QCOMPARE(timeBootMs(index, record), target);
+    }
+
+    // Between two records lands on the later one
+    QVERIFY(index.seek(kStartUSecs + (10 * kStepUSecs) + 1, record));
+    QCOMPARE(timeBootMs(index, record), 11u);
+
+    QVERIFY(index.seek(0, record));
+    QCOMPARE(timeBootMs(index, record), 0u);
+
+    QVERIFY(!index.seek(kStartUSecs + (kRecords * kStepUSecs), record));
+}
+
+void TlogIndexTest::_testFindLastTimestamp()
+{
+    // Larger than the tail window so only the tail gets framed
+    constexpr uint32_t kRecords = 5000;
+    const QByteArray log = makeTlog(kRecords, false, 13);
+    QVERIFY(log.size() > (64 * 1024));
+
+    TlogIndex index;
+    index.setData(reinterpret_cast<const uchar*>(log.constData()), log.size());
+    QCOMPARE(index.findLastTimestamp(), kStartUSecs + ((kRecords - 1) * kStepUSecs));
+
+    // Trailing partial frame is ignored
+    const QByteArray truncated = log.left(log.size() - 3);
+    index.setData(reinterpret_cast<const uchar*>(truncated.constData()), truncated.size());
+    QCOMPARE(index.findLastTimestamp(), kStartUSecs + ((kRecords - 2) * kStepUSecs));
+}
+
+void TlogIndexTest::_testLittleEndianTimestamps()
+{
+    constexpr uint32_t kRecords = 100;
+    const QByteArray log = makeTlog(kRecords, true);
+
+    TlogIndex index;
+    index.setData(reinterpret_cast<const uchar*>(log.constData()), log.size());
+    QCOMPARE(index.firstTimestamp(), kStartUSecs);
+    QCOMPARE(index.findLastTimestamp(), kStartUSecs + ((kRecords - 1) * kStepUSecs));
+
+    QVERIFY(index.build());
+    TlogIndex::Record record;
+    QVERIFY(index.seek(kStartUSecs + (42 * kStepUSecs), record));
+    QCOMPARE(timeBootMs(index, record), 42u);
+}
+
+void TlogIndexTest::_testCacheRoundTrip()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString logFileName = tempDir.filePath(QStringLiteral("replay.tlog"));
+
+    constexpr uint32_t kRecords = 1000;
+    {
+        QFile file(logFileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QVERIFY(file.write(makeTlog(kRecords)) > 0);
+    }
+
+    QFile file(logFileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const uchar* const data = file.map(0, file.size());
+    QVERIFY(data);
+
+    TlogIndex built;
+    built.setData(data, file.size());
+    QVERIFY(!built.loadCache(logFileName));
+    QVERIFY(built.build());
+    QVERIFY(built.saveCache(logFileName));
+    QVERIFY(QFile::exists(TlogIndex::cacheFileName(logFileName)));
+
+    TlogIndex cached;
+    cached.setData(data, file.size());
+    QVERIFY(cached.loadCache(logFileName));
+    QVERIFY(cached.isBuilt());
+    QCOMPARE(cached.recordCount(), built.recordCount());
+    QCOMPARE(cached.lastTimestamp(), built.lastTimestamp());
+
+    TlogIndex::Record record;
+    QVERIFY(cached.seek(kStartUSecs + (777 * kStepUSecs), record));
+    QCOMPARE(timeBootMs(cached, record), 777u);
+
+    // A cache for a different file size is stale
+    TlogIndex shorter;
+    shorter.setData(data, file.size() - 1);
+    QVERIFY(!shorter.loadCache(logFileName));
+}
+
+UT_REGISTER_TEST(TlogIndexTest, TestLabel::Unit, TestLabel::Comms)
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class TlogIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testReadRecordsSkipsGarbage();
+    void _testSeek();
+    void _testFindLastTimestamp();
+    void _testLittleEndianTimestamps();
+    void _testCacheRoundTrip();
+};
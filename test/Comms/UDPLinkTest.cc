@@ -0,0 +1,181 @@
+#include "UDPLinkTest.h"
+
+#include "LinkManager.h"
+#include "MAVLinkLib.h"
+#include "MAVLinkProtocol.h"
+#include "MavlinkSettings.h"
+#include "SettingsManager.h"
+#include "UDPLink.h"
+
+#include <QtCore/QThread>
+#include <QtNetwork/QUdpSocket>
+#include <QtTest/QTest>
+
+void UDPLinkTest::_testMessagesDeliveredOnGuiThread()
+{
+    // Grab a free port for the link to bind to
+    quint16 port = 0;
+    {
+        QUdpSocket probe;
+        QVERIFY(probe.bind(QHostAddress::LocalHost, 0));
+        port = probe.localPort();
+    }
+
+    UDPConfiguration *const udpConfig = new UDPConfiguration(QStringLiteral("UDPLinkTest"));
+    udpConfig->setLocalPort(port);
+    udpConfig->setDynamic(true);
+    SharedLinkConfigurationPtr config = linkManager()->addConfiguration(udpConfig);
+    QVERIFY(linkManager()->createConnectedLink(config));
+    QVERIFY(config->link());
+    QTRY_VERIFY_WITH_TIMEOUT(config->link()->isConnected(), TestTimeout::mediumMs());
+
+    LinkInterface *const link = config->link();
+    QList<uint32_t> received;
+    bool allOnGuiThread = true;
+    const QMetaObject::Connection connection = connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::messageReceived, this,
+        [&](LinkInterface *msgLink, const mavlink_message_t &message) {
+            if ((msgLink != link) || (message.msgid != MAVLINK_MSG_ID_ATTITUDE)) {
+                return;
+            }
+            allOnGuiThread &= (QThread::currentThread() == thread());
+            received.append(mavlink_msg_attitude_get_time_boot_ms(&message));
+        });
+
+    // Status snapshots follow the messages they count, so at least that many have been dispatched
+    QList<uint64_t> statusReceived;
+    bool statusAfterDispatch = true;
+    const QMetaObject::Connection statusConnection = connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::mavlinkMessageStatus, this,
+        [&](int sysid, uint64_t, uint64_t totalReceived, uint64_t, float) {
+            if (sysid != 200) {
+                return;
+            }
+            allOnGuiThread &= (QThread::currentThread() == thread());
+            statusAfterDispatch &= (static_cast<uint64_t>(received.size()) >= totalReceived);
+            statusReceived.append(totalReceived);
+        });
+
+    // No HEARTBEAT is sent, so no Vehicle gets created for this traffic
+    constexpr uint32_t kMessageCount = 64;
+    QUdpSocket sender;
+    for (uint32_t i = 0; i < kMessageCount; ++i) {
+        mavlink_message_t message{};
+        (void) mavlink_msg_attitude_pack(200, MAV_COMP_ID_AUTOPILOT1, &message, i, 0, 0, 0, 0, 0, 0);
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+        QCOMPARE(sender.writeDatagram(reinterpret_cast<const char*>(buffer), len, QHostAddress::LocalHost, port), qint64(len));
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(received.size(), qsizetype(kMessageCount), TestTimeout::mediumMs());
+    QTRY_VERIFY_WITH_TIMEOUT(!statusReceived.isEmpty(), TestTimeout::mediumMs());
+    QVERIFY(statusAfterDispatch);
+    QVERIFY(allOnGuiThread);
+    for (uint32_t i = 0; i < kMessageCount; ++i) {
+        QCOMPARE(received[i], i);
+    }
+
+    (void) disconnect(connection);
+    (void) disconnect(statusConnection);
+    linkManager()->disconnectLink(link);
+    QTRY_VERIFY_WITH_TIMEOUT(config->link() == nullptr, TestTimeout::mediumMs());
+    linkManager()->removeConfiguration(config.get());
+}
+
+void UDPLinkTest::_testForwardsReceivedMessages()
+{
+    QUdpSocket forwardReceiver;
+    QVERIFY(forwardReceiver.bind(QHostAddress::LocalHost, 0));
+
+    // Same name LinkManager gives the link it creates from the forwarding settings
+    UDPConfiguration *const forwardConfig = new UDPConfiguration(QStringLiteral("MAVLink Forwarding Link"));
+    forwardConfig->setDynamic(true);
+    forwardConfig->setForwarding(true);
+    forwardConfig->addHost(QStringLiteral("127.0.0.1"), forwardReceiver.localPort());
+    SharedLinkConfigurationPtr forwardLinkConfig = linkManager()->addConfiguration(forwardConfig);
+    QVERIFY(linkManager()->createConnectedLink(forwardLinkConfig));
+    QTRY_VERIFY_WITH_TIMEOUT(forwardLinkConfig->link() && forwardLinkConfig->link()->isConnected(), TestTimeout::mediumMs());
+
+    Fact *const forwardMavlink = SettingsManager::instance()->mavlinkSettings()->forwardMavlink();
+    forwardMavlink->setRawValue(true);
+
+    quint16 port = 0;
+    {
+        QUdpSocket probe;
+        QVERIFY(probe.bind(QHostAddress::LocalHost, 0));
+        port = probe.localPort();
+    }
+    UDPConfiguration *const udpConfig = new UDPConfiguration(QStringLiteral("UDPLinkTestSource"));
+    udpConfig->setLocalPort(port);
+    udpConfig->setDynamic(true);
+    SharedLinkConfigurationPtr config = linkManager()->addConfiguration(udpConfig);
+    QVERIFY(linkManager()->createConnectedLink(config));
+    QTRY_VERIFY_WITH_TIMEOUT(config->link() && config->link()->isConnected(), TestTimeout::mediumMs());
+
+    // SETUP_SIGNING carries a key and must never be forwarded
+    constexpr uint32_t kMessageCount = 64;
+    QUdpSocket sender;
+    for (uint32_t i = 0; i < kMessageCount; ++i) {
+        mavlink_message_t message{};
+        if (i == (kMessageCount / 2)) {
+            mavlink_setup_signing_t setupSigning{};
+            (void) mavlink_msg_setup_signing_encode(200, MAV_COMP_ID_AUTOPILOT1, &message, &setupSigning);
+        } else {
+            (void) mavlink_msg_attitude_pack(200, MAV_COMP_ID_AUTOPILOT1, &message, i, 0, 0, 0, 0, 0, 0);
+        }
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+        QCOMPARE(sender.writeDatagram(reinterpret_cast<const char*>(buffer), len, QHostAddress::LocalHost, port), qint64(len));
+    }
+
+    constexpr uint8_t kParseChannel = MAVLINK_COMM_NUM_BUFFERS - 1;
+    QList<uint32_t> forwarded;
+    bool sawSetupSigning = false;
+    bool sawSystemTime = false;
+    const auto drain = [&]() {
+        while (forwardReceiver.hasPendingDatagrams()) {
+            const QByteArray datagram = forwardReceiver.receiveDatagram().data();
+            for (const char byte : datagram) {
+                mavlink_message_t message{};
+                mavlink_status_t status{};
+                if (mavlink_parse_char(kParseChannel, static_cast<uint8_t>(byte), &message, &status) != MAVLINK_FRAMING_OK) {
+                    continue;
+                }
+                if (message.msgid == MAVLINK_MSG_ID_ATTITUDE) {
+                    forwarded.append(mavlink_msg_attitude_get_time_boot_ms(&message));
+                }
+                sawSetupSigning |= (message.msgid == MAVLINK_MSG_ID_SETUP_SIGNING);
+                sawSystemTime |= (message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME);
+            }
+        }
+        return forwarded.size();
+    };
+    QTRY_COMPARE_WITH_TIMEOUT(drain(), qsizetype(kMessageCount - 1), TestTimeout::mediumMs());
+    QVERIFY(!sawSetupSigning);
+    for (qsizetype i = 1; i < forwarded.size(); ++i) {
+        QVERIFY(forwarded[i] > forwarded[i - 1]);
+    }
+
+    // Editing the endpoint's filter re-routes traffic already flowing; SYSTEM_TIME goes last and still passes
+    forwardLinkConfig->setRouteDenyMsgIds(QString::number(MAVLINK_MSG_ID_ATTITUDE));
+    for (uint32_t i = 0; i <= 8; ++i) {
+        mavlink_message_t message{};
+        if (i == 8) {
+            (void) mavlink_msg_system_time_pack(200, MAV_COMP_ID_AUTOPILOT1, &message, 0, i);
+        } else {
+            (void) mavlink_msg_attitude_pack(200, MAV_COMP_ID_AUTOPILOT1, &message, kMessageCount + i, 0, 0, 0, 0, 0, 0);
+        }
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+        QCOMPARE(sender.writeDatagram(reinterpret_cast<const char*>(buffer), len, QHostAddress::LocalHost, port), qint64(len));
+    }
+    QTRY_VERIFY_WITH_TIMEOUT((drain(), sawSystemTime), TestTimeout::mediumMs());
+    QCOMPARE(forwarded.size(), qsizetype(kMessageCount - 1));
+
+    forwardMavlink->setRawValue(false);
+    linkManager()->disconnectLink(config->link());
+    linkManager()->disconnectLink(forwardLinkConfig->link());
+    QTRY_VERIFY_WITH_TIMEOUT((config->link() == nullptr) && (forwardLinkConfig->link() == nullptr), TestTimeout::mediumMs());
+    linkManager()->removeConfiguration(config.get());
+    linkManager()->removeConfiguration(forwardLinkConfig.get());
+}
+
+UT_REGISTER_TEST(UDPLinkTest, TestLabel::Integration, TestLabel::Comms)
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "CommsTest.h"
+
+/// Tests for UDPLink receive handling. MAVLink is decoded on the link worker thread and only whole messages are
+/// delivered to the GUI thread.
+class UDPLinkTest : public CommsTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testMessagesDeliveredOnGuiThread();
+    void _testForwardsReceivedMessages();
+};
@@ -0,0 +1,170 @@
+#include "UdpDatagramBatchTest.h"
+#include "Benchmarking.h"
+#include "UdpDatagramBatch.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtNetwork/QNetworkDatagram>
+#include <QtNetwork/QUdpSocket>
+#include <QtTest/QTest>
+
+namespace {
+
+/// MAVLink-sized payload tagged with its sequence number
+QByteArray floodDatagram(int sequence)
+{
+    QByteArray datagram(64, static_cast<char>(sequence & 0xFF));
+    (void) datagram.prepend(QByteArray::number(sequence) + ':');
+    return datagram;
+}
+
+void flood(QUdpSocket &sender, quint16 port, int count)
+{
+    for (int i = 0; i < count; i++) {
+        (void) sender.writeDatagram(floodDatagram(i), QHostAddress(QHostAddress::LocalHost), port);
+    }
+}
+
+}  // namespace
+
+void UdpDatagramBatchTest::_testReceiveBatches()
+{
+    if (!UdpDatagramBatch::isSupported()) {
+        QSKIP("Batched datagram I/O is not supported on this platform");
+    }
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress::LocalHost, 0));
+
+    // More than one batch, so the second receive picks up where the first stopped
+    constexpr int kDatagrams = UdpDatagramBatch::kBatchSize + 36;
+    flood(sender, receiver.localPort(), kDatagrams);
+    QVERIFY(receiver.waitForReadyRead(TestTimeout::mediumMs()));
+
+    UdpDatagramBatch batch;
+    int received = 0;
+    QElapsedTimer timer;
+    timer.start();
+    while ((received < kDatagrams) && (timer.elapsed() < TestTimeout::mediumMs())) {
+        const int count = batch.receive(receiver.socketDescriptor());
+        QVERIFY2(count >= 0, qPrintable(batch.errorString()));
+        QVERIFY(count <= UdpDatagramBatch::kBatchSize);
+        for (int i = 0; i < count; i++) {
+            QCOMPARE(batch.datagram(i).toByteArray(), floodDatagram(received + i));
+            QCOMPARE(batch.sender(i).ipv4, QHostAddress(QHostAddress::LocalHost).toIPv4Address());
+            QCOMPARE(batch.sender(i).port, sender.localPort());
+        }
+        received += count;
+    }
+    QCOMPARE(received, kDatagrams);
+    QCOMPARE(batch.receive(receiver.socketDescriptor()), 0);
+    QCOMPARE(batch.truncatedDatagrams(), quint64(0));
+}
+
+void UdpDatagramBatchTest::_testReceiveLargeDatagram()
+{
+    if (!UdpDatagramBatch::isSupported()) {
+        QSKIP("Batched datagram I/O is not supported on this platform");
+    }
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress::LocalHost, 0));
+
+    // A router batching many frames into one jumbo datagram, next to an ordinary one
+    QByteArray large(32000, '\0');
+    for (qsizetype i = 0; i < large.size(); i++) {
+        large[i] = static_cast<char>(i * 7);
+    }
+    QCOMPARE(sender.writeDatagram(large, QHostAddress(QHostAddress::LocalHost), receiver.localPort()), qint64(large.size()));
+    (void) sender.writeDatagram(floodDatagram(1), QHostAddress(QHostAddress::LocalHost), receiver.localPort());
+    QVERIFY(receiver.waitForReadyRead(TestTimeout::mediumMs()));
+
+    UdpDatagramBatch batch;
+    QList<QByteArray> received;
+    QElapsedTimer timer;
+    timer.start();
+    while ((received.size() < 2) && (timer.elapsed() < TestTimeout::mediumMs())) {
+        const int count = batch.receive(receiver.socketDescriptor());
+        QVERIFY2(count >= 0, qPrintable(batch.errorString()));
+        for (int i = 0; i < count; i++) {
+            received.append(batch.datagram(i).toByteArray());
+        }
+    }
+    QCOMPARE(received.size(), qsizetype(2));
+    QCOMPARE(received[0], large);
+    QCOMPARE(received[1], floodDatagram(1));
+    QCOMPARE(batch.truncatedDatagrams(), quint64(0));
+}
+
+void UdpDatagramBatchTest::_testSendToEndpoints()
+{
+    if (!UdpDatagramBatch::isSupported()) {
+        QSKIP("Batched datagram I/O is not supported on this platform");
+    }
+
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress::LocalHost, 0));
+
+    constexpr int kReceivers = 3;
+    QUdpSocket receivers[kReceivers];
+    QList<UdpDatagramBatch::Endpoint> endpoints;
+    for (QUdpSocket &receiver : receivers) {
+        QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+        endpoints.append({QHostAddress(QHostAddress::LocalHost).toIPv4Address(), receiver.localPort()});
+    }
+
+    const QByteArray payload = floodDatagram(7);
+    UdpDatagramBatch batch;
+    QCOMPARE(batch.send(sender.socketDescriptor(), payload, endpoints), kReceivers);
+
+    for (QUdpSocket &receiver : receivers) {
+        QVERIFY(receiver.hasPendingDatagrams() || receiver.waitForReadyRead(TestTimeout::mediumMs()));
+        const QNetworkDatagram datagram = receiver.receiveDatagram();
+        QCOMPARE(datagram.data(), payload);
+        QCOMPARE(datagram.senderPort(), static_cast<int>(sender.localPort()));
+    }
+}
+
+void UdpDatagramBatchTest::_benchmarkReceiveFlood()
+{
+    if (!UdpDatagramBatch::isSupported()) {
+        QSKIP("Batched datagram I/O is not supported on this platform");
+    }
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress::LocalHost, 0));
+    const quint16 port = receiver.localPort();
+
+    // Each iteration floods one batch worth of datagrams over loopback and drains them; the send side is common to both
+    constexpr int kDatagrams = UdpDatagramBatch::kBatchSize;
+    auto bench = qgc::bench::ciConfig();
+    bench.relative(true).batch(kDatagrams).unit("datagram");
+
+    bench.run("QUdpSocket::receiveDatagram loop", [&] {
+        flood(sender, port, kDatagrams);
+        int received = 0;
+        while (receiver.hasPendingDatagrams()) {
+            const QNetworkDatagram datagram = receiver.receiveDatagram();
+            received += datagram.isValid() ? 1 : 0;
+        }
+        ankerl::nanobench::doNotOptimizeAway(received);
+    });
+
+    UdpDatagramBatch batch;
+    bench.run("UdpDatagramBatch::receive", [&] {
+        flood(sender, port, kDatagrams);
+        int received = 0;
+        int count = 0;
+        while ((count = batch.receive(receiver.socketDescriptor())) > 0) {
+            received += count;
+        }
+        ankerl::nanobench::doNotOptimizeAway(received);
+    });
+}
+
+UT_REGISTER_TEST(UdpDatagramBatchTest, TestLabel::Unit, TestLabel::Comms)
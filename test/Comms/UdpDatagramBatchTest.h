@@ -0,0 +1,14 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class UdpDatagramBatchTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testReceiveBatches();
+    void _testReceiveLargeDatagram();
+    void _testSendToEndpoints();
+    void _benchmarkReceiveFlood();
+};
@@ -19,6 +19,7 @@ class TestableFactGroup : public FactGroup
     using FactGroup::_addFact;
     using FactGroup::_addFactGroup;
     using FactGroup::_setTelemetryAvailable;
+    using FactGroup::_setCoalescedNotifications;
 };
 
 void FactGroupTest::_addFactAndLookup_test()
@@ -234,6 +235,21 @@ void FactGroupTest::_factGroupNames_test()
     QVERIFY(names.contains(QStringLiteral("sub2")));
 }
 
+void FactGroupTest::_coalescedNotificationsOptIn_test()
+{
+    TestableFactGroup group;
+    Fact before(0, "before", FactMetaData::valueTypeDouble, &group);
+    Fact after(0, "after", FactMetaData::valueTypeDouble, &group);
+
+    group._addFact(&before, QStringLiteral("before"));
+    QVERIFY(!before.coalescedNotifications());
+
+    group._setCoalescedNotifications(true);
+    group._addFact(&after, QStringLiteral("after"));
+    QVERIFY(before.coalescedNotifications());
+    QVERIFY(after.coalescedNotifications());
+}
+
 #include "FactGroupTest.moc"
 
 UT_REGISTER_TEST(FactGroupTest, TestLabel::Unit)
@@ -0,0 +1,177 @@
+#include "FactNotificationCoalescerTest.h"
+#include "Benchmarking.h"
+#include "Fact.h"
+#include "FactMetaData.h"
+#include "FactNotificationCoalescer.h"
+
+#include <QtTest/QSignalSpy>
+
+void FactNotificationCoalescerTest::cleanup()
+{
+    FactNotificationCoalescer::instance()->setIntervalMSecs(FactNotificationCoalescer::kDefaultIntervalMSecs);
+    FactNotificationCoalescer::instance()->flush();
+    UnitTest::cleanup();
+}
+
+void FactNotificationCoalescerTest::_coalescesToLatestValue_test()
+{
+    Fact fact(0, "roll", FactMetaData::valueTypeDouble);
+    fact.setCoalescedNotifications(true);
+
+    QSignalSpy rawSpy(&fact, &Fact::rawValueChanged);
+    QSignalSpy valueSpy(&fact, &Fact::valueChanged);
+
+    for (int i = 1; i <= 100; i++) {
+        fact.setRawValue(static_cast<double>(i));
+    }
+    QCOMPARE(rawSpy.count(), 0);
+    QCOMPARE(valueSpy.count(), 0);
+    QCOMPARE(FactNotificationCoalescer::instance()->pendingCount(), 1);
+
+    QVERIFY(rawSpy.wait(1000));
+    QCOMPARE(rawSpy.count(), 1);
+    QCOMPARE(rawSpy.at(0).at(0).toDouble(), 100.0);
+    QCOMPARE(valueSpy.count(), 1);
+    QCOMPARE(FactNotificationCoalescer::instance()->pendingCount(), 0);
+
+    // Same value again is not a change
+    fact.setRawValue(100.0);
+    QCOMPARE(FactNotificationCoalescer::instance()->pendingCount(), 0);
+}
+
+void FactNotificationCoalescerTest::_rawValueIsImmediate_test()
+{
+    Fact fact(0, "altitude", FactMetaData::valueTypeFloat);
+    fact.setCoalescedNotifications(true);
+
+    fact.setRawValue(12.5f);
+    QCOMPARE(fact.rawValue().toFloat(), 12.5f);
+    QCOMPARE(fact.rawValue().metaType(), QMetaType::fromType<float>());
+
+    fact.setRawValue(QVariant(13.5));
+    QCOMPARE(fact.rawValue().toFloat(), 13.5f);
+}
+
+void FactNotificationCoalescerTest::_zeroIntervalNotifiesImmediately_test()
+{
+    Fact fact(0, "heading", FactMetaData::valueTypeDouble);
+    fact.setCoalescedNotifications(true);
+
+    QSignalSpy rawSpy(&fact, &Fact::rawValueChanged);
+    fact.setRawValue(1.0);
+    QCOMPARE(rawSpy.count(), 0);
+
+    // Disabling flushes what is pending
+    FactNotificationCoalescer::instance()->setIntervalMSecs(0);
+    QCOMPARE(rawSpy.count(), 1);
+
+    fact.setRawValue(2.0);
+    QCOMPARE(rawSpy.count(), 2);
+    QCOMPARE(rawSpy.at(1).at(0).toDouble(), 2.0);
+}
+
+void FactNotificationCoalescerTest::_deletedFactIsSkipped_test()
+{
+    Fact *const fact = new Fact(0, "pitch", FactMetaData::valueTypeDouble);
+    fact->setCoalescedNotifications(true);
+    fact->setRawValue(5.0);
+    QCOMPARE(FactNotificationCoalescer::instance()->pendingCount(), 1);
+
+    delete fact;
+    FactNotificationCoalescer::instance()->flush();
+    QCOMPARE(FactNotificationCoalescer::instance()->pendingCount(), 0);
+}
+
+void FactNotificationCoalescerTest::_typedSetterMatchesVariantSetter_test()
+{
+    const struct {
+        FactMetaData::ValueType_t type;
+        QMetaType metaType;
+    } cases[] = {
+        { FactMetaData::valueTypeUint8,  QMetaType::fromType<uint>() },
+        { FactMetaData::valueTypeInt16,  QMetaType::fromType<int>() },
+        { FactMetaData::valueTypeInt32,  QMetaType::fromType<int>() },
+        { FactMetaData::valueTypeUint32, QMetaType::fromType<uint>() },
+        { FactMetaData::valueTypeInt64,  QMetaType::fromType<qlonglong>() },
+        { FactMetaData::valueTypeUint64, QMetaType::fromType<qulonglong>() },
+    };
+
+    for (const auto &test : cases) {
+        Fact typed(0, "typed", test.type);
+        Fact variant(0, "variant", test.type);
+
+        typed.setRawValue(uint16_t{42});
+        variant.setRawValue(QVariant(42));
+        QCOMPARE(typed.rawValue().metaType(), test.metaType);
+        QCOMPARE(typed.rawValue(), variant.rawValue());
+    }
+
+    Fact boolFact(0, "armed", FactMetaData::valueTypeBool);
+    QSignalSpy boolSpy(&boolFact, &Fact::rawValueChanged);
+    boolFact.setRawValue(true);
+    QCOMPARE(boolFact.rawValue().metaType(), QMetaType::fromType<bool>());
+    QCOMPARE(boolSpy.count(), 1);
+    boolFact.setRawValue(true);
+    QCOMPARE(boolSpy.count(), 1);
+}
+
+void FactNotificationCoalescerTest::_typedSetterFallsBack_test()
+{
+    // Out of range for the fast path; the QVariant conversion decides, as before
+    Fact intFact(0, "int", FactMetaData::valueTypeInt32);
+    intFact.setRawValue(int64_t{5});
+    QCOMPARE(intFact.rawValue().toInt(), 5);
+    intFact.setRawValue(int64_t{1} << 40);
+    QCOMPARE(intFact.rawValue().metaType(), QMetaType::fromType<int>());
+
+    Fact uintFact(0, "uint", FactMetaData::valueTypeUint32);
+    uintFact.setRawValue(7);
+    QCOMPARE(uintFact.rawValue().toUInt(), 7u);
+    uintFact.setRawValue(-1);
+    QCOMPARE(uintFact.rawValue().metaType(), QMetaType::fromType<uint>());
+
+    // Mismatched kinds go through the QVariant conversion
+    Fact doubleFact(0, "double", FactMetaData::valueTypeDouble);
+    doubleFact.setRawValue(3);
+    QCOMPARE(doubleFact.rawValue().metaType(), QMetaType::fromType<double>());
+    QCOMPARE(doubleFact.rawValue().toDouble(), 3.0);
+
+    Fact stringFact(0, "string", FactMetaData::valueTypeString);
+    stringFact.setRawValue(1.5);
+    QCOMPARE(stringFact.rawValue().toString(), QStringLiteral("1.5"));
+}
+
+void FactNotificationCoalescerTest::_benchmarkTelemetryWrites()
+{
+    Fact immediate(0, "immediate", FactMetaData::valueTypeDouble);
+    Fact coalesced(0, "coalesced", FactMetaData::valueTypeDouble);
+    coalesced.setCoalescedNotifications(true);
+
+    // Stand-in for a QML binding so the immediate Fact pays for delivering its signals
+    int bindingEvaluations = 0;
+    (void) connect(&immediate, &Fact::valueChanged, this, [&bindingEvaluations]() { bindingEvaluations++; });
+    (void) connect(&coalesced, &Fact::valueChanged, this, [&bindingEvaluations]() { bindingEvaluations++; });
+
+    double value = 0;
+    auto bench = qgc::bench::ciConfig();
+    bench.relative(true).unit("write");
+
+    bench.run("setRawValue(QVariant), immediate", [&] {
+        immediate.setRawValue(QVariant(value += 0.5));
+        ankerl::nanobench::doNotOptimizeAway(bindingEvaluations);
+    });
+
+    bench.run("setRawValue(double), immediate", [&] {
+        immediate.setRawValue(value += 0.5);
+        ankerl::nanobench::doNotOptimizeAway(bindingEvaluations);
+    });
+
+    bench.run("setRawValue(double), coalesced", [&] {
+        coalesced.setRawValue(value += 0.5);
+        ankerl::nanobench::doNotOptimizeAway(bindingEvaluations);
+    });
+
+    FactNotificationCoalescer::instance()->flush();
+}
+
+UT_REGISTER_TEST(FactNotificationCoalescerTest, TestLabel::Unit)
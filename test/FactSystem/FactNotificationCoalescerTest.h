@@ -0,0 +1,19 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class FactNotificationCoalescerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void cleanup() override;
+
+    void _coalescesToLatestValue_test();
+    void _rawValueIsImmediate_test();
+    void _zeroIntervalNotifiesImmediately_test();
+    void _deletedFactIsSkipped_test();
+    void _typedSetterMatchesVariantSetter_test();
+    void _typedSetterFallsBack_test();
+    void _benchmarkTelemetryWrites();
+};
@@ -0,0 +1,334 @@
+#include "MAVLinkFrameScannerTest.h"
+
+#include <algorithm>
+
+#include "Benchmarking.h"
+#include "MAVLinkFrameScanner.h"
+#include "MAVLinkLib.h"
+#include "MAVLinkSigning.h"
+#include "SigningChannel.h"
+
+namespace {
+
+constexpr uint8_t kScanChannel = MAVLINK_COMM_14;
+constexpr uint8_t kByteChannel = MAVLINK_COMM_15;
+constexpr uint8_t kEncodeChannel = MAVLINK_COMM_13;
+constexpr uint8_t kUnsignedEncodeChannel = MAVLINK_COMM_12;
+
+struct ParsedFrame
+{
+    uint8_t framing = 0;
+    bool isV1 = false;
+    uint32_t msgid = 0;
+    uint8_t seq = 0;
+    uint8_t sysid = 0;
+    uint8_t compid = 0;
+    QByteArray payload;
+
+    bool operator==(const ParsedFrame& other) const = default;
+};
+
+ParsedFrame toParsedFrame(uint8_t framing, bool isV1, const mavlink_message_t& message)
+{
+    return ParsedFrame{
+        .framing = framing,
+        .isV1 = isV1,
+        .msgid = message.msgid,
+        .seq = message.seq,
+        .sysid = message.sysid,
+        .compid = message.compid,
+        .payload = QByteArray(_MAV_PAYLOAD(&message), message.len),
+    };
+}
+
+void resetChannel(uint8_t channel)
+{
+    *mavlink_get_channel_status(channel) = mavlink_status_t{};
+}
+
+void appendMessage(QByteArray& stream, const mavlink_message_t& message)
+{
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+    stream.append(reinterpret_cast<const char*>(buffer), len);
+}
+
+void appendHeartbeat(QByteArray& stream, uint8_t channel, bool asV1 = false)
+{
+    mavlink_status_t* const status = mavlink_get_channel_status(channel);
+    if (asV1) {
+        status->flags |= MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+    }
+
+    mavlink_message_t message{};
+    (void) mavlink_msg_heartbeat_pack_chan(1, MAV_COMP_ID_AUTOPILOT1, channel, &message, MAV_TYPE_QUADROTOR,
+                                           MAV_AUTOPILOT_PX4, MAV_MODE_FLAG_CUSTOM_MODE_ENABLED, 0, MAV_STATE_ACTIVE);
+    appendMessage(stream, message);
+
+    status->flags &= ~MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+}
+
+void appendAttitude(QByteArray& stream, uint8_t channel, uint32_t timeBootMs, float yawspeed = 0.5f)
+{
+    mavlink_message_t message{};
+    (void) mavlink_msg_attitude_pack_chan(1, MAV_COMP_ID_AUTOPILOT1, channel, &message, timeBootMs, 0.1f, 0.2f, 0.3f,
+                                          0.01f, 0.02f, yawspeed);
+    appendMessage(stream, message);
+}
+
+/// Mixed v1/v2 traffic with line noise, a dangling STX and corrupted CRCs.
+QByteArray buildMixedStream(int frameCount)
+{
+    QByteArray stream;
+    for (int i = 0; i < frameCount; ++i) {
+        appendAttitude(stream, kEncodeChannel, static_cast<uint32_t>(i));
+        if ((i % 5) == 0) {
+            appendHeartbeat(stream, kEncodeChannel);
+        }
+        if ((i % 7) == 0) {
+            appendHeartbeat(stream, kEncodeChannel, true);
+        }
+        if ((i % 11) == 0) {
+            QByteArray corrupt;
+            appendAttitude(corrupt, kEncodeChannel, static_cast<uint32_t>(i));
+            corrupt[corrupt.size() - 1] = static_cast<char>(corrupt.back() ^ 0x5A);
+            stream.append(corrupt);
+        }
+        if ((i % 13) == 0) {
+            stream.append("\x00\x42\x13\x37", 4);
+        }
+        if ((i % 31) == 0) {
+            // Stray STX: the parser commits to a bogus header and has to resync on a later frame.
+            stream.append(static_cast<char>(MAVLINK_STX));
+        }
+    }
+    return stream;
+}
+
+QList<ParsedFrame> parseBytewise(uint8_t channel, const QByteArray& stream)
+{
+    QList<ParsedFrame> frames;
+    mavlink_message_t message{};
+    mavlink_status_t status{};
+    for (const char byte : stream) {
+        const uint8_t framing = mavlink_parse_char(channel, static_cast<uint8_t>(byte), &message, &status);
+        if ((framing == MAVLINK_FRAMING_OK) || (framing == MAVLINK_FRAMING_BAD_SIGNATURE)) {
+            frames.append(toParsedFrame(framing, status.flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1, message));
+        }
+    }
+    return frames;
+}
+
+QList<ParsedFrame> parseScanner(uint8_t channel, const QByteArray& stream, qsizetype chunkSize)
+{
+    QList<ParsedFrame> frames;
+    const QByteArrayView view(stream);
+    for (qsizetype offset = 0; offset < view.size(); offset += chunkSize) {
+        MAVLinkFrameScanner scanner(channel, view.sliced(offset, qMin(chunkSize, view.size() - offset)));
+        while (scanner.next()) {
+            frames.append(toParsedFrame(scanner.framing(), scanner.isV1(), scanner.message()));
+        }
+    }
+    return frames;
+}
+
+void compareChannelStatus(uint8_t actualChannel, uint8_t expectedChannel)
+{
+    const mavlink_status_t* const actual = mavlink_get_channel_status(actualChannel);
+    const mavlink_status_t* const expected = mavlink_get_channel_status(expectedChannel);
+    QCOMPARE(actual->packet_rx_success_count, expected->packet_rx_success_count);
+    QCOMPARE(actual->current_rx_seq, expected->current_rx_seq);
+    QCOMPARE(static_cast<int>(actual->parse_state), static_cast<int>(expected->parse_state));
+    QCOMPARE(actual->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1, expected->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1);
+}
+
+}  // namespace
+
+void MAVLinkFrameScannerTest::init()
+{
+    UnitTest::init();
+
+    resetChannel(kScanChannel);
+    resetChannel(kByteChannel);
+    resetChannel(kEncodeChannel);
+    resetChannel(kUnsignedEncodeChannel);
+}
+
+void MAVLinkFrameScannerTest::cleanup()
+{
+    // Drop any signing pointers a test left behind before the SigningChannels go out of scope.
+    resetChannel(kScanChannel);
+    resetChannel(kByteChannel);
+    resetChannel(kEncodeChannel);
+    resetChannel(kUnsignedEncodeChannel);
+
+    UnitTest::cleanup();
+}
+
+void MAVLinkFrameScannerTest::_testMatchesByteParser()
+{
+    const QByteArray stream = buildMixedStream(200);
+
+    const QList<ParsedFrame> expected = parseBytewise(kByteChannel, stream);
+    QVERIFY(expected.size() > 150);
+
+    MAVLinkFrameScanner scanner(kScanChannel, stream);
+    QList<ParsedFrame> actual;
+    while (scanner.next()) {
+        actual.append(toParsedFrame(scanner.framing(), scanner.isV1(), scanner.message()));
+    }
+
+    QCOMPARE(actual.size(), expected.size());
+    QVERIFY(actual == expected);
+    compareChannelStatus(kScanChannel, kByteChannel);
+
+    // Clean frames must not have gone through the byte parser.
+    QVERIFY(scanner.fastPathFrames() > static_cast<uint32_t>(expected.size() / 2));
+    QVERIFY(scanner.bytePathBytes() < static_cast<uint32_t>(stream.size() / 2));
+}
+
+void MAVLinkFrameScannerTest::_testSplitReads_data()
+{
+    QTest::addColumn<int>("chunkSize");
+
+    QTest::newRow("1 byte") << 1;
+    QTest::newRow("3 bytes") << 3;
+    QTest::newRow("17 bytes") << 17;
+    QTest::newRow("64 bytes") << 64;
+    QTest::newRow("255 bytes") << 255;
+    QTest::newRow("4 KiB") << 4096;
+}
+
+void MAVLinkFrameScannerTest::_testSplitReads()
+{
+    QFETCH(int, chunkSize);
+
+    const QByteArray stream = buildMixedStream(100);
+
+    const QList<ParsedFrame> expected = parseBytewise(kByteChannel, stream);
+    const QList<ParsedFrame> actual = parseScanner(kScanChannel, stream, chunkSize);
+
+    QCOMPARE(actual.size(), expected.size());
+    QVERIFY(actual == expected);
+    compareChannelStatus(kScanChannel, kByteChannel);
+}
+
+void MAVLinkFrameScannerTest::_testBadCrcResync()
+{
+    QByteArray corrupt;
+    appendAttitude(corrupt, kEncodeChannel, 1);
+    corrupt[MAVLINK_NUM_HEADER_BYTES] = static_cast<char>(corrupt.at(MAVLINK_NUM_HEADER_BYTES) ^ 0xFF);
+
+    QByteArray stream = corrupt;
+    appendHeartbeat(stream, kEncodeChannel);
+    appendAttitude(stream, kEncodeChannel, 2);
+
+    MAVLinkFrameScanner scanner(kScanChannel, stream);
+    QVERIFY(scanner.next());
+    QCOMPARE(scanner.message().msgid, static_cast<uint32_t>(MAVLINK_MSG_ID_HEARTBEAT));
+    QVERIFY(scanner.next());
+    QCOMPARE(scanner.message().msgid, static_cast<uint32_t>(MAVLINK_MSG_ID_ATTITUDE));
+    QVERIFY(!scanner.next());
+
+    (void) parseBytewise(kByteChannel, stream);
+    compareChannelStatus(kScanChannel, kByteChannel);
+}
+
+void MAVLinkFrameScannerTest::_testTruncatedPayloadZeroFilled()
+{
+    // The trailing zero yawspeed is trimmed on the wire; a stale value from the previous frame must not leak.
+    QByteArray stream;
+    appendAttitude(stream, kEncodeChannel, 1, 9.0f);
+    appendAttitude(stream, kEncodeChannel, 2, 0.0f);
+
+    MAVLinkFrameScanner scanner(kScanChannel, stream);
+    QVERIFY(scanner.next());
+    QVERIFY(scanner.next());
+    QVERIFY(scanner.message().len < MAVLINK_MSG_ID_ATTITUDE_LEN);
+
+    mavlink_attitude_t attitude{};
+    mavlink_msg_attitude_decode(&scanner.message(), &attitude);
+    QCOMPARE(attitude.time_boot_ms, 2u);
+    QCOMPARE(attitude.yawspeed, 0.0f);
+    QCOMPARE(scanner.fastPathFrames(), 2u);
+}
+
+void MAVLinkFrameScannerTest::_testSignedFrames()
+{
+    const QByteArray key(MAVLinkSigning::kSigningKeySize, '\x5a');
+
+    // Receivers first so the sender's timestamps are never older than theirs.
+    SigningChannel scanSigning;
+    SigningChannel byteSigning;
+    SigningChannel sendSigning;
+    QVERIFY(scanSigning.init(static_cast<mavlink_channel_t>(kScanChannel), key,
+                             MAVLinkSigning::secureConnectionAcceptUnsignedCallback));
+    QVERIFY(byteSigning.init(static_cast<mavlink_channel_t>(kByteChannel), key,
+                             MAVLinkSigning::secureConnectionAcceptUnsignedCallback));
+    QVERIFY(sendSigning.init(static_cast<mavlink_channel_t>(kEncodeChannel), key,
+                             MAVLinkSigning::insecureConnectionAcceptUnsignedCallback));
+
+    QByteArray stream;
+    appendHeartbeat(stream, kEncodeChannel);
+    appendAttitude(stream, kEncodeChannel, 1);
+    // Unsigned data message: rejected by the strict policy.
+    appendAttitude(stream, kUnsignedEncodeChannel, 2);
+    // Tampered signature: CRC still passes, signature does not.
+    QByteArray tampered;
+    appendAttitude(tampered, kEncodeChannel, 3);
+    tampered[tampered.size() - 1] = static_cast<char>(tampered.back() ^ 0x01);
+    stream.append(tampered);
+    appendAttitude(stream, kEncodeChannel, 4);
+
+    const QList<ParsedFrame> expected = parseBytewise(kByteChannel, stream);
+    const QList<ParsedFrame> actual = parseScanner(kScanChannel, stream, stream.size());
+
+    QCOMPARE(actual.size(), expected.size());
+    QVERIFY(actual == expected);
+    compareChannelStatus(kScanChannel, kByteChannel);
+
+    const qsizetype okCount = std::count_if(actual.cbegin(), actual.cend(),
+                                            [](const ParsedFrame& frame) { return frame.framing == MAVLINK_FRAMING_OK; });
+    QCOMPARE(okCount, qsizetype(3));
+
+    QVERIFY(sendSigning.init(static_cast<mavlink_channel_t>(kEncodeChannel), QByteArrayView(), nullptr));
+    QVERIFY(byteSigning.init(static_cast<mavlink_channel_t>(kByteChannel), QByteArrayView(), nullptr));
+    QVERIFY(scanSigning.init(static_cast<mavlink_channel_t>(kScanChannel), QByteArrayView(), nullptr));
+}
+
+void MAVLinkFrameScannerTest::_benchmarkScannerVsByteParser()
+{
+    QByteArray stream;
+    for (int i = 0; i < 1000; ++i) {
+        appendAttitude(stream, kEncodeChannel, static_cast<uint32_t>(i));
+        if ((i % 10) == 0) {
+            appendHeartbeat(stream, kEncodeChannel);
+        }
+    }
+
+    auto bench = qgc::bench::ciConfig();
+    bench.relative(true).unit("byte").batch(stream.size());
+
+    bench.run("mavlink_parse_char", [&] {
+        mavlink_message_t message{};
+        mavlink_status_t status{};
+        uint32_t frames = 0;
+        for (const char byte : stream) {
+            if (mavlink_parse_char(kByteChannel, static_cast<uint8_t>(byte), &message, &status) == MAVLINK_FRAMING_OK) {
+                ++frames;
+            }
+        }
+        ankerl::nanobench::doNotOptimizeAway(frames);
+    });
+
+    bench.run("MAVLinkFrameScanner", [&] {
+        MAVLinkFrameScanner scanner(kScanChannel, stream);
+        uint32_t frames = 0;
+        while (scanner.next()) {
+            ++frames;
+        }
+        ankerl::nanobench::doNotOptimizeAway(frames);
+    });
+}
+
+UT_REGISTER_TEST(MAVLinkFrameScannerTest, TestLabel::Unit)
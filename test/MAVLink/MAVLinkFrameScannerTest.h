@@ -0,0 +1,26 @@
+#pragma once
+
+#include "UnitTest.h"
+
+/// Unit tests for MAVLinkFrameScanner.
+///
+/// Every case compares the scanner against libmavlink's per-byte parser fed the same stream on a separate
+/// channel: the frames reported, their framing result and the channel rx counters must match exactly.
+class MAVLinkFrameScannerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init() override;
+    void cleanup() override;
+
+    void _testMatchesByteParser();
+    void _testSplitReads_data();
+    void _testSplitReads();
+    void _testBadCrcResync();
+    void _testTruncatedPayloadZeroFilled();
+    void _testSignedFrames();
+
+    // Benchmarks (nanobench)
+    void _benchmarkScannerVsByteParser();
+};
@@ -7,6 +7,8 @@
 #include <QtTest/QSignalSpy>
 #include <QtTest/QTest>
 
+#include "Benchmarking.h"
+#include "MAVLinkFrameScanner.h"
 #include "MAVLinkLib.h"
 #include "MAVLinkSigning.h"
 #include "MAVLinkSigningKeys.h"
@@ -615,4 +617,69 @@ void SigningControllerTest::_testWallClockTimerStoppedWhenIdle()
     QCOMPARE(ctrl.state(), SigningController::State::Off);
 }
 
+void SigningControllerTest::_benchmarkSignedVsUnsignedReceive()
+{
+    constexpr mavlink_channel_t kEncodeChannel = MAVLINK_COMM_6;
+    constexpr mavlink_channel_t kSignedChannel = MAVLINK_COMM_7;
+    constexpr mavlink_channel_t kUnsignedChannel = MAVLINK_COMM_8;
+    constexpr int kFrames = 1000;
+
+    const auto key = makeKey(0x5A);
+    const QByteArrayView keyView(reinterpret_cast<const char*>(key.data()), key.size());
+
+    const auto encode = [](QByteArray& stream) {
+        for (int i = 0; i < kFrames; ++i) {
+            mavlink_message_t message;
+            (void)mavlink_msg_attitude_pack_chan(1, MAV_COMP_ID_AUTOPILOT1, kEncodeChannel, &message,
+                                                 static_cast<uint32_t>(i), 0, 0, 0, 0, 0, 0);
+            uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+            const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+            (void)stream.append(reinterpret_cast<const char*>(buffer), len);
+        }
+    };
+
+    QByteArray unsignedStream;
+    encode(unsignedStream);
+    QByteArray signedStream;
+    {
+        SigningController sender(kEncodeChannel);
+        QVERIFY(sender.initSigningImmediate(keyView, MAVLinkSigning::UnsignedAcceptancePolicy::Strict));
+        encode(signedStream);
+        (void)sender.clearSigning();
+    }
+
+    SigningController unsignedRx(kUnsignedChannel);
+    SigningController signedRx(kSignedChannel);
+
+    // Each pass replays the same timestamps, so the signed receiver starts from a fresh stream table every time
+    const auto receive = [](SigningController& ctrl, mavlink_channel_t channel, const QByteArray& stream) {
+        MAVLinkFrameScanner scanner(channel, stream);
+        int ok = 0;
+        while (scanner.next()) {
+            const bool framingOk = (scanner.framing() == MAVLINK_FRAMING_OK);
+            (void)ctrl.processFrame(framingOk, scanner.message());
+            ok += framingOk ? 1 : 0;
+        }
+        return ok;
+    };
+
+    QVERIFY(signedRx.initSigningImmediate(keyView, MAVLinkSigning::UnsignedAcceptancePolicy::Strict));
+    QCOMPARE(receive(signedRx, kSignedChannel, signedStream), kFrames);
+    QCOMPARE(receive(unsignedRx, kUnsignedChannel, unsignedStream), kFrames);
+
+    auto bench = qgc::bench::ciConfig();
+    bench.relative(true).unit("frame").batch(kFrames);
+
+    bench.run("unsigned receive", [&] {
+        ankerl::nanobench::doNotOptimizeAway(receive(unsignedRx, kUnsignedChannel, unsignedStream));
+    });
+
+    bench.run("signed receive", [&] {
+        (void)signedRx.initSigningImmediate(keyView, MAVLinkSigning::UnsignedAcceptancePolicy::Strict);
+        ankerl::nanobench::doNotOptimizeAway(receive(signedRx, kSignedChannel, signedStream));
+    });
+
+    (void)signedRx.clearSigning();
+}
+
 UT_REGISTER_TEST(SigningControllerTest, TestLabel::Unit, TestLabel::Comms, TestLabel::Slow)
@@ -40,4 +40,5 @@ private slots:
     void _testExpectedSysIdScopedToPendingOp();
     void _testWallClockTimerRefreshesAfterEnable();
     void _testWallClockTimerStoppedWhenIdle();
+    void _benchmarkSignedVsUnsignedReceive();
 };
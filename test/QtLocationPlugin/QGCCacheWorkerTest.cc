@@ -11,6 +11,11 @@
 
 static const QString kTestProviderType = QStringLiteral("Bing Road");
 
+static quint64 testKey(int x, int y = 0)
+{
+    return UrlFactory::getTileKey(kTestProviderType, x, y, 1);
+}
+
 void QGCCacheWorkerTest::initTestCase()
 {
     UnitTest::initTestCase();
@@ -57,7 +62,7 @@ void QGCCacheWorkerTest::_testEnqueueBeforeInit()
     QGCCacheWorker worker;
     worker.setDatabaseFile(tempDir.filePath("pre_init.db"));
 
-    auto* task = new QGCFetchTileTask(QStringLiteral("hash"));
+    auto* task = new QGCFetchTileTask(testKey(0));
     bool errorReceived = false;
     connect(task, &QGCMapTask::error, this, [&](QGCMapTask::TaskType, const QString&) { errorReceived = true; });
     QVERIFY(!worker.enqueueTask(task));
@@ -99,11 +104,11 @@ void QGCCacheWorkerTest::_testSaveAndFetchTile()
     QVERIFY(_startWorker(worker));
 
     auto* tile =
-        new QGCCacheTile(QStringLiteral("h1"), QByteArray("tile_data"), QStringLiteral("png"), kTestProviderType);
+        new QGCCacheTile(testKey(1), QByteArray("tile_data"), QStringLiteral("png"), kTestProviderType);
     QVERIFY(worker.enqueueTask(new QGCSaveTileTask(tile)));
 
     // Fetch — FIFO guarantees save completes first
-    auto* fetchTask = new QGCFetchTileTask(QStringLiteral("h1"));
+    auto* fetchTask = new QGCFetchTileTask(testKey(1));
     QGCCacheTile* fetched = nullptr;
     bool fetchError = false;
     connect(
@@ -117,7 +122,7 @@ void QGCCacheWorkerTest::_testSaveAndFetchTile()
 
     QVERIFY2(fetched != nullptr, "Expected tile to be fetched");
     QVERIFY(!fetchError);
-    QCOMPARE(fetched->hash, QStringLiteral("h1"));
+    QCOMPARE(fetched->key, testKey(1));
     QCOMPARE(fetched->img, QByteArray("tile_data"));
     QCOMPARE(fetched->format, QStringLiteral("png"));
     delete fetched;
@@ -126,6 +131,157 @@ void QGCCacheWorkerTest::_testSaveAndFetchTile()
     worker.wait(TestTimeout::mediumMs());
 }
 
+void QGCCacheWorkerTest::_testSaveManyTiles()
+{
+    QTemporaryDir tempDir;
+    QGCCacheWorker worker;
+    worker.setDatabaseFile(tempDir.filePath("save_many.db"));
+    QVERIFY(_startWorker(worker));
+
+    // More than one save batch, then a fetch that must not overtake them
+    constexpr int kTiles = 600;
+    int saveErrors = 0;
+    for (int i = 0; i < kTiles; i++) {
+        auto* tile = new QGCCacheTile(testKey(i, 1), QByteArray(64, 'M'), QStringLiteral("png"),
+                                      kTestProviderType);
+        auto* saveTask = new QGCSaveTileTask(tile);
+        connect(
+            saveTask, &QGCMapTask::error, this, [&](QGCMapTask::TaskType, const QString&) { saveErrors++; },
+            Qt::QueuedConnection);
+        QVERIFY(worker.enqueueTask(saveTask));
+    }
+
+    auto* fetchTask = new QGCFetchTileTask(testKey(kTiles - 1, 1));
+    QGCCacheTile* fetched = nullptr;
+    bool fetchError = false;
+    connect(
+        fetchTask, &QGCFetchTileTask::tileFetched, this, [&](QGCCacheTile* t) { fetched = t; }, Qt::QueuedConnection);
+    connect(
+        fetchTask, &QGCMapTask::error, this, [&](QGCMapTask::TaskType, const QString&) { fetchError = true; },
+        Qt::QueuedConnection);
+    QVERIFY(worker.enqueueTask(fetchTask));
+    QTRY_VERIFY_WITH_TIMEOUT(fetched || fetchError, TestTimeout::mediumMs());
+
+    QVERIFY(fetched != nullptr);
+    delete fetched;
+
+    quint32 total = 0;
+    auto conn = connect(
+        &worker, &QGCCacheWorker::updateTotals, this,
+        [&](quint32 tiles, quint64, quint32, quint64) { total = tiles; }, Qt::QueuedConnection);
+    QVERIFY(worker.enqueueTask(new QGCMapTask(QGCMapTask::TaskType::taskInit)));
+    QTRY_COMPARE_WITH_TIMEOUT(total, quint32(kTiles), TestTimeout::mediumMs());
+    disconnect(conn);
+    QCOMPARE(saveErrors, 0);
+
+    worker.stop();
+    worker.wait(TestTimeout::mediumMs());
+}
+
+void QGCCacheWorkerTest::_testFetchAlongsideWrites()
+{
+    QTemporaryDir tempDir;
+    QGCCacheWorker worker;
+    worker.setDatabaseFile(tempDir.filePath("fetch_writes.db"));
+    QVERIFY(_startWorker(worker));
+
+    constexpr int kCached = 16;
+    for (int i = 0; i < kCached; i++) {
+        auto* tile = new QGCCacheTile(testKey(i, 2), QByteArray(64, 'C'), QStringLiteral("png"),
+                                      kTestProviderType);
+        QVERIFY(worker.enqueueTask(new QGCSaveTileTask(tile)));
+    }
+
+    // Lookups resolve whether a reader or the writer (for a save still queued) serves them
+    for (int i = 0; i < 200; i++) {
+        auto* tile = new QGCCacheTile(testKey(i, 3), QByteArray(64, 'B'), QStringLiteral("png"),
+                                      kTestProviderType);
+        QVERIFY(worker.enqueueTask(new QGCSaveTileTask(tile)));
+    }
+
+    int fetched = 0;
+    int fetchErrors = 0;
+    for (int i = 0; i < kCached; i++) {
+        auto* fetchTask = new QGCFetchTileTask(testKey(i, 2));
+        connect(
+            fetchTask, &QGCFetchTileTask::tileFetched, this,
+            [&](QGCCacheTile* t) {
+                fetched++;
+                delete t;
+            },
+            Qt::QueuedConnection);
+        connect(
+            fetchTask, &QGCMapTask::error, this, [&](QGCMapTask::TaskType, const QString&) { fetchErrors++; },
+            Qt::QueuedConnection);
+        QVERIFY(worker.enqueueTask(fetchTask));
+    }
+    QTRY_COMPARE_WITH_TIMEOUT(fetched + fetchErrors, kCached, TestTimeout::mediumMs());
+    QCOMPARE(fetchErrors, 0);
+
+    // Readers give up their connections for a reset and see the empty cache afterwards
+    auto* resetTask = new QGCResetTask();
+    bool resetDone = false;
+    connect(resetTask, &QGCResetTask::resetCompleted, this, [&]() { resetDone = true; }, Qt::QueuedConnection);
+    QVERIFY(worker.enqueueTask(resetTask));
+    QTRY_VERIFY_WITH_TIMEOUT(resetDone, TestTimeout::mediumMs());
+
+    auto* fetchTask = new QGCFetchTileTask(testKey(0, 2));
+    bool fetchError = false;
+    connect(
+        fetchTask, &QGCMapTask::error, this, [&](QGCMapTask::TaskType, const QString&) { fetchError = true; },
+        Qt::QueuedConnection);
+    QVERIFY(worker.enqueueTask(fetchTask));
+    QTRY_VERIFY_WITH_TIMEOUT(fetchError, TestTimeout::mediumMs());
+
+    worker.stop();
+    QVERIFY(worker.wait(TestTimeout::mediumMs()));
+}
+
+void QGCCacheWorkerTest::_testLowPriorityFetch()
+{
+    QTemporaryDir tempDir;
+    QGCCacheWorker worker;
+    worker.setDatabaseFile(tempDir.filePath("low_priority.db"));
+    QVERIFY(_startWorker(worker));
+
+    constexpr int kCached = 16;
+    for (int i = 0; i < kCached; i++) {
+        auto* tile = new QGCCacheTile(testKey(i, 4), QByteArray(64, 'L'), QStringLiteral("png"),
+                                      kTestProviderType);
+        QVERIFY(worker.enqueueTask(new QGCSaveTileTask(tile)));
+    }
+
+    // Prefetch lookups share the readers with the map's lookups and resolve either way
+    int fetched = 0;
+    int lowPriorityFetched = 0;
+    int fetchErrors = 0;
+    for (int i = 0; i < kCached; i++) {
+        const bool lowPriority = (i % 2) == 0;
+        auto* fetchTask = new QGCFetchTileTask(testKey(i, 4), lowPriority);
+        QCOMPARE(fetchTask->lowPriority(), lowPriority);
+        connect(
+            fetchTask, &QGCFetchTileTask::tileFetched, this,
+            [&, lowPriority](QGCCacheTile* t) {
+                fetched++;
+                if (lowPriority) {
+                    lowPriorityFetched++;
+                }
+                delete t;
+            },
+            Qt::QueuedConnection);
+        connect(
+            fetchTask, &QGCMapTask::error, this, [&](QGCMapTask::TaskType, const QString&) { fetchErrors++; },
+            Qt::QueuedConnection);
+        QVERIFY(worker.enqueueTask(fetchTask));
+    }
+    QTRY_COMPARE_WITH_TIMEOUT(fetched + fetchErrors, kCached, TestTimeout::mediumMs());
+    QCOMPARE(fetchErrors, 0);
+    QCOMPARE(lowPriorityFetched, kCached / 2);
+
+    worker.stop();
+    QVERIFY(worker.wait(TestTimeout::mediumMs()));
+}
+
 void QGCCacheWorkerTest::_testFetchTileNotFound()
 {
     QTemporaryDir tempDir;
@@ -133,7 +289,7 @@ void QGCCacheWorkerTest::_testFetchTileNotFound()
     worker.setDatabaseFile(tempDir.filePath("not_found.db"));
     QVERIFY(_startWorker(worker));
 
-    auto* fetchTask = new QGCFetchTileTask(QStringLiteral("nonexistent"));
+    auto* fetchTask = new QGCFetchTileTask(testKey(2));
     QGCCacheTile* fetched = nullptr;
     bool fetchError = false;
     connect(
@@ -243,7 +399,7 @@ void QGCCacheWorkerTest::_testPruneCache()
     QVERIFY(_startWorker(worker));
 
     for (int i = 0; i < 10; i++) {
-        auto* tile = new QGCCacheTile(QStringLiteral("pr_%1").arg(i), QByteArray(100, 'P'), QStringLiteral("png"),
+        auto* tile = new QGCCacheTile(testKey(i, 4), QByteArray(100, 'P'), QStringLiteral("png"),
                                       kTestProviderType);
         QVERIFY(worker.enqueueTask(new QGCSaveTileTask(tile)));
     }
@@ -277,7 +433,7 @@ void QGCCacheWorkerTest::_testResetDatabase()
     worker.setDatabaseFile(tempDir.filePath("reset.db"));
     QVERIFY(_startWorker(worker));
 
-    auto* tile = new QGCCacheTile(QStringLiteral("r1"), QByteArray("data"), QStringLiteral("png"), kTestProviderType);
+    auto* tile = new QGCCacheTile(testKey(3), QByteArray("data"), QStringLiteral("png"), kTestProviderType);
     QVERIFY(worker.enqueueTask(new QGCSaveTileTask(tile)));
 
     auto* resetTask = new QGCResetTask();
@@ -287,7 +443,7 @@ void QGCCacheWorkerTest::_testResetDatabase()
     QTRY_VERIFY_WITH_TIMEOUT(resetDone, TestTimeout::mediumMs());
 
     // Verify saved tile is gone
-    auto* fetchTask = new QGCFetchTileTask(QStringLiteral("r1"));
+    auto* fetchTask = new QGCFetchTileTask(testKey(3));
     bool fetchError = false;
     connect(
         fetchTask, &QGCMapTask::error, this, [&](QGCMapTask::TaskType, const QString&) { fetchError = true; },
@@ -309,7 +465,7 @@ void QGCCacheWorkerTest::_testStopWhileProcessing()
     QVERIFY(_startWorker(worker));
 
     for (int i = 0; i < 100; i++) {
-        auto* tile = new QGCCacheTile(QStringLiteral("stop_%1").arg(i), QByteArray(50, 'S'), QStringLiteral("png"),
+        auto* tile = new QGCCacheTile(testKey(i, 5), QByteArray(50, 'S'), QStringLiteral("png"),
                                       kTestProviderType);
         worker.enqueueTask(new QGCSaveTileTask(tile));
     }
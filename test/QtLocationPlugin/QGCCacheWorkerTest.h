@@ -14,6 +14,9 @@ private slots:
     void _testEnqueueBeforeInit();
     void _testUpdateTotalsOnInit();
     void _testSaveAndFetchTile();
+    void _testSaveManyTiles();
+    void _testFetchAlongsideWrites();
+    void _testLowPriorityFetch();
     void _testFetchTileNotFound();
     void _testFetchTileSets();
     void _testCreateAndDeleteTileSet();
@@ -1,4 +1,5 @@
 #include "QGCTileCacheDatabaseTest.h"
+#include "Benchmarking.h"
 
 #include <QtCore/QDateTime>
 #include <QtCore/QFile>
@@ -11,10 +12,16 @@
 #include "QGCMapUrlEngine.h"
 #include "QGCTile.h"
 #include "QGCTileCacheDatabase.h"
+#include "QGCTileKey.h"
 #include <QtCore/QTemporaryDir>
 
 static const QString kFixedProviderType = QStringLiteral("Bing Road");
 
+static quint64 testKey(int x)
+{
+    return UrlFactory::getTileKey(kFixedProviderType, x, 0, 1);
+}
+
 std::unique_ptr<QGCTileCacheDatabase> QGCTileCacheDatabaseTest::_createInitializedDB(QTemporaryDir &tempDir)
 {
     auto db = std::make_unique<QGCTileCacheDatabase>(tempDir.filePath("tiles.db"));
@@ -34,14 +41,13 @@ void QGCTileCacheDatabaseTest::_insertTileSet(QGCTileCacheDatabase* db, const QS
     outSetID = query.lastInsertId().toULongLong();
 }
 
-void QGCTileCacheDatabaseTest::_insertDownloadRecord(QGCTileCacheDatabase* db, quint64 setID, const QString& hash,
-                                                     int state)
+void QGCTileCacheDatabaseTest::_insertDownloadRecord(QGCTileCacheDatabase* db, quint64 setID, quint64 key, int state)
 {
     QSqlQuery query(db->database());
     QVERIFY(query.prepare(
-        "INSERT OR IGNORE INTO TilesDownload(setID, hash, type, x, y, z, state) VALUES(?, ?, ?, ?, ?, ?, ?)"));
+        "INSERT OR IGNORE INTO TilesDownload(setID, tileKey, type, x, y, z, state) VALUES(?, ?, ?, ?, ?, ?, ?)"));
     query.addBindValue(setID);
-    query.addBindValue(hash);
+    query.addBindValue(key);
     query.addBindValue(0);
     query.addBindValue(0);
     query.addBindValue(0);
@@ -50,6 +56,49 @@ void QGCTileCacheDatabaseTest::_insertDownloadRecord(QGCTileCacheDatabase* db, q
     QVERIFY(query.exec());
 }
 
+void QGCTileCacheDatabaseTest::_createVersion1DB(const QString& path)
+{
+    // Schema version 1 as shipped: tiles keyed by "%010d%08d%08d%03d" (provider, x, y, zoom) TEXT hashes
+    const QString tileHash = QString::asprintf("%010d%08d%08d%03d",
+                                               UrlFactory::hashFromProviderType(kFixedProviderType), 5, 7, 3);
+    const QString downloadHash = QString::asprintf("%010d%08d%08d%03d",
+                                                   UrlFactory::hashFromProviderType(kFixedProviderType), 6, 7, 3);
+    {
+        QSqlDatabase v1 = QSqlDatabase::addDatabase("QSQLITE", "v1_setup");
+        v1.setDatabaseName(path);
+        QVERIFY(v1.open());
+        QSqlQuery q(v1);
+        QVERIFY(q.exec("CREATE TABLE Tiles (tileID INTEGER PRIMARY KEY NOT NULL, hash TEXT NOT NULL UNIQUE, format "
+                       "TEXT NOT NULL, tile BLOB NULL, size INTEGER, type INTEGER, date INTEGER DEFAULT 0)"));
+        QVERIFY(q.exec("CREATE TABLE TileSets (setID INTEGER PRIMARY KEY NOT NULL, name TEXT NOT NULL UNIQUE, typeStr "
+                       "TEXT, topleftLat REAL DEFAULT 0.0, topleftLon REAL DEFAULT 0.0, bottomRightLat REAL DEFAULT "
+                       "0.0, bottomRightLon REAL DEFAULT 0.0, minZoom INTEGER DEFAULT 3, maxZoom INTEGER DEFAULT 3, "
+                       "type INTEGER DEFAULT -1, numTiles INTEGER DEFAULT 0, defaultSet INTEGER DEFAULT 0, date "
+                       "INTEGER DEFAULT 0)"));
+        QVERIFY(q.exec("CREATE TABLE SetTiles (setID INTEGER NOT NULL REFERENCES TileSets(setID) ON DELETE CASCADE, "
+                       "tileID INTEGER NOT NULL REFERENCES Tiles(tileID) ON DELETE CASCADE)"));
+        QVERIFY(q.exec("CREATE TABLE TilesDownload (setID INTEGER NOT NULL REFERENCES TileSets(setID) ON DELETE "
+                       "CASCADE, hash TEXT NOT NULL, type INTEGER, x INTEGER, y INTEGER, z INTEGER, state INTEGER "
+                       "DEFAULT 0)"));
+        QVERIFY(q.exec("CREATE UNIQUE INDEX idx_tilesdownload_setid_hash ON TilesDownload(setID, hash)"));
+        QVERIFY(q.exec("INSERT INTO TileSets(name, defaultSet, date) VALUES('Default Tile Set', 1, 0)"));
+        QVERIFY(q.exec("INSERT INTO TileSets(name, typeStr, numTiles, date) VALUES('V1 Set', 'Bing Road', 2, 0)"));
+        QVERIFY(q.prepare("INSERT INTO Tiles(tileID, hash, format, tile, size, type, date) VALUES(42, ?, 'png', ?, 4, ?, 0)"));
+        q.addBindValue(tileHash);
+        q.addBindValue(QByteArray("v1v1"));
+        q.addBindValue(UrlFactory::getQtMapIdFromProviderType(kFixedProviderType));
+        QVERIFY(q.exec());
+        QVERIFY(q.exec("INSERT INTO SetTiles(setID, tileID) VALUES(2, 42)"));
+        QVERIFY(q.prepare("INSERT INTO TilesDownload(setID, hash, type, x, y, z, state) VALUES(2, ?, ?, 6, 7, 3, 0)"));
+        q.addBindValue(downloadHash);
+        q.addBindValue(UrlFactory::getQtMapIdFromProviderType(kFixedProviderType));
+        QVERIFY(q.exec());
+        QVERIFY(q.exec("PRAGMA user_version = 1"));
+        v1.close();
+    }
+    QSqlDatabase::removeDatabase("v1_setup");
+}
+
 void QGCTileCacheDatabaseTest::_testInitWithValidPath()
 {
     QTemporaryDir tempDir;
@@ -107,16 +156,16 @@ void QGCTileCacheDatabaseTest::_testSaveTileAndGetTile()
     QTemporaryDir tempDir;
     auto db = _createInitializedDB(tempDir);
 
-    const QString hash = QStringLiteral("test_hash_1234");
+    const quint64 key = testKey(1);
     const QString format = QStringLiteral("png");
     const QByteArray img("fake_tile_data_bytes");
     QVERIFY(UrlFactory::getQtMapIdFromProviderType(kFixedProviderType) != -1);
 
-    QVERIFY(db->saveTile(hash, format, img, kFixedProviderType, QGCTileCacheDatabase::kInvalidTileSet));
+    QVERIFY(db->saveTile(key, format, img, kFixedProviderType, QGCTileCacheDatabase::kInvalidTileSet));
 
-    auto tile = db->getTile(hash);
+    auto tile = db->getTile(key);
     QVERIFY(tile != nullptr);
-    QCOMPARE(tile->hash, hash);
+    QCOMPARE(tile->key, key);
     QCOMPARE(tile->format, format);
     QCOMPARE(tile->img, img);
     QCOMPARE(tile->type, kFixedProviderType);
@@ -126,7 +175,7 @@ void QGCTileCacheDatabaseTest::_testGetTileNotFound()
 {
     QTemporaryDir tempDir;
     auto db = _createInitializedDB(tempDir);
-    auto tile = db->getTile(QStringLiteral("nonexistent_hash"));
+    auto tile = db->getTile(testKey(2));
     QVERIFY(tile == nullptr);
 }
 
@@ -135,15 +184,15 @@ void QGCTileCacheDatabaseTest::_testFindTile()
     QTemporaryDir tempDir;
     auto db = _createInitializedDB(tempDir);
 
-    const QString hash = QStringLiteral("findme_hash");
-    QVERIFY(db->saveTile(hash, QStringLiteral("png"), QByteArray("data"), kFixedProviderType,
+    const quint64 key = testKey(3);
+    QVERIFY(db->saveTile(key, QStringLiteral("png"), QByteArray("data"), kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
 
-    const auto id = db->findTile(hash);
+    const auto id = db->findTile(key);
     QVERIFY(id.has_value());
     QVERIFY(id.value() != 0);
 
-    const auto missing = db->findTile(QStringLiteral("no_such_hash"));
+    const auto missing = db->findTile(testKey(4));
     QVERIFY(!missing.has_value());
 }
 
@@ -220,14 +269,14 @@ void QGCTileCacheDatabaseTest::_testResetDatabase()
     QTemporaryDir tempDir;
     auto db = _createInitializedDB(tempDir);
 
-    QVERIFY(db->saveTile(QStringLiteral("h1"), QStringLiteral("png"), QByteArray("d1"), kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(5), QStringLiteral("png"), QByteArray("d1"), kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
-    QVERIFY(db->findTile(QStringLiteral("h1")).has_value());
+    QVERIFY(db->findTile(testKey(5)).has_value());
 
     QVERIFY(db->resetDatabase());
     QVERIFY(db->isValid());
 
-    QVERIFY(!db->findTile(QStringLiteral("h1")).has_value());
+    QVERIFY(!db->findTile(testKey(5)).has_value());
 
     const auto sets = db->getTileSets();
     QCOMPARE(sets.size(), 1);
@@ -241,9 +290,9 @@ void QGCTileCacheDatabaseTest::_testComputeTotals()
 
     const QByteArray data10(10, 'A');
     const QByteArray data20(20, 'B');
-    QVERIFY(db->saveTile(QStringLiteral("ct1"), QStringLiteral("png"), data10, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(6), QStringLiteral("png"), data10, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
-    QVERIFY(db->saveTile(QStringLiteral("ct2"), QStringLiteral("png"), data20, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(7), QStringLiteral("png"), data20, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
 
     const TotalsResult totals = db->computeTotals();
@@ -259,7 +308,7 @@ void QGCTileCacheDatabaseTest::_testComputeSetTotalsDefault()
     auto db = _createInitializedDB(tempDir);
 
     const QByteArray data(15, 'X');
-    QVERIFY(db->saveTile(QStringLiteral("sd1"), QStringLiteral("png"), data, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(8), QStringLiteral("png"), data, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
 
     const auto defaultSetID = db->findTileSetID(QStringLiteral("Default Tile Set"));
@@ -276,17 +325,17 @@ void QGCTileCacheDatabaseTest::_testPruneCache()
     auto db = _createInitializedDB(tempDir);
 
     const QByteArray data(100, 'Z');
-    QVERIFY(db->saveTile(QStringLiteral("pr1"), QStringLiteral("png"), data, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(9), QStringLiteral("png"), data, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
-    QVERIFY(db->saveTile(QStringLiteral("pr2"), QStringLiteral("png"), data, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(10), QStringLiteral("png"), data, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
 
-    QVERIFY(db->findTile(QStringLiteral("pr1")).has_value());
+    QVERIFY(db->findTile(testKey(9)).has_value());
 
     QVERIFY(db->pruneCache(200));
 
-    QVERIFY(!db->findTile(QStringLiteral("pr1")).has_value());
-    QVERIFY(!db->findTile(QStringLiteral("pr2")).has_value());
+    QVERIFY(!db->findTile(testKey(9)).has_value());
+    QVERIFY(!db->findTile(testKey(10)).has_value());
 }
 
 void QGCTileCacheDatabaseTest::_testUpdateTileDownloadState()
@@ -297,26 +346,26 @@ void QGCTileCacheDatabaseTest::_testUpdateTileDownloadState()
     const auto defaultSetID = db->findTileSetID(QStringLiteral("Default Tile Set"));
     QVERIFY(defaultSetID.has_value());
 
-    _insertDownloadRecord(db.get(), defaultSetID.value(), QStringLiteral("dl_hash_1"), QGCTile::StatePending);
-    _insertDownloadRecord(db.get(), defaultSetID.value(), QStringLiteral("dl_hash_2"), QGCTile::StatePending);
+    _insertDownloadRecord(db.get(), defaultSetID.value(), testKey(11), QGCTile::StatePending);
+    _insertDownloadRecord(db.get(), defaultSetID.value(), testKey(12), QGCTile::StatePending);
 
-    QVERIFY(db->updateTileDownloadState(defaultSetID.value(), QGCTile::StateDownloading, QStringLiteral("dl_hash_1")));
+    QVERIFY(db->updateTileDownloadState(defaultSetID.value(), QGCTile::StateDownloading, testKey(11)));
 
     {
         QSqlQuery query(db->database());
-        QVERIFY(query.prepare(QStringLiteral("SELECT state FROM TilesDownload WHERE hash = ?")));
-        query.addBindValue(QStringLiteral("dl_hash_1"));
+        QVERIFY(query.prepare(QStringLiteral("SELECT state FROM TilesDownload WHERE tileKey = ?")));
+        query.addBindValue(testKey(11));
         QVERIFY(query.exec());
         QVERIFY(query.next());
         QCOMPARE(query.value(0).toInt(), static_cast<int>(QGCTile::StateDownloading));
     }
 
-    QVERIFY(db->updateTileDownloadState(defaultSetID.value(), QGCTile::StateComplete, QStringLiteral("dl_hash_1")));
+    QVERIFY(db->updateTileDownloadState(defaultSetID.value(), QGCTile::StateComplete, testKey(11)));
 
     {
         QSqlQuery query(db->database());
-        QVERIFY(query.prepare(QStringLiteral("SELECT COUNT(*) FROM TilesDownload WHERE hash = ?")));
-        query.addBindValue(QStringLiteral("dl_hash_1"));
+        QVERIFY(query.prepare(QStringLiteral("SELECT COUNT(*) FROM TilesDownload WHERE tileKey = ?")));
+        query.addBindValue(testKey(11));
         QVERIFY(query.exec());
         QVERIFY(query.next());
         QCOMPARE(query.value(0).toInt(), 0);
@@ -326,8 +375,8 @@ void QGCTileCacheDatabaseTest::_testUpdateTileDownloadState()
 
     {
         QSqlQuery query(db->database());
-        QVERIFY(query.prepare(QStringLiteral("SELECT state FROM TilesDownload WHERE hash = ?")));
-        query.addBindValue(QStringLiteral("dl_hash_2"));
+        QVERIFY(query.prepare(QStringLiteral("SELECT state FROM TilesDownload WHERE tileKey = ?")));
+        query.addBindValue(testKey(12));
         QVERIFY(query.exec());
         QVERIFY(query.next());
         QCOMPARE(query.value(0).toInt(), static_cast<int>(QGCTile::StateError));
@@ -340,9 +389,9 @@ void QGCTileCacheDatabaseTest::_testExportImportReplace()
     auto db = _createInitializedDB(tempDir);
 
     const QByteArray data(50, 'E');
-    QVERIFY(db->saveTile(QStringLiteral("exp1"), QStringLiteral("png"), data, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(13), QStringLiteral("png"), data, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
-    QVERIFY(db->saveTile(QStringLiteral("exp2"), QStringLiteral("png"), data, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(14), QStringLiteral("png"), data, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
 
     const auto sets = db->getTileSets();
@@ -365,14 +414,14 @@ void QGCTileCacheDatabaseTest::_testExportImportReplace()
     QVERIFY(db2->init());
     QVERIFY(db2->connectDB());
 
-    QVERIFY(!db2->findTile(QStringLiteral("exp1")).has_value());
+    QVERIFY(!db2->findTile(testKey(13)).has_value());
 
     const DatabaseResult importResult = db2->importSetsReplace(exportPath, nullptr);
     QVERIFY(importResult.success);
     QVERIFY(db2->isValid());
 
-    QVERIFY(db2->findTile(QStringLiteral("exp1")).has_value());
-    QVERIFY(db2->findTile(QStringLiteral("exp2")).has_value());
+    QVERIFY(db2->findTile(testKey(13)).has_value());
+    QVERIFY(db2->findTile(testKey(14)).has_value());
 }
 
 void QGCTileCacheDatabaseTest::_linkTileToSet(QGCTileCacheDatabase* db, quint64 tileID, quint64 setID)
@@ -392,35 +441,35 @@ void QGCTileCacheDatabaseTest::_testGetTileDownloadList()
     const auto defaultSetID = db->findTileSetID(QStringLiteral("Default Tile Set"));
     QVERIFY(defaultSetID.has_value());
 
-    _insertDownloadRecord(db.get(), defaultSetID.value(), QStringLiteral("dl_a"), QGCTile::StatePending);
-    _insertDownloadRecord(db.get(), defaultSetID.value(), QStringLiteral("dl_b"), QGCTile::StatePending);
-    _insertDownloadRecord(db.get(), defaultSetID.value(), QStringLiteral("dl_c"), QGCTile::StatePending);
+    _insertDownloadRecord(db.get(), defaultSetID.value(), testKey(15), QGCTile::StatePending);
+    _insertDownloadRecord(db.get(), defaultSetID.value(), testKey(16), QGCTile::StatePending);
+    _insertDownloadRecord(db.get(), defaultSetID.value(), testKey(17), QGCTile::StatePending);
 
     const QList<QGCTile> tiles = db->getTileDownloadList(defaultSetID.value(), 2);
     QCOMPARE(tiles.size(), 2);
 
-    QStringList hashes;
+    QList<quint64> keys;
     for (const auto& t : tiles) {
-        hashes.append(t.hash);
+        keys.append(t.key);
     }
-    QVERIFY(hashes.contains(QStringLiteral("dl_a")));
-    QVERIFY(hashes.contains(QStringLiteral("dl_b")));
+    QVERIFY(keys.contains(testKey(15)));
+    QVERIFY(keys.contains(testKey(16)));
 
     {
         QSqlQuery query(db->database());
-        QVERIFY(query.exec(QStringLiteral("SELECT state FROM TilesDownload WHERE hash = 'dl_a'")));
+        QVERIFY(query.exec(QStringLiteral("SELECT state FROM TilesDownload WHERE tileKey = %1").arg(testKey(15))));
         QVERIFY(query.next());
         QCOMPARE(query.value(0).toInt(), static_cast<int>(QGCTile::StateDownloading));
     }
     {
         QSqlQuery query(db->database());
-        QVERIFY(query.exec(QStringLiteral("SELECT state FROM TilesDownload WHERE hash = 'dl_b'")));
+        QVERIFY(query.exec(QStringLiteral("SELECT state FROM TilesDownload WHERE tileKey = %1").arg(testKey(16))));
         QVERIFY(query.next());
         QCOMPARE(query.value(0).toInt(), static_cast<int>(QGCTile::StateDownloading));
     }
     {
         QSqlQuery query(db->database());
-        QVERIFY(query.exec(QStringLiteral("SELECT state FROM TilesDownload WHERE hash = 'dl_c'")));
+        QVERIFY(query.exec(QStringLiteral("SELECT state FROM TilesDownload WHERE tileKey = %1").arg(testKey(17))));
         QVERIFY(query.next());
         QCOMPARE(query.value(0).toInt(), static_cast<int>(QGCTile::StatePending));
     }
@@ -432,9 +481,9 @@ void QGCTileCacheDatabaseTest::_testImportSetsMerge()
     auto dbSrc = _createInitializedDB(tempDir);
 
     const QByteArray data(40, 'M');
-    QVERIFY(dbSrc->saveTile(QStringLiteral("exp_m1"), QStringLiteral("png"), data, kFixedProviderType,
+    QVERIFY(dbSrc->saveTile(testKey(18), QStringLiteral("png"), data, kFixedProviderType,
                             QGCTileCacheDatabase::kInvalidTileSet));
-    QVERIFY(dbSrc->saveTile(QStringLiteral("exp_m2"), QStringLiteral("png"), data, kFixedProviderType,
+    QVERIFY(dbSrc->saveTile(testKey(19), QStringLiteral("png"), data, kFixedProviderType,
                             QGCTileCacheDatabase::kInvalidTileSet));
 
     const auto srcSets = dbSrc->getTileSets();
@@ -451,7 +500,7 @@ void QGCTileCacheDatabaseTest::_testImportSetsMerge()
     QVERIFY(dbTgt->init());
     QVERIFY(dbTgt->connectDB());
 
-    QVERIFY(dbTgt->saveTile(QStringLiteral("trg_m1"), QStringLiteral("png"), QByteArray(25, 'N'), kFixedProviderType,
+    QVERIFY(dbTgt->saveTile(testKey(20), QStringLiteral("png"), QByteArray(25, 'N'), kFixedProviderType,
                             QGCTileCacheDatabase::kInvalidTileSet));
 
     int lastProgress = 0;
@@ -461,9 +510,9 @@ void QGCTileCacheDatabaseTest::_testImportSetsMerge()
     QVERIFY(importResult.success);
     QVERIFY(lastProgress > 0);
 
-    QVERIFY(dbTgt->findTile(QStringLiteral("trg_m1")).has_value());
-    QVERIFY(dbTgt->findTile(QStringLiteral("exp_m1")).has_value());
-    QVERIFY(dbTgt->findTile(QStringLiteral("exp_m2")).has_value());
+    QVERIFY(dbTgt->findTile(testKey(20)).has_value());
+    QVERIFY(dbTgt->findTile(testKey(18)).has_value());
+    QVERIFY(dbTgt->findTile(testKey(19)).has_value());
 }
 
 void QGCTileCacheDatabaseTest::_testComputeSetTotalsNonDefault()
@@ -477,13 +526,13 @@ void QGCTileCacheDatabaseTest::_testComputeSetTotalsNonDefault()
 
     const QByteArray data20(20, 'A');
     const QByteArray data30(30, 'B');
-    QVERIFY(db->saveTile(QStringLiteral("st1"), QStringLiteral("png"), data20, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(21), QStringLiteral("png"), data20, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
-    QVERIFY(db->saveTile(QStringLiteral("st2"), QStringLiteral("png"), data30, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(22), QStringLiteral("png"), data30, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
 
-    const auto tile1 = db->findTile(QStringLiteral("st1"));
-    const auto tile2 = db->findTile(QStringLiteral("st2"));
+    const auto tile1 = db->findTile(testKey(21));
+    const auto tile2 = db->findTile(testKey(22));
     QVERIFY(tile1.has_value());
     QVERIFY(tile2.has_value());
 
@@ -503,17 +552,106 @@ void QGCTileCacheDatabaseTest::_testSaveDuplicateTile()
     const QByteArray data1(10, 'X');
     const QByteArray data2(10, 'Y');
 
-    QVERIFY(db->saveTile(QStringLiteral("dup_hash"), QStringLiteral("png"), data1, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(23), QStringLiteral("png"), data1, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
-    // Second save with same hash succeeds (links existing tile to same set via OR IGNORE)
-    QVERIFY(db->saveTile(QStringLiteral("dup_hash"), QStringLiteral("png"), data2, kFixedProviderType,
+    // Second save with same key succeeds (links existing tile to same set via OR IGNORE)
+    QVERIFY(db->saveTile(testKey(23), QStringLiteral("png"), data2, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
 
-    auto tile = db->getTile(QStringLiteral("dup_hash"));
+    auto tile = db->getTile(testKey(23));
     QVERIFY(tile != nullptr);
     QCOMPARE(tile->img, data1);
 }
 
+void QGCTileCacheDatabaseTest::_testSaveTilesBatch()
+{
+    QTemporaryDir tempDir;
+    auto db = _createInitializedDB(tempDir);
+
+    quint64 setA = 0;
+    _insertTileSet(db.get(), QStringLiteral("SetA"), setA);
+
+    QVERIFY(db->saveTile(testKey(24), QStringLiteral("png"), QByteArray(10, 'E'),
+                         kFixedProviderType, QGCTileCacheDatabase::kInvalidTileSet));
+
+    const QGCCacheTile first(testKey(25), QByteArray(10, '1'), QStringLiteral("png"), kFixedProviderType);
+    const QGCCacheTile existing(testKey(24), QByteArray(10, 'X'), QStringLiteral("png"),
+                                kFixedProviderType, setA);
+    const QGCCacheTile missingSet(testKey(26), QByteArray(10, 'O'), QStringLiteral("png"),
+                                  kFixedProviderType, 999999);
+    const QGCCacheTile second(testKey(27), QByteArray(10, '2'), QStringLiteral("png"), kFixedProviderType,
+                              setA);
+
+    // A tile that can't be linked fails alone; the rest of the batch commits
+    expectLogMessage("QtLocationPlugin.QGCTileCacheDatabase", QtWarningMsg, QRegularExpression("add tile into SetTiles"));
+    const QList<bool> saved = db->saveTiles({&first, &existing, &missingSet, &second});
+    verifyExpectedLogMessage();
+    QCOMPARE(saved, QList<bool>({true, true, false, true}));
+
+    QVERIFY(db->getTile(testKey(25)) != nullptr);
+    QVERIFY(db->getTile(testKey(27)) != nullptr);
+    QVERIFY(!db->findTile(testKey(26)).has_value());
+
+    // Already cached tile keeps its data and gains the second set
+    auto tile = db->getTile(testKey(24));
+    QVERIFY(tile != nullptr);
+    QCOMPARE(tile->img, QByteArray(10, 'E'));
+    {
+        QSqlQuery query(db->database());
+        QVERIFY(query.prepare(QStringLiteral("SELECT COUNT(*) FROM SetTiles WHERE tileID = ?")));
+        query.addBindValue(db->findTile(testKey(24)).value());
+        QVERIFY(query.exec());
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), 2);
+    }
+
+    // Reused statements must not get in the way of dropping the tables
+    QVERIFY(db->resetDatabase());
+    QVERIFY(db->saveTiles({&first}).constFirst());
+}
+
+void QGCTileCacheDatabaseTest::_benchmarkSaveTiles()
+{
+    QTemporaryDir tempDir;
+    auto db = _createInitializedDB(tempDir);
+    QVERIFY(db);
+
+    // Tiles as they arrive while panning: a few KB each, always new keys
+    constexpr int kTiles = 256;
+    const QByteArray image(8 * 1024, 'T');
+    int next = 0;
+    auto makeTiles = [&] {
+        QList<QGCCacheTile> tiles;
+        tiles.reserve(kTiles);
+        for (int i = 0; i < kTiles; i++) {
+            tiles.append(QGCCacheTile(testKey(next++), image, QStringLiteral("png"),
+                                      kFixedProviderType));
+        }
+        return tiles;
+    };
+
+    auto bench = qgc::bench::ciConfig();
+    bench.relative(true).batch(kTiles).unit("tile");
+
+    bench.run("saveTile per tile", [&] {
+        const QList<QGCCacheTile> tiles = makeTiles();
+        for (const QGCCacheTile &tile : tiles) {
+            ankerl::nanobench::doNotOptimizeAway(
+                db->saveTile(tile.key, tile.format, tile.img, tile.type, tile.tileSet));
+        }
+    });
+
+    bench.run("saveTiles batch", [&] {
+        const QList<QGCCacheTile> tiles = makeTiles();
+        QList<const QGCCacheTile*> batch;
+        batch.reserve(tiles.size());
+        for (const QGCCacheTile &tile : tiles) {
+            batch.append(&tile);
+        }
+        ankerl::nanobench::doNotOptimizeAway(db->saveTiles(batch));
+    });
+}
+
 void QGCTileCacheDatabaseTest::_testOperationsAfterDisconnect()
 {
     QTemporaryDir tempDir;
@@ -524,16 +662,16 @@ void QGCTileCacheDatabaseTest::_testOperationsAfterDisconnect()
     const QRegularExpression disconnectedPattern(QStringLiteral("Database not connected"));
 
     expectLogMessage(categoryPattern, QtWarningMsg, disconnectedPattern);
-    QVERIFY(!db->saveTile(QStringLiteral("x"), QStringLiteral("png"), QByteArray("d"), kFixedProviderType,
+    QVERIFY(!db->saveTile(testKey(100), QStringLiteral("png"), QByteArray("d"), kFixedProviderType,
                           QGCTileCacheDatabase::kInvalidTileSet));
     verifyExpectedLogMessage();
 
     expectLogMessage(categoryPattern, QtWarningMsg, disconnectedPattern);
-    QVERIFY(db->getTile(QStringLiteral("x")) == nullptr);
+    QVERIFY(db->getTile(testKey(100)) == nullptr);
     verifyExpectedLogMessage();
 
     expectLogMessage(categoryPattern, QtWarningMsg, disconnectedPattern);
-    QVERIFY(!db->findTile(QStringLiteral("x")).has_value());
+    QVERIFY(!db->findTile(testKey(100)).has_value());
     verifyExpectedLogMessage();
 
     expectLogMessage(categoryPattern, QtWarningMsg, disconnectedPattern);
@@ -561,9 +699,9 @@ void QGCTileCacheDatabaseTest::_testPruneCacheCleansSetTiles()
     auto db = _createInitializedDB(tempDir);
 
     const QByteArray data(100, 'P');
-    QVERIFY(db->saveTile(QStringLiteral("ps1"), QStringLiteral("png"), data, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(28), QStringLiteral("png"), data, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
-    QVERIFY(db->saveTile(QStringLiteral("ps2"), QStringLiteral("png"), data, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(29), QStringLiteral("png"), data, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
 
     {
@@ -582,8 +720,8 @@ void QGCTileCacheDatabaseTest::_testPruneCacheCleansSetTiles()
         QCOMPARE(query.value(0).toInt(), 0);
     }
 
-    QVERIFY(!db->findTile(QStringLiteral("ps1")).has_value());
-    QVERIFY(!db->findTile(QStringLiteral("ps2")).has_value());
+    QVERIFY(!db->findTile(testKey(28)).has_value());
+    QVERIFY(!db->findTile(testKey(29)).has_value());
 }
 
 void QGCTileCacheDatabaseTest::_testDeleteTileSetCleansTiles()
@@ -595,14 +733,14 @@ void QGCTileCacheDatabaseTest::_testDeleteTileSetCleansTiles()
     _insertTileSet(db.get(), QStringLiteral("CleanupSet"), setID);
     QVERIFY(setID != 0);
 
-    QVERIFY(db->saveTile(QStringLiteral("cleanup1"), QStringLiteral("png"), QByteArray(50, 'C'), kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(30), QStringLiteral("png"), QByteArray(50, 'C'), kFixedProviderType,
                          setID));
 
-    QVERIFY(db->findTile(QStringLiteral("cleanup1")).has_value());
+    QVERIFY(db->findTile(testKey(30)).has_value());
 
     QVERIFY(db->deleteTileSet(setID));
 
-    QVERIFY(!db->findTile(QStringLiteral("cleanup1")).has_value());
+    QVERIFY(!db->findTile(testKey(30)).has_value());
 
     {
         QSqlQuery query(db->database());
@@ -623,9 +761,9 @@ void QGCTileCacheDatabaseTest::_testImportSetsMergeDeduplicatesName()
     _insertTileSet(dbSrc.get(), QStringLiteral("SharedName"), customSetID);
     QVERIFY(customSetID != 0);
 
-    QVERIFY(dbSrc->saveTile(QStringLiteral("dedup_tile1"), QStringLiteral("png"), QByteArray(30, 'D'),
+    QVERIFY(dbSrc->saveTile(testKey(31), QStringLiteral("png"), QByteArray(30, 'D'),
                             kFixedProviderType, QGCTileCacheDatabase::kInvalidTileSet));
-    const auto tileID = dbSrc->findTile(QStringLiteral("dedup_tile1"));
+    const auto tileID = dbSrc->findTile(testKey(31));
     QVERIFY(tileID.has_value());
     _linkTileToSet(dbSrc.get(), tileID.value(), customSetID);
 
@@ -678,7 +816,7 @@ void QGCTileCacheDatabaseTest::_testGetTileDownloadListBatch()
     QVERIFY(defaultSetID.has_value());
 
     for (int i = 0; i < 10; i++) {
-        _insertDownloadRecord(db.get(), defaultSetID.value(), QStringLiteral("batch_dl_%1").arg(i),
+        _insertDownloadRecord(db.get(), defaultSetID.value(), testKey(1000 + i),
                               QGCTile::StatePending);
     }
 
@@ -705,6 +843,46 @@ void QGCTileCacheDatabaseTest::_testGetTileDownloadListBatch()
     }
 }
 
+void QGCTileCacheDatabaseTest::_testUpdateTileDownloadStatesBatch()
+{
+    QTemporaryDir tempDir;
+    auto db = _createInitializedDB(tempDir);
+
+    const auto defaultSetID = db->findTileSetID(QStringLiteral("Default Tile Set"));
+    QVERIFY(defaultSetID.has_value());
+
+    // More keys than fit in one statement
+    QList<quint64> keys;
+    for (int i = 0; i < 1200; i++) {
+        keys.append(testKey(2000 + i));
+        _insertDownloadRecord(db.get(), defaultSetID.value(), keys.last(), QGCTile::StateDownloading);
+    }
+
+    const auto countInState = [&](QGCTile::TileState state) {
+        QSqlQuery query(db->database());
+        if (!query.prepare(QStringLiteral("SELECT COUNT(*) FROM TilesDownload WHERE setID = ? AND state = ?"))) {
+            return -1;
+        }
+        query.addBindValue(defaultSetID.value());
+        query.addBindValue(static_cast<int>(state));
+        if (!query.exec() || !query.next()) {
+            return -1;
+        }
+        return query.value(0).toInt();
+    };
+
+    QVERIFY(db->updateTileDownloadStates(defaultSetID.value(), QGCTile::StateError, keys.mid(0, 700)));
+    QCOMPARE(countInState(QGCTile::StateError), 700);
+    QCOMPARE(countInState(QGCTile::StateDownloading), 500);
+
+    QVERIFY(db->updateTileDownloadStates(defaultSetID.value(), QGCTile::StateComplete, keys.mid(100)));
+    QCOMPARE(countInState(QGCTile::StateError), 100);
+    QCOMPARE(countInState(QGCTile::StateDownloading), 0);
+
+    QVERIFY(db->updateTileDownloadStates(defaultSetID.value(), QGCTile::StatePending, {}));
+    QCOMPARE(countInState(QGCTile::StateError), 100);
+}
+
 void QGCTileCacheDatabaseTest::_testSaveTileLinksToDifferentSet()
 {
     QTemporaryDir tempDir;
@@ -715,14 +893,14 @@ void QGCTileCacheDatabaseTest::_testSaveTileLinksToDifferentSet()
     _insertTileSet(db.get(), QStringLiteral("SetB"), setB);
 
     const QByteArray data(10, 'A');
-    QVERIFY(db->saveTile(QStringLiteral("shared_hash"), QStringLiteral("png"), data, kFixedProviderType, setA));
-    QVERIFY(db->saveTile(QStringLiteral("shared_hash"), QStringLiteral("png"), data, kFixedProviderType, setB));
+    QVERIFY(db->saveTile(testKey(32), QStringLiteral("png"), data, kFixedProviderType, setA));
+    QVERIFY(db->saveTile(testKey(32), QStringLiteral("png"), data, kFixedProviderType, setB));
 
-    auto tile = db->getTile(QStringLiteral("shared_hash"));
+    auto tile = db->getTile(testKey(32));
     QVERIFY(tile != nullptr);
     QCOMPARE(tile->img, data);
 
-    const auto tileID = db->findTile(QStringLiteral("shared_hash"));
+    const auto tileID = db->findTile(testKey(32));
     QVERIFY(tileID.has_value());
 
     {
@@ -741,7 +919,7 @@ void QGCTileCacheDatabaseTest::_testExportImportNoLingeringConnections()
     auto db1 = _createInitializedDB(tempDir);
 
     const QByteArray data(20, 'L');
-    QVERIFY(db1->saveTile(QStringLiteral("linger1"), QStringLiteral("png"), data, kFixedProviderType,
+    QVERIFY(db1->saveTile(testKey(33), QStringLiteral("png"), data, kFixedProviderType,
                           QGCTileCacheDatabase::kInvalidTileSet));
 
     const auto sets = db1->getTileSets();
@@ -814,21 +992,21 @@ void QGCTileCacheDatabaseTest::_testDeleteBingNoTileTiles()
     file.close();
     QVERIFY(!noTileBytes.isEmpty());
 
-    QVERIFY(db->saveTile(QStringLiteral("bing_notile_1"), QStringLiteral("png"), noTileBytes, kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(34), QStringLiteral("png"), noTileBytes, kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
-    QVERIFY(db->saveTile(QStringLiteral("normal_tile"), QStringLiteral("png"), QByteArray(50, 'N'), kFixedProviderType,
+    QVERIFY(db->saveTile(testKey(35), QStringLiteral("png"), QByteArray(50, 'N'), kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
 
-    QVERIFY(db->findTile(QStringLiteral("bing_notile_1")).has_value());
-    QVERIFY(db->findTile(QStringLiteral("normal_tile")).has_value());
+    QVERIFY(db->findTile(testKey(34)).has_value());
+    QVERIFY(db->findTile(testKey(35)).has_value());
 
     QSettings settings;
     settings.remove(QStringLiteral("_deleteBingNoTileTilesDone"));
 
     db->deleteBingNoTileTiles();
 
-    QVERIFY(!db->findTile(QStringLiteral("bing_notile_1")).has_value());
-    QVERIFY(db->findTile(QStringLiteral("normal_tile")).has_value());
+    QVERIFY(!db->findTile(testKey(34)).has_value());
+    QVERIFY(db->findTile(testKey(35)).has_value());
 }
 
 void QGCTileCacheDatabaseTest::_testDeleteDefaultSetInvalidatesCache()
@@ -847,7 +1025,7 @@ void QGCTileCacheDatabaseTest::_testDeleteDefaultSetInvalidatesCache()
                      QRegularExpression(QStringLiteral("Default tile set not found in database")));
     expectLogMessage("QtLocationPlugin.QGCTileCacheDatabase", QtWarningMsg,
                      QRegularExpression(QStringLiteral("Cannot save tile: no valid tile set")));
-    QVERIFY(!db->saveTile(QStringLiteral("orphan"), QStringLiteral("png"), QByteArray(10, 'O'), kFixedProviderType,
+    QVERIFY(!db->saveTile(testKey(36), QStringLiteral("png"), QByteArray(10, 'O'), kFixedProviderType,
                           QGCTileCacheDatabase::kInvalidTileSet));
     verifyExpectedLogMessage();
     verifyExpectedLogMessage();
@@ -860,7 +1038,7 @@ void QGCTileCacheDatabaseTest::_testPruneCacheMultipleBatches()
 
     // Save 200 tiles of 100 bytes each = 20000 bytes total
     for (int i = 0; i < 200; i++) {
-        QVERIFY(db->saveTile(QStringLiteral("prune_multi_%1").arg(i), QStringLiteral("png"), QByteArray(100, 'P'),
+        QVERIFY(db->saveTile(testKey(2000 + i), QStringLiteral("png"), QByteArray(100, 'P'),
                              kFixedProviderType, QGCTileCacheDatabase::kInvalidTileSet));
     }
 
@@ -927,7 +1105,7 @@ void QGCTileCacheDatabaseTest::_testSchemaVersionResetsLegacyDB()
     QVERIFY(db.connectDB());
 
     // Legacy tile data should be gone
-    QVERIFY(!db.findTile(QStringLiteral("old_hash")).has_value());
+    QVERIFY(!db.findTile(testKey(0)).has_value());
 
     // Schema version should now be set
     QSqlQuery query(db.database());
@@ -941,6 +1119,60 @@ void QGCTileCacheDatabaseTest::_testSchemaVersionResetsLegacyDB()
     QVERIFY(sets[0].defaultSet);
 }
 
+void QGCTileCacheDatabaseTest::_testSchemaVersion1Migrated()
+{
+    QTemporaryDir tempDir;
+    const QString path = tempDir.filePath("v1.db");
+    _createVersion1DB(path);
+
+    QGCTileCacheDatabase db(path);
+    QVERIFY(db.init());
+    QVERIFY(db.connectDB());
+
+    // The tile keeps its row id and set membership under its packed key
+    const quint64 key = UrlFactory::getTileKey(kFixedProviderType, 5, 7, 3);
+    QCOMPARE(db.findTile(key).value_or(0), 42ULL);
+    auto tile = db.getTile(key);
+    QVERIFY(tile != nullptr);
+    QCOMPARE(tile->img, QByteArray("v1v1"));
+    QCOMPARE(tile->type, kFixedProviderType);
+
+    const auto setID = db.findTileSetID(QStringLiteral("V1 Set"));
+    QVERIFY(setID.has_value());
+    const QList<QGCTile> pending = db.getTileDownloadList(setID.value(), 10);
+    QCOMPARE(pending.size(), 1);
+    QCOMPARE(pending.first().key, UrlFactory::getTileKey(kFixedProviderType, 6, 7, 3));
+
+    QVERIFY(db.deleteTileSet(setID.value()));
+    QVERIFY(!db.findTile(key).has_value());
+
+    QSqlQuery query(db.database());
+    QVERIFY(query.exec("PRAGMA user_version"));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), QGCTileCacheDatabase::kSchemaVersion);
+    QVERIFY(query.exec("SELECT COUNT(*) FROM sqlite_master WHERE name = 'idx_tilesdownload_setid_tilekey'"));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), 1);
+}
+
+void QGCTileCacheDatabaseTest::_testImportSetsMergeVersion1()
+{
+    QTemporaryDir tempDir;
+    const QString importPath = tempDir.filePath("v1_export.db");
+    _createVersion1DB(importPath);
+
+    auto db = _createInitializedDB(tempDir);
+    QVERIFY(db);
+
+    const DatabaseResult result = db->importSetsMerge(importPath, nullptr);
+    QVERIFY(result.success);
+
+    auto tile = db->getTile(UrlFactory::getTileKey(kFixedProviderType, 5, 7, 3));
+    QVERIFY(tile != nullptr);
+    QCOMPARE(tile->img, QByteArray("v1v1"));
+    QVERIFY(db->findTileSetID(QStringLiteral("V1 Set")).has_value());
+}
+
 void QGCTileCacheDatabaseTest::_testSaveTileTypeStoredAsInteger()
 {
     QTemporaryDir tempDir;
@@ -949,22 +1181,22 @@ void QGCTileCacheDatabaseTest::_testSaveTileTypeStoredAsInteger()
     const int expectedMapId = UrlFactory::getQtMapIdFromProviderType(kFixedProviderType);
     QVERIFY(expectedMapId != -1);
 
-    const QString hash = QStringLiteral("type_int_test");
-    QVERIFY(db->saveTile(hash, QStringLiteral("png"), QByteArray("data"), kFixedProviderType,
+    const quint64 key = testKey(37);
+    QVERIFY(db->saveTile(key, QStringLiteral("png"), QByteArray("data"), kFixedProviderType,
                          QGCTileCacheDatabase::kInvalidTileSet));
 
     // Verify the raw DB stores the type as an integer mapId, not a string
     {
         QSqlQuery query(db->database());
-        QVERIFY(query.prepare("SELECT type FROM Tiles WHERE hash = ?"));
-        query.addBindValue(hash);
+        QVERIFY(query.prepare("SELECT type FROM Tiles WHERE tileKey = ?"));
+        query.addBindValue(key);
         QVERIFY(query.exec());
         QVERIFY(query.next());
         QCOMPARE(query.value(0).toInt(), expectedMapId);
     }
 
     // Verify getTile converts the integer back to the provider name string
-    auto tile = db->getTile(hash);
+    auto tile = db->getTile(key);
     QVERIFY(tile != nullptr);
     QCOMPARE(tile->type, kFixedProviderType);
 }
@@ -1060,9 +1292,9 @@ void QGCTileCacheDatabaseTest::_testTilesTableColumns()
     QVERIFY(c->pk);
     QVERIFY(c->notnull);
 
-    c = findCol(QStringLiteral("hash"));
+    c = findCol(QStringLiteral("tileKey"));
     QVERIFY(c);
-    QCOMPARE(c->type, QStringLiteral("TEXT"));
+    QCOMPARE(c->type, QStringLiteral("INTEGER"));
     QVERIFY(c->notnull);
 
     c = findCol(QStringLiteral("format"));
@@ -1258,9 +1490,9 @@ void QGCTileCacheDatabaseTest::_testTilesDownloadTableColumns()
     QCOMPARE(c->type, QStringLiteral("INTEGER"));
     QVERIFY(c->notnull);
 
-    c = findCol(QStringLiteral("hash"));
+    c = findCol(QStringLiteral("tileKey"));
     QVERIFY(c);
-    QCOMPARE(c->type, QStringLiteral("TEXT"));
+    QCOMPARE(c->type, QStringLiteral("INTEGER"));
     QVERIFY(c->notnull);
 
     c = findCol(QStringLiteral("type"));
@@ -1302,7 +1534,7 @@ void QGCTileCacheDatabaseTest::_testIndexesExist()
     const QStringList expected = {
         QStringLiteral("idx_settiles_setid"),           QStringLiteral("idx_settiles_tileid"),
         QStringLiteral("idx_settiles_unique"),          QStringLiteral("idx_tiles_date"),
-        QStringLiteral("idx_tilesdownload_setid_hash"), QStringLiteral("idx_tilesdownload_setid_state"),
+        QStringLiteral("idx_tilesdownload_setid_tilekey"), QStringLiteral("idx_tilesdownload_setid_state"),
     };
 
     QCOMPARE(indexes.size(), expected.size());
@@ -1319,12 +1551,12 @@ void QGCTileCacheDatabaseTest::_testForeignKeyCascadeDelete()
 
     QVERIFY(UrlFactory::getQtMapIdFromProviderType(kFixedProviderType) != -1);
 
-    const QString hash = QStringLiteral("fk_cascade_hash");
+    const quint64 key = testKey(38);
     QVERIFY(
-        db->saveTile(hash, QStringLiteral("png"), QByteArray("data"), kFixedProviderType,
+        db->saveTile(key, QStringLiteral("png"), QByteArray("data"), kFixedProviderType,
                      QGCTileCacheDatabase::kInvalidTileSet));
 
-    const auto tileID = db->findTile(hash);
+    const auto tileID = db->findTile(key);
     QVERIFY(tileID.has_value());
 
     const auto setID = db->createTileSet(QStringLiteral("CascadeTestSet"), kFixedProviderType, 10.0, 20.0, 30.0,
@@ -1357,7 +1589,7 @@ void QGCTileCacheDatabaseTest::_testForeignKeyCascadeDelete()
 
     // Tile itself should still exist (linked to default set)
     {
-        auto tile = db->getTile(hash);
+        auto tile = db->getTile(key);
         QVERIFY(tile != nullptr);
     }
 }
@@ -32,11 +32,14 @@ private slots:
     void _testImportSetsMerge();
     void _testComputeSetTotalsNonDefault();
     void _testSaveDuplicateTile();
+    void _testSaveTilesBatch();
+    void _benchmarkSaveTiles();
     void _testOperationsAfterDisconnect();
     void _testPruneCacheCleansSetTiles();
     void _testDeleteTileSetCleansTiles();
     void _testImportSetsMergeDeduplicatesName();
     void _testGetTileDownloadListBatch();
+    void _testUpdateTileDownloadStatesBatch();
     void _testSaveTileLinksToDifferentSet();
     void _testExportImportNoLingeringConnections();
     void _testCreateTileSet();
@@ -45,6 +48,8 @@ private slots:
     void _testPruneCacheMultipleBatches();
     void _testSchemaVersionSetOnFreshDB();
     void _testSchemaVersionResetsLegacyDB();
+    void _testSchemaVersion1Migrated();
+    void _testImportSetsMergeVersion1();
     void _testSaveTileTypeStoredAsInteger();
     void _testCreateTileSetTypeStoredAsInteger();
     void _testTablesExist();
@@ -58,6 +63,7 @@ private slots:
 private:
     std::unique_ptr<QGCTileCacheDatabase> _createInitializedDB(QTemporaryDir &tempDir);
     void _insertTileSet(QGCTileCacheDatabase* db, const QString& name, quint64& outSetID);
-    void _insertDownloadRecord(QGCTileCacheDatabase* db, quint64 setID, const QString& hash, int state = 0);
+    void _insertDownloadRecord(QGCTileCacheDatabase* db, quint64 setID, quint64 key, int state = 0);
     void _linkTileToSet(QGCTileCacheDatabase* db, quint64 tileID, quint64 setID);
+    void _createVersion1DB(const QString& path);
 };
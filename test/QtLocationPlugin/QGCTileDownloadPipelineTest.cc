@@ -0,0 +1,293 @@
+#include "QGCTileDownloadPipelineTest.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtSql/QSqlQuery>
+#include <QtTest/QTest>
+
+#include "LocalHttpTestServer.h"
+#include "QGCCachedTileSet.h"
+#include "QGCMapTasks.h"
+#include "QGCMapUrlEngine.h"
+#include "QGCTileCacheDatabase.h"
+#include "QGCTileCacheWorker.h"
+#include "QGCTileDownloadPipeline.h"
+#include "QGCTileSet.h"
+
+static const QString kTestProviderType = QStringLiteral("Bing Road");
+static constexpr double kTopLeftLat = 37.0;
+static constexpr double kTopLeftLon = -122.0;
+static constexpr double kBottomRightLat = 36.9;
+static constexpr double kBottomRightLon = -121.9;
+
+static QByteArray pngTile()
+{
+    return QByteArrayLiteral("\x89PNG\r\n\x1a\n") + QByteArray(2048, 'P');
+}
+
+static void serveTiles(QGCTileDownloadPipeline &pipeline, QGCCacheWorker &worker, const TestFixtures::LocalHttpTestServer &server)
+{
+    pipeline.setTaskSink([&worker](QGCMapTask *task) { return worker.enqueueTask(task); });
+    pipeline.setRequestFactory([&server](const QGCTile &tile) {
+        return QNetworkRequest(QUrl(server.url(QStringLiteral("/%1/%2/%3.png").arg(tile.z).arg(tile.x).arg(tile.y))));
+    });
+}
+
+/// Tile count per download state for @p setID, read once the worker has stopped
+static QHash<int, int> downloadStates(const QString &path, quint64 setID)
+{
+    QHash<int, int> states;
+    QGCTileCacheDatabase db(path);
+    if (!db.init() || !db.connectDB()) {
+        return states;
+    }
+
+    QSqlQuery query(db.database());
+    if (!query.prepare(QStringLiteral("SELECT state, COUNT(*) FROM TilesDownload WHERE setID = ? GROUP BY state"))) {
+        return states;
+    }
+    query.addBindValue(setID);
+    if (query.exec()) {
+        while (query.next()) {
+            states.insert(query.value(0).toInt(), query.value(1).toInt());
+        }
+    }
+    return states;
+}
+
+static quint32 savedTileCount(const QString &path, quint64 setID, quint32 totalTileCount)
+{
+    QGCTileCacheDatabase db(path);
+    if (!db.init() || !db.connectDB()) {
+        return 0;
+    }
+    return db.computeSetTotals(setID, false, totalTileCount, kTestProviderType).savedTileCount;
+}
+
+void QGCTileDownloadPipelineTest::initTestCase()
+{
+    UnitTest::initTestCase();
+    QVERIFY2(UrlFactory::getQtMapIdFromProviderType(kTestProviderType) != -1,
+             ("Provider type '" + kTestProviderType.toLatin1() + "' not available in this build").constData());
+}
+
+bool QGCTileDownloadPipelineTest::_startWorker(QGCCacheWorker &worker)
+{
+    bool totalsReceived = false;
+    auto conn = connect(&worker, &QGCCacheWorker::updateTotals, this, [&]() { totalsReceived = true; }, Qt::QueuedConnection);
+
+    if (!worker.enqueueTask(new QGCMapTask(QGCMapTask::TaskType::taskInit))) {
+        disconnect(conn);
+        return false;
+    }
+
+    const bool ok = UnitTest::waitForCondition([&]() { return totalsReceived; }, TestTimeout::mediumMs(),
+                                               QStringLiteral("QGCCacheWorker::updateTotals"));
+    disconnect(conn);
+    return ok;
+}
+
+std::unique_ptr<QGCCachedTileSet> QGCTileDownloadPipelineTest::_createTileSet(QGCCacheWorker &worker, int minZoom, int maxZoom)
+{
+    auto *tileSet = new QGCCachedTileSet(QStringLiteral("Pipeline Set"));
+    tileSet->setMapTypeStr(kTestProviderType);
+    tileSet->setType(kTestProviderType);
+    tileSet->setTopleftLat(kTopLeftLat);
+    tileSet->setTopleftLon(kTopLeftLon);
+    tileSet->setBottomRightLat(kBottomRightLat);
+    tileSet->setBottomRightLon(kBottomRightLon);
+    tileSet->setMinZoom(minZoom);
+    tileSet->setMaxZoom(maxZoom);
+    tileSet->setTotalTileCount(_tileCount(minZoom, maxZoom));
+
+    // The set belongs to the task until it is saved
+    auto *createTask = new QGCCreateTileSetTask(tileSet);
+    QGCCachedTileSet *savedSet = nullptr;
+    bool createError = false;
+    (void) connect(createTask, &QGCCreateTileSetTask::tileSetSaved, this, [&](QGCCachedTileSet *set) { savedSet = set; }, Qt::QueuedConnection);
+    (void) connect(createTask, &QGCMapTask::error, this, [&]() { createError = true; }, Qt::QueuedConnection);
+    if (!worker.enqueueTask(createTask)) {
+        return nullptr;
+    }
+
+    (void) UnitTest::waitForCondition([&]() { return savedSet || createError; }, TestTimeout::mediumMs(),
+                                      QStringLiteral("QGCCreateTileSetTask::tileSetSaved"));
+    return std::unique_ptr<QGCCachedTileSet>(savedSet);
+}
+
+bool QGCTileDownloadPipelineTest::_runPipeline(QGCTileDownloadPipeline &pipeline, int timeoutMs)
+{
+    bool done = false;
+    auto conn = connect(&pipeline, &QGCTileDownloadPipeline::finished, this, [&]() { done = true; });
+    pipeline.start();
+    const bool ok = UnitTest::waitForCondition([&]() { return done; }, timeoutMs, QStringLiteral("QGCTileDownloadPipeline::finished"));
+    disconnect(conn);
+    return ok;
+}
+
+quint32 QGCTileDownloadPipelineTest::_tileCount(int minZoom, int maxZoom)
+{
+    quint32 count = 0;
+    for (int z = minZoom; z <= maxZoom; z++) {
+        count += static_cast<quint32>(UrlFactory::getTileCount(z, kTopLeftLon, kTopLeftLat, kBottomRightLon, kBottomRightLat, kTestProviderType).tileCount);
+    }
+    return count;
+}
+
+void QGCTileDownloadPipelineTest::_testValidateTile()
+{
+    QByteArray empty;
+    QVERIFY(QGCTileDownloadPipeline::validateTile(kTestProviderType, empty).isEmpty());
+
+    QByteArray png = pngTile();
+    QCOMPARE(QGCTileDownloadPipeline::validateTile(kTestProviderType, png), QStringLiteral("png"));
+    QCOMPARE(png, pngTile());
+
+    QByteArray unknownProvider = pngTile();
+    QVERIFY(QGCTileDownloadPipeline::validateTile(QStringLiteral("No Such Provider"), unknownProvider).isEmpty());
+}
+
+void QGCTileDownloadPipelineTest::_testValidateBingNoTile()
+{
+    QFile file(QStringLiteral(":/res/BingNoTileBytes.dat"));
+    if (!file.open(QFile::ReadOnly)) {
+        QSKIP("BingNoTileBytes.dat resource not available");
+    }
+    QByteArray noTile = file.readAll();
+    QVERIFY(!noTile.isEmpty());
+
+    QVERIFY(QGCTileDownloadPipeline::validateTile(kTestProviderType, noTile).isEmpty());
+}
+
+void QGCTileDownloadPipelineTest::_testDownloadThroughput()
+{
+    QTemporaryDir tempDir;
+    const QString dbPath = tempDir.filePath("throughput.db");
+    QGCCacheWorker worker;
+    worker.setDatabaseFile(dbPath);
+    QVERIFY(_startWorker(worker));
+
+    const std::unique_ptr<QGCCachedTileSet> tileSet = _createTileSet(worker, 14, 16);
+    QVERIFY(tileSet);
+    const quint32 total = tileSet->totalTileCount();
+    QVERIFY(total > 256);
+
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY(server.listen());
+    server.installHttpResponder(pngTile(), 200, "image/png");
+
+    QNetworkAccessManager networkManager;
+    QGCTileDownloadPipeline pipeline(tileSet->id(), &networkManager);
+    serveTiles(pipeline, worker, server);
+
+    quint32 stored = 0;
+    quint32 failed = 0;
+    (void) connect(&pipeline, &QGCTileDownloadPipeline::tilesStored, this, [&](quint32 count) { stored += count; });
+    (void) connect(&pipeline, &QGCTileDownloadPipeline::tilesFailed, this, [&](quint32 count) { failed += count; });
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(_runPipeline(pipeline, TestTimeout::longMs()));
+    const qint64 elapsedMs = qMax<qint64>(1, timer.elapsed());
+    qCDebug(UnitTestLog) << "Downloaded" << stored << "tiles in" << elapsedMs << "ms:" << ((stored * 1000.) / elapsedMs) << "tiles/s";
+
+    QCOMPARE(failed, 0u);
+    QCOMPARE(stored, total);
+
+    worker.stop();
+    QVERIFY(worker.wait(TestTimeout::mediumMs()));
+
+    QVERIFY(downloadStates(dbPath, tileSet->id()).isEmpty());
+    QCOMPARE(savedTileCount(dbPath, tileSet->id(), total), total);
+}
+
+void QGCTileDownloadPipelineTest::_testCancelAndResume()
+{
+    QTemporaryDir tempDir;
+    const QString dbPath = tempDir.filePath("resume.db");
+    QGCCacheWorker worker;
+    worker.setDatabaseFile(dbPath);
+    QVERIFY(_startWorker(worker));
+
+    const std::unique_ptr<QGCCachedTileSet> tileSet = _createTileSet(worker, 14, 15);
+    QVERIFY(tileSet);
+    const quint32 total = tileSet->totalTileCount();
+
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY(server.listen());
+    server.installHttpResponder(pngTile(), 200, "image/png");
+
+    QNetworkAccessManager networkManager;
+    QGCTileDownloadPipeline pipeline(tileSet->id(), &networkManager);
+    QGCTileDownloadPipeline::Options options;
+    options.storeBatch = 16;
+    pipeline.setOptions(options);
+    serveTiles(pipeline, worker, server);
+
+    quint32 stored = 0;
+    bool cancelled = false;
+    const QMetaObject::Connection cancelOnStore = connect(&pipeline, &QGCTileDownloadPipeline::tilesStored, this, [&](quint32 count) {
+        stored += count;
+        pipeline.cancel();
+    });
+    (void) connect(&pipeline, &QGCTileDownloadPipeline::finished, this, [&](bool wasCancelled) { cancelled = wasCancelled; });
+
+    QVERIFY(_runPipeline(pipeline, TestTimeout::longMs()));
+    QVERIFY(cancelled);
+    QVERIFY(stored > 0);
+    QVERIFY(stored < total);
+
+    // The next run only fetches what the first one did not store
+    (void) disconnect(cancelOnStore);
+    (void) connect(&pipeline, &QGCTileDownloadPipeline::tilesStored, this, [&](quint32 count) { stored += count; });
+    QVERIFY(_runPipeline(pipeline, TestTimeout::longMs()));
+    QVERIFY(!cancelled);
+    QCOMPARE(stored, total);
+
+    worker.stop();
+    QVERIFY(worker.wait(TestTimeout::mediumMs()));
+
+    QVERIFY(downloadStates(dbPath, tileSet->id()).isEmpty());
+    QCOMPARE(savedTileCount(dbPath, tileSet->id(), total), total);
+}
+
+void QGCTileDownloadPipelineTest::_testFailedTiles()
+{
+    QTemporaryDir tempDir;
+    const QString dbPath = tempDir.filePath("failed.db");
+    QGCCacheWorker worker;
+    worker.setDatabaseFile(dbPath);
+    QVERIFY(_startWorker(worker));
+
+    const std::unique_ptr<QGCCachedTileSet> tileSet = _createTileSet(worker, 14, 14);
+    QVERIFY(tileSet);
+    const quint32 total = tileSet->totalTileCount();
+
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY(server.listen());
+    server.installHttpResponder(QByteArrayLiteral("not found"), 404, "text/plain");
+
+    QNetworkAccessManager networkManager;
+    QGCTileDownloadPipeline pipeline(tileSet->id(), &networkManager);
+    serveTiles(pipeline, worker, server);
+
+    quint32 stored = 0;
+    quint32 failed = 0;
+    (void) connect(&pipeline, &QGCTileDownloadPipeline::tilesStored, this, [&](quint32 count) { stored += count; });
+    (void) connect(&pipeline, &QGCTileDownloadPipeline::tilesFailed, this, [&](quint32 count) { failed += count; });
+
+    QVERIFY(_runPipeline(pipeline, TestTimeout::longMs()));
+    QCOMPARE(stored, 0u);
+    QCOMPARE(failed, total);
+
+    worker.stop();
+    QVERIFY(worker.wait(TestTimeout::mediumMs()));
+
+    const QHash<int, int> states = downloadStates(dbPath, tileSet->id());
+    QCOMPARE(states.size(), 1);
+    QCOMPARE(states.value(QGCTile::StateError), static_cast<int>(total));
+}
+
+UT_REGISTER_TEST(QGCTileDownloadPipelineTest, TestLabel::Unit)
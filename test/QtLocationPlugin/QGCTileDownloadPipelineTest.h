@@ -0,0 +1,29 @@
+#pragma once
+
+#include "UnitTest.h"
+
+#include <memory>
+
+class QGCCachedTileSet;
+class QGCCacheWorker;
+class QGCTileDownloadPipeline;
+
+class QGCTileDownloadPipelineTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() override;
+    void _testValidateTile();
+    void _testValidateBingNoTile();
+    void _testDownloadThroughput();
+    void _testCancelAndResume();
+    void _testFailedTiles();
+
+private:
+    bool _startWorker(QGCCacheWorker &worker);
+    std::unique_ptr<QGCCachedTileSet> _createTileSet(QGCCacheWorker &worker, int minZoom, int maxZoom);
+    /// Runs @p pipeline until it finishes; returns false on timeout
+    bool _runPipeline(QGCTileDownloadPipeline &pipeline, int timeoutMs);
+    static quint32 _tileCount(int minZoom, int maxZoom);
+};
@@ -0,0 +1,111 @@
+#include "QGCTilePrefetcherTest.h"
+
+#include <QtCore/QSet>
+#include <QtCore/QtNumeric>
+#include <QtPositioning/QGeoCoordinate>
+
+#include "QGCMapUrlEngine.h"
+#include "QGCTileKey.h"
+#include "QGCTilePrefetcher.h"
+
+static const QString kBingRoad = QStringLiteral("Bing Road");
+static const QGeoCoordinate kStart(47.3977, 8.5456);
+
+static quint64 tileKeyAt(const QGeoCoordinate &coord, int zoom)
+{
+    return UrlFactory::getTileKey(kBingRoad, UrlFactory::long2tileX(kBingRoad, coord.longitude(), zoom),
+                                  UrlFactory::lat2tileY(kBingRoad, coord.latitude(), zoom), zoom);
+}
+
+void QGCTilePrefetcherTest::_testTilesAlongPathSinglePoint()
+{
+    const QList<quint64> keys = QGCTilePrefetcher::tilesAlongPath(kBingRoad, { kStart }, 15, 0, 100);
+    QCOMPARE(keys.size(), 1);
+    QCOMPARE(keys.first(), tileKeyAt(kStart, 15));
+}
+
+void QGCTilePrefetcherTest::_testTilesAlongPathMargin()
+{
+    const QList<quint64> keys = QGCTilePrefetcher::tilesAlongPath(kBingRoad, { kStart }, 15, 1, 100);
+    QCOMPARE(keys.size(), 9);
+
+    const quint64 center = tileKeyAt(kStart, 15);
+    for (const quint64 key : keys) {
+        QCOMPARE(QGCTileKey::zoom(key), 15);
+        QVERIFY(qAbs(QGCTileKey::x(key) - QGCTileKey::x(center)) <= 1);
+        QVERIFY(qAbs(QGCTileKey::y(key) - QGCTileKey::y(center)) <= 1);
+    }
+}
+
+void QGCTilePrefetcherTest::_testTilesAlongPathContiguous()
+{
+    // A diagonal leg of a few kilometres crosses dozens of tiles at zoom 16
+    const QGeoCoordinate end = kStart.atDistanceAndAzimuth(5000., 60.);
+    const QList<quint64> keys = QGCTilePrefetcher::tilesAlongPath(kBingRoad, { kStart, end }, 16, 0, 1000);
+
+    QVERIFY(keys.size() > 10);
+    QCOMPARE(keys.first(), tileKeyAt(kStart, 16));
+    QCOMPARE(keys.last(), tileKeyAt(end, 16));
+    QCOMPARE(QSet<quint64>(keys.cbegin(), keys.cend()).size(), keys.size());
+
+    for (qsizetype i = 1; i < keys.size(); i++) {
+        QVERIFY2(qAbs(QGCTileKey::x(keys[i]) - QGCTileKey::x(keys[i - 1])) <= 1, "Path skipped a column of tiles");
+        QVERIFY2(qAbs(QGCTileKey::y(keys[i]) - QGCTileKey::y(keys[i - 1])) <= 1, "Path skipped a row of tiles");
+    }
+}
+
+void QGCTilePrefetcherTest::_testTilesAlongPathLimit()
+{
+    const QGeoCoordinate end = kStart.atDistanceAndAzimuth(50000., 90.);
+    const QList<quint64> keys = QGCTilePrefetcher::tilesAlongPath(kBingRoad, { kStart, end }, 18, 1, 64);
+    QCOMPARE(keys.size(), 64);
+}
+
+void QGCTilePrefetcherTest::_testTilesAlongPathInvalid()
+{
+    QVERIFY(QGCTilePrefetcher::tilesAlongPath(kBingRoad, {}, 15, 1, 100).isEmpty());
+    QVERIFY(QGCTilePrefetcher::tilesAlongPath(kBingRoad, { kStart }, 0, 1, 100).isEmpty());
+    QVERIFY(QGCTilePrefetcher::tilesAlongPath(kBingRoad, { QGeoCoordinate() }, 15, 1, 100).isEmpty());
+
+    expectLogMessage("QtLocationPlugin.QGCMapUrlEngine", QtWarningMsg, QRegularExpression("type not found:"));
+    QVERIFY(QGCTilePrefetcher::tilesAlongPath(QStringLiteral("Nonexistent"), { kStart }, 15, 1, 100).isEmpty());
+    verifyExpectedLogMessage();
+}
+
+void QGCTilePrefetcherTest::_testPredictTrack()
+{
+    const QList<QGeoCoordinate> track = QGCTilePrefetcher::predictTrack(kStart, 90., 20., 60.);
+    QCOMPARE(track.size(), 2);
+    QCOMPARE(track.first(), kStart);
+    QVERIFY(qAbs(kStart.distanceTo(track.last()) - 1200.) < 1.);
+    QVERIFY(qAbs(kStart.azimuthTo(track.last()) - 90.) < 0.1);
+}
+
+void QGCTilePrefetcherTest::_testPredictTrackTooSlow()
+{
+    QVERIFY(QGCTilePrefetcher::predictTrack(kStart, 90., 0.5, 60.).isEmpty());
+    QVERIFY(QGCTilePrefetcher::predictTrack(QGeoCoordinate(), 90., 20., 60.).isEmpty());
+    QVERIFY(QGCTilePrefetcher::predictTrack(kStart, qQNaN(), 20., 60.).isEmpty());
+}
+
+void QGCTilePrefetcherTest::_testViewLookupStatistics()
+{
+    QGCTilePrefetcher prefetcher;
+    QCOMPARE(prefetcher.hitRate(), 0.);
+
+    prefetcher.recordViewLookup(tileKeyAt(kStart, 15), true);
+    prefetcher.recordViewLookup(tileKeyAt(kStart, 16), true);
+    prefetcher.recordViewLookup(tileKeyAt(kStart, 17), true);
+    prefetcher.recordViewLookup(tileKeyAt(kStart, 18), false);
+
+    QCOMPARE(prefetcher.viewLookups(), 4u);
+    QCOMPARE(prefetcher.viewHits(), 3u);
+    QCOMPARE(prefetcher.hitRate(), 0.75);
+    QCOMPARE(prefetcher.prefetchedHits(), 0u);
+
+    prefetcher.resetStatistics();
+    QCOMPARE(prefetcher.viewLookups(), 0u);
+    QCOMPARE(prefetcher.viewHits(), 0u);
+}
+
+UT_REGISTER_TEST(QGCTilePrefetcherTest, TestLabel::Unit)
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class QGCTilePrefetcherTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testTilesAlongPathSinglePoint();
+    void _testTilesAlongPathMargin();
+    void _testTilesAlongPathContiguous();
+    void _testTilesAlongPathLimit();
+    void _testTilesAlongPathInvalid();
+    void _testPredictTrack();
+    void _testPredictTrackTooSlow();
+    void _testViewLookupStatistics();
+};
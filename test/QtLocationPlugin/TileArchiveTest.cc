@@ -0,0 +1,269 @@
+#include "TileArchiveTest.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QSet>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
+#include <QtSql/QSqlDatabase>
+#include <QtSql/QSqlQuery>
+
+#include "QGCMapUrlEngine.h"
+#include "TileArchiveMapProvider.h"
+
+namespace {
+
+struct TestEntry
+{
+    quint64 tileId;
+    quint64 offset;
+    quint32 length;
+    quint32 runLength;
+};
+
+const QByteArray kTileA = QByteArrayLiteral("tile-a");
+const QByteArray kTileB = QByteArrayLiteral("tile-bb");
+const QByteArray kTileC = QByteArrayLiteral("tile-ccc");
+const QByteArray kTileD = QByteArrayLiteral("tile-dddd");
+
+QByteArray varint(quint64 value)
+{
+    QByteArray bytes;
+    while (value >= 0x80) {
+        bytes.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    bytes.append(static_cast<char>(value));
+    return bytes;
+}
+
+QByteArray directory(const QList<TestEntry> &entries)
+{
+    QByteArray bytes = varint(entries.size());
+    quint64 lastId = 0;
+    for (const TestEntry &entry : entries) {
+        bytes += varint(entry.tileId - lastId);
+        lastId = entry.tileId;
+    }
+    for (const TestEntry &entry : entries) {
+        bytes += varint(entry.runLength);
+    }
+    for (const TestEntry &entry : entries) {
+        bytes += varint(entry.length);
+    }
+    for (qsizetype i = 0; i < entries.size(); i++) {
+        const bool follows = (i > 0) && (entries[i].offset == (entries[i - 1].offset + entries[i - 1].length));
+        bytes += varint(follows ? 0 : (entries[i].offset + 1));
+    }
+    return bytes;
+}
+
+void putU64(QByteArray &bytes, int offset, quint64 value)
+{
+    qToLittleEndian<quint64>(value, bytes.data() + offset);
+}
+
+} // namespace
+
+bool TileArchiveTest::_writePMTiles(const QString &path, const QMap<int, quint8> &header)
+{
+    // Tile 0 and the run 1-2 in the root, tile 4 behind a leaf; tile 3 is missing
+    const QByteArray tileData = kTileA + kTileB + kTileC;
+    const QByteArray leaf = directory({{4, quint64(kTileA.size() + kTileB.size()), quint32(kTileC.size()), 1}});
+    const QByteArray root = directory({
+        {0, 0, quint32(kTileA.size()), 1},
+        {1, quint64(kTileA.size()), quint32(kTileB.size()), 2},
+        {4, 0, quint32(leaf.size()), 0},
+    });
+    const QByteArray metadata = QByteArrayLiteral(R"({"name":"Test Basemap"})");
+
+    QByteArray bytes(PMTilesArchive::kHeaderSize, '\0');
+    (void) bytes.replace(0, 7, "PMTiles");
+    bytes[7] = 3;
+    const quint64 rootOffset = PMTilesArchive::kHeaderSize;
+    const quint64 metadataOffset = rootOffset + root.size();
+    const quint64 leafOffset = metadataOffset + metadata.size();
+    const quint64 tileDataOffset = leafOffset + leaf.size();
+    putU64(bytes, 8, rootOffset);
+    putU64(bytes, 16, root.size());
+    putU64(bytes, 24, metadataOffset);
+    putU64(bytes, 32, metadata.size());
+    putU64(bytes, 40, leafOffset);
+    putU64(bytes, 48, leaf.size());
+    putU64(bytes, 56, tileDataOffset);
+    putU64(bytes, 64, tileData.size());
+    bytes[96] = 1;  // clustered
+    bytes[97] = 1;  // internal compression: none
+    bytes[98] = 1;  // tile compression: none
+    bytes[99] = 2;  // png
+    bytes[100] = 0;
+    bytes[101] = 1;
+    for (auto it = header.cbegin(); it != header.cend(); ++it) {
+        bytes[it.key()] = static_cast<char>(it.value());
+    }
+    bytes += root + metadata + leaf + tileData;
+
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && (file.write(bytes) == bytes.size());
+}
+
+bool TileArchiveTest::_writeMBTiles(const QString &path, const QString &name)
+{
+    bool ok = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("mbtiles_setup"));
+        db.setDatabaseName(path);
+        if (db.open()) {
+            QSqlQuery query(db);
+            ok = query.exec(QStringLiteral("CREATE TABLE metadata (name TEXT, value TEXT)")) &&
+                 query.exec(QStringLiteral("CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, tile_data BLOB)")) &&
+                 query.exec(QStringLiteral("INSERT INTO metadata VALUES ('name', '%1'), ('format', 'jpeg'), ('minzoom', '0'), ('maxzoom', '2')").arg(name));
+            // XYZ 1/1/1 is TMS row 0
+            ok = ok && query.prepare(QStringLiteral("INSERT INTO tiles VALUES (1, 1, 0, ?)"));
+            query.addBindValue(kTileD);
+            ok = ok && query.exec();
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(QStringLiteral("mbtiles_setup"));
+    return ok;
+}
+
+void TileArchiveTest::_testTileId()
+{
+    QCOMPARE(PMTilesArchive::tileId(0, 0, 0), 0ULL);
+    QCOMPARE(PMTilesArchive::tileId(0, 0, 1), 1ULL);
+    QCOMPARE(PMTilesArchive::tileId(0, 1, 1), 2ULL);
+    QCOMPARE(PMTilesArchive::tileId(1, 1, 1), 3ULL);
+    QCOMPARE(PMTilesArchive::tileId(1, 0, 1), 4ULL);
+    QCOMPARE(PMTilesArchive::tileId(0, 0, 2), 5ULL);
+    QCOMPARE(PMTilesArchive::tileId(3, 0, 2), 20ULL);
+
+    // Every tile of a zoom level lands on its own id, after all the ids of the lower levels
+    QSet<quint64> ids;
+    for (int x = 0; x < 8; x++) {
+        for (int y = 0; y < 8; y++) {
+            const quint64 id = PMTilesArchive::tileId(x, y, 3);
+            QVERIFY((id >= 21) && (id < 85));
+            ids.insert(id);
+        }
+    }
+    QCOMPARE(ids.size(), 64);
+}
+
+void TileArchiveTest::_testPMTilesLookup()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString path = tempDir.filePath(QStringLiteral("test.pmtiles"));
+    QVERIFY(_writePMTiles(path));
+
+    const std::unique_ptr<TileArchive> archive = TileArchive::open(path);
+    QVERIFY(archive);
+    QCOMPARE(archive->name(), QStringLiteral("Test Basemap"));
+    QCOMPARE(archive->format(), QStringLiteral("png"));
+    QCOMPARE(archive->minZoom(), 0);
+    QCOMPARE(archive->maxZoom(), 1);
+
+    QCOMPARE(archive->tile(0, 0, 0), kTileA);
+    QCOMPARE(archive->tile(0, 0, 1), kTileB);
+    QCOMPARE(archive->tile(0, 1, 1), kTileB);
+    QCOMPARE(archive->tile(1, 0, 1), kTileC);
+    QVERIFY(archive->tile(1, 1, 1).isEmpty());
+    QVERIFY(archive->tile(0, 0, 2).isEmpty());
+    QVERIFY(archive->tile(2, 0, 1).isEmpty());
+    QVERIFY(archive->tile(-1, 0, 1).isEmpty());
+
+    // Both tiles of the run are views of the same bytes in the mapping, not copies
+    QCOMPARE(archive->tile(0, 0, 1).constData(), archive->tile(0, 1, 1).constData());
+}
+
+void TileArchiveTest::_testPMTilesRejectsBadFiles()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString badMagic = tempDir.filePath(QStringLiteral("magic.pmtiles"));
+    QVERIFY(_writePMTiles(badMagic, {{0, 'X'}}));
+    QVERIFY(!TileArchive::open(badMagic));
+
+    const QString badVersion = tempDir.filePath(QStringLiteral("version.pmtiles"));
+    QVERIFY(_writePMTiles(badVersion, {{7, 2}}));
+    QVERIFY(!TileArchive::open(badVersion));
+
+    const QString compressedTiles = tempDir.filePath(QStringLiteral("gzip.pmtiles"));
+    QVERIFY(_writePMTiles(compressedTiles, {{98, 2}}));
+    QVERIFY(!TileArchive::open(compressedTiles));
+
+    const QString vectorTiles = tempDir.filePath(QStringLiteral("mvt.pmtiles"));
+    QVERIFY(_writePMTiles(vectorTiles, {{99, 1}}));
+    QVERIFY(!TileArchive::open(vectorTiles));
+
+    // Root directory running past the end of the file
+    const QString badRoot = tempDir.filePath(QStringLiteral("root.pmtiles"));
+    QVERIFY(_writePMTiles(badRoot, {{23, 1}}));
+    QVERIFY(!TileArchive::open(badRoot));
+
+    const QString truncated = tempDir.filePath(QStringLiteral("short.pmtiles"));
+    QFile file(truncated);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    (void) file.write("PMTiles\x03");
+    file.close();
+    QVERIFY(!TileArchive::open(truncated));
+
+    QVERIFY(!TileArchive::open(tempDir.filePath(QStringLiteral("missing.pmtiles"))));
+    QVERIFY(!TileArchive::open(tempDir.filePath(QStringLiteral("tiles.zip"))));
+}
+
+void TileArchiveTest::_testMBTilesLookup()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString path = tempDir.filePath(QStringLiteral("test.mbtiles"));
+    QVERIFY(_writeMBTiles(path, QStringLiteral("Test MBTiles")));
+
+    const std::unique_ptr<TileArchive> archive = TileArchive::open(path);
+    QVERIFY(archive);
+    QCOMPARE(archive->name(), QStringLiteral("Test MBTiles"));
+    QCOMPARE(archive->format(), QStringLiteral("jpg"));
+    QCOMPARE(archive->minZoom(), 0);
+    QCOMPARE(archive->maxZoom(), 2);
+
+    QCOMPARE(archive->tile(1, 1, 1), kTileD);
+    QVERIFY(archive->tile(1, 0, 1).isEmpty());
+    QVERIFY(archive->tile(0, 0, 3).isEmpty());
+}
+
+void TileArchiveTest::_testArchiveProvider()
+{
+    const QString type = QString(TileArchiveMapProvider::kProviderKey);
+    const SharedMapProvider provider = UrlFactory::getMapProviderFromProviderType(type);
+    QVERIFY(provider);
+    QVERIFY(provider->isArchiveProvider());
+    QVERIFY(!provider->getTileURL(1, 1, 1).isEmpty());
+
+    // Cached tiles store map ids, so the archive provider must not take an id an existing provider had
+    for (const SharedMapProvider &other : UrlFactory::getProviders()) {
+        QVERIFY(other->getMapId() <= provider->getMapId());
+    }
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QVERIFY(_writePMTiles(tempDir.filePath(QStringLiteral("a.pmtiles"))));
+    QVERIFY(_writeMBTiles(tempDir.filePath(QStringLiteral("b.mbtiles")), QStringLiteral("Test MBTiles")));
+
+    const qsizetype before = TileArchiveMapProvider::archiveCount();
+    QCOMPARE(TileArchiveMapProvider::loadArchives(tempDir.path()), 2);
+    QCOMPARE(TileArchiveMapProvider::archiveCount(), before + 2);
+    QCOMPARE(TileArchiveMapProvider::loadArchives(tempDir.path()), 0);
+
+    // Neither archive names a map type, so both serve the archive map type, first file first
+    QString format;
+    QCOMPARE(TileArchiveMapProvider::archivedTile(type, 1, 0, 1, format), kTileC);
+    QCOMPARE(format, QStringLiteral("png"));
+    QCOMPARE(TileArchiveMapProvider::archivedTile(type, 1, 1, 1, format), kTileD);
+    QCOMPARE(format, QStringLiteral("jpg"));
+    QVERIFY(TileArchiveMapProvider::archivedTile(type, 3, 3, 2, format).isEmpty());
+    QVERIFY(TileArchiveMapProvider::archivedTile(QStringLiteral("Bing Road"), 1, 0, 1, format).isEmpty());
+}
+
+UT_REGISTER_TEST(TileArchiveTest, TestLabel::Unit)
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QtCore/QMap>
+
+#include "UnitTest.h"
+
+class TileArchiveTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testTileId();
+    void _testPMTilesLookup();
+    void _testPMTilesRejectsBadFiles();
+    void _testMBTilesLookup();
+    void _testArchiveProvider();
+
+private:
+    /// Writes a small PMTiles v3 archive with a root and a leaf directory; @p header patches header bytes
+    static bool _writePMTiles(const QString &path, const QMap<int, quint8> &header = {});
+    static bool _writeMBTiles(const QString &path, const QString &name);
+};
@@ -2,6 +2,7 @@
 
 #include "MapProvider.h"
 #include "QGCMapUrlEngine.h"
+#include "QGCTileKey.h"
 #include "QGCTileSet.h"
 
 static const QString kBingRoad = QStringLiteral("Bing Road");
@@ -110,29 +111,48 @@ void UrlFactoryTest::_testProviderTypeFromInvalidHash()
     verifyExpectedLogMessage();
 }
 
-// --- Tile hash encode/decode ---
+// --- Tile key encode/decode ---
 
-void UrlFactoryTest::_testGetTileHashFormat()
+void UrlFactoryTest::_testGetTileKeyLayout()
 {
-    const QString hash = UrlFactory::getTileHash(kBingRoad, 100, 200, 5);
-    // Format: "%010d%08d%08d%03d" = 10+8+8+3 = 29 chars
-    QCOMPARE(hash.length(), 29);
+    const quint64 key = UrlFactory::getTileKey(kBingRoad, 100, 200, 5);
+    QCOMPARE(QGCTileKey::providerId(key), UrlFactory::hashFromProviderType(kBingRoad));
+    QCOMPARE(QGCTileKey::x(key), 100);
+    QCOMPARE(QGCTileKey::y(key), 200);
+    QCOMPARE(QGCTileKey::zoom(key), 5);
+    // Must round-trip through SQLite's signed INTEGER
+    QVERIFY(static_cast<qint64>(key) >= 0);
+
+    // Zoom 23 spans the full coordinate range without touching the neighbouring fields
+    const int max = (1 << 23) - 1;
+    const quint64 corner = UrlFactory::getTileKey(kBingRoad, max, max, 23);
+    QCOMPARE(QGCTileKey::x(corner), max);
+    QCOMPARE(QGCTileKey::y(corner), max);
+    QCOMPARE(QGCTileKey::zoom(corner), 23);
+}
+
+void UrlFactoryTest::_testTileKeyFromLegacyHash()
+{
+    const int providerId = UrlFactory::hashFromProviderType(kBingRoad);
+    const QString legacy = QString::asprintf("%010d%08d%08d%03d", providerId, 100, 200, 5);
+    QCOMPARE(QGCTileKey::fromLegacyHash(legacy).value_or(0), UrlFactory::getTileKey(kBingRoad, 100, 200, 5));
+    QVERIFY(!QGCTileKey::fromLegacyHash(u"garbage").has_value());
 }
 
-void UrlFactoryTest::_testTileHashToTypeRoundtrip()
+void UrlFactoryTest::_testTileKeyToTypeRoundtrip()
 {
     const QStringList types = UrlFactory::getProviderTypes();
     for (const auto& type : types) {
-        const QString hash = UrlFactory::getTileHash(type, 42, 99, 7);
-        const QString recovered = UrlFactory::tileHashToType(hash);
+        const quint64 key = UrlFactory::getTileKey(type, 42, 99, 7);
+        const QString recovered = UrlFactory::tileKeyToType(key);
         QCOMPARE(recovered, type);
     }
 }
 
-void UrlFactoryTest::_testTileHashToTypeInvalid()
+void UrlFactoryTest::_testTileKeyToTypeInvalid()
 {
     expectLogMessage("QtLocationPlugin.QGCMapUrlEngine", QtWarningMsg, QRegularExpression("provider not found from hash:"));
-    QVERIFY(UrlFactory::tileHashToType(QStringLiteral("garbage")).isEmpty());
+    QVERIFY(UrlFactory::tileKeyToType(QGCTileKey::make(0, 1, 2, 3)).isEmpty());
     verifyExpectedLogMessage();
 }
 
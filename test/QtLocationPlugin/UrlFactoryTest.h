@@ -19,9 +19,10 @@ private slots:
     void _testProviderTypeFromHashRoundtrip();
     void _testHashFromInvalidType();
     void _testProviderTypeFromInvalidHash();
-    void _testGetTileHashFormat();
-    void _testTileHashToTypeRoundtrip();
-    void _testTileHashToTypeInvalid();
+    void _testGetTileKeyLayout();
+    void _testTileKeyFromLegacyHash();
+    void _testTileKeyToTypeRoundtrip();
+    void _testTileKeyToTypeInvalid();
     void _testGetImageFormatByType();
     void _testGetImageFormatByMapId();
     void _testGetImageFormatInvalidInputs();
@@ -0,0 +1,483 @@
+#include "TerrainQueryLocalDemTest.h"
+#include "FlightMapSettings.h"
+#include "SettingsManager.h"
+#include "TerrainDemDirectory.h"
+#include "TerrainQuery.h"
+#include "TerrainQueryLocalDem.h"
+#include "TerrainTileCopernicus.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QtEndian>
+#include <QtTest/QSignalSpy>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+/// Minimal classic TIFF writer: one IFD, out-of-line values after it, then the pixel blocks
+class TiffWriter
+{
+public:
+    enum Type : quint16 { Ascii = 2, Short = 3, Long = 4, Double = 12 };
+
+    explicit TiffWriter(bool bigEndian) : _bigEndian(bigEndian) {}
+
+    QByteArray u16(quint16 value) const
+    {
+        QByteArray bytes(2, '\0');
+        _bigEndian ? qToBigEndian(value, bytes.data()) : qToLittleEndian(value, bytes.data());
+        return bytes;
+    }
+
+    QByteArray u32(quint32 value) const
+    {
+        QByteArray bytes(4, '\0');
+        _bigEndian ? qToBigEndian(value, bytes.data()) : qToLittleEndian(value, bytes.data());
+        return bytes;
+    }
+
+    QByteArray f64(double value) const
+    {
+        quint64 bits;
+        (void) memcpy(&bits, &value, sizeof(bits));
+        QByteArray bytes(8, '\0');
+        _bigEndian ? qToBigEndian(bits, bytes.data()) : qToLittleEndian(bits, bytes.data());
+        return bytes;
+    }
+
+    void add(quint16 tag, Type type, quint32 count, const QByteArray &bytes) { _entries.append({tag, type, count, bytes}); }
+    void addShort(quint16 tag, quint16 value) { add(tag, Short, 1, u16(value)); }
+    void addLong(quint16 tag, quint32 value) { add(tag, Long, 1, u32(value)); }
+
+    /// @param blockOffsets offsets of each block within @p pixels
+    QByteArray build(quint16 offsetsTag, const QList<quint32> &blockOffsets, const QByteArray &pixels)
+    {
+        add(offsetsTag, Long, static_cast<quint32>(blockOffsets.size()), QByteArray(blockOffsets.size() * 4, '\0'));
+        std::sort(_entries.begin(), _entries.end(), [](const Entry &a, const Entry &b) { return a.tag < b.tag; });
+
+        const quint32 ifdOffset = 8;
+        quint32 dataOffset = ifdOffset + 2 + (static_cast<quint32>(_entries.size()) * 12) + 4;
+        quint32 pixelsOffset = dataOffset;
+        for (Entry &entry : _entries) {
+            if (entry.bytes.size() % 2) {
+                entry.bytes.append('\0');
+            }
+            if (entry.bytes.size() > 4) {
+                pixelsOffset += static_cast<quint32>(entry.bytes.size());
+            }
+        }
+
+        for (Entry &entry : _entries) {
+            if (entry.tag == offsetsTag) {
+                entry.bytes.clear();
+                for (const quint32 offset : blockOffsets) {
+                    entry.bytes += u32(pixelsOffset + offset);
+                }
+            }
+        }
+
+        QByteArray tiff = _bigEndian ? QByteArray("MM") : QByteArray("II");
+        tiff += u16(42) + u32(ifdOffset) + u16(static_cast<quint16>(_entries.size()));
+        QByteArray outOfLine;
+        for (const Entry &entry : _entries) {
+            tiff += u16(entry.tag) + u16(entry.type) + u32(entry.count);
+            if (entry.bytes.size() > 4) {
+                tiff += u32(dataOffset + static_cast<quint32>(outOfLine.size()));
+                outOfLine += entry.bytes;
+            } else {
+                tiff += entry.bytes.leftJustified(4, '\0');
+            }
+        }
+        tiff += u32(0) + outOfLine + pixels;
+        return tiff;
+    }
+
+private:
+    struct Entry
+    {
+        quint16 tag;
+        Type type;
+        quint32 count;
+        QByteArray bytes;
+    };
+
+    bool _bigEndian;
+    QList<Entry> _entries;
+};
+
+}  // namespace
+
+void TerrainQueryLocalDemTest::init()
+{
+    TerrainTest::init();
+
+    _demDir = new QTemporaryDir();
+    QVERIFY(_demDir->isValid());
+
+    // Point Nemo cell: flat 10m with one void sample in the far corner
+    QVERIFY(_writeHgt(_demDir->path(), -49, -124, kHgtSamples, [](int row, int col) {
+        return ((row == kVoidRow) && (col == kVoidCol)) ? TerrainDemDirectory::kVoidValue : static_cast<int16_t>(UnitTestTerrainQuery::Flat10Region::amslElevation);
+    }));
+}
+
+void TerrainQueryLocalDemTest::cleanup()
+{
+    SettingsManager::instance()->flightMapSettings()->localDemDirectory()->setRawValue(QString());
+
+    delete _demDir;
+    _demDir = nullptr;
+
+    TerrainTest::cleanup();
+}
+
+bool TerrainQueryLocalDemTest::_writeHgt(const QString &dirPath, int lat, int lon, int samples, const SampleFunction &sample)
+{
+    const QString name = QStringLiteral("%1%2%3%4.hgt")
+                             .arg(lat < 0 ? QLatin1Char('S') : QLatin1Char('N'))
+                             .arg(qAbs(lat), 2, 10, QLatin1Char('0'))
+                             .arg(lon < 0 ? QLatin1Char('W') : QLatin1Char('E'))
+                             .arg(qAbs(lon), 3, 10, QLatin1Char('0'));
+
+    QByteArray data(static_cast<qsizetype>(samples) * samples * 2, '\0');
+    for (int row = 0; row < samples; row++) {
+        for (int col = 0; col < samples; col++) {
+            qToBigEndian(sample(row, col), data.data() + ((static_cast<qsizetype>(row) * samples + col) * 2));
+        }
+    }
+
+    QFile file(QDir(dirPath).filePath(name));
+    return file.open(QIODevice::WriteOnly) && (file.write(data) == data.size());
+}
+
+bool TerrainQueryLocalDemTest::_writeGeoTiff(const QString &fileName, const GeoTiffSpec &spec, const SampleFunction &sample)
+{
+    TiffWriter writer(spec.bigEndian);
+    writer.addLong(256, static_cast<quint32>(spec.width));     // ImageWidth
+    writer.addLong(257, static_cast<quint32>(spec.height));    // ImageLength
+    writer.addShort(258, 16);                                   // BitsPerSample
+    writer.addShort(259, 1);                                    // Compression: none
+    writer.addShort(277, 1);                                    // SamplesPerPixel
+    writer.addShort(339, 2);                                    // SampleFormat: signed integer
+
+    writer.add(33550, TiffWriter::Double, 3, writer.f64(spec.spacing) + writer.f64(spec.spacing) + writer.f64(0.0));
+    writer.add(33922, TiffWriter::Double, 6, writer.f64(0.0) + writer.f64(0.0) + writer.f64(0.0) +
+                                             writer.f64(spec.west) + writer.f64(spec.north) + writer.f64(0.0));
+
+    QByteArray geoKeys;
+    for (const quint16 value : {1, 1, 0, 2, 1024, 0, 1, 2, 1025, 0, 1, spec.pixelIsPoint ? 2 : 1}) {
+        geoKeys += writer.u16(value);
+    }
+    writer.add(34735, TiffWriter::Short, 12, geoKeys);
+
+    if (!spec.noData.isEmpty()) {
+        writer.add(42113, TiffWriter::Ascii, static_cast<quint32>(spec.noData.size() + 1), spec.noData + '\0');
+    }
+
+    const auto appendSample = [&](QByteArray &pixels, int row, int col) {
+        const int16_t value = ((row < spec.height) && (col < spec.width)) ? sample(row, col) : 0;
+        pixels += writer.u16(static_cast<quint16>(value));
+    };
+
+    QByteArray pixels;
+    QList<quint32> blockOffsets;
+    quint16 offsetsTag;
+    if (spec.tileSize > 0) {
+        writer.addShort(322, static_cast<quint16>(spec.tileSize));  // TileWidth
+        writer.addShort(323, static_cast<quint16>(spec.tileSize));  // TileLength
+        offsetsTag = 324;                                           // TileOffsets
+
+        const int tilesAcross = (spec.width + spec.tileSize - 1) / spec.tileSize;
+        const int tilesDown = (spec.height + spec.tileSize - 1) / spec.tileSize;
+        for (int tileRow = 0; tileRow < tilesDown; tileRow++) {
+            for (int tileCol = 0; tileCol < tilesAcross; tileCol++) {
+                blockOffsets.append(static_cast<quint32>(pixels.size()));
+                for (int row = 0; row < spec.tileSize; row++) {
+                    for (int col = 0; col < spec.tileSize; col++) {
+                        appendSample(pixels, (tileRow * spec.tileSize) + row, (tileCol * spec.tileSize) + col);
+                    }
+                }
+            }
+        }
+    } else {
+        writer.addLong(278, static_cast<quint32>(spec.rowsPerStrip));   // RowsPerStrip
+        offsetsTag = 273;                                               // StripOffsets
+
+        for (int row = 0; row < spec.height; row++) {
+            if ((row % spec.rowsPerStrip) == 0) {
+                blockOffsets.append(static_cast<quint32>(pixels.size()));
+            }
+            for (int col = 0; col < spec.width; col++) {
+                appendSample(pixels, row, col);
+            }
+        }
+    }
+
+    const QByteArray tiff = writer.build(offsetsTag, blockOffsets, pixels);
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && (file.write(tiff) == tiff.size());
+}
+
+void TerrainQueryLocalDemTest::_testRequestCoordinateHeights()
+{
+    TerrainQueryLocalDem query(_demDir->path());
+    QSignalSpy spy(&query, &TerrainQueryInterface::coordinateHeightsReceived);
+    QVERIFY(spy.isValid());
+
+    const QList<QGeoCoordinate> coords = {pointNemo(), flat10Region().center()};
+    query.requestCoordinateHeights(coords);
+
+    QCOMPARE(spy.count(), 1);
+    const QVariantList arguments = spy.takeFirst();
+    QVERIFY(arguments.at(0).toBool());
+    const QList<double> heights = arguments.at(1).value<QList<double>>();
+    QCOMPARE(heights.size(), coords.size());
+    QCOMPARE(heights.at(0), UnitTestTerrainQuery::Flat10Region::amslElevation);
+    QCOMPARE(heights.at(1), UnitTestTerrainQuery::Flat10Region::amslElevation);
+}
+
+void TerrainQueryLocalDemTest::_testRequestCoordinateHeightsUncovered()
+{
+    TerrainQueryLocalDem query(_demDir->path());
+    QSignalSpy spy(&query, &TerrainQueryInterface::coordinateHeightsReceived);
+    QVERIFY(spy.isValid());
+
+    query.requestCoordinateHeights({pointNemo(), QGeoCoordinate(47.5, 8.5)});
+
+    QCOMPARE(spy.count(), 1);
+    const QVariantList arguments = spy.takeFirst();
+    QVERIFY(!arguments.at(0).toBool());
+    QVERIFY(arguments.at(1).value<QList<double>>().isEmpty());
+}
+
+void TerrainQueryLocalDemTest::_testRequestPathHeights()
+{
+    TerrainQueryLocalDem query(_demDir->path());
+    QSignalSpy spy(&query, &TerrainQueryInterface::pathHeightsReceived);
+    QVERIFY(spy.isValid());
+
+    const QGeoCoordinate from = pointNemo();
+    const QGeoCoordinate to(pointNemo().latitude(), pointNemo().longitude() + UnitTestTerrainQuery::regionSizeDeg);
+    query.requestPathHeights(from, to);
+
+    QCOMPARE(spy.count(), 1);
+    const QVariantList arguments = spy.takeFirst();
+    QVERIFY(arguments.at(0).toBool());
+    QVERIFY(arguments.at(1).toDouble() > 0.);
+    QVERIFY(arguments.at(2).toDouble() > 0.);
+    const QList<double> heights = arguments.at(3).value<QList<double>>();
+    QVERIFY(heights.size() > 2);
+    QCOMPARE(heights.constFirst(), UnitTestTerrainQuery::Flat10Region::amslElevation);
+    QCOMPARE(heights.constLast(), UnitTestTerrainQuery::Flat10Region::amslElevation);
+}
+
+void TerrainQueryLocalDemTest::_testRequestPathHeightsSpacing()
+{
+    TerrainQueryLocalDem query(_demDir->path());
+    QSignalSpy spy(&query, &TerrainQueryInterface::pathHeightsReceived);
+    QVERIFY(spy.isValid());
+
+    const QGeoCoordinate from = pointNemo();
+    const QGeoCoordinate to(pointNemo().latitude(), pointNemo().longitude() + UnitTestTerrainQuery::regionSizeDeg);
+    query.requestPathHeights(from, to);
+
+    QCOMPARE(spy.count(), 1);
+    const QVariantList arguments = spy.takeFirst();
+    QVERIFY(arguments.at(0).toBool());
+    QVERIFY(qAbs(arguments.at(1).toDouble() - TerrainTileCopernicus::kTileValueSpacingMeters) < 2.0);
+    QVERIFY(qAbs(arguments.at(2).toDouble() - TerrainTileCopernicus::kTileValueSpacingMeters) < 2.0);
+}
+
+void TerrainQueryLocalDemTest::_testRequestCarpetHeights()
+{
+    TerrainQueryLocalDem query(_demDir->path());
+    QSignalSpy spy(&query, &TerrainQueryInterface::carpetHeightsReceived);
+    QVERIFY(spy.isValid());
+
+    query.requestCarpetHeights(pointNemo(), _carpetNe(), false);
+
+    QCOMPARE(spy.count(), 1);
+    const QVariantList arguments = spy.takeFirst();
+    QVERIFY(arguments.at(0).toBool());
+    QCOMPARE(arguments.at(1).toDouble(), UnitTestTerrainQuery::Flat10Region::amslElevation);
+    QCOMPARE(arguments.at(2).toDouble(), UnitTestTerrainQuery::Flat10Region::amslElevation);
+    const QList<QList<double>> carpet = arguments.at(3).value<QList<QList<double>>>();
+    QVERIFY(carpet.size() > 1);
+    QVERIFY(carpet.constFirst().size() > 1);
+    QCOMPARE(carpet.constFirst().constFirst(), UnitTestTerrainQuery::Flat10Region::amslElevation);
+}
+
+void TerrainQueryLocalDemTest::_testRequestCarpetHeightsStatsOnly()
+{
+    TerrainQueryLocalDem query(_demDir->path());
+    QSignalSpy spy(&query, &TerrainQueryInterface::carpetHeightsReceived);
+    QVERIFY(spy.isValid());
+
+    query.requestCarpetHeights(pointNemo(), _carpetNe(), true);
+
+    QCOMPARE(spy.count(), 1);
+    const QVariantList arguments = spy.takeFirst();
+    QVERIFY(arguments.at(0).toBool());
+    QCOMPARE(arguments.at(1).toDouble(), UnitTestTerrainQuery::Flat10Region::amslElevation);
+    QCOMPARE(arguments.at(2).toDouble(), UnitTestTerrainQuery::Flat10Region::amslElevation);
+    QVERIFY(arguments.at(3).value<QList<QList<double>>>().isEmpty());
+}
+
+void TerrainQueryLocalDemTest::_testRequestCarpetHeightsInvalidBounds()
+{
+    TerrainQueryLocalDem query(_demDir->path());
+    QSignalSpy spy(&query, &TerrainQueryInterface::carpetHeightsReceived);
+    QVERIFY(spy.isValid());
+
+    // SW and NE are reversed
+    expectLogMessage("Terrain.TerrainTileManager", QtWarningMsg, QRegularExpression("Invalid carpet bounds"));
+    query.requestCarpetHeights(_carpetNe(), pointNemo(), false);
+    verifyExpectedLogMessage();
+
+    QCOMPARE(spy.count(), 1);
+    const QVariantList arguments = spy.takeFirst();
+    QVERIFY(!arguments.at(0).toBool());
+    QVERIFY(qIsNaN(arguments.at(1).toDouble()));
+    QVERIFY(qIsNaN(arguments.at(2).toDouble()));
+}
+
+void TerrainQueryLocalDemTest::_testVoidSamples()
+{
+    const std::shared_ptr<const TerrainDemDirectory> directory = TerrainDemDirectory::shared(_demDir->path());
+    QCOMPARE(directory->fileCount(), qsizetype(1));
+
+    constexpr double spacing = 1.0 / (kHgtSamples - 1);
+    const QGeoCoordinate voidSample(-48.0, -124.0);
+
+    // The void itself and anything interpolated from it has no elevation
+    QVERIFY(qIsNaN(directory->elevation(voidSample)));
+    QVERIFY(qIsNaN(directory->elevation(QGeoCoordinate(voidSample.latitude() - (spacing / 2), voidSample.longitude() + (spacing / 2)))));
+    QCOMPARE(directory->elevation(QGeoCoordinate(voidSample.latitude() - (2 * spacing), voidSample.longitude() + (2 * spacing))),
+             UnitTestTerrainQuery::Flat10Region::amslElevation);
+
+    TerrainQueryLocalDem query(_demDir->path());
+    QSignalSpy spy(&query, &TerrainQueryInterface::coordinateHeightsReceived);
+    QVERIFY(spy.isValid());
+    query.requestCoordinateHeights({pointNemo(), voidSample});
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(!spy.takeFirst().at(0).toBool());
+}
+
+void TerrainQueryLocalDemTest::_testInvalidCoordinates()
+{
+    const std::shared_ptr<const TerrainDemDirectory> directory = TerrainDemDirectory::shared(_demDir->path());
+
+    // Invalid coordinates are missing without a file lookup and do not disturb the valid ones around them
+    const QList<QGeoCoordinate> coords = {pointNemo(), QGeoCoordinate(), QGeoCoordinate(qQNaN(), pointNemo().longitude()), pointNemo()};
+    QList<double> heights(coords.size(), 0.);
+    QCOMPARE(directory->elevations(coords, heights), qsizetype(2));
+    QCOMPARE(heights.at(0), UnitTestTerrainQuery::Flat10Region::amslElevation);
+    QVERIFY(qIsNaN(heights.at(1)));
+    QVERIFY(qIsNaN(heights.at(2)));
+    QCOMPARE(heights.at(3), UnitTestTerrainQuery::Flat10Region::amslElevation);
+}
+
+void TerrainQueryLocalDemTest::_testGeoTiffTiledLittleEndian()
+{
+    GeoTiffSpec spec;
+    spec.tileSize = 16;
+    spec.west = -122.5;
+    spec.north = -48.5;
+    QVERIFY(_writeGeoTiff(QDir(_demDir->path()).filePath(QStringLiteral("slope.tif")), spec,
+                          [](int row, int col) { return static_cast<int16_t>((col * 3) - row); }));
+
+    const std::shared_ptr<const TerrainDemDirectory> directory = TerrainDemDirectory::shared(_demDir->path());
+    QCOMPARE(directory->fileCount(), qsizetype(2));
+
+    // Samples are linear in row and column, so bilinear interpolation is exact anywhere, including across tiles
+    const auto expected = [](double row, double col) { return (col * 3) - row; };
+    const auto coordinate = [&](double row, double col) {
+        return QGeoCoordinate(spec.north - (row * spec.spacing), spec.west + (col * spec.spacing));
+    };
+    for (const auto &[row, col] : {std::pair{0.0, 0.0}, std::pair{20.25, 10.5}, std::pair{15.5, 15.5}, std::pair{47.0, 63.0}}) {
+        QVERIFY(qAbs(directory->elevation(coordinate(row, col)) - expected(row, col)) < 1e-6);
+    }
+    QVERIFY(qIsNaN(directory->elevation(coordinate(48.5, 10.0))));
+
+    TerrainQueryLocalDem query(_demDir->path());
+    QSignalSpy spy(&query, &TerrainQueryInterface::pathHeightsReceived);
+    QVERIFY(spy.isValid());
+    query.requestPathHeights(coordinate(20.0, 2.0), coordinate(20.0, 60.0));
+    QCOMPARE(spy.count(), 1);
+    const QVariantList arguments = spy.takeFirst();
+    QVERIFY(arguments.at(0).toBool());
+    const QList<double> heights = arguments.at(3).value<QList<double>>();
+    QVERIFY(heights.size() > 2);
+    QVERIFY(qAbs(heights.constFirst() - expected(20.0, 2.0)) < 0.01);
+    QVERIFY(qAbs(heights.constLast() - expected(20.0, 60.0)) < 0.01);
+    QVERIFY(std::is_sorted(heights.cbegin(), heights.cend()));
+}
+
+void TerrainQueryLocalDemTest::_testGeoTiffStrippedBigEndian()
+{
+    GeoTiffSpec spec;
+    spec.bigEndian = true;
+    spec.pixelIsPoint = false;
+    spec.west = -121.5;
+    spec.north = -48.5;
+    spec.noData = "-9999";
+    QVERIFY(_writeGeoTiff(QDir(_demDir->path()).filePath(QStringLiteral("strips.tiff")), spec,
+                          [](int row, int col) { return static_cast<int16_t>(((row == 5) && (col == 5)) ? -9999 : (100 + (row * 2))); }));
+
+    const std::shared_ptr<const TerrainDemDirectory> directory = TerrainDemDirectory::shared(_demDir->path());
+    QCOMPARE(directory->fileCount(), qsizetype(2));
+
+    // PixelIsArea: the tie point is the corner of the first pixel, samples sit at pixel centres
+    const auto pixelCentre = [&](int row, int col) {
+        return QGeoCoordinate(spec.north - ((row + 0.5) * spec.spacing), spec.west + ((col + 0.5) * spec.spacing));
+    };
+    QVERIFY(qAbs(directory->elevation(pixelCentre(3, 7)) - 106.0) < 1e-6);
+    QVERIFY(qAbs(directory->elevation(pixelCentre(spec.height - 1, 0)) - (100.0 + ((spec.height - 1) * 2))) < 1e-6);
+    QVERIFY(qIsNaN(directory->elevation(pixelCentre(5, 5))));
+    QVERIFY(qAbs(directory->elevation(pixelCentre(5, 7)) - 110.0) < 1e-6);
+
+    // The outer half pixel is covered and holds the edge sample
+    QVERIFY(qAbs(directory->elevation(QGeoCoordinate(spec.north - (spec.spacing / 4), spec.west + (spec.spacing / 4))) - 100.0) < 1e-6);
+}
+
+void TerrainQueryLocalDemTest::_testTerrainAtCoordinateQuery()
+{
+    Fact *const demDirectoryFact = SettingsManager::instance()->flightMapSettings()->localDemDirectory();
+    demDirectoryFact->setRawValue(_demDir->path());
+
+    QList<QGeoCoordinate> coordinates = {pointNemo(), QGeoCoordinate(pointNemo().latitude() - 0.01, pointNemo().longitude() + 0.01)};
+
+    QList<double> altitudes;
+    bool error = true;
+    QVERIFY(TerrainAtCoordinateQuery::getAltitudesForCoordinates(coordinates, altitudes, error));
+    QVERIFY(!error);
+    QCOMPARE(altitudes.size(), coordinates.size());
+    QCOMPARE(altitudes.at(0), UnitTestTerrainQuery::Flat10Region::amslElevation);
+
+    TerrainAtCoordinateQuery *const query = new TerrainAtCoordinateQuery(true, this);
+    QSignalSpy spy(query, &TerrainAtCoordinateQuery::terrainDataReceived);
+    QVERIFY(spy.isValid());
+    query->requestData(coordinates);
+
+    QVERIFY_SIGNAL_WAIT(spy, TestTimeout::mediumMs());
+    const QVariantList arguments = spy.takeFirst();
+    QVERIFY(arguments.at(0).toBool());
+    const QList<double> heights = arguments.at(1).value<QList<double>>();
+    QCOMPARE(heights.size(), coordinates.size());
+    QCOMPARE(heights.at(0), UnitTestTerrainQuery::Flat10Region::amslElevation);
+    QCOMPARE(heights.at(1), UnitTestTerrainQuery::Flat10Region::amslElevation);
+
+    // Synchronous lookups reuse the opened directory until the setting changes
+    TerrainAtCoordinateBatchManager *const batchManager = TerrainAtCoordinateBatchManager::instance();
+    const std::shared_ptr<const TerrainDemDirectory> directory = batchManager->demDirectory();
+    QVERIFY(directory);
+    QVERIFY(TerrainAtCoordinateQuery::getAltitudesForCoordinates(coordinates, altitudes, error));
+    QCOMPARE(batchManager->demDirectory(), directory);
+
+    demDirectoryFact->setRawValue(QString());
+    QVERIFY(!batchManager->demDirectory());
+}
+
+UT_REGISTER_TEST(TerrainQueryLocalDemTest, TestLabel::Unit, TestLabel::Terrain)
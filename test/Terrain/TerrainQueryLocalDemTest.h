@@ -0,0 +1,58 @@
+#pragma once
+
+#include "BaseClasses/TerrainTest.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <functional>
+
+class TerrainQueryLocalDemTest : public TerrainTest
+{
+    Q_OBJECT
+
+private slots:
+    void init() override;
+    void cleanup() override;
+
+    void _testRequestCoordinateHeights();
+    void _testRequestCoordinateHeightsUncovered();
+    void _testRequestPathHeights();
+    void _testRequestPathHeightsSpacing();
+    void _testRequestCarpetHeights();
+    void _testRequestCarpetHeightsStatsOnly();
+    void _testRequestCarpetHeightsInvalidBounds();
+    void _testVoidSamples();
+    void _testInvalidCoordinates();
+    void _testGeoTiffTiledLittleEndian();
+    void _testGeoTiffStrippedBigEndian();
+    void _testTerrainAtCoordinateQuery();
+
+private:
+    using SampleFunction = std::function<int16_t(int row, int col)>;
+
+    struct GeoTiffSpec
+    {
+        bool bigEndian = false;
+        int tileSize = 0;           ///< 0: strips of rowsPerStrip rows
+        int rowsPerStrip = 7;
+        bool pixelIsPoint = true;
+        double west = 0.0;
+        double north = 0.0;
+        double spacing = 0.001;
+        int width = 64;
+        int height = 48;
+        QByteArray noData;          ///< GDAL_NODATA text, empty for none
+    };
+
+    /// Writes an SRTM .hgt for the 1 degree cell with south-west corner (@p lat, @p lon)
+    static bool _writeHgt(const QString &dirPath, int lat, int lon, int samples, const SampleFunction &sample);
+    static bool _writeGeoTiff(const QString &fileName, const GeoTiffSpec &spec, const SampleFunction &sample);
+
+    static QGeoCoordinate _carpetNe() { return QGeoCoordinate(pointNemo().latitude() + 0.01, pointNemo().longitude() + 0.01); }
+
+    QTemporaryDir *_demDir = nullptr;
+
+    static constexpr int kHgtSamples = 121;     ///< 30 arc-second grid keeps the fixture small
+    static constexpr int kVoidRow = 0;          ///< North-west corner sample of the Point Nemo cell is void
+    static constexpr int kVoidCol = 0;
+};
@@ -0,0 +1,106 @@
+#include "TerrainTileManagerTest.h"
+#include "TerrainTile.h"
+#include "TerrainTileManager.h"
+
+#include <QtPositioning/QGeoCoordinate>
+
+QByteArray TerrainTileManagerTest::_createTileData(double swLat, double swLon)
+{
+    // Same shape as a Copernicus tile: 0.01 degrees at 1 arc-second spacing
+    constexpr int16_t kGridSize = 36;
+    constexpr int headerSize = static_cast<int>(sizeof(TerrainTile::TileInfo_t));
+    constexpr int dataSize = static_cast<int>(sizeof(int16_t)) * kGridSize * kGridSize;
+
+    QByteArray result(headerSize + dataSize, '\0');
+    TerrainTile::TileInfo_t* header = reinterpret_cast<TerrainTile::TileInfo_t*>(result.data());
+    header->swLat = swLat;
+    header->swLon = swLon;
+    header->neLat = swLat + 0.01;
+    header->neLon = swLon + 0.01;
+    header->minElevation = 0;
+    header->maxElevation = 0;
+    header->avgElevation = 0;
+    header->gridSizeLat = kGridSize;
+    header->gridSizeLon = kGridSize;
+    return result;
+}
+
+void TerrainTileManagerTest::_testTileKey()
+{
+    const quint64 key = TerrainTileManager::tileKey(7, 36000, 18000);
+    QCOMPARE(key, TerrainTileManager::tileKey(7, 36000, 18000));
+    QVERIFY(key != TerrainTileManager::tileKey(7, 18000, 36000));
+    QVERIFY(key != TerrainTileManager::tileKey(8, 36000, 18000));
+    QVERIFY(TerrainTileManager::tileKey(7, 1, 0) != TerrainTileManager::tileKey(7, 0, 1));
+}
+
+void TerrainTileManagerTest::_testHitsAndMisses()
+{
+    TerrainTileManager manager;
+    const quint64 key = TerrainTileManager::tileKey(1, 10, 20);
+
+    QVERIFY(!manager._getCachedTile(key));
+    manager._cacheTile(_createTileData(10.0, 20.0), key);
+    const std::shared_ptr<const TerrainTile> tile = manager._getCachedTile(key);
+    QVERIFY(tile);
+    QVERIFY(tile->isValid());
+
+    const TerrainTileManager::TileCacheStats stats = manager.tileCacheStats();
+    QCOMPARE(stats.hits, quint64(1));
+    QCOMPARE(stats.misses, quint64(1));
+    QCOMPARE(stats.evictions, quint64(0));
+    QCOMPARE(stats.tileCount, qsizetype(1));
+    QCOMPARE(stats.bytes, tile->memoryBytes());
+}
+
+void TerrainTileManagerTest::_testEvictsLeastRecentlyUsed()
+{
+    TerrainTileManager manager;
+
+    const quint64 key1 = TerrainTileManager::tileKey(1, 1, 1);
+    const quint64 key2 = TerrainTileManager::tileKey(1, 2, 1);
+    const quint64 key3 = TerrainTileManager::tileKey(1, 3, 1);
+
+    manager._cacheTile(_createTileData(0.0, 0.0), key1);
+    const qsizetype tileBytes = manager.tileCacheStats().bytes;
+    manager.setTileCacheMaxBytes(tileBytes * 2);
+
+    manager._cacheTile(_createTileData(0.0, 0.01), key2);
+    std::shared_ptr<const TerrainTile> heldTile = manager._getCachedTile(key1);    // key2 is now least recently used
+    QVERIFY(heldTile);
+
+    manager._cacheTile(_createTileData(0.0, 0.02), key3);
+    QVERIFY(manager._getCachedTile(key1));
+    QVERIFY(!manager._getCachedTile(key2));
+    QVERIFY(manager._getCachedTile(key3));
+
+    const TerrainTileManager::TileCacheStats stats = manager.tileCacheStats();
+    QCOMPARE(stats.evictions, quint64(1));
+    QCOMPARE(stats.tileCount, qsizetype(2));
+    QVERIFY(stats.bytes <= stats.maxBytes);
+
+    // A tile handed out before eviction stays usable
+    manager.setTileCacheMaxBytes(0);
+    QCOMPARE(manager.tileCacheStats().tileCount, qsizetype(0));
+    QVERIFY(heldTile->isValid());
+    QCOMPARE(heldTile->elevation(QGeoCoordinate(0.005, 0.005)), 0.0);
+}
+
+void TerrainTileManagerTest::_testShrinkingBudgetEvicts()
+{
+    TerrainTileManager manager;
+    for (int i = 0; i < 10; i++) {
+        manager._cacheTile(_createTileData(0.0, i * 0.01), TerrainTileManager::tileKey(1, i, 0));
+    }
+    const TerrainTileManager::TileCacheStats before = manager.tileCacheStats();
+    QCOMPARE(before.tileCount, qsizetype(10));
+
+    manager.setTileCacheMaxBytes(before.bytes / 2);
+    const TerrainTileManager::TileCacheStats after = manager.tileCacheStats();
+    QCOMPARE(after.tileCount, qsizetype(5));
+    QCOMPARE(after.evictions, quint64(5));
+    QVERIFY(manager._getCachedTile(TerrainTileManager::tileKey(1, 9, 0)));
+    QVERIFY(!manager._getCachedTile(TerrainTileManager::tileKey(1, 0, 0)));
+}
+
+UT_REGISTER_TEST(TerrainTileManagerTest, TestLabel::Unit, TestLabel::Terrain)
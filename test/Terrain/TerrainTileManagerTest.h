@@ -0,0 +1,17 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class TerrainTileManagerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testTileKey();
+    void _testHitsAndMisses();
+    void _testEvictsLeastRecentlyUsed();
+    void _testShrinkingBudgetEvicts();
+
+private:
+    static QByteArray _createTileData(double swLat, double swLon);
+};
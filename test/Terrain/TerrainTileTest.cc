@@ -1,4 +1,7 @@
 #include "TerrainTileTest.h"
+#include "Benchmarking.h"
+
+#include <QtPositioning/QGeoCoordinate>
 
 QByteArray TerrainTileTest::_createValidTileData(double swLat, double swLon, double neLat, double neLon,
                                                  int16_t minElev, int16_t maxElev, double avgElev, int16_t gridSizeLat,
@@ -24,6 +27,20 @@ QByteArray TerrainTileTest::_createValidTileData(double swLat, double swLon, dou
     return result;
 }
 
+QByteArray TerrainTileTest::_createGradientTileData(double swLat, double swLon, double neLat, double neLon,
+                                                    int16_t gridSizeLat, int16_t gridSizeLon)
+{
+    const int16_t maxElev = static_cast<int16_t>(((gridSizeLat - 1) * 100) + (gridSizeLon - 1));
+    QByteArray result = _createValidTileData(swLat, swLon, neLat, neLon, 0, maxElev, maxElev / 2.0, gridSizeLat, gridSizeLon, 0);
+    int16_t* elevData = reinterpret_cast<int16_t*>(result.data() + sizeof(TerrainTile::TileInfo_t));
+    for (int row = 0; row < gridSizeLat; ++row) {
+        for (int col = 0; col < gridSizeLon; ++col) {
+            elevData[(row * gridSizeLon) + col] = static_cast<int16_t>((row * 100) + col);
+        }
+    }
+    return result;
+}
+
 void TerrainTileTest::_testValidTile()
 {
     const QByteArray tileData = _createValidTileData(-48.88, -123.40, -48.87, -123.39, 10, 100, 55.0, 10, 10, 50);
@@ -186,4 +203,92 @@ void TerrainTileTest::_testInvalidTileElevation()
     QVERIFY(qIsNaN(tile.avgElevation()));
 }
 
+void TerrainTileTest::_testGridIsRowMajor()
+{
+    // 10 x 20 grid, 0.001 degree cells
+    const QByteArray tileData = _createGradientTileData(10.0, 20.0, 10.01, 20.02, 10, 20);
+    TerrainTile tile(tileData);
+    QVERIFY(tile.isValid());
+
+    // Exactly on a grid value, interpolation returns that value
+    QCOMPARE(tile.elevation(QGeoCoordinate(10.0, 20.0)), 0.0);
+    QCOMPARE_FUZZY(tile.elevation(QGeoCoordinate(10.003, 20.0)), 300.0, 1e-6);
+    QCOMPARE_FUZZY(tile.elevation(QGeoCoordinate(10.0, 20.007)), 7.0, 1e-6);
+    QCOMPARE_FUZZY(tile.elevation(QGeoCoordinate(10.009, 20.019)), 919.0, 1e-6);
+}
+
+void TerrainTileTest::_testBilinearInterpolation()
+{
+    const QByteArray tileData = _createGradientTileData(10.0, 20.0, 10.01, 20.02, 10, 20);
+    TerrainTile tile(tileData);
+    QVERIFY(tile.isValid());
+
+    // Halfway between rows 2 and 3 and a quarter of the way between columns 4 and 5
+    QCOMPARE_FUZZY(tile.elevation(QGeoCoordinate(10.0025, 20.00425)), 254.25, 1e-6);
+
+    // The last row and column have no neighbour to interpolate towards
+    QCOMPARE_FUZZY(tile.elevation(QGeoCoordinate(10.0095, 20.0195)), 919.0, 1e-6);
+}
+
+void TerrainTileTest::_testBatchMatchesSingle()
+{
+    const QByteArray tileData = _createGradientTileData(10.0, 20.0, 10.01, 20.02, 10, 20);
+    TerrainTile tile(tileData);
+    QVERIFY(tile.isValid());
+
+    QList<QGeoCoordinate> coordinates;
+    for (int i = 0; i < 1000; ++i) {
+        coordinates.append(QGeoCoordinate(10.0 + ((i % 97) * 0.0001), 20.0 + ((i % 193) * 0.0001)));
+    }
+    coordinates.append(QGeoCoordinate(9.0, 20.0));
+    coordinates.append(QGeoCoordinate(10.005, 20.03));
+
+    QList<double> elevations(coordinates.size());
+    QCOMPARE(tile.elevations(coordinates, elevations), qsizetype(2));
+
+    for (qsizetype i = 0; i < (coordinates.size() - 2); ++i) {
+        QCOMPARE(elevations[i], tile.elevation(coordinates[i]));
+    }
+    QVERIFY(qIsNaN(elevations[coordinates.size() - 2]));
+    QVERIFY(qIsNaN(elevations[coordinates.size() - 1]));
+}
+
+void TerrainTileTest::_benchmarkSurveyCarpet()
+{
+    // 10 km survey carpet at the 1 arc-second terrain spacing, sampled from a single tile covering it
+    constexpr double kCarpetDegrees = 0.09;
+    constexpr int kGridSize = 324;
+    constexpr double kSpacingDegrees = 1.0 / 3600.0;
+
+    const QByteArray tileData = _createGradientTileData(47.0, 8.0, 47.0 + kCarpetDegrees, 8.0 + kCarpetDegrees, kGridSize, kGridSize);
+    TerrainTile tile(tileData);
+    QVERIFY(tile.isValid());
+
+    QList<QGeoCoordinate> carpet;
+    const int samples = static_cast<int>(kCarpetDegrees / kSpacingDegrees);
+    carpet.reserve(samples * samples);
+    for (int latIdx = 0; latIdx < samples; latIdx++) {
+        for (int lonIdx = 0; lonIdx < samples; lonIdx++) {
+            carpet.append(QGeoCoordinate(47.0 + (latIdx * kSpacingDegrees), 8.0 + (lonIdx * kSpacingDegrees)));
+        }
+    }
+    QList<double> elevations(carpet.size());
+
+    // Each iteration samples the whole carpet, so fewer epochs than usual keep the run short
+    auto bench = qgc::bench::ciConfig();
+    bench.epochs(10).relative(true).batch(carpet.size()).unit("coordinate");
+
+    bench.run("elevation() per coordinate", [&] {
+        for (qsizetype i = 0; i < carpet.size(); i++) {
+            elevations[i] = tile.elevation(carpet[i]);
+        }
+        ankerl::nanobench::doNotOptimizeAway(elevations);
+    });
+
+    bench.run("elevations() batch", [&] {
+        const qsizetype outside = tile.elevations(carpet, elevations);
+        ankerl::nanobench::doNotOptimizeAway(outside);
+    });
+}
+
 UT_REGISTER_TEST(TerrainTileTest, TestLabel::Unit, TestLabel::Terrain)
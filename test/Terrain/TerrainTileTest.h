@@ -20,9 +20,16 @@ private slots:
     void _testDataTooSmallForElevation();
     void _testElevationOutsideBounds();
     void _testInvalidTileElevation();
+    void _testGridIsRowMajor();
+    void _testBilinearInterpolation();
+    void _testBatchMatchesSingle();
+    void _benchmarkSurveyCarpet();
 
 private:
     static QByteArray _createValidTileData(double swLat, double swLon, double neLat, double neLon, int16_t minElev,
                                            int16_t maxElev, double avgElev, int16_t gridSizeLat, int16_t gridSizeLon,
                                            int16_t fillElevation);
+    /// Tile where the value at (row, col) is row * 100 + col
+    static QByteArray _createGradientTileData(double swLat, double swLon, double neLat, double neLon, int16_t gridSizeLat,
+                                              int16_t gridSizeLon);
 };
@@ -73,8 +73,8 @@ UnitTestTerrainQuery::PathHeightInfo_t UnitTestTerrainQuery::_requestPathHeights
                                                                                  const QGeoCoordinate& toCoord)
 {
     PathHeightInfo_t pathHeights;
-    pathHeights.rgCoords = TerrainTileManager::_pathQueryToCoords(fromCoord, toCoord, pathHeights.distanceBetween,
-                                                                  pathHeights.finalDistanceBetween);
+    pathHeights.rgCoords = TerrainTileManager::pathQueryToCoords(fromCoord, toCoord, pathHeights.distanceBetween,
+                                                                 pathHeights.finalDistanceBetween);
     pathHeights.rgHeights = _requestCoordinateHeights(pathHeights.rgCoords);
     return pathHeights;
 }
@@ -1,6 +1,7 @@
 #include "APMDataFlashUtilityTest.h"
 
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
@@ -339,6 +340,161 @@ void APMDataFlashUtilityTest::_testParseMessage()
     QCOMPARE(fields[QStringLiteral("Value2")].toInt(), -10);
 }
 
+void APMDataFlashUtilityTest::_testParseNumericValue()
+{
+    // Every numeric format character must decode to what parseValue() gives
+    char data[8];
+    for (int i = 0; i < 8; ++i) {
+        data[i] = static_cast<char>(0x81 + (i * 29));
+    }
+
+    const QByteArray numeric = QByteArrayLiteral("bBMhHcCiIeELfdqQg");
+    for (const char formatChar : numeric) {
+        QVERIFY2(APMDataFlashUtility::isNumericFormatChar(formatChar), qPrintable(QString(QLatin1Char(formatChar))));
+        QCOMPARE(APMDataFlashUtility::parseNumericValue(data, formatChar), APMDataFlashUtility::parseValue(data, formatChar).toDouble());
+    }
+
+    for (const char formatChar : QByteArrayLiteral("nNZax")) {
+        QVERIFY(!APMDataFlashUtility::isNumericFormatChar(formatChar));
+    }
+}
+
+// ============================================================================
+// Compiled Series Decoding Tests
+// ============================================================================
+
+void APMDataFlashUtilityTest::_testSeriesDecoder()
+{
+    // IMU-like numeric record, a record with a string column and a record type that is never logged
+    QMap<uint8_t, APMDataFlashUtility::MessageFormat> formats;
+    APMDataFlashUtility::MessageFormat imu;
+    imu.type = 100;
+    imu.name = QStringLiteral("IMU");
+    imu.format = QStringLiteral("QfhLB");
+    imu.columns = QStringList({QStringLiteral("TimeUS"), QStringLiteral("GyrX"), QStringLiteral("T"), QStringLiteral("Lat"), QStringLiteral("I")});
+    imu.length = static_cast<uint8_t>(3 + APMDataFlashUtility::calculatePayloadSize(imu.format));
+    formats[imu.type] = imu;
+
+    APMDataFlashUtility::MessageFormat msg;
+    msg.type = 101;
+    msg.name = QStringLiteral("MSG");
+    msg.format = QStringLiteral("QZ");
+    msg.columns = QStringList({QStringLiteral("TimeUS"), QStringLiteral("Message")});
+    msg.length = static_cast<uint8_t>(3 + APMDataFlashUtility::calculatePayloadSize(msg.format));
+    formats[msg.type] = msg;
+
+    APMDataFlashUtility::MessageFormat unused;
+    unused.type = 102;
+    unused.name = QStringLiteral("UNSD");
+    unused.format = QStringLiteral("Qf");
+    unused.columns = QStringList({QStringLiteral("TimeUS"), QStringLiteral("V")});
+    unused.length = 15;
+    formats[unused.type] = unused;
+
+    APMDataFlashUtility::SeriesDecoder decoder(formats);
+
+    QByteArray imuPayload(imu.length - 3, '\0');
+    for (int i = 0; i < 3; ++i) {
+        const uint64_t timeUs = 1000000ULL * (i + 1);
+        const float gyrX = 0.25f * i;
+        const int16_t temp = static_cast<int16_t>(-40 + i);
+        const int32_t lat = 473977420 + i;
+        memcpy(imuPayload.data(), &timeUs, 8);
+        memcpy(imuPayload.data() + 8, &gyrX, 4);
+        memcpy(imuPayload.data() + 12, &temp, 2);
+        memcpy(imuPayload.data() + 14, &lat, 4);
+        imuPayload[18] = static_cast<char>(i);
+
+        const double timestamp = decoder.timestampSeconds(imu.type, imuPayload.constData());
+        QCOMPARE(timestamp, i + 1.0);
+        decoder.decode(imu.type, imuPayload.constData(), timestamp);
+
+        // Same samples as walking the parsed value map
+        const QMap<QString, QVariant> values = APMDataFlashUtility::parseMessage(imuPayload.constData(), imu);
+        QCOMPARE(values.value(QStringLiteral("Lat")).toDouble(), lat / 1.0e7);
+    }
+
+    QByteArray msgPayload(msg.length - 3, '\0');
+    memcpy(msgPayload.data() + 8, "ArduCopter", 10);
+    decoder.decode(msg.type, msgPayload.constData(), decoder.timestampSeconds(msg.type, msgPayload.constData()));
+
+    QStringList fieldNames = decoder.fieldNames();
+    std::sort(fieldNames.begin(), fieldNames.end());
+    QCOMPARE(fieldNames, QStringList({QStringLiteral("IMU.GyrX"), QStringLiteral("IMU.I"), QStringLiteral("IMU.Lat"), QStringLiteral("IMU.T"),
+                                      QStringLiteral("IMU.TimeUS"), QStringLiteral("MSG.Message"), QStringLiteral("MSG.TimeUS")}));
+
+    const QList<APMDataFlashUtility::SeriesDecoder::Column> columns = decoder.numericColumns(imu.type);
+    QCOMPARE(columns.size(), 5);
+    QCOMPARE(columns.at(3).fieldName, QStringLiteral("IMU.Lat"));
+    QCOMPARE(columns.at(3).offset, 14);
+    QCOMPARE(columns.at(3).formatChar, 'L');
+    QCOMPARE(decoder.numericColumns(msg.type).size(), 1);
+
+    const QHash<QString, QVector<QPointF>> series = decoder.takeSeries();
+    QVERIFY(!series.contains(QStringLiteral("MSG.Message")));
+    QVERIFY(!series.contains(QStringLiteral("UNSD.V")));
+    QCOMPARE(series.value(QStringLiteral("MSG.TimeUS")).size(), 1);
+    QCOMPARE(series.value(QStringLiteral("IMU.GyrX")), QVector<QPointF>({{1.0, 0.0}, {2.0, 0.25}, {3.0, 0.5}}));
+    QCOMPARE(series.value(QStringLiteral("IMU.T")), QVector<QPointF>({{1.0, -40.0}, {2.0, -39.0}, {3.0, -38.0}}));
+    QCOMPARE(series.value(QStringLiteral("IMU.Lat")).at(2).y(), 473977422 / 1.0e7);
+    QCOMPARE(series.value(QStringLiteral("IMU.I")).at(1).y(), 1.0);
+
+    QVERIFY(decoder.takeSeries().isEmpty());
+}
+
+void APMDataFlashUtilityTest::_testSeriesDecoderTimestamps()
+{
+    QMap<uint8_t, APMDataFlashUtility::MessageFormat> formats;
+
+    // TimeMS in milliseconds, no time column at all, and a column named twice where the last one wins
+    APMDataFlashUtility::MessageFormat ms;
+    ms.type = 1;
+    ms.name = QStringLiteral("MS");
+    ms.format = QStringLiteral("IH");
+    ms.columns = QStringList({QStringLiteral("TimeMS"), QStringLiteral("V")});
+    ms.length = 9;
+    formats[ms.type] = ms;
+
+    APMDataFlashUtility::MessageFormat none;
+    none.type = 2;
+    none.name = QStringLiteral("NONE");
+    none.format = QStringLiteral("H");
+    none.columns = QStringList({QStringLiteral("V")});
+    none.length = 5;
+    formats[none.type] = none;
+
+    APMDataFlashUtility::MessageFormat dup;
+    dup.type = 3;
+    dup.name = QStringLiteral("DUP");
+    dup.format = QStringLiteral("QBB");
+    dup.columns = QStringList({QStringLiteral("TimeUS"), QStringLiteral("V"), QStringLiteral("V")});
+    dup.length = 13;
+    formats[dup.type] = dup;
+
+    APMDataFlashUtility::SeriesDecoder decoder(formats);
+
+    char payload[10] = {};
+    const uint32_t timeMs = 2500;
+    memcpy(payload, &timeMs, 4);
+    QCOMPARE(decoder.timestampSeconds(ms.type, payload), 2.5);
+    QCOMPARE(decoder.timestampSeconds(none.type, payload), -1.0);
+
+    // No timestamp: the type still counts as seen, but nothing is plotted
+    decoder.decode(none.type, payload, -1.0);
+    QVERIFY(decoder.fieldNames().contains(QStringLiteral("NONE.V")));
+
+    const uint64_t timeUs = 3000000;
+    memcpy(payload, &timeUs, 8);
+    payload[8] = 7;
+    payload[9] = 9;
+    decoder.decode(dup.type, payload, decoder.timestampSeconds(dup.type, payload));
+
+    const QHash<QString, QVector<QPointF>> series = decoder.takeSeries();
+    QVERIFY(!series.contains(QStringLiteral("NONE.V")));
+    QCOMPARE(series.value(QStringLiteral("DUP.V")), QVector<QPointF>({{3.0, 9.0}}));
+    QCOMPARE(APMDataFlashUtility::parseMessage(payload, dup).value(QStringLiteral("V")).toDouble(), 9.0);
+}
+
 // ============================================================================
 // Message Iteration Tests
 // ============================================================================
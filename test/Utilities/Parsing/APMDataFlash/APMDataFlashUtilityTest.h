@@ -36,6 +36,11 @@ private slots:
 
     // Message parsing tests
     void _testParseMessage();
+    void _testParseNumericValue();
+
+    // Compiled series decoding tests
+    void _testSeriesDecoder();
+    void _testSeriesDecoderTimestamps();
 
     // Message iteration tests
     void _testIterateMessages();
@@ -0,0 +1,163 @@
+#include "VehicleMessageDispatchTest.h"
+
+#include "Benchmarking.h"
+#include "BatteryFactGroupListModel.h"
+#include "MAVLinkLib.h"
+#include "MessageDispatchTable.h"
+#include "Vehicle.h"
+
+#include <QtTest/QTest>
+
+namespace {
+
+mavlink_message_t messageWithId(uint32_t msgId)
+{
+    mavlink_message_t message{};
+    message.msgid = msgId;
+    return message;
+}
+
+}  // namespace
+
+mavlink_message_t VehicleMessageDispatchTest::_attitudeMessage() const
+{
+    mavlink_message_t message{};
+    (void) mavlink_msg_attitude_pack_chan(static_cast<uint8_t>(vehicle()->id()), static_cast<uint8_t>(vehicle()->compId()),
+                                          MAVLINK_COMM_0, &message, 1000, 0.1f, 0.2f, 0.3f, 0.f, 0.f, 0.f);
+    return message;
+}
+
+void VehicleMessageDispatchTest::_testTableOrdering()
+{
+    MessageDispatchTable table;
+    QStringList calls;
+
+    table.subscribe({ 5, 1, 5 }, [&](const mavlink_message_t &message) { calls.append(QStringLiteral("a%1").arg(message.msgid)); });
+    table.subscribeAll([&](const mavlink_message_t &message) { calls.append(QStringLiteral("all%1").arg(message.msgid)); });
+    table.subscribe({ 5 }, [&](const mavlink_message_t &message) { calls.append(QStringLiteral("c%1").arg(message.msgid)); });
+    table.subscribe({}, [&](const mavlink_message_t &) { calls.append(QStringLiteral("never")); });
+
+    table.dispatch(messageWithId(5));
+    QCOMPARE(calls, QStringList({ QStringLiteral("a5"), QStringLiteral("all5"), QStringLiteral("c5") }));
+
+    calls.clear();
+    table.dispatch(messageWithId(1));
+    QCOMPARE(calls, QStringList({ QStringLiteral("a1"), QStringLiteral("all1") }));
+
+    // Ids past the end of the table only reach wildcard subscribers
+    calls.clear();
+    table.dispatch(messageWithId(MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS));
+    QCOMPARE(calls, QStringList({ QStringLiteral("all%1").arg(MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS) }));
+
+    QCOMPARE(table.handlerCount(5), 3);
+    QCOMPARE(table.handlerCount(2), 1);
+    QCOMPARE(table.handlerCount(100000), 1);
+
+    table.clear();
+    calls.clear();
+    table.dispatch(messageWithId(5));
+    QVERIFY(calls.isEmpty());
+    QCOMPARE(table.handlerCount(5), 0);
+}
+
+void VehicleMessageDispatchTest::_testSubscribeDuringDispatch()
+{
+    MessageDispatchTable table;
+    int lateCalls = 0;
+    bool subscribed = false;
+
+    table.subscribe({ 7 }, [&](const mavlink_message_t &) {
+        if (!subscribed) {
+            subscribed = true;
+            table.subscribe({ 7 }, [&](const mavlink_message_t &) { lateCalls++; });
+        }
+    });
+
+    table.dispatch(messageWithId(7));
+    QCOMPARE(lateCalls, 0);
+    table.dispatch(messageWithId(7));
+    QCOMPARE(lateCalls, 1);
+}
+
+void VehicleMessageDispatchTest::_testVehicleRoutesByMsgId()
+{
+    Vehicle *const vehicle = this->vehicle();
+    QVERIFY(vehicle);
+
+    // Make sure the fact group table reflects all groups present now
+    const mavlink_message_t attitude = _attitudeMessage();
+    vehicle->_mavlinkMessageReceived(mockLink(), attitude);
+    QVERIFY(!vehicle->_factGroupDispatchDirty);
+
+    // ATTITUDE only reaches the vehicle fact group, not every group
+    const qsizetype groupCount = vehicle->factGroups().count() + 1;
+    const qsizetype attitudeHandlers = vehicle->_factGroupDispatch.handlerCount(MAVLINK_MSG_ID_ATTITUDE);
+    QVERIFY2(attitudeHandlers >= 1, "vehicle fact group must receive ATTITUDE");
+    QVERIFY(attitudeHandlers < groupCount);
+    QCOMPARE(vehicle->_factGroupDispatch.handlerCount(MAVLINK_MSG_ID_VIBRATION), attitudeHandlers);
+
+    // Managers: only the request-message coordinator sees traffic it did not declare
+    QCOMPARE(vehicle->_messageDispatch.handlerCount(MAVLINK_MSG_ID_ATTITUDE), 1);
+    QCOMPARE(vehicle->_messageDispatch.handlerCount(MAVLINK_MSG_ID_PARAM_VALUE), 2);
+}
+
+void VehicleMessageDispatchTest::_testDynamicFactGroupSeesCreatingMessage()
+{
+    Vehicle *const vehicle = this->vehicle();
+    QVERIFY(vehicle);
+
+    constexpr uint8_t kBatteryId = 7;
+    const QString groupName = QStringLiteral("battery%1").arg(kBatteryId);
+    QVERIFY(!vehicle->factGroupNames().contains(groupName));
+
+    uint16_t voltages[10];
+    std::fill(std::begin(voltages), std::end(voltages), UINT16_MAX);
+    voltages[0] = 12000;
+    uint16_t voltagesExt[4] = {};
+
+    mavlink_message_t message{};
+    (void) mavlink_msg_battery_status_pack_chan(static_cast<uint8_t>(vehicle->id()), static_cast<uint8_t>(vehicle->compId()),
+                                                MAVLINK_COMM_0, &message, kBatteryId, MAV_BATTERY_FUNCTION_ALL,
+                                                MAV_BATTERY_TYPE_LIPO, INT16_MAX, voltages, -1, -1, -1, 42, 0,
+                                                MAV_BATTERY_CHARGE_STATE_OK, voltagesExt, MAV_BATTERY_MODE_UNKNOWN, 0);
+    vehicle->_mavlinkMessageReceived(mockLink(), message);
+
+    QVERIFY(vehicle->factGroupNames().contains(groupName));
+    BatteryFactGroup *const battery = qobject_cast<BatteryFactGroup*>(vehicle->getFactGroup(groupName));
+    QVERIFY(battery);
+    QVERIFY(battery->telemetryAvailable());
+    QCOMPARE(battery->percentRemaining()->rawValue().toInt(), 42);
+}
+
+void VehicleMessageDispatchTest::_benchmarkDispatchPerMessage()
+{
+    Vehicle *const vehicle = this->vehicle();
+    QVERIFY(vehicle);
+
+    const mavlink_message_t attitude = _attitudeMessage();
+    vehicle->_mavlinkMessageReceived(mockLink(), attitude);
+
+    auto bench = qgc::bench::ciConfig();
+    bench.relative(true).unit("message");
+
+    // What every message used to cost: each production fact group runs its own msgid switch
+    bench.run("broadcast to all fact groups", [&] {
+        for (FactGroup *const factGroup : vehicle->factGroups()) {
+            factGroup->handleMessage(vehicle, attitude);
+        }
+        vehicle->handleMessage(vehicle, attitude);
+        ankerl::nanobench::doNotOptimizeAway(vehicle);
+    });
+
+    bench.run("fact group dispatch table", [&] {
+        vehicle->_factGroupDispatch.dispatch(attitude);
+        ankerl::nanobench::doNotOptimizeAway(vehicle);
+    });
+
+    bench.run("full Vehicle::_mavlinkMessageReceived", [&] {
+        vehicle->_mavlinkMessageReceived(mockLink(), attitude);
+        ankerl::nanobench::doNotOptimizeAway(vehicle);
+    });
+}
+
+UT_REGISTER_TEST(VehicleMessageDispatchTest, TestLabel::Integration, TestLabel::Vehicle)
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "BaseClasses/VehicleTest.h"
+
+/// Tests for MessageDispatchTable and Vehicle's per-msgid routing of incoming messages.
+class VehicleMessageDispatchTest : public VehicleTestNoInitialConnect
+{
+    Q_OBJECT
+
+private slots:
+    void _testTableOrdering();
+    void _testSubscribeDuringDispatch();
+    void _testVehicleRoutesByMsgId();
+    void _testDynamicFactGroupSeesCreatingMessage();
+    void _benchmarkDispatchPerMessage();
+
+private:
+    mavlink_message_t _attitudeMessage() const;
+};